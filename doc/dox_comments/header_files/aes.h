@@ -463,6 +463,88 @@ int  wc_AesGcmDecrypt(Aes* aes, byte* out,
                                    const byte* authTag, word32 authTagSz,
                                    const byte* authIn, word32 authInSz);
 
+/*!
+    \ingroup AES
+    \brief This function encrypts and authenticates a vector of independent
+    jobs. Each job has its own AES object, IV, authentication input and
+    message. With VAES and VPCLMULQDQ, jobs with 12 byte IVs and keys of the
+    same size are processed sixteen at a time so that short messages keep the
+    AES and GHASH units busy. Other jobs are encrypted one at a time with
+    wc_AesGcmEncrypt. Available when wolfSSL is built with
+    WOLFSSL_AESGCM_MULTI (--enable-aesgcm-multi).
+
+    \return 0 On successfully encrypting all jobs
+    \return BAD_FUNC_ARG If jobs is NULL and count is not 0.
+    \return Result of the first job that failed otherwise. The result of
+    each job is in its ret field.
+
+    \param jobs pointer to the jobs. The AES objects must have a key set by
+    wc_AesGcmSetKey.
+    \param count number of jobs
+
+    _Example_
+    \code
+    Aes aes[N]; // keys set with wc_AesGcmSetKey
+    wc_AesGcmJob jobs[N];
+    int i;
+
+    for (i = 0; i < N; i++) {
+        jobs[i].aes = &aes[i];
+        jobs[i].out = cipher[i];
+        jobs[i].in = plain[i];
+        jobs[i].sz = plainSz[i];
+        jobs[i].iv = iv[i];
+        jobs[i].ivSz = GCM_NONCE_MID_SZ;
+        jobs[i].authTag = tag[i];
+        jobs[i].authTagSz = AES_BLOCK_SIZE;
+        jobs[i].authIn = aad[i];
+        jobs[i].authInSz = aadSz[i];
+    }
+    if (wc_AesGcmEncryptMulti(jobs, N) != 0) {
+        // check jobs[i].ret for the jobs that failed
+    }
+    \endcode
+
+    \sa wc_AesGcmEncrypt
+    \sa wc_AesGcmDecryptMulti
+*/
+int wc_AesGcmEncryptMulti(wc_AesGcmJob* jobs, word32 count);
+
+/*!
+    \ingroup AES
+    \brief This function decrypts and verifies a vector of independent
+    jobs. The authTag of each job is the tag to check. A job whose tag doesn't
+    match has its ret field set to AES_GCM_AUTH_E - other jobs are not
+    affected. Jobs are processed together as in wc_AesGcmEncryptMulti.
+
+    \return 0 On successfully decrypting and verifying all jobs
+    \return BAD_FUNC_ARG If jobs is NULL and count is not 0.
+    \return AES_GCM_AUTH_E If the first job that failed had a tag that didn't
+    match.
+    \return Result of the first job that failed otherwise.
+
+    \param jobs pointer to the jobs. The AES objects must have a key set by
+    wc_AesGcmSetKey.
+    \param count number of jobs
+
+    _Example_
+    \code
+    wc_AesGcmJob jobs[N]; // set up as for wc_AesGcmEncryptMulti
+    int i;
+
+    wc_AesGcmDecryptMulti(jobs, N);
+    for (i = 0; i < N; i++) {
+        if (jobs[i].ret != 0) {
+            // drop packet i
+        }
+    }
+    \endcode
+
+    \sa wc_AesGcmDecrypt
+    \sa wc_AesGcmEncryptMulti
+*/
+int wc_AesGcmDecryptMulti(wc_AesGcmJob* jobs, word32 count);
+
 /*!
     \ingroup AES
     \brief This function initializes and sets the key for a GMAC object
@@ -853,6 +935,101 @@ int wc_AesXtsEncryptSector(XtsAes* aes, byte* out,
 int wc_AesXtsDecryptSector(XtsAes* aes, byte* out,
          const byte* in, word32 sz, word64 sector);
 
+/*!
+    \ingroup AES
+
+    \brief Encrypts a run of consecutive sectors in one call. The tweak of
+           the first sector is sector and is incremented every sectorSz bytes.
+           The last sector may be partial. With AVX-512 VAES available at
+           runtime (WOLFSSL_AESXTS_VAES), four sectors are encrypted at a time
+           when sectorSz is a multiple of the block size. With
+           WOLFSSL_AESXTS_THREADS, the run is split across up to threads
+           threads, each with at least WC_AESXTS_THREAD_MIN_SZ bytes.
+
+    \return 0 Success
+    \return BAD_FUNC_ARG Returned if aes, out or in is NULL, sectorSz is 0,
+            sz is less than a block or threads is negative or more than
+            WOLFSSL_AESXTS_MAX_THREADS (default: 64)
+    \return MEMORY_E Returned if memory for the threads can't be allocated
+
+    \param aes      AES keys to use for block encrypt
+    \param out      output buffer to hold cipher text
+    \param in       input plain text buffer to encrypt
+    \param sz       size of both out and in buffers
+    \param sector   value to use for tweak of first sector
+    \param sectorSz size of a sector
+    \param threads  maximum number of threads to use, 0 or 1 for the calling
+                    thread only
+
+    _Example_
+    \code
+    XtsAes aes;
+    unsigned char plain[16 * 4096];
+    unsigned char cipher[16 * 4096];
+    word64 s = VALUE;
+
+    //set up keys with AES_ENCRYPTION as dir
+
+    if(wc_AesXtsEncryptSectors(&aes, cipher, plain, sizeof(plain), s, 4096,
+            4) != 0)
+    {
+        // Handle error
+    }
+    wc_AesXtsFree(&aes);
+    \endcode
+
+    \sa wc_AesXtsDecryptSectors
+    \sa wc_AesXtsEncryptSector
+    \sa wc_AesXtsEncryptConsecutiveSectors
+*/
+int wc_AesXtsEncryptSectors(XtsAes* aes, byte* out, const byte* in,
+        word32 sz, word64 sector, word32 sectorSz, int threads);
+
+/*!
+    \ingroup AES
+
+    \brief Same as wc_AesXtsEncryptSectors but decrypts. The AES key is
+           AES_DECRYPTION type.
+
+    \return 0 Success
+    \return BAD_FUNC_ARG Returned if aes, out or in is NULL, sectorSz is 0,
+            sz is less than a block or threads is negative or more than
+            WOLFSSL_AESXTS_MAX_THREADS (default: 64)
+    \return MEMORY_E Returned if memory for the threads can't be allocated
+
+    \param aes      AES keys to use for block decrypt
+    \param out      output buffer to hold plain text
+    \param in       input cipher text buffer to decrypt
+    \param sz       size of both out and in buffers
+    \param sector   value to use for tweak of first sector
+    \param sectorSz size of a sector
+    \param threads  maximum number of threads to use, 0 or 1 for the calling
+                    thread only
+
+    _Example_
+    \code
+    XtsAes aes;
+    unsigned char plain[16 * 4096];
+    unsigned char cipher[16 * 4096];
+    word64 s = VALUE;
+
+    //set up aes key with AES_DECRYPTION as dir and tweak with AES_ENCRYPTION
+
+    if(wc_AesXtsDecryptSectors(&aes, plain, cipher, sizeof(cipher), s, 4096,
+            4) != 0)
+    {
+        // Handle error
+    }
+    wc_AesXtsFree(&aes);
+    \endcode
+
+    \sa wc_AesXtsEncryptSectors
+    \sa wc_AesXtsDecryptSector
+    \sa wc_AesXtsDecryptConsecutiveSectors
+*/
+int wc_AesXtsDecryptSectors(XtsAes* aes, byte* out, const byte* in,
+        word32 sz, word64 sector, word32 sectorSz, int threads);
+
 /*!
     \ingroup AES
 
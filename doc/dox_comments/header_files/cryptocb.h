@@ -109,3 +109,71 @@ int  wc_CryptoCb_RegisterDevice(int devId, CryptoDevCallbackFunc cb, void* ctx);
     \sa wolfSSL_CTX_SetDevId
 */
 void wc_CryptoCb_UnRegisterDevice(int devId);
+
+/*!
+    \ingroup CryptoCb
+
+    \brief This function starts a pool of worker threads and registers it as
+    the crypto callback device devId. RSA, ECC (key generation, ECDH, ECDSA
+    sign and verify), Curve25519 and Ed25519 operations of keys and
+    WOLFSSL_CTX objects set to devId are run in software on the workers.
+    Other operations are left to the calling thread. Without flags the
+    callback waits for the worker. With WC_CRYPTOCB_POOL_FLAG_ASYNC, in a
+    WOLFSSL_ASYNC_CRYPT build, ECC, Curve25519 and Ed25519 operations return
+    WC_PENDING_E until a worker has run them and the result is returned when
+    the operation is called again. RSA operations always wait since rsa.c
+    does not call the device again for a pending operation. Requires
+    WOLF_CRYPTO_CB_POOL (--enable-cryptocb-pool).
+
+    \return 0 on success.
+    \return BAD_FUNC_ARG if pool is NULL, devId is INVALID_DEVID, threads is
+    not 1 to WC_CRYPTOCB_POOL_MAX_THREADS or flags are not supported.
+    \return MEMORY_E on allocation failure.
+    \return BUFFER_E if no device can be registered.
+
+    \param pool set to the new pool
+    \param devId any unique value, not -2 (INVALID_DEVID)
+    \param threads number of worker threads
+    \param flags 0 or WC_CRYPTOCB_POOL_FLAG_ASYNC
+    \param heap heap hint for the pool
+
+    _Example_
+    \code
+    wc_CryptoCbPool* pool;
+    int devId = 7;
+
+    if (wc_CryptoCbPool_New(&pool, devId, 4, 0, NULL) == 0) {
+        wolfSSL_CTX_SetDevId(ctx, devId);
+        // handshakes of ctx run their public key operations on the pool
+    }
+    ...
+    wolfSSL_CTX_free(ctx);
+    wc_CryptoCbPool_Free(pool);
+    \endcode
+
+    \sa wc_CryptoCbPool_Free
+    \sa wc_CryptoCb_RegisterDevice
+    \sa wolfSSL_CTX_SetDevId
+*/
+int wc_CryptoCbPool_New(wc_CryptoCbPool** pool, int devId, int threads,
+                        int flags, void* heap);
+
+/*!
+    \ingroup CryptoCb
+
+    \brief This function un-registers the device of a pool started with
+    wc_CryptoCbPool_New(), runs the queued operations and stops the workers.
+    No operation may be using the device meanwhile.
+
+    \return none No returns.
+
+    \param pool pool to free, may be NULL
+
+    _Example_
+    \code
+    wc_CryptoCbPool_Free(pool);
+    \endcode
+
+    \sa wc_CryptoCbPool_New
+*/
+void wc_CryptoCbPool_Free(wc_CryptoCbPool* pool);
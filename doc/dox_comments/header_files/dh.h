@@ -381,6 +381,40 @@ int wc_DhExportParamsRaw(DhKey* dh, byte* p, word32* pSz,
 */
 int wc_DhGenerateParams(WC_RNG *rng, int modSz, DhKey *dh);
 
+/*!
+    \ingroup Diffie-Hellman
+
+    \brief This function sets the number of threads wc_DhGenerateParams uses
+    to search for the prime p = 2qk + 1. Each thread tests every threads'th
+    value of k. The first prime found by any thread is used, which need not
+    be the one with the smallest k. 0 or 1 searches on the calling thread
+    only. Requires WOLFSSL_KEY_GEN and WOLFSSL_KEYGEN_THREADS
+    (--enable-keygen-threads).
+
+    \return 0 Returned upon success
+    \return BAD_FUNC_ARG Returned if key is NULL or threads is negative or
+    more than WOLFSSL_KEYGEN_MAX_THREADS (default: 64)
+
+    \param key pointer to the DhKey structure to generate parameters into
+    \param threads number of threads to search for the prime with
+
+    _Example_
+    \code
+    DhKey key;
+    WC_RNG rng;
+    int ret;
+
+    wc_InitDhKey(&key);
+    ret = wc_DhSetParamGenThreads(&key, 4);
+    if (ret == 0) {
+        ret = wc_DhGenerateParams(&rng, 2048, &key);
+    }
+    \endcode
+
+    \sa wc_DhGenerateParams
+*/
+int wc_DhSetParamGenThreads(DhKey* key, int threads);
+
 /*!
     \ingroup Diffie-Hellman
 */
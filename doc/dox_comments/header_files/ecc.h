@@ -534,11 +534,60 @@ int wc_ecc_verify_hash(const byte* sig, word32 siglen, const byte* hash,
     \endcode
 
     \sa wc_ecc_verify_hash
+    \sa wc_ecc_verify_hash_batch
 */
 
 int wc_ecc_verify_hash_ex(mp_int *r, mp_int *s, const byte* hash,
                           word32 hashlen, int* stat, ecc_key* key);
 
+/*!
+    \ingroup ECC
+
+    \brief Verify a batch of ECC signatures. The result of each signature is
+    written to the matching entry of stat, 1 is valid, 0 is invalid.
+    Consecutive signatures whose keys are on the same curve share one
+    modular inversion of s (Montgomery's trick) and one load of the curve
+    parameters. Keys on curves handled by the SP implementation are verified
+    one at a time. An r or s that is out of range gives an invalid result
+    rather than an error.
+    Note: Do not use the return value to test for valid.  Only use stat.
+
+    \return MP_OKAY If successful (even if signatures are not valid)
+    \return ECC_BAD_ARG_E Returns if arguments are null, count is negative or
+    a key-idx is invalid.
+    \return MEMORY_E Error allocating ints or points.
+
+    \param r Array of count signature R components to verify
+    \param s Array of count signature S components to verify
+    \param hash Array of count hashes (message digests) that were signed
+    \param hashlen Array of count hash lengths (octets)
+    \param stat Array of count results, 1==valid, 0==invalid
+    \param key Array of count public ECC keys, one per signature
+    \param count Number of signatures in the batch
+
+    _Example_
+    \code
+    mp_int* r[2];
+    mp_int* s[2];
+    const byte* hash[2];
+    word32 hashlen[2];
+    int stat[2];
+    ecc_key* key[2];
+    // set r, s and hash of each signature and the key that signed it
+
+    if (wc_ecc_verify_hash_batch(r, s, hash, hashlen, stat, key, 2) ==
+            MP_OKAY) {
+        // Check stat[0] and stat[1]
+    }
+    \endcode
+
+    \sa wc_ecc_verify_hash_ex
+*/
+
+int wc_ecc_verify_hash_batch(mp_int** r, mp_int** s, const byte** hash,
+                             const word32* hashlen, int* stat, ecc_key** key,
+                             int count);
+
 /*!
     \ingroup ECC
 
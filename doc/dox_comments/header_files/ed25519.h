@@ -516,6 +516,65 @@ int wc_ed25519ph_verify_msg(const byte* sig, word32 siglen, const byte* msg,
                             word32 msgLen, int* ret, ed25519_key* key,
                             const byte* context, byte contextLen);
 
+/*!
+    \ingroup ED25519
+
+    \brief This function verifies a batch of Ed25519 signatures. Random
+    weights from rng combine the signatures so that one multi-scalar
+    multiplication checks up to ED25519_BATCH_MAX of them at once. When the
+    combined check fails each signature is verified on its own. The
+    combined check is cofactored (multiplied by 8) while
+    wc_ed25519_verify_msg() is cofactorless. The results only differ for
+    signatures whose R or public key has a small order component, which a
+    signer never produces: these may be reported as valid here. The result of
+    each signature is returned in res, with 1 corresponding to a valid
+    signature, and 0 corresponding to an invalid signature. Only Ed25519
+    signatures without a context are supported.
+
+    \return 0 Returned when all the signatures were checked. An invalid
+    signature is not an error.
+    \return BAD_FUNC_ARG Returned if any of the arrays, or any entry of sig,
+    msg or key, or rng is NULL.
+    \return MEMORY_E Returned if there is an error allocating memory.
+
+    \param [in] sig Array of pointers to the signatures to verify.
+    \param [in] sigLen Array of the signature lengths.
+    \param [in] msg Array of pointers to the messages signed.
+    \param [in] msgLen Array of the message lengths.
+    \param [out] res Array of the verification results. 1 indicates the
+    signature was successfully verified.
+    \param [in] key Array of pointers to the public Ed25519 keys.
+    \param [in] count Number of signatures in the batch.
+    \param [in] rng Pointer to an initialized RNG used for the weights.
+
+    _Example_
+    \code
+    const byte* sig[N];
+    word32 sigLen[N];
+    const byte* msg[N];
+    word32 msgLen[N];
+    int res[N];
+    ed25519_key* key[N];
+    WC_RNG rng;
+    int ret;
+
+    // initialize signatures, messages and keys
+    ret = wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, res, key, N,
+            &rng);
+    if (ret < 0) {
+        // error performing verification
+    }
+    // res[i] is 1 for each valid signature
+    \endcode
+
+    \sa wc_ed25519_verify_msg
+*/
+
+int wc_ed25519_verify_msg_batch(const byte** sig, const word32* sigLen,
+                                const byte** msg, const word32* msgLen,
+                                int* res, ed25519_key** key, word32 count,
+                                WC_RNG* rng);
+
 /*!
     \ingroup ED25519
 
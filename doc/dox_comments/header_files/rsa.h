@@ -109,6 +109,50 @@ int  wc_InitRsaKey_Id(RsaKey* key, unsigned char* id, int len,
 */
 int wc_RsaSetRNG(RsaKey* key, WC_RNG* rng);
 
+/*!
+    \ingroup RSA
+
+    \brief This function prepares an RSA private key for repeated private key
+    operations. The Montgomery multiplier for the modulus and a blinding pair
+    are cached with the key. Each private operation then advances the blinding
+    pair by squaring instead of generating a random value, inverting it and
+    exponentiating it. A fresh blinding pair is generated every
+    WC_RSA_PREPARED_REFRESH (default: 32) operations using the RNG passed to
+    the operation. Requires WC_RSA_PREPARED and WC_RSA_BLINDING.
+
+    The cached values are freed by wc_FreeRsaKey. The key must not be modified
+    after it is prepared; call this function again if it is. Private key
+    operations on a prepared key are thread safe, preparing is not.
+
+    \return 0 Returned upon success
+    \return BAD_FUNC_ARG Returned if key or rng is NULL or key is not a
+    private key
+    \return MEMORY_E Returned if memory allocation fails
+    \return BAD_MUTEX_E Returned if the lock could not be initialized
+
+    \param key pointer to the RsaKey structure holding a private key
+    \param rng pointer to the WC_RNG structure to generate the blinding value
+
+    _Example_
+    \code
+    RsaKey key;
+    WC_RNG rng;
+    word32 idx = 0;
+    int ret;
+
+    ret = wc_RsaPrivateKeyDecode(der, &idx, &key, derSz);
+    if (ret == 0) {
+        ret = wc_RsaPrepareKey(&key, &rng);
+    }
+    // sign many times with key
+    \endcode
+
+    \sa wc_RsaSetRNG
+    \sa wc_RsaSSL_Sign
+    \sa wc_FreeRsaKey
+*/
+int wc_RsaPrepareKey(RsaKey* key, WC_RNG* rng);
+
 /*!
     \ingroup RSA
 
@@ -1524,6 +1568,40 @@ int wc_RsaKeyToPublicDer_ex(RsaKey* key, byte* output, word32 inLen,
 */
 int wc_MakeRsaKey(RsaKey* key, int size, long e, WC_RNG* rng);
 
+/*!
+    \ingroup RSA
+
+    \brief This function sets the number of threads wc_MakeRsaKey uses to
+    search for each of the primes p and q. Each thread tests its own random
+    candidates with an RNG instantiated from the RNG passed to wc_MakeRsaKey.
+    The first probable prime found by any thread is used. 0 or 1 searches on
+    the calling thread only. Requires WOLFSSL_KEY_GEN and
+    WOLFSSL_KEYGEN_THREADS (--enable-keygen-threads).
+
+    \return 0 Returned upon success
+    \return BAD_FUNC_ARG Returned if key is NULL or threads is negative or
+    more than WOLFSSL_KEYGEN_MAX_THREADS (default: 64)
+
+    \param key pointer to the RsaKey structure to generate into
+    \param threads number of threads to search for primes with
+
+    _Example_
+    \code
+    RsaKey key;
+    WC_RNG rng;
+    int ret;
+
+    wc_InitRsaKey(&key, NULL);
+    ret = wc_RsaSetKeyGenThreads(&key, 4);
+    if (ret == 0) {
+        ret = wc_MakeRsaKey(&key, 3072, WC_RSA_EXPONENT, &rng);
+    }
+    \endcode
+
+    \sa wc_MakeRsaKey
+*/
+int wc_RsaSetKeyGenThreads(RsaKey* key, int threads);
+
 /*!
     \ingroup RSA
 
@@ -152,6 +152,109 @@ void wc_Sha256Free(wc_Sha256*);
 */
 int wc_Sha256GetHash(wc_Sha256* sha256, byte* hash);
 
+/*!
+    \ingroup SHA
+
+    \brief Initializes a multi-buffer SHA-256 context. The context hashes
+    several independent messages at once, one per lane. The lane count is
+    chosen from the CPU: 16 with AVX-512, 8 with AVX2, otherwise 1. With one
+    lane each message is hashed when submitted, using the same
+    implementation as wc_Sha256Hash(). Requires WOLFSSL_SHA256_MB.
+
+    \return 0 Success.
+    \return BAD_FUNC_ARG mb is NULL.
+
+    \param mb pointer to the multi-buffer context to initialize.
+    \param heap heap hint, may be NULL.
+    \param devId device id used when a message is hashed on its own.
+
+    _Example_
+    \code
+    wc_Sha256_MB mb;
+    int i;
+
+    wc_Sha256_MB_Init(&mb, NULL, INVALID_DEVID);
+    for (i = 0; i < count; i++) {
+        if (wc_Sha256_MB_Submit(&mb, msg[i], msgLen[i], hash[i]) != 0)
+            break;
+    }
+    wc_Sha256_MB_Flush(&mb);
+    wc_Sha256_MB_Free(&mb);
+    \endcode
+
+    \sa wc_Sha256_MB_Submit
+    \sa wc_Sha256_MB_Flush
+    \sa wc_Sha256_MB_Free
+*/
+int wc_Sha256_MB_Init(wc_Sha256_MB* mb, void* heap, int devId);
+
+/*!
+    \ingroup SHA
+
+    \brief Returns the number of lanes the multi-buffer context hashes in
+    parallel. Submitting at least this many messages before flushing keeps
+    every lane busy.
+
+    \return lane count on success.
+    \return BAD_FUNC_ARG mb is NULL.
+
+    \param mb pointer to an initialized multi-buffer context.
+
+    \sa wc_Sha256_MB_Init
+*/
+int wc_Sha256_MB_Lanes(wc_Sha256_MB* mb);
+
+/*!
+    \ingroup SHA
+
+    \brief Queues a whole message on a free lane. When every lane is busy
+    the lanes are run until one message completes, whose digest is then
+    written to the hash buffer given at its submission. The data and hash
+    buffers must stay valid until the message completes.
+
+    \return 0 Success.
+    \return BAD_FUNC_ARG mb or hash is NULL, or data is NULL with a
+    non-zero len.
+    \return other negative values when hashing a message on its own fails.
+
+    \param mb pointer to an initialized multi-buffer context.
+    \param data message to hash.
+    \param len length of the message in bytes.
+    \param hash buffer of WC_SHA256_DIGEST_SIZE bytes for the digest.
+
+    \sa wc_Sha256_MB_Flush
+*/
+int wc_Sha256_MB_Submit(wc_Sha256_MB* mb, const byte* data, word32 len,
+    byte* hash);
+
+/*!
+    \ingroup SHA
+
+    \brief Completes every queued message and writes its digest.
+
+    \return 0 Success.
+    \return BAD_FUNC_ARG mb is NULL.
+
+    \param mb pointer to an initialized multi-buffer context.
+
+    \sa wc_Sha256_MB_Submit
+*/
+int wc_Sha256_MB_Flush(wc_Sha256_MB* mb);
+
+/*!
+    \ingroup SHA
+
+    \brief Clears the multi-buffer context. Queued messages that were not
+    flushed are dropped.
+
+    \return none No returns.
+
+    \param mb pointer to the multi-buffer context to free.
+
+    \sa wc_Sha256_MB_Init
+*/
+void wc_Sha256_MB_Free(wc_Sha256_MB* mb);
+
 /*!
     \ingroup SHA
 
@@ -1248,3 +1248,164 @@ int wc_Shake256_GetHash(wc_Shake* shake, byte* hash);
 int wc_Shake256_Copy(wc_Shake* shake, wc_Shake* dst);
 
 
+
+/*!
+    \ingroup SHA
+
+    \brief Initializes four SHAKE128 states that are absorbed and squeezed
+    together. On x86_64 CPUs with AVX2 the four Keccak permutations run in
+    parallel in one pass.
+
+    \return 0 Returned upon successfully initializing.
+    \return BAD_FUNC_ARG shake is NULL.
+
+    \param shake pointer to the four-state shake structure to initialize
+    \param heap pointer to a heap hint, may be NULL
+    \param devId device identifier, use INVALID_DEVID
+
+    _Example_
+    \code
+    wc_Shake_x4 shake;
+    const byte* seed[WC_SHAKE_X4_LANES] = { seed0, seed1, seed2, seed3 };
+    byte* out[WC_SHAKE_X4_LANES] = { out0, out1, out2, out3 };
+
+    if ((ret = wc_InitShake128_x4(&shake, NULL, INVALID_DEVID)) == 0) {
+        ret = wc_Shake128_x4_Absorb(&shake, seed, seedLen);
+    }
+    if (ret == 0) {
+        ret = wc_Shake128_x4_SqueezeBlocks(&shake, out, blocks);
+    }
+    wc_Shake128_x4_Free(&shake);
+    \endcode
+
+    \sa wc_Shake128_x4_Absorb
+    \sa wc_Shake128_x4_SqueezeBlocks
+    \sa wc_Shake128_x4_Free
+*/
+int wc_InitShake128_x4(wc_Shake_x4* shake, void* heap, int devId);
+
+/*!
+    \ingroup SHA
+
+    \brief Absorbs four messages of the same length, one into each state,
+    and pads them ready for squeezing. Call once after initializing.
+
+    \return 0 Returned upon successfully absorbing the data.
+    \return BAD_FUNC_ARG shake or data is NULL, or an entry of data is NULL
+    and len is not zero.
+
+    \param shake pointer to the four-state shake structure
+    \param data array of four pointers to the data to absorb
+    \param len length of each buffer in bytes
+
+    \sa wc_InitShake128_x4
+    \sa wc_Shake128_x4_SqueezeBlocks
+*/
+int wc_Shake128_x4_Absorb(wc_Shake_x4* shake, const byte* const* data,
+    word32 len);
+
+/*!
+    \ingroup SHA
+
+    \brief Squeezes blocks of output from each of the four states. Each
+    output buffer receives blockCnt * WC_SHA3_128_BLOCK_SIZE bytes. The
+    output of each state is the same as from wc_Shake128_SqueezeBlocks.
+
+    \return 0 Returned upon successfully squeezing.
+    \return BAD_FUNC_ARG shake or out is NULL, or an entry of out is NULL
+    and blockCnt is not zero.
+
+    \param shake pointer to the four-state shake structure
+    \param out array of four pointers to the output buffers
+    \param blockCnt number of blocks to write to each buffer
+
+    \sa wc_InitShake128_x4
+    \sa wc_Shake128_x4_Absorb
+*/
+int wc_Shake128_x4_SqueezeBlocks(wc_Shake_x4* shake, byte* const* out,
+    word32 blockCnt);
+
+/*!
+    \ingroup SHA
+
+    \brief Clears the four SHAKE128 states.
+
+    \return none No returns.
+
+    \param shake pointer to the four-state shake structure
+
+    \sa wc_InitShake128_x4
+*/
+void wc_Shake128_x4_Free(wc_Shake_x4* shake);
+
+/*!
+    \ingroup SHA
+
+    \brief Initializes four SHAKE256 states that are absorbed and squeezed
+    together. Used the same way as wc_InitShake128_x4.
+
+    \return 0 Returned upon successfully initializing.
+    \return BAD_FUNC_ARG shake is NULL.
+
+    \param shake pointer to the four-state shake structure to initialize
+    \param heap pointer to a heap hint, may be NULL
+    \param devId device identifier, use INVALID_DEVID
+
+    \sa wc_Shake256_x4_Absorb
+    \sa wc_Shake256_x4_SqueezeBlocks
+    \sa wc_Shake256_x4_Free
+*/
+int wc_InitShake256_x4(wc_Shake_x4* shake, void* heap, int devId);
+
+/*!
+    \ingroup SHA
+
+    \brief Absorbs four messages of the same length, one into each SHAKE256
+    state, and pads them ready for squeezing.
+
+    \return 0 Returned upon successfully absorbing the data.
+    \return BAD_FUNC_ARG shake or data is NULL, or an entry of data is NULL
+    and len is not zero.
+
+    \param shake pointer to the four-state shake structure
+    \param data array of four pointers to the data to absorb
+    \param len length of each buffer in bytes
+
+    \sa wc_InitShake256_x4
+    \sa wc_Shake256_x4_SqueezeBlocks
+*/
+int wc_Shake256_x4_Absorb(wc_Shake_x4* shake, const byte* const* data,
+    word32 len);
+
+/*!
+    \ingroup SHA
+
+    \brief Squeezes blocks of output from each of the four SHAKE256 states.
+    Each output buffer receives blockCnt * WC_SHA3_256_BLOCK_SIZE bytes.
+
+    \return 0 Returned upon successfully squeezing.
+    \return BAD_FUNC_ARG shake or out is NULL, or an entry of out is NULL
+    and blockCnt is not zero.
+
+    \param shake pointer to the four-state shake structure
+    \param out array of four pointers to the output buffers
+    \param blockCnt number of blocks to write to each buffer
+
+    \sa wc_InitShake256_x4
+    \sa wc_Shake256_x4_Absorb
+*/
+int wc_Shake256_x4_SqueezeBlocks(wc_Shake_x4* shake, byte* const* out,
+    word32 blockCnt);
+
+/*!
+    \ingroup SHA
+
+    \brief Clears the four SHAKE256 states.
+
+    \return none No returns.
+
+    \param shake pointer to the four-state shake structure
+
+    \sa wc_InitShake256_x4
+*/
+void wc_Shake256_x4_Free(wc_Shake_x4* shake);
@@ -2245,6 +2245,653 @@ int  wolfSSL_read(WOLFSSL* ssl, void* data, int sz);
 */
 int  wolfSSL_peek(WOLFSSL* ssl, void* data, int sz);
 
+/*!
+    \ingroup IO
+
+    \brief This function is a zero-copy alternative to wolfSSL_read(). The
+    record is decrypted in place and, instead of copying the plaintext into a
+    caller buffer, data is set to point at it inside the session's internal
+    input buffer. The view is pinned: no further records are read and the
+    input buffer is not moved or freed until the caller consumes the data with
+    wolfSSL_read_release(). While pinned, calling wolfSSL_read_zc() again
+    returns the unconsumed remainder of the same record, and wolfSSL_read()
+    copies from it as usual. Operations that need to read more records from
+    the peer return WOLFSSL_ERROR_WANT_READ until the view is released.
+
+    \return >0 the number of bytes available at data.
+    \return 0 on a clean (close notify alert) shutdown or when the peer
+    closed the connection.
+    \return WOLFSSL_FATAL_ERROR on error, or when using non-blocking sockets
+    and WOLFSSL_ERROR_WANT_READ or WOLFSSL_ERROR_WANT_WRITE was received. Use
+    wolfSSL_get_error() to get a specific error code.
+    \return BAD_FUNC_ARG if ssl or data is NULL.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param data set to point at the decrypted application data.
+
+    _Example_
+    \code
+    WOLFSSL* ssl;
+    const unsigned char* view;
+    int sz;
+    ...
+    sz = wolfSSL_read_zc(ssl, &view);
+    if (sz > 0) {
+        // process sz bytes at view
+        wolfSSL_read_release(ssl, sz);
+    }
+    \endcode
+
+    \sa wolfSSL_read_release
+    \sa wolfSSL_read
+*/
+int  wolfSSL_read_zc(WOLFSSL* ssl, const unsigned char** data);
+
+/*!
+    \ingroup IO
+
+    \brief This function consumes sz bytes of the view handed out by
+    wolfSSL_read_zc(). A partial release advances the view; once all of the
+    record's data has been released the input buffer is unpinned and the next
+    call to wolfSSL_read_zc() or wolfSSL_read() processes the next record.
+    Pointers previously returned by wolfSSL_read_zc() must not be used after
+    the view is fully released.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ssl is NULL or sz is negative or larger than the
+    data remaining in the view.
+    \return BAD_STATE_E if no view is outstanding.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param sz number of bytes consumed from the front of the view.
+
+    _Example_
+    \code
+    WOLFSSL* ssl;
+    const unsigned char* view;
+    int sz = wolfSSL_read_zc(ssl, &view);
+    ...
+    wolfSSL_read_release(ssl, sz);
+    \endcode
+
+    \sa wolfSSL_read_zc
+*/
+int  wolfSSL_read_release(WOLFSSL* ssl, int sz);
+
+/*!
+    \ingroup IO
+
+    \brief Sets how many application data records a single wolfSSL_write()
+    or wolfSSL_writev() call builds back-to-back in the output buffer before
+    sending them with one call to the send callback. Larger batches mean fewer
+    send calls and keep the cipher busy on consecutive records, at the cost of
+    an output buffer of up to records times the maximum record size for each
+    connection, too big for the pool of wolfSSL_CTX_set_record_pool(). So
+    batching is off by default: a value of 1 sends every record as soon as it
+    is built. The default is WOLFSSL_SEND_BATCH (1) and the maximum
+    WOLFSSL_MAX_SEND_BATCH (16); both can be changed at build time. DTLS,
+    partial write mode and asynchronous crypto always send one record at a
+    time. WOLFSSL objects take the value from the WOLFSSL_CTX when they are
+    created.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ctx is NULL or records is out of range.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    \param records number of records per send, 1 to WOLFSSL_MAX_SEND_BATCH.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    ...
+    if (wolfSSL_CTX_set_send_batch(ctx, 8) != WOLFSSL_SUCCESS) {
+        // invalid batch size
+    }
+    \endcode
+
+    \sa wolfSSL_set_send_batch
+    \sa wolfSSL_get_send_batch
+    \sa wolfSSL_write
+*/
+int  wolfSSL_CTX_set_send_batch(WOLFSSL_CTX* ctx, int records);
+
+/*!
+    \ingroup IO
+
+    \brief Sets the number of application data records built before they are
+    sent together for a single session. See wolfSSL_CTX_set_send_batch().
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ssl is NULL or records is out of range.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param records number of records per send, 1 to WOLFSSL_MAX_SEND_BATCH.
+
+    _Example_
+    \code
+    WOLFSSL* ssl;
+    ...
+    wolfSSL_set_send_batch(ssl, 1); // flush every record
+    \endcode
+
+    \sa wolfSSL_CTX_set_send_batch
+    \sa wolfSSL_get_send_batch
+*/
+int  wolfSSL_set_send_batch(WOLFSSL* ssl, int records);
+
+/*!
+    \ingroup IO
+
+    \brief Returns the number of application data records built before they
+    are sent together for the session.
+
+    \return the send batch size on success.
+    \return BAD_FUNC_ARG if ssl is NULL.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+
+    _Example_
+    \code
+    WOLFSSL* ssl;
+    int records = wolfSSL_get_send_batch(ssl);
+    \endcode
+
+    \sa wolfSSL_set_send_batch
+    \sa wolfSSL_CTX_set_send_batch
+*/
+int  wolfSSL_get_send_batch(const WOLFSSL* ssl);
+
+/*!
+    \ingroup IO
+
+    \brief Lends record buffers to the connections made from ctx out of a
+    pool instead of allocating one each time a connection needs more than its
+    small static buffer (a full size record, a certificate chain) and freeing
+    it once the connection is idle again. Returned buffers are kept for reuse,
+    so many keep-alive connections cost one static buffer each while idle and
+    busy connections don't go through the allocator for every record. The pool
+    keeps one freelist per thread (WOLFSSL_RECORD_POOL_LISTS of them) so
+    threads don't contend on a lock. Needs that don't fit a pooled buffer, like
+    a write batching several records, are still allocated. maxIdle can be
+    changed at any time; bufSz only while no buffer is lent out. Not available
+    with WOLFSSL_STATIC_MEMORY, which has its own I/O pools.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ctx is NULL or maxIdle or bufSz is out of range.
+    \return BAD_STATE_E if bufSz changes while buffers are lent out.
+    \return MEMORY_E if the pool can't be allocated.
+    \return NOT_COMPILED_IN if built with WOLFSSL_NO_RECORD_POOL.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    \param maxIdle number of returned buffers kept for reuse, spread over the
+    freelists. 0 stops lending.
+    \param bufSz usable size of a pooled buffer, 0 for one full size record
+    (WOLFSSL_RECORD_POOL_BUF_SZ).
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    ...
+    // keep up to 256 record buffers around, one record each
+    if (wolfSSL_CTX_set_record_pool(ctx, 256, 0) != WOLFSSL_SUCCESS) {
+        // pool not set up, buffers are allocated per connection
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_get_record_pool_stats
+    \sa wolfSSL_CTX_set_send_batch
+*/
+int  wolfSSL_CTX_set_record_pool(WOLFSSL_CTX* ctx, int maxIdle, int bufSz);
+
+/*!
+    \ingroup IO
+
+    \brief Reports how the record buffer pool of ctx is used: buffers handed
+    out, how many of those were reused without allocating, buffers held by
+    connections now and at most, and buffers kept idle. The peak is tracked
+    per freelist and summed, so with several threads it can be above the
+    number of buffers ever lent out at the same time. All fields are 0 when no
+    pool was set up.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ctx or stats is NULL.
+    \return NOT_COMPILED_IN if built with WOLFSSL_NO_RECORD_POOL.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    \param stats filled with the pool's counters.
+
+    _Example_
+    \code
+    WOLFSSL_RECORD_POOL_STATS stats;
+    if (wolfSSL_CTX_get_record_pool_stats(ctx, &stats) == WOLFSSL_SUCCESS) {
+        printf("hits %lu/%lu, peak %u\n", stats.hits, stats.gets,
+               stats.peakInUse);
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_set_record_pool
+*/
+int  wolfSSL_CTX_get_record_pool_stats(WOLFSSL_CTX* ctx,
+                                       WOLFSSL_RECORD_POOL_STATS* stats);
+
+/*!
+    \ingroup Setup
+
+    \brief Frees everything a connection with a finished handshake can do
+    without. This covers the handshake-only state (see
+    wolfSSL_FreeHandshakeResources()), the peer's certificate and the dynamic
+    input and output buffers when they hold no data. Buffers go back to the
+    heap, or to the record buffer pool of the CTX when one is set. Use it on
+    connections that are about to go idle. Records sent or received
+    afterwards allocate buffers again. State needed later is kept:
+    - secure renegotiation;
+    - TLS 1.3 post-handshake authentication offered by the client;
+    - session ticket and KeyUpdate processing;
+    - the last DTLS flight until the peer is known to have it.
+    Built with SESSION_CERTS, wolfSSL_get_peer_certificate() decodes the
+    certificate again from the session.
+
+    \return number of bytes released. Only the main structures and buffers
+    are counted, so this is a lower bound.
+    \return BAD_FUNC_ARG if ssl is NULL.
+    \return BAD_STATE_E if the handshake isn't done.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+
+    _Example_
+    \code
+    WOLFSSL* ssl;
+    int released;
+    ...
+    // connection goes idle waiting for the next publish
+    released = wolfSSL_compact(ssl);
+    if (released < 0) {
+        // handshake still in progress
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_set_auto_compact
+    \sa wolfSSL_CTX_set_record_pool
+*/
+int  wolfSSL_compact(WOLFSSL* ssl);
+
+/*!
+    \ingroup Setup
+
+    \brief Compacts the connections made from ctx as soon as their handshake
+    is done (see wolfSSL_compact()). Use this for servers with many
+    long-lived, mostly idle connections. The peer's certificate is released
+    at the end of the handshake, so inspect it in the verify callback.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ctx is NULL.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    \param on 1 to compact after the handshake, 0 not to (default).
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx = wolfSSL_CTX_new(wolfTLS_server_method());
+    wolfSSL_CTX_set_auto_compact(ctx, 1);
+    \endcode
+
+    \sa wolfSSL_set_auto_compact
+    \sa wolfSSL_compact
+*/
+int  wolfSSL_CTX_set_auto_compact(WOLFSSL_CTX* ctx, int on);
+
+/*!
+    \ingroup Setup
+
+    \brief Turns automatic compaction after the handshake on or off for one
+    session. See wolfSSL_CTX_set_auto_compact().
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ssl is NULL.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param on 1 to compact after the handshake, 0 not to.
+
+    _Example_
+    \code
+    WOLFSSL* ssl = wolfSSL_new(ctx);
+    wolfSSL_set_auto_compact(ssl, 0); // this one needs the peer cert later
+    \endcode
+
+    \sa wolfSSL_CTX_set_auto_compact
+    \sa wolfSSL_compact
+*/
+int  wolfSSL_set_auto_compact(WOLFSSL* ssl, int on);
+
+/*!
+    \ingroup CertsKeys
+
+    \brief Checks the signatures of the certificate chain a peer sends on a
+    pool of worker threads owned by ctx. When the Certificate message arrives,
+    the check of each certificate below the top of the chain against the
+    public key of the certificate sent after it is queued on the workers, and
+    the top certificate is verified against the trusted CAs in the calling
+    thread meanwhile. The chain is then walked as usual; a certificate's
+    signature is only checked again if its worker failed or if the signer
+    found for it has a different key. The handshake thread waits for the
+    workers as it reaches each certificate, so the latency of a chain of n
+    certificates drops towards that of one signature check. The pool is shared
+    by all connections of ctx and is stopped when ctx is freed. Requires
+    WOLFSSL_CHAIN_VERIFY_POOL (--enable-chain-verify-pool).
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ctx is NULL or workers is negative or more than
+    WOLFSSL_CHAIN_VERIFY_MAX_WORKERS.
+    \return MEMORY_E if the pool can't be allocated.
+    \return THREAD_CREATE_E if a worker can't be started.
+    \return NOT_COMPILED_IN if built without WOLFSSL_CHAIN_VERIFY_POOL.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    \param workers number of worker threads, 0 stops the pool. Replaces an
+    existing pool, so call it before handshakes use ctx.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    ...
+    wolfSSL_CTX_set_verify(ctx, WOLFSSL_VERIFY_PEER |
+        WOLFSSL_VERIFY_FAIL_IF_NO_PEER_CERT, NULL);
+    if (wolfSSL_CTX_set_verify_workers(ctx, 4) != WOLFSSL_SUCCESS) {
+        // chains are verified in the handshake thread only
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_set_verify
+*/
+int  wolfSSL_CTX_set_verify_workers(WOLFSSL_CTX* ctx, int workers);
+
+/*!
+    \ingroup Setup
+
+    \brief Keeps key pairs of a TLS 1.3 key share group generated ahead of the
+    handshakes of ctx. When a handshake needs a key share of the group it
+    takes a ready key pair instead of generating one; each key pair is handed
+    to one handshake only and is freed with it. A handshake that finds none
+    ready counts an underrun and generates its key pair as usual. The pool is
+    refilled by wolfSSL_CTX_keyshare_pool_fill() or by the thread of
+    wolfSSL_CTX_keyshare_pool_start(). X25519, SECP256R1 and the Kyber
+    groups are supported; a Kyber key pair is only used by clients as the
+    server encapsulates. The pool is not used by connections with a device
+    id, a heap other than that of ctx, an ECC key generation callback or
+    static ephemeral keys. Requires WOLFSSL_KEY_SHARE_POOL
+    (--enable-keyshare-pool).
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ctx is NULL, the group is not supported or size
+    is negative or more than WOLFSSL_KEY_SHARE_POOL_MAX.
+    \return BUFFER_E if WOLFSSL_KEY_SHARE_POOL_GROUPS groups are pooled.
+    \return MEMORY_E if the pool can't be allocated.
+    \return NOT_COMPILED_IN if built without WOLFSSL_KEY_SHARE_POOL.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    \param group the named group, e.g. WOLFSSL_ECC_X25519.
+    \param size number of key pairs to keep ready, 0 stops pooling the group.
+    Lowering it frees the extra key pairs.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    ...
+    wolfSSL_CTX_set_keyshare_pool(ctx, WOLFSSL_ECC_X25519, 64);
+    wolfSSL_CTX_set_keyshare_pool(ctx, WOLFSSL_ECC_SECP256R1, 16);
+    wolfSSL_CTX_keyshare_pool_start(ctx);
+    \endcode
+
+    \sa wolfSSL_CTX_keyshare_pool_fill
+    \sa wolfSSL_CTX_keyshare_pool_start
+    \sa wolfSSL_CTX_get_keyshare_pool_stats
+*/
+int  wolfSSL_CTX_set_keyshare_pool(WOLFSSL_CTX* ctx, word16 group, int size);
+
+/*!
+    \ingroup Setup
+
+    \brief Generates missing key pairs of the key share pool of ctx on the
+    calling thread, the group missing the most first. Meant for event loops
+    that fill the pool when idle, in batches of max key pairs.
+
+    \return the number of key pairs generated, 0 when the pool is full.
+    \return BAD_FUNC_ARG if ctx is NULL or max is negative.
+    \return NOT_COMPILED_IN if built without WOLFSSL_KEY_SHARE_POOL.
+    \return other negative values if key generation failed.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    \param max maximum number of key pairs to generate, 0 for all missing.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    ...
+    // idle: top up the pool 8 key pairs at a time
+    while (wolfSSL_CTX_keyshare_pool_fill(ctx, 8) > 0 && !EventsPending()) {
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_set_keyshare_pool
+*/
+int  wolfSSL_CTX_keyshare_pool_fill(WOLFSSL_CTX* ctx, int max);
+
+/*!
+    \ingroup Setup
+
+    \brief Starts a thread that refills the key share pool of ctx whenever
+    handshakes take key pairs from it. The thread runs until ctx is freed.
+    Calling it again does nothing.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ctx is NULL.
+    \return MEMORY_E if the pool can't be allocated.
+    \return NOT_COMPILED_IN if built without WOLFSSL_KEY_SHARE_POOL or with
+    SINGLE_THREADED.
+    \return other negative values if the thread can't be started.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    ...
+    wolfSSL_CTX_set_keyshare_pool(ctx, WOLFSSL_ECC_X25519, 64);
+    if (wolfSSL_CTX_keyshare_pool_start(ctx) != WOLFSSL_SUCCESS) {
+        // fill from the event loop instead
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_set_keyshare_pool
+*/
+int  wolfSSL_CTX_keyshare_pool_start(WOLFSSL_CTX* ctx);
+
+/*!
+    \ingroup Setup
+
+    \brief Gets the counters of a group of the key share pool of ctx: the key
+    pairs handed to handshakes, the handshakes that found none ready, and the
+    key pairs ready now. A rising underrun count means the pool is too small
+    or refilled too slowly. All counters are zero for groups not pooled.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ctx or stats is NULL.
+    \return NOT_COMPILED_IN if built without WOLFSSL_KEY_SHARE_POOL.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    \param group the named group.
+    \param stats the counters.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    WOLFSSL_KEYSHARE_POOL_STATS stats;
+    ...
+    wolfSSL_CTX_get_keyshare_pool_stats(ctx, WOLFSSL_ECC_X25519, &stats);
+    printf("used %lu, underruns %lu\n", stats.used, stats.underruns);
+    \endcode
+
+    \sa wolfSSL_CTX_set_keyshare_pool
+*/
+int  wolfSSL_CTX_get_keyshare_pool_stats(WOLFSSL_CTX* ctx, word16 group,
+                                         WOLFSSL_KEYSHARE_POOL_STATS* stats);
+
+/*!
+    \ingroup Setup
+
+    \brief Turns off, or back on, sending the TLS 1.3 Certificate message of
+    a server from a body encoded once for the certificate and chain of ctx.
+    The body is encoded by the first handshake that needs it and again after
+    the certificate or chain of ctx changes. It is copied in place of
+    building the message when the connection sends the certificates of ctx
+    without certificate extensions, such as an OCSP staple, and the message
+    fits in one record. Servers with an SNI callback switching to a
+    CTX per host name get one body per CTX. On by default when built with
+    WOLFSSL_CERT_MSG_CACHE (--enable-certmsg-cache).
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ctx is NULL.
+    \return NOT_COMPILED_IN if built without WOLFSSL_CERT_MSG_CACHE.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    \param on 0 to build the message for each connection, 1 to copy it.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    ...
+    wolfSSL_CTX_use_certificate_chain_file(ctx, "server-chain.pem");
+    wolfSSL_CTX_set_cert_msg_cache(ctx, 1);
+    \endcode
+
+    \sa wolfSSL_CTX_use_certificate_chain_file
+*/
+int  wolfSSL_CTX_set_cert_msg_cache(WOLFSSL_CTX* ctx, int on);
+
+/*!
+    \ingroup IO
+
+    \brief Hands the record layer of connections made from ctx to Linux
+    kernel TLS once their handshake is done. The kernel then encrypts
+    application data on send and decrypts it on receive, which lets
+    wolfSSL_sendfile() send file pages without copying them through user
+    space. Only TLS 1.2 and TLS 1.3 over TCP with AES-GCM or
+    ChaCha20-Poly1305 cipher suites are offloaded, using the default socket
+    I/O callbacks on a single descriptor. When the kernel doesn't support a
+    direction, or the connection uses a feature that needs the record layer
+    (secure renegotiation, write duplication, record layer callbacks), wolfSSL
+    keeps processing records itself and the connection behaves as without this
+    option. A TLS 1.3 key update requires a kernel that can rekey an offloaded
+    socket. Requires building with --enable-ktls (WOLFSSL_KTLS).
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ctx is NULL.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    ...
+    wolfSSL_CTX_UseKTLS(ctx);
+    \endcode
+
+    \sa wolfSSL_UseKTLS
+    \sa wolfSSL_get_ktls
+    \sa wolfSSL_sendfile
+*/
+int  wolfSSL_CTX_UseKTLS(WOLFSSL_CTX* ctx);
+
+/*!
+    \ingroup IO
+
+    \brief Offloads the record layer of a single session to Linux kernel TLS
+    once its handshake is done. See wolfSSL_CTX_UseKTLS().
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ssl is NULL.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+
+    _Example_
+    \code
+    WOLFSSL* ssl;
+    ...
+    wolfSSL_UseKTLS(ssl);
+    wolfSSL_set_fd(ssl, sockfd);
+    \endcode
+
+    \sa wolfSSL_CTX_UseKTLS
+    \sa wolfSSL_get_ktls
+*/
+int  wolfSSL_UseKTLS(WOLFSSL* ssl);
+
+/*!
+    \ingroup IO
+
+    \brief Returns which directions of the session the kernel is currently
+    handling. Offload starts on the first read or write after the handshake.
+
+    \return a combination of WOLFSSL_KTLS_TX and WOLFSSL_KTLS_RX, 0 when
+    wolfSSL processes the records.
+    \return BAD_FUNC_ARG if ssl is NULL.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+
+    _Example_
+    \code
+    WOLFSSL* ssl;
+    ...
+    if (wolfSSL_get_ktls(ssl) & WOLFSSL_KTLS_TX) {
+        // sendfile goes straight from the page cache
+    }
+    \endcode
+
+    \sa wolfSSL_UseKTLS
+*/
+int  wolfSSL_get_ktls(const WOLFSSL* ssl);
+
+/*!
+    \ingroup IO
+
+    \brief Sends count bytes of the file fd, starting at *offset, as
+    application data and advances *offset by the bytes sent. The handshake is
+    completed first if needed. When the kernel encrypts for the session the
+    file goes to the socket with sendfile(2), otherwise it is read and written
+    through wolfSSL_write() in send batch sized chunks. With non-blocking
+    sockets the return may be short of count; call again with the updated
+    offset for the rest.
+
+    \return the number of bytes sent on success.
+    \return WOLFSSL_FATAL_ERROR on failure, call wolfSSL_get_error() for the
+    reason. WOLFSSL_ERROR_WANT_WRITE means nothing could be sent yet.
+    \return BAD_FUNC_ARG if ssl or offset is NULL or fd is negative.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param fd file descriptor open for reading.
+    \param offset file position to send from, updated on return.
+    \param count number of bytes to send.
+
+    _Example_
+    \code
+    WOLFSSL* ssl;
+    int fd = open("index.html", O_RDONLY);
+    off_t offset = 0;
+    struct stat st;
+    fstat(fd, &st);
+    while (offset < st.st_size) {
+        long ret = wolfSSL_sendfile(ssl, fd, &offset, st.st_size - offset);
+        if (ret < 0 &&
+                wolfSSL_get_error(ssl, ret) != WOLFSSL_ERROR_WANT_WRITE)
+            break;
+    }
+    \endcode
+
+    \sa wolfSSL_UseKTLS
+    \sa wolfSSL_write
+*/
+long wolfSSL_sendfile(WOLFSSL* ssl, int fd, off_t* offset, size_t count);
+
 /*!
     \ingroup IO
 
@@ -7538,14 +8185,19 @@ int wolfSSL_make_eap_keys(WOLFSSL* ssl, void* key, unsigned int len,
 /*!
     \ingroup IO
 
-    \brief Simulates writev semantics but doesn’t actually do block at a time
-    because of SSL_write() behavior and because front adds may be small.
-    Makes porting into software that uses writev easier.
+    \brief Writes the data held in an array of I/O vectors, like writev().
+    The vectors aren't coalesced into a temporary buffer: each record's
+    plaintext is gathered directly from the vectors into the output buffer and
+    encrypted in place. Records can be sent in batches, see
+    wolfSSL_CTX_set_send_batch(). Makes porting into software that uses writev
+    easier.
 
     \return >0 the number of bytes written upon success.
     \return 0 will be returned upon failure.  Call wolfSSL_get_error() for
     the specific error code.
-    \return MEMORY_ERROR will be returned if a memory error was encountered.
+    \return BAD_FUNC_ARG if ssl is NULL, iov is NULL with a non-zero iovcnt
+    or the total length of the vectors doesn't fit in an int.
+    \return MEMORY_E will be returned if a memory error was encountered.
     \return SSL_FATAL_ERROR will be returned upon failure when either an error
     occurred or, when using non-blocking sockets, the SSL_ERROR_WANT_READ or
     SSL_ERROR_WANT_WRITE error was received and and the application needs to
@@ -7575,6 +8227,7 @@ int wolfSSL_make_eap_keys(WOLFSSL* ssl, void* key, unsigned int len,
     \endcode
 
     \sa wolfSSL_write
+    \sa wolfSSL_CTX_set_send_batch
 */
 int wolfSSL_writev(WOLFSSL* ssl, const struct iovec* iov,
                                      int iovcnt);
@@ -11970,6 +12623,55 @@ int wolfSSL_CTX_set_TicketEncCtx(WOLFSSL_CTX* ctx, void*);
 */
 void* wolfSSL_CTX_get_TicketEncCtx(WOLFSSL_CTX* ctx);
 
+/*!
+    \brief This function sets the keys the default session ticket callback
+    encrypts and decrypts tickets with, replacing any set before. For server
+    side use. Give all servers of a fleet the same keys and they can redeem
+    each other's tickets. Of the keys whose encStart has passed and that can
+    still decrypt when a new ticket expires, the one with the latest encStart
+    encrypts new tickets. A ticket is decrypted with the key of the name in it
+    until that key's decEnd. Calling again with the next key added and an old
+    one removed rotates keys. Tickets are encrypted with the context's own
+    random keys when no key is scheduled, and the keys are not used when the
+    application sets its own ticket callback. Keys are found by name through a
+    hash and the one used is copied out under the context's lock.
+    With AES-GCM for tickets, the key is set up once for all the tickets sent
+    in a handshake.
+    Available when wolfSSL is built with WOLFSSL_TICKET_KEY_SET
+    (--enable-ticket-keyset).
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when ctx is NULL, cnt is negative or more than
+    WOLFSSL_TICKET_KEY_SET_MAX, keys is NULL and cnt is not 0, a key has decEnd
+    not after encStart or two keys have the same name.
+    \return BAD_MUTEX_E when locking the mutex fails.
+    \return NOT_COMPILED_IN when WOLFSSL_TICKET_KEY_SET is not defined.
+
+    \param ctx pointer to the WOLFSSL_CTX object, created
+    with wolfSSL_CTX_new().
+    \param keys array of keys. Times are in seconds of the clock used for
+    session timeouts - time() on POSIX systems. Only the first
+    WOLFSSL_TICKET_KEY_SZ bytes of each key are used.
+    \param cnt number of keys. 0 removes all keys.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    WOLFSSL_TICKET_KEY keys[2];
+    ...
+    // keys[0]: current key, keys[1]: next key starting in an hour
+    if (wolfSSL_CTX_set_ticket_keys(ctx, keys, 2) != WOLFSSL_SUCCESS) {
+        // failed to set keys
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_set_TicketEncCb
+    \sa wolfSSL_CTX_set_TicketHint
+    \sa wolfSSL_CTX_set_num_tickets
+*/
+int wolfSSL_CTX_set_ticket_keys(WOLFSSL_CTX* ctx,
+    const WOLFSSL_TICKET_KEY* keys, int cnt);
+
 /*!
     \brief This function sets the handshake done callback. The hsDoneCb and
     hsDoneCtx members of the WOLFSSL structure are set in this function.
@@ -12058,6 +12760,214 @@ int wolfSSL_get_session_stats(unsigned int* active,
                                           unsigned int* peak,
                                           unsigned int* maxSessions);
 
+/*!
+    \ingroup IO
+
+    \brief This function resizes the session cache so that it holds at least
+    sz sessions. Cached sessions are moved to the new cache rows; when
+    shrinking, sessions that no longer fit are evicted least recently used
+    first. The session cache is shared by all contexts. Requires
+    WOLFSSL_SHARDED_SESSION_CACHE (--enable-shardedcache).
+
+    \return SSL_SUCCESS returned on success.
+    \return BAD_FUNC_ARG returned if sz is 0 or too big.
+    \return BAD_STATE_E returned if wolfSSL_Init() hasn't been called.
+    \return MEMORY_E returned if allocating the new cache failed.
+    \return BAD_MUTEX_E returned if there was a mutex error.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure. May be NULL.
+    \param sz the minimum number of sessions the cache should hold.
+
+    _Example_
+    \code
+    if (wolfSSL_CTX_set_session_cache_size(ctx, 100000) != SSL_SUCCESS) {
+        // session cache not resized
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_get_session_cache_size
+    \sa wolfSSL_get_session_cache_stats
+*/
+int wolfSSL_CTX_set_session_cache_size(WOLFSSL_CTX* ctx, unsigned int sz);
+
+/*!
+    \ingroup IO
+
+    \brief This function returns the number of sessions the session cache can
+    hold. Requires WOLFSSL_SHARDED_SESSION_CACHE.
+
+    \return the session cache size in sessions.
+    \return 0 if wolfSSL_Init() hasn't been called.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure. May be NULL.
+
+    _Example_
+    \code
+    unsigned int sz = wolfSSL_CTX_get_session_cache_size(ctx);
+    \endcode
+
+    \sa wolfSSL_CTX_set_session_cache_size
+*/
+unsigned int wolfSSL_CTX_get_session_cache_size(WOLFSSL_CTX* ctx);
+
+/*!
+    \ingroup IO
+
+    \brief This function gets the session cache counters summed over all
+    rows of the cache. Counters are exact when atomic operations are
+    available. Requires WOLFSSL_SHARDED_SESSION_CACHE.
+
+    \return SSL_SUCCESS returned on success.
+    \return BAD_STATE_E returned if wolfSSL_Init() hasn't been called.
+    \return BAD_MUTEX_E returned if there was a mutex error.
+
+    \param hits number of lookups by session ID that found a session. May be
+    NULL.
+    \param misses number of lookups by session ID that found no session. May
+    be NULL.
+    \param evictions number of unexpired sessions replaced to make room for
+    another. May be NULL.
+    \param contention number of row lock requests made while another thread
+    held or waited on the row. May be NULL.
+
+    _Example_
+    \code
+    unsigned int hits, misses;
+    wolfSSL_get_session_cache_stats(&hits, &misses, NULL, NULL);
+    \endcode
+
+    \sa wolfSSL_CTX_set_session_cache_size
+*/
+int wolfSSL_get_session_cache_stats(unsigned int* hits, unsigned int* misses,
+                                    unsigned int* evictions,
+                                    unsigned int* contention);
+
+/*!
+    \ingroup IO
+
+    \brief This function sets an external session store that servers use to
+    resume each other's sessions. A server hands every new session to setCb
+    serialized with wolfSSL_i2d_SSL_SESSION and, when a TLS v1.2 or lower
+    ClientHello asks to resume a session not found in the local session
+    cache, looks it up with getCb. getCb returns the serialized size when
+    found, 0 when not found or WOLFSSL_CBIO_ERR_WANT_READ when the lookup is
+    still in progress. In the last case wolfSSL_accept() fails with
+    wolfSSL_get_error() returning WOLFSSL_ERROR_WANT_READ and must be called
+    again once the store has the answer; getCb is then called again for the
+    same session ID. Requires WOLFSSL_SESSION_STORE (--enable-sessionstore).
+
+    \return SSL_SUCCESS returned on success.
+    \return BAD_FUNC_ARG returned if ctx is NULL.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+    \param getCb looks up a serialized session by session ID. NULL disables
+    the store.
+    \param setCb stores a serialized session until expire, in seconds as
+    returned by LowResTimer(). May be NULL.
+    \param removeCb removes a session from the store. May be NULL.
+    \param storeCtx user context passed to the callbacks.
+
+    _Example_
+    \code
+    static int StoreGet(WOLFSSL* ssl, const unsigned char* id, int idSz,
+        unsigned char* data, int dataSz, void* ctx)
+    {
+        if (!lookup_started(ssl)) {
+            start_lookup(ssl, id, idSz);
+            return WOLFSSL_CBIO_ERR_WANT_READ;
+        }
+        return lookup_result(ssl, data, dataSz);
+    }
+
+    wolfSSL_CTX_SetSessionStore(ctx, StoreGet, StoreSet, StoreRemove, NULL);
+    \endcode
+
+    \sa wolfSSL_CTX_UseSessionStoreShm
+    \sa wolfSSL_i2d_SSL_SESSION
+*/
+int wolfSSL_CTX_SetSessionStore(WOLFSSL_CTX* ctx,
+        CallbackSessionStoreGet getCb, CallbackSessionStoreSet setCb,
+        CallbackSessionStoreRemove removeCb, void* storeCtx);
+
+/*!
+    \ingroup IO
+
+    \brief This function returns the size of shared memory needed for a
+    session store holding the given number of sessions. Requires
+    WOLFSSL_SESSION_STORE_SHM (--enable-sessionstore=shm).
+
+    \return the size in bytes on success.
+    \return BAD_FUNC_ARG returned if sessions is not positive or too big.
+
+    \param sessions the number of sessions to hold.
+
+    \sa wolfSSL_SessionStoreShm_Init
+*/
+int wolfSSL_SessionStoreShm_Size(int sessions);
+
+/*!
+    \ingroup IO
+
+    \brief This function formats shared memory as an empty session store.
+    Call it once, before the worker processes sharing the memory use it with
+    wolfSSL_CTX_UseSessionStoreShm(). Each set of entries is protected by a
+    process shared mutex.
+
+    \return SSL_SUCCESS returned on success.
+    \return BAD_FUNC_ARG returned if mem is NULL or memSz too small.
+    \return BAD_MUTEX_E returned if a mutex could not be initialized.
+
+    \param mem the shared memory, for example from mmap() with MAP_SHARED.
+    \param memSz the size of the shared memory in bytes.
+
+    _Example_
+    \code
+    int sz = wolfSSL_SessionStoreShm_Size(20000);
+    void* mem = mmap(NULL, sz, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    wolfSSL_SessionStoreShm_Init(mem, sz);
+    // fork workers, each calling wolfSSL_CTX_UseSessionStoreShm(ctx, mem)
+    \endcode
+
+    \sa wolfSSL_SessionStoreShm_Size
+    \sa wolfSSL_SessionStoreShm_Free
+    \sa wolfSSL_CTX_UseSessionStoreShm
+*/
+int wolfSSL_SessionStoreShm_Init(void* mem, int memSz);
+
+/*!
+    \ingroup IO
+
+    \brief This function releases the mutexes of a shared memory session
+    store. Call it once, after all worker processes are done with it.
+
+    \return SSL_SUCCESS returned on success.
+    \return BAD_FUNC_ARG returned if mem is not a session store.
+
+    \param mem the shared memory formatted by wolfSSL_SessionStoreShm_Init().
+
+    \sa wolfSSL_SessionStoreShm_Init
+*/
+int wolfSSL_SessionStoreShm_Free(void* mem);
+
+/*!
+    \ingroup IO
+
+    \brief This function sets a shared memory session store as the external
+    session store of the context.
+
+    \return SSL_SUCCESS returned on success.
+    \return BAD_FUNC_ARG returned if ctx is NULL or mem is not a session
+    store.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+    \param mem the shared memory formatted by wolfSSL_SessionStoreShm_Init().
+
+    \sa wolfSSL_CTX_SetSessionStore
+    \sa wolfSSL_SessionStoreShm_Init
+*/
+int wolfSSL_CTX_UseSessionStoreShm(WOLFSSL_CTX* ctx, void* mem);
+
 /*!
     \ingroup TLS
 
@@ -13285,6 +14195,49 @@ int  wolfSSL_send_hrr_cookie(WOLFSSL* ssl,
 */
 int wolfSSL_disable_hrr_cookie(WOLFSSL* ssl);
 
+/*!
+    \ingroup Setup
+
+    \brief This function is called on the server to send a HelloRetryRequest
+    without keeping any state of the first ClientHello. The ClientHello is
+    parsed on the stack, the HelloRetryRequest is sent with a Cookie and the
+    handshake hash is freed. The hash is rebuilt from the Cookie when the
+    second ClientHello arrives. A server waiting on many clients that sent an
+    unsupported key share then holds less memory for each. ClientHello
+    messages with a pre-shared key or ECH are handled as before. All objects
+    created from the context after this call use the mode and share the
+    secret used to protect the Cookie.
+    Available when wolfSSL is built with WOLFSSL_STATELESS_HRR
+    (--enable-stateless-hrr).
+
+    \param [in,out] ctx a pointer to a WOLFSSL_CTX structure, created with
+    wolfSSL_CTX_new().
+    \param [in] secret a pointer to a buffer holding the secret.
+    Passing NULL indicates to generate a new random secret.
+    \param [in] secretSz Size of the secret in bytes.
+    Passing 0 indicates to use the default size: WC_SHA256_DIGEST_SIZE.
+
+    \return WOLFSSL_SUCCESS if successful.
+    \return BAD_FUNC_ARG if ctx is NULL or not using TLS v1.3.
+    \return SIDE_ERROR if invoked on client.
+    \return MEMORY_ERROR if allocating memory for the secret fails.
+    \return NOT_COMPILED_IN if WOLFSSL_STATELESS_HRR is not defined.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    ...
+    if (wolfSSL_CTX_set_stateless_hrr(ctx, NULL, 0) != WOLFSSL_SUCCESS) {
+        // failed to set stateless HelloRetryRequest mode
+    }
+    \endcode
+
+    \sa wolfSSL_send_hrr_cookie
+    \sa wolfSSL_disable_hrr_cookie
+*/
+int wolfSSL_CTX_set_stateless_hrr(WOLFSSL_CTX* ctx,
+    const unsigned char* secret, unsigned int secretSz);
+
 /*!
     \ingroup Setup
 
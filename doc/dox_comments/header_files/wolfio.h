@@ -575,3 +575,174 @@ int wolfSSL_SetIO_ISOTP(WOLFSSL *ssl, isotp_wolfssl_ctx *ctx,
         can_recv_fn recv_fn, can_send_fn send_fn, can_delay_fn delay_fn,
         word32 receive_delay, char *receive_buffer, int receive_buffer_size,
         void *arg);
+
+/*!
+    \ingroup IO
+
+    \brief Creates a Linux io_uring that carries the socket I/O of up to
+    maxConns connections. Each connection gets a receive and a send area of
+    bufSz bytes owned by the ring; the receive areas are registered with the
+    kernel so reads land in them without a per-call buffer lookup. One ring
+    is meant to be driven by one thread. Available when wolfSSL is built with
+    --enable-io-uring (WOLFSSL_IO_URING).
+
+    \return pointer to the new ring on success.
+    \return NULL if maxConns is out of range or the ring could not be set up.
+
+    \param maxConns number of connections that can use the ring at once
+    (at most 16384).
+    \param bufSz size of each receive and send area. Use 0 for the default,
+    which holds one full TLS record.
+    \param heap heap hint used for the ring's memory, can be NULL.
+
+    _Example_
+    \code
+    WOLFSSL_URING* ring = wolfSSL_uring_new(1024, 0, NULL);
+    if (ring == NULL) {
+        // io_uring not available, fall back to the socket callbacks
+    }
+    wolfSSL_CTX_SetIO_uring(ctx, ring);
+    \endcode
+
+    \sa wolfSSL_uring_free
+    \sa wolfSSL_CTX_SetIO_uring
+    \sa wolfSSL_SetIO_uring
+    \sa wolfSSL_uring_wait
+*/
+WOLFSSL_URING* wolfSSL_uring_new(int maxConns, int bufSz, void* heap);
+
+/*!
+    \ingroup IO
+
+    \brief Frees a ring created with wolfSSL_uring_new(). Free the WOLFSSL
+    objects using the ring first. Operations still in the kernel are
+    cancelled and waited for.
+
+    \return none No returns.
+
+    \param ring the ring to free, can be NULL.
+
+    _Example_
+    \code
+    wolfSSL_free(ssl);
+    wolfSSL_uring_free(ring);
+    \endcode
+
+    \sa wolfSSL_uring_new
+*/
+void wolfSSL_uring_free(WOLFSSL_URING* ring);
+
+/*!
+    \ingroup IO
+
+    \brief Makes the WOLFSSL objects created from ctx do their socket I/O
+    through ring. The file descriptor set with wolfSSL_set_fd() is used, the
+    I/O callbacks and their contexts are not. A connection takes a slot of
+    the ring on its first read or write and gives it back when freed.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ctx or ring is NULL.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+    \param ring the ring created with wolfSSL_uring_new().
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx = wolfSSL_CTX_new(wolfTLS_server_method());
+    WOLFSSL_URING* ring = wolfSSL_uring_new(1024, 0, NULL);
+    if (wolfSSL_CTX_SetIO_uring(ctx, ring) != WOLFSSL_SUCCESS) {
+        // error setting io_uring
+    }
+    \endcode
+
+    \sa wolfSSL_SetIO_uring
+    \sa wolfSSL_uring_wait
+*/
+int wolfSSL_CTX_SetIO_uring(WOLFSSL_CTX* ctx, WOLFSSL_URING* ring);
+
+/*!
+    \ingroup IO
+
+    \brief Makes one WOLFSSL object do its socket I/O through ring. See
+    wolfSSL_CTX_SetIO_uring(). Must be called before the first read or
+    write.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if ssl or ring is NULL or ssl already holds a slot of
+    a ring.
+
+    \param ssl a pointer to a WOLFSSL structure, created using wolfSSL_new().
+    \param ring the ring created with wolfSSL_uring_new().
+
+    _Example_
+    \code
+    WOLFSSL* ssl = wolfSSL_new(ctx);
+    wolfSSL_set_fd(ssl, sockfd);
+    if (wolfSSL_SetIO_uring(ssl, ring) != WOLFSSL_SUCCESS) {
+        // error setting io_uring
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_SetIO_uring
+*/
+int wolfSSL_SetIO_uring(WOLFSSL* ssl, WOLFSSL_URING* ring);
+
+/*!
+    \ingroup IO
+
+    \brief Submits the reads and sends queued by all connections of the ring
+    with one system call. wolfSSL_uring_wait() does this too; call this
+    directly when the event loop does other work before waiting.
+
+    \return number of operations submitted, 0 when nothing was queued.
+    \return BAD_FUNC_ARG if ring is NULL.
+    \return SOCKET_ERROR_E if the kernel rejected the submission.
+
+    \param ring the ring created with wolfSSL_uring_new().
+
+    _Example_
+    \code
+    wolfSSL_write(ssl, msg, msgSz);  // queues the send
+    wolfSSL_uring_submit(ring);      // hands it to the kernel
+    \endcode
+
+    \sa wolfSSL_uring_wait
+*/
+int wolfSSL_uring_submit(WOLFSSL_URING* ring);
+
+/*!
+    \ingroup IO
+
+    \brief Submits queued operations and collects completions. Up to max
+    connections whose read or send finished are stored in ready; call the
+    wolfSSL_accept(), wolfSSL_connect(), wolfSSL_read() or wolfSSL_write()
+    that returned WANT_READ or WANT_WRITE on them again.
+
+    \return number of connections stored in ready.
+    \return BAD_FUNC_ARG if ring or ready is NULL or max is not positive.
+    \return SOCKET_ERROR_E if waiting on the ring failed.
+
+    \param ring the ring created with wolfSSL_uring_new().
+    \param ready array receiving the connections that can make progress.
+    \param max number of entries in ready.
+    \param timeoutMs milliseconds to wait when nothing is ready: negative
+    waits for a completion, 0 does not wait.
+
+    _Example_
+    \code
+    WOLFSSL* ready[64];
+    int i, n;
+    for (;;) {
+        n = wolfSSL_uring_wait(ring, ready, 64, -1);
+        if (n < 0)
+            break;
+        for (i = 0; i < n; i++)
+            handle_connection(ready[i]);  // resumes the blocked call
+    }
+    \endcode
+
+    \sa wolfSSL_uring_submit
+    \sa wolfSSL_CTX_SetIO_uring
+*/
+int wolfSSL_uring_wait(WOLFSSL_URING* ring, WOLFSSL** ready, int max,
+    int timeoutMs);
@@ -46,6 +46,9 @@ Or
 #include <wolfssl/wolfcrypt/hash.h> /* WC_MAX_DIGEST_SIZE */
 #include <wolfssl/test.h>
 #include <wolfssl/wolfio.h>
+#ifdef WOLF_CRYPTO_CB_POOL
+    #include <wolfssl/wolfcrypt/cryptocb.h>
+#endif
 #include <examples/benchmark/tls_bench.h>
 
 /* force certificate test buffers to be included via headers */
@@ -131,9 +134,20 @@ platform supports it"
     #endif
 #endif
 
+/* Largest packet, over 16kB spans several TLS records */
+#ifndef TEST_MAX_PACKET_SIZE
+    #ifdef BENCH_EMBEDDED
+        #define TEST_MAX_PACKET_SIZE    TEST_PACKET_SIZE
+    #else
+        #define TEST_MAX_PACKET_SIZE    (64 * 1024)
+    #endif
+#endif
+
 /* In memory transfer buffer maximum size */
-/* Must be large enough to handle max TLS packet size plus max TLS header MAX_MSG_EXTRA */
-#define MEM_BUFFER_SZ       (TEST_PACKET_SIZE + 38 + WC_MAX_DIGEST_SIZE)
+/* Must be large enough to handle max TLS packet size plus max TLS header MAX_MSG_EXTRA per record */
+#define MEM_BUFFER_SZ       (TEST_MAX_PACKET_SIZE + \
+    ((TEST_MAX_PACKET_SIZE + (16 * 1024) - 1) / (16 * 1024)) * \
+    (38 + WC_MAX_DIGEST_SIZE))
 #define SHOW_VERBOSE        0 /* Default output is tab delimited format */
 
 #if (!defined(NO_WOLFSSL_CLIENT) || !defined(NO_WOLFSSL_SERVER)) && \
@@ -335,6 +349,8 @@ typedef struct {
     word32 port;
     int packetSize; /* The data payload size in the packet */
     int maxSize;
+    int sendBatch;  /* Records per send, 0 for library default */
+    int recordPool; /* Idle record buffers pooled per CTX, 0 for no pool */
     int runTimeSec;
     int showPeerInfo;
     int showVerbose;
@@ -803,6 +819,18 @@ static int SetSocketNonBlocking(int sockFd)
 }
 #endif
 
+static void show_record_pool(WOLFSSL_CTX* ctx, const char* desc)
+{
+    WOLFSSL_RECORD_POOL_STATS stats;
+
+    if (wolfSSL_CTX_get_record_pool_stats(ctx, &stats) == WOLFSSL_SUCCESS &&
+            stats.gets > 0) {
+        fprintf(stderr, "%s record pool: %lu gets, %lu hits, peak %u, "
+                "idle %u\n", desc, stats.gets, stats.hits, stats.peakInUse,
+                stats.idle);
+    }
+}
+
 #ifndef NO_WOLFSSL_CLIENT
 static int SetupSocketAndConnect(info_t* info, const char* host,
     word32 port)
@@ -952,6 +980,19 @@ static int bench_tls_client(info_t* info)
     wolfSSL_CTX_SetIOSend(cli_ctx, ClientSend);
     wolfSSL_CTX_SetIORecv(cli_ctx, ClientRecv);
 
+    if (info->sendBatch > 0 &&
+            wolfSSL_CTX_set_send_batch(cli_ctx, info->sendBatch) !=
+                                                            WOLFSSL_SUCCESS) {
+        fprintf(stderr, "error setting send batch\n");
+        ret = BAD_FUNC_ARG; goto exit;
+    }
+    if (info->recordPool > 0 &&
+            wolfSSL_CTX_set_record_pool(cli_ctx, info->recordPool, 0) !=
+                                                            WOLFSSL_SUCCESS) {
+        fprintf(stderr, "error setting record pool\n");
+        ret = BAD_FUNC_ARG; goto exit;
+    }
+
     /* set cipher suite */
     ret = wolfSSL_CTX_set_cipher_list(cli_ctx, info->cipher);
     if (ret != WOLFSSL_SUCCESS) {
@@ -999,6 +1040,7 @@ static int bench_tls_client(info_t* info)
     /* BENCHMARK CONNECTIONS LOOP */
     while (!info->client.shutdown) {
         int writeSz = info->packetSize;
+        int rxSz;
     #ifdef BENCH_USE_NONBLOCK
         int err;
     #endif
@@ -1130,25 +1172,30 @@ static int bench_tls_client(info_t* info)
             info->client_stats.txTotal += ret;
             total_sz += ret;
 
-            /* read echo of message from server */
+            /* read echo of message from server, one record at a time */
             XMEMSET(readBuf, 0, readBufSz);
-            start = gettime_secs(1);
-        #ifndef BENCH_USE_NONBLOCK
-            ret = wolfSSL_read(cli_ssl, readBuf, readBufSz);
-        #else
+            rxSz = 0;
             do {
-                ret = wolfSSL_read(cli_ssl, readBuf, readBufSz);
-                err = wolfSSL_get_error(cli_ssl, ret);
-            }
-            while (err == WOLFSSL_ERROR_WANT_READ);
-        #endif
-            info->client_stats.rxTime += gettime_secs(0) - start;
-            if (ret < 0) {
-                fprintf(stderr, "error on client read\n");
-                ret = wolfSSL_get_error(cli_ssl, ret);
-                goto exit;
-            }
-            info->client_stats.rxTotal += ret;
+                start = gettime_secs(1);
+            #ifndef BENCH_USE_NONBLOCK
+                ret = wolfSSL_read(cli_ssl, readBuf + rxSz, readBufSz - rxSz);
+            #else
+                do {
+                    ret = wolfSSL_read(cli_ssl, readBuf + rxSz,
+                                       readBufSz - rxSz);
+                    err = wolfSSL_get_error(cli_ssl, ret);
+                }
+                while (err == WOLFSSL_ERROR_WANT_READ);
+            #endif
+                info->client_stats.rxTime += gettime_secs(0) - start;
+                if (ret < 0) {
+                    fprintf(stderr, "error on client read\n");
+                    ret = wolfSSL_get_error(cli_ssl, ret);
+                    goto exit;
+                }
+                info->client_stats.rxTotal += ret;
+                rxSz += ret;
+            } while (ret > 0 && rxSz < writeSz);
             ret = 0; /* reset return code */
 
             /* validate echo */
@@ -1178,6 +1225,8 @@ exit:
         wolfSSL_free(cli_ssl);
     }
     if (cli_ctx != NULL) {
+        if (info->showVerbose)
+            show_record_pool(cli_ctx, "Client");
         wolfSSL_CTX_free(cli_ctx);
     }
     XFREE(readBuf, NULL, DYNAMIC_TYPE_TMP_BUFFER);
@@ -1416,6 +1465,19 @@ static int bench_tls_server(info_t* info)
     wolfSSL_CTX_SetIOSend(srv_ctx, ServerSend);
     wolfSSL_CTX_SetIORecv(srv_ctx, ServerRecv);
 
+    if (info->sendBatch > 0 &&
+            wolfSSL_CTX_set_send_batch(srv_ctx, info->sendBatch) !=
+                                                            WOLFSSL_SUCCESS) {
+        fprintf(stderr, "error setting send batch\n");
+        ret = BAD_FUNC_ARG; goto exit;
+    }
+    if (info->recordPool > 0 &&
+            wolfSSL_CTX_set_record_pool(srv_ctx, info->recordPool, 0) !=
+                                                            WOLFSSL_SUCCESS) {
+        fprintf(stderr, "error setting record pool\n");
+        ret = BAD_FUNC_ARG; goto exit;
+    }
+
     /* set cipher suite */
     ret = wolfSSL_CTX_set_cipher_list(srv_ctx, info->cipher);
     if (ret != WOLFSSL_SUCCESS) {
@@ -1624,6 +1686,8 @@ exit:
         wolfSSL_free(srv_ssl);
     }
     if (srv_ctx != NULL) {
+        if (info->showVerbose)
+            show_record_pool(srv_ctx, "Server");
         wolfSSL_CTX_free(srv_ctx);
     }
     XFREE(readBuf, NULL, DYNAMIC_TYPE_TMP_BUFFER);
@@ -1669,6 +1733,353 @@ static THREAD_RETURN WOLFSSL_THREAD_NO_JOIN server_thread(void* args)
 #endif /* !NO_WOLFSSL_SERVER */
 
 
+#if defined(WOLFSSL_IO_URING) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER)
+enum {
+    URING_CONN_HANDSHAKE,
+    URING_CONN_IDLE,
+    URING_CONN_WRITE,
+    URING_CONN_READ
+};
+
+/* One side of a connection in io_uring mode */
+typedef struct {
+    WOLFSSL* ssl;
+    stats_t* stats;
+    byte*    buf;
+    int      server;
+    int      state;
+    int      rxSz;
+} uring_conn_t;
+
+static WOLFSSL_CTX* bench_uring_ctx(info_t* info, int server)
+{
+    WOLFSSL_CTX* ctx = NULL;
+    int tls13 = XSTRNCMP(info->cipher, "TLS13", 5) == 0;
+    int ret = WOLFSSL_SUCCESS;
+
+#ifdef WOLFSSL_TLS13
+    if (tls13) {
+        ctx = wolfSSL_CTX_new(server ? wolfTLSv1_3_server_method() :
+                                       wolfTLSv1_3_client_method());
+    }
+    else
+#endif
+    {
+    #if !defined(WOLFSSL_TLS13)
+        ctx = wolfSSL_CTX_new(server ? wolfSSLv23_server_method() :
+                                       wolfSSLv23_client_method());
+    #elif !defined(WOLFSSL_NO_TLS12)
+        ctx = wolfSSL_CTX_new(server ? wolfTLSv1_2_server_method() :
+                                       wolfTLSv1_2_client_method());
+    #endif
+    }
+    (void)tls13;
+    if (ctx == NULL) {
+        fprintf(stderr, "error creating ctx\n");
+        return NULL;
+    }
+
+#ifndef NO_CERTS
+    if (server) {
+    #ifdef HAVE_ECC
+        if (XSTRSTR(info->cipher, "ECDSA")) {
+            ret = wolfSSL_CTX_use_PrivateKey_buffer(ctx, ecc_key_der_256,
+                sizeof_ecc_key_der_256, WOLFSSL_FILETYPE_ASN1);
+            if (ret == WOLFSSL_SUCCESS) {
+                ret = wolfSSL_CTX_use_certificate_buffer(ctx,
+                    serv_ecc_der_256, sizeof_serv_ecc_der_256,
+                    WOLFSSL_FILETYPE_ASN1);
+            }
+        }
+        else
+    #endif
+        {
+            ret = wolfSSL_CTX_use_PrivateKey_buffer(ctx, server_key_der_2048,
+                sizeof_server_key_der_2048, WOLFSSL_FILETYPE_ASN1);
+            if (ret == WOLFSSL_SUCCESS) {
+                ret = wolfSSL_CTX_use_certificate_buffer(ctx,
+                    server_cert_der_2048, sizeof_server_cert_der_2048,
+                    WOLFSSL_FILETYPE_ASN1);
+            }
+        }
+    }
+    else {
+    #ifdef HAVE_ECC
+        if (XSTRSTR(info->cipher, "ECDSA")) {
+            ret = wolfSSL_CTX_load_verify_buffer(ctx, ca_ecc_cert_der_256,
+                sizeof_ca_ecc_cert_der_256, WOLFSSL_FILETYPE_ASN1);
+        }
+        else
+    #endif
+        {
+            ret = wolfSSL_CTX_load_verify_buffer(ctx, ca_cert_der_2048,
+                sizeof_ca_cert_der_2048, WOLFSSL_FILETYPE_ASN1);
+        }
+    }
+    if (ret != WOLFSSL_SUCCESS) {
+        fprintf(stderr, "error loading certificates\n");
+        wolfSSL_CTX_free(ctx);
+        return NULL;
+    }
+#endif /* !NO_CERTS */
+
+    if (info->sendBatch > 0 &&
+            wolfSSL_CTX_set_send_batch(ctx, info->sendBatch) !=
+                                                            WOLFSSL_SUCCESS) {
+        ret = BAD_FUNC_ARG;
+    }
+    if (info->recordPool > 0 &&
+            wolfSSL_CTX_set_record_pool(ctx, info->recordPool, 0) !=
+                                                            WOLFSSL_SUCCESS) {
+        ret = BAD_FUNC_ARG;
+    }
+    if (ret == WOLFSSL_SUCCESS)
+        ret = wolfSSL_CTX_set_cipher_list(ctx, info->cipher);
+#ifndef NO_DH
+    if (ret == WOLFSSL_SUCCESS)
+        ret = wolfSSL_CTX_SetMinDhKey_Sz(ctx, MIN_DHKEY_BITS);
+#endif
+    if (ret != WOLFSSL_SUCCESS) {
+        fprintf(stderr, "error setting up ctx\n");
+        wolfSSL_CTX_free(ctx);
+        return NULL;
+    }
+
+#ifndef NO_PSK
+    if (server) {
+        wolfSSL_CTX_set_psk_server_callback(ctx, my_psk_server_cb);
+    #ifdef WOLFSSL_TLS13
+        wolfSSL_CTX_set_psk_server_tls13_callback(ctx, my_psk_server_tls13_cb);
+    #endif
+    }
+    else {
+        wolfSSL_CTX_set_psk_client_callback(ctx, my_psk_client_cb);
+    #ifdef WOLFSSL_TLS13
+    #if !defined(WOLFSSL_PSK_TLS13_CB) && !defined(WOLFSSL_PSK_ONE_ID)
+        wolfSSL_CTX_set_psk_client_cs_callback(ctx, my_psk_client_cs_cb);
+    #else
+        wolfSSL_CTX_set_psk_client_tls13_callback(ctx, my_psk_client_tls13_cb);
+    #endif
+    #endif
+        wolfSSL_CTX_set_psk_callback_ctx(ctx, (void*)info->cipher);
+    }
+#endif /* !NO_PSK */
+
+    return ctx;
+}
+
+/* Moves a connection along until it would block.
+ * The client writes a packet and reads the echo, the server echoes. */
+static int bench_uring_step(info_t* info, uring_conn_t* conn)
+{
+    int ret, err;
+
+    for (;;) {
+        switch (conn->state) {
+            case URING_CONN_HANDSHAKE:
+                ret = conn->server ? wolfSSL_accept(conn->ssl) :
+                                     wolfSSL_connect(conn->ssl);
+                if (ret == WOLFSSL_SUCCESS) {
+                    conn->state = URING_CONN_IDLE;
+                    return 0;
+                }
+                break;
+
+            case URING_CONN_IDLE:
+                return 0;
+
+            case URING_CONN_WRITE:
+                ret = wolfSSL_write(conn->ssl, conn->buf, info->packetSize);
+                if (ret > 0) {
+                    conn->stats->txTotal += ret;
+                    conn->state = URING_CONN_READ;
+                    conn->rxSz = 0;
+                    continue;
+                }
+                break;
+
+            case URING_CONN_READ:
+            default:
+                ret = wolfSSL_read(conn->ssl, conn->buf + conn->rxSz,
+                                   info->packetSize - conn->rxSz);
+                if (ret > 0) {
+                    conn->stats->rxTotal += ret;
+                    conn->rxSz += ret;
+                    if (conn->rxSz == info->packetSize)
+                        conn->state = URING_CONN_WRITE;
+                    continue;
+                }
+                break;
+        }
+
+        err = wolfSSL_get_error(conn->ssl, ret);
+        if (err == WOLFSSL_ERROR_WANT_READ || err == WOLFSSL_ERROR_WANT_WRITE)
+            return 0;
+        fprintf(stderr, "%s error %d (%s)\n", conn->server ? "Server" :
+            "Client", err, wolfSSL_ERR_reason_error_string(err));
+        return err;
+    }
+}
+
+/* Handshake and echo pairs connections over loopback with the socket I/O
+ * of all of them going through one io_uring, in this thread. */
+static int bench_tls_uring(info_t* info, int pairs)
+{
+    WOLFSSL_CTX* cli_ctx = NULL;
+    WOLFSSL_CTX* srv_ctx = NULL;
+    WOLFSSL_URING* ring = NULL;
+    WOLFSSL** ready = NULL;
+    uring_conn_t* conns = NULL;
+    int listenFd = -1;
+    int ret = 0;
+    int i, n, left;
+    double start, elapsed = 0;
+
+    cli_ctx = bench_uring_ctx(info, 0);
+    srv_ctx = bench_uring_ctx(info, 1);
+    ring = wolfSSL_uring_new(2 * pairs, 0, NULL);
+    conns = (uring_conn_t*)XMALLOC(sizeof(uring_conn_t) * 2 * pairs, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    ready = (WOLFSSL**)XMALLOC(sizeof(WOLFSSL*) * 2 * pairs, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (cli_ctx == NULL || srv_ctx == NULL || ring == NULL || conns == NULL ||
+            ready == NULL) {
+        fprintf(stderr, "error setting up io_uring benchmark\n");
+        ret = MEMORY_E; goto exit;
+    }
+    XMEMSET(conns, 0, sizeof(uring_conn_t) * 2 * pairs);
+    wolfSSL_CTX_SetIO_uring(cli_ctx, ring);
+    wolfSSL_CTX_SetIO_uring(srv_ctx, ring);
+
+    ret = SetupSocketAndListen(&listenFd, info->port, 0);
+    if (ret != 0)
+        goto exit;
+#ifndef SINGLE_THREADED
+    info->serverListening = 1;
+#endif
+
+    /* conns[2i] is the client and conns[2i + 1] the server of pair i */
+    for (i = 0; i < 2 * pairs; i++) {
+        uring_conn_t* conn = &conns[i];
+        int sockFd;
+
+        conn->server = i & 1;
+        conn->stats = conn->server ? &info->server_stats : &info->client_stats;
+        if (conn->server) {
+            sockFd = accept(listenFd, NULL, NULL);
+        }
+        else {
+            ret = SetupSocketAndConnect(info, info->host, info->port);
+            if (ret != 0)
+                goto exit;
+            sockFd = info->client.sockFd;
+            info->client.sockFd = -1;
+        }
+        if (sockFd >= 0) {
+            /* small handshake flights must not wait on a delayed ACK */
+            int on = 1;
+            (void)setsockopt(sockFd, IPPROTO_TCP, TCP_NODELAY, &on,
+                             sizeof(on));
+        }
+        conn->buf = (byte*)XMALLOC(info->packetSize, NULL,
+            DYNAMIC_TYPE_TMP_BUFFER);
+        conn->ssl = wolfSSL_new(conn->server ? srv_ctx : cli_ctx);
+        if (sockFd < 0 || conn->buf == NULL || conn->ssl == NULL) {
+            if (sockFd >= 0)
+                CloseSocket(sockFd);
+            fprintf(stderr, "error setting up io_uring connection\n");
+            ret = MEMORY_E; goto exit;
+        }
+        XSTRNCPY((char*)conn->buf, kTestStr, info->packetSize);
+        wolfSSL_set_fd(conn->ssl, sockFd);
+        /* the io_uring callbacks use the descriptor, the I/O context can
+         * point back to the connection */
+        wolfSSL_SetIOReadCtx(conn->ssl, conn);
+    #if defined(WOLFSSL_TLS13) && defined(HAVE_SUPPORTED_CURVES)
+        if (!conn->server && info->group != 0 &&
+                wolfSSL_UseKeyShare(conn->ssl, info->group) !=
+                                                            WOLFSSL_SUCCESS) {
+            fprintf(stderr, "error setting client key share.\n");
+            ret = BAD_FUNC_ARG; goto exit;
+        }
+    #endif
+    }
+
+    /* all handshakes at once */
+    start = gettime_secs(1);
+    for (i = 0; i < 2 * pairs && ret == 0; i++)
+        ret = bench_uring_step(info, &conns[i]);
+    left = 2 * pairs;
+    while (ret == 0 && left > 0) {
+        n = wolfSSL_uring_wait(ring, ready, 2 * pairs, -1);
+        if (n < 0) {
+            ret = n; break;
+        }
+        for (i = 0; i < n && ret == 0; i++) {
+            uring_conn_t* conn = (uring_conn_t*)wolfSSL_GetIOReadCtx(ready[i]);
+            if (conn->state != URING_CONN_HANDSHAKE)
+                continue;
+            ret = bench_uring_step(info, conn);
+            if (conn->state == URING_CONN_IDLE) {
+                conn->stats->connTime += gettime_secs(0) - start;
+                conn->stats->connCount++;
+                left--;
+            }
+        }
+    }
+    if (ret != 0)
+        goto exit;
+    if (info->showPeerInfo)
+        showPeer(conns[0].ssl);
+
+    /* echo until the run time is up */
+    start = gettime_secs(1);
+    for (i = 0; i < 2 * pairs && ret == 0; i++) {
+        conns[i].state = conns[i].server ? URING_CONN_READ : URING_CONN_WRITE;
+        ret = bench_uring_step(info, &conns[i]);
+    }
+    while (ret == 0 && elapsed < info->runTimeSec) {
+        n = wolfSSL_uring_wait(ring, ready, 2 * pairs, 100);
+        if (n < 0) {
+            ret = n; break;
+        }
+        for (i = 0; i < n && ret == 0; i++) {
+            ret = bench_uring_step(info,
+                (uring_conn_t*)wolfSSL_GetIOReadCtx(ready[i]));
+        }
+        elapsed = gettime_secs(0) - start;
+    }
+    info->client_stats.txTime = info->client_stats.rxTime = elapsed;
+    info->server_stats.txTime = info->server_stats.rxTime = elapsed;
+
+exit:
+    if (conns != NULL) {
+        for (i = 0; i < 2 * pairs; i++) {
+            if (conns[i].ssl != NULL) {
+                int sockFd = wolfSSL_get_fd(conns[i].ssl);
+                wolfSSL_free(conns[i].ssl);
+                CloseSocket(sockFd);
+            }
+            XFREE(conns[i].buf, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        }
+    }
+    wolfSSL_uring_free(ring);
+    XFREE(conns, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(ready, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    if (listenFd >= 0)
+        CloseAndCleanupListenSocket(&listenFd);
+    if (info->showVerbose && cli_ctx != NULL && srv_ctx != NULL) {
+        show_record_pool(cli_ctx, "Client");
+        show_record_pool(srv_ctx, "Server");
+    }
+    wolfSSL_CTX_free(cli_ctx);
+    wolfSSL_CTX_free(srv_ctx);
+
+    return ret;
+}
+#endif /* WOLFSSL_IO_URING && !NO_WOLFSSL_CLIENT && !NO_WOLFSSL_SERVER */
+
 static void print_stats(stats_t* wcStat, const char* desc, const char* cipher, const char *group, int verbose)
 {
     if (verbose) {
@@ -1712,6 +2123,646 @@ static void print_stats(stats_t* wcStat, const char* desc, const char* cipher, c
     }
 }
 
+#if (((defined(WOLFSSL_CHAIN_VERIFY_POOL) || \
+       defined(WOLFSSL_CERT_MSG_CACHE)) && !defined(NO_FILESYSTEM)) || \
+     defined(WOLF_CRYPTO_CB_POOL) || defined(WOLFSSL_TICKET_KEY_SET)) && \
+    !defined(NO_RSA) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER)
+#define BENCH_MEM_PIPE
+#define MEM_PIPE_SZ (32 * 1024)
+
+/* Both directions of one client/server pair handshaking in this thread */
+typedef struct mem_pipe_t {
+    byte buf[2][MEM_PIPE_SZ]; /* [0] to the server, [1] to the client */
+    int  len[2];
+} mem_pipe_t;
+
+typedef struct mem_end_t {
+    mem_pipe_t* pipe;
+    int         server;
+} mem_end_t;
+
+static int MemPipeRecv(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    mem_end_t* end = (mem_end_t*)ctx;
+    int dir = end->server ? 0 : 1;
+    int len = end->pipe->len[dir];
+
+    (void)ssl;
+    if (len == 0)
+        return WOLFSSL_CBIO_ERR_WANT_READ;
+    if (sz > len)
+        sz = len;
+    XMEMCPY(buf, end->pipe->buf[dir], sz);
+    XMEMMOVE(end->pipe->buf[dir], end->pipe->buf[dir] + sz, len - sz);
+    end->pipe->len[dir] = len - sz;
+    return sz;
+}
+
+static int MemPipeSend(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    mem_end_t* end = (mem_end_t*)ctx;
+    int dir = end->server ? 1 : 0;
+    int len = end->pipe->len[dir];
+
+    (void)ssl;
+    if (len + sz > MEM_PIPE_SZ)
+        return WOLFSSL_CBIO_ERR_WANT_WRITE;
+    XMEMCPY(end->pipe->buf[dir] + len, buf, sz);
+    end->pipe->len[dir] = len + sz;
+    return sz;
+}
+#endif /* BENCH_MEM_PIPE */
+
+#if defined(WOLFSSL_CHAIN_VERIFY_POOL) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_RSA) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER)
+/* Client handshake time with the server sending a three cert chain, with the
+ * chain signatures checked in place and on 1, 2, 4 and 8 workers */
+static int bench_chain_verify(int runtimeSec)
+{
+    static const int workers[] = { 0, 1, 2, 4, 8 };
+    mem_pipe_t* pipe = NULL;
+    mem_end_t cliEnd, srvEnd;
+    WOLFSSL_CTX* cli_ctx = NULL;
+    WOLFSSL_CTX* srv_ctx = NULL;
+    WOLFSSL* cli = NULL;
+    WOLFSSL* srv = NULL;
+    int ret = 0;
+    size_t w;
+
+    pipe = (mem_pipe_t*)XMALLOC(sizeof(mem_pipe_t), NULL,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (pipe == NULL)
+        return MEMORY_E;
+    cliEnd.pipe = srvEnd.pipe = pipe;
+    cliEnd.server = 0;
+    srvEnd.server = 1;
+
+    srv_ctx = wolfSSL_CTX_new(wolfSSLv23_server_method());
+    if (srv_ctx == NULL ||
+            wolfSSL_CTX_use_certificate_chain_file(srv_ctx,
+                "./certs/intermediate/server-chain.pem") != WOLFSSL_SUCCESS ||
+            wolfSSL_CTX_use_PrivateKey_buffer(srv_ctx, server_key_der_2048,
+                sizeof_server_key_der_2048, WOLFSSL_FILETYPE_ASN1) !=
+                                                            WOLFSSL_SUCCESS) {
+        fprintf(stderr, "error setting up chain verify server\n");
+        ret = -1; goto exit;
+    }
+    wolfSSL_CTX_SetIORecv(srv_ctx, MemPipeRecv);
+    wolfSSL_CTX_SetIOSend(srv_ctx, MemPipeSend);
+
+    for (w = 0; ret == 0 && w < sizeof(workers) / sizeof(workers[0]); w++) {
+        double start, elapsed = 0, total;
+        int count = 0;
+
+        cli_ctx = wolfSSL_CTX_new(wolfSSLv23_client_method());
+        if (cli_ctx == NULL ||
+                wolfSSL_CTX_load_verify_buffer(cli_ctx, ca_cert_der_2048,
+                    sizeof_ca_cert_der_2048, WOLFSSL_FILETYPE_ASN1) !=
+                                                            WOLFSSL_SUCCESS ||
+                wolfSSL_CTX_set_verify_workers(cli_ctx, workers[w]) !=
+                                                            WOLFSSL_SUCCESS) {
+            fprintf(stderr, "error setting up chain verify client\n");
+            ret = -1; break;
+        }
+        wolfSSL_CTX_SetIORecv(cli_ctx, MemPipeRecv);
+        wolfSSL_CTX_SetIOSend(cli_ctx, MemPipeSend);
+
+        total = gettime_secs(1);
+        while (ret == 0 && gettime_secs(0) - total < runtimeSec) {
+            int cliDone = 0, srvDone = 0;
+
+            pipe->len[0] = pipe->len[1] = 0;
+            cli = wolfSSL_new(cli_ctx);
+            srv = wolfSSL_new(srv_ctx);
+            if (cli == NULL || srv == NULL) {
+                ret = MEMORY_E; break;
+            }
+            wolfSSL_SetIOReadCtx(cli, &cliEnd);
+            wolfSSL_SetIOWriteCtx(cli, &cliEnd);
+            wolfSSL_SetIOReadCtx(srv, &srvEnd);
+            wolfSSL_SetIOWriteCtx(srv, &srvEnd);
+
+            while (ret == 0 && (!cliDone || !srvDone)) {
+                if (!cliDone) {
+                    /* only the client side is timed */
+                    start = gettime_secs(1);
+                    ret = wolfSSL_connect(cli);
+                    elapsed += gettime_secs(0) - start;
+                    if (ret == WOLFSSL_SUCCESS)
+                        cliDone = 1;
+                    ret = (ret == WOLFSSL_SUCCESS ||
+                           wolfSSL_get_error(cli, ret) ==
+                                        WOLFSSL_ERROR_WANT_READ) ? 0 : -1;
+                }
+                if (ret == 0 && !srvDone) {
+                    ret = wolfSSL_accept(srv);
+                    if (ret == WOLFSSL_SUCCESS)
+                        srvDone = 1;
+                    ret = (ret == WOLFSSL_SUCCESS ||
+                           wolfSSL_get_error(srv, ret) ==
+                                        WOLFSSL_ERROR_WANT_READ) ? 0 : -1;
+                }
+            }
+            if (ret != 0)
+                fprintf(stderr, "chain verify handshake failed\n");
+
+            wolfSSL_free(cli);
+            cli = NULL;
+            wolfSSL_free(srv);
+            srv = NULL;
+            count++;
+        }
+
+        if (ret == 0 && count > 0) {
+            printf("Chain verify workers %d: %d handshakes, %.3f ms per "
+                   "client handshake\n", workers[w], count,
+                   elapsed * 1000 / count);
+        }
+        wolfSSL_CTX_free(cli_ctx);
+        cli_ctx = NULL;
+    }
+
+exit:
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+    wolfSSL_CTX_free(cli_ctx);
+    wolfSSL_CTX_free(srv_ctx);
+    XFREE(pipe, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+#endif
+
+#if defined(WOLF_CRYPTO_CB_POOL) && defined(BENCH_MEM_PIPE)
+#define CRYPTOCB_POOL_DEVID 7
+#define CRYPTOCB_POOL_PAIRS 16
+
+/* One client/server pair of the event loop below */
+typedef struct pool_pair_t {
+    mem_pipe_t pipe;
+    mem_end_t  cliEnd;
+    mem_end_t  srvEnd;
+    WOLFSSL*   cli;
+    WOLFSSL*   srv;
+    int        cliDone;
+    int        srvDone;
+} pool_pair_t;
+
+/* Continue a handshake, 0 while it is waiting on the peer or the device */
+static int PoolPairStep(WOLFSSL* ssl, int server, int* done)
+{
+    int ret = server ? wolfSSL_accept(ssl) : wolfSSL_connect(ssl);
+    int err;
+
+    if (ret == WOLFSSL_SUCCESS) {
+        *done = 1;
+        return 0;
+    }
+    err = wolfSSL_get_error(ssl, ret);
+    if (err == WOLFSSL_ERROR_WANT_READ || err == WOLFSSL_ERROR_WANT_WRITE)
+        return 0;
+#ifdef WOLFSSL_ASYNC_CRYPT
+    if (err == WC_PENDING_E)
+        return 0;
+#endif
+    return -1;
+}
+
+/* Handshakes per second of CRYPTOCB_POOL_PAIRS pairs driven from this thread,
+ * with the public key operations in place and on a pool of workers threads */
+static int bench_cryptocb_pool(int runtimeSec, int workers)
+{
+    pool_pair_t* pairs = NULL;
+    WOLFSSL_CTX* cli_ctx = NULL;
+    WOLFSSL_CTX* srv_ctx = NULL;
+    wc_CryptoCbPool* pool = NULL;
+    int flags = 0;
+    int ret = 0;
+    int run, i;
+
+#ifdef WOLFSSL_ASYNC_CRYPT
+    flags = WC_CRYPTOCB_POOL_FLAG_ASYNC;
+#endif
+
+    pairs = (pool_pair_t*)XMALLOC(sizeof(pool_pair_t) * CRYPTOCB_POOL_PAIRS,
+        NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    if (pairs == NULL)
+        return MEMORY_E;
+    XMEMSET(pairs, 0, sizeof(pool_pair_t) * CRYPTOCB_POOL_PAIRS);
+
+    for (run = 0; ret == 0 && run < 2; run++) {
+        int devId = INVALID_DEVID;
+        double start, elapsed = 0;
+        int count = 0;
+
+        if (run == 1) {
+            ret = wc_CryptoCbPool_New(&pool, CRYPTOCB_POOL_DEVID, workers,
+                flags, NULL);
+            if (ret != 0) {
+                fprintf(stderr, "error starting crypto callback pool %d\n",
+                        ret);
+                break;
+            }
+            devId = CRYPTOCB_POOL_DEVID;
+        }
+
+        srv_ctx = wolfSSL_CTX_new(wolfSSLv23_server_method());
+        cli_ctx = wolfSSL_CTX_new(wolfSSLv23_client_method());
+        if (srv_ctx == NULL || cli_ctx == NULL ||
+                wolfSSL_CTX_SetDevId(srv_ctx, devId) != WOLFSSL_SUCCESS ||
+                wolfSSL_CTX_SetDevId(cli_ctx, devId) != WOLFSSL_SUCCESS ||
+                wolfSSL_CTX_use_certificate_buffer(srv_ctx,
+                    server_cert_der_2048, sizeof_server_cert_der_2048,
+                    WOLFSSL_FILETYPE_ASN1) != WOLFSSL_SUCCESS ||
+                wolfSSL_CTX_use_PrivateKey_buffer(srv_ctx, server_key_der_2048,
+                    sizeof_server_key_der_2048, WOLFSSL_FILETYPE_ASN1) !=
+                                                            WOLFSSL_SUCCESS) {
+            fprintf(stderr, "error setting up crypto callback pool bench\n");
+            ret = -1; break;
+        }
+        /* the key exchange and server signature are measured */
+        wolfSSL_CTX_set_verify(cli_ctx, WOLFSSL_VERIFY_NONE, NULL);
+        wolfSSL_CTX_SetIORecv(srv_ctx, MemPipeRecv);
+        wolfSSL_CTX_SetIOSend(srv_ctx, MemPipeSend);
+        wolfSSL_CTX_SetIORecv(cli_ctx, MemPipeRecv);
+        wolfSSL_CTX_SetIOSend(cli_ctx, MemPipeSend);
+
+        start = gettime_secs(1);
+        while (ret == 0 && (elapsed = gettime_secs(0) - start) < runtimeSec) {
+            for (i = 0; ret == 0 && i < CRYPTOCB_POOL_PAIRS; i++) {
+                pool_pair_t* pair = &pairs[i];
+
+                if (pair->cli == NULL) {
+                    pair->pipe.len[0] = pair->pipe.len[1] = 0;
+                    pair->cliEnd.pipe = pair->srvEnd.pipe = &pair->pipe;
+                    pair->cliEnd.server = 0;
+                    pair->srvEnd.server = 1;
+                    pair->cliDone = pair->srvDone = 0;
+                    pair->cli = wolfSSL_new(cli_ctx);
+                    pair->srv = wolfSSL_new(srv_ctx);
+                    if (pair->cli == NULL || pair->srv == NULL) {
+                        ret = MEMORY_E; break;
+                    }
+                    wolfSSL_SetIOReadCtx(pair->cli, &pair->cliEnd);
+                    wolfSSL_SetIOWriteCtx(pair->cli, &pair->cliEnd);
+                    wolfSSL_SetIOReadCtx(pair->srv, &pair->srvEnd);
+                    wolfSSL_SetIOWriteCtx(pair->srv, &pair->srvEnd);
+                }
+
+                if (!pair->cliDone)
+                    ret = PoolPairStep(pair->cli, 0, &pair->cliDone);
+                if (ret == 0 && !pair->srvDone)
+                    ret = PoolPairStep(pair->srv, 1, &pair->srvDone);
+                if (ret != 0)
+                    fprintf(stderr, "crypto callback pool handshake failed\n");
+
+                if (ret == 0 && pair->cliDone && pair->srvDone) {
+                    count++;
+                    wolfSSL_free(pair->cli);
+                    pair->cli = NULL;
+                    wolfSSL_free(pair->srv);
+                    pair->srv = NULL;
+                }
+            }
+        }
+
+        if (ret == 0) {
+            if (run == 0)
+                printf("Public key in place:     ");
+            else
+                printf("Public key on %2d workers:", workers);
+            printf(" %d handshakes, %.1f handshakes/sec\n", count,
+                   count / elapsed);
+        }
+
+        /* handshakes in flight are dropped before the device goes away */
+        for (i = 0; i < CRYPTOCB_POOL_PAIRS; i++) {
+            wolfSSL_free(pairs[i].cli);
+            pairs[i].cli = NULL;
+            wolfSSL_free(pairs[i].srv);
+            pairs[i].srv = NULL;
+        }
+        wolfSSL_CTX_free(cli_ctx);
+        cli_ctx = NULL;
+        wolfSSL_CTX_free(srv_ctx);
+        srv_ctx = NULL;
+        wc_CryptoCbPool_Free(pool);
+        pool = NULL;
+    }
+
+    wolfSSL_CTX_free(cli_ctx);
+    wolfSSL_CTX_free(srv_ctx);
+    wc_CryptoCbPool_Free(pool);
+    XFREE(pairs, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+#endif
+
+#if defined(WOLFSSL_CERT_MSG_CACHE) && !defined(NO_FILESYSTEM) && \
+    defined(BENCH_MEM_PIPE)
+/* TLS 1.3 server handshake time sending a three cert chain, with the
+ * Certificate message built per connection and copied from the CTX */
+static int bench_cert_msg_cache(int runtimeSec)
+{
+    mem_pipe_t* pipe = NULL;
+    mem_end_t cliEnd, srvEnd;
+    WOLFSSL_CTX* cli_ctx = NULL;
+    WOLFSSL_CTX* srv_ctx = NULL;
+    WOLFSSL* cli = NULL;
+    WOLFSSL* srv = NULL;
+    int ret = 0;
+    int on;
+
+    pipe = (mem_pipe_t*)XMALLOC(sizeof(mem_pipe_t), NULL,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (pipe == NULL)
+        return MEMORY_E;
+    cliEnd.pipe = srvEnd.pipe = pipe;
+    cliEnd.server = 0;
+    srvEnd.server = 1;
+
+    srv_ctx = wolfSSL_CTX_new(wolfTLSv1_3_server_method());
+    cli_ctx = wolfSSL_CTX_new(wolfTLSv1_3_client_method());
+    if (srv_ctx == NULL || cli_ctx == NULL ||
+            wolfSSL_CTX_use_certificate_chain_file(srv_ctx,
+                "./certs/intermediate/server-chain.pem") != WOLFSSL_SUCCESS ||
+            wolfSSL_CTX_use_PrivateKey_buffer(srv_ctx, server_key_der_2048,
+                sizeof_server_key_der_2048, WOLFSSL_FILETYPE_ASN1) !=
+                                                            WOLFSSL_SUCCESS) {
+        fprintf(stderr, "error setting up certificate message cache bench\n");
+        ret = -1; goto exit;
+    }
+    /* the server side is measured */
+    wolfSSL_CTX_set_verify(cli_ctx, WOLFSSL_VERIFY_NONE, NULL);
+    wolfSSL_CTX_SetIORecv(srv_ctx, MemPipeRecv);
+    wolfSSL_CTX_SetIOSend(srv_ctx, MemPipeSend);
+    wolfSSL_CTX_SetIORecv(cli_ctx, MemPipeRecv);
+    wolfSSL_CTX_SetIOSend(cli_ctx, MemPipeSend);
+
+    for (on = 0; ret == 0 && on < 2; on++) {
+        double start, elapsed = 0, total;
+        int count = 0;
+
+        wolfSSL_CTX_set_cert_msg_cache(srv_ctx, on);
+
+        total = gettime_secs(1);
+        while (ret == 0 && gettime_secs(0) - total < runtimeSec) {
+            int cliDone = 0, srvDone = 0;
+
+            pipe->len[0] = pipe->len[1] = 0;
+            cli = wolfSSL_new(cli_ctx);
+            srv = wolfSSL_new(srv_ctx);
+            if (cli == NULL || srv == NULL) {
+                ret = MEMORY_E; break;
+            }
+            wolfSSL_SetIOReadCtx(cli, &cliEnd);
+            wolfSSL_SetIOWriteCtx(cli, &cliEnd);
+            wolfSSL_SetIOReadCtx(srv, &srvEnd);
+            wolfSSL_SetIOWriteCtx(srv, &srvEnd);
+
+            while (ret == 0 && (!cliDone || !srvDone)) {
+                if (!cliDone) {
+                    ret = wolfSSL_connect(cli);
+                    if (ret == WOLFSSL_SUCCESS)
+                        cliDone = 1;
+                    ret = (ret == WOLFSSL_SUCCESS ||
+                           wolfSSL_get_error(cli, ret) ==
+                                        WOLFSSL_ERROR_WANT_READ) ? 0 : -1;
+                }
+                if (ret == 0 && !srvDone) {
+                    start = gettime_secs(1);
+                    ret = wolfSSL_accept(srv);
+                    elapsed += gettime_secs(0) - start;
+                    if (ret == WOLFSSL_SUCCESS)
+                        srvDone = 1;
+                    ret = (ret == WOLFSSL_SUCCESS ||
+                           wolfSSL_get_error(srv, ret) ==
+                                        WOLFSSL_ERROR_WANT_READ) ? 0 : -1;
+                }
+            }
+            if (ret != 0)
+                fprintf(stderr, "certificate message cache handshake failed\n");
+
+            wolfSSL_free(cli);
+            cli = NULL;
+            wolfSSL_free(srv);
+            srv = NULL;
+            count++;
+        }
+
+        if (ret == 0 && count > 0) {
+            printf("Certificate message %s: %d handshakes, %.3f ms per "
+                   "server handshake, %.1f server handshakes/sec\n",
+                   on ? "cached" : "built ", count, elapsed * 1000 / count,
+                   count / elapsed);
+        }
+    }
+
+exit:
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+    wolfSSL_CTX_free(cli_ctx);
+    wolfSSL_CTX_free(srv_ctx);
+    XFREE(pipe, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+#endif
+
+#if defined(WOLFSSL_TICKET_KEY_SET) && defined(HAVE_SESSION_TICKET) && \
+    defined(WOLFSSL_TLS13) && !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) && \
+    defined(BENCH_MEM_PIPE)
+#define BENCH_TICKETS_PER_CONN 4
+
+/* One TLS 1.3 connection over the memory pipe, resuming *sess when set or
+ * else returning the new session in it. Server time in accept is added to
+ * srvTime and time of the last call, sending the tickets, to lastTime. */
+static int bench_ticket_conn(WOLFSSL_CTX* cli_ctx, WOLFSSL_CTX* srv_ctx,
+    mem_end_t* cliEnd, mem_end_t* srvEnd, WOLFSSL_SESSION** sess,
+    double* srvTime, double* lastTime)
+{
+    WOLFSSL* cli;
+    WOLFSSL* srv;
+    int resume = (*sess != NULL);
+    int cliDone = 0, srvDone = 0;
+    int ret = 0;
+    char buf[1];
+
+    cliEnd->pipe->len[0] = cliEnd->pipe->len[1] = 0;
+    cli = wolfSSL_new(cli_ctx);
+    srv = wolfSSL_new(srv_ctx);
+    if (cli == NULL || srv == NULL) {
+        ret = MEMORY_E;
+    }
+    else {
+        wolfSSL_SetIOReadCtx(cli, cliEnd);
+        wolfSSL_SetIOWriteCtx(cli, cliEnd);
+        wolfSSL_SetIOReadCtx(srv, srvEnd);
+        wolfSSL_SetIOWriteCtx(srv, srvEnd);
+        if (resume && wolfSSL_set_session(cli, *sess) != WOLFSSL_SUCCESS)
+            ret = -1;
+    }
+
+    while (ret == 0 && (!cliDone || !srvDone)) {
+        if (!cliDone) {
+            ret = wolfSSL_connect(cli);
+            if (ret == WOLFSSL_SUCCESS)
+                cliDone = 1;
+            ret = (ret == WOLFSSL_SUCCESS ||
+                   wolfSSL_get_error(cli, ret) ==
+                                WOLFSSL_ERROR_WANT_READ) ? 0 : -1;
+        }
+        if (ret == 0 && !srvDone) {
+            double start = gettime_secs(1);
+            double elapsed;
+
+            ret = wolfSSL_accept(srv);
+            elapsed = gettime_secs(0) - start;
+            *srvTime += elapsed;
+            if (ret == WOLFSSL_SUCCESS) {
+                srvDone = 1;
+                *lastTime += elapsed;
+            }
+            ret = (ret == WOLFSSL_SUCCESS ||
+                   wolfSSL_get_error(srv, ret) ==
+                                WOLFSSL_ERROR_WANT_READ) ? 0 : -1;
+        }
+    }
+    /* client takes in the tickets */
+    if (ret == 0 && (wolfSSL_read(cli, buf, sizeof(buf)) != WOLFSSL_FATAL_ERROR
+            || wolfSSL_get_error(cli, WOLFSSL_FATAL_ERROR) !=
+                                                    WOLFSSL_ERROR_WANT_READ)) {
+        ret = -1;
+    }
+    if (ret == 0 && resume && !wolfSSL_session_reused(srv)) {
+        fprintf(stderr, "ticket not redeemed\n");
+        ret = -1;
+    }
+    if (ret == 0 && !resume) {
+        *sess = wolfSSL_get1_session(cli);
+        if (*sess == NULL)
+            ret = -1;
+    }
+
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+
+    return ret;
+}
+
+/* Server time to issue TLS 1.3 session tickets, BENCH_TICKETS_PER_CONN per
+ * full handshake, and to redeem them in PSK only resumptions. Tickets are
+ * encrypted with the context's own keys and with an operator key set. */
+static int bench_ticket_keys(int runtimeSec)
+{
+    mem_pipe_t* pipe = NULL;
+    mem_end_t cliEnd, srvEnd;
+    WOLFSSL_CTX* cli_ctx = NULL;
+    WOLFSSL_CTX* srv_ctx = NULL;
+    WOLFSSL_SESSION* sess = NULL;
+    WOLFSSL_TICKET_KEY keys[WOLFSSL_TICKET_KEY_SET_MAX];
+    int ret = 0;
+    int i;
+    int on;
+
+    pipe = (mem_pipe_t*)XMALLOC(sizeof(mem_pipe_t), NULL,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (pipe == NULL)
+        return MEMORY_E;
+    cliEnd.pipe = srvEnd.pipe = pipe;
+    cliEnd.server = 0;
+    srvEnd.server = 1;
+
+    /* Keys retiring in turn, the latest to start encrypts. */
+    XMEMSET(keys, 0, sizeof(keys));
+    for (i = 0; i < WOLFSSL_TICKET_KEY_SET_MAX; i++) {
+        XMEMSET(keys[i].name, 'a' + i, sizeof(keys[i].name));
+        XMEMSET(keys[i].key, i + 1, sizeof(keys[i].key));
+        keys[i].encStart = (word32)i;
+        keys[i].decEnd = 0xffffffff - (word32)(WOLFSSL_TICKET_KEY_SET_MAX - i);
+    }
+
+    srv_ctx = wolfSSL_CTX_new(wolfTLSv1_3_server_method());
+    cli_ctx = wolfSSL_CTX_new(wolfTLSv1_3_client_method());
+    if (srv_ctx == NULL || cli_ctx == NULL ||
+            wolfSSL_CTX_use_certificate_buffer(srv_ctx, server_cert_der_2048,
+                sizeof_server_cert_der_2048, WOLFSSL_FILETYPE_ASN1) !=
+                                                            WOLFSSL_SUCCESS ||
+            wolfSSL_CTX_use_PrivateKey_buffer(srv_ctx, server_key_der_2048,
+                sizeof_server_key_der_2048, WOLFSSL_FILETYPE_ASN1) !=
+                                                            WOLFSSL_SUCCESS ||
+            wolfSSL_CTX_set_num_tickets(srv_ctx, BENCH_TICKETS_PER_CONN) !=
+                                                            WOLFSSL_SUCCESS) {
+        fprintf(stderr, "error setting up ticket key bench\n");
+        ret = -1; goto exit;
+    }
+    /* resumption cost is then the ticket and key schedule */
+    wolfSSL_CTX_no_dhe_psk(cli_ctx);
+    wolfSSL_CTX_no_dhe_psk(srv_ctx);
+    wolfSSL_CTX_set_verify(cli_ctx, WOLFSSL_VERIFY_NONE, NULL);
+    wolfSSL_CTX_SetIORecv(srv_ctx, MemPipeRecv);
+    wolfSSL_CTX_SetIOSend(srv_ctx, MemPipeSend);
+    wolfSSL_CTX_SetIORecv(cli_ctx, MemPipeRecv);
+    wolfSSL_CTX_SetIOSend(cli_ctx, MemPipeSend);
+
+    for (on = 0; ret == 0 && on < 2; on++) {
+        double srvTime = 0, lastTime = 0, total;
+        int issued = 0, redeemed = 0;
+
+        ret = wolfSSL_CTX_set_ticket_keys(srv_ctx, on ? keys : NULL,
+            on ? WOLFSSL_TICKET_KEY_SET_MAX : 0);
+        if (ret != WOLFSSL_SUCCESS) {
+            fprintf(stderr, "error setting ticket keys: %d\n", ret);
+            break;
+        }
+        ret = 0;
+
+        /* issue: full handshakes */
+        total = gettime_secs(1);
+        while (ret == 0 && gettime_secs(0) - total < runtimeSec) {
+            wolfSSL_SESSION_free(sess);
+            sess = NULL;
+            ret = bench_ticket_conn(cli_ctx, srv_ctx, &cliEnd, &srvEnd, &sess,
+                &srvTime, &lastTime);
+            issued += BENCH_TICKETS_PER_CONN;
+        }
+
+        /* redeem: resume with the last ticket */
+        srvTime = 0;
+        total = gettime_secs(1);
+        while (ret == 0 && gettime_secs(0) - total < runtimeSec) {
+            double ignore = 0;
+
+            ret = bench_ticket_conn(cli_ctx, srv_ctx, &cliEnd, &srvEnd, &sess,
+                &srvTime, &ignore);
+            redeemed++;
+        }
+
+        if (ret == 0 && issued > 0 && redeemed > 0) {
+            printf("Ticket keys %s: %d issued, %.1f us per ticket sent; "
+                   "%d redeemed, %.1f resumptions/sec\n",
+                   on ? "operator set" : "own         ", issued,
+                   lastTime * 1000000 / issued, redeemed,
+                   redeemed / srvTime);
+        }
+        else if (ret != 0) {
+            fprintf(stderr, "ticket key bench handshake failed\n");
+        }
+    }
+
+exit:
+    wolfSSL_SESSION_free(sess);
+    wolfSSL_CTX_free(cli_ctx);
+    wolfSSL_CTX_free(srv_ctx);
+    XFREE(pipe, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+#endif
+
 static void Usage(void)
 {
     fprintf(stderr, "tls_bench "    LIBWOLFSSL_VERSION_STRING
@@ -1728,15 +2779,33 @@ static void Usage(void)
 #endif
     fprintf(stderr, "-l <str>    Cipher suite list (: delimited)\n");
     fprintf(stderr, "-t <num>    Time <num> (seconds) to run each test (default %d)\n", BENCH_RUNTIME_SEC);
-    fprintf(stderr, "-p <num>    The packet size <num> in bytes [1-16kB] (default %d)\n", TEST_PACKET_SIZE);
+    fprintf(stderr, "-p <num>    The packet size <num> in bytes [1-%dkB] (default %d)\n",
+        (TEST_MAX_PACKET_SIZE > 16 * 1024 ? TEST_MAX_PACKET_SIZE : 16 * 1024) / 1024, TEST_PACKET_SIZE);
 #ifdef WOLFSSL_DTLS
     fprintf(stderr, "            In the case of DTLS, [1-8kB] (default %d)\n", TEST_DTLS_PACKET_SIZE);
 #endif
     fprintf(stderr, "-S <num>    The total size <num> in bytes (default %d)\n", TEST_MAX_SIZE);
+    fprintf(stderr, "-B <num>    Records built per send [1-%d] (default %d)\n", WOLFSSL_MAX_SEND_BATCH, WOLFSSL_SEND_BATCH);
+    fprintf(stderr, "-R <num>    Keep <num> idle record buffers in a per CTX pool\n");
     fprintf(stderr, "-v          Show verbose output\n");
 #ifdef DEBUG_WOLFSSL
     fprintf(stderr, "-d          Enable debug messages\n");
 #endif
+#ifdef WOLFSSL_IO_URING
+    fprintf(stderr, "-U <num>    Run <num> client/server pairs in one thread over io_uring\n");
+#endif
+#ifdef WOLFSSL_CHAIN_VERIFY_POOL
+    fprintf(stderr, "-V          Benchmark peer chain verify on 0, 1, 2, 4 and 8 workers\n");
+#endif
+#ifdef WOLFSSL_CERT_MSG_CACHE
+    fprintf(stderr, "-C          Server handshakes with the Certificate message built and cached\n");
+#endif
+#ifdef WOLFSSL_TICKET_KEY_SET
+    fprintf(stderr, "-K          Server ticket issue and redeem with own keys and an operator key set\n");
+#endif
+#ifdef WOLF_CRYPTO_CB_POOL
+    fprintf(stderr, "-A <num>    Handshakes/sec with public key ops in place and on a <num> thread crypto callback pool\n");
+#endif
 #ifndef SINGLE_THREADED
     fprintf(stderr, "-T <num>    Number of threaded server/client pairs (default %d)\n", NUM_THREAD_PAIRS);
     fprintf(stderr, "-m          Use local memory, not socket\n");
@@ -1841,6 +2910,7 @@ int bench_tls(void* args)
 #endif
 #if !defined(NO_WOLFSSL_SERVER) || !defined(SINGLE_THREADED)
     int argLocalMem = 0;
+    int argSendBatch = 0;
     int listenFd = -1;
 #endif
 #if defined(WOLFSSL_DTLS) && !defined(NO_WOLFSSL_SERVER)
@@ -1849,6 +2919,12 @@ int bench_tls(void* args)
 #ifdef WOLFSSL_DTLS
     int doDTLS = 0;
 #endif
+    int argUring = 0;
+    int argRecordPool = 0;
+    int argChainVerify = 0;
+    int argCryptoCbPool = 0;
+    int argCertMsgCache = 0;
+    int argTicketKeys = 0;
 #if defined(WOLFSSL_TLS13) && defined(HAVE_SUPPORTED_CURVES)
     int group_index = 0;
     int argDoGroups = 0;
@@ -1864,7 +2940,7 @@ int bench_tls(void* args)
     wolfSSL_Init();
 
     /* Parse command line arguments */
-    while ((ch = mygetopt(argc, argv, "?" "udeil:p:t:vT:sch:P:mS:g")) != -1) {
+    while ((ch = mygetopt(argc, argv, "?" "udeil:p:t:vVT:sch:P:mS:gB:U:R:A:CK")) != -1) {
         switch (ch) {
             case '?' :
                 Usage();
@@ -1915,7 +2991,8 @@ int bench_tls(void* args)
 
             case 'p' :
                 argTestPacketSize = atoi(myoptarg);
-                if (argTestPacketSize > (16 * 1024)) {
+                if (argTestPacketSize > (16 * 1024) &&
+                        argTestPacketSize > TEST_MAX_PACKET_SIZE) {
                     fprintf(stderr, "Invalid packet size %d\n", argTestPacketSize);
                     Usage();
                     ret = MY_EX_USAGE; goto exit;
@@ -1929,14 +3006,81 @@ int bench_tls(void* args)
                 argTestMaxSize = atoi(myoptarg);
                 break;
 
+            case 'B' :
+                argSendBatch = atoi(myoptarg);
+                if (argSendBatch < 1 || argSendBatch > WOLFSSL_MAX_SEND_BATCH) {
+                    fprintf(stderr, "Invalid send batch %d\n", argSendBatch);
+                    Usage();
+                    ret = MY_EX_USAGE; goto exit;
+                }
+                break;
+
             case 't' :
                 argRuntimeSec = atoi(myoptarg);
                 break;
 
+            case 'R' :
+                argRecordPool = atoi(myoptarg);
+                if (argRecordPool < 0) {
+                    fprintf(stderr, "Invalid record pool size %d\n",
+                            argRecordPool);
+                    Usage();
+                    ret = MY_EX_USAGE; goto exit;
+                }
+                break;
+
+            case 'U' :
+            #if defined(WOLFSSL_IO_URING) && !defined(NO_WOLFSSL_CLIENT) && \
+                !defined(NO_WOLFSSL_SERVER)
+                argUring = atoi(myoptarg);
+                if (argUring < 1) {
+                    fprintf(stderr, "Invalid io_uring pairs %d\n", argUring);
+                    Usage();
+                    ret = MY_EX_USAGE; goto exit;
+                }
+            #endif
+                break;
+
             case 'v' :
                 argShowVerbose = 1;
                 break;
 
+            case 'V' :
+            #if defined(WOLFSSL_CHAIN_VERIFY_POOL) && !defined(NO_FILESYSTEM) && \
+                !defined(NO_RSA) && !defined(NO_WOLFSSL_CLIENT) && \
+                !defined(NO_WOLFSSL_SERVER)
+                argChainVerify = 1;
+            #endif
+                break;
+
+            case 'A' :
+            #if defined(WOLF_CRYPTO_CB_POOL) && defined(BENCH_MEM_PIPE)
+                argCryptoCbPool = atoi(myoptarg);
+                if (argCryptoCbPool < 1) {
+                    fprintf(stderr, "Invalid crypto callback pool threads %d\n",
+                            argCryptoCbPool);
+                    Usage();
+                    ret = MY_EX_USAGE; goto exit;
+                }
+            #endif
+                break;
+
+            case 'C' :
+            #if defined(WOLFSSL_CERT_MSG_CACHE) && !defined(NO_FILESYSTEM) && \
+                defined(BENCH_MEM_PIPE)
+                argCertMsgCache = 1;
+            #endif
+                break;
+
+            case 'K' :
+            #if defined(WOLFSSL_TICKET_KEY_SET) && \
+                defined(HAVE_SESSION_TICKET) && defined(WOLFSSL_TLS13) && \
+                !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) && \
+                defined(BENCH_MEM_PIPE)
+                argTicketKeys = 1;
+            #endif
+                break;
+
             case 'T' :
             #ifndef SINGLE_THREADED
                 argThreadPairs = atoi(myoptarg);
@@ -1968,6 +3112,39 @@ int bench_tls(void* args)
     /* reset for test cases */
     myoptind = 0;
 
+    if (argChainVerify) {
+    #if defined(WOLFSSL_CHAIN_VERIFY_POOL) && !defined(NO_FILESYSTEM) && \
+        !defined(NO_RSA) && !defined(NO_WOLFSSL_CLIENT) && \
+        !defined(NO_WOLFSSL_SERVER)
+        ret = bench_chain_verify(argRuntimeSec);
+    #endif
+        goto exit;
+    }
+
+    if (argCryptoCbPool) {
+    #if defined(WOLF_CRYPTO_CB_POOL) && defined(BENCH_MEM_PIPE)
+        ret = bench_cryptocb_pool(argRuntimeSec, argCryptoCbPool);
+    #endif
+        goto exit;
+    }
+
+    if (argCertMsgCache) {
+    #if defined(WOLFSSL_CERT_MSG_CACHE) && !defined(NO_FILESYSTEM) && \
+        defined(BENCH_MEM_PIPE)
+        ret = bench_cert_msg_cache(argRuntimeSec);
+    #endif
+        goto exit;
+    }
+
+    if (argTicketKeys) {
+    #if defined(WOLFSSL_TICKET_KEY_SET) && defined(HAVE_SESSION_TICKET) && \
+        defined(WOLFSSL_TLS13) && !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) && \
+        defined(BENCH_MEM_PIPE)
+        ret = bench_ticket_keys(argRuntimeSec);
+    #endif
+        goto exit;
+    }
+
     if (argCipherList != NULL) {
         /* Use the list from CL argument */
         cipher = argCipherList;
@@ -1991,7 +3168,7 @@ int bench_tls(void* args)
 #endif
 
     /* for server or client side only, only 1 thread is allowed */
-    if (argServerOnly || argClientOnly) {
+    if (argServerOnly || argClientOnly || argUring > 0) {
         argThreadPairs = 1;
     }
 #ifdef SINGLE_THREADED
@@ -2087,6 +3264,8 @@ int bench_tls(void* args)
                 }
 
                 info->packetSize = argTestPacketSize;
+                info->sendBatch = argSendBatch;
+                info->recordPool = argRecordPool;
 
                 info->runTimeSec = argRuntimeSec;
                 info->maxSize = argTestMaxSize;
@@ -2119,6 +3298,12 @@ int bench_tls(void* args)
                 else if (argServerOnly) {
             #ifndef NO_WOLFSSL_SERVER
                     ret = bench_tls_server(info);
+            #endif
+                }
+                else if (argUring > 0) {
+            #if defined(WOLFSSL_IO_URING) && !defined(NO_WOLFSSL_CLIENT) && \
+                !defined(NO_WOLFSSL_SERVER)
+                    ret = bench_tls_uring(info, argUring);
             #endif
                 }
                 else {
@@ -2141,7 +3326,7 @@ int bench_tls(void* args)
 
     #ifndef SINGLE_THREADED
             /* For threading, wait for completion */
-            if (!argClientOnly && !argServerOnly) {
+            if (!argClientOnly && !argServerOnly && argUring == 0) {
                 /* Wait until threads are marked done */
                 do {
                      doShutdown = 1;
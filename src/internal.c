@@ -217,6 +217,10 @@ WOLFSSL_CALLBACKS needs LARGE_STATIC_BUFFERS, please add LARGE_STATIC_BUFFERS
     static int _DtlsCheckWindow(WOLFSSL* ssl);
 #endif
 
+#ifndef WOLFSSL_NO_RECORD_POOL
+    static byte RecordPoolListIdx(WOLFSSL* ssl);
+#endif
+
 #if defined(__APPLE__) && defined(WOLFSSL_SYS_CA_CERTS)
 #include <Security/SecCertificate.h>
 #include <Security/SecTrust.h>
@@ -2225,6 +2229,7 @@ int InitSSL_Ctx(WOLFSSL_CTX* ctx, WOLFSSL_METHOD* method, void* heap)
         ctx->heap = heap; /* wolfSSL_CTX_load_static_memory sets */
     }
     ctx->timeout  = WOLFSSL_SESSION_TIMEOUT;
+    ctx->sendBatch = WOLFSSL_SEND_BATCH;
 
 #ifdef WOLFSSL_DTLS
     if (method->version.major == DTLS_MAJOR) {
@@ -2249,6 +2254,14 @@ int InitSSL_Ctx(WOLFSSL_CTX* ctx, WOLFSSL_METHOD* method, void* heap)
     (void)ret;
 #endif
 
+#if defined(WOLFSSL_CERT_MSG_CACHE) && !defined(SINGLE_THREADED)
+    if (wc_InitMutex(&ctx->certMsgCache.lock) != 0) {
+        WOLFSSL_MSG("Bad mutex init");
+        WOLFSSL_ERROR_VERBOSE(BAD_MUTEX_E);
+        return BAD_MUTEX_E;
+    }
+#endif
+
 #ifndef NO_CERTS
     ctx->privateKeyDevId = INVALID_DEVID;
 #endif
@@ -2695,6 +2708,30 @@ void SSL_CtxResourceFree(WOLFSSL_CTX* ctx)
 #if defined(WOLFSSL_TLS13) && defined(HAVE_ECH)
     FreeEchConfigs(ctx->echConfigs, ctx->heap);
     ctx->echConfigs = NULL;
+#endif
+#ifndef WOLFSSL_NO_RECORD_POOL
+    RecordPoolFree(ctx);
+#endif
+#ifdef WOLFSSL_CHAIN_VERIFY_POOL
+    ChainVerifyPoolFree(ctx);
+#endif
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    KeySharePoolFree(ctx);
+#endif
+#ifdef WOLFSSL_CERT_MSG_CACHE
+    XFREE(ctx->certMsgCache.msg, ctx->heap, DYNAMIC_TYPE_CERT_MSG);
+    ctx->certMsgCache.msg = NULL;
+    #ifndef SINGLE_THREADED
+    wc_FreeMutex(&ctx->certMsgCache.lock);
+    #endif
+#endif
+#ifdef WOLFSSL_STATELESS_HRR
+    if (ctx->hrrCookieSecret != NULL) {
+        ForceZero(ctx->hrrCookieSecret, ctx->hrrCookieSecretSz);
+        XFREE(ctx->hrrCookieSecret, ctx->heap, DYNAMIC_TYPE_COOKIE_PWD);
+        ctx->hrrCookieSecret = NULL;
+        ctx->hrrCookieSecretSz = 0;
+    }
 #endif
     (void)heapAtCTXInit;
 }
@@ -6543,6 +6580,9 @@ int SetSSL_CTX(WOLFSSL* ssl, WOLFSSL_CTX* ctx, int writeDup)
      * This should only happen if switching ctxs!*/
     if (!newSSL) {
         WOLFSSL_MSG("freeing old ctx to decrement reference count. Switching ctx.");
+    #ifndef WOLFSSL_NO_RECORD_POOL
+        RecordPoolDetach(ssl);
+    #endif
         wolfSSL_CTX_free(ssl->ctx);
     }
 
@@ -6730,6 +6770,11 @@ int SetSSL_CTX(WOLFSSL* ssl, WOLFSSL_CTX* ctx, int writeDup)
     ssl->options.sendVerify     = ctx->sendVerify;
 
     ssl->options.partialWrite  = ctx->partialWrite;
+    ssl->sendBatch             = ctx->sendBatch;
+    ssl->options.autoCompact   = ctx->autoCompact;
+#ifndef WOLFSSL_NO_RECORD_POOL
+    ssl->recordPoolList        = RecordPoolListIdx(ssl);
+#endif
     ssl->options.quietShutdown = ctx->quietShutdown;
     ssl->options.groupMessages = ctx->groupMessages;
 
@@ -6834,6 +6879,10 @@ int SetSSL_CTX(WOLFSSL* ssl, WOLFSSL_CTX* ctx, int writeDup)
     if (ssl->CBIOSend != BioSend)
 #endif
         ssl->CBIOSend = ctx->CBIOSend;
+#ifdef WOLFSSL_IO_URING
+    if (ssl->uringConn == NULL)
+        ssl->uring = ctx->uring;
+#endif
     ssl->verifyDepth = ctx->verifyDepth;
 
     return ret;
@@ -7309,6 +7358,9 @@ int InitSSL(WOLFSSL* ssl, WOLFSSL_CTX* ctx, int writeDup)
     ssl->options.haveEMS = ctx->haveEMS;
 #endif
     ssl->options.useClientOrder = ctx->useClientOrder;
+#ifdef WOLFSSL_KTLS
+    ssl->options.useKtls = ctx->useKtls;
+#endif
     ssl->options.mutualAuth = ctx->mutualAuth;
 
 #ifdef WOLFSSL_TLS13
@@ -7333,6 +7385,12 @@ int InitSSL(WOLFSSL* ssl, WOLFSSL_CTX* ctx, int writeDup)
         XMEMCPY(ssl->group, ctx->group, sizeof(*ctx->group) * ctx->numGroups);
         ssl->numGroups = ctx->numGroups;
     }
+    #if defined(WOLFSSL_STATELESS_HRR) && !defined(NO_WOLFSSL_SERVER)
+        if (ctx->hrrCookieSecret != NULL) {
+            ssl->options.statelessHrr = 1;
+            ssl->options.sendCookie = 1;
+        }
+    #endif
 
     #ifdef WOLFSSL_TLS13_MIDDLEBOX_COMPAT
         ssl->options.tls13MiddleBoxCompat = 1;
@@ -8006,6 +8064,9 @@ void SSL_ResourceFree(WOLFSSL* ssl)
     wolfSSL_CRYPTO_cleanup_ex_data(&ssl->ex_data);
 #endif
 
+#ifdef WOLFSSL_IO_URING
+    UringDetach(ssl);
+#endif
     FreeCiphers(ssl);
     FreeArrays(ssl, 0);
     FreeKeyExchange(ssl);
@@ -8021,6 +8082,9 @@ void SSL_ResourceFree(WOLFSSL* ssl)
     }
     FreeSuites(ssl);
     FreeHandshakeHashes(ssl);
+#ifdef WOLFSSL_TICKET_ENC_BATCH
+    FreeTicketEncBatch(ssl);
+#endif
     XFREE(ssl->buffers.domainName.buffer, ssl->heap, DYNAMIC_TYPE_DOMAIN);
 
     /* clear keys struct after session */
@@ -8238,6 +8302,9 @@ void SSL_ResourceFree(WOLFSSL* ssl)
 
     if (ssl->session != NULL)
         wolfSSL_FreeSession(ssl->ctx, ssl->session);
+#ifdef WOLFSSL_SESSION_STORE
+    wolfSSL_FreeSession(ssl->ctx, ssl->storeSession);
+#endif
 #ifdef HAVE_WRITE_DUP
     if (ssl->dupWrite) {
         FreeWriteDup(ssl);
@@ -8359,6 +8426,11 @@ void FreeHandshakeResources(WOLFSSL* ssl)
     }
 #endif
 
+#ifdef WOLFSSL_SESSION_STORE
+    wolfSSL_FreeSession(ssl->ctx, ssl->storeSession);
+    ssl->storeSession = NULL;
+#endif
+
 #ifdef HAVE_SECURE_RENEGOTIATION
     if (ssl->secure_renegotiation && ssl->secure_renegotiation->enabled) {
         WOLFSSL_MSG("Secure Renegotiation needs to retain handshake resources");
@@ -8575,9 +8647,153 @@ void FreeHandshakeResources(WOLFSSL* ssl)
     #endif
     }
 #endif /* WOLFSSL_STATIC_MEMORY */
+
+    if (ssl->options.autoCompact)
+        CompactIdle(ssl);
 }
 
 
+#ifdef WOLFSSL_DTLS
+static word32 DtlsMsgListBytes(DtlsMsg* msg)
+{
+    word32 sz = 0;
+
+    for (; msg != NULL; msg = msg->next)
+        sz += (word32)sizeof(DtlsMsg) + msg->sz;
+
+    return sz;
+}
+#endif
+
+/* Bytes held in the allocations CompactSSL() can release. Counts the
+ * structures and buffers, not every allocation they point to in turn. */
+static word32 CompactHeldBytes(WOLFSSL* ssl)
+{
+    word32 sz = 0;
+
+    if (ssl->arrays != NULL) {
+        sz += (word32)sizeof(Arrays) + ssl->arrays->pendingMsgSz;
+        if (ssl->arrays->preMasterSecret != NULL)
+            sz += ENCRYPT_LEN;
+    }
+    if (ssl->hsHashes != NULL)
+        sz += (word32)sizeof(HS_Hashes);
+    if (ssl->suites != NULL)
+        sz += (word32)sizeof(Suites);
+    if (ssl->options.weOwnRng && ssl->rng != NULL)
+        sz += (word32)sizeof(WC_RNG);
+#ifndef NO_RSA
+    if (ssl->peerRsaKey != NULL)
+        sz += (word32)sizeof(RsaKey);
+#endif
+#ifdef HAVE_ECC
+    /* sized as ECC whatever curve type it holds */
+    if (ssl->eccTempKey != NULL)
+        sz += (word32)sizeof(ecc_key);
+    if (ssl->peerEccKey != NULL)
+        sz += (word32)sizeof(ecc_key);
+    if (ssl->peerEccDsaKey != NULL)
+        sz += (word32)sizeof(ecc_key);
+#endif
+#ifdef HAVE_ED25519
+    if (ssl->peerEd25519Key != NULL)
+        sz += (word32)sizeof(ed25519_key);
+#endif
+#ifdef HAVE_CURVE25519
+    if (ssl->peerX25519Key != NULL)
+        sz += (word32)sizeof(curve25519_key);
+#endif
+#ifdef HAVE_ED448
+    if (ssl->peerEd448Key != NULL)
+        sz += (word32)sizeof(ed448_key);
+#endif
+#ifdef HAVE_CURVE448
+    if (ssl->peerX448Key != NULL)
+        sz += (word32)sizeof(curve448_key);
+#endif
+#ifndef NO_DH
+    if (ssl->buffers.serverDH_Priv.buffer != NULL)
+        sz += ssl->buffers.serverDH_Priv.length;
+    if (ssl->buffers.serverDH_Pub.buffer != NULL)
+        sz += ssl->buffers.serverDH_Pub.length;
+#endif
+#ifdef KEEP_PEER_CERT
+    if (ssl->peerCert.derCert != NULL)
+        sz += (word32)sizeof(DerBuffer) + ssl->peerCert.derCert->length;
+#endif
+#ifdef WOLFSSL_DTLS
+    sz += DtlsMsgListBytes(ssl->dtls_tx_msg_list);
+    sz += DtlsMsgListBytes(ssl->dtls_rx_msg_list);
+#endif
+    if (ssl->buffers.inputBuffer.dynamicFlag)
+        sz += ssl->buffers.inputBuffer.bufferSize;
+    if (ssl->buffers.outputBuffer.dynamicFlag)
+        sz += ssl->buffers.outputBuffer.bufferSize;
+
+    return sz;
+}
+
+/* Free what an idle connection holds on top of FreeHandshakeResources():
+ * handshake state that TLS 1.3 keeps for post-handshake authentication when
+ * the client never offered it, on either side, the peer's certificate and
+ * dynamic input and output buffers with nothing left in them. */
+void CompactIdle(WOLFSSL* ssl)
+{
+#if defined(WOLFSSL_TLS13) && defined(WOLFSSL_POST_HANDSHAKE_AUTH)
+    /* without the extension no CertificateRequest/Finished can follow */
+    if (ssl->options.tls1_3 && !ssl->options.postHandshakeAuth) {
+    #ifndef OPENSSL_EXTRA
+        FreeSuites(ssl);
+    #endif
+        FreeHandshakeHashes(ssl);
+        if (ssl->options.saveArrays == 0)
+            FreeArrays(ssl, 1);
+    }
+#endif
+
+#ifdef KEEP_PEER_CERT
+    if (ssl->peerCert.derCert != NULL) {
+        FreeX509(&ssl->peerCert);
+        InitX509(&ssl->peerCert, 0, ssl->heap);
+    }
+#endif
+#ifdef OPENSSL_EXTRA
+    wolfSSL_sk_X509_pop_free(ssl->peerCertChain, NULL);
+    ssl->peerCertChain = NULL;
+#endif
+
+    /* a zero-copy read view points into the input buffer */
+    if (ssl->buffers.inputBuffer.dynamicFlag &&
+            !ssl->buffers.clearOutputPinned) {
+        ShrinkInputBuffer(ssl, NO_FORCED_FREE);
+    }
+    if (ssl->buffers.outputBuffer.dynamicFlag &&
+            ssl->buffers.outputBuffer.length == 0) {
+        ShrinkOutputBuffer(ssl);
+    }
+}
+
+/* Free everything a connection with a finished handshake can do without.
+ * return number of bytes released */
+word32 CompactSSL(WOLFSSL* ssl)
+{
+    word32 held = CompactHeldBytes(ssl);
+    word32 left;
+
+#ifdef WOLFSSL_DTLS
+    /* the last flight is kept until the peer shows it got it */
+    if (!ssl->options.dtlsHsRetain)
+#endif
+    {
+        FreeHandshakeResources(ssl);
+    }
+    CompactIdle(ssl);
+
+    left = CompactHeldBytes(ssl);
+
+    return held > left ? held - left : 0;
+}
+
 /* heap argument is the heap hint used when creating SSL */
 void FreeSSL(WOLFSSL* ssl, void* heap)
 {
@@ -10307,6 +10523,11 @@ static int wolfSSLReceive(WOLFSSL* ssl, byte* buf, word32 sz)
     }
 
 retry:
+#ifdef WOLFSSL_KTLS
+    if (ssl->options.ktlsRx)
+        recvd = KtlsReceive(ssl, buf, (int)sz);
+    else
+#endif
     recvd = ssl->CBIORecv(ssl, (char *)buf, (int)sz, ssl->IOCB_ReadCtx);
     if (recvd < 0) {
         switch (recvd) {
@@ -10400,12 +10621,441 @@ retry:
 }
 
 
+#ifndef WOLFSSL_NO_RECORD_POOL
+static WC_INLINE void RecordPoolLock(RecordPoolList* list)
+{
+#ifndef SINGLE_THREADED
+    if (wc_LockMutex(&list->lock) != 0) {
+        /* only fails on a broken mutex, nothing sensible to fall back to */
+        WOLFSSL_MSG("Record pool lock failed");
+    }
+#else
+    (void)list;
+#endif
+}
+
+static WC_INLINE void RecordPoolUnLock(RecordPoolList* list)
+{
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&list->lock);
+#else
+    (void)list;
+#endif
+}
+
+/* Pick the pool list a new connection borrows from. Connections made on the
+ * same thread share one so threads don't contend on a lock. */
+static byte RecordPoolListIdx(WOLFSSL* ssl)
+{
+#if WOLFSSL_RECORD_POOL_LISTS == 1
+    (void)ssl;
+    return 0;
+#elif defined(HAVE_THREAD_LS) && defined(WOLFSSL_ATOMIC_OPS)
+    static wolfSSL_Atomic_Int nextIdx;
+    static THREAD_LS_T int threadIdx = -1;
+
+    (void)ssl;
+    if (threadIdx < 0) {
+        threadIdx = (int)((unsigned int)wolfSSL_Atomic_Int_FetchAdd(&nextIdx,
+                                       1) % WOLFSSL_RECORD_POOL_LISTS);
+    }
+    return (byte)threadIdx;
+#else
+    /* no thread local storage, spread connections over the lists */
+    return (byte)(((wc_ptr_t)ssl >> 6) % WOLFSSL_RECORD_POOL_LISTS);
+#endif
+}
+
+/* Create the pool on the first call, after that change how many idle
+ * buffers are kept and, while none is lent out, their size.
+ * return WOLFSSL_SUCCESS or error */
+int RecordPoolSet(WOLFSSL_CTX* ctx, word32 maxIdle, word32 bufSz)
+{
+    RecordPool* pool = ctx->recordPool;
+    word32 perList = (maxIdle + WOLFSSL_RECORD_POOL_LISTS - 1) /
+                     WOLFSSL_RECORD_POOL_LISTS;
+    word32 inUse = 0;
+    int ret = WOLFSSL_SUCCESS;
+    int i;
+
+    if (pool == NULL) {
+        if (maxIdle == 0)
+            return WOLFSSL_SUCCESS;
+
+        pool = (RecordPool*)XMALLOC(sizeof(RecordPool), ctx->heap,
+                                    DYNAMIC_TYPE_RECORD_POOL);
+        if (pool == NULL)
+            return MEMORY_E;
+        XMEMSET(pool, 0, sizeof(RecordPool));
+        pool->heap = ctx->heap;
+        pool->bufSz = bufSz;
+        for (i = 0; i < WOLFSSL_RECORD_POOL_LISTS; i++) {
+        #ifndef SINGLE_THREADED
+            if (wc_InitMutex(&pool->list[i].lock) != 0) {
+                WOLFSSL_MSG("Record pool mutex init failed");
+                while (--i >= 0)
+                    wc_FreeMutex(&pool->list[i].lock);
+                XFREE(pool, ctx->heap, DYNAMIC_TYPE_RECORD_POOL);
+                return BAD_MUTEX_E;
+            }
+        #endif
+            pool->list[i].maxIdle = perList;
+        }
+        ctx->recordPool = pool;
+        return WOLFSSL_SUCCESS;
+    }
+
+    for (i = 0; i < WOLFSSL_RECORD_POOL_LISTS; i++) {
+        RecordPoolLock(&pool->list[i]);
+        inUse += pool->list[i].inUse;
+    }
+    if (bufSz != pool->bufSz && inUse > 0) {
+        WOLFSSL_MSG("Record pool buffers in use, can't change their size");
+        ret = BAD_STATE_E;
+    }
+    else {
+        if (bufSz != pool->bufSz) {
+            /* idle buffers have the old size */
+            perList = 0;
+        }
+        for (i = 0; i < WOLFSSL_RECORD_POOL_LISTS; i++) {
+            RecordPoolList* list = &pool->list[i];
+            while (list->idle > perList) {
+                byte* buf = list->head;
+                list->head = *(byte**)buf;
+                list->idle--;
+                XFREE(buf, pool->heap, DYNAMIC_TYPE_RECORD_POOL);
+            }
+            list->maxIdle = (maxIdle + WOLFSSL_RECORD_POOL_LISTS - 1) /
+                            WOLFSSL_RECORD_POOL_LISTS;
+        }
+        pool->bufSz = bufSz;
+    }
+    for (i = WOLFSSL_RECORD_POOL_LISTS - 1; i >= 0; i--)
+        RecordPoolUnLock(&pool->list[i]);
+
+    return ret;
+}
+
+void RecordPoolGetStats(WOLFSSL_CTX* ctx, WOLFSSL_RECORD_POOL_STATS* stats)
+{
+    RecordPool* pool = ctx->recordPool;
+    int i;
+
+    XMEMSET(stats, 0, sizeof(WOLFSSL_RECORD_POOL_STATS));
+    if (pool == NULL)
+        return;
+
+    for (i = 0; i < WOLFSSL_RECORD_POOL_LISTS; i++) {
+        RecordPoolList* list = &pool->list[i];
+
+        RecordPoolLock(list);
+        stats->gets      += list->gets;
+        stats->hits      += list->hits;
+        stats->inUse     += list->inUse;
+        stats->peakInUse += list->peakInUse;
+        stats->idle      += list->idle;
+        if (i == 0)
+            stats->bufSz = pool->bufSz;
+        RecordPoolUnLock(list);
+    }
+}
+
+/* Free the pool with its ctx, all connections are gone by then */
+void RecordPoolFree(WOLFSSL_CTX* ctx)
+{
+    RecordPool* pool = ctx->recordPool;
+    int i;
+
+    if (pool == NULL)
+        return;
+
+    for (i = 0; i < WOLFSSL_RECORD_POOL_LISTS; i++) {
+        RecordPoolList* list = &pool->list[i];
+        while (list->head != NULL) {
+            byte* buf = list->head;
+            list->head = *(byte**)buf;
+            XFREE(buf, pool->heap, DYNAMIC_TYPE_RECORD_POOL);
+        }
+    #ifndef SINGLE_THREADED
+        wc_FreeMutex(&list->lock);
+    #endif
+    }
+    XFREE(pool, ctx->heap, DYNAMIC_TYPE_RECORD_POOL);
+    ctx->recordPool = NULL;
+}
+
+/* Borrow a buffer able to hold need bytes.
+ * return buffer of *sz bytes, NULL when the pool can't lend one */
+static byte* RecordPoolGet(WOLFSSL* ssl, word32 need, word32* sz)
+{
+    RecordPool* pool = ssl->ctx != NULL ? ssl->ctx->recordPool : NULL;
+    RecordPoolList* list;
+    byte* buf = NULL;
+    int lend = 0;
+
+    if (pool == NULL)
+        return NULL;
+
+    list = &pool->list[ssl->recordPoolList];
+    RecordPoolLock(list);
+    if (list->maxIdle > 0 && need <= pool->bufSz) {
+        lend = 1;
+        *sz = pool->bufSz + RECORD_POOL_SLACK;
+        list->gets++;
+        if (list->head != NULL) {
+            buf = list->head;
+            list->head = *(byte**)buf;
+            list->idle--;
+            list->hits++;
+        }
+        if (++list->inUse > list->peakInUse)
+            list->peakInUse = list->inUse;
+    }
+    RecordPoolUnLock(list);
+
+    if (lend && buf == NULL) {
+        /* pool is empty, the buffer joins it when returned */
+        buf = (byte*)XMALLOC(*sz, pool->heap, DYNAMIC_TYPE_RECORD_POOL);
+        if (buf == NULL) {
+            RecordPoolLock(list);
+            list->inUse--;
+            RecordPoolUnLock(list);
+        }
+    }
+
+    return buf;
+}
+
+/* Give back a buffer from RecordPoolGet(), keep it if the list has room */
+static void RecordPoolPut(WOLFSSL* ssl, byte* buf)
+{
+    RecordPool* pool = ssl->ctx->recordPool;
+    RecordPoolList* list = &pool->list[ssl->recordPoolList];
+
+    RecordPoolLock(list);
+    list->inUse--;
+    if (list->idle < list->maxIdle) {
+        *(byte**)buf = list->head;
+        list->head = buf;
+        list->idle++;
+        buf = NULL;
+    }
+    RecordPoolUnLock(list);
+
+    if (buf != NULL)
+        XFREE(buf, pool->heap, DYNAMIC_TYPE_RECORD_POOL);
+}
+
+/* The connection moves to another ctx. Buffers it holds become its own and
+ * are freed instead of returned. */
+void RecordPoolDetach(WOLFSSL* ssl)
+{
+    RecordPool* pool = ssl->ctx != NULL ? ssl->ctx->recordPool : NULL;
+    RecordPoolList* list;
+
+    if (pool == NULL)
+        return;
+
+    list = &pool->list[ssl->recordPoolList];
+    RecordPoolLock(list);
+    if (ssl->buffers.inputBuffer.pooled) {
+        ssl->buffers.inputBuffer.pooled = 0;
+        list->inUse--;
+    }
+    if (ssl->buffers.outputBuffer.pooled) {
+        ssl->buffers.outputBuffer.pooled = 0;
+        list->inUse--;
+    }
+    RecordPoolUnLock(list);
+}
+#endif /* !WOLFSSL_NO_RECORD_POOL */
+
+#ifdef WOLFSSL_CHAIN_VERIFY_POOL
+/* Check the signature of job->cert with the public key of job->issuer */
+static int ChainVerifyRun(ChainVerifyJob* job, void* heap)
+{
+    int ret;
+#ifdef WOLFSSL_SMALL_STACK
+    DecodedCert* issuer;
+#else
+    DecodedCert  issuer[1];
+#endif
+
+#ifdef WOLFSSL_SMALL_STACK
+    issuer = (DecodedCert*)XMALLOC(sizeof(DecodedCert), heap,
+                                   DYNAMIC_TYPE_DCERT);
+    if (issuer == NULL)
+        return MEMORY_E;
+#endif
+
+    InitDecodedCert(issuer, job->issuer, job->issuerSz, heap);
+    ret = ParseCert(issuer, CHAIN_CERT_TYPE, NO_VERIFY, NULL);
+    if (ret == 0) {
+        job->key = (byte*)XMALLOC(issuer->pubKeySize, heap,
+                                  DYNAMIC_TYPE_PUBLIC_KEY);
+        if (job->key == NULL)
+            ret = MEMORY_E;
+    }
+    if (ret == 0) {
+        XMEMCPY(job->key, issuer->publicKey, issuer->pubKeySize);
+        job->keySz = issuer->pubKeySize;
+        job->keyOID = issuer->keyOID;
+    }
+    FreeDecodedCert(issuer);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(issuer, heap, DYNAMIC_TYPE_DCERT);
+#endif
+
+    if (ret == 0) {
+        ret = CheckCertSignaturePubKey(job->cert, job->certSz, heap, job->key,
+                                       job->keySz, (int)job->keyOID);
+    }
+
+    return ret;
+}
+
+/* Worker thread: run queued jobs until the pool stops and the queue is
+ * empty */
+static THREAD_RETURN WOLFSSL_THREAD ChainVerifyWorker(void* arg)
+{
+    ChainVerifyPool* pool = (ChainVerifyPool*)arg;
+    ChainVerifyJob* job;
+    ChainVerifyBatch* batch;
+
+    for (;;) {
+        if (wolfSSL_CondStart(&pool->cond) != 0)
+            break;
+        while (pool->head == NULL && !pool->stop) {
+            if (wolfSSL_CondWait(&pool->cond) != 0)
+                break;
+        }
+        job = pool->head;
+        if (job != NULL) {
+            pool->head = job->next;
+            if (pool->head == NULL)
+                pool->tail = NULL;
+        }
+        /* a signal wakes one worker, pass it on to the next */
+        if (pool->head != NULL || pool->stop)
+            wolfSSL_CondSignal(&pool->cond);
+        wolfSSL_CondEnd(&pool->cond);
+
+        if (job == NULL)
+            break;
+
+        batch = job->batch;
+        job->ret = ChainVerifyRun(job, batch->heap);
+        if (wolfSSL_CondStart(&batch->cond) == 0) {
+            job->done = 1;
+            wolfSSL_CondSignal(&batch->cond);
+            wolfSSL_CondEnd(&batch->cond);
+        }
+    }
+
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+/* Stop and join the workers, queued jobs are run first */
+static void ChainVerifyPoolStop(ChainVerifyPool* pool, int started)
+{
+    void* heap = pool->heap;
+    int i;
+
+    if (wolfSSL_CondStart(&pool->cond) == 0) {
+        pool->stop = 1;
+        wolfSSL_CondSignal(&pool->cond);
+        wolfSSL_CondEnd(&pool->cond);
+    }
+    for (i = 0; i < started; i++)
+        wolfSSL_JoinThread(pool->threads[i]);
+    wolfSSL_CondFree(&pool->cond);
+    XFREE(pool->threads, heap, DYNAMIC_TYPE_VERIFY_POOL);
+    XFREE(pool, heap, DYNAMIC_TYPE_VERIFY_POOL);
+    (void)heap;
+}
+
+/* Replace the workers of ctx with a pool of the given size, 0 for none.
+ * No handshake of ctx may be processing a peer certificate meanwhile. */
+int ChainVerifyPoolSet(WOLFSSL_CTX* ctx, int workers)
+{
+    ChainVerifyPool* pool;
+    int i;
+    int ret = WOLFSSL_SUCCESS;
+
+    ChainVerifyPoolFree(ctx);
+    if (workers == 0)
+        return WOLFSSL_SUCCESS;
+
+    pool = (ChainVerifyPool*)XMALLOC(sizeof(ChainVerifyPool), ctx->heap,
+                                     DYNAMIC_TYPE_VERIFY_POOL);
+    if (pool == NULL)
+        return MEMORY_E;
+    XMEMSET(pool, 0, sizeof(ChainVerifyPool));
+    pool->heap = ctx->heap;
+    pool->threads = (THREAD_TYPE*)XMALLOC(sizeof(THREAD_TYPE) * workers,
+                                          ctx->heap, DYNAMIC_TYPE_VERIFY_POOL);
+    if (pool->threads == NULL) {
+        XFREE(pool, ctx->heap, DYNAMIC_TYPE_VERIFY_POOL);
+        return MEMORY_E;
+    }
+    if (wolfSSL_CondInit(&pool->cond) != 0) {
+        XFREE(pool->threads, ctx->heap, DYNAMIC_TYPE_VERIFY_POOL);
+        XFREE(pool, ctx->heap, DYNAMIC_TYPE_VERIFY_POOL);
+        return BAD_MUTEX_E;
+    }
+
+    for (i = 0; i < workers; i++) {
+        if (wolfSSL_NewThread(&pool->threads[i], ChainVerifyWorker,
+                              pool) != 0) {
+            WOLFSSL_MSG("Chain verify worker start failed");
+            ret = THREAD_CREATE_E;
+            break;
+        }
+    }
+    if (ret != WOLFSSL_SUCCESS) {
+        ChainVerifyPoolStop(pool, i);
+        return ret;
+    }
+
+    pool->workers = workers;
+    ctx->verifyPool = pool;
+    return WOLFSSL_SUCCESS;
+}
+
+void ChainVerifyPoolFree(WOLFSSL_CTX* ctx)
+{
+    ChainVerifyPool* pool = ctx->verifyPool;
+
+    if (pool == NULL)
+        return;
+
+    ctx->verifyPool = NULL;
+    ChainVerifyPoolStop(pool, pool->workers);
+}
+#endif /* WOLFSSL_CHAIN_VERIFY_POOL */
+
+/* Release the dynamic memory of an input or output buffer */
+static void FreeRecordBuffer(WOLFSSL* ssl, bufferStatic* buf, int type)
+{
+    byte* mem = buf->buffer - buf->offset;
+
+#ifndef WOLFSSL_NO_RECORD_POOL
+    if (buf->pooled) {
+        buf->pooled = 0;
+        RecordPoolPut(ssl, mem);
+        return;
+    }
+#endif
+    XFREE(mem, ssl->heap, type);
+    (void)type;
+}
+
 /* Switch dynamic output buffer back to static, buffer is assumed clear */
 void ShrinkOutputBuffer(WOLFSSL* ssl)
 {
     WOLFSSL_MSG("Shrinking output buffer");
-    XFREE(ssl->buffers.outputBuffer.buffer - ssl->buffers.outputBuffer.offset,
-          ssl->heap, DYNAMIC_TYPE_OUT_BUFFER);
+    FreeRecordBuffer(ssl, &ssl->buffers.outputBuffer, DYNAMIC_TYPE_OUT_BUFFER);
     ssl->buffers.outputBuffer.buffer = ssl->buffers.outputBuffer.staticBuffer;
     ssl->buffers.outputBuffer.bufferSize  = STATIC_BUFFER_LEN;
     ssl->buffers.outputBuffer.dynamicFlag = 0;
@@ -10437,8 +11087,7 @@ void ShrinkInputBuffer(WOLFSSL* ssl, int forcedFree)
 
     ForceZero(ssl->buffers.inputBuffer.buffer,
         ssl->buffers.inputBuffer.length);
-    XFREE(ssl->buffers.inputBuffer.buffer - ssl->buffers.inputBuffer.offset,
-          ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
+    FreeRecordBuffer(ssl, &ssl->buffers.inputBuffer, DYNAMIC_TYPE_IN_BUFFER);
     ssl->buffers.inputBuffer.buffer = ssl->buffers.inputBuffer.staticBuffer;
     ssl->buffers.inputBuffer.bufferSize  = STATIC_BUFFER_LEN;
     ssl->buffers.inputBuffer.dynamicFlag = 0;
@@ -10473,6 +11122,14 @@ int SendBuffered(WOLFSSL* ssl)
     while (ssl->buffers.outputBuffer.length > 0) {
         int sent = 0;
 retry:
+    #ifdef WOLFSSL_KTLS
+        if (ssl->options.ktlsTx) {
+            sent = KtlsSend(ssl, ssl->buffers.outputBuffer.buffer +
+                                 ssl->buffers.outputBuffer.idx,
+                            (int)ssl->buffers.outputBuffer.length);
+        }
+        else
+    #endif
         sent = ssl->CBIOSend(ssl,
                              (char*)ssl->buffers.outputBuffer.buffer +
                              ssl->buffers.outputBuffer.idx,
@@ -10538,6 +11195,14 @@ retry:
     if (ssl->buffers.outputBuffer.dynamicFlag)
         ShrinkOutputBuffer(ssl);
 
+#ifdef WOLFSSL_KTLS
+    if (ssl->options.ktlsTxRekey) {
+        /* records built for the old key are out, now switch the socket */
+        ssl->options.ktlsTxRekey = 0;
+        return KtlsSetKeys(ssl, 1);
+    }
+#endif
+
     return 0;
 }
 
@@ -10563,6 +11228,9 @@ static WC_INLINE int GrowOutputBuffer(WOLFSSL* ssl, int size)
 #endif
     int newSz = size + ssl->buffers.outputBuffer.idx +
                 ssl->buffers.outputBuffer.length;
+#ifndef WOLFSSL_NO_RECORD_POOL
+    word32 poolSz = 0;
+#endif
 
 #if WOLFSSL_GENERAL_ALIGNMENT > 0
     /* the encrypted data will be offset from the front of the buffer by
@@ -10573,7 +11241,14 @@ static WC_INLINE int GrowOutputBuffer(WOLFSSL* ssl, int size)
         align *= 2;
 #endif
 
-    tmp = (byte*)XMALLOC(newSz + align, ssl->heap, DYNAMIC_TYPE_OUT_BUFFER);
+#ifndef WOLFSSL_NO_RECORD_POOL
+    tmp = RecordPoolGet(ssl, (word32)newSz, &poolSz);
+    if (tmp == NULL)
+#endif
+    {
+        tmp = (byte*)XMALLOC(newSz + align, ssl->heap,
+                             DYNAMIC_TYPE_OUT_BUFFER);
+    }
     WOLFSSL_MSG("growing output buffer");
 
     if (tmp == NULL)
@@ -10599,9 +11274,8 @@ static WC_INLINE int GrowOutputBuffer(WOLFSSL* ssl, int size)
                ssl->buffers.outputBuffer.length);
 
     if (ssl->buffers.outputBuffer.dynamicFlag) {
-        XFREE(ssl->buffers.outputBuffer.buffer -
-              ssl->buffers.outputBuffer.offset, ssl->heap,
-              DYNAMIC_TYPE_OUT_BUFFER);
+        FreeRecordBuffer(ssl, &ssl->buffers.outputBuffer,
+                         DYNAMIC_TYPE_OUT_BUFFER);
     }
     ssl->buffers.outputBuffer.dynamicFlag = 1;
 
@@ -10614,6 +11288,13 @@ static WC_INLINE int GrowOutputBuffer(WOLFSSL* ssl, int size)
 
     ssl->buffers.outputBuffer.buffer = tmp;
     ssl->buffers.outputBuffer.bufferSize = newSz;
+#ifndef WOLFSSL_NO_RECORD_POOL
+    if (poolSz > 0) {
+        /* use all of the pooled buffer, saves growing again */
+        ssl->buffers.outputBuffer.bufferSize = poolSz - RECORD_POOL_SLACK;
+        ssl->buffers.outputBuffer.pooled = 1;
+    }
+#endif
     return 0;
 }
 
@@ -10622,6 +11303,9 @@ static WC_INLINE int GrowOutputBuffer(WOLFSSL* ssl, int size)
 int GrowInputBuffer(WOLFSSL* ssl, int size, int usedLength)
 {
     byte* tmp;
+#ifndef WOLFSSL_NO_RECORD_POOL
+    word32 poolSz = 0;
+#endif
 #if defined(WOLFSSL_DTLS) || WOLFSSL_GENERAL_ALIGNMENT > 0
     byte  align = ssl->options.dtls ? WOLFSSL_GENERAL_ALIGNMENT : 0;
     byte  hdrSz = DTLS_RECORD_HEADER_SZ;
@@ -10646,8 +11330,14 @@ int GrowInputBuffer(WOLFSSL* ssl, int size, int usedLength)
         return BAD_FUNC_ARG;
     }
 
-    tmp = (byte*)XMALLOC(size + usedLength + align,
+#ifndef WOLFSSL_NO_RECORD_POOL
+    tmp = RecordPoolGet(ssl, (word32)(size + usedLength), &poolSz);
+    if (tmp == NULL)
+#endif
+    {
+        tmp = (byte*)XMALLOC(size + usedLength + align,
                              ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
+    }
     WOLFSSL_MSG("growing input buffer");
 
     if (tmp == NULL)
@@ -10677,8 +11367,8 @@ int GrowInputBuffer(WOLFSSL* ssl, int size, int usedLength)
             ForceZero(ssl->buffers.inputBuffer.buffer,
                 ssl->buffers.inputBuffer.length);
         }
-        XFREE(ssl->buffers.inputBuffer.buffer - ssl->buffers.inputBuffer.offset,
-              ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
+        FreeRecordBuffer(ssl, &ssl->buffers.inputBuffer,
+                         DYNAMIC_TYPE_IN_BUFFER);
     }
 
     ssl->buffers.inputBuffer.dynamicFlag = 1;
@@ -10691,6 +11381,12 @@ int GrowInputBuffer(WOLFSSL* ssl, int size, int usedLength)
 
     ssl->buffers.inputBuffer.buffer = tmp;
     ssl->buffers.inputBuffer.bufferSize = size + usedLength;
+#ifndef WOLFSSL_NO_RECORD_POOL
+    if (poolSz > 0) {
+        ssl->buffers.inputBuffer.bufferSize = poolSz - RECORD_POOL_SLACK;
+        ssl->buffers.inputBuffer.pooled = 1;
+    }
+#endif
     ssl->buffers.inputBuffer.idx    = 0;
     ssl->buffers.inputBuffer.length = usedLength;
 
@@ -13548,6 +14244,98 @@ int DoVerifyCallback(WOLFSSL_CERT_MANAGER* cm, WOLFSSL* ssl, int ret,
     return ret;
 }
 
+#ifdef WOLFSSL_CHAIN_VERIFY_POOL
+/* Queue the signature checks of the certs below the top of the peer chain on
+ * the ctx workers. Each cert is checked with the key of the cert sent after
+ * it while the top cert is verified against the trusted CAs here. */
+static void ChainVerifyDispatch(WOLFSSL* ssl, ProcPeerCertArgs* args)
+{
+    ChainVerifyPool* pool = ssl->ctx->verifyPool;
+    ChainVerifyBatch* batch;
+    int count = args->count - 1;
+    int i;
+
+    if (pool == NULL || count < 1 || args->batch != NULL ||
+            ssl->options.verifyNone) {
+        return;
+    }
+
+    /* on failure the chain is verified in place as without a pool */
+    batch = (ChainVerifyBatch*)XMALLOC(sizeof(ChainVerifyBatch) +
+                                       sizeof(ChainVerifyJob) * count,
+                                       ssl->heap, DYNAMIC_TYPE_VERIFY_POOL);
+    if (batch == NULL)
+        return;
+    XMEMSET(batch, 0, sizeof(ChainVerifyBatch) +
+                      sizeof(ChainVerifyJob) * count);
+    if (wolfSSL_CondInit(&batch->cond) != 0) {
+        XFREE(batch, ssl->heap, DYNAMIC_TYPE_VERIFY_POOL);
+        return;
+    }
+    batch->jobs = (ChainVerifyJob*)(batch + 1);
+    batch->count = count;
+    batch->heap = ssl->heap;
+    for (i = 0; i < count; i++) {
+        ChainVerifyJob* job = &batch->jobs[i];
+
+        job->batch = batch;
+        job->cert = args->certs[i].buffer;
+        job->certSz = args->certs[i].length;
+        job->issuer = args->certs[i + 1].buffer;
+        job->issuerSz = args->certs[i + 1].length;
+        job->next = (i + 1 < count) ? &batch->jobs[i + 1] : NULL;
+    }
+
+    if (wolfSSL_CondStart(&pool->cond) != 0) {
+        wolfSSL_CondFree(&batch->cond);
+        XFREE(batch, ssl->heap, DYNAMIC_TYPE_VERIFY_POOL);
+        return;
+    }
+    if (pool->tail != NULL)
+        pool->tail->next = &batch->jobs[0];
+    else
+        pool->head = &batch->jobs[0];
+    pool->tail = &batch->jobs[count - 1];
+    wolfSSL_CondSignal(&pool->cond);
+    wolfSSL_CondEnd(&pool->cond);
+
+    args->batch = batch;
+}
+
+/* Wait for the job of the cert at idx, returns it once done */
+static ChainVerifyJob* ChainVerifyWait(ChainVerifyBatch* batch, int idx)
+{
+    ChainVerifyJob* job = &batch->jobs[idx];
+    int done = 0;
+
+    if (wolfSSL_CondStart(&batch->cond) != 0)
+        return NULL;
+    while (!(done = job->done)) {
+        if (wolfSSL_CondWait(&batch->cond) != 0)
+            break;
+    }
+    wolfSSL_CondEnd(&batch->cond);
+
+    return done ? job : NULL;
+}
+
+static void ChainVerifyBatchFree(ChainVerifyBatch* batch)
+{
+    void* heap = batch->heap;
+    int i;
+
+    /* workers still reference the batch until all its jobs ran */
+    for (i = 0; i < batch->count; i++) {
+        ChainVerifyJob* job = ChainVerifyWait(batch, i);
+        if (job != NULL)
+            XFREE(job->key, heap, DYNAMIC_TYPE_PUBLIC_KEY);
+    }
+    wolfSSL_CondFree(&batch->cond);
+    XFREE(batch, heap, DYNAMIC_TYPE_VERIFY_POOL);
+    (void)heap;
+}
+#endif /* WOLFSSL_CHAIN_VERIFY_POOL */
+
 static void FreeProcPeerCertArgs(WOLFSSL* ssl, void* pArgs)
 {
     ProcPeerCertArgs* args = (ProcPeerCertArgs*)pArgs;
@@ -13572,6 +14360,12 @@ static void FreeProcPeerCertArgs(WOLFSSL* ssl, void* pArgs)
         XFREE(args->dCert, ssl->heap, DYNAMIC_TYPE_DCERT);
         args->dCert = NULL;
     }
+#ifdef WOLFSSL_CHAIN_VERIFY_POOL
+    if (args->batch) {
+        ChainVerifyBatchFree(args->batch);
+        args->batch = NULL;
+    }
+#endif
 }
 #if defined(OPENSSL_ALL) && defined(WOLFSSL_CERT_GEN) && \
     (defined(WOLFSSL_CERT_REQ) || defined(WOLFSSL_CERT_EXT)) && \
@@ -13885,6 +14679,20 @@ PRAGMA_GCC_DIAG_POP
     #endif
     }
 
+#ifdef WOLFSSL_CHAIN_VERIFY_POOL
+    /* use the signature check of a worker if it succeeded with the key of
+     * the signer found, otherwise it is checked again while parsing */
+    if (verify == VERIFY && args->batch != NULL &&
+            args->certIdx < args->batch->count) {
+        ChainVerifyJob* job = ChainVerifyWait(args->batch, args->certIdx);
+        if (job != NULL && job->ret == 0) {
+            args->dCert->sigVerifiedKey = job->key;
+            args->dCert->sigVerifiedKeySz = job->keySz;
+            args->dCert->sigVerifiedKeyOID = job->keyOID;
+        }
+    }
+#endif
+
     /* Parse Certificate */
     ret = ParseCertRelative(args->dCert, certType, verify, SSL_CM(ssl));
 
@@ -14469,6 +15277,15 @@ int ProcessPeerCerts(WOLFSSL* ssl, byte* input, word32* inOutIdx,
                 }
             #endif /* WOLFSSL_TRUST_PEER_CERT || OPENSSL_EXTRA */
 
+            #ifdef WOLFSSL_CHAIN_VERIFY_POOL
+                #ifdef WOLFSSL_TRUST_PEER_CERT
+                if (!args->haveTrustPeer)
+                #endif
+                {
+                    ChainVerifyDispatch(ssl, args);
+                }
+            #endif
+
                 /* check certificate up to peer's first */
                 /* do not verify chain if trusted peer cert found */
                 while (args->count > 1
@@ -16647,6 +17464,17 @@ int DoHandShakeMsgType(WOLFSSL* ssl, byte* input, word32* inOutIdx,
         expectedIdx += MacSize(ssl);
 #endif
 
+#ifdef WOLFSSL_SESSION_STORE
+    if (type == client_hello) {
+        /* Session lookup may be pending - process message again. */
+        ret = SessionStorePrefetch(ssl, input + *inOutIdx, size);
+        if (ret == WANT_READ)
+            *inOutIdx -= HANDSHAKE_HEADER_SZ;
+        if (ret != 0)
+            return ret;
+    }
+#endif
+
 #if !defined(NO_WOLFSSL_SERVER) && \
     defined(HAVE_SECURE_RENEGOTIATION) && \
     defined(HAVE_SERVER_RENEGOTIATION_INFO)
@@ -19490,6 +20318,11 @@ static WC_INLINE int CipherHasExpIV(WOLFSSL *ssl)
 #ifdef WOLFSSL_TLS13
     if (ssl->options.tls1_3)
         return 0;
+#endif
+#ifdef WOLFSSL_KTLS
+    /* records from the kernel are plaintext only */
+    if (ssl->options.ktlsRx)
+        return 0;
 #endif
     return (ssl->specs.cipher_type == aead) &&
             (ssl->specs.bulk_cipher_algorithm != wolfssl_chacha);
@@ -20405,8 +21238,14 @@ static int GetInputData(WOLFSSL *ssl, word32 size)
     int inSz;
     int maxLength;
     int usedLength;
-    int dtlsExtra = 0;
+    int extraSz = 0;
 
+    /* the user still holds a view into inputBuffer from wolfSSL_read_zc(),
+     * don't move or reallocate it until the view is released */
+    if (ssl->buffers.clearOutputPinned) {
+        WOLFSSL_MSG("Input buffer pinned by zero-copy read");
+        return WANT_READ;
+    }
 
     /* check max input length */
     usedLength = ssl->buffers.inputBuffer.length - ssl->buffers.inputBuffer.idx;
@@ -20423,7 +21262,18 @@ static int GetInputData(WOLFSSL *ssl, word32 size)
         inSz = MAX_MTU + DTLS_MTU_ADDITIONAL_READ_BUFFER;
 #endif
         if (size < (word32)inSz)
-            dtlsExtra = (int)(inSz - size);
+            extraSz = (int)(inSz - size);
+    }
+#endif
+#ifdef WOLFSSL_KTLS
+    if (ssl->options.ktlsRx) {
+        /* each read from the kernel brings a whole record, its body came in
+         * with the header */
+        if (usedLength >= (int)size)
+            return 0;
+        inSz = RECORD_HEADER_SZ + MAX_RECORD_SIZE;
+        if (size < (word32)inSz)
+            extraSz = (int)(inSz - size);
     }
 #endif
 
@@ -20433,7 +21283,7 @@ static int GetInputData(WOLFSSL *ssl, word32 size)
     }
 
     if (inSz > maxLength) {
-        if (GrowInputBuffer(ssl, size + dtlsExtra, usedLength) < 0)
+        if (GrowInputBuffer(ssl, size + extraSz, usedLength) < 0)
             return MEMORY_E;
     }
 
@@ -20910,8 +21760,18 @@ default:
                 return ret;
             }
 
+#ifdef WOLFSSL_KTLS
+            if (ssl->options.ktlsRx) {
+                /* the kernel already decrypted and verified the record and
+                 * gave it its real content type */
+                ssl->keys.decryptedCur = 1;
+                ssl->keys.encryptSz = ssl->curSize;
+            }
+#endif
+
 #ifdef WOLFSSL_TLS13
             if (IsAtLeastTLSv1_3(ssl->version) && IsEncryptionOn(ssl, 0) &&
+                                        ssl->keys.decryptedCur == 0 &&
                                         ssl->curRL.type != application_data &&
                                         ssl->curRL.type != change_cipher_spec) {
                 SendAlert(ssl, alert_fatal, unexpected_message);
@@ -22241,6 +23101,33 @@ void FreeBuildMsgArgs(WOLFSSL* ssl, BuildMsgArgs* args)
 }
 #endif
 
+#ifdef WOLFSSL_KTLS
+/* Build a plaintext record for KtlsSend(), the kernel encrypts it. */
+int BuildKtlsMessage(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
+                     int inSz, int type, int hashOutput, int sizeOnly)
+{
+    int sz = RECORD_HEADER_SZ + inSz;
+
+    if (sizeOnly)
+        return sz;
+    if (sz > outSz) {
+        WOLFSSL_MSG("Oops, want to write past output buffer size");
+        return BUFFER_E;
+    }
+
+    AddRecordHeader(output, (word32)inSz, (byte)type, ssl, CUR_ORDER);
+    if (input != output + RECORD_HEADER_SZ)
+        XMEMMOVE(output + RECORD_HEADER_SZ, input, (size_t)inSz);
+    if (hashOutput) {
+        int ret = HashOutput(ssl, output, sz, 0);
+        if (ret != 0)
+            return ret;
+    }
+
+    return sz;
+}
+#endif /* WOLFSSL_KTLS */
+
 /* Build SSL Message, encrypted */
 int BuildMessage(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
              int inSz, int type, int hashOutput, int sizeOnly, int asyncOkay,
@@ -22278,6 +23165,12 @@ int BuildMessage(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
                                  hashOutput, sizeOnly, asyncOkay);
     }
 #endif
+#ifdef WOLFSSL_KTLS
+    if (ssl->options.ktlsTx) {
+        return BuildKtlsMessage(ssl, output, outSz, input, inSz, type,
+                                hashOutput, sizeOnly);
+    }
+#endif
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     ret = WC_NO_PENDING_E;
@@ -22469,7 +23362,9 @@ int BuildMessage(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
                                         min(args->ivSz, MAX_IV_SZ));
                 args->idx += min(args->ivSz, MAX_IV_SZ);
             }
-            XMEMCPY(output + args->idx, input, inSz);
+            /* plaintext may already be in place, see SendData() */
+            if (input != output + args->idx)
+                XMEMCPY(output + args->idx, input, inSz);
             args->idx += inSz;
 
             ssl->options.buildMsgState = BUILD_MSG_HASH;
@@ -24086,11 +24981,178 @@ static int ssl_in_handshake(WOLFSSL *ssl, int send)
     return 0;
 }
 
-int SendData(WOLFSSL* ssl, const void* data, int sz)
+#ifdef WOLFSSL_KTLS
+/* Connection level conditions for handing the record layer to the kernel. */
+static int KtlsCanOffload(WOLFSSL* ssl)
+{
+    if (ssl->options.dtls || WOLFSSL_IS_QUIC(ssl) || ssl->wfd < 0 ||
+            ssl->rfd != ssl->wfd || !IsAtLeastTLSv1_2(ssl)) {
+        return 0;
+    }
+    if (ssl->specs.bulk_cipher_algorithm != wolfssl_aes_gcm &&
+            ssl->specs.bulk_cipher_algorithm != wolfssl_chacha) {
+        return 0;
+    }
+#ifdef HAVE_SECURE_RENEGOTIATION
+    /* keys from a renegotiation can't be given to the socket */
+    if (!ssl->options.tls1_3 && ssl->secure_renegotiation != NULL &&
+            ssl->secure_renegotiation->enabled) {
+        return 0;
+    }
+#endif
+#ifdef HAVE_WRITE_DUP
+    if (ssl->dupWrite != NULL)
+        return 0;
+#endif
+#ifdef ATOMIC_USER
+    if (ssl->ctx->MacEncryptCb != NULL || ssl->ctx->DecryptVerifyCb != NULL)
+        return 0;
+#endif
+#ifdef HAVE_PK_CALLBACKS
+    if (ssl->ctx->EncryptKeysCb != NULL ||
+            ssl->ctx->PerformTlsRecordProcessingCb != NULL) {
+        return 0;
+    }
+#endif
+
+    return 1;
+}
+
+/* Offload the record layer of an established connection to kernel TLS, each
+ * direction once nothing for it is left in our buffers. Only connections using
+ * both default socket I/O callbacks are offloaded. When the cipher suite, the
+ * callbacks or the kernel don't allow it the connection quietly stays in user
+ * space. */
+void KtlsTryEnable(WOLFSSL* ssl)
+{
+    int tx, rx;
+
+    if (!ssl->options.useKtls || !ssl->options.handShakeDone ||
+            ssl->options.handShakeState != HANDSHAKE_DONE) {
+        return;
+    }
+
+    tx = !ssl->options.ktlsTx && !ssl->options.ktlsTxOff &&
+         ssl->buffers.outputBuffer.length == 0;
+    rx = !ssl->options.ktlsRx && !ssl->options.ktlsRxOff &&
+         ssl->options.processReply == doProcessInit &&
+         ssl->buffers.inputBuffer.idx == ssl->buffers.inputBuffer.length;
+    if (!tx && !rx)
+        return;
+
+    if (!ssl->options.ktlsUlp) {
+        if (!KtlsCanOffload(ssl) || (ssl->CBIOSend != EmbedSend ||
+                                     ssl->CBIORecv != EmbedReceive) ||
+                KtlsInit(ssl) != 0) {
+            ssl->options.ktlsTxOff = 1;
+            ssl->options.ktlsRxOff = 1;
+            return;
+        }
+        ssl->options.ktlsUlp = 1;
+    }
+
+    if (tx) {
+        if (ssl->CBIOSend == EmbedSend && KtlsSetKeys(ssl, 1) == 0) {
+            WOLFSSL_MSG("kTLS transmit offload on");
+            ssl->options.ktlsTx = 1;
+        }
+        else {
+            ssl->options.ktlsTxOff = 1;
+        }
+    }
+    if (rx) {
+        if (ssl->CBIORecv == EmbedReceive && KtlsSetKeys(ssl, 0) == 0) {
+            WOLFSSL_MSG("kTLS receive offload on");
+            ssl->options.ktlsRx = 1;
+        }
+        else {
+            ssl->options.ktlsRxOff = 1;
+        }
+    }
+}
+#endif /* WOLFSSL_KTLS */
+
+#ifdef WOLFSSL_SEND_GATHER
+/* Offset of the plaintext in the record BuildMessage()/BuildTls13Message()
+ * will write for the current write cipher. Plaintext gathered to this offset
+ * is encrypted in place instead of being copied again. */
+static word32 RecordPlainOffset(WOLFSSL* ssl)
+{
+    word32 offset = RECORD_HEADER_SZ;
+
+#ifdef WOLFSSL_KTLS
+    if (ssl->options.ktlsTx)
+        return offset;
+#endif
+
+#ifdef WOLFSSL_TLS13
+    if (ssl->options.tls1_3) {
+    #ifdef WOLFSSL_DTLS13
+        if (ssl->options.dtls)
+            offset = Dtls13GetRlHeaderLength(ssl, 1);
+    #endif
+        return offset;
+    }
+#endif
+
+#ifdef WOLFSSL_DTLS
+    if (ssl->options.dtls)
+        offset += DTLS_RECORD_EXTRA;
+#endif
+#ifndef WOLFSSL_AEAD_ONLY
+    if (ssl->specs.cipher_type == block && ssl->options.tls1_1)
+        offset += min(ssl->specs.block_size, MAX_IV_SZ);
+#endif
+#ifdef HAVE_AEAD
+    if (ssl->specs.cipher_type == aead &&
+            ssl->specs.bulk_cipher_algorithm != wolfssl_chacha)
+        offset += AESGCM_EXP_IV_SZ;
+#endif
+
+    return offset;
+}
+
+/* Copy sz bytes from the iovecs at the cursor (*idx, *off) into out. With out
+ * NULL the cursor is only moved past them. */
+static void GatherIov(const struct iovec* iov, int iovcnt, int* idx,
+                      word32* off, byte* out, int sz)
+{
+    while (sz > 0 && *idx < iovcnt) {
+        word32 len = (word32)iov[*idx].iov_len - *off;
+
+        if (len > (word32)sz)
+            len = (word32)sz;
+        if (out != NULL) {
+            XMEMCPY(out, (const byte*)iov[*idx].iov_base + *off, len);
+            out += len;
+        }
+        sz  -= (int)len;
+        *off += len;
+        if (*off == (word32)iov[*idx].iov_len) {
+            (*idx)++;
+            *off = 0;
+        }
+    }
+}
+#endif /* WOLFSSL_SEND_GATHER */
+
+/* Send sz bytes of application data. data is the plaintext, or when iovcnt is
+ * non-zero an array of iovcnt struct iovec holding the sz bytes. Gathered
+ * plaintext is copied once, straight into its record. Up to ssl->sendBatch
+ * records are built back-to-back into the output buffer and flushed with a
+ * single send. */
+static int SendDataEx(WOLFSSL* ssl, const void* data, int sz, int iovcnt)
 {
     int sent = 0,  /* plainText size */
         sendSz,
         ret;
+    int batchSz   = 0;  /* plaintext in records built but not yet flushed */
+    int batchRecs = 0;
+    int maxRecs   = 1;
+#ifdef WOLFSSL_SEND_GATHER
+    int    iovIdx = 0;
+    word32 iovOff = 0;
+#endif
 #if defined(WOLFSSL_EARLY_DATA) && defined(WOLFSSL_EARLY_DATA_GROUP)
     int groupMsgs = 0;
 #endif
@@ -24186,6 +25248,33 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
         return WOLFSSL_FATAL_ERROR;
     }
 
+#ifdef WOLFSSL_KTLS
+    KtlsTryEnable(ssl);
+#endif
+
+#ifdef WOLFSSL_SEND_GATHER
+    if (iovcnt > 0) {
+        /* skip what was already sent before a WANT_WRITE */
+        word32 skip = (word32)sent;
+        const struct iovec* iov = (const struct iovec*)data;
+
+        while (iovIdx < iovcnt && skip >= (word32)iov[iovIdx].iov_len)
+            skip -= (word32)iov[iovIdx++].iov_len;
+        iovOff = skip;
+    }
+#else
+    (void)iovcnt;
+#endif
+
+    /* Batching keeps several records in the output buffer at once, which
+     * async crypto and DTLS (one record per datagram) don't allow. */
+#ifndef WOLFSSL_ASYNC_CRYPT
+    if (!ssl->options.dtls && !ssl->options.partialWrite &&
+            ssl->sendBatch > 1) {
+        maxRecs = ssl->sendBatch;
+    }
+#endif
+
     for (;;) {
         byte* out;
         byte* sendBuffer = (byte*)data + sent;  /* may switch on comp */
@@ -24250,7 +25339,7 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
         else
 #endif
         {
-            buffSz = wolfSSL_GetMaxFragSize(ssl, sz - sent);
+            buffSz = wolfSSL_GetMaxFragSize(ssl, sz - sent - batchSz);
 
         }
 
@@ -24267,13 +25356,48 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
         if (IsEncryptionOn(ssl, 1) || ssl->options.tls1_3)
             outputSz += cipherExtraData(ssl);
 
-        /* check for available size */
-        if ((ret = CheckAvailableSize(ssl, outputSz)) != 0)
+        /* check for available size, room for the whole batch up front so the
+         * records already built aren't copied when the buffer grows */
+        if (batchRecs == 0 && maxRecs > 1) {
+            int recs = (sz - sent + buffSz - 1) / buffSz;
+
+            if (recs > maxRecs)
+                recs = maxRecs;
+            ret = CheckAvailableSize(ssl, outputSz * recs);
+        }
+        else {
+            ret = CheckAvailableSize(ssl, outputSz);
+        }
+        if (ret != 0)
             return ssl->error = ret;
 
         /* get output buffer */
         out = GetOutputBuffer(ssl);
 
+#ifdef WOLFSSL_SEND_GATHER
+        if (iovcnt > 0) {
+            /* gather into the record, the builder encrypts it in place */
+            sendBuffer = out + RecordPlainOffset(ssl);
+        #ifdef WOLFSSL_ASYNC_CRYPT
+            /* A pending build owns the record and may have encrypted it
+             * already, only move past its plaintext. */
+            if (ssl->options.buildMsgState != BUILD_MSG_BEGIN) {
+                GatherIov((const struct iovec*)data, iovcnt, &iovIdx, &iovOff,
+                          NULL, buffSz);
+            }
+            else
+        #endif
+            {
+                GatherIov((const struct iovec*)data, iovcnt, &iovIdx,
+                          &iovOff, sendBuffer, buffSz);
+            }
+        }
+        else
+#endif
+        {
+            sendBuffer += batchSz;
+        }
+
 #ifdef HAVE_LIBZ
         if (ssl->options.usingCompression) {
             buffSz = myCompress(ssl, sendBuffer, buffSz, comp, sizeof(comp));
@@ -24317,13 +25441,19 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
         FreeAsyncCtx(ssl, 0);
 #endif
         ssl->buffers.outputBuffer.length += sendSz;
+        batchSz += buffSz;
+        batchRecs++;
+
+        /* store for next call if WANT_WRITE or user embedSend() that
+           doesn't present like WANT_WRITE */
+        ssl->buffers.plainSz  = batchSz;
+        ssl->buffers.prevSent = sent;
+
+        if (batchRecs < maxRecs && sent + batchSz < sz)
+            continue;
 
         if ( (ssl->error = SendBuffered(ssl)) < 0) {
             WOLFSSL_ERROR(ssl->error);
-            /* store for next call if WANT_WRITE or user embedSend() that
-               doesn't present like WANT_WRITE */
-            ssl->buffers.plainSz  = buffSz;
-            ssl->buffers.prevSent = sent;
             if (ssl->error == SOCKET_ERROR_E && (ssl->options.connReset ||
                                                  ssl->options.isClosed)) {
                 ssl->error = SOCKET_PEER_CLOSED_E;
@@ -24333,7 +25463,11 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
             return ssl->error;
         }
 
-        sent += buffSz;
+        sent += batchSz;
+        batchSz = 0;
+        batchRecs = 0;
+        ssl->buffers.plainSz  = 0;
+        ssl->buffers.prevSent = 0;
 
         /* only one message per attempt */
         if (ssl->options.partialWrite == 1) {
@@ -24345,12 +25479,27 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
     return sent;
 }
 
-/* process input data */
-int ReceiveData(WOLFSSL* ssl, byte* output, int sz, int peek)
+int SendData(WOLFSSL* ssl, const void* data, int sz)
 {
-    int size;
+    return SendDataEx(ssl, data, sz, 0);
+}
 
-    WOLFSSL_ENTER("ReceiveData");
+#ifdef WOLFSSL_SEND_GATHER
+/* Send the sz bytes of application data in iovcnt iovecs without first
+ * coalescing them */
+int SendDataV(WOLFSSL* ssl, const struct iovec* iov, int iovcnt, int sz)
+{
+    return SendDataEx(ssl, iov, sz, iovcnt);
+}
+#endif
+
+/* Process records until application data is available in clearOutputBuffer.
+ * Returns WOLFSSL_SUCCESS when data is ready, otherwise the value ReceiveData
+ * should return (0 on closure, negative on error). */
+static int ReceiveDataWait(WOLFSSL* ssl, int sz, int peek)
+{
+    (void)sz;
+    (void)peek;
 
     /* reset error state */
     if (ssl->error == WANT_READ || ssl->error == WOLFSSL_ERROR_WANT_READ) {
@@ -24417,6 +25566,9 @@ startScr:
 #endif
 
     while (ssl->buffers.clearOutputBuffer.length == 0) {
+    #ifdef WOLFSSL_KTLS
+        KtlsTryEnable(ssl);
+    #endif
         if ( (ssl->error = ProcessReply(ssl)) < 0) {
             if (ssl->error == ZERO_RETURN) {
                 WOLFSSL_MSG("Zero return, no more data coming");
@@ -24491,6 +25643,20 @@ startScr:
 #endif
     }
 
+    return WOLFSSL_SUCCESS;
+}
+
+/* process input data */
+int ReceiveData(WOLFSSL* ssl, byte* output, int sz, int peek)
+{
+    int size;
+
+    WOLFSSL_ENTER("ReceiveData");
+
+    size = ReceiveDataWait(ssl, sz, peek);
+    if (size != WOLFSSL_SUCCESS)
+        return size;
+
     size = min(sz, (int)ssl->buffers.clearOutputBuffer.length);
 
     XMEMCPY(output, ssl->buffers.clearOutputBuffer.buffer, size);
@@ -24498,6 +25664,8 @@ startScr:
     if (peek == 0) {
         ssl->buffers.clearOutputBuffer.length -= size;
         ssl->buffers.clearOutputBuffer.buffer += size;
+        if (ssl->buffers.clearOutputBuffer.length == 0)
+            ssl->buffers.clearOutputPinned = 0;
     }
 
     if (ssl->buffers.inputBuffer.dynamicFlag)
@@ -24507,6 +25675,51 @@ startScr:
     return size;
 }
 
+/* Zero-copy variant of ReceiveData. Points *data at the decrypted record
+ * still in inputBuffer and pins it until ReleaseReceivedData() consumes it.
+ * Returns the number of bytes in the view, 0 on closure or an error code. */
+int ReceiveDataView(WOLFSSL* ssl, const byte** data)
+{
+    int size;
+
+    WOLFSSL_ENTER("ReceiveDataView");
+
+    size = ReceiveDataWait(ssl, 0, 0);
+    if (size != WOLFSSL_SUCCESS)
+        return size;
+
+    *data = ssl->buffers.clearOutputBuffer.buffer;
+    size = (int)ssl->buffers.clearOutputBuffer.length;
+    ssl->buffers.clearOutputPinned = 1;
+
+    WOLFSSL_LEAVE("ReceiveDataView()", size);
+    return size;
+}
+
+/* Consume sz bytes of the view handed out by ReceiveDataView(). Once the
+ * whole record is consumed the input buffer may be moved or shrunk again. */
+int ReleaseReceivedData(WOLFSSL* ssl, int sz)
+{
+    WOLFSSL_ENTER("ReleaseReceivedData");
+
+    if (!ssl->buffers.clearOutputPinned)
+        return BAD_STATE_E;
+    if (sz < 0 || sz > (int)ssl->buffers.clearOutputBuffer.length)
+        return BAD_FUNC_ARG;
+
+    ssl->buffers.clearOutputBuffer.length -= (word32)sz;
+    ssl->buffers.clearOutputBuffer.buffer += sz;
+
+    if (ssl->buffers.clearOutputBuffer.length == 0) {
+        ssl->buffers.clearOutputPinned = 0;
+        if (ssl->buffers.inputBuffer.dynamicFlag)
+            ShrinkInputBuffer(ssl, NO_FORCED_FREE);
+    }
+
+    WOLFSSL_LEAVE("ReleaseReceivedData()", 0);
+    return 0;
+}
+
 static int SendAlert_ex(WOLFSSL* ssl, int severity, int type)
 {
     byte input[ALERT_SIZE];
@@ -37764,6 +38977,10 @@ static int TicketEncCbCtx_Init(WOLFSSL_CTX* ctx, TicketEncCbCtx* keyCtx)
         sizeof(keyCtx->key[0]));
     wc_MemZero_Add("TicketEncCbCtx_Init keyCtx->key[1]", keyCtx->key[1],
         sizeof(keyCtx->key[1]));
+#ifdef WOLFSSL_TICKET_KEY_SET
+    wc_MemZero_Add("TicketEncCbCtx_Init keyCtx->keySet", keyCtx->keySet,
+        sizeof(keyCtx->keySet));
+#endif
 #endif
 
 #ifndef SINGLE_THREADED
@@ -37827,11 +39044,17 @@ static void TicketEncCbCtx_Free(TicketEncCbCtx* keyCtx)
     ForceZero(keyCtx->name, sizeof(keyCtx->name));
     ForceZero(keyCtx->key[0], sizeof(keyCtx->key[0]));
     ForceZero(keyCtx->key[1], sizeof(keyCtx->key[1]));
+#ifdef WOLFSSL_TICKET_KEY_SET
+    ForceZero(&keyCtx->keySet, sizeof(keyCtx->keySet));
+#endif
 
 #ifdef WOLFSSL_CHECK_MEM_ZERO
     wc_MemZero_Check(keyCtx->name, sizeof(keyCtx->name));
     wc_MemZero_Check(keyCtx->key[0], sizeof(keyCtx->key[0]));
     wc_MemZero_Check(keyCtx->key[1], sizeof(keyCtx->key[1]));
+#ifdef WOLFSSL_TICKET_KEY_SET
+    wc_MemZero_Check(&keyCtx->keySet, sizeof(keyCtx->keySet));
+#endif
 #endif
 
 #ifndef SINGLE_THREADED
@@ -38080,6 +39303,359 @@ static int TicketEncCbCtx_ChooseKey(TicketEncCbCtx* keyCtx, int ticketHint,
     return ret;
 }
 
+#ifdef WOLFSSL_TICKET_KEY_SET
+/* Bucket of key name in key set index.
+ *
+ * FNV-1a over whole name as operators may give names a common prefix.
+ *
+ * @param [in]  name  Name of key.
+ * @return  Index of first bucket to probe.
+ */
+static word32 TicketKeySet_Bucket(const byte* name)
+{
+    word32 h = 0x811c9dc5;
+    int i;
+
+    for (i = 0; i < WOLFSSL_TICKET_NAME_SZ; i++) {
+        h = (h ^ name[i]) * 0x01000193;
+    }
+
+    return h % WOLFSSL_TICKET_KEY_SET_BUCKETS;
+}
+
+/* Replace the operator keys of the session ticket encryption context.
+ *
+ * Keys are replaced under the mutex. Callbacks copy out the key they use under
+ * the mutex so a replacement never changes a key being used.
+ *
+ * @param [in]  keyCtx  Context for session ticket encryption.
+ * @param [in]  keys    Operator keys. May be NULL when cnt is 0.
+ * @param [in]  cnt     Number of keys. 0 removes operator keys.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when two keys have the same name.
+ * @return  BAD_MUTEX_E when locking mutex fails.
+ */
+int TicketEncCbCtx_SetKeys(TicketEncCbCtx* keyCtx,
+                           const WOLFSSL_TICKET_KEY* keys, int cnt)
+{
+    int ret = 0;
+    byte bucket[WOLFSSL_TICKET_KEY_SET_BUCKETS];
+    int i;
+
+    WOLFSSL_ASSERT_TEST(WOLFSSL_TICKET_KEY_SZ, WOLFSSL_TICKET_KEY_MAX_SZ, <=);
+
+    /* Build name index before taking the lock. */
+    XMEMSET(bucket, 0, sizeof(bucket));
+    for (i = 0; (ret == 0) && (i < cnt); i++) {
+        word32 b = TicketKeySet_Bucket(keys[i].name);
+
+        while (bucket[b] != 0) {
+            if (XMEMCMP(keys[bucket[b] - 1].name, keys[i].name,
+                    WOLFSSL_TICKET_NAME_SZ) == 0) {
+                WOLFSSL_MSG("Ticket key name used twice");
+                ret = BAD_FUNC_ARG;
+                break;
+            }
+            b = (b + 1) % WOLFSSL_TICKET_KEY_SET_BUCKETS;
+        }
+        bucket[b] = (byte)(i + 1);
+    }
+    if (ret != 0) {
+        return ret;
+    }
+
+#ifndef SINGLE_THREADED
+    if (wc_LockMutex(&keyCtx->mutex) != 0) {
+        WOLFSSL_MSG("Couldn't lock key context mutex");
+        return BAD_MUTEX_E;
+    }
+#endif
+    ForceZero(keyCtx->keySet.key, sizeof(keyCtx->keySet.key));
+    if (cnt > 0) {
+        XMEMCPY(keyCtx->keySet.key, keys,
+                (size_t)cnt * sizeof(WOLFSSL_TICKET_KEY));
+    }
+    /* Empty index when removing keys - no name found. */
+    XMEMCPY(keyCtx->keySet.bucket, bucket, sizeof(bucket));
+    keyCtx->keySet.cnt = cnt;
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&keyCtx->mutex);
+#endif
+
+    return ret;
+}
+
+/* Find an operator key by name.
+ *
+ * @param [in]  set   Operator key set.
+ * @param [in]  name  Name of key from ticket.
+ * @return  Key with name on success.
+ * @return  NULL when no key has the name.
+ */
+static const WOLFSSL_TICKET_KEY* TicketKeySet_Find(const TicketKeySet* set,
+                                                   const byte* name)
+{
+    word32 b = TicketKeySet_Bucket(name);
+    int i;
+
+    /* Always an empty bucket as there are twice the buckets of keys. */
+    for (i = 0; (i < WOLFSSL_TICKET_KEY_SET_BUCKETS) && (set->bucket[b] != 0);
+            i++) {
+        const WOLFSSL_TICKET_KEY* key = &set->key[set->bucket[b] - 1];
+
+        if (XMEMCMP(key->name, name, WOLFSSL_TICKET_NAME_SZ) == 0) {
+            return key;
+        }
+        b = (b + 1) % WOLFSSL_TICKET_KEY_SET_BUCKETS;
+    }
+
+    return NULL;
+}
+
+/* Choose the operator key to encrypt new tickets with.
+ *
+ * Latest key to start encrypting that can still decrypt when ticket expires.
+ *
+ * @param [in]  set         Operator key set.
+ * @param [in]  now         Current time in seconds.
+ * @param [in]  ticketHint  Session ticket lifetime in seconds.
+ * @return  Key to encrypt with on success.
+ * @return  NULL when no key is scheduled for now.
+ */
+static const WOLFSSL_TICKET_KEY* TicketKeySet_Active(const TicketKeySet* set,
+                                                     word32 now, int ticketHint)
+{
+    const WOLFSSL_TICKET_KEY* active = NULL;
+    int i;
+
+    for (i = 0; i < set->cnt; i++) {
+        const WOLFSSL_TICKET_KEY* key = &set->key[i];
+
+        if ((key->encStart <= now) &&
+                (key->decEnd > now + (word32)ticketHint) &&
+                ((active == NULL) || (key->encStart > active->encStart))) {
+            active = key;
+        }
+    }
+
+    return active;
+}
+#endif /* WOLFSSL_TICKET_KEY_SET */
+
+#ifdef WOLFSSL_TICKET_ENC_BATCH
+/* Encrypt a ticket with the AES-GCM cipher kept on the connection.
+ *
+ * The key schedule and GHASH table are only made when the key changes, so
+ * they are made once for all the tickets a connection sends.
+ *
+ * @param [in]   ssl     SSL connection.
+ * @param [in]   key     Key for encryption.
+ * @param [in]   iv      IV/Nonce for encryption.
+ * @param [in]   aad     Additional authentication data.
+ * @param [in]   aadSz   Length of additional authentication data.
+ * @param [in]   in      Data to encrypt.
+ * @param [in]   inLen   Length of data.
+ * @param [out]  out     Encrypted data.
+ * @param [out]  outLen  Size of encrypted data.
+ * @param [out]  tag     Authentication tag for encrypted data.
+ * @return  0 on success.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  Other value when encryption fails.
+ */
+static int TicketEncBatch_Encrypt(WOLFSSL* ssl, const byte* key, byte* iv,
+                                  byte* aad, int aadSz, byte* in, int inLen,
+                                  byte* out, int* outLen, byte* tag)
+{
+    int ret = 0;
+    TicketEncBatch* batch = ssl->ticketEncBatch;
+
+    if (batch == NULL) {
+        batch = (TicketEncBatch*)XMALLOC(sizeof(TicketEncBatch), ssl->heap,
+                                         DYNAMIC_TYPE_CIPHER);
+        if (batch == NULL) {
+            return MEMORY_E;
+        }
+        XMEMSET(batch, 0, sizeof(TicketEncBatch));
+        ret = wc_AesInit(&batch->aes, NULL, INVALID_DEVID);
+        if (ret != 0) {
+            XFREE(batch, ssl->heap, DYNAMIC_TYPE_CIPHER);
+            return ret;
+        }
+        ssl->ticketEncBatch = batch;
+    }
+
+    if ((!batch->ready) ||
+            (ConstantCompare(batch->key, key, WOLFSSL_TICKET_KEY_SZ) != 0)) {
+        batch->ready = 0;
+        ret = wc_AesGcmSetKey(&batch->aes, key, WOLFSSL_TICKET_KEY_SZ);
+        if (ret == 0) {
+            XMEMCPY(batch->key, key, WOLFSSL_TICKET_KEY_SZ);
+            batch->ready = 1;
+        }
+    }
+    if (ret == 0) {
+        ret = wc_AesGcmEncrypt(&batch->aes, in, out, inLen, iv,
+                               GCM_NONCE_MID_SZ, tag, AES_BLOCK_SIZE, aad,
+                               aadSz);
+    }
+
+    *outLen = inLen;
+
+    return ret;
+}
+
+/* Free the ticket cipher kept on the connection.
+ *
+ * @param [in]  ssl  SSL connection.
+ */
+void FreeTicketEncBatch(WOLFSSL* ssl)
+{
+    if (ssl->ticketEncBatch != NULL) {
+        wc_AesFree(&ssl->ticketEncBatch->aes);
+        ForceZero(ssl->ticketEncBatch, sizeof(TicketEncBatch));
+        XFREE(ssl->ticketEncBatch, ssl->heap, DYNAMIC_TYPE_CIPHER);
+        ssl->ticketEncBatch = NULL;
+    }
+    ssl->options.ticketEncBatch = 0;
+}
+#endif /* WOLFSSL_TICKET_ENC_BATCH */
+
+#ifdef WOLFSSL_TICKET_KEY_SET
+/* Encrypt a ticket, with the connection's cipher when sending a number.
+ *
+ * @param [in]   ssl     SSL connection.
+ * @param [in]   key     Key for encryption.
+ * @param [in]   iv      IV/Nonce for encryption.
+ * @param [in]   aad     Additional authentication data.
+ * @param [in]   aadSz   Length of additional authentication data.
+ * @param [in]   ticket  Ticket to encrypt in place.
+ * @param [in]   inLen   Length of ticket.
+ * @param [out]  outLen  Size of encrypted ticket.
+ * @param [out]  mac     Authentication tag for encrypted ticket.
+ * @return  0 on success.
+ * @return  Other value when encryption fails.
+ */
+static int TicketEncrypt(WOLFSSL* ssl, byte* key, byte* iv, byte* aad,
+                         int aadSz, byte* ticket, int inLen, int* outLen,
+                         byte* mac)
+{
+#ifdef WOLFSSL_TICKET_ENC_BATCH
+    if (ssl->options.ticketEncBatch) {
+        return TicketEncBatch_Encrypt(ssl, key, iv, aad, aadSz, ticket, inLen,
+                                      ticket, outLen, mac);
+    }
+#endif
+    return TicketEncDec(key, WOLFSSL_TICKET_KEY_SZ, iv, aad, aadSz, ticket,
+                        inLen, ticket, outLen, mac, ssl->heap, 1);
+}
+
+/* Encrypt or decrypt a ticket with an operator key.
+ *
+ * AAD = key_name | iv | ticket len (16-bits network order)
+ *
+ * The key is copied out under the mutex so that it can't be replaced while
+ * being used.
+ *
+ * @param [in]      ssl       SSL connection.
+ * @param [in]      keyCtx    Context for session ticket encryption.
+ * @param [in,out]  key_name  Name of key.
+ *                            Encrypt: name of key returned.
+ *                            Decrypt: name from ticket message to find.
+ * @param [in,out]  iv        IV to use in encryption/decryption.
+ * @param [in]      mac       MAC for authentication of encrypted data.
+ * @param [in]      enc       1 when encrypting ticket, 0 when decrypting.
+ * @param [in,out]  ticket    Encrypted/decrypted session ticket bytes.
+ * @param [in]      inLen     Length of incoming ticket.
+ * @param [out]     outLen    Length of outgoing ticket.
+ * @param [out]     found     1 when an operator key was used, 0 when the
+ *                            context's own keys are to be used.
+ * @return  WOLFSSL_TICKET_RET_OK when successful.
+ * @return  WOLFSSL_TICKET_RET_REJECT when failed to produce valid encrypted or
+ *          decrypted ticket.
+ */
+static int TicketKeySet_EncDec(WOLFSSL* ssl, TicketEncCbCtx* keyCtx,
+                               byte key_name[WOLFSSL_TICKET_NAME_SZ],
+                               byte iv[WOLFSSL_TICKET_IV_SZ],
+                               byte mac[WOLFSSL_TICKET_MAC_SZ],
+                               int enc, byte* ticket, int inLen, int* outLen,
+                               int* found)
+{
+    int ret;
+    word16 sLen = XHTONS((word16)inLen);
+    byte aad[WOLFSSL_TICKET_NAME_SZ + WOLFSSL_TICKET_IV_SZ + sizeof(sLen)];
+    int  aadSz = WOLFSSL_TICKET_NAME_SZ + WOLFSSL_TICKET_IV_SZ + sizeof(sLen);
+    byte key[WOLFSSL_TICKET_KEY_SZ];
+    const WOLFSSL_TICKET_KEY* opKey;
+    word32 now = LowResTimer();
+    word32 decEnd = 0;
+
+    *found = 0;
+#ifndef SINGLE_THREADED
+    if (wc_LockMutex(&keyCtx->mutex) != 0) {
+        WOLFSSL_MSG("Couldn't lock key context mutex");
+        *found = 1;
+        return WOLFSSL_TICKET_RET_REJECT;
+    }
+#endif
+    if (enc) {
+        opKey = TicketKeySet_Active(&keyCtx->keySet, now,
+                                    ssl->ctx->ticketHint);
+    }
+    else {
+        opKey = TicketKeySet_Find(&keyCtx->keySet, key_name);
+    }
+    if (opKey != NULL) {
+        *found = 1;
+        decEnd = opKey->decEnd;
+        /* Copy out before unlocking - keys may be replaced after. */
+        XMEMCPY(key, opKey->key, WOLFSSL_TICKET_KEY_SZ);
+        if (enc) {
+            XMEMCPY(key_name, opKey->name, WOLFSSL_TICKET_NAME_SZ);
+        }
+    }
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&keyCtx->mutex);
+#endif
+    if (!*found) {
+        return WOLFSSL_TICKET_RET_OK;
+    }
+    if (!enc && (decEnd <= now)) {
+        ForceZero(key, sizeof(key));
+        return WOLFSSL_TICKET_RET_REJECT;
+    }
+
+    if (enc) {
+        /* Don't use the RNG in keyCtx as it's for generating private data. */
+        ret = wc_RNG_GenerateBlock(ssl->rng, iv, WOLFSSL_TICKET_IV_SZ);
+        if (ret != 0) {
+            ForceZero(key, sizeof(key));
+            return WOLFSSL_TICKET_RET_REJECT;
+        }
+    }
+
+    /* Build AAD from: key name, iv, and length of ticket. */
+    XMEMCPY(aad, key_name, WOLFSSL_TICKET_NAME_SZ);
+    XMEMCPY(aad + WOLFSSL_TICKET_NAME_SZ, iv, WOLFSSL_TICKET_IV_SZ);
+    XMEMCPY(aad + WOLFSSL_TICKET_NAME_SZ + WOLFSSL_TICKET_IV_SZ, &sLen,
+            sizeof(sLen));
+
+    if (enc) {
+        ret = TicketEncrypt(ssl, key, iv, aad, aadSz, ticket, inLen, outLen,
+                            mac);
+    }
+    else {
+        ret = TicketEncDec(key, WOLFSSL_TICKET_KEY_SZ, iv, aad, aadSz, ticket,
+                           inLen, ticket, outLen, mac, ssl->heap, 0);
+    }
+    ForceZero(key, sizeof(key));
+    if (ret != 0) {
+        return WOLFSSL_TICKET_RET_REJECT;
+    }
+
+    return WOLFSSL_TICKET_RET_OK;
+}
+#endif /* WOLFSSL_TICKET_KEY_SET */
+
 /* Default Session Ticket encryption/decryption callback.
  *
  * Use ChaCha20-Poly1305, AES-GCM or SM4-GCM to encrypt/decrypt the ticket.
@@ -38099,6 +39675,9 @@ static int TicketEncCbCtx_ChooseKey(TicketEncCbCtx* keyCtx, int ticketHint,
  * that if one ticket is only valid for decryption, then the other will be
  * valid for encryption.
  * AAD = key_name | iv | ticket len (16-bits network order)
+ * With operator keys set, they are used first: the scheduled key encrypts and
+ * a ticket is decrypted with the key found by name. The context's own keys are
+ * used when no operator key is scheduled or has the name.
  *
  * @param [in]      ssl       SSL connection.
  * @param [in,out]  key_name  Name of key from client.
@@ -38135,6 +39714,23 @@ static int DefTicketEncCb(WOLFSSL* ssl, byte key_name[WOLFSSL_TICKET_NAME_SZ],
 
     WOLFSSL_ENTER("DefTicketEncCb");
 
+#ifdef WOLFSSL_TICKET_KEY_SET
+    {
+        int found;
+
+        ret = TicketKeySet_EncDec(ssl, keyCtx, key_name, iv, mac, enc, ticket,
+                                  inLen, outLen, &found);
+        if (found) {
+        #ifndef WOLFSSL_TICKET_DECRYPT_NO_CREATE
+            if ((ret == WOLFSSL_TICKET_RET_OK) &&
+                    !IsAtLeastTLSv1_3(ssl->version) && !enc)
+                return WOLFSSL_TICKET_RET_CREATE;
+        #endif
+            return ret;
+        }
+    }
+#endif
+
     /* Check we have setup the RNG, name and primary key. */
     if (keyCtx->expirary[0] == 0) {
 #ifndef SINGLE_THREADED
@@ -38221,9 +39817,14 @@ static int DefTicketEncCb(WOLFSSL* ssl, byte key_name[WOLFSSL_TICKET_NAME_SZ],
         aad[WOLFSSL_TICKET_NAME_SZ - 1] |= keyIdx;
 
         /* Encrypt ticket data. */
+#ifdef WOLFSSL_TICKET_ENC_BATCH
+        ret = TicketEncrypt(ssl, keyCtx->key[keyIdx], iv, aad, aadSz, ticket,
+                            inLen, outLen, mac);
+#else
         ret = TicketEncDec(keyCtx->key[keyIdx], WOLFSSL_TICKET_KEY_SZ, iv, aad,
                            aadSz, ticket, inLen, ticket, outLen, mac, ssl->heap,
                            1);
+#endif
         if (ret != 0) return WOLFSSL_TICKET_RET_REJECT;
     }
     /* Decrypt ticket. */
@@ -3577,6 +3577,19 @@ int SetKeysSide(WOLFSSL* ssl, enum encrypt_side side)
         ret = wolfSSL_quic_keys_active(ssl, side);
     }
 #endif /* WOLFSSL_QUIC */
+#ifdef WOLFSSL_KTLS
+    /* TLS v1.3 KeyUpdate, re-key the offloaded directions of the socket */
+    if (ret == 0 && wc_decrypt != NULL && ssl->options.ktlsRx)
+        ret = KtlsSetKeys(ssl, 0);
+    if (ret == 0 && wc_encrypt != NULL && ssl->options.ktlsTx) {
+        /* queued records were built for the old key, SendBuffered()
+         * switches once they are out */
+        if (ssl->buffers.outputBuffer.length > 0)
+            ssl->options.ktlsTxRekey = 1;
+        else
+            ret = KtlsSetKeys(ssl, 1);
+    }
+#endif /* WOLFSSL_KTLS */
 
 #ifdef HAVE_SECURE_RENEGOTIATION
 #ifdef WOLFSSL_DTLS
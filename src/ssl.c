@@ -3262,16 +3262,12 @@ int wolfSSL_GetDhKey_Sz(WOLFSSL* ssl)
 #endif /* !NO_DH */
 
 
-WOLFSSL_ABI
-int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
+/* data is the plaintext, or when iovcnt is non-zero the caller's iovecs */
+static int wolfSSL_write_internal(WOLFSSL* ssl, const void* data, int sz,
+                                  int iovcnt)
 {
     int ret;
 
-    WOLFSSL_ENTER("wolfSSL_write");
-
-    if (ssl == NULL || data == NULL || sz < 0)
-        return BAD_FUNC_ARG;
-
 #ifdef WOLFSSL_QUIC
     if (WOLFSSL_IS_QUIC(ssl)) {
         WOLFSSL_MSG("SSL_write() on QUIC not allowed");
@@ -3319,9 +3315,14 @@ int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
         ssl->cbmode = SSL_CB_WRITE;
     }
     #endif
-    ret = SendData(ssl, data, sz);
-
-    WOLFSSL_LEAVE("wolfSSL_write", ret);
+#ifdef WOLFSSL_SEND_GATHER
+    if (iovcnt > 0)
+        ret = SendDataV(ssl, (const struct iovec*)data, iovcnt, sz);
+    else
+#else
+    (void)iovcnt;
+#endif
+        ret = SendData(ssl, data, sz);
 
     if (ret < 0)
         return WOLFSSL_FATAL_ERROR;
@@ -3329,6 +3330,221 @@ int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
         return ret;
 }
 
+WOLFSSL_ABI
+int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
+{
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_write");
+
+    if (ssl == NULL || data == NULL || sz < 0)
+        return BAD_FUNC_ARG;
+
+    ret = wolfSSL_write_internal(ssl, data, sz, 0);
+
+    WOLFSSL_LEAVE("wolfSSL_write", ret);
+
+    return ret;
+}
+
+/* Set the number of application data records built before they are sent
+ * together. 1 sends each record as soon as it is built. */
+int wolfSSL_CTX_set_send_batch(WOLFSSL_CTX* ctx, int records)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_set_send_batch");
+
+    if (ctx == NULL || records < 1 || records > WOLFSSL_MAX_SEND_BATCH)
+        return BAD_FUNC_ARG;
+
+    ctx->sendBatch = (byte)records;
+
+    return WOLFSSL_SUCCESS;
+}
+
+int wolfSSL_set_send_batch(WOLFSSL* ssl, int records)
+{
+    WOLFSSL_ENTER("wolfSSL_set_send_batch");
+
+    if (ssl == NULL || records < 1 || records > WOLFSSL_MAX_SEND_BATCH)
+        return BAD_FUNC_ARG;
+
+    ssl->sendBatch = (byte)records;
+
+    return WOLFSSL_SUCCESS;
+}
+
+int wolfSSL_get_send_batch(const WOLFSSL* ssl)
+{
+    if (ssl == NULL)
+        return BAD_FUNC_ARG;
+
+    return ssl->sendBatch;
+}
+
+/* Lend record buffers to the connections of ctx from a pool instead of
+ * allocating one each time a connection needs more than its static buffer.
+ * Buffers go back to the pool when the connection is idle again; up to
+ * maxIdle of them are kept for reuse. bufSz is the usable size of a buffer,
+ * 0 for one full size record. Larger needs are still allocated. maxIdle of 0
+ * stops lending. maxIdle can be changed any time, bufSz only while no
+ * buffer is lent out. */
+int wolfSSL_CTX_set_record_pool(WOLFSSL_CTX* ctx, int maxIdle, int bufSz)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_set_record_pool");
+
+#ifndef WOLFSSL_NO_RECORD_POOL
+    if (ctx == NULL || maxIdle < 0 || bufSz < 0 ||
+            bufSz > WOLFSSL_MAX_SEND_BATCH * WOLFSSL_RECORD_POOL_BUF_SZ)
+        return BAD_FUNC_ARG;
+
+    if (bufSz == 0)
+        bufSz = WOLFSSL_RECORD_POOL_BUF_SZ;
+
+    return RecordPoolSet(ctx, (word32)maxIdle, (word32)bufSz);
+#else
+    (void)ctx;
+    (void)maxIdle;
+    (void)bufSz;
+    return NOT_COMPILED_IN;
+#endif
+}
+
+int wolfSSL_CTX_get_record_pool_stats(WOLFSSL_CTX* ctx,
+                                      WOLFSSL_RECORD_POOL_STATS* stats)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_get_record_pool_stats");
+
+    if (ctx == NULL || stats == NULL)
+        return BAD_FUNC_ARG;
+
+#ifndef WOLFSSL_NO_RECORD_POOL
+    RecordPoolGetStats(ctx, stats);
+
+    return WOLFSSL_SUCCESS;
+#else
+    return NOT_COMPILED_IN;
+#endif
+}
+
+/* Check the signatures of a peer's certificate chain on a pool of worker
+ * threads owned by ctx. Each cert below the top of the chain is checked with
+ * the key of the next one in parallel while the top one is verified against
+ * the trusted CAs. Results are only used when the signer found while
+ * verifying has that same key. workers of 0 stops the pool. Set it up
+ * before handshakes use ctx. */
+int wolfSSL_CTX_set_verify_workers(WOLFSSL_CTX* ctx, int workers)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_set_verify_workers");
+
+#ifdef WOLFSSL_CHAIN_VERIFY_POOL
+    if (ctx == NULL || workers < 0 ||
+            workers > WOLFSSL_CHAIN_VERIFY_MAX_WORKERS)
+        return BAD_FUNC_ARG;
+
+    return ChainVerifyPoolSet(ctx, workers);
+#else
+    (void)ctx;
+    (void)workers;
+    return NOT_COMPILED_IN;
+#endif
+}
+
+/* Keep up to size key pairs of a TLS 1.3 key share group made ahead of the
+ * handshakes of ctx. X25519, SECP256R1 and the Kyber groups are supported.
+ * Each key pair is handed to one handshake only. size of 0 drops the group.
+ * The pool is refilled by wolfSSL_CTX_keyshare_pool_fill() or the thread of
+ * wolfSSL_CTX_keyshare_pool_start(). */
+int wolfSSL_CTX_set_keyshare_pool(WOLFSSL_CTX* ctx, word16 group, int size)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_set_keyshare_pool");
+
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    if (ctx == NULL || size < 0 || size > WOLFSSL_KEY_SHARE_POOL_MAX)
+        return BAD_FUNC_ARG;
+
+    return KeySharePoolSet(ctx, group, (word32)size);
+#else
+    (void)ctx;
+    (void)group;
+    (void)size;
+    return NOT_COMPILED_IN;
+#endif
+}
+
+/* Generate up to max key pairs, all missing ones when max is 0, on the
+ * calling thread. For event loops filling the pool in idle time.
+ * return number generated or error */
+int wolfSSL_CTX_keyshare_pool_fill(WOLFSSL_CTX* ctx, int max)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_keyshare_pool_fill");
+
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    if (ctx == NULL || max < 0)
+        return BAD_FUNC_ARG;
+
+    return KeySharePoolFill(ctx, max);
+#else
+    (void)ctx;
+    (void)max;
+    return NOT_COMPILED_IN;
+#endif
+}
+
+/* Start a thread refilling the key share pool as handshakes take from it.
+ * It runs until ctx is freed. */
+int wolfSSL_CTX_keyshare_pool_start(WOLFSSL_CTX* ctx)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_keyshare_pool_start");
+
+#if defined(WOLFSSL_KEY_SHARE_POOL) && !defined(SINGLE_THREADED)
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    return KeySharePoolStart(ctx);
+#else
+    (void)ctx;
+    return NOT_COMPILED_IN;
+#endif
+}
+
+int wolfSSL_CTX_get_keyshare_pool_stats(WOLFSSL_CTX* ctx, word16 group,
+                                        WOLFSSL_KEYSHARE_POOL_STATS* stats)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_get_keyshare_pool_stats");
+
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    if (ctx == NULL || stats == NULL)
+        return BAD_FUNC_ARG;
+
+    return KeySharePoolGetStats(ctx, group, stats);
+#else
+    (void)ctx;
+    (void)group;
+    (void)stats;
+    return NOT_COMPILED_IN;
+#endif
+}
+
+/* Turn off, or back on, copying the TLS 1.3 Certificate message of the
+ * server from a body encoded once for the certificate and chain of ctx.
+ * On by default. */
+int wolfSSL_CTX_set_cert_msg_cache(WOLFSSL_CTX* ctx, int on)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_set_cert_msg_cache");
+
+#ifdef WOLFSSL_CERT_MSG_CACHE
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    ctx->certMsgCache.off = (on == 0);
+    return WOLFSSL_SUCCESS;
+#else
+    (void)ctx;
+    (void)on;
+    return NOT_COMPILED_IN;
+#endif
+}
+
 static int wolfSSL_read_internal(WOLFSSL* ssl, void* data, int sz, int peek)
 {
     int ret;
@@ -3434,6 +3650,69 @@ int wolfSSL_read(WOLFSSL* ssl, void* data, int sz)
 }
 
 
+/* Zero-copy read. On success *data points at decrypted application data that
+ * still lives in the input buffer and the number of bytes available is
+ * returned. The view stays valid, and no further records are read, until it
+ * is consumed with wolfSSL_read_release(). Calling again before the view is
+ * fully released returns the unconsumed remainder of the same record. */
+int wolfSSL_read_zc(WOLFSSL* ssl, const unsigned char** data)
+{
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_read_zc");
+
+    if (ssl == NULL || data == NULL)
+        return BAD_FUNC_ARG;
+
+    *data = NULL;
+
+#ifdef WOLFSSL_QUIC
+    if (WOLFSSL_IS_QUIC(ssl)) {
+        WOLFSSL_MSG("SSL_read() on QUIC not allowed");
+        return BAD_FUNC_ARG;
+    }
+#endif
+#ifdef HAVE_WRITE_DUP
+    if (ssl->dupWrite && ssl->dupSide == WRITE_DUP_SIDE) {
+        WOLFSSL_MSG("Write dup side cannot read");
+        return WRITE_DUP_READ_E;
+    }
+#endif
+
+#ifdef HAVE_ERRNO_H
+        errno = 0;
+#endif
+
+    ret = ReceiveDataView(ssl, data);
+
+    WOLFSSL_LEAVE("wolfSSL_read_zc", ret);
+
+    if (ret < 0)
+        return WOLFSSL_FATAL_ERROR;
+    else
+        return ret;
+}
+
+
+/* Consume sz bytes of the view returned by wolfSSL_read_zc(). Releasing the
+ * whole view unpins the input buffer so the next record can be read. */
+int wolfSSL_read_release(WOLFSSL* ssl, int sz)
+{
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_read_release");
+
+    if (ssl == NULL)
+        return BAD_FUNC_ARG;
+
+    ret = ReleaseReceivedData(ssl, sz);
+
+    WOLFSSL_LEAVE("wolfSSL_read_release", ret);
+
+    return ret == 0 ? WOLFSSL_SUCCESS : ret;
+}
+
+
 #ifdef WOLFSSL_MULTICAST
 
 int wolfSSL_mcast_read(WOLFSSL* ssl, word16* id, void* data, int sz)
@@ -4288,6 +4567,57 @@ size_t wolfSSL_CTX_get_num_tickets(WOLFSSL_CTX* ctx)
     return (size_t)ctx->maxTicketTls13;
 }
 #endif /* WOLFSSL_TLS13 */
+
+/* Set the keys of the default ticket callback, replacing any set before.
+ *
+ * The key with the latest start of encryption, that still decrypts when a new
+ * ticket expires, encrypts new tickets. Tickets are decrypted with the key of
+ * the name in them until the key's decryption end.
+ *
+ * @param [in]  ctx   SSL/TLS context object.
+ * @param [in]  keys  Operator keys. May be NULL when cnt is 0.
+ * @param [in]  cnt   Number of keys. 0 removes all operator keys.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when ctx is NULL, cnt is out of range, keys is NULL
+ *          with keys to set, a key's decryption ends before its encryption
+ *          starts or two keys have the same name.
+ * @return  BAD_MUTEX_E when locking mutex fails.
+ * @return  NOT_COMPILED_IN when WOLFSSL_TICKET_KEY_SET is not defined.
+ */
+int wolfSSL_CTX_set_ticket_keys(WOLFSSL_CTX* ctx,
+                                const WOLFSSL_TICKET_KEY* keys, int cnt)
+{
+#if defined(WOLFSSL_TICKET_KEY_SET) && !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB)
+    int ret;
+    int i;
+
+    if ((ctx == NULL) || (cnt < 0) || (cnt > WOLFSSL_TICKET_KEY_SET_MAX) ||
+            ((keys == NULL) && (cnt > 0))) {
+        return BAD_FUNC_ARG;
+    }
+    for (i = 0; i < cnt; i++) {
+        if (keys[i].decEnd <= keys[i].encStart) {
+            return BAD_FUNC_ARG;
+        }
+    }
+
+    ret = TicketEncCbCtx_SetKeys(&ctx->ticketKeyCtx, keys, cnt);
+    if (ret == 0) {
+        ret = WOLFSSL_SUCCESS;
+    }
+
+    return ret;
+#else
+    (void)keys;
+    (void)cnt;
+
+    if (ctx == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    return NOT_COMPILED_IN;
+#endif
+}
 #endif /* !NO_WOLFSSL_SERVER */
 
 #if !defined(NO_WOLFSSL_CLIENT)
@@ -4700,6 +5030,64 @@ int wolfSSL_FreeHandshakeResources(WOLFSSL* ssl)
     return 0;
 }
 
+/* Free everything an idle connection doesn't need once the handshake is
+ * done: handshake resources, the peer's certificate and input/output
+ * buffers with no data in them. The connection keeps working, buffers are
+ * allocated again when records come and go.
+ *
+ * ssl  The SSL/TLS object.
+ * returns the number of bytes released, BAD_FUNC_ARG when ssl is NULL and
+ * BAD_STATE_E while a handshake is in progress.
+ */
+int wolfSSL_compact(WOLFSSL* ssl)
+{
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_compact");
+
+    if (ssl == NULL)
+        return BAD_FUNC_ARG;
+    if (!ssl->options.handShakeDone ||
+            ssl->options.handShakeState != HANDSHAKE_DONE) {
+        WOLFSSL_MSG("Handshake not done");
+        return BAD_STATE_E;
+    }
+
+    ret = (int)CompactSSL(ssl);
+
+    WOLFSSL_LEAVE("wolfSSL_compact", ret);
+
+    return ret;
+}
+
+/* Compact connections made from ctx as soon as their handshake is done,
+ * see wolfSSL_compact(). The peer's certificate isn't available after the
+ * handshake then, inspect it in the verify callback.
+ *
+ * ctx  The SSL/TLS context object.
+ * on   1 to compact, 0 not to.
+ * returns BAD_FUNC_ARG when ctx is NULL and WOLFSSL_SUCCESS otherwise.
+ */
+int wolfSSL_CTX_set_auto_compact(WOLFSSL_CTX* ctx, int on)
+{
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    ctx->autoCompact = on != 0;
+
+    return WOLFSSL_SUCCESS;
+}
+
+int wolfSSL_set_auto_compact(WOLFSSL* ssl, int on)
+{
+    if (ssl == NULL)
+        return BAD_FUNC_ARG;
+
+    ssl->options.autoCompact = on != 0;
+
+    return WOLFSSL_SUCCESS;
+}
+
 /* Use the client's order of preference when matching cipher suites.
  *
  * ssl  The SSL/TLS context object.
@@ -6049,6 +6437,13 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
 
        default SESSION_CACHE stores 33 sessions (no XXX_SESSION_CACHE defined)
        SessionCache takes about 13K bytes, ClientCache takes 17K bytes
+
+       WOLFSSL_SHARDED_SESSION_CACHE allocates the rows (shards) at
+       wolfSSL_Init() with the size selected above and allows resizing them at
+       runtime with wolfSSL_CTX_set_session_cache_size(). Every row has its own
+       lock, slots are reused with CLOCK (second chance) instead of FIFO and
+       hit/miss/eviction/contention counters are kept per row. Implies
+       SESSION_CACHE_DYNAMIC_MEM and ENABLE_SESSION_CACHE_ROW_LOCK.
     */
     #if defined(TITAN_SESSION_CACHE)
         #define SESSIONS_PER_ROW 31
@@ -6077,6 +6472,26 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
     #endif
     #define INVALID_SESSION_ROW (-1)
 
+    #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+        #ifdef WOLFSSL_ATOMIC_OPS
+            typedef wolfSSL_Atomic_Int SessionCacheCounter;
+            #define SESSION_CACHE_COUNTER_INC(c) \
+                (void)wolfSSL_Atomic_Int_FetchAdd(&(c), 1)
+            /* Lookups share the row lock, the reference is counted. */
+            #define SESSION_ROW_REF(row, idx, readOnly) \
+                SESSION_CACHE_COUNTER_INC((row)->refBit[idx])
+        #else
+            /* Counters are only approximate without atomics. */
+            typedef int SessionCacheCounter;
+            #define SESSION_CACHE_COUNTER_INC(c) (c)++
+            /* Only marked with the row locked for write. */
+            #define SESSION_ROW_REF(row, idx, readOnly) do {                   \
+                if (!(readOnly))                                               \
+                    (row)->refBit[idx] = 1;                                    \
+            } while (0)
+        #endif
+    #endif
+
     #ifdef NO_SESSION_CACHE_ROW_LOCK
         #undef ENABLE_SESSION_CACHE_ROW_LOCK
     #endif
@@ -6096,16 +6511,92 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
         wolfSSL_RwLock row_lock;
         int lock_valid;
     #endif
+    #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+        /* CLOCK reference, non-zero when used since the last sweep. */
+        SessionCacheCounter refBit[SESSIONS_PER_ROW];
+        SessionCacheCounter hits;              /* lookups that found entry  */
+        SessionCacheCounter misses;            /* lookups that didn't       */
+        SessionCacheCounter evictions;         /* live entries replaced     */
+        SessionCacheCounter contention;        /* lock found row busy       */
+        SessionCacheCounter lockers;           /* threads holding/waiting   */
+    #endif
     } SessionRow;
     #define SIZEOF_SESSION_ROW (sizeof(WOLFSSL_SESSION) + (sizeof(int) * 2))
 
+#ifdef WOLFSSL_SHARDED_SESSION_CACHE
+    typedef struct SessionCacheTable {
+        word32 rows;
+        /* counters of the tables this one replaced */
+        word32 hits;
+        word32 misses;
+        word32 evictions;
+        word32 contention;
+        SessionRow Rows[1];
+    } SessionCacheTable;
+
+    /* no slot in a table, see SessionCacheResize() */
+    #define INVALID_SESSION_SLOT 0xFFFFFFFFU
+
+    #ifndef WOLFSSL_SESSION_CACHE_MAX_ROWS
+        /* ClientSession stores the row as a word16 */
+        #define WOLFSSL_SESSION_CACHE_MAX_ROWS 65535
+    #endif
+
+    static WOLFSSL_GLOBAL SessionCacheTable* SessionCacheCur = NULL;
+    #define SessionCache        (SessionCacheCur->Rows)
+    #define SESSION_CACHE_ROWS  (SessionCacheCur->rows)
+
+    /* Serializes resizing and operations that walk every row. */
+    static WOLFSSL_GLOBAL wolfSSL_Mutex session_resize_mutex WOLFSSL_MUTEX_INITIALIZER_CLAUSE(session_resize_mutex);
+    #ifndef WOLFSSL_MUTEX_INITIALIZER
+    static WOLFSSL_GLOBAL int session_resize_mutex_valid = 0;
+    #endif
+    /* Read locked while a row of the current table is selected and locked,
+     * write locked by a resize while it replaces the table. Once the resize
+     * is done no thread can reference the old table and it is freed. */
+    static WOLFSSL_GLOBAL wolfSSL_RwLock session_table_lock;
+    static WOLFSSL_GLOBAL int session_table_lock_valid = 0;
+#else
     static WOLFSSL_GLOBAL SessionRow SessionCache[SESSION_ROWS];
+    #define SESSION_CACHE_ROWS  SESSION_ROWS
+#endif
 
     #if defined(WOLFSSL_SESSION_STATS) && defined(WOLFSSL_PEAK_SESSIONS)
         static WOLFSSL_GLOBAL word32 PeakSessions;
     #endif
 
-    #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
+    #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+    static int SessionRowLock(SessionRow* sessRow, byte readOnly)
+    {
+        int ret;
+
+    #ifdef WOLFSSL_ATOMIC_OPS
+        if (wolfSSL_Atomic_Int_FetchAdd(&sessRow->lockers, 1) != 0)
+            SESSION_CACHE_COUNTER_INC(sessRow->contention);
+    #endif
+        if (readOnly)
+            ret = wc_LockRwLock_Rd(&sessRow->row_lock);
+        else
+            ret = wc_LockRwLock_Wr(&sessRow->row_lock);
+    #ifdef WOLFSSL_ATOMIC_OPS
+        if (ret != 0)
+            (void)wolfSSL_Atomic_Int_FetchSub(&sessRow->lockers, 1);
+    #endif
+        return ret;
+    }
+
+    static void SessionRowUnLock(SessionRow* sessRow)
+    {
+        /* Row isn't touched once unlocked as a resize may free it. */
+    #ifdef WOLFSSL_ATOMIC_OPS
+        (void)wolfSSL_Atomic_Int_FetchSub(&sessRow->lockers, 1);
+    #endif
+        wc_UnLockRwLock(&sessRow->row_lock);
+    }
+    #define SESSION_ROW_RD_LOCK(row)   SessionRowLock((row), 1)
+    #define SESSION_ROW_WR_LOCK(row)   SessionRowLock((row), 0)
+    #define SESSION_ROW_UNLOCK(row)    SessionRowUnLock(row);
+    #elif defined(ENABLE_SESSION_CACHE_ROW_LOCK)
     #define SESSION_ROW_RD_LOCK(row)   wc_LockRwLock_Rd(&(row)->row_lock)
     #define SESSION_ROW_WR_LOCK(row)   wc_LockRwLock_Wr(&(row)->row_lock)
     #define SESSION_ROW_UNLOCK(row)    wc_UnLockRwLock(&(row)->row_lock);
@@ -6146,60 +6637,419 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
         #error CLIENT_SESSION_ROWS too big
         #endif
 
-        struct ClientSession {
-            word16 serverRow;            /* SessionCache Row id */
-            word16 serverIdx;            /* SessionCache Idx (column) */
-            word32 sessionIDHash;
-        };
-    #ifndef WOLFSSL_CLIENT_SESSION_DEFINED
-        typedef struct ClientSession ClientSession;
-        #define WOLFSSL_CLIENT_SESSION_DEFINED
-    #endif
+        struct ClientSession {
+            word16 serverRow;            /* SessionCache Row id */
+            word16 serverIdx;            /* SessionCache Idx (column) */
+            word32 sessionIDHash;
+        };
+    #ifndef WOLFSSL_CLIENT_SESSION_DEFINED
+        typedef struct ClientSession ClientSession;
+        #define WOLFSSL_CLIENT_SESSION_DEFINED
+    #endif
+
+        typedef struct ClientRow {
+            int nextIdx;                /* where to place next one   */
+            int totalCount;             /* sessions ever on this row */
+            ClientSession Clients[CLIENT_SESSIONS_PER_ROW];
+        } ClientRow;
+
+        static WOLFSSL_GLOBAL ClientRow ClientCache[CLIENT_SESSION_ROWS];
+                                                     /* Client Cache */
+                                                     /* uses session mutex */
+
+        static WOLFSSL_GLOBAL wolfSSL_Mutex clisession_mutex WOLFSSL_MUTEX_INITIALIZER_CLAUSE(clisession_mutex); /* ClientCache mutex */
+        #ifndef WOLFSSL_MUTEX_INITIALIZER
+        static WOLFSSL_GLOBAL int clisession_mutex_valid = 0;
+        #endif
+    #endif /* !NO_CLIENT_CACHE */
+
+    void EvictSessionFromCache(WOLFSSL_SESSION* session)
+    {
+#ifdef HAVE_EX_DATA
+        int save_ownExData = session->ownExData;
+        session->ownExData = 1; /* Make sure ex_data access doesn't lead back
+                                 * into the cache. */
+#endif
+#if defined(HAVE_EXT_CACHE) || defined(HAVE_EX_DATA)
+        if (session->rem_sess_cb != NULL) {
+            session->rem_sess_cb(NULL, session);
+            session->rem_sess_cb = NULL;
+        }
+#endif
+        ForceZero(session->masterSecret, SECRET_LEN);
+        XMEMSET(session->sessionID, 0, ID_LEN);
+        session->sessionIDSz = 0;
+#ifdef HAVE_SESSION_TICKET
+        if (session->ticketLenAlloc > 0) {
+            XFREE(session->ticket, NULL, DYNAMIC_TYPE_SESSION_TICK);
+            session->ticket = session->staticTicket;
+            session->ticketLen = 0;
+            session->ticketLenAlloc = 0;
+        }
+#endif
+#ifdef HAVE_EX_DATA
+        session->ownExData = save_ownExData;
+#endif
+    }
+
+    /* Lock a row of the session cache. The row is selected by index or, when
+     * isHash is set, by reducing row modulo the number of rows.
+     *
+     * Returns the locked row and sets lockedRow to its index, or NULL when the
+     * index is out of range or locking failed. */
+    static SessionRow* SessionCacheLockRow(word32 row, byte isHash,
+        byte readOnly, word32* lockedRow)
+    {
+        SessionRow* sessRow;
+        word32 idx;
+    #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+        SessionCacheTable* table;
+
+        /* A resize write locks every row of the table it replaces, so once the
+         * row is locked the table can't be replaced until it is unlocked. */
+        if (wc_LockRwLock_Rd(&session_table_lock) != 0)
+            return NULL;
+        table = SessionCacheCur;
+        sessRow = NULL;
+        idx = 0;
+        if (table != NULL) {
+            idx = isHash ? row % table->rows : row;
+            if (idx < table->rows) {
+                sessRow = &table->Rows[idx];
+                if (SessionRowLock(sessRow, readOnly) != 0)
+                    sessRow = NULL;
+            }
+        }
+        wc_UnLockRwLock(&session_table_lock);
+        if (sessRow == NULL)
+            return NULL;
+    #else
+        idx = isHash ? row % SESSION_ROWS : row;
+        if (idx >= SESSION_ROWS)
+            return NULL;
+        sessRow = &SessionCache[idx];
+        if ((readOnly ? SESSION_ROW_RD_LOCK(sessRow) :
+                        SESSION_ROW_WR_LOCK(sessRow)) != 0)
+            return NULL;
+    #endif
+
+        if (lockedRow != NULL)
+            *lockedRow = idx;
+        return sessRow;
+    }
+
+#ifdef WOLFSSL_SHARDED_SESSION_CACHE
+#ifndef NO_CLIENT_CACHE
+    /* Find the row and slot of the cached session with id. The row is only
+     * locked while looking so the caller must stop resizes, as holding
+     * clisession_mutex does.
+     *
+     * Returns 0 when found and non-zero otherwise. */
+    static int SessionCacheFindSlot(const byte* id, byte side, int* row,
+        int* idx)
+    {
+        SessionRow* sessRow;
+        WOLFSSL_SESSION* s;
+        word32 r;
+        int error = 0;
+        int i;
+        int ret = -1;
+
+        if (id == NULL)
+            return BAD_FUNC_ARG;
+        r = HashObject(id, ID_LEN, &error);
+        if (error != 0)
+            return error;
+        sessRow = SessionCacheLockRow(r, 1, 1, &r);
+        if (sessRow == NULL)
+            return BAD_MUTEX_E;
+        for (i = 0; i < SESSIONS_PER_ROW; i++) {
+            s = sessRow->Sessions[i];
+            if (s != NULL && s->side == side &&
+                    XMEMCMP(s->sessionID, id, ID_LEN) == 0) {
+                *row = (int)r;
+                *idx = i;
+                ret = 0;
+                break;
+            }
+        }
+        SESSION_ROW_UNLOCK(sessRow);
+
+        return ret;
+    }
+#endif /* !NO_CLIENT_CACHE */
+
+    /* Choose the slot of a row to place a new session in using CLOCK. Empty and
+     * expired slots are taken first, otherwise the hand clears reference bits
+     * until it finds a slot that wasn't used since the last sweep. Must be
+     * called with the row write locked. */
+    static word32 SessionRowClockVictim(SessionRow* sessRow)
+    {
+        word32 idx = (word32)sessRow->nextIdx % SESSIONS_PER_ROW;
+        word32 ticks = LowResTimer();
+        WOLFSSL_SESSION* s;
+        int i;
+
+        /* At most two sweeps as the first clears every reference bit. */
+        for (i = 0; i < 2 * SESSIONS_PER_ROW; i++) {
+            s = sessRow->Sessions[idx];
+            if (s == NULL || s->sessionIDSz == 0 ||
+                    ticks >= s->bornOn + s->timeout) {
+                return idx;
+            }
+            if (!sessRow->refBit[idx])
+                break;
+            sessRow->refBit[idx] = 0;
+            idx = (idx + 1) % SESSIONS_PER_ROW;
+        }
+
+        SESSION_CACHE_COUNTER_INC(sessRow->evictions);
+        return idx;
+    }
+
+    static void SessionCacheTableFree(SessionCacheTable* table)
+    {
+        word32 i;
+        int j;
+
+        if (table == NULL)
+            return;
+
+        for (i = 0; i < table->rows; i++) {
+            SessionRow* sessRow = &table->Rows[i];
+            for (j = 0; j < SESSIONS_PER_ROW; j++) {
+                if (sessRow->Sessions[j] != NULL) {
+                    EvictSessionFromCache(sessRow->Sessions[j]);
+                    XFREE(sessRow->Sessions[j], sessRow->heap,
+                          DYNAMIC_TYPE_SESSION);
+                    sessRow->Sessions[j] = NULL;
+                }
+            }
+            if (sessRow->lock_valid)
+                wc_FreeRwLock(&sessRow->row_lock);
+            sessRow->lock_valid = 0;
+        }
+        XFREE(table, NULL, DYNAMIC_TYPE_SESSION);
+    }
+
+    static SessionCacheTable* SessionCacheTableNew(word32 rows)
+    {
+        SessionCacheTable* table;
+        word32 sz;
+        word32 i;
+
+        sz = (word32)(sizeof(SessionCacheTable) +
+                      (rows - 1) * sizeof(SessionRow));
+        table = (SessionCacheTable*)XMALLOC(sz, NULL, DYNAMIC_TYPE_SESSION);
+        if (table == NULL)
+            return NULL;
+        XMEMSET(table, 0, sz);
+        table->rows = rows;
+
+        for (i = 0; i < rows; i++) {
+            if (wc_InitRwLock(&table->Rows[i].row_lock) != 0) {
+                WOLFSSL_MSG("Bad Init Mutex session");
+                SessionCacheTableFree(table);
+                return NULL;
+            }
+            table->Rows[i].lock_valid = 1;
+        }
+
+        return table;
+    }
+
+    /* Move a session out of a table being replaced into the new table. The new
+     * table is not yet visible to other threads so its rows aren't locked.
+     * from is the slot the session had in the old table and is recorded in
+     * origin, indexed by the slot it gets in the new table. */
+    static void SessionCacheTableMove(SessionCacheTable* table,
+        WOLFSSL_SESSION* session, byte refBit, word32* origin, word32 from)
+    {
+        SessionRow* sessRow;
+        WOLFSSL_SESSION* victim;
+        word32 row = 0;
+        word32 idx;
+        int error = 0;
+
+        if (session->sessionIDSz != 0)
+            row = HashObject(session->sessionID, ID_LEN, &error) % table->rows;
+        if (session->sessionIDSz == 0 || error != 0) {
+            EvictSessionFromCache(session);
+            XFREE(session, NULL, DYNAMIC_TYPE_SESSION);
+            return;
+        }
+
+        sessRow = &table->Rows[row];
+        idx = SessionRowClockVictim(sessRow);
+        victim = sessRow->Sessions[idx];
+        if (victim != NULL) {
+            EvictSessionFromCache(victim);
+            XFREE(victim, sessRow->heap, DYNAMIC_TYPE_SESSION);
+        }
+        else if (sessRow->totalCount < SESSIONS_PER_ROW) {
+            sessRow->totalCount++;
+        }
+        sessRow->Sessions[idx] = session;
+        sessRow->refBit[idx] = refBit;
+        sessRow->nextIdx = (int)((idx + 1) % SESSIONS_PER_ROW);
+        session->cacheRow = (int)row;
+        origin[row * SESSIONS_PER_ROW + idx] = from;
+    }
+
+#ifndef NO_CLIENT_CACHE
+    /* Point the ClientCache entries at the slots their sessions were moved to
+     * by a resize. moved maps each slot of the old table to its slot in the
+     * new one, or to INVALID_SESSION_SLOT when the session was dropped. Must
+     * be called with clisession_mutex locked. */
+    static void SessionCacheRemapClients(const word32* moved, word32 oldRows)
+    {
+        ClientSession* clSess;
+        word32 slot;
+        int i, j;
+
+        for (i = 0; i < CLIENT_SESSION_ROWS; i++) {
+            for (j = 0; j < CLIENT_SESSIONS_PER_ROW; j++) {
+                clSess = &ClientCache[i].Clients[j];
+                slot = INVALID_SESSION_SLOT;
+                if (clSess->serverRow < oldRows &&
+                        clSess->serverIdx < SESSIONS_PER_ROW) {
+                    slot = moved[clSess->serverRow * SESSIONS_PER_ROW +
+                                 clSess->serverIdx];
+                }
+                if (slot == INVALID_SESSION_SLOT) {
+                    /* never matches a session ID hash of a cached session */
+                    XMEMSET(clSess, 0, sizeof(ClientSession));
+                }
+                else {
+                    clSess->serverRow = (word16)(slot / SESSIONS_PER_ROW);
+                    clSess->serverIdx = (word16)(slot % SESSIONS_PER_ROW);
+                }
+            }
+        }
+    }
+#endif /* !NO_CLIENT_CACHE */
+
+    /* Replace the session cache with one of rows rows, moving over the cached
+     * sessions. Entries that no longer fit are evicted with CLOCK. The
+     * ClientCache entries follow their sessions and the old table is freed. */
+    static int SessionCacheResize(word32 rows)
+    {
+        SessionCacheTable* newTable;
+        SessionCacheTable* oldTable = NULL;
+        word32* origin = NULL;  /* old slot of each new slot */
+        word32* moved = NULL;   /* new slot of each old slot */
+        word32 oldSlots = 0;
+        word32 locked = 0;
+        word32 i;
+        int j;
+        int tableLocked = 0;
+        int ret = 0;
+
+        newTable = SessionCacheTableNew(rows);
+        if (newTable == NULL)
+            return MEMORY_E;
+
+        if (wc_LockMutex(&session_resize_mutex) != 0) {
+            SessionCacheTableFree(newTable);
+            return BAD_MUTEX_E;
+        }
+
+        /* The table is only replaced with the resize mutex held. */
+        oldSlots = SessionCacheCur->rows * SESSIONS_PER_ROW;
+        origin = (word32*)XMALLOC(sizeof(word32) *
+            (rows * SESSIONS_PER_ROW + oldSlots), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        if (origin == NULL) {
+            wc_UnLockMutex(&session_resize_mutex);
+            SessionCacheTableFree(newTable);
+            return MEMORY_E;
+        }
+        moved = origin + rows * SESSIONS_PER_ROW;
+
+    #ifndef NO_CLIENT_CACHE
+        /* ClientCache users lock it before a session row. */
+        if (wc_LockMutex(&clisession_mutex) != 0) {
+            wc_UnLockMutex(&session_resize_mutex);
+            XFREE(origin, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+            SessionCacheTableFree(newTable);
+            return BAD_MUTEX_E;
+        }
+    #endif
+        if (wc_LockRwLock_Wr(&session_table_lock) != 0) {
+            WOLFSSL_MSG("Session table lock failed");
+            ret = BAD_MUTEX_E;
+        }
+        else {
+            tableLocked = 1;
+        }
+
+        oldTable = SessionCacheCur;
+        for (; ret == 0 && locked < oldTable->rows; locked++) {
+            if (SessionRowLock(&oldTable->Rows[locked], 0) != 0) {
+                WOLFSSL_MSG("Session row lock failed");
+                ret = BAD_MUTEX_E;
+                break;
+            }
+        }
+
+        if (ret == 0) {
+            newTable->hits       = oldTable->hits;
+            newTable->misses     = oldTable->misses;
+            newTable->evictions  = oldTable->evictions;
+            newTable->contention = oldTable->contention;
+            for (i = 0; i < oldTable->rows; i++) {
+                SessionRow* sessRow = &oldTable->Rows[i];
+
+                for (j = 0; j < SESSIONS_PER_ROW; j++) {
+                    if (sessRow->Sessions[j] != NULL) {
+                        SessionCacheTableMove(newTable, sessRow->Sessions[j],
+                            sessRow->refBit[j] != 0, origin,
+                            i * SESSIONS_PER_ROW + (word32)j);
+                        sessRow->Sessions[j] = NULL;
+                    }
+                }
+                sessRow->totalCount = 0;
+                sessRow->nextIdx = 0;
 
-        typedef struct ClientRow {
-            int nextIdx;                /* where to place next one   */
-            int totalCount;             /* sessions ever on this row */
-            ClientSession Clients[CLIENT_SESSIONS_PER_ROW];
-        } ClientRow;
+                newTable->hits       += (word32)sessRow->hits;
+                newTable->misses     += (word32)sessRow->misses;
+                newTable->evictions  += (word32)sessRow->evictions;
+                newTable->contention += (word32)sessRow->contention;
+            }
 
-        static WOLFSSL_GLOBAL ClientRow ClientCache[CLIENT_SESSION_ROWS];
-                                                     /* Client Cache */
-                                                     /* uses session mutex */
+            SessionCacheCur = newTable;
 
-        static WOLFSSL_GLOBAL wolfSSL_Mutex clisession_mutex WOLFSSL_MUTEX_INITIALIZER_CLAUSE(clisession_mutex); /* ClientCache mutex */
-        #ifndef WOLFSSL_MUTEX_INITIALIZER
-        static WOLFSSL_GLOBAL int clisession_mutex_valid = 0;
+            /* sessions evicted by the move left no slot in the new table */
+            for (i = 0; i < oldSlots; i++)
+                moved[i] = INVALID_SESSION_SLOT;
+            for (i = 0; i < rows; i++) {
+                for (j = 0; j < SESSIONS_PER_ROW; j++) {
+                    if (newTable->Rows[i].Sessions[j] != NULL) {
+                        word32 slot = i * SESSIONS_PER_ROW + (word32)j;
+                        moved[origin[slot]] = slot;
+                    }
+                }
+            }
+        #ifndef NO_CLIENT_CACHE
+            SessionCacheRemapClients(moved, oldTable->rows);
         #endif
-    #endif /* !NO_CLIENT_CACHE */
-
-    void EvictSessionFromCache(WOLFSSL_SESSION* session)
-    {
-#ifdef HAVE_EX_DATA
-        int save_ownExData = session->ownExData;
-        session->ownExData = 1; /* Make sure ex_data access doesn't lead back
-                                 * into the cache. */
-#endif
-#if defined(HAVE_EXT_CACHE) || defined(HAVE_EX_DATA)
-        if (session->rem_sess_cb != NULL) {
-            session->rem_sess_cb(NULL, session);
-            session->rem_sess_cb = NULL;
-        }
-#endif
-        ForceZero(session->masterSecret, SECRET_LEN);
-        XMEMSET(session->sessionID, 0, ID_LEN);
-        session->sessionIDSz = 0;
-#ifdef HAVE_SESSION_TICKET
-        if (session->ticketLenAlloc > 0) {
-            XFREE(session->ticket, NULL, DYNAMIC_TYPE_SESSION_TICK);
-            session->ticket = session->staticTicket;
-            session->ticketLen = 0;
-            session->ticketLenAlloc = 0;
         }
-#endif
-#ifdef HAVE_EX_DATA
-        session->ownExData = save_ownExData;
-#endif
+
+        for (i = 0; i < locked; i++)
+            SessionRowUnLock(&oldTable->Rows[i]);
+        if (tableLocked)
+            wc_UnLockRwLock(&session_table_lock);
+    #ifndef NO_CLIENT_CACHE
+        wc_UnLockMutex(&clisession_mutex);
+    #endif
+        wc_UnLockMutex(&session_resize_mutex);
+        XFREE(origin, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+        /* Threads only reach a row through the table lock, so none can be
+         * using the table that wasn't kept. */
+        SessionCacheTableFree(ret == 0 ? oldTable : newTable);
+        return ret;
     }
+#endif /* WOLFSSL_SHARDED_SESSION_CACHE */
 
 #endif /* !NO_SESSION_CACHE */
 
@@ -6221,7 +7071,8 @@ WOLFSSL_ABI
 int wolfSSL_Init(void)
 {
     int ret = WOLFSSL_SUCCESS;
-#if !defined(NO_SESSION_CACHE) && defined(ENABLE_SESSION_CACHE_ROW_LOCK)
+#if !defined(NO_SESSION_CACHE) && defined(ENABLE_SESSION_CACHE_ROW_LOCK) && \
+    !defined(WOLFSSL_SHARDED_SESSION_CACHE)
     int i;
 #endif
 
@@ -6290,7 +7141,35 @@ int wolfSSL_Init(void)
 #endif
 
 #ifndef NO_SESSION_CACHE
-    #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
+    #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+        #ifndef WOLFSSL_MUTEX_INITIALIZER
+        if (ret == WOLFSSL_SUCCESS) {
+            if (wc_InitMutex(&session_resize_mutex) != 0) {
+                WOLFSSL_MSG("Bad Init Mutex session resize");
+                ret = BAD_MUTEX_E;
+            }
+            else {
+                session_resize_mutex_valid = 1;
+            }
+        }
+        #endif
+        if (ret == WOLFSSL_SUCCESS) {
+            if (wc_InitRwLock(&session_table_lock) != 0) {
+                WOLFSSL_MSG("Bad Init Mutex session table");
+                ret = BAD_MUTEX_E;
+            }
+            else {
+                session_table_lock_valid = 1;
+            }
+        }
+        if (ret == WOLFSSL_SUCCESS) {
+            SessionCacheCur = SessionCacheTableNew(SESSION_ROWS);
+            if (SessionCacheCur == NULL) {
+                WOLFSSL_MSG("Session cache allocation failed");
+                ret = MEMORY_E;
+            }
+        }
+    #elif defined(ENABLE_SESSION_CACHE_ROW_LOCK)
         for (i = 0; i < SESSION_ROWS; ++i) {
             SessionCache[i].lock_valid = 0;
         }
@@ -6496,6 +7375,7 @@ static int ProcessUserChain(WOLFSSL_CTX* ctx, const unsigned char* buff,
             #endif
             } else if (ctx) {
                 FreeDer(&ctx->certChain);
+                CertMsgCacheReset(ctx);
                 ret = AllocDer(&ctx->certChain, idx, type, heap);
                 if (ret == 0) {
                     XMEMCPY(ctx->certChain->buffer, chainBuffer, idx);
@@ -7411,6 +8291,7 @@ int ProcessBuffer(WOLFSSL_CTX* ctx, const unsigned char* buff,
         }
         else if (ctx != NULL) {
             FreeDer(&ctx->certificate); /* Make sure previous is free'd */
+            CertMsgCacheReset(ctx);
         #ifdef KEEP_OUR_CERT
             if (ctx->ourCert) {
                 if (ctx->ownOurCert)
@@ -13620,7 +14501,7 @@ int wolfSSL_Cleanup(void)
 {
     int ret = WOLFSSL_SUCCESS; /* Only the first error will be returned */
     int release = 0;
-#if !defined(NO_SESSION_CACHE)
+#if !defined(NO_SESSION_CACHE) && !defined(WOLFSSL_SHARDED_SESSION_CACHE)
     int i;
     int j;
 #endif
@@ -13660,6 +14541,24 @@ int wolfSSL_Cleanup(void)
 #endif
 
 #ifndef NO_SESSION_CACHE
+    #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+    SessionCacheTableFree(SessionCacheCur);
+    SessionCacheCur = NULL;
+    if ((session_table_lock_valid == 1) &&
+        (wc_FreeRwLock(&session_table_lock) != 0)) {
+        if (ret == WOLFSSL_SUCCESS)
+            ret = BAD_MUTEX_E;
+    }
+    session_table_lock_valid = 0;
+    #ifndef WOLFSSL_MUTEX_INITIALIZER
+    if ((session_resize_mutex_valid == 1) &&
+        (wc_FreeMutex(&session_resize_mutex) != 0)) {
+        if (ret == WOLFSSL_SUCCESS)
+            ret = BAD_MUTEX_E;
+    }
+    session_resize_mutex_valid = 0;
+    #endif
+    #else
     #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
     for (i = 0; i < SESSION_ROWS; ++i) {
         if ((SessionCache[i].lock_valid == 1) &&
@@ -13690,6 +14589,7 @@ int wolfSSL_Cleanup(void)
     #endif
         }
     }
+    #endif /* WOLFSSL_SHARDED_SESSION_CACHE */
     #ifndef NO_CLIENT_CACHE
     #ifndef WOLFSSL_MUTEX_INITIALIZER
     if ((clisession_mutex_valid == 1) &&
@@ -13825,10 +14725,21 @@ void wolfSSL_CTX_flush_sessions(WOLFSSL_CTX* ctx, long tm)
     (void)ctx;
     XMEMSET(id, 0, ID_LEN);
     WOLFSSL_ENTER("wolfSSL_flush_sessions");
-    for (i = 0; i < SESSION_ROWS; ++i) {
+#ifdef WOLFSSL_SHARDED_SESSION_CACHE
+    /* Keep the table from being replaced while walking it. */
+    if (wc_LockMutex(&session_resize_mutex) != 0) {
+        WOLFSSL_MSG("Session cache resize mutex lock failed");
+        return;
+    }
+    if (SessionCacheCur == NULL) {
+        wc_UnLockMutex(&session_resize_mutex);
+        return;
+    }
+#endif
+    for (i = 0; i < (int)SESSION_CACHE_ROWS; ++i) {
         if (SESSION_ROW_WR_LOCK(&SessionCache[i]) != 0) {
             WOLFSSL_MSG("Session cache mutex lock failed");
-            return;
+            break;
         }
         for (j = 0; j < SESSIONS_PER_ROW; j++) {
 #ifdef SESSION_CACHE_DYNAMIC_MEM
@@ -13853,7 +14764,101 @@ void wolfSSL_CTX_flush_sessions(WOLFSSL_CTX* ctx, long tm)
         }
         SESSION_ROW_UNLOCK(&SessionCache[i]);
     }
+#ifdef WOLFSSL_SHARDED_SESSION_CACHE
+    wc_UnLockMutex(&session_resize_mutex);
+#endif
+}
+
+#ifdef WOLFSSL_SHARDED_SESSION_CACHE
+/* Resize the session cache to hold at least sz sessions. Cached sessions are
+ * moved to the new rows; when shrinking the least recently used ones that no
+ * longer fit are evicted. The session cache is shared by all WOLFSSL_CTX
+ * objects so ctx is only used for argument checking by compatibility layers.
+ * ClientCache entries are updated to the new slots of their sessions.
+ *
+ * Returns WOLFSSL_SUCCESS on success, BAD_FUNC_ARG when sz is 0 or too big and
+ * MEMORY_E or BAD_MUTEX_E on failure. */
+int wolfSSL_CTX_set_session_cache_size(WOLFSSL_CTX* ctx, unsigned int sz)
+{
+    word32 rows;
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_CTX_set_session_cache_size");
+    (void)ctx;
+
+    if (sz == 0 || sz > SESSIONS_PER_ROW * WOLFSSL_SESSION_CACHE_MAX_ROWS)
+        return BAD_FUNC_ARG;
+    if (SessionCacheCur == NULL)
+        return BAD_STATE_E;
+
+    rows = (sz + SESSIONS_PER_ROW - 1) / SESSIONS_PER_ROW;
+    ret = SessionCacheResize(rows);
+    if (ret == 0)
+        ret = WOLFSSL_SUCCESS;
+
+    WOLFSSL_LEAVE("wolfSSL_CTX_set_session_cache_size", ret);
+    return ret;
+}
+
+/* Return the number of sessions the session cache can hold. */
+unsigned int wolfSSL_CTX_get_session_cache_size(WOLFSSL_CTX* ctx)
+{
+    (void)ctx;
+    if (SessionCacheCur == NULL)
+        return 0;
+    return SESSION_CACHE_ROWS * SESSIONS_PER_ROW;
+}
+
+/* Get the session cache counters summed over all rows. Counters are only
+ * guaranteed to be exact when atomic operations are available.
+ *
+ * hits        lookups by session ID that found a session
+ * misses      lookups by session ID that found nothing
+ * evictions   unexpired sessions replaced to make room for another
+ * contention  row locks requested while another thread held or waited on it
+ *
+ * Any of the output parameters may be NULL.
+ * Returns WOLFSSL_SUCCESS on success. */
+int wolfSSL_get_session_cache_stats(word32* hits, word32* misses,
+                                    word32* evictions, word32* contention)
+{
+    SessionCacheTable* table;
+    word32 h, m, e, c;
+    word32 i;
+
+    WOLFSSL_ENTER("wolfSSL_get_session_cache_stats");
+
+    if (SessionCacheCur == NULL)
+        return BAD_STATE_E;
+    if (wc_LockMutex(&session_resize_mutex) != 0)
+        return BAD_MUTEX_E;
+
+    table = SessionCacheCur;
+    h = table->hits;
+    m = table->misses;
+    e = table->evictions;
+    c = table->contention;
+    for (i = 0; i < table->rows; i++) {
+        h += (word32)table->Rows[i].hits;
+        m += (word32)table->Rows[i].misses;
+        e += (word32)table->Rows[i].evictions;
+        c += (word32)table->Rows[i].contention;
+    }
+
+    wc_UnLockMutex(&session_resize_mutex);
+
+    if (hits != NULL)
+        *hits = h;
+    if (misses != NULL)
+        *misses = m;
+    if (evictions != NULL)
+        *evictions = e;
+    if (contention != NULL)
+        *contention = c;
+
+    return WOLFSSL_SUCCESS;
 }
+#endif /* WOLFSSL_SHARDED_SESSION_CACHE */
 
 
 /* set ssl session timeout in seconds */
@@ -13983,15 +14988,10 @@ WOLFSSL_SESSION* wolfSSL_GetSessionClient(WOLFSSL* ssl, const byte* id, int len)
         WOLFSSL_SESSION* current;
         SessionRow* sessRow;
 
-        if (clSess[idx].serverRow >= SESSION_ROWS) {
-            WOLFSSL_MSG("Client cache serverRow invalid");
-            break;
-        }
-
         /* lock row */
-        sessRow = &SessionCache[clSess[idx].serverRow];
-        if (SESSION_ROW_RD_LOCK(sessRow) != 0) {
-            WOLFSSL_MSG("Session cache row lock failure");
+        sessRow = SessionCacheLockRow(clSess[idx].serverRow, 0, 1, NULL);
+        if (sessRow == NULL) {
+            WOLFSSL_MSG("Client cache serverRow invalid or row lock failure");
             break;
         }
 
@@ -14004,6 +15004,9 @@ WOLFSSL_SESSION* wolfSSL_GetSessionClient(WOLFSSL* ssl, const byte* id, int len)
             WOLFSSL_MSG("Found a serverid match for client");
             if (LowResTimer() < (current->bornOn + current->timeout)) {
                 WOLFSSL_MSG("Session valid");
+            #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+                SESSION_ROW_REF(sessRow, clSess[idx].serverIdx, 1);
+            #endif
                 ret = current;
                 SESSION_ROW_UNLOCK(sessRow);
                 break;
@@ -14074,6 +15077,7 @@ void TlsSessionCacheUnlockRow(word32 row)
 {
     SessionRow* sessRow;
 
+    /* The table can't be replaced while one of its rows is locked. */
     sessRow = &SessionCache[row];
     (void)sessRow;
     SESSION_ROW_UNLOCK(sessRow);
@@ -14092,15 +15096,11 @@ static int TlsSessionCacheGetAndLock(const byte *id,
     int idx;
 
     *sess = NULL;
-    row = HashObject(id, ID_LEN, &error) % SESSION_ROWS;
+    row = HashObject(id, ID_LEN, &error);
     if (error != 0)
         return error;
-    sessRow = &SessionCache[row];
-    if (readOnly)
-        error = SESSION_ROW_RD_LOCK(sessRow);
-    else
-        error = SESSION_ROW_WR_LOCK(sessRow);
-    if (error != 0)
+    sessRow = SessionCacheLockRow(row, 1, readOnly, &row);
+    if (sessRow == NULL)
         return FATAL_ERROR;
 
     /* start from most recently used */
@@ -14117,10 +15117,19 @@ static int TlsSessionCacheGetAndLock(const byte *id,
 #endif
         if (s && XMEMCMP(s->sessionID, id, ID_LEN) == 0 && s->side == side) {
             *sess = s;
+        #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+            SESSION_ROW_REF(sessRow, idx, readOnly);
+        #endif
             break;
         }
         idx = idx > 0 ? idx - 1 : SESSIONS_PER_ROW - 1;
     }
+#ifdef WOLFSSL_SHARDED_SESSION_CACHE
+    if (*sess != NULL)
+        SESSION_CACHE_COUNTER_INC(sessRow->hits);
+    else
+        SESSION_CACHE_COUNTER_INC(sessRow->misses);
+#endif
     if (*sess == NULL) {
         SESSION_ROW_UNLOCK(sessRow);
     }
@@ -14160,6 +15169,9 @@ int TlsSessionCacheGetAndWrLock(const byte *id, WOLFSSL_SESSION **sess,
             lockedRow, 0, side);
 }
 
+#define WOLFSSL_SSL_SESS_STORE_INCLUDED
+#include "src/ssl_sess_store.c"
+
 int wolfSSL_GetSessionFromCache(WOLFSSL* ssl, WOLFSSL_SESSION* output)
 {
     const WOLFSSL_SESSION* sess = NULL;
@@ -14474,6 +15486,11 @@ WOLFSSL_SESSION* wolfSSL_GetSession(WOLFSSL* ssl, byte* masterSecret,
     if (wolfSSL_GetSessionFromCache(ssl, ssl->session) == WOLFSSL_SUCCESS) {
         ret = ssl->session;
     }
+#ifdef WOLFSSL_SESSION_STORE
+    else if (SessionStoreGetSession(ssl, ssl->session) == WOLFSSL_SUCCESS) {
+        ret = ssl->session;
+    }
+#endif
     else {
         WOLFSSL_MSG("wolfSSL_GetSessionFromCache did not return a session");
     }
@@ -14498,9 +15515,11 @@ int wolfSSL_SetSession(WOLFSSL* ssl, WOLFSSL_SESSION* session)
 
     /* We need to lock the session as the first step if its in the cache */
     if (session->type == WOLFSSL_SESSION_TYPE_CACHE) {
-        if (session->cacheRow < SESSION_ROWS) {
-            sessRow = &SessionCache[session->cacheRow];
-            if (SESSION_ROW_RD_LOCK(sessRow) != 0) {
+        if (session->cacheRow >= 0 &&
+                (word32)session->cacheRow < SESSION_CACHE_ROWS) {
+            sessRow = SessionCacheLockRow((word32)session->cacheRow, 0, 1,
+                                          NULL);
+            if (sessRow == NULL) {
                 WOLFSSL_MSG("Session row lock failed");
                 return WOLFSSL_FAILURE;
             }
@@ -14629,6 +15648,15 @@ ClientSession* AddSessionToClientCache(int side, int row, int idx, byte* serverI
             error = -1;
         }
         if (error == 0 && wc_LockMutex(&clisession_mutex) == 0) {
+        #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+            /* A resize may have moved the session after its row was unlocked.
+             * It can't move again while the ClientCache is locked. */
+            if (SessionCacheFindSlot(sessionID, (byte)side, &row, &idx) != 0) {
+                WOLFSSL_MSG("Session left the cache before the client entry");
+                wc_UnLockMutex(&clisession_mutex);
+                return NULL;
+            }
+        #endif
             clientIdx = ClientCache[clientRow].nextIdx;
             if (clientIdx < CLIENT_SESSIONS_PER_ROW) {
                 ClientCache[clientRow].Clients[clientIdx].serverRow =
@@ -14707,21 +15735,21 @@ WOLFSSL_SESSION* ClientSessionToSession(const WOLFSSL_SESSION* session)
             WOLFSSL_MSG("Client cache mutex lock failed");
             return NULL;
         }
-        if (clientSession->serverRow >= SESSION_ROWS ||
-                clientSession->serverIdx >= SESSIONS_PER_ROW) {
-            WOLFSSL_MSG("Client cache serverRow or serverIdx invalid");
+        if (clientSession->serverIdx >= SESSIONS_PER_ROW) {
+            WOLFSSL_MSG("Client cache serverIdx invalid");
             error = -1;
         }
         /* Prevent memory access before clientSession->serverRow and
          * clientSession->serverIdx are sanitized. */
         XFENCE();
         if (error == 0) {
-            /* Lock row */
-            sessRow = &SessionCache[clientSession->serverRow];
-            error = SESSION_ROW_RD_LOCK(sessRow);
-            if (error != 0) {
-                WOLFSSL_MSG("Session cache row lock failure");
-                sessRow = NULL;
+            /* Lock row, checks serverRow is valid */
+            sessRow = SessionCacheLockRow(clientSession->serverRow, 0, 1,
+                                          NULL);
+            if (sessRow == NULL) {
+                WOLFSSL_MSG("Client cache serverRow invalid or row lock "
+                            "failure");
+                error = -1;
             }
         }
         if (error == 0) {
@@ -14730,7 +15758,7 @@ WOLFSSL_SESSION* ClientSessionToSession(const WOLFSSL_SESSION* session)
 #else
             cacheSession = &sessRow->Sessions[clientSession->serverIdx];
 #endif
-            if (cacheSession && cacheSession->sessionIDSz == 0) {
+            if (cacheSession == NULL || cacheSession->sessionIDSz == 0) {
                 cacheSession = NULL;
                 WOLFSSL_MSG("Session cache entry not set");
                 error = -1;
@@ -14793,6 +15821,7 @@ int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
 #endif /* WOLFSSL_TLS13 && WOLFSSL_TICKET_NONCE_MALLOC */
 #endif /* HAVE_SESSION_TICKET */
     int ret = 0;
+    word32 hash;
     int row;
     int i;
     int overwrite = 0;
@@ -14844,7 +15873,7 @@ int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
 
     /* Find a position for the new session in cache and use that */
     /* Use the session object in the cache for external cache if required */
-    row = (int)(HashObject(id, ID_LEN, &ret) % SESSION_ROWS);
+    hash = HashObject(id, ID_LEN, &ret);
     if (ret != 0) {
         WOLFSSL_MSG("Hash session failed");
     #ifdef HAVE_SESSION_TICKET
@@ -14856,8 +15885,8 @@ int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
         return ret;
     }
 
-    sessRow = &SessionCache[row];
-    if (SESSION_ROW_WR_LOCK(sessRow) != 0) {
+    sessRow = SessionCacheLockRow(hash, 1, 0, &hash);
+    if (sessRow == NULL) {
     #ifdef HAVE_SESSION_TICKET
         XFREE(ticBuff, NULL, DYNAMIC_TYPE_SESSION_TICK);
     #if defined(WOLFSSL_TLS13) && defined(WOLFSSL_TICKET_NONCE_MALLOC)
@@ -14867,6 +15896,7 @@ int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
         WOLFSSL_MSG("Session row lock failed");
         return BAD_MUTEX_E;
     }
+    row = (int)hash;
 
     for (i = 0; i < SESSIONS_PER_ROW && i < sessRow->totalCount; i++) {
 #ifdef SESSION_CACHE_DYNAMIC_MEM
@@ -14884,8 +15914,13 @@ int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
         }
     }
 
-    if (!overwrite)
+    if (!overwrite) {
+#ifdef WOLFSSL_SHARDED_SESSION_CACHE
+        idx = SessionRowClockVictim(sessRow);
+#else
         idx = sessRow->nextIdx;
+#endif
+    }
 #ifdef SESSION_INDEX
     if (sessionIndex != NULL)
         *sessionIndex = (row << SESSIDX_ROW_SHIFT) | idx;
@@ -15003,7 +16038,10 @@ int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
             /* Increment the totalCount and the nextIdx */
             if (sessRow->totalCount < SESSIONS_PER_ROW)
                 sessRow->totalCount++;
-            sessRow->nextIdx = (sessRow->nextIdx + 1) % SESSIONS_PER_ROW;
+            sessRow->nextIdx = (int)((idx + 1) % SESSIONS_PER_ROW);
+        #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+            sessRow->refBit[idx] = 0;
+        #endif
         }
         if (id != addSession->sessionID) {
             /* ssl->session->sessionID may contain the bogus ID or we want the
@@ -15144,6 +16182,11 @@ void AddSession(WOLFSSL* ssl)
                         );
     }
 
+#ifdef WOLFSSL_SESSION_STORE
+    if (error == 0)
+        SessionStorePut(ssl, session, id, idSz);
+#endif
+
 #ifdef HAVE_EXT_CACHE
     if (error == 0 && ssl->ctx->new_sess_cb != NULL) {
         int cbRet = 0;
@@ -15196,12 +16239,13 @@ int wolfSSL_GetSessionAtIndex(int idx, WOLFSSL_SESSION* session)
     col = idx & SESSIDX_IDX_MASK;
 
     if (session == NULL ||
-            row < 0 || row >= SESSION_ROWS || col >= SESSIONS_PER_ROW) {
+            row < 0 || row >= (int)SESSION_CACHE_ROWS ||
+            col >= SESSIONS_PER_ROW) {
         return WOLFSSL_FAILURE;
     }
 
-    sessRow = &SessionCache[row];
-    if (SESSION_ROW_RD_LOCK(sessRow) != 0) {
+    sessRow = SessionCacheLockRow((word32)row, 0, 1, NULL);
+    if (sessRow == NULL) {
         return BAD_MUTEX_E;
     }
 
@@ -15288,14 +16332,24 @@ static int get_locked_session_stats(word32* active, word32* total, word32* peak)
 
     WOLFSSL_ENTER("get_locked_session_stats");
 
+#ifdef WOLFSSL_SHARDED_SESSION_CACHE
+    /* Keep the table from being replaced while walking it. */
+    if (wc_LockMutex(&session_resize_mutex) != 0) {
+        WOLFSSL_MSG("Session cache resize mutex lock failed");
+        return BAD_MUTEX_E;
+    }
+#endif
 #ifndef ENABLE_SESSION_CACHE_ROW_LOCK
     SESSION_ROW_RD_LOCK(&SessionCache[0]);
 #endif
-    for (i = 0; i < SESSION_ROWS; i++) {
+    for (i = 0; i < (int)SESSION_CACHE_ROWS; i++) {
         SessionRow* row = &SessionCache[i];
     #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
         if (SESSION_ROW_RD_LOCK(row) != 0) {
             WOLFSSL_MSG("Session row cache mutex lock failed");
+        #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+            wc_UnLockMutex(&session_resize_mutex);
+        #endif
             return BAD_MUTEX_E;
         }
     #endif
@@ -15337,6 +16391,9 @@ static int get_locked_session_stats(word32* active, word32* total, word32* peak)
 #ifndef ENABLE_SESSION_CACHE_ROW_LOCK
     SESSION_ROW_UNLOCK(&SessionCache[0]);
 #endif
+#ifdef WOLFSSL_SHARDED_SESSION_CACHE
+    wc_UnLockMutex(&session_resize_mutex);
+#endif
 
     if (active) {
         *active = now;
@@ -15368,7 +16425,7 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
     WOLFSSL_ENTER("wolfSSL_get_session_stats");
 
     if (maxSessions) {
-        *maxSessions = SESSIONS_PER_ROW * SESSION_ROWS;
+        *maxSessions = SESSIONS_PER_ROW * SESSION_CACHE_ROWS;
 
         if (active == NULL && total == NULL && peak == NULL)
             return result;  /* we're done */
@@ -15414,9 +16471,9 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
 #endif
         printf("Max   Sessions      = %u\n", maxSessions);
 
-        E = (double)totalSessionsSeen / SESSION_ROWS;
+        E = (double)totalSessionsSeen / SESSION_CACHE_ROWS;
 
-        for (i = 0; i < SESSION_ROWS; i++) {
+        for (i = 0; i < (int)SESSION_CACHE_ROWS; i++) {
             double diff = SessionCache[i].totalCount - E;
             diff *= diff;                /* square    */
             diff /= E;                   /* normalize */
@@ -15424,7 +16481,7 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
             chiSquare += diff;
         }
         printf("  chi-square = %5.1f, d.f. = %d\n", chiSquare,
-                                                     SESSION_ROWS - 1);
+                                              (int)SESSION_CACHE_ROWS - 1);
         #if (SESSION_ROWS == 11)
             printf(" .05 p value =  18.3, chi-square should be less\n");
         #elif (SESSION_ROWS == 211)
@@ -15515,51 +16572,29 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
 #ifndef USE_WINDOWS_API
     #ifndef NO_WRITEV
 
-        /* simulate writev semantics, doesn't actually do block at a time though
-           because of SSL_write behavior and because front adds may be small */
+        /* writev semantics, records are built straight from the iovecs so
+           the data isn't coalesced into a temporary buffer first */
         int wolfSSL_writev(WOLFSSL* ssl, const struct iovec* iov, int iovcnt)
         {
-        #ifdef WOLFSSL_SMALL_STACK
-            byte   staticBuffer[1]; /* force heap usage */
-        #else
-            byte   staticBuffer[FILE_BUFFER_SIZE];
-        #endif
-            byte* myBuffer  = staticBuffer;
-            int   dynamic   = 0;
-            int   sending   = 0;
-            int   idx       = 0;
-            int   i;
-            int   ret;
+            int sending = 0;
+            int i;
+            int ret;
 
             WOLFSSL_ENTER("wolfSSL_writev");
 
-            for (i = 0; i < iovcnt; i++)
-                sending += (int)iov[i].iov_len;
-
-            if (sending > (int)sizeof(staticBuffer)) {
-                myBuffer = (byte*)XMALLOC(sending, ssl->heap,
-                                                           DYNAMIC_TYPE_WRITEV);
-                if (!myBuffer)
-                    return MEMORY_ERROR;
-
-                dynamic = 1;
-            }
+            if (ssl == NULL || iovcnt < 0 || (iov == NULL && iovcnt > 0))
+                return BAD_FUNC_ARG;
 
             for (i = 0; i < iovcnt; i++) {
-                XMEMCPY(&myBuffer[idx], iov[i].iov_base, iov[i].iov_len);
-                idx += (int)iov[i].iov_len;
+                if (iov[i].iov_len > (size_t)(INT_MAX - sending) ||
+                        (iov[i].iov_base == NULL && iov[i].iov_len > 0))
+                    return BAD_FUNC_ARG;
+                sending += (int)iov[i].iov_len;
             }
 
-           /* myBuffer may not be initialized fully, but the span up to the
-            * sending length will be.
-            */
-            PRAGMA_GCC_DIAG_PUSH
-            PRAGMA_GCC("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-            ret = wolfSSL_write(ssl, myBuffer, sending);
-            PRAGMA_GCC_DIAG_POP
+            ret = wolfSSL_write_internal(ssl, iov, sending, iovcnt);
 
-            if (dynamic)
-                XFREE(myBuffer, ssl->heap, DYNAMIC_TYPE_WRITEV);
+            WOLFSSL_LEAVE("wolfSSL_writev", ret);
 
             return ret;
         }
@@ -15567,6 +16602,151 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
 #endif
 
 
+#ifdef WOLFSSL_KTLS
+
+/* Offload the record layer of connections made from ctx to Linux kernel TLS
+ * once their handshake is done. */
+int wolfSSL_CTX_UseKTLS(WOLFSSL_CTX* ctx)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_UseKTLS");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    ctx->useKtls = 1;
+
+    return WOLFSSL_SUCCESS;
+}
+
+int wolfSSL_UseKTLS(WOLFSSL* ssl)
+{
+    WOLFSSL_ENTER("wolfSSL_UseKTLS");
+
+    if (ssl == NULL)
+        return BAD_FUNC_ARG;
+
+    ssl->options.useKtls = 1;
+
+    return WOLFSSL_SUCCESS;
+}
+
+/* returns the directions the kernel handles, WOLFSSL_KTLS_TX and
+ * WOLFSSL_KTLS_RX */
+int wolfSSL_get_ktls(const WOLFSSL* ssl)
+{
+    int dirs = 0;
+
+    if (ssl == NULL)
+        return BAD_FUNC_ARG;
+
+    if (ssl->options.ktlsTx)
+        dirs |= WOLFSSL_KTLS_TX;
+    if (ssl->options.ktlsRx)
+        dirs |= WOLFSSL_KTLS_RX;
+
+    return dirs;
+}
+
+/* Send count bytes of file fd, from *offset, as application data. When the
+ * kernel encrypts for this connection the pages go to the socket with
+ * sendfile(2), otherwise the file is read and written in chunks of one send
+ * batch. *offset is advanced by the bytes sent.
+ * returns the bytes sent, which may be short of count, or
+ * WOLFSSL_FATAL_ERROR with the reason in wolfSSL_get_error() */
+long wolfSSL_sendfile(WOLFSSL* ssl, int fd, off_t* offset, size_t count)
+{
+    long  total = 0;
+    byte* buf;
+    int   bufSz = 0;
+    int   ret;
+
+    WOLFSSL_ENTER("wolfSSL_sendfile");
+
+    if (ssl == NULL || fd < 0 || offset == NULL)
+        return BAD_FUNC_ARG;
+    if (count > INT_MAX)
+        count = INT_MAX;
+
+    /* finishes the handshake, flushes queued records and offloads */
+    ret = wolfSSL_write_internal(ssl, &bufSz, 0, 0);
+    if (ret < 0 || count == 0)
+        return ret;
+
+    if (ssl->options.ktlsTx) {
+        do {
+            ret = KtlsSendFile(ssl, fd, offset, (int)count);
+        } while (ret == WOLFSSL_CBIO_ERR_ISR);
+
+        if (ret >= 0) {
+            WOLFSSL_LEAVE("wolfSSL_sendfile", ret);
+            return ret;
+        }
+        if (ret == WOLFSSL_CBIO_ERR_WANT_WRITE) {
+            ssl->error = WANT_WRITE;
+        }
+        else {
+            if (ret == WOLFSSL_CBIO_ERR_CONN_RST ||
+                    ret == WOLFSSL_CBIO_ERR_CONN_CLOSE) {
+                ssl->options.connReset = 1;
+            }
+            ssl->error = SOCKET_ERROR_E;
+        }
+        WOLFSSL_ERROR(ssl->error);
+        return WOLFSSL_FATAL_ERROR;
+    }
+
+    bufSz = (int)ssl->sendBatch * MAX_RECORD_SIZE;
+    if ((size_t)bufSz > count)
+        bufSz = (int)count;
+    buf = (byte*)XMALLOC((size_t)bufSz, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (buf == NULL)
+        return MEMORY_E;
+
+    while ((size_t)total < count) {
+        int sz = bufSz;
+
+        if ((size_t)sz > count - (size_t)total)
+            sz = (int)(count - (size_t)total);
+        sz = (int)pread(fd, buf, (size_t)sz, *offset);
+        if (sz <= 0) {
+            if (sz < 0) {
+                ssl->error = FREAD_ERROR;
+                ret = WOLFSSL_FATAL_ERROR;
+            }
+            break;
+        }
+
+        ret = wolfSSL_write_internal(ssl, buf, sz, 0);
+        if (ret < 0 && ssl->error == WANT_WRITE) {
+            /* The records built are queued and go out first on the next
+             * write. Count them as sent, the next write doesn't resend. */
+            ret = ssl->buffers.prevSent + ssl->buffers.plainSz;
+            ssl->buffers.prevSent = 0;
+            ssl->buffers.plainSz  = 0;
+            *offset += ret;
+            total   += ret;
+            ret = WOLFSSL_FATAL_ERROR;
+            break;
+        }
+        if (ret <= 0)
+            break;
+        *offset += ret;
+        total   += ret;
+    }
+
+    ForceZero(buf, (word32)bufSz);
+    XFREE(buf, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+    if (total > 0)
+        ret = (int)total;
+    WOLFSSL_LEAVE("wolfSSL_sendfile", ret);
+
+    return total > 0 ? total : ret;
+}
+
+#endif /* WOLFSSL_KTLS */
+
+
 #ifdef WOLFSSL_CALLBACKS
 
     typedef struct itimerval Itimerval;
@@ -16468,6 +17648,15 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
    /* returns previous set cache size which stays constant */
     long wolfSSL_CTX_sess_set_cache_size(WOLFSSL_CTX* ctx, long sz)
     {
+    #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+        long prev = (long)wolfSSL_CTX_get_session_cache_size(ctx);
+
+        if (sz > 0 && wolfSSL_CTX_set_session_cache_size(ctx, (word32)sz) !=
+                WOLFSSL_SUCCESS) {
+            WOLFSSL_MSG("session cache resize failed");
+        }
+        return prev;
+    #else
         /* cache size fixed at compile time in wolfSSL */
         (void)ctx;
         (void)sz;
@@ -16477,6 +17666,7 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
         #else
             return 0;
         #endif
+    #endif /* WOLFSSL_SHARDED_SESSION_CACHE */
     }
 
 #endif
@@ -18643,6 +19833,11 @@ size_t wolfSSL_get_client_random(const WOLFSSL* ssl, unsigned char* out,
         #endif
         ssl->options.rejectTicket = 0;
     #endif
+    #ifdef WOLFSSL_SESSION_STORE
+        ssl->options.sessionStoreDone = 0;
+        wolfSSL_FreeSession(ssl->ctx, ssl->storeSession);
+        ssl->storeSession = NULL;
+    #endif
     #ifdef WOLFSSL_EARLY_DATA
         ssl->earlyData = no_early_data;
         ssl->earlyDataSz = 0;
@@ -18831,7 +20026,9 @@ size_t wolfSSL_get_client_random(const WOLFSSL* ssl, unsigned char* out,
     long wolfSSL_CTX_sess_get_cache_size(WOLFSSL_CTX* ctx)
     {
         (void)ctx;
-        #ifndef NO_SESSION_CACHE
+        #ifdef WOLFSSL_SHARDED_SESSION_CACHE
+            return (long)wolfSSL_CTX_get_session_cache_size(ctx);
+        #elif !defined(NO_SESSION_CACHE)
             return (long)(SESSIONS_PER_ROW * SESSION_ROWS);
         #else
             return 0;
@@ -22669,6 +23866,7 @@ long wolfSSL_CTX_add_extra_chain_cert(WOLFSSL_CTX* ctx, WOLFSSL_X509* x509)
 #endif
 
         FreeDer(&ctx->certChain);
+        CertMsgCacheReset(ctx);
         ret = AllocDer(&ctx->certChain, idx, CERT_TYPE, ctx->heap);
         if (ret == 0) {
             XMEMCPY(ctx->certChain->buffer, chain, idx);
@@ -26536,6 +27734,7 @@ void* wolfSSL_GetHKDFExtractCtx(WOLFSSL* ssl)
         }
 
         FreeDer(&ctx->certificate); /* Make sure previous is free'd */
+        CertMsgCacheReset(ctx);
         ret = AllocDer(&ctx->certificate, x->derCert->length, CERT_TYPE,
                        ctx->heap);
         if (ret != 0)
@@ -26653,6 +27852,7 @@ void* wolfSSL_GetHKDFExtractCtx(WOLFSSL* ssl)
                 x509->derCert->length, WOLFSSL_FILETYPE_ASN1);
             if (ret == WOLFSSL_SUCCESS) {
                 /* push to ctx->certChain */
+                CertMsgCacheReset(ctx);
                 ret = PushCertToDerBuffer(&ctx->certChain, 1,
                     x509->derCert->buffer, x509->derCert->length, ctx->heap);
             }
@@ -27671,6 +28871,7 @@ long wolfSSL_CTX_ctrl(WOLFSSL_CTX* ctx, int cmd, long opt, void* pt)
         }
         /* Clear certificate chain */
         FreeDer(&ctx->certChain);
+        CertMsgCacheReset(ctx);
         if (sk) {
             for (i = 0; i < wolfSSL_sk_X509_num(sk); i++) {
                 x509 = wolfSSL_sk_X509_value(sk, i);
@@ -28006,7 +29207,7 @@ void wolfSSL_print_all_errors_fp(XFILE fp)
 static void SESSION_ex_data_cache_update(WOLFSSL_SESSION* session, int idx,
         void* data, byte get, void** getRet, int* setRet)
 {
-    int row;
+    word32 row;
     int i;
     int error = 0;
     SessionRow* sessRow = NULL;
@@ -28022,18 +29223,14 @@ static void SESSION_ex_data_cache_update(WOLFSSL_SESSION* session, int idx,
     if (session->haveAltSessionID)
         id = session->altSessionID;
 
-    row = (int)(HashObject(id, ID_LEN, &error) % SESSION_ROWS);
+    row = HashObject(id, ID_LEN, &error);
     if (error != 0) {
         WOLFSSL_MSG("Hash session failed");
         return;
     }
 
-    sessRow = &SessionCache[row];
-    if (get)
-        error = SESSION_ROW_RD_LOCK(sessRow);
-    else
-        error = SESSION_ROW_WR_LOCK(sessRow);
-    if (error != 0) {
+    sessRow = SessionCacheLockRow(row, 1, get, NULL);
+    if (sessRow == NULL) {
         WOLFSSL_MSG("Session row lock failed");
         return;
     }
@@ -28384,6 +29581,10 @@ WOLFSSL_CTX* wolfSSL_set_SSL_CTX(WOLFSSL* ssl, WOLFSSL_CTX* ctx)
     }
 #else
     (void)ret;
+#endif
+#ifndef WOLFSSL_NO_RECORD_POOL
+    /* buffers borrowed from the old ctx can't go back to it */
+    RecordPoolDetach(ssl);
 #endif
     if (ssl->ctx != NULL)
         wolfSSL_CTX_free(ssl->ctx);
@@ -29936,6 +31137,10 @@ int wolfSSL_SSL_CTX_remove_session(WOLFSSL_CTX *ctx, WOLFSSL_SESSION *s)
         }
     }
 
+#ifdef WOLFSSL_SESSION_STORE
+    SessionStoreRemove(ctx, s);
+#endif
+
 #if defined(HAVE_EXT_CACHE) || defined(HAVE_EX_DATA)
     if (ctx->rem_sess_cb != NULL && !rem_called) {
         ctx->rem_sess_cb(ctx, s);
@@ -0,0 +1,581 @@
+/* ssl_sess_store.c
+ *
+ * Copyright (C) 2006-2023 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+
+#include <wolfssl/wolfcrypt/settings.h>
+
+#include <wolfssl/internal.h>
+
+#if !defined(WOLFSSL_SSL_SESS_STORE_INCLUDED)
+    #ifndef WOLFSSL_IGNORE_FILE_WARN
+        #warning ssl_sess_store.c does not need to be compiled separately from ssl.c
+    #endif
+#else
+
+#ifdef WOLFSSL_SESSION_STORE
+
+/* External session store.
+ *
+ * Servers sharing resumption state hand sessions to a store after the
+ * handshake and look them up by session ID when a ClientHello asks to resume
+ * one that isn't in the local session cache. Sessions are serialized once
+ * with wolfSSL_i2d_SSL_SESSION so the store only deals with opaque bytes.
+ *
+ * The lookup is started when the ClientHello is received, before any state is
+ * changed. When the store returns WOLFSSL_CBIO_ERR_WANT_READ the handshake
+ * returns WOLFSSL_ERROR_WANT_READ and the ClientHello is processed again on
+ * the next call to wolfSSL_accept(), asking the store again.
+ *
+ * Only TLS v1.2 and below resume with a session ID, so the store isn't asked
+ * about ClientHellos that will negotiate TLS v1.3.
+ *
+ * WOLFSSL_SESSION_STORE_MAX_SZ
+ *     Maximum size of a serialized session. Default: 2048.
+ * WOLFSSL_SESSION_STORE_SHM
+ *     Build the shared memory store for worker processes on one host.
+ */
+
+#ifndef WOLFSSL_SESSION_STORE_MAX_SZ
+    #define WOLFSSL_SESSION_STORE_MAX_SZ    2048
+#endif
+
+/* Set the external session store callbacks.
+ *
+ * @param [in, out] ctx       SSL context object.
+ * @param [in]      getCb     Looks up a serialized session by session ID.
+ * @param [in]      setCb     Stores a serialized session. May be NULL.
+ * @param [in]      removeCb  Removes a session. May be NULL.
+ * @param [in]      storeCtx  Passed to all callbacks.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when ctx is NULL.
+ */
+int wolfSSL_CTX_SetSessionStore(WOLFSSL_CTX* ctx,
+    CallbackSessionStoreGet getCb, CallbackSessionStoreSet setCb,
+    CallbackSessionStoreRemove removeCb, void* storeCtx)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_SetSessionStore");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    ctx->sessStoreGetCb = getCb;
+    ctx->sessStoreSetCb = setCb;
+    ctx->sessStoreRemoveCb = removeCb;
+    ctx->sessStoreCtx = storeCtx;
+
+    return WOLFSSL_SUCCESS;
+}
+
+/* Ask the external store for a session.
+ *
+ * On completion the session, if found and still valid, is kept in
+ * ssl->storeSession and the store isn't asked again for this handshake.
+ *
+ * @param [in, out] ssl      SSL object.
+ * @param [in]      id       Session ID of ID_LEN bytes.
+ * @param [in]      canPend  Whether the ClientHello can be processed again.
+ * @return  0 when the lookup has completed.
+ * @return  WANT_READ when the lookup is still in progress.
+ * @return  MEMORY_E on dynamic memory allocation failure.
+ */
+static int SessionStoreFetch(WOLFSSL* ssl, const byte* id, int canPend)
+{
+    int ret;
+    byte* data;
+    WOLFSSL_SESSION* sess = NULL;
+
+    data = (byte*)XMALLOC(WOLFSSL_SESSION_STORE_MAX_SZ, ssl->heap,
+            DYNAMIC_TYPE_TMP_BUFFER);
+    if (data == NULL)
+        return MEMORY_E;
+
+    WOLFSSL_MSG("Calling external session store");
+    ret = ssl->ctx->sessStoreGetCb(ssl, id, ID_LEN, data,
+            WOLFSSL_SESSION_STORE_MAX_SZ, ssl->ctx->sessStoreCtx);
+    if (ret == WOLFSSL_CBIO_ERR_WANT_READ && canPend) {
+        WOLFSSL_MSG("External session store lookup pending");
+        XFREE(data, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        return WANT_READ;
+    }
+    if (ret > 0 && ret <= WOLFSSL_SESSION_STORE_MAX_SZ) {
+        const unsigned char* p = data;
+        sess = wolfSSL_d2i_SSL_SESSION(NULL, &p, ret);
+        if (sess != NULL && (sess->sessionIDSz != ID_LEN ||
+                XMEMCMP(sess->sessionID, id, ID_LEN) != 0 ||
+                LowResTimer() >= sess->bornOn + sess->timeout)) {
+            WOLFSSL_MSG("External session store returned unusable session");
+            wolfSSL_FreeSession(ssl->ctx, sess);
+            sess = NULL;
+        }
+    }
+    XFREE(data, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+    wolfSSL_FreeSession(ssl->ctx, ssl->storeSession);
+    ssl->storeSession = sess;
+    ssl->options.sessionStoreDone = 1;
+
+    return 0;
+}
+
+/* Start the external store lookup of the session ID in a ClientHello.
+ *
+ * Called before the ClientHello changes any state so that it can be processed
+ * again when the lookup is pending. A reassembled ClientHello is not buffered
+ * for processing again and waits for the store instead.
+ *
+ * @param [in, out] ssl      SSL object.
+ * @param [in]      input    ClientHello message body.
+ * @param [in]      helloSz  Length of ClientHello message body.
+ * @return  0 when not needed or the lookup has completed.
+ * @return  WANT_READ when the lookup is still in progress.
+ */
+int SessionStorePrefetch(WOLFSSL* ssl, const byte* input, word32 helloSz)
+{
+    word32 idx = OPAQUE16_LEN + RAN_LEN;
+    const byte* id;
+    const WOLFSSL_SESSION* sess = NULL;
+    word32 row = 0;
+    int canPend;
+
+    if (ssl->options.side != WOLFSSL_SERVER_END || ssl->options.dtls ||
+            ssl->options.sessionStoreDone || ssl->ctx->sessStoreGetCb == NULL ||
+            ssl->options.sessionCacheOff) {
+        return 0;
+    }
+
+    if (idx + OPAQUE8_LEN + ID_LEN > helloSz || input[idx] != ID_LEN)
+        return 0;
+    id = input + idx + OPAQUE8_LEN;
+
+#ifdef WOLFSSL_TLS13
+    if (TLSv1_3_Capable(ssl) && (input[0] > SSLv3_MAJOR ||
+            (input[0] == SSLv3_MAJOR && input[1] >= TLSv1_2_MINOR))) {
+        word16 len;
+        word16 extSz;
+
+        /* Look for TLS v1.3 in supported_versions extension. */
+        idx += OPAQUE8_LEN + ID_LEN;
+        if (idx + OPAQUE16_LEN > helloSz)
+            return 0;
+        ato16(input + idx, &len);
+        idx += OPAQUE16_LEN + len;
+        if (idx + OPAQUE8_LEN > helloSz)
+            return 0;
+        idx += OPAQUE8_LEN + input[idx];
+        if (idx + OPAQUE16_LEN > helloSz)
+            return 0;
+        idx += OPAQUE16_LEN;
+        while (idx + HELLO_EXT_TYPE_SZ + OPAQUE16_LEN <= helloSz) {
+            word16 type;
+
+            ato16(input + idx, &type);
+            ato16(input + idx + HELLO_EXT_TYPE_SZ, &extSz);
+            idx += HELLO_EXT_TYPE_SZ + OPAQUE16_LEN;
+            if (idx + extSz > helloSz)
+                return 0;
+            if (type == TLSX_SUPPORTED_VERSIONS) {
+                word32 i;
+
+                for (i = OPAQUE8_LEN; i + OPAQUE16_LEN <= extSz;
+                        i += OPAQUE16_LEN) {
+                    if (input[idx + i] == SSLv3_MAJOR &&
+                            input[idx + i + 1] >= TLSv1_3_MINOR) {
+                        return 0;
+                    }
+                }
+            }
+            idx += extSz;
+        }
+    }
+#endif
+
+    /* Local cache first. */
+    if (!ssl->options.internalCacheLookupOff &&
+            TlsSessionCacheGetAndRdLock(id, &sess, &row,
+                WOLFSSL_SERVER_END) == 0 && sess != NULL) {
+        TlsSessionCacheUnlockRow(row);
+        return 0;
+    }
+
+    canPend = ssl->arrays == NULL || ssl->arrays->pendingMsg == NULL;
+    return SessionStoreFetch(ssl, id, canPend);
+}
+
+/* Get the session being resumed from the external store.
+ *
+ * @param [in, out] ssl     SSL object.
+ * @param [out]     output  Session to copy into.
+ * @return  WOLFSSL_SUCCESS when a matching session was found.
+ * @return  WOLFSSL_FAILURE otherwise.
+ */
+static int SessionStoreGetSession(WOLFSSL* ssl, WOLFSSL_SESSION* output)
+{
+    int ret = WOLFSSL_FAILURE;
+    const byte* id;
+
+    if (ssl->options.side != WOLFSSL_SERVER_END ||
+            ssl->ctx->sessStoreGetCb == NULL || ssl->arrays == NULL ||
+            IsAtLeastTLSv1_3(ssl->version) || ssl->options.haveSessionId == 0) {
+        return WOLFSSL_FAILURE;
+    }
+    id = ssl->arrays->sessionID;
+
+    if (!ssl->options.sessionStoreDone)
+        (void)SessionStoreFetch(ssl, id, 0);
+
+    if (ssl->storeSession != NULL &&
+            XMEMCMP(ssl->storeSession->sessionID, id, ID_LEN) == 0 &&
+            CheckSessionMatch(ssl, ssl->storeSession)) {
+        WOLFSSL_MSG("Session found in external store");
+        ret = wolfSSL_DupSession(ssl->storeSession, output, 0);
+    }
+
+    return ret;
+}
+
+/* Hand a new server session to the external store.
+ *
+ * @param [in] ssl      SSL object.
+ * @param [in] session  Session to store.
+ * @param [in] id       Session ID.
+ * @param [in] idSz     Length of session ID.
+ */
+static void SessionStorePut(WOLFSSL* ssl, WOLFSSL_SESSION* session,
+    const byte* id, byte idSz)
+{
+    int sz;
+    byte* data = NULL;
+
+    if (ssl->options.side != WOLFSSL_SERVER_END ||
+            ssl->ctx->sessStoreSetCb == NULL || idSz != ID_LEN) {
+        return;
+    }
+
+    sz = wolfSSL_i2d_SSL_SESSION(session, NULL);
+    if (sz <= 0 || sz > WOLFSSL_SESSION_STORE_MAX_SZ) {
+        WOLFSSL_MSG("Session not serializable for external store");
+        return;
+    }
+    data = (byte*)XMALLOC((size_t)sz, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (data == NULL)
+        return;
+    if (wolfSSL_i2d_SSL_SESSION(session, &data) == sz) {
+        (void)ssl->ctx->sessStoreSetCb(ssl, id, idSz, data, sz,
+                session->bornOn + session->timeout, ssl->ctx->sessStoreCtx);
+    }
+    XFREE(data, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+}
+
+#if (defined(OPENSSL_ALL) || defined(WOLFSSL_NGINX) || \
+     defined(WOLFSSL_HAPROXY) || defined(OPENSSL_EXTRA) || \
+     defined(HAVE_LIGHTY)) && !defined(NO_SESSION_CACHE)
+/* Remove a session from the external store.
+ *
+ * @param [in] ctx      SSL context object.
+ * @param [in] session  Session to remove.
+ */
+static void SessionStoreRemove(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* session)
+{
+    if (ctx->sessStoreRemoveCb != NULL && session->side == WOLFSSL_SERVER_END &&
+            session->sessionIDSz == ID_LEN) {
+        ctx->sessStoreRemoveCb(session->sessionID, ID_LEN, ctx->sessStoreCtx);
+    }
+}
+#endif /* (OPENSSL_ALL || WOLFSSL_NGINX || WOLFSSL_HAPROXY || OPENSSL_EXTRA ||
+        * HAVE_LIGHTY) && !NO_SESSION_CACHE */
+
+#ifdef WOLFSSL_SESSION_STORE_SHM
+
+/* Shared memory session store.
+ *
+ * The application maps memory shared by its worker processes, formats it
+ * once with wolfSSL_SessionStoreShm_Init() and has every process call
+ * wolfSSL_CTX_UseSessionStoreShm() with its mapping. Sessions are hashed into
+ * sets of WOLFSSL_SESSION_STORE_SHM_WAYS entries, each set with a process
+ * shared mutex. When a set is full the entry expiring first is replaced.
+ *
+ * WOLFSSL_SESSION_STORE_SHM_WAYS
+ *     Entries per set. Default: 4.
+ * WOLFSSL_SESSION_STORE_SHM_DATA_SZ
+ *     Maximum serialized session size kept. Default: 512.
+ */
+
+#ifndef WOLFSSL_SESSION_STORE_SHM_WAYS
+    #define WOLFSSL_SESSION_STORE_SHM_WAYS      4
+#endif
+#ifndef WOLFSSL_SESSION_STORE_SHM_DATA_SZ
+    #define WOLFSSL_SESSION_STORE_SHM_DATA_SZ   512
+#endif
+
+#define SESSION_STORE_SHM_MAGIC 0x77534853 /* wSHS */
+
+typedef struct SessionStoreShmEntry {
+    word32 expire;
+    word16 dataSz;                          /* 0 when empty */
+    byte   id[ID_LEN];
+    byte   data[WOLFSSL_SESSION_STORE_SHM_DATA_SZ];
+} SessionStoreShmEntry;
+
+typedef struct SessionStoreShmSet {
+    pthread_mutex_t      lock;
+    SessionStoreShmEntry entry[WOLFSSL_SESSION_STORE_SHM_WAYS];
+} SessionStoreShmSet;
+
+typedef struct SessionStoreShm {
+    word32             magic;
+    word32             sets;
+    SessionStoreShmSet set[1];
+} SessionStoreShm;
+
+/* Size of the shared memory to hold a number of sessions.
+ *
+ * @param [in] sessions  Number of sessions.
+ * @return  Size in bytes on success.
+ * @return  BAD_FUNC_ARG when sessions is not positive.
+ */
+int wolfSSL_SessionStoreShm_Size(int sessions)
+{
+    word32 sets;
+
+    if (sessions <= 0 || sessions > 0x100000)
+        return BAD_FUNC_ARG;
+
+    sets = ((word32)sessions + WOLFSSL_SESSION_STORE_SHM_WAYS - 1) /
+        WOLFSSL_SESSION_STORE_SHM_WAYS;
+    return (int)(sizeof(SessionStoreShm) +
+        (sets - 1) * sizeof(SessionStoreShmSet));
+}
+
+/* Format shared memory as an empty session store.
+ *
+ * Call once before the worker processes use it.
+ *
+ * @param [out] mem    Shared memory.
+ * @param [in]  memSz  Size of shared memory in bytes.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when mem is NULL or memSz too small.
+ * @return  BAD_MUTEX_E when a mutex can't be initialized.
+ */
+int wolfSSL_SessionStoreShm_Init(void* mem, int memSz)
+{
+    SessionStoreShm* store = (SessionStoreShm*)mem;
+    pthread_mutexattr_t attr;
+    word32 sets;
+    word32 i;
+    int ret = WOLFSSL_SUCCESS;
+
+    WOLFSSL_ENTER("wolfSSL_SessionStoreShm_Init");
+
+    if (mem == NULL || memSz < (int)sizeof(SessionStoreShm))
+        return BAD_FUNC_ARG;
+
+    sets = 1 + (word32)(memSz - (int)sizeof(SessionStoreShm)) /
+        (word32)sizeof(SessionStoreShmSet);
+    XMEMSET(store, 0, sizeof(SessionStoreShm) +
+        (sets - 1) * sizeof(SessionStoreShmSet));
+
+    if (pthread_mutexattr_init(&attr) != 0)
+        return BAD_MUTEX_E;
+    if (pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) != 0)
+        ret = BAD_MUTEX_E;
+    for (i = 0; ret == WOLFSSL_SUCCESS && i < sets; i++) {
+        if (pthread_mutex_init(&store->set[i].lock, &attr) != 0) {
+            while (i > 0)
+                pthread_mutex_destroy(&store->set[--i].lock);
+            ret = BAD_MUTEX_E;
+        }
+    }
+    pthread_mutexattr_destroy(&attr);
+
+    if (ret == WOLFSSL_SUCCESS) {
+        store->sets = sets;
+        store->magic = SESSION_STORE_SHM_MAGIC;
+    }
+
+    return ret;
+}
+
+/* Release the mutexes of a shared memory session store.
+ *
+ * Call once after all the worker processes are done with it.
+ *
+ * @param [in, out] mem  Shared memory.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when mem is not a session store.
+ */
+int wolfSSL_SessionStoreShm_Free(void* mem)
+{
+    SessionStoreShm* store = (SessionStoreShm*)mem;
+    word32 i;
+
+    if (store == NULL || store->magic != SESSION_STORE_SHM_MAGIC)
+        return BAD_FUNC_ARG;
+
+    for (i = 0; i < store->sets; i++)
+        pthread_mutex_destroy(&store->set[i].lock);
+    store->magic = 0;
+
+    return WOLFSSL_SUCCESS;
+}
+
+/* Find and lock the set for a session ID.
+ *
+ * @return  Locked set on success.
+ * @return  NULL on failure.
+ */
+static SessionStoreShmSet* SessionStoreShmLock(SessionStoreShm* store,
+    const byte* id, int idSz)
+{
+    SessionStoreShmSet* set;
+    word32 hash;
+    int error = 0;
+
+    if (idSz != ID_LEN)
+        return NULL;
+    hash = HashObject(id, ID_LEN, &error);
+    if (error != 0)
+        return NULL;
+    set = &store->set[hash % store->sets];
+    if (pthread_mutex_lock(&set->lock) != 0)
+        return NULL;
+    return set;
+}
+
+static SessionStoreShmEntry* SessionStoreShmFind(SessionStoreShmSet* set,
+    const byte* id)
+{
+    int i;
+
+    for (i = 0; i < WOLFSSL_SESSION_STORE_SHM_WAYS; i++) {
+        if (set->entry[i].dataSz != 0 &&
+                XMEMCMP(set->entry[i].id, id, ID_LEN) == 0) {
+            return &set->entry[i];
+        }
+    }
+    return NULL;
+}
+
+static int SessionStoreShmGetCb(WOLFSSL* ssl, const unsigned char* id,
+    int idSz, unsigned char* data, int dataSz, void* ctx)
+{
+    SessionStoreShmSet* set;
+    SessionStoreShmEntry* entry;
+    int ret = 0;
+
+    (void)ssl;
+
+    set = SessionStoreShmLock((SessionStoreShm*)ctx, id, idSz);
+    if (set == NULL)
+        return 0;
+    entry = SessionStoreShmFind(set, id);
+    if (entry != NULL) {
+        if (LowResTimer() >= entry->expire)
+            entry->dataSz = 0;
+        else if (entry->dataSz <= dataSz) {
+            XMEMCPY(data, entry->data, entry->dataSz);
+            ret = entry->dataSz;
+        }
+    }
+    pthread_mutex_unlock(&set->lock);
+
+    return ret;
+}
+
+static int SessionStoreShmSetCb(WOLFSSL* ssl, const unsigned char* id,
+    int idSz, const unsigned char* data, int dataSz, word32 expire, void* ctx)
+{
+    SessionStoreShmSet* set;
+    SessionStoreShmEntry* entry;
+    int i;
+
+    (void)ssl;
+
+    if (dataSz <= 0 || dataSz > WOLFSSL_SESSION_STORE_SHM_DATA_SZ)
+        return WOLFSSL_FAILURE;
+    set = SessionStoreShmLock((SessionStoreShm*)ctx, id, idSz);
+    if (set == NULL)
+        return WOLFSSL_FAILURE;
+    entry = SessionStoreShmFind(set, id);
+    for (i = 0; entry == NULL && i < WOLFSSL_SESSION_STORE_SHM_WAYS; i++) {
+        if (set->entry[i].dataSz == 0)
+            entry = &set->entry[i];
+    }
+    if (entry == NULL) {
+        /* Replace the session expiring first. */
+        entry = &set->entry[0];
+        for (i = 1; i < WOLFSSL_SESSION_STORE_SHM_WAYS; i++) {
+            if (set->entry[i].expire < entry->expire)
+                entry = &set->entry[i];
+        }
+    }
+    XMEMCPY(entry->id, id, ID_LEN);
+    XMEMCPY(entry->data, data, (size_t)dataSz);
+    entry->dataSz = (word16)dataSz;
+    entry->expire = expire;
+    pthread_mutex_unlock(&set->lock);
+
+    return WOLFSSL_SUCCESS;
+}
+
+static void SessionStoreShmRemoveCb(const unsigned char* id, int idSz,
+    void* ctx)
+{
+    SessionStoreShmSet* set;
+    SessionStoreShmEntry* entry;
+
+    set = SessionStoreShmLock((SessionStoreShm*)ctx, id, idSz);
+    if (set == NULL)
+        return;
+    entry = SessionStoreShmFind(set, id);
+    if (entry != NULL)
+        entry->dataSz = 0;
+    pthread_mutex_unlock(&set->lock);
+}
+
+/* Use a shared memory session store.
+ *
+ * @param [in, out] ctx  SSL context object.
+ * @param [in]      mem  Shared memory formatted by
+ *                       wolfSSL_SessionStoreShm_Init().
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when ctx is NULL or mem is not a session store.
+ */
+int wolfSSL_CTX_UseSessionStoreShm(WOLFSSL_CTX* ctx, void* mem)
+{
+    SessionStoreShm* store = (SessionStoreShm*)mem;
+
+    if (ctx == NULL || store == NULL ||
+            store->magic != SESSION_STORE_SHM_MAGIC) {
+        return BAD_FUNC_ARG;
+    }
+
+    return wolfSSL_CTX_SetSessionStore(ctx, SessionStoreShmGetCb,
+        SessionStoreShmSetCb, SessionStoreShmRemoveCb, store);
+}
+
+#endif /* WOLFSSL_SESSION_STORE_SHM */
+
+#endif /* WOLFSSL_SESSION_STORE */
+
+#endif /* !WOLFSSL_SSL_SESS_STORE_INCLUDED */
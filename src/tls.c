@@ -6513,6 +6513,14 @@ static int TLSX_Cookie_Parse(WOLFSSL* ssl, const byte* input, word16 length,
             return TLSX_Cookie_Use(ssl, input + idx, len, NULL, 0, 0,
                                    &ssl->extensions);
         else
+#endif
+#ifdef WOLFSSL_STATELESS_HRR
+        /* The HelloRetryRequest was sent without keeping its Cookie. */
+        if (ssl->options.statelessHrr && ssl->options.serverState ==
+                                          SERVER_HELLO_RETRY_REQUEST_COMPLETE)
+            return TLSX_Cookie_Use(ssl, input + idx, len, NULL, 0, 0,
+                                   &ssl->extensions);
+        else
 #endif
         {
             WOLFSSL_ERROR_VERBOSE(HRR_COOKIE_ERROR);
@@ -7790,6 +7798,665 @@ static int TLSX_KeyShare_GenPqcKey(WOLFSSL *ssl, KeyShareEntry* kse)
 }
 #endif /* HAVE_PQC */
 
+#ifdef WOLFSSL_KEY_SHARE_POOL
+/* Lock the groups of the key share pool. */
+static WC_INLINE int KeySharePoolLock(KeySharePool* pool)
+{
+#ifndef SINGLE_THREADED
+    return wolfSSL_CondStart(&pool->cond);
+#else
+    (void)pool;
+    return 0;
+#endif
+}
+
+/* Unlock the groups of the key share pool. */
+static WC_INLINE void KeySharePoolUnLock(KeySharePool* pool)
+{
+#ifndef SINGLE_THREADED
+    wolfSSL_CondEnd(&pool->cond);
+#else
+    (void)pool;
+#endif
+}
+
+/* Wake the filler thread, if running. Groups locked. */
+static WC_INLINE void KeySharePoolWake(KeySharePool* pool)
+{
+#ifndef SINGLE_THREADED
+    if (pool->threadOn)
+        wolfSSL_CondSignal(&pool->cond);
+#else
+    (void)pool;
+#endif
+}
+
+/* Check whether the pool can make key pairs of the named group.
+ *
+ * Hybrid post-quantum groups are not pooled as their ECC half would need an
+ * entry of its own.
+ *
+ * group  The named group.
+ * returns 1 when supported, 0 otherwise.
+ */
+static int KeySharePoolGroupSupported(word16 group)
+{
+    switch (group) {
+    #ifdef HAVE_CURVE25519
+        case WOLFSSL_ECC_X25519:
+            return 1;
+    #endif
+    #if defined(HAVE_ECC) && defined(HAVE_ECC_KEY_EXPORT) && \
+        (!defined(NO_ECC256) || defined(HAVE_ALL_CURVES)) && \
+        ECC_MIN_KEY_SZ <= 256 && !defined(NO_ECC_SECP)
+        case WOLFSSL_ECC_SECP256R1:
+            return 1;
+    #endif
+        default:
+            break;
+    }
+#ifdef HAVE_PQC
+    if (WOLFSSL_NAMED_GROUP_IS_PQC(group)) {
+        int ecc = 0;
+        int pqc = 0;
+        int type = 0;
+
+        findEccPqc(&ecc, &pqc, group);
+        return ecc == 0 && kyber_id2type(pqc, &type) == 0;
+    }
+#endif
+    return 0;
+}
+
+/* Free a key pair of the pool.
+ *
+ * entry  The key pair.
+ * group  The named group of the key pair.
+ * heap   The heap used for allocation.
+ */
+static void KeySharePoolEntryFree(KeySharePoolEntry* entry, word16 group,
+    void* heap)
+{
+    if (group == WOLFSSL_ECC_X25519) {
+#ifdef HAVE_CURVE25519
+        wc_curve25519_free((curve25519_key*)entry->key);
+#endif
+    }
+#ifdef HAVE_PQC
+    else if (WOLFSSL_NAMED_GROUP_IS_PQC(group)) {
+        if (entry->privKey != NULL) {
+            ForceZero(entry->privKey, entry->privKeyLen);
+            XFREE(entry->privKey, heap, DYNAMIC_TYPE_PRIVATE_KEY);
+        }
+    }
+#endif
+    else if (entry->key != NULL) {
+#ifdef HAVE_ECC
+        wc_ecc_free((ecc_key*)entry->key);
+#endif
+    }
+    XFREE(entry->key, heap, DYNAMIC_TYPE_PRIVATE_KEY);
+    XFREE(entry->pubKey, heap, DYNAMIC_TYPE_PUBLIC_KEY);
+    XFREE(entry, heap, DYNAMIC_TYPE_KEY_SHARE_POOL);
+}
+
+/* Generate a key pair of the named group in the form
+ * TLSX_KeyShare_GenKey() would leave it in a key share entry.
+ * Caller holds the RNG lock.
+ *
+ * pool   The key share pool.
+ * group  The named group.
+ * out    The new key pair.
+ * returns 0 on success, otherwise failure.
+ */
+static int KeySharePoolMake(KeySharePool* pool, word16 group,
+    KeySharePoolEntry** out)
+{
+    int ret = 0;
+    void* heap = pool->heap;
+    KeySharePoolEntry* entry;
+
+    entry = (KeySharePoolEntry*)XMALLOC(sizeof(KeySharePoolEntry), heap,
+                                        DYNAMIC_TYPE_KEY_SHARE_POOL);
+    if (entry == NULL)
+        return MEMORY_E;
+    XMEMSET(entry, 0, sizeof(KeySharePoolEntry));
+
+#ifdef HAVE_CURVE25519
+    if (group == WOLFSSL_ECC_X25519) {
+        curve25519_key* key;
+
+        key = (curve25519_key*)XMALLOC(sizeof(curve25519_key), heap,
+                                       DYNAMIC_TYPE_PRIVATE_KEY);
+        if (key == NULL) {
+            ret = MEMORY_E;
+        }
+        else if ((ret = wc_curve25519_init_ex(key, heap, INVALID_DEVID)) != 0) {
+            XFREE(key, heap, DYNAMIC_TYPE_PRIVATE_KEY);
+        }
+        else {
+            entry->key = key;
+        }
+
+        if (ret == 0)
+            ret = wc_curve25519_make_key(&pool->rng, CURVE25519_KEYSIZE, key);
+        if (ret == 0) {
+            entry->pubKey = (byte*)XMALLOC(CURVE25519_KEYSIZE, heap,
+                                           DYNAMIC_TYPE_PUBLIC_KEY);
+            if (entry->pubKey == NULL)
+                ret = MEMORY_E;
+        }
+        if (ret == 0) {
+            entry->pubKeyLen = CURVE25519_KEYSIZE;
+            if (wc_curve25519_export_public_ex(key, entry->pubKey,
+                    &entry->pubKeyLen, EC25519_LITTLE_ENDIAN) != 0) {
+                ret = ECC_EXPORT_ERROR;
+            }
+        }
+    }
+    else
+#endif
+#ifdef HAVE_PQC
+    if (WOLFSSL_NAMED_GROUP_IS_PQC(group)) {
+        KyberKey kem[1];
+        int type = 0;
+        int pqc = 0;
+        word32 privSz = 0;
+        word32 pubSz = 0;
+
+        findEccPqc(NULL, &pqc, group);
+        ret = kyber_id2type(pqc, &type);
+        if (ret == 0)
+            ret = wc_KyberKey_Init(type, kem, heap, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_KyberKey_PrivateKeySize(kem, &privSz);
+            if (ret == 0)
+                ret = wc_KyberKey_PublicKeySize(kem, &pubSz);
+            if (ret == 0) {
+                entry->pubKey = (byte*)XMALLOC(pubSz, heap,
+                                               DYNAMIC_TYPE_PUBLIC_KEY);
+                entry->privKey = (byte*)XMALLOC(privSz, heap,
+                                                DYNAMIC_TYPE_PRIVATE_KEY);
+                entry->pubKeyLen = pubSz;
+                entry->privKeyLen = privSz;
+                if (entry->pubKey == NULL || entry->privKey == NULL)
+                    ret = MEMORY_E;
+            }
+            if (ret == 0)
+                ret = wc_KyberKey_MakeKey(kem, &pool->rng);
+            if (ret == 0)
+                ret = wc_KyberKey_EncodePublicKey(kem, entry->pubKey, pubSz);
+            if (ret == 0)
+                ret = wc_KyberKey_EncodePrivateKey(kem, entry->privKey, privSz);
+            wc_KyberKey_Free(kem);
+        }
+    }
+    else
+#endif
+    {
+#if defined(HAVE_ECC) && defined(HAVE_ECC_KEY_EXPORT)
+        ecc_key* key;
+
+        key = (ecc_key*)XMALLOC(sizeof(ecc_key), heap,
+                                DYNAMIC_TYPE_PRIVATE_KEY);
+        if (key == NULL) {
+            ret = MEMORY_E;
+        }
+        else if ((ret = wc_ecc_init_ex(key, heap, INVALID_DEVID)) != 0) {
+            XFREE(key, heap, DYNAMIC_TYPE_PRIVATE_KEY);
+        }
+        else {
+            entry->key = key;
+        }
+
+        if (ret == 0) {
+            entry->keyLen = 32;
+            entry->pubKeyLen = 2 * 32 + 1;
+            ret = wc_ecc_make_key_ex(&pool->rng, (int)entry->keyLen, key,
+                                     ECC_SECP256R1);
+        }
+        if (ret == 0) {
+            entry->pubKey = (byte*)XMALLOC(entry->pubKeyLen, heap,
+                                           DYNAMIC_TYPE_PUBLIC_KEY);
+            if (entry->pubKey == NULL)
+                ret = MEMORY_E;
+        }
+        if (ret == 0) {
+            PRIVATE_KEY_UNLOCK();
+            ret = wc_ecc_export_x963(key, entry->pubKey, &entry->pubKeyLen);
+            PRIVATE_KEY_LOCK();
+        }
+#else
+        ret = NOT_COMPILED_IN;
+#endif
+    }
+
+    if (ret != 0) {
+        KeySharePoolEntryFree(entry, group, heap);
+        entry = NULL;
+    }
+    *out = entry;
+    return ret;
+}
+
+/* Find the slot of the named group. Groups locked.
+ *
+ * returns the slot or NULL when the group is not pooled.
+ */
+static KeySharePoolGroup* KeySharePoolFind(KeySharePool* pool, word16 group)
+{
+    int i;
+
+    for (i = 0; i < WOLFSSL_KEY_SHARE_POOL_GROUPS; i++) {
+        if (pool->groups[i].group == group)
+            return &pool->groups[i];
+    }
+    return NULL;
+}
+
+/* Find the group missing the most key pairs. Groups locked.
+ *
+ * returns the slot or NULL when all groups are full.
+ */
+static KeySharePoolGroup* KeySharePoolNeediest(KeySharePool* pool)
+{
+    KeySharePoolGroup* grp = NULL;
+    word32 missing = 0;
+    int i;
+
+    for (i = 0; i < WOLFSSL_KEY_SHARE_POOL_GROUPS; i++) {
+        KeySharePoolGroup* g = &pool->groups[i];
+
+        if (g->ready + g->making < g->size &&
+                g->size - g->ready - g->making > missing) {
+            missing = g->size - g->ready - g->making;
+            grp = g;
+        }
+    }
+    return grp;
+}
+
+/* Make one key pair for the group missing the most.
+ *
+ * Key generation is done with the groups unlocked so that handshakes can take
+ * key pairs meanwhile. A slot is not reused while key pairs are being made for
+ * it so the group of the slot stays the same.
+ *
+ * returns 1 when a key pair was made, 0 when all groups are full, otherwise
+ * failure.
+ */
+static int KeySharePoolFillOne(KeySharePool* pool)
+{
+    int ret;
+    KeySharePoolGroup* grp;
+    KeySharePoolEntry* entry = NULL;
+    word16 group;
+
+    if (KeySharePoolLock(pool) != 0)
+        return BAD_MUTEX_E;
+    grp = KeySharePoolNeediest(pool);
+    if (grp != NULL)
+        grp->making++;
+    KeySharePoolUnLock(pool);
+    if (grp == NULL)
+        return 0;
+    group = grp->group;
+
+#ifndef SINGLE_THREADED
+    ret = wc_LockMutex(&pool->rngLock);
+    if (ret == 0)
+#endif
+    {
+        ret = KeySharePoolMake(pool, group, &entry);
+    #ifndef SINGLE_THREADED
+        wc_UnLockMutex(&pool->rngLock);
+    #endif
+    }
+
+    /* Nothing sensible to fall back to when the lock fails. */
+    (void)KeySharePoolLock(pool);
+    grp->making--;
+    /* Size may have been lowered while making. */
+    if (ret == 0 && grp->ready < grp->size) {
+        entry->next = grp->head;
+        grp->head = entry;
+        grp->ready++;
+        entry = NULL;
+    }
+    KeySharePoolUnLock(pool);
+
+    if (entry != NULL)
+        KeySharePoolEntryFree(entry, group, pool->heap);
+    return (ret == 0) ? 1 : ret;
+}
+
+#ifndef SINGLE_THREADED
+/* Thread that keeps the groups of the pool filled. */
+static THREAD_RETURN WOLFSSL_THREAD KeySharePoolFiller(void* arg)
+{
+    KeySharePool* pool = (KeySharePool*)arg;
+    int wait = 0;
+    int stop = 0;
+
+    while (!stop) {
+        if (wolfSSL_CondStart(&pool->cond) != 0)
+            break;
+        while (!pool->stop && (wait || KeySharePoolNeediest(pool) == NULL)) {
+            wait = 0;
+            if (wolfSSL_CondWait(&pool->cond) != 0)
+                break;
+        }
+        stop = pool->stop;
+        wolfSSL_CondEnd(&pool->cond);
+
+        if (!stop) {
+            /* On failure, try again when a key pair is next taken. */
+            wait = (KeySharePoolFillOne(pool) < 0);
+        }
+    }
+
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+#endif
+
+/* Create the key share pool of the CTX.
+ *
+ * returns 0 on success, otherwise failure.
+ */
+static int KeySharePoolNew(WOLFSSL_CTX* ctx)
+{
+    int ret;
+    KeySharePool* pool;
+
+    pool = (KeySharePool*)XMALLOC(sizeof(KeySharePool), ctx->heap,
+                                  DYNAMIC_TYPE_KEY_SHARE_POOL);
+    if (pool == NULL)
+        return MEMORY_E;
+    XMEMSET(pool, 0, sizeof(KeySharePool));
+    pool->heap = ctx->heap;
+
+    ret = wc_InitRng_ex(&pool->rng, pool->heap, INVALID_DEVID);
+#ifndef SINGLE_THREADED
+    if (ret == 0) {
+        ret = wolfSSL_CondInit(&pool->cond);
+        if (ret == 0) {
+            if (wc_InitMutex(&pool->rngLock) != 0) {
+                wolfSSL_CondFree(&pool->cond);
+                ret = BAD_MUTEX_E;
+            }
+        }
+        if (ret != 0)
+            wc_FreeRng(&pool->rng);
+    }
+#endif
+    if (ret != 0) {
+        XFREE(pool, ctx->heap, DYNAMIC_TYPE_KEY_SHARE_POOL);
+        return ret;
+    }
+
+    ctx->keySharePool = pool;
+    return 0;
+}
+
+/* Set the number of key pairs of the named group to keep ready.
+ *
+ * ctx    The SSL/TLS CTX object.
+ * group  The named group.
+ * size   The number of key pairs. 0 stops pooling the group.
+ * returns WOLFSSL_SUCCESS on success, otherwise failure.
+ */
+int KeySharePoolSet(WOLFSSL_CTX* ctx, word16 group, word32 size)
+{
+    int ret = WOLFSSL_SUCCESS;
+    int i;
+    KeySharePool* pool;
+    KeySharePoolGroup* grp;
+    KeySharePoolEntry* drop = NULL;
+    KeySharePoolEntry* entry;
+
+    if (!KeySharePoolGroupSupported(group))
+        return BAD_FUNC_ARG;
+
+    if (ctx->keySharePool == NULL) {
+        if (size == 0)
+            return WOLFSSL_SUCCESS;
+        ret = KeySharePoolNew(ctx);
+        if (ret != 0)
+            return ret;
+        ret = WOLFSSL_SUCCESS;
+    }
+    pool = ctx->keySharePool;
+
+    if (KeySharePoolLock(pool) != 0)
+        return BAD_MUTEX_E;
+    grp = KeySharePoolFind(pool, group);
+    if (grp == NULL && size > 0) {
+        /* Take a slot that is free or no longer in use. */
+        for (i = 0; i < WOLFSSL_KEY_SHARE_POOL_GROUPS; i++) {
+            KeySharePoolGroup* g = &pool->groups[i];
+
+            if (g->size == 0 && g->ready == 0 && g->making == 0) {
+                XMEMSET(g, 0, sizeof(KeySharePoolGroup));
+                g->group = group;
+                grp = g;
+                break;
+            }
+        }
+        if (grp == NULL)
+            ret = BUFFER_E;
+    }
+    if (grp != NULL) {
+        grp->size = size;
+        while (grp->ready > size) {
+            entry = grp->head;
+            grp->head = entry->next;
+            grp->ready--;
+            entry->next = drop;
+            drop = entry;
+        }
+        KeySharePoolWake(pool);
+    }
+    KeySharePoolUnLock(pool);
+
+    while ((entry = drop) != NULL) {
+        drop = entry->next;
+        KeySharePoolEntryFree(entry, group, pool->heap);
+    }
+    return ret;
+}
+
+/* Make key pairs until all groups of the pool are full.
+ *
+ * ctx  The SSL/TLS CTX object.
+ * max  The maximum number of key pairs to make. 0 for no limit.
+ * returns the number of key pairs made, otherwise failure.
+ */
+int KeySharePoolFill(WOLFSSL_CTX* ctx, int max)
+{
+    int ret = 0;
+    int made = 0;
+
+    if (ctx->keySharePool == NULL)
+        return 0;
+
+    while (max == 0 || made < max) {
+        ret = KeySharePoolFillOne(ctx->keySharePool);
+        if (ret <= 0)
+            break;
+        made++;
+    }
+
+    return (ret < 0) ? ret : made;
+}
+
+#ifndef SINGLE_THREADED
+/* Start a thread that keeps the groups of the pool filled.
+ *
+ * ctx  The SSL/TLS CTX object.
+ * returns WOLFSSL_SUCCESS on success, otherwise failure.
+ */
+int KeySharePoolStart(WOLFSSL_CTX* ctx)
+{
+    int ret;
+    KeySharePool* pool;
+
+    if (ctx->keySharePool == NULL) {
+        ret = KeySharePoolNew(ctx);
+        if (ret != 0)
+            return ret;
+    }
+    pool = ctx->keySharePool;
+
+    if (wolfSSL_CondStart(&pool->cond) != 0)
+        return BAD_MUTEX_E;
+    ret = 0;
+    if (!pool->threadOn) {
+        pool->stop = 0;
+        ret = wolfSSL_NewThread(&pool->thread, KeySharePoolFiller, pool);
+        if (ret == 0)
+            pool->threadOn = 1;
+    }
+    wolfSSL_CondEnd(&pool->cond);
+
+    return (ret == 0) ? WOLFSSL_SUCCESS : ret;
+}
+#endif
+
+/* Get the counters of the named group.
+ *
+ * ctx    The SSL/TLS CTX object.
+ * group  The named group.
+ * stats  The counters. All zero when the group is not pooled.
+ * returns WOLFSSL_SUCCESS on success, otherwise failure.
+ */
+int KeySharePoolGetStats(WOLFSSL_CTX* ctx, word16 group,
+    WOLFSSL_KEYSHARE_POOL_STATS* stats)
+{
+    KeySharePool* pool = ctx->keySharePool;
+    KeySharePoolGroup* grp;
+
+    XMEMSET(stats, 0, sizeof(WOLFSSL_KEYSHARE_POOL_STATS));
+    if (pool == NULL)
+        return WOLFSSL_SUCCESS;
+
+    if (KeySharePoolLock(pool) != 0)
+        return BAD_MUTEX_E;
+    grp = KeySharePoolFind(pool, group);
+    if (grp != NULL) {
+        stats->used = grp->used;
+        stats->underruns = grp->underruns;
+        stats->ready = grp->ready;
+        stats->size = grp->size;
+    }
+    KeySharePoolUnLock(pool);
+
+    return WOLFSSL_SUCCESS;
+}
+
+/* Stop the filler thread and free the key share pool of the CTX.
+ *
+ * ctx  The SSL/TLS CTX object.
+ */
+void KeySharePoolFree(WOLFSSL_CTX* ctx)
+{
+    KeySharePool* pool = ctx->keySharePool;
+    KeySharePoolEntry* entry;
+    int i;
+
+    if (pool == NULL)
+        return;
+
+#ifndef SINGLE_THREADED
+    if (pool->threadOn) {
+        if (wolfSSL_CondStart(&pool->cond) == 0) {
+            pool->stop = 1;
+            wolfSSL_CondSignal(&pool->cond);
+            wolfSSL_CondEnd(&pool->cond);
+        }
+        (void)wolfSSL_JoinThread(pool->thread);
+        pool->threadOn = 0;
+    }
+#endif
+
+    for (i = 0; i < WOLFSSL_KEY_SHARE_POOL_GROUPS; i++) {
+        while ((entry = pool->groups[i].head) != NULL) {
+            pool->groups[i].head = entry->next;
+            KeySharePoolEntryFree(entry, pool->groups[i].group, pool->heap);
+        }
+    }
+
+    wc_FreeRng(&pool->rng);
+#ifndef SINGLE_THREADED
+    wc_FreeMutex(&pool->rngLock);
+    wolfSSL_CondFree(&pool->cond);
+#endif
+    XFREE(pool, pool->heap, DYNAMIC_TYPE_KEY_SHARE_POOL);
+    ctx->keySharePool = NULL;
+}
+
+/* Take a key pair made ahead for the key share entry.
+ *
+ * Key pairs are only handed out when the handshake would have made them the
+ * same way: in software, on the heap of the CTX, without a user callback or a
+ * static ephemeral key. Each key pair is used by one handshake only.
+ *
+ * ssl  The SSL/TLS object.
+ * kse  The key share entry.
+ * returns 1 when kse now holds a key pair, 0 when one is to be generated.
+ */
+static int KeySharePoolUse(WOLFSSL* ssl, KeyShareEntry* kse)
+{
+    KeySharePool* pool = ssl->ctx->keySharePool;
+    KeySharePoolGroup* grp;
+    KeySharePoolEntry* entry = NULL;
+
+    if (pool == NULL || kse->key != NULL || kse->pubKey != NULL ||
+            ssl->devId != INVALID_DEVID || ssl->heap != pool->heap) {
+        return 0;
+    }
+#ifdef HAVE_PK_CALLBACKS
+    if (kse->group == WOLFSSL_ECC_SECP256R1 && ssl->ctx->EccKeyGenCb != NULL)
+        return 0;
+#endif
+#ifdef WOLFSSL_STATIC_EPHEMERAL
+    if (ssl->ctx->staticKELockInit)
+        return 0;
+#endif
+
+    if (KeySharePoolLock(pool) != 0)
+        return 0;
+    grp = KeySharePoolFind(pool, kse->group);
+    if (grp != NULL && grp->size > 0) {
+        entry = grp->head;
+        if (entry != NULL) {
+            grp->head = entry->next;
+            grp->ready--;
+            grp->used++;
+        }
+        else {
+            grp->underruns++;
+        }
+        KeySharePoolWake(pool);
+    }
+    KeySharePoolUnLock(pool);
+
+    if (entry == NULL)
+        return 0;
+
+    /* Key share entry owns the key pair now. */
+    kse->key = entry->key;
+    kse->keyLen = entry->keyLen;
+    kse->pubKey = entry->pubKey;
+    kse->pubKeyLen = entry->pubKeyLen;
+#ifdef HAVE_PQC
+    kse->privKey = entry->privKey;
+    kse->privKeyLen = entry->privKeyLen;
+#endif
+    XFREE(entry, pool->heap, DYNAMIC_TYPE_KEY_SHARE_POOL);
+    return 1;
+}
+#endif /* WOLFSSL_KEY_SHARE_POOL */
+
 /* Generate a secret/key using the key share entry.
  *
  * ssl  The SSL/TLS object.
@@ -7798,6 +8465,11 @@ static int TLSX_KeyShare_GenPqcKey(WOLFSSL *ssl, KeyShareEntry* kse)
 int TLSX_KeyShare_GenKey(WOLFSSL *ssl, KeyShareEntry *kse)
 {
     int ret;
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    if (KeySharePoolUse(ssl, kse))
+        ret = 0;
+    else
+#endif
     /* Named FFDHE groups have a bit set to identify them. */
     if (WOLFSSL_NAMED_GROUP_IS_FFHDE(kse->group))
         ret = TLSX_KeyShare_GenDhKey(ssl, kse);
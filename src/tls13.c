@@ -3227,6 +3227,13 @@ int BuildTls13Message(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
 
     WOLFSSL_ENTER("BuildTls13Message");
 
+#ifdef WOLFSSL_KTLS
+    if (ssl->options.ktlsTx) {
+        return BuildKtlsMessage(ssl, output, outSz, input, inSz, type,
+                                hashOutput, sizeOnly);
+    }
+#endif
+
 #ifdef WOLFSSL_ASYNC_CRYPT
     ret = WC_NO_PENDING_E;
     if (asyncOkay) {
@@ -3537,6 +3544,28 @@ byte SuiteMac(const byte* suite)
 }
 #endif
 
+#if defined(WOLFSSL_SEND_HRR_COOKIE)
+/* Get the secret used for the integrity check of the HRR Cookie.
+ * The connection's own secret is preferred over the one of the context.
+ *
+ * ssl       SSL/TLS object.
+ * secret    The secret or NULL when none set.
+ * secretSz  The size of the secret in bytes.
+ */
+static void GetCookieSecret(const WOLFSSL* ssl, const byte** secret,
+                            word32* secretSz)
+{
+    *secret   = ssl->buffers.tls13CookieSecret.buffer;
+    *secretSz = ssl->buffers.tls13CookieSecret.length;
+#ifdef WOLFSSL_STATELESS_HRR
+    if (*secret == NULL || *secretSz == 0) {
+        *secret   = ssl->ctx->hrrCookieSecret;
+        *secretSz = ssl->ctx->hrrCookieSecretSz;
+    }
+#endif
+}
+#endif
+
 #if defined(WOLFSSL_SEND_HRR_COOKIE) && !defined(NO_WOLFSSL_SERVER)
 /* Create Cookie extension using the hash of the first ClientHello.
  *
@@ -3556,13 +3585,15 @@ int CreateCookieExt(const WOLFSSL* ssl, byte* hash, word16 hashSz,
     byte cookie[OPAQUE8_LEN + WC_MAX_DIGEST_SIZE + OPAQUE16_LEN * 2];
     TLSX* ext;
     word16 cookieSz = 0;
+    const byte* secret;
+    word32 secretSz;
 
     if (hash == NULL || hashSz == 0) {
         return BAD_FUNC_ARG;
     }
 
-    if (ssl->buffers.tls13CookieSecret.buffer == NULL ||
-            ssl->buffers.tls13CookieSecret.length == 0) {
+    GetCookieSecret(ssl, &secret, &secretSz);
+    if (secret == NULL || secretSz == 0) {
         WOLFSSL_MSG("Missing DTLS 1.3 cookie secret");
         return COOKIE_ERROR;
     }
@@ -3595,9 +3626,7 @@ int CreateCookieExt(const WOLFSSL* ssl, byte* hash, word16 hashSz,
 
     ret = wc_HmacInit(&cookieHmac, ssl->heap, INVALID_DEVID);
     if (ret == 0) {
-        ret = wc_HmacSetKey(&cookieHmac, cookieType,
-                            ssl->buffers.tls13CookieSecret.buffer,
-                            ssl->buffers.tls13CookieSecret.length);
+        ret = wc_HmacSetKey(&cookieHmac, cookieType, secret, secretSz);
     }
     if (ret == 0)
         ret = wc_HmacUpdate(&cookieHmac, cookie, cookieSz);
@@ -6341,9 +6370,11 @@ int TlsCheckCookie(const WOLFSSL* ssl, const byte* cookie, word16 cookieSz)
     Hmac cookieHmac;
     byte cookieType = 0;
     byte macSz = 0;
+    const byte* secret;
+    word32 secretSz;
 
-    if (ssl->buffers.tls13CookieSecret.buffer == NULL ||
-            ssl->buffers.tls13CookieSecret.length == 0) {
+    GetCookieSecret(ssl, &secret, &secretSz);
+    if (secret == NULL || secretSz == 0) {
         WOLFSSL_MSG("Missing DTLS 1.3 cookie secret");
         return COOKIE_ERROR;
     }
@@ -6363,9 +6394,7 @@ int TlsCheckCookie(const WOLFSSL* ssl, const byte* cookie, word16 cookieSz)
 
     ret = wc_HmacInit(&cookieHmac, ssl->heap, INVALID_DEVID);
     if (ret == 0) {
-        ret = wc_HmacSetKey(&cookieHmac, cookieType,
-                            ssl->buffers.tls13CookieSecret.buffer,
-                            ssl->buffers.tls13CookieSecret.length);
+        ret = wc_HmacSetKey(&cookieHmac, cookieType, secret, secretSz);
     }
     if (ret == 0)
         ret = wc_HmacUpdate(&cookieHmac, cookie, cookieSz);
@@ -6619,6 +6648,278 @@ static int DoTls13SupportedVersions(WOLFSSL* ssl, const byte* input, word32 i,
     return 0;
 }
 
+#ifdef WOLFSSL_STATELESS_HRR
+/* Find an extension in the extensions data of a ClientHello.
+ *
+ * exts    The extensions data.
+ * extsSz  The length of the extensions data in bytes.
+ * type    The type of extension to find.
+ * data    On return, the extension data or NULL when not found.
+ * dataSz  On return, the length of the extension data in bytes.
+ * returns BUFFER_ERROR when the extensions data is badly formed and 0
+ * otherwise.
+ */
+static int FindHelloExt(const byte* exts, word16 extsSz, word16 type,
+                        const byte** data, word16* dataSz)
+{
+    word16 idx = 0;
+    word16 extType;
+    word16 extSz;
+
+    *data = NULL;
+    *dataSz = 0;
+    while (idx < extsSz) {
+        if (extsSz - idx < OPAQUE16_LEN + OPAQUE16_LEN)
+            return BUFFER_ERROR;
+        ato16(exts + idx, &extType);
+        idx += OPAQUE16_LEN;
+        ato16(exts + idx, &extSz);
+        idx += OPAQUE16_LEN;
+        if (extsSz - idx < extSz)
+            return BUFFER_ERROR;
+        if (extType == type) {
+            *data = exts + idx;
+            *dataSz = extSz;
+            break;
+        }
+        idx += extSz;
+    }
+
+    return 0;
+}
+
+/* Hash the ClientHello, with handshake header, for the Cookie.
+ *
+ * ssl      The SSL/TLS object.
+ * input    The ClientHello message.
+ * helloSz  The length of the ClientHello message.
+ * specs    The cipher specs of the cipher suite chosen.
+ * hash     The buffer to hold the hash.
+ * hashSz   On return, the size of the hash in bytes.
+ * returns 0 on success and otherwise failure.
+ */
+static int HashClientHelloStateless(const WOLFSSL* ssl, const byte* input,
+    word32 helloSz, CipherSpecs* specs, byte* hash, int* hashSz)
+{
+    byte header[HANDSHAKE_HEADER_SZ];
+    int ret;
+    wc_HashAlg hashCtx;
+    int type = wolfSSL_GetHmacType_ex(specs);
+
+    header[0] = (byte)client_hello;
+    c32to24(helloSz, header + 1);
+
+    ret = wc_HashInit_ex(&hashCtx, type, ssl->heap, ssl->devId);
+    if (ret == 0) {
+        ret = wc_HashUpdate(&hashCtx, type, header, HANDSHAKE_HEADER_SZ);
+        if (ret == 0)
+            ret = wc_HashUpdate(&hashCtx, type, input, helloSz);
+        if (ret == 0)
+            ret = wc_HashFinal(&hashCtx, type, hash);
+        if (ret == 0) {
+            *hashSz = wc_HashGetDigestSize(type);
+            if (*hashSz < 0)
+                ret = *hashSz;
+        }
+        wc_HashFree(&hashCtx, type);
+    }
+    return ret;
+}
+
+/* Handle the first ClientHello without keeping any state when a
+ * HelloRetryRequest is needed.
+ * The fields of the ClientHello are only referenced and the extensions needed
+ * to choose a cipher suite and group are parsed into a temporary list. When
+ * none of the client's key shares can be used, a HelloRetryRequest with a
+ * Cookie holding the hash of the ClientHello is sent and nothing is kept from
+ * the ClientHello - not even the handshake hash. The second ClientHello
+ * restores the handshake hash from the Cookie.
+ * ClientHellos that don't need a HelloRetryRequest, that have a pre-shared
+ * key or that can't be understood here are left for DoTls13ClientHello().
+ *
+ * ssl      The SSL/TLS object.
+ * input    The ClientHello message.
+ * helloSz  The length of the ClientHello message.
+ * hrrSent  On return, 1 when a HelloRetryRequest was sent and 0 otherwise.
+ * returns 0 on success and otherwise failure.
+ */
+static int DoTls13ClientHelloStateless(WOLFSSL* ssl, const byte* input,
+                                       word32 helloSz, int* hrrSent)
+{
+    int             ret = 0;
+    word32          idx = OPAQUE16_LEN + RAN_LEN;
+    byte            sessIdSz;
+    const byte*     sessId;
+    word16          suitesSz;
+    const byte*     exts;
+    word16          extsSz;
+    const byte*     data;
+    word16          dataSz;
+    ProtocolVersion pv;
+    Suites          suites;
+    CipherSuite     cs;
+    CipherSpecs     specs;
+    TLSX*           parsedExts = NULL;
+    byte            hash[WC_MAX_DIGEST_SIZE];
+    int             hashSz = 0;
+
+    *hrrSent = 0;
+
+#ifdef HAVE_ECH
+    if (ssl->ctx->echConfigs != NULL)
+        return 0;
+#endif
+
+    /* Session id, cipher suites, compression methods and extensions. */
+    if (idx + OPAQUE8_LEN > helloSz)
+        return 0;
+    sessIdSz = input[idx++];
+    if (sessIdSz > ID_LEN || idx + sessIdSz + OPAQUE16_LEN > helloSz)
+        return 0;
+    sessId = input + idx;
+    idx += sessIdSz;
+    ato16(input + idx, &suitesSz);
+    idx += OPAQUE16_LEN;
+    if (suitesSz > WOLFSSL_MAX_SUITE_SZ || (suitesSz % 2) != 0 ||
+            idx + suitesSz + OPAQUE8_LEN > helloSz)
+        return 0;
+    XMEMSET(&suites, 0, sizeof(suites));
+    suites.suiteSz = suitesSz;
+    XMEMCPY(suites.suites, input + idx, suitesSz);
+    idx += suitesSz;
+    idx += OPAQUE8_LEN + input[idx];
+    if (idx + OPAQUE16_LEN > helloSz)
+        return 0;
+    ato16(input + idx, &extsSz);
+    idx += OPAQUE16_LEN;
+    if (idx + extsSz != helloSz)
+        return 0;
+    exts = input + idx;
+
+    /* Only TLS v1.3 and no resumption. */
+#if defined(HAVE_SESSION_TICKET) || !defined(NO_PSK)
+    if (FindHelloExt(exts, extsSz, TLSX_PRE_SHARED_KEY, &data, &dataSz) != 0 ||
+            data != NULL) {
+        return 0;
+    }
+#endif
+    if (FindHelloExt(exts, extsSz, TLSX_SUPPORTED_VERSIONS, &data,
+            &dataSz) != 0 || data == NULL) {
+        return 0;
+    }
+    pv = ssl->version;
+    if (TLSX_SupportedVersions_Parse(ssl, data, dataSz, client_hello, &pv,
+            NULL, NULL) != 0 || !IsAtLeastTLSv1_3(pv)) {
+        return 0;
+    }
+
+#ifndef NO_CERTS
+    if (FindHelloExt(exts, extsSz, TLSX_SIGNATURE_ALGORITHMS, &data,
+            &dataSz) != 0 || data == NULL || dataSz < OPAQUE16_LEN) {
+        return 0;
+    }
+    ato16(data, &suites.hashSigAlgoSz);
+    if (suites.hashSigAlgoSz != dataSz - OPAQUE16_LEN ||
+            suites.hashSigAlgoSz > WOLFSSL_MAX_SIGALGO ||
+            (suites.hashSigAlgoSz % 2) != 0) {
+        return 0;
+    }
+    XMEMCPY(suites.hashSigAlgo, data + OPAQUE16_LEN, suites.hashSigAlgoSz);
+#endif
+
+    /* Supported versions has to be before the key share as that is the order
+     * RestartHandshakeHashWithCookie() reconstructs it in. */
+    ret = TLSX_Push(&parsedExts, TLSX_SUPPORTED_VERSIONS, ssl, ssl->heap);
+    if (ret != 0)
+        goto exit_dchs;
+    parsedExts->resp = 1;
+    ret = TLSX_SupportedCurve_Copy(ssl->extensions, &parsedExts, ssl->heap);
+    if (ret != 0)
+        goto exit_dchs;
+
+    if (FindHelloExt(exts, extsSz, TLSX_SUPPORTED_GROUPS, &data,
+            &dataSz) != 0 || data == NULL) {
+        goto exit_dchs;
+    }
+    ret = TLSX_SupportedCurve_Parse(ssl, data, dataSz, 1, &parsedExts);
+    if (ret != 0)
+        goto exit_dchs;
+    if (FindHelloExt(exts, extsSz, TLSX_KEY_SHARE, &data, &dataSz) != 0 ||
+            data == NULL) {
+        goto exit_dchs;
+    }
+    ret = TLSX_KeyShare_Parse_ClientHello(ssl, data, dataSz, &parsedExts);
+    if (ret != 0)
+        goto exit_dchs;
+
+    /* TLSX_KeyShare_Choose is done deep inside MatchSuite_ex */
+    XMEMSET(&cs, 0, sizeof(cs));
+    if (MatchSuite_ex(ssl, &suites, &cs, parsedExts) < 0 || !cs.doHelloRetry)
+        goto exit_dchs;
+
+    ret = TLSX_KeyShare_SetSupported(ssl, &parsedExts);
+    if (ret == 0) {
+        ret = GetCipherSpec(WOLFSSL_SERVER_END, cs.cipherSuite0,
+                            cs.cipherSuite, &specs, NULL);
+    }
+    if (ret == 0) {
+        ret = HashClientHelloStateless(ssl, input, helloSz, &specs, hash,
+                                       &hashSz);
+    }
+    if (ret == 0) {
+        ret = CreateCookieExt(ssl, hash, (word16)hashSz, &parsedExts,
+                              cs.cipherSuite0, cs.cipherSuite);
+    }
+    if (ret == 0) {
+        TLSX* sslExts = ssl->extensions;
+        byte  sslSessIdSz = ssl->session->sessionIDSz;
+        byte  cipherSuite0 = ssl->options.cipherSuite0;
+        byte  cipherSuite = ssl->options.cipherSuite;
+
+        /* A HelloRetryRequest commits the server to TLS v1.3. */
+        ssl->options.tls1_3 = 1;
+
+        XMEMCPY(ssl->session->sessionID, sessId, sessIdSz);
+        ssl->session->sessionIDSz = sessIdSz;
+        ssl->options.cipherSuite0 = cs.cipherSuite0;
+        ssl->options.cipherSuite = cs.cipherSuite;
+        ssl->extensions = parsedExts;
+        ssl->options.sendingStatelessHrr = 1;
+
+        ret = SendTls13ServerHello(ssl, hello_retry_request);
+
+        /* Can be modified inside SendTls13ServerHello */
+        parsedExts = ssl->extensions;
+
+        ssl->options.sendingStatelessHrr = 0;
+        ssl->extensions = sslExts;
+        ssl->options.cipherSuite = cipherSuite;
+        ssl->options.cipherSuite0 = cipherSuite0;
+        ssl->session->sessionIDSz = sslSessIdSz;
+    }
+#ifdef WOLFSSL_TLS13_MIDDLEBOX_COMPAT
+    if ((ret == 0 || ret == WANT_WRITE) && ssl->options.tls13MiddleBoxCompat) {
+        ret = SendChangeCipher(ssl);
+        if (ret == 0 || ret == WANT_WRITE)
+            ssl->options.sentChangeCipher = 1;
+    }
+#endif
+    /* Anything left in the output buffer is sent by wolfSSL_accept_TLSv13. */
+    if (ret == WANT_WRITE)
+        ret = 0;
+    if (ret == 0) {
+        ssl->options.serverState = SERVER_HELLO_RETRY_REQUEST_COMPLETE;
+        /* Restarted from the Cookie of the second ClientHello. */
+        FreeHandshakeHashes(ssl);
+        *hrrSent = 1;
+    }
+
+exit_dchs:
+    TLSX_FreeAll(parsedExts, ssl->heap);
+    return ret;
+}
+#endif /* WOLFSSL_STATELESS_HRR */
+
 /* Handle a ClientHello handshake message.
  * If the protocol version in the message is not TLS v1.3 or higher, use
  * DoClientHello()
@@ -6740,6 +7041,20 @@ int DoTls13ClientHello(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
     ssl->options.dtlsStateful = 1;
 #endif /* WOLFSSL_DTLS */
 
+#ifdef WOLFSSL_STATELESS_HRR
+    if (ssl->options.statelessHrr && !ssl->options.dtls &&
+            ssl->options.serverState != SERVER_HELLO_RETRY_REQUEST_COMPLETE) {
+        int hrrSent = 0;
+
+        ret = DoTls13ClientHelloStateless(ssl, input + *inOutIdx, helloSz,
+                                          &hrrSent);
+        if (ret != 0 || hrrSent) {
+            *inOutIdx += helloSz;
+            goto exit_dch;
+        }
+    }
+#endif
+
     args->idx = *inOutIdx;
     args->begin = args->idx;
 
@@ -7160,7 +7475,12 @@ int DoTls13ClientHello(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
 #ifdef WOLFSSL_SEND_HRR_COOKIE
     if (ret == 0 && ssl->options.sendCookie) {
         if (ssl->options.cookieGood &&
-                ssl->options.acceptState == TLS13_ACCEPT_FIRST_REPLY_DONE) {
+                (ssl->options.acceptState == TLS13_ACCEPT_FIRST_REPLY_DONE
+#ifdef WOLFSSL_STATELESS_HRR
+                 /* HRR was sent while reading the first ClientHello. */
+                 || ssl->options.statelessHrr
+#endif
+                )) {
             /* Processing second ClientHello. Clear HRR state. */
             ssl->options.serverState = NULL_STATE;
         }
@@ -7183,7 +7503,12 @@ int DoTls13ClientHello(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
 #endif
         /* Send a cookie */
         if (!ssl->options.cookieGood &&
-            ssl->options.serverState != SERVER_HELLO_RETRY_REQUEST_COMPLETE) {
+            ssl->options.serverState != SERVER_HELLO_RETRY_REQUEST_COMPLETE
+#ifdef WOLFSSL_STATELESS_HRR
+            /* Only HRR when the key share needs it. */
+            && !ssl->options.statelessHrr
+#endif
+            ) {
 #ifdef WOLFSSL_DTLS13
             if (ssl->options.dtls) {
 #ifdef WOLFSSL_DTLS13_NO_HRR_ON_RESUME
@@ -7277,6 +7602,9 @@ int SendTls13ServerHello(WOLFSSL* ssl, byte extMsgType)
     if (extMsgType == hello_retry_request
 #ifdef WOLFSSL_DTLS13
             && (!ssl->options.dtls || ssl->options.dtlsStateful)
+#endif
+#ifdef WOLFSSL_STATELESS_HRR
+            && !ssl->options.sendingStatelessHrr
 #endif
             ) {
         WOLFSSL_MSG("wolfSSL Sending HelloRetryRequest");
@@ -7370,6 +7698,12 @@ int SendTls13ServerHello(WOLFSSL* ssl, byte extMsgType)
         if (ssl->options.dtls && !ssl->options.dtlsStateful)
             ret = 0;
         else
+#endif
+#ifdef WOLFSSL_STATELESS_HRR
+        /* Cookie calculated in DoTls13ClientHelloStateless */
+        if (ssl->options.sendingStatelessHrr)
+            ret = 0;
+        else
 #endif
             ret = InitHandshakeHashes(ssl);
     }
@@ -8355,6 +8689,123 @@ static word32 AddCertExt(WOLFSSL* ssl, byte* cert, word32 len, word16 extSz,
     return i;
 }
 
+#ifdef WOLFSSL_CERT_MSG_CACHE
+/* Encode the body of the Certificate message for the certificate and chain of
+ * the CTX, each certificate with empty extensions.
+ *
+ * ctx    SSL/TLS CTX object.
+ * msg    The encoded body.
+ * msgSz  The length of the encoded body.
+ * returns 0 on success, otherwise failure.
+ */
+static int CertMsgEncode(WOLFSSL_CTX* ctx, byte** msg, word32* msgSz)
+{
+    DerBuffer* cert = ctx->certificate;
+    byte*  chain = NULL;
+    word32 chainSz = 0;
+    word32 listSz;
+    word32 cnt = 0;
+    word32 idx = 0;
+    word32 len;
+    word32 i = 0;
+    byte*  out;
+
+    if (cert == NULL || cert->length == 0)
+        return BUFFER_E;
+    if (ctx->certChain != NULL) {
+        chain = ctx->certChain->buffer;
+        chainSz = ctx->certChain->length;
+    }
+
+    /* Chain certificates have leading lengths already. */
+    while (idx + CERT_HEADER_SZ <= chainSz) {
+        if (NextCert(chain, chainSz, &idx) == 0 || idx > chainSz)
+            return BUFFER_E;
+        cnt++;
+    }
+    if (idx != chainSz)
+        return BUFFER_E;
+
+    listSz = CERT_HEADER_SZ + cert->length + OPAQUE16_LEN + chainSz +
+             cnt * OPAQUE16_LEN;
+    *msgSz = OPAQUE8_LEN + CERT_HEADER_SZ + listSz;
+    out = (byte*)XMALLOC(*msgSz, ctx->heap, DYNAMIC_TYPE_CERT_MSG);
+    if (out == NULL)
+        return MEMORY_E;
+
+    /* Empty request context. */
+    out[i++] = 0;
+    c32to24(listSz, out + i);
+    i += CERT_HEADER_SZ;
+    c32to24(cert->length, out + i);
+    i += CERT_HEADER_SZ;
+    XMEMCPY(out + i, cert->buffer, cert->length);
+    i += cert->length;
+    c16toa(0, out + i);
+    i += OPAQUE16_LEN;
+
+    idx = 0;
+    while ((len = NextCert(chain, chainSz, &idx)) != 0) {
+        XMEMCPY(out + i, chain + idx - len, len);
+        i += len;
+        c16toa(0, out + i);
+        i += OPAQUE16_LEN;
+    }
+
+    *msg = out;
+    return 0;
+}
+
+/* Get the body of the Certificate message encoded for the certificate and
+ * chain of the CTX, encoding it again when they have changed.
+ *
+ * Only for connections sending the certificates of the CTX. As with the
+ * certificates themselves, the CTX's certificates must not be changed while
+ * its connections are handshaking.
+ *
+ * ssl    SSL/TLS object.
+ * msgSz  The length of the body.
+ * returns the body or NULL when the message is to be built.
+ */
+static const byte* CertMsgCacheGet(WOLFSSL* ssl, word32* msgSz)
+{
+    WOLFSSL_CTX* ctx = ssl->ctx;
+    CertMsgCache* cache = &ctx->certMsgCache;
+    const byte* msg = NULL;
+    byte* newMsg;
+    word32 newSz;
+
+    if (cache->off || ctx->certificate == NULL ||
+            ssl->buffers.certificate != ctx->certificate ||
+            ssl->buffers.certChain != ctx->certChain) {
+        return NULL;
+    }
+
+#ifndef SINGLE_THREADED
+    if (wc_LockMutex(&cache->lock) != 0)
+        return NULL;
+#endif
+    if (cache->msg == NULL || cache->msgGen != cache->certGen) {
+        XFREE(cache->msg, ctx->heap, DYNAMIC_TYPE_CERT_MSG);
+        cache->msg = NULL;
+        if (CertMsgEncode(ctx, &newMsg, &newSz) == 0) {
+            cache->msg = newMsg;
+            cache->msgSz = newSz;
+            cache->msgGen = cache->certGen;
+        }
+    }
+    if (cache->msg != NULL) {
+        msg = cache->msg;
+        *msgSz = cache->msgSz;
+    }
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&cache->lock);
+#endif
+
+    return msg;
+}
+#endif /* WOLFSSL_CERT_MSG_CACHE */
+
 /* handle generation TLS v1.3 certificate (11) */
 /* Send the certificate for this end and any CAs that help with validation.
  * This message is always encrypted in TLS v1.3.
@@ -8376,6 +8827,10 @@ static int SendTls13Certificate(WOLFSSL* ssl)
 #ifdef WOLFSSL_POST_HANDSHAKE_AUTH
     byte*  certReqCtx = NULL;
 #endif
+#ifdef WOLFSSL_CERT_MSG_CACHE
+    const byte* certMsg = NULL;
+    word32 certMsgSz = 0;
+#endif
 
 #ifdef OPENSSL_EXTRA
     WOLFSSL_X509* x509 = NULL;
@@ -8465,6 +8920,17 @@ static int SendTls13Certificate(WOLFSSL* ssl)
 
     payloadSz = length;
 
+#ifdef WOLFSSL_CERT_MSG_CACHE
+    /* Nothing is specific to the connection - copy the body encoded for the
+     * CTX. */
+    if (ssl->options.side == WOLFSSL_SERVER_END && ssl->fragOffset == 0 &&
+            certSz > 0 && extSz == OPAQUE16_LEN && certReqCtxLen == 0) {
+        certMsg = CertMsgCacheGet(ssl, &certMsgSz);
+        if (certMsg != NULL && certMsgSz != payloadSz)
+            certMsg = NULL;
+    }
+#endif
+
     if (ssl->fragOffset != 0)
         length -= (ssl->fragOffset + headerSz);
 
@@ -8551,6 +9017,17 @@ static int SendTls13Certificate(WOLFSSL* ssl)
         else
             AddTls13RecordHeader(output, fragSz, handshake, ssl);
 
+    #ifdef WOLFSSL_CERT_MSG_CACHE
+        if (certMsg != NULL && ssl->fragOffset == 0 &&
+                fragSz == payloadSz - headerSz) {
+            /* All certificates with their extensions in this fragment. */
+            XMEMCPY(output + i, certMsg + headerSz, fragSz);
+            i += fragSz;
+            ssl->fragOffset += fragSz;
+            length -= fragSz;
+            fragSz = 0;
+        }
+    #endif
         if (certSz > 0 && ssl->fragOffset < certSz + extSz) {
             /* Put in the leaf certificate with extensions. */
             word32 copySz = AddCertExt(ssl, ssl->buffers.certificate->buffer,
@@ -12006,6 +12483,17 @@ int DoTls13HandShakeMsgType(WOLFSSL* ssl, byte* input, word32* inOutIdx,
     if (*inOutIdx + size > totalSz)
         return INCOMPLETE_DATA;
 
+#ifdef WOLFSSL_SESSION_STORE
+    if (type == client_hello) {
+        /* Session lookup may be pending - process message again. */
+        ret = SessionStorePrefetch(ssl, input + *inOutIdx, size);
+        if (ret == WANT_READ)
+            *inOutIdx -= HANDSHAKE_HEADER_SZ;
+        if (ret != 0)
+            return ret;
+    }
+#endif
+
     /* sanity check msg received */
     if ((ret = SanityCheckTls13MsgReceived(ssl, type)) != 0) {
         WOLFSSL_MSG("Sanity Check on handshake message type received failed");
@@ -13002,6 +13490,89 @@ int wolfSSL_disable_hrr_cookie(WOLFSSL* ssl)
 
 #endif /* defined(WOLFSSL_SEND_HRR_COOKIE) */
 
+/* Send a HelloRetryRequest without keeping any state of the first ClientHello
+ * on all new connections of the context.
+ * The Cookie in the HelloRetryRequest is protected with a secret shared by all
+ * connections. Call before creating the connections.
+ *
+ * ctx       SSL/TLS context.
+ * secret    Secret to use when generating integrity check for cookie.
+ *           A value of NULL indicates to generate a new random secret.
+ * secretSz  Size of secret data in bytes.
+ *           Use a value of 0 to indicate use of default size.
+ * returns BAD_FUNC_ARG when ctx is NULL or not using TLS v1.3, SIDE_ERROR when
+ * called on a client; WOLFSSL_SUCCESS on success and otherwise failure.
+ */
+int wolfSSL_CTX_set_stateless_hrr(WOLFSSL_CTX* ctx,
+    const unsigned char* secret, unsigned int secretSz)
+{
+    int ret = 0;
+#if defined(WOLFSSL_STATELESS_HRR) && !defined(NO_WOLFSSL_SERVER)
+    byte* newSecret;
+#endif
+
+    if (ctx == NULL || !IsAtLeastTLSv1_3(ctx->method->version))
+        return BAD_FUNC_ARG;
+#ifndef WOLFSSL_STATELESS_HRR
+    (void)secret;
+    (void)secretSz;
+
+    ret = NOT_COMPILED_IN;
+#elif !defined(NO_WOLFSSL_SERVER)
+    if (ctx->method->side == WOLFSSL_CLIENT_END)
+        return SIDE_ERROR;
+
+    if (secretSz == 0) {
+    #if !defined(NO_SHA) && defined(NO_SHA256)
+        secretSz = WC_SHA_DIGEST_SIZE;
+    #endif /* NO_SHA */
+    #ifndef NO_SHA256
+        secretSz = WC_SHA256_DIGEST_SIZE;
+    #endif /* NO_SHA256 */
+    }
+
+    newSecret = (byte*)XMALLOC(secretSz, ctx->heap, DYNAMIC_TYPE_COOKIE_PWD);
+    if (newSecret == NULL) {
+        WOLFSSL_MSG("couldn't allocate new cookie secret");
+        return MEMORY_ERROR;
+    }
+
+    /* If the supplied secret is NULL, randomly generate a new secret. */
+    if (secret == NULL) {
+        WC_RNG rng;
+
+        ret = wc_InitRng_ex(&rng, ctx->heap, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_RNG_GenerateBlock(&rng, newSecret, secretSz);
+            wc_FreeRng(&rng);
+        }
+    }
+    else
+        XMEMCPY(newSecret, secret, secretSz);
+    if (ret != 0) {
+        ForceZero(newSecret, secretSz);
+        XFREE(newSecret, ctx->heap, DYNAMIC_TYPE_COOKIE_PWD);
+        return ret;
+    }
+
+    if (ctx->hrrCookieSecret != NULL) {
+        ForceZero(ctx->hrrCookieSecret, ctx->hrrCookieSecretSz);
+        XFREE(ctx->hrrCookieSecret, ctx->heap, DYNAMIC_TYPE_COOKIE_PWD);
+    }
+    ctx->hrrCookieSecret = newSecret;
+    ctx->hrrCookieSecretSz = secretSz;
+
+    ret = WOLFSSL_SUCCESS;
+#else
+    (void)secret;
+    (void)secretSz;
+
+    ret = SIDE_ERROR;
+#endif
+
+    return ret;
+}
+
 #ifdef HAVE_SUPPORTED_CURVES
 /* Create a key share entry from group.
  * Generates a key pair.
@@ -13880,6 +14451,14 @@ int wolfSSL_accept_TLSv13(WOLFSSL* ssl)
                 }
 #endif /* WOLFSSL_DTLS13 */
 
+#ifdef WOLFSSL_STATELESS_HRR
+                /* Finish sending a HelloRetryRequest made without state. */
+                if (ssl->buffers.outputBuffer.length > 0 &&
+                        (ssl->error = SendBuffered(ssl)) < 0) {
+                    WOLFSSL_ERROR(ssl->error);
+                    return WOLFSSL_FATAL_ERROR;
+                }
+#endif
             }
 
             ssl->options.acceptState = TLS13_ACCEPT_CLIENT_HELLO_DONE;
@@ -14113,6 +14692,14 @@ int wolfSSL_accept_TLSv13(WOLFSSL* ssl)
                 return WOLFSSL_FATAL_ERROR;
             }
 #ifdef HAVE_SESSION_TICKET
+    #ifdef WOLFSSL_TICKET_ENC_BATCH
+            /* Set up the ticket cipher once when sending more than one. */
+            if (!ssl->options.resuming &&
+                    ssl->options.ticketsSent + 1 <
+                                                ssl->options.maxTicketTls13) {
+                ssl->options.ticketEncBatch = 1;
+            }
+    #endif
             while (ssl->options.ticketsSent < ssl->options.maxTicketTls13) {
                 if (!ssl->options.noTicketTls13 && ssl->ctx->ticketEncCb
                         != NULL) {
@@ -14128,6 +14715,9 @@ int wolfSSL_accept_TLSv13(WOLFSSL* ssl)
                     break;
                 }
             }
+    #ifdef WOLFSSL_TICKET_ENC_BATCH
+            FreeTicketEncBatch(ssl);
+    #endif
 #endif /* HAVE_SESSION_TICKET */
             ssl->options.acceptState = TLS13_TICKET_SENT;
             WOLFSSL_MSG("accept state TICKET_SENT");
@@ -398,6 +398,992 @@ int EmbedSend(WOLFSSL* ssl, char *buf, int sz, void *ctx)
 }
 
 
+#ifdef WOLFSSL_KTLS
+
+#include <netinet/tcp.h>
+#include <linux/tls.h>
+#include <sys/sendfile.h>
+#ifdef NO_INLINE
+    #include <wolfssl/wolfcrypt/misc.h>
+#else
+    #define WOLFSSL_MISC_INCLUDED
+    #include <wolfcrypt/src/misc.c>
+#endif
+
+#ifndef SOL_TLS
+    #define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+    #define TCP_ULP 31
+#endif
+
+/* kernel crypto_info for each cipher we offload */
+typedef union KtlsCryptoInfo {
+    struct tls_crypto_info                     info;
+    struct tls12_crypto_info_aes_gcm_128       gcm128;
+#ifdef TLS_CIPHER_AES_GCM_256
+    struct tls12_crypto_info_aes_gcm_256       gcm256;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    struct tls12_crypto_info_chacha20_poly1305 chacha;
+#endif
+} KtlsCryptoInfo;
+
+/* Attach the kernel TLS upper layer protocol to the connection's socket.
+ * The socket keeps working as plain TCP until keys are set on it.
+ *  return : 0 on success, or SOCKET_ERROR_E when kTLS is unavailable */
+int KtlsInit(WOLFSSL* ssl)
+{
+    if (setsockopt(ssl->wfd, IPPROTO_TCP, TCP_ULP, "tls",
+                   sizeof("tls")) != 0) {
+        WOLFSSL_MSG("kTLS upper layer protocol not available");
+        return SOCKET_ERROR_E;
+    }
+
+    return 0;
+}
+
+/* Hand the current transmit (tx set) or receive keys, implicit IV and record
+ * sequence number to the kernel. Called when a direction is first offloaded
+ * and again after each TLS v1.3 KeyUpdate.
+ *  return : 0 on success, NOT_COMPILED_IN for ciphers the kernel headers
+ *           don't know, or SOCKET_ERROR_E when the kernel refuses the keys */
+int KtlsSetKeys(WOLFSSL* ssl, int tx)
+{
+    KtlsCryptoInfo ci;
+    socklen_t      ciSz = 0;
+    const byte*    key;
+    const byte*    iv;
+    byte           seq[TLS_CIPHER_AES_GCM_128_REC_SEQ_SIZE];
+    word32         seqHi, seqLo;
+    int            i;
+    int            ret = 0;
+
+    if ((ssl->options.side == WOLFSSL_CLIENT_END) == (tx != 0))
+        key = ssl->keys.client_write_key;
+    else
+        key = ssl->keys.server_write_key;
+    iv = tx ? ssl->keys.aead_enc_imp_IV : ssl->keys.aead_dec_imp_IV;
+    seqHi = tx ? ssl->keys.sequence_number_hi :
+                 ssl->keys.peer_sequence_number_hi;
+    seqLo = tx ? ssl->keys.sequence_number_lo :
+                 ssl->keys.peer_sequence_number_lo;
+    for (i = 0; i < 4; i++) {
+        seq[i]     = (byte)(seqHi >> (24 - 8 * i));
+        seq[i + 4] = (byte)(seqLo >> (24 - 8 * i));
+    }
+
+    XMEMSET(&ci, 0, sizeof(ci));
+    ci.info.version = ssl->options.tls1_3 ? TLS_1_3_VERSION : TLS_1_2_VERSION;
+
+    /* TLS v1.2 GCM puts an explicit nonce on each record, any value unique
+     * under the key will do. The kernel counts up from the one given, so
+     * start at the record sequence number like the TLS v1.3 nonce does. */
+    switch (ssl->specs.bulk_cipher_algorithm) {
+        case wolfssl_aes_gcm:
+            if (ssl->specs.key_size == TLS_CIPHER_AES_GCM_128_KEY_SIZE) {
+                ci.gcm128.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+                XMEMCPY(ci.gcm128.key, key, TLS_CIPHER_AES_GCM_128_KEY_SIZE);
+                XMEMCPY(ci.gcm128.salt, iv, TLS_CIPHER_AES_GCM_128_SALT_SIZE);
+                XMEMCPY(ci.gcm128.iv, ssl->options.tls1_3 ?
+                        iv + TLS_CIPHER_AES_GCM_128_SALT_SIZE : seq,
+                        TLS_CIPHER_AES_GCM_128_IV_SIZE);
+                XMEMCPY(ci.gcm128.rec_seq, seq, sizeof(seq));
+                ciSz = sizeof(ci.gcm128);
+            }
+        #ifdef TLS_CIPHER_AES_GCM_256
+            else if (ssl->specs.key_size == TLS_CIPHER_AES_GCM_256_KEY_SIZE) {
+                ci.gcm256.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+                XMEMCPY(ci.gcm256.key, key, TLS_CIPHER_AES_GCM_256_KEY_SIZE);
+                XMEMCPY(ci.gcm256.salt, iv, TLS_CIPHER_AES_GCM_256_SALT_SIZE);
+                XMEMCPY(ci.gcm256.iv, ssl->options.tls1_3 ?
+                        iv + TLS_CIPHER_AES_GCM_256_SALT_SIZE : seq,
+                        TLS_CIPHER_AES_GCM_256_IV_SIZE);
+                XMEMCPY(ci.gcm256.rec_seq, seq, sizeof(seq));
+                ciSz = sizeof(ci.gcm256);
+            }
+        #endif
+            else {
+                ret = NOT_COMPILED_IN;
+            }
+            break;
+    #ifdef TLS_CIPHER_CHACHA20_POLY1305
+        case wolfssl_chacha:
+        #ifdef HAVE_POLY1305
+            if (ssl->options.oldPoly) {
+                ret = NOT_COMPILED_IN;
+                break;
+            }
+        #endif
+            ci.chacha.info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+            XMEMCPY(ci.chacha.key, key, TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE);
+            XMEMCPY(ci.chacha.iv, iv, TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE);
+            XMEMCPY(ci.chacha.rec_seq, seq, sizeof(seq));
+            ciSz = sizeof(ci.chacha);
+            break;
+    #endif
+        default:
+            ret = NOT_COMPILED_IN;
+            break;
+    }
+
+    if (ret == 0 && setsockopt(ssl->wfd, SOL_TLS, tx ? TLS_TX : TLS_RX, &ci,
+                               ciSz) != 0) {
+        WOLFSSL_MSG("kTLS setting keys failed");
+        ret = SOCKET_ERROR_E;
+    }
+
+    ForceZero(&ci, sizeof(ci));
+    return ret;
+}
+
+/* The send callback used once the kernel encrypts. buf holds plaintext
+ * records as built by BuildMessage(), the kernel frames them again so only
+ * the record bodies are sent. Consecutive application data records go out
+ * in one sendmsg(), other content types one record at a time with their
+ * type in a control message. On a partial send the record header is
+ * rewritten in front of the unsent part of the body.
+ *  return : nb bytes of buf consumed, or error */
+int KtlsSend(WOLFSSL* ssl, byte* buf, int sz)
+{
+    struct msghdr   msg;
+    struct iovec    iov[WOLFSSL_MAX_SEND_BATCH];
+    byte            cbuf[CMSG_SPACE(sizeof(byte))];
+    struct cmsghdr* cmsg;
+    byte            type;
+    int             iovcnt = 0;
+    int             idx = 0;
+    int             sent;
+    int             i;
+
+    if (sz < RECORD_HEADER_SZ)
+        return WOLFSSL_CBIO_ERR_GENERAL;
+
+    type = buf[0];
+    while (iovcnt < WOLFSSL_MAX_SEND_BATCH &&
+           idx + RECORD_HEADER_SZ <= sz && buf[idx] == type) {
+        int len = (buf[idx + 3] << 8) | buf[idx + 4];
+
+        if (idx + RECORD_HEADER_SZ + len > sz) {
+            WOLFSSL_MSG("kTLS send of partial record");
+            return WOLFSSL_CBIO_ERR_GENERAL;
+        }
+        iov[iovcnt].iov_base = buf + idx + RECORD_HEADER_SZ;
+        iov[iovcnt].iov_len  = (size_t)len;
+        iovcnt++;
+        idx += RECORD_HEADER_SZ + len;
+        if (type != application_data)
+            break;
+    }
+
+    XMEMSET(&msg, 0, sizeof(msg));
+    msg.msg_iov    = iov;
+    msg.msg_iovlen = (size_t)iovcnt;
+    if (type != application_data) {
+        msg.msg_control    = cbuf;
+        msg.msg_controllen = sizeof(cbuf);
+        cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_TLS;
+        cmsg->cmsg_type  = TLS_SET_RECORD_TYPE;
+        cmsg->cmsg_len   = CMSG_LEN(sizeof(byte));
+        *CMSG_DATA(cmsg) = type;
+    }
+
+    sent = (int)sendmsg(ssl->wfd, &msg, ssl->wflags);
+    if (sent < 0) {
+        WOLFSSL_MSG("kTLS send error");
+        return TranslateIoError(sent);
+    }
+
+    /* map the body bytes sent back onto buf */
+    idx = 0;
+    for (i = 0; i < iovcnt; i++) {
+        int len = (int)iov[i].iov_len;
+
+        if (sent < len) {
+            if (sent > 0) {
+                byte* hdr = buf + idx + sent;
+                byte  pvMajor = buf[idx + 1];
+                byte  pvMinor = buf[idx + 2];
+
+                len -= sent;
+                idx += sent;
+                hdr[0] = type;
+                hdr[1] = pvMajor;
+                hdr[2] = pvMinor;
+                hdr[3] = (byte)(len >> 8);
+                hdr[4] = (byte)len;
+            }
+            break;
+        }
+        sent -= len;
+        idx  += RECORD_HEADER_SZ + len;
+    }
+
+    return idx;
+}
+
+/* The receive callback used once the kernel decrypts. Reads the next run of
+ * plaintext, at most one record's worth, and puts a record header with the
+ * content type the kernel reports in front of it so ProcessReply() handles
+ * it like any other record.
+ *  return : nb bytes placed in buf including the header, or error */
+int KtlsReceive(WOLFSSL* ssl, byte* buf, int sz)
+{
+    struct msghdr   msg;
+    struct iovec    iov;
+    byte            cbuf[CMSG_SPACE(sizeof(byte))];
+    struct cmsghdr* cmsg;
+    byte            type = application_data;
+    int             recvd;
+
+    if (sz <= RECORD_HEADER_SZ)
+        return WOLFSSL_CBIO_ERR_GENERAL;
+    if (sz > RECORD_HEADER_SZ + MAX_RECORD_SIZE)
+        sz = RECORD_HEADER_SZ + MAX_RECORD_SIZE;
+
+    iov.iov_base = buf + RECORD_HEADER_SZ;
+    iov.iov_len  = (size_t)(sz - RECORD_HEADER_SZ);
+    XMEMSET(&msg, 0, sizeof(msg));
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = cbuf;
+    msg.msg_controllen = sizeof(cbuf);
+
+    recvd = (int)recvmsg(ssl->rfd, &msg, ssl->rflags);
+    if (recvd < 0) {
+        WOLFSSL_MSG("kTLS receive error");
+        return TranslateIoError(recvd);
+    }
+    else if (recvd == 0) {
+        WOLFSSL_MSG("kTLS receive connection closed");
+        return WOLFSSL_CBIO_ERR_CONN_CLOSE;
+    }
+
+    cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg != NULL && cmsg->cmsg_level == SOL_TLS &&
+            cmsg->cmsg_type == TLS_GET_RECORD_TYPE) {
+        type = *CMSG_DATA(cmsg);
+    }
+
+    buf[0] = type;
+    buf[1] = ssl->version.major;
+    buf[2] = ssl->version.minor;
+    buf[3] = (byte)(recvd >> 8);
+    buf[4] = (byte)recvd;
+
+    return recvd + RECORD_HEADER_SZ;
+}
+
+/* Send sz bytes of file fd from *offset with sendfile(2), the kernel
+ * encrypts the pages on their way to the socket.
+ *  return : nb bytes sent, or error */
+int KtlsSendFile(WOLFSSL* ssl, int fd, off_t* offset, int sz)
+{
+    int sent;
+
+    sent = (int)sendfile(ssl->wfd, fd, offset, (size_t)sz);
+    if (sent < 0) {
+        WOLFSSL_MSG("kTLS sendfile error");
+        return TranslateIoError(sent);
+    }
+
+    return sent;
+}
+
+#endif /* WOLFSSL_KTLS */
+
+
+#ifdef WOLFSSL_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <poll.h>
+
+/* Size of each connection's receive and send area. One full record fits. */
+#ifndef WOLFSSL_URING_BUF_SZ
+    #define WOLFSSL_URING_BUF_SZ (RECORD_HEADER_SZ + MAX_RECORD_SIZE + \
+                                  MAX_MSG_EXTRA)
+#endif
+/* Connections per ring, bounded by the number of registered buffers. */
+#define WOLFSSL_URING_MAX_CONNS 16384
+
+/* user_data of a completion: connection index and which direction. */
+#define URING_OP_RX        0
+#define URING_OP_TX        1
+#define URING_DATA(i, op)  (((__u64)(i) << 1) | (op))
+#define URING_DATA_NONE    ((__u64)-1)
+
+/* Per connection state. The kernel reads and writes straight into the rx and
+ * tx areas, which belong to the ring so an operation still in flight when the
+ * WOLFSSL is freed never touches freed memory. */
+typedef struct UringConn {
+    WOLFSSL_URING*    ring;
+    WOLFSSL*          ssl;        /* NULL once detached */
+    byte*             rx;
+    byte*             tx;
+    struct UringConn* nextFree;
+    struct UringConn* nextReady;
+    int               idx;
+    int               txFd;
+    int               rxIdx;      /* next unread byte of rx */
+    int               rxLen;      /* bytes received into rx */
+    int               rxErr;      /* WOLFSSL_CBIO_ERR_* once the read ends */
+    int               txLen;      /* bytes queued in tx */
+    int               txBusy;     /* bytes of tx being sent */
+    int               txErr;      /* WOLFSSL_CBIO_ERR_* of the last send */
+    byte              rxBusy:1;
+    byte              onReady:1;
+    byte              detached:1;
+} UringConn;
+
+struct WOLFSSL_URING {
+    void*                heap;
+    int                  fd;
+    int                  bufSz;
+    int                  maxConns;
+    int                  inFlight;   /* operations without a completion */
+    byte                 fixed:1;    /* reads use registered buffers */
+    unsigned             sqEntries;
+    unsigned             sqMask;
+    unsigned             cqMask;
+    unsigned             sqTail;
+    unsigned             toSubmit;
+    unsigned*            sqHead;
+    unsigned*            sqTailPtr;
+    unsigned*            sqArray;
+    unsigned*            cqHead;
+    unsigned*            cqTail;
+    struct io_uring_sqe* sqes;
+    struct io_uring_cqe* cqes;
+    void*                sqRing;
+    size_t               sqRingSz;
+    void*                cqRing;
+    size_t               cqRingSz;
+    size_t               sqesSz;
+    byte*                bufs;
+    UringConn*           conns;
+    UringConn*           freeList;
+    UringConn*           readyHead;
+    UringConn*           readyTail;
+};
+
+static int UringEnter(WOLFSSL_URING* ring, unsigned toSubmit,
+                      unsigned minComplete)
+{
+    int ret;
+
+    do {
+        ret = (int)syscall(__NR_io_uring_enter, ring->fd, toSubmit,
+                           minComplete,
+                           minComplete > 0 ? IORING_ENTER_GETEVENTS : 0,
+                           NULL, 0);
+    } while (ret < 0 && errno == EINTR);
+
+    if (ret >= 0) {
+        ring->toSubmit -= (unsigned)ret < ring->toSubmit ? (unsigned)ret :
+                                                           ring->toSubmit;
+    }
+
+    return ret;
+}
+
+/* Next free submission queue entry, zeroed. Submits what is queued when the
+ * queue is full. */
+static struct io_uring_sqe* UringGetSqe(WOLFSSL_URING* ring)
+{
+    struct io_uring_sqe* sqe;
+    unsigned head = __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE);
+
+    if (ring->sqTail - head >= ring->sqEntries) {
+        if (UringEnter(ring, ring->toSubmit, 0) < 0)
+            return NULL;
+        head = __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE);
+        if (ring->sqTail - head >= ring->sqEntries)
+            return NULL;
+    }
+
+    sqe = &ring->sqes[ring->sqTail & ring->sqMask];
+    XMEMSET(sqe, 0, sizeof(*sqe));
+
+    return sqe;
+}
+
+static void UringPushSqe(WOLFSSL_URING* ring)
+{
+    ring->sqArray[ring->sqTail & ring->sqMask] = ring->sqTail & ring->sqMask;
+    ring->sqTail++;
+    __atomic_store_n(ring->sqTailPtr, ring->sqTail, __ATOMIC_RELEASE);
+    ring->toSubmit++;
+}
+
+static int UringQueueRecv(UringConn* conn, int fd)
+{
+    WOLFSSL_URING* ring = conn->ring;
+    struct io_uring_sqe* sqe = UringGetSqe(ring);
+
+    if (sqe == NULL) {
+        WOLFSSL_MSG("io_uring submission queue full");
+        return WOLFSSL_CBIO_ERR_GENERAL;
+    }
+
+    if (ring->fixed) {
+        sqe->opcode    = IORING_OP_READ_FIXED;
+        sqe->buf_index = (__u16)conn->idx;
+    }
+    else {
+        sqe->opcode = IORING_OP_RECV;
+    }
+    sqe->fd        = fd;
+    sqe->addr      = (__u64)(wc_ptr_t)conn->rx;
+    sqe->len       = (__u32)ring->bufSz;
+    sqe->user_data = URING_DATA(conn->idx, URING_OP_RX);
+    UringPushSqe(ring);
+
+    conn->rxIdx  = 0;
+    conn->rxLen  = 0;
+    conn->rxBusy = 1;
+    ring->inFlight++;
+
+    return 0;
+}
+
+static int UringQueueSend(UringConn* conn)
+{
+    WOLFSSL_URING* ring = conn->ring;
+    struct io_uring_sqe* sqe = UringGetSqe(ring);
+
+    if (sqe == NULL) {
+        WOLFSSL_MSG("io_uring submission queue full");
+        return WOLFSSL_CBIO_ERR_GENERAL;
+    }
+
+    sqe->opcode    = IORING_OP_SEND;
+    sqe->fd        = conn->txFd;
+    sqe->addr      = (__u64)(wc_ptr_t)conn->tx;
+    sqe->len       = (__u32)conn->txLen;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = URING_DATA(conn->idx, URING_OP_TX);
+    UringPushSqe(ring);
+
+    conn->txBusy = conn->txLen;
+    ring->inFlight++;
+
+    return 0;
+}
+
+static void UringCancel(UringConn* conn, int op)
+{
+    struct io_uring_sqe* sqe = UringGetSqe(conn->ring);
+
+    if (sqe == NULL)
+        return;
+
+    sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+    sqe->fd        = -1;
+    sqe->addr      = URING_DATA(conn->idx, op);
+    sqe->user_data = URING_DATA_NONE;
+    UringPushSqe(conn->ring);
+}
+
+static void UringRelease(UringConn* conn)
+{
+    conn->ssl      = NULL;
+    conn->detached = 0;
+    conn->nextFree = conn->ring->freeList;
+    conn->ring->freeList = conn;
+}
+
+static int UringIdle(const UringConn* conn)
+{
+    return !conn->rxBusy && conn->txBusy == 0 && !conn->onReady;
+}
+
+/* Connection state of ssl, taking a free slot of its ring on first use. */
+static UringConn* UringAttach(WOLFSSL* ssl)
+{
+    WOLFSSL_URING* ring = ssl->uring;
+    UringConn* conn = ssl->uringConn;
+
+    if (conn != NULL)
+        return conn;
+    if (ring == NULL || ring->freeList == NULL) {
+        WOLFSSL_MSG("No free io_uring connection");
+        return NULL;
+    }
+
+    conn = ring->freeList;
+    ring->freeList = conn->nextFree;
+    conn->ssl    = ssl;
+    conn->txFd   = ssl->wfd;
+    conn->rxIdx  = 0;
+    conn->rxLen  = 0;
+    conn->rxErr  = 0;
+    conn->txLen  = 0;
+    conn->txBusy = 0;
+    conn->txErr  = 0;
+    ssl->uringConn = conn;
+
+    return conn;
+}
+
+/* Called when ssl is freed. A pending read is cancelled, queued data is still
+ * sent. The slot is reused once the kernel is done with it. */
+void UringDetach(WOLFSSL* ssl)
+{
+    UringConn* conn = ssl->uringConn;
+
+    if (conn == NULL)
+        return;
+
+    ssl->uringConn = NULL;
+    conn->ssl      = NULL;
+    conn->detached = 1;
+    if (conn->rxBusy)
+        UringCancel(conn, URING_OP_RX);
+    if (UringIdle(conn))
+        UringRelease(conn);
+}
+
+static int UringTranslateError(int err)
+{
+    switch (err) {
+        case ECONNRESET:
+            WOLFSSL_MSG("\tConnection reset");
+            return WOLFSSL_CBIO_ERR_CONN_RST;
+        case EPIPE:
+            WOLFSSL_MSG("\tBroken pipe");
+            return WOLFSSL_CBIO_ERR_CONN_CLOSE;
+        case ECONNABORTED:
+            WOLFSSL_MSG("\tConnection aborted");
+            return WOLFSSL_CBIO_ERR_CONN_CLOSE;
+        default:
+            WOLFSSL_MSG("\tGeneral error");
+            return WOLFSSL_CBIO_ERR_GENERAL;
+    }
+}
+
+static void UringComplete(WOLFSSL_URING* ring, __u64 data, int res)
+{
+    UringConn* conn;
+
+    if (data == URING_DATA_NONE)
+        return;
+
+    conn = &ring->conns[data >> 1];
+    ring->inFlight--;
+
+    if ((data & 1) == URING_OP_RX) {
+        conn->rxBusy = 0;
+        if (res > 0)
+            conn->rxLen = res;
+        else if (res == 0)
+            conn->rxErr = WOLFSSL_CBIO_ERR_CONN_CLOSE;
+        else
+            conn->rxErr = UringTranslateError(-res);
+    }
+    else {
+        conn->txBusy = 0;
+        if (res >= 0) {
+            conn->txLen -= res;
+            if (conn->txLen > 0) {
+                XMEMMOVE(conn->tx, conn->tx + res, (size_t)conn->txLen);
+                if (UringQueueSend(conn) != 0)
+                    conn->txErr = WOLFSSL_CBIO_ERR_GENERAL;
+            }
+        }
+        else {
+            conn->txErr = UringTranslateError(-res);
+        }
+    }
+
+    if (conn->detached) {
+        if (UringIdle(conn))
+            UringRelease(conn);
+    }
+    else if (!conn->onReady) {
+        conn->onReady   = 1;
+        conn->nextReady = NULL;
+        if (ring->readyTail != NULL)
+            ring->readyTail->nextReady = conn;
+        else
+            ring->readyHead = conn;
+        ring->readyTail = conn;
+    }
+}
+
+static void UringReap(WOLFSSL_URING* ring)
+{
+    unsigned head = *ring->cqHead;
+    unsigned tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+
+    while (head != tail) {
+        struct io_uring_cqe* cqe = &ring->cqes[head & ring->cqMask];
+
+        UringComplete(ring, cqe->user_data, cqe->res);
+        head++;
+        __atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+        tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+    }
+}
+
+/* The receive I/O callback of the io_uring backend. Hands out what the last
+ * completed read brought in and queues the next read once that is used up,
+ * otherwise asks to be called again after wolfSSL_uring_wait().
+ *  return : nb bytes read, or error */
+int UringReceive(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    UringConn* conn;
+    int avail;
+
+    (void)ctx;
+
+    conn = UringAttach(ssl);
+    if (conn == NULL)
+        return WOLFSSL_CBIO_ERR_GENERAL;
+
+    avail = conn->rxLen - conn->rxIdx;
+    if (avail > 0) {
+        if (avail > sz)
+            avail = sz;
+        XMEMCPY(buf, conn->rx + conn->rxIdx, (size_t)avail);
+        conn->rxIdx += avail;
+        /* read ahead */
+        if (conn->rxIdx == conn->rxLen && conn->rxErr == 0)
+            (void)UringQueueRecv(conn, ssl->rfd);
+        return avail;
+    }
+    if (conn->rxErr != 0)
+        return conn->rxErr;
+    if (!conn->rxBusy && UringQueueRecv(conn, ssl->rfd) != 0)
+        return WOLFSSL_CBIO_ERR_GENERAL;
+
+    return WOLFSSL_CBIO_ERR_WANT_READ;
+}
+
+/* The send I/O callback of the io_uring backend. Queues data in the
+ * connection's send area, a send is submitted with the next
+ * wolfSSL_uring_submit() or wolfSSL_uring_wait().
+ *  return : nb bytes taken, or error */
+int UringSend(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    UringConn* conn;
+    int room;
+
+    (void)ctx;
+
+    conn = UringAttach(ssl);
+    if (conn == NULL)
+        return WOLFSSL_CBIO_ERR_GENERAL;
+    if (conn->txErr != 0)
+        return conn->txErr;
+
+    room = conn->ring->bufSz - conn->txLen;
+    if (room == 0)
+        return WOLFSSL_CBIO_ERR_WANT_WRITE;
+    if (sz > room)
+        sz = room;
+
+    XMEMCPY(conn->tx + conn->txLen, buf, (size_t)sz);
+    conn->txLen += sz;
+    if (conn->txBusy == 0 && UringQueueSend(conn) != 0)
+        return WOLFSSL_CBIO_ERR_GENERAL;
+
+    return sz;
+}
+
+static int UringSetup(WOLFSSL_URING* ring, unsigned entries)
+{
+    struct io_uring_params p;
+    struct iovec* iov;
+    int i;
+
+    XMEMSET(&p, 0, sizeof(p));
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+    if (ring->fd < 0) {
+        WOLFSSL_MSG("io_uring_setup failed");
+        return SOCKET_ERROR_E;
+    }
+
+    ring->sqRingSz = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring->cqRingSz = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cqRingSz > ring->sqRingSz)
+            ring->sqRingSz = ring->cqRingSz;
+        ring->cqRingSz = ring->sqRingSz;
+    }
+    ring->sqRing = mmap(NULL, ring->sqRingSz, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring->fd,
+                        IORING_OFF_SQ_RING);
+    if (ring->sqRing == MAP_FAILED) {
+        ring->sqRing = NULL;
+        return MEMORY_E;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cqRing = ring->sqRing;
+    }
+    else {
+        ring->cqRing = mmap(NULL, ring->cqRingSz, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ring->fd,
+                            IORING_OFF_CQ_RING);
+        if (ring->cqRing == MAP_FAILED) {
+            ring->cqRing = NULL;
+            return MEMORY_E;
+        }
+    }
+    ring->sqesSz = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqesSz,
+                        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ring->fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        return MEMORY_E;
+    }
+
+    ring->sqEntries = p.sq_entries;
+    ring->sqMask    = *(unsigned*)((byte*)ring->sqRing + p.sq_off.ring_mask);
+    ring->sqHead    = (unsigned*)((byte*)ring->sqRing + p.sq_off.head);
+    ring->sqTailPtr = (unsigned*)((byte*)ring->sqRing + p.sq_off.tail);
+    ring->sqArray   = (unsigned*)((byte*)ring->sqRing + p.sq_off.array);
+    ring->sqTail    = *ring->sqTailPtr;
+    ring->cqMask    = *(unsigned*)((byte*)ring->cqRing + p.cq_off.ring_mask);
+    ring->cqHead    = (unsigned*)((byte*)ring->cqRing + p.cq_off.head);
+    ring->cqTail    = (unsigned*)((byte*)ring->cqRing + p.cq_off.tail);
+    ring->cqes      = (struct io_uring_cqe*)((byte*)ring->cqRing +
+                                             p.cq_off.cqes);
+
+    /* Each connection's receive area is a registered buffer, reads land in
+     * it without the kernel mapping user pages per operation. Without
+     * (e.g. over RLIMIT_MEMLOCK) plain receives are used. Sends from
+     * registered buffers only come as zero copy sends, whose completion
+     * notification round doesn't pay for record sized writes. */
+    iov = (struct iovec*)XMALLOC(sizeof(struct iovec) * (size_t)ring->maxConns,
+                                 ring->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (iov == NULL)
+        return MEMORY_E;
+    for (i = 0; i < ring->maxConns; i++) {
+        iov[i].iov_base = ring->conns[i].rx;
+        iov[i].iov_len  = (size_t)ring->bufSz;
+    }
+    if (syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_BUFFERS,
+                iov, ring->maxConns) == 0) {
+        ring->fixed = 1;
+    }
+    else {
+        WOLFSSL_MSG("io_uring buffer registration failed, not using fixed");
+    }
+    XFREE(iov, ring->heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return 0;
+}
+
+/* Create an io_uring for up to maxConns connections, each with a receive and
+ * a send area of bufSz bytes (0 for a full record). The ring isn't thread
+ * safe, use one per event loop thread.
+ *  return : the ring, or NULL on failure */
+WOLFSSL_URING* wolfSSL_uring_new(int maxConns, int bufSz, void* heap)
+{
+    WOLFSSL_URING* ring;
+    unsigned entries = 1;
+    int i;
+
+    WOLFSSL_ENTER("wolfSSL_uring_new");
+
+    if (maxConns <= 0 || maxConns > WOLFSSL_URING_MAX_CONNS || bufSz < 0)
+        return NULL;
+    if (bufSz == 0)
+        bufSz = WOLFSSL_URING_BUF_SZ;
+
+    ring = (WOLFSSL_URING*)XMALLOC(sizeof(WOLFSSL_URING), heap,
+                                   DYNAMIC_TYPE_URING);
+    if (ring == NULL)
+        return NULL;
+    XMEMSET(ring, 0, sizeof(WOLFSSL_URING));
+    ring->heap     = heap;
+    ring->fd       = -1;
+    ring->bufSz    = bufSz;
+    ring->maxConns = maxConns;
+
+    ring->conns = (UringConn*)XMALLOC(sizeof(UringConn) * (size_t)maxConns,
+                                      heap, DYNAMIC_TYPE_URING);
+    ring->bufs = (byte*)XMALLOC(2 * (size_t)bufSz * (size_t)maxConns, heap,
+                                DYNAMIC_TYPE_URING);
+    if (ring->conns == NULL || ring->bufs == NULL) {
+        wolfSSL_uring_free(ring);
+        return NULL;
+    }
+    XMEMSET(ring->conns, 0, sizeof(UringConn) * (size_t)maxConns);
+    for (i = maxConns - 1; i >= 0; i--) {
+        UringConn* conn = &ring->conns[i];
+
+        conn->ring = ring;
+        conn->idx  = i;
+        conn->rx   = ring->bufs + 2 * (size_t)bufSz * (size_t)i;
+        conn->tx   = conn->rx + bufSz;
+        conn->nextFree = ring->freeList;
+        ring->freeList = conn;
+    }
+
+    /* a read, a send and a cancel per connection never overflow the
+     * completion queue, which is twice the submission queue */
+    while (entries < 2 * (unsigned)maxConns)
+        entries <<= 1;
+    if (UringSetup(ring, entries) != 0) {
+        wolfSSL_uring_free(ring);
+        return NULL;
+    }
+
+    return ring;
+}
+
+/* Free the ring. Free the WOLFSSL objects using it first. Waits for the
+ * kernel to finish with the operations still in flight. */
+void wolfSSL_uring_free(WOLFSSL_URING* ring)
+{
+    int i;
+
+    WOLFSSL_ENTER("wolfSSL_uring_free");
+
+    if (ring == NULL)
+        return;
+
+    if (ring->fd >= 0 && ring->sqes != NULL) {
+        for (i = 0; i < ring->maxConns; i++) {
+            if (ring->conns[i].rxBusy)
+                UringCancel(&ring->conns[i], URING_OP_RX);
+            if (ring->conns[i].txBusy != 0)
+                UringCancel(&ring->conns[i], URING_OP_TX);
+        }
+        while (ring->inFlight > 0) {
+            if (UringEnter(ring, ring->toSubmit, 1) < 0)
+                break;
+            UringReap(ring);
+        }
+    }
+
+    if (ring->sqes != NULL)
+        munmap(ring->sqes, ring->sqesSz);
+    if (ring->cqRing != NULL && ring->cqRing != ring->sqRing)
+        munmap(ring->cqRing, ring->cqRingSz);
+    if (ring->sqRing != NULL)
+        munmap(ring->sqRing, ring->sqRingSz);
+    if (ring->fd >= 0)
+        close(ring->fd);
+    XFREE(ring->bufs, ring->heap, DYNAMIC_TYPE_URING);
+    XFREE(ring->conns, ring->heap, DYNAMIC_TYPE_URING);
+    XFREE(ring, ring->heap, DYNAMIC_TYPE_URING);
+}
+
+/* Connections made from ctx do their socket I/O through ring. */
+int wolfSSL_CTX_SetIO_uring(WOLFSSL_CTX* ctx, WOLFSSL_URING* ring)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_SetIO_uring");
+
+    if (ctx == NULL || ring == NULL)
+        return BAD_FUNC_ARG;
+
+    ctx->uring    = ring;
+    ctx->CBIORecv = UringReceive;
+    ctx->CBIOSend = UringSend;
+
+    return WOLFSSL_SUCCESS;
+}
+
+int wolfSSL_SetIO_uring(WOLFSSL* ssl, WOLFSSL_URING* ring)
+{
+    WOLFSSL_ENTER("wolfSSL_SetIO_uring");
+
+    if (ssl == NULL || ring == NULL || ssl->uringConn != NULL)
+        return BAD_FUNC_ARG;
+
+    ssl->uring    = ring;
+    ssl->CBIORecv = UringReceive;
+    ssl->CBIOSend = UringSend;
+
+    return WOLFSSL_SUCCESS;
+}
+
+/* Submit the reads and sends queued by all connections with one system
+ * call.
+ *  return : nb operations submitted, or SOCKET_ERROR_E */
+int wolfSSL_uring_submit(WOLFSSL_URING* ring)
+{
+    int ret;
+
+    if (ring == NULL)
+        return BAD_FUNC_ARG;
+    if (ring->toSubmit == 0)
+        return 0;
+
+    ret = UringEnter(ring, ring->toSubmit, 0);
+    if (ret < 0) {
+        WOLFSSL_MSG("io_uring_enter failed");
+        return SOCKET_ERROR_E;
+    }
+
+    return ret;
+}
+
+/* Submit queued operations and collect completions. Up to max connections
+ * whose reads or sends completed are put in ready, call the wolfSSL function
+ * that returned WANT_READ or WANT_WRITE on them again. Waits for a completion
+ * for up to timeoutMs milliseconds when there are none, forever when
+ * negative.
+ *  return : nb connections in ready, or error */
+int wolfSSL_uring_wait(WOLFSSL_URING* ring, WOLFSSL** ready, int max,
+                       int timeoutMs)
+{
+    int cnt = 0;
+
+    if (ring == NULL || ready == NULL || max <= 0)
+        return BAD_FUNC_ARG;
+
+    if (ring->toSubmit > 0 && UringEnter(ring, ring->toSubmit, 0) < 0) {
+        WOLFSSL_MSG("io_uring_enter failed");
+        return SOCKET_ERROR_E;
+    }
+    UringReap(ring);
+
+    if (ring->readyHead == NULL && timeoutMs != 0) {
+        if (timeoutMs < 0) {
+            if (UringEnter(ring, 0, 1) < 0) {
+                WOLFSSL_MSG("io_uring_enter failed");
+                return SOCKET_ERROR_E;
+            }
+        }
+        else {
+            struct pollfd pfd;
+
+            pfd.fd      = ring->fd;
+            pfd.events  = POLLIN;
+            pfd.revents = 0;
+            (void)poll(&pfd, 1, timeoutMs);
+        }
+        UringReap(ring);
+    }
+
+    while (cnt < max && ring->readyHead != NULL) {
+        UringConn* conn = ring->readyHead;
+
+        ring->readyHead = conn->nextReady;
+        if (ring->readyHead == NULL)
+            ring->readyTail = NULL;
+        conn->onReady = 0;
+        if (conn->detached) {
+            if (UringIdle(conn))
+                UringRelease(conn);
+            continue;
+        }
+        ready[cnt++] = conn->ssl;
+    }
+
+    return cnt;
+}
+
+#endif /* WOLFSSL_IO_URING */
+
+
 #ifdef WOLFSSL_DTLS
 
 #include <wolfssl/wolfcrypt/sha.h>
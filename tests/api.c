@@ -229,6 +229,7 @@
 #endif
 
 #include <wolfssl/wolfcrypt/hash.h>
+#include <wolfssl/wolfcrypt/cpuid.h>
 #ifndef NO_RSA
     #include <wolfssl/wolfcrypt/rsa.h>
 
@@ -11456,6 +11457,1631 @@ static int test_wolfSSL_SCR_Reconnect(void)
     return EXPECT_RESULT();
 }
 
+#ifdef HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES
+static int test_writev_sends = 0;
+
+/* memio send that accepts partial writes, counting calls */
+static int test_writev_send_cb(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    struct test_memio_ctx* test_ctx = (struct test_memio_ctx*)ctx;
+    int room = TEST_MEMIO_BUF_SZ - test_ctx->s_len;
+
+    test_writev_sends++;
+    if (room == 0)
+        return WOLFSSL_CBIO_ERR_WANT_WRITE;
+    return test_memio_write_cb(ssl, buf, sz < room ? sz : room, ctx);
+}
+
+static int test_writev_recv(WOLFSSL* ssl, byte* buf, int sz)
+{
+    int got = 0;
+    int ret;
+
+    while (got < sz && (ret = wolfSSL_read(ssl, buf + got, sz - got)) > 0)
+        got += ret;
+    return got;
+}
+#endif
+
+/* writev gathers records straight from the iovecs, batching their sends. */
+static int test_wolfSSL_writev(void)
+{
+    EXPECT_DECLS;
+#if !defined(USE_WINDOWS_API) && !defined(NO_WRITEV) && \
+    defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES)
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    struct iovec iov[4];
+    byte* data = NULL;
+    byte* rcvd = NULL;
+    const int dataSz = 100000;
+    int got;
+    int ret;
+    int i;
+    struct {
+        method_provider client;
+        method_provider server;
+        const char* ciphers;
+    } params[] = {
+#ifdef WOLFSSL_TLS13
+        { wolfTLSv1_3_client_method, wolfTLSv1_3_server_method, NULL },
+#endif
+#ifndef WOLFSSL_NO_TLS12
+        { wolfTLSv1_2_client_method, wolfTLSv1_2_server_method, NULL },
+    #ifdef BUILD_TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA256
+        /* explicit IV ahead of the gathered plaintext */
+        { wolfTLSv1_2_client_method, wolfTLSv1_2_server_method,
+          "ECDHE-RSA-AES128-SHA256" },
+    #endif
+#endif
+        { NULL, NULL, NULL }
+    };
+
+    ExpectNotNull(data = (byte*)XMALLOC(dataSz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    ExpectNotNull(rcvd = (byte*)XMALLOC(dataSz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    for (i = 0; EXPECT_SUCCESS() && i < dataSz; i++)
+        data[i] = (byte)(i * 7);
+
+    for (i = 0; params[i].client != NULL; i++) {
+        XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+        test_ctx.c_ciphers = test_ctx.s_ciphers = params[i].ciphers;
+        ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c,
+            &ssl_s, params[i].client, params[i].server), 0);
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+        wolfSSL_SSLSetIOSend(ssl_c, test_writev_send_cb);
+        ExpectIntEQ(wolfSSL_set_send_batch(ssl_c, 4), WOLFSSL_SUCCESS);
+
+        ExpectIntEQ(wolfSSL_writev(NULL, iov, 1), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_writev(ssl_c, NULL, 1), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_writev(ssl_c, iov, -1), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_writev(ssl_c, NULL, 0), 0);
+
+        /* Three records, split unevenly and with an empty segment, are sent
+         * in one batch. */
+        iov[0].iov_base = data;
+        iov[0].iov_len  = 10;
+        iov[1].iov_base = data + 10;
+        iov[1].iov_len  = 0;
+        iov[2].iov_base = data + 10;
+        iov[2].iov_len  = 30000;
+        iov[3].iov_base = data + 30010;
+        iov[3].iov_len  = 10000;
+        test_writev_sends = 0;
+        ExpectIntEQ(wolfSSL_writev(ssl_c, iov, 4), 40010);
+        ExpectIntEQ(test_writev_sends, 1);
+        ExpectIntEQ(test_writev_recv(ssl_s, rcvd, 40010), 40010);
+        ExpectBufEQ(rcvd, data, 40010);
+
+        /* More than the transport takes at once: resume after WANT_WRITE
+         * partway through the vectors. */
+        iov[0].iov_base = data;
+        iov[0].iov_len  = 20000;
+        iov[1].iov_base = data + 20000;
+        iov[1].iov_len  = 1;
+        iov[2].iov_base = data + 20001;
+        iov[2].iov_len  = dataSz - 20001;
+        got = 0;
+        while (EXPECT_SUCCESS() && (ret = wolfSSL_writev(ssl_c, iov, 3)) < 0) {
+            ExpectIntEQ(wolfSSL_get_error(ssl_c, ret),
+                        WOLFSSL_ERROR_WANT_WRITE);
+            got += test_writev_recv(ssl_s, rcvd + got, dataSz - got);
+        }
+        ExpectIntEQ(ret, dataSz);
+        got += test_writev_recv(ssl_s, rcvd + got, dataSz - got);
+        ExpectIntEQ(got, dataSz);
+        ExpectBufEQ(rcvd, data, dataSz);
+
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+        wolfSSL_CTX_free(ctx_c);
+        ctx_c = NULL;
+        wolfSSL_CTX_free(ctx_s);
+        ctx_s = NULL;
+    }
+
+    XFREE(data, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(rcvd, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+    return EXPECT_RESULT();
+}
+
+/* wolfSSL_write() builds a batch of records and flushes them together. */
+static int test_wolfSSL_send_batch(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    (defined(WOLFSSL_TLS13) || !defined(WOLFSSL_NO_TLS12))
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    byte* data = NULL;
+    byte* rcvd = NULL;
+    const int dataSz = 40010; /* three full size records */
+    int i;
+
+    ExpectNotNull(data = (byte*)XMALLOC(dataSz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    ExpectNotNull(rcvd = (byte*)XMALLOC(dataSz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    for (i = 0; EXPECT_SUCCESS() && i < dataSz; i++)
+        data[i] = (byte)(i * 13);
+
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+#ifdef WOLFSSL_TLS13
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, NULL, NULL,
+        wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+#else
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, NULL, NULL,
+        wolfTLSv1_2_client_method, wolfTLSv1_2_server_method), 0);
+#endif
+    ExpectIntEQ(wolfSSL_CTX_set_send_batch(NULL, 2), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_set_send_batch(ctx_c, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_set_send_batch(ctx_c, WOLFSSL_MAX_SEND_BATCH + 1),
+        BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_set_send_batch(ctx_c, 3), WOLFSSL_SUCCESS);
+
+    ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+    ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+    wolfSSL_SetIOWriteCtx(ssl_c, &test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_c, &test_ctx);
+    wolfSSL_SetIOWriteCtx(ssl_s, &test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_s, &test_ctx);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+    wolfSSL_SSLSetIOSend(ssl_c, test_writev_send_cb);
+
+    ExpectIntEQ(wolfSSL_get_send_batch(NULL), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_get_send_batch(ssl_c), 3);
+    ExpectIntEQ(wolfSSL_get_send_batch(ssl_s), WOLFSSL_SEND_BATCH);
+    ExpectIntEQ(wolfSSL_set_send_batch(NULL, 1), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_set_send_batch(ssl_c, -1), BAD_FUNC_ARG);
+
+    /* One send for all three records. */
+    test_writev_sends = 0;
+    ExpectIntEQ(wolfSSL_write(ssl_c, data, dataSz), dataSz);
+    ExpectIntEQ(test_writev_sends, 1);
+    ExpectIntEQ(test_writev_recv(ssl_s, rcvd, dataSz), dataSz);
+    ExpectBufEQ(rcvd, data, dataSz);
+
+    /* Two records then one. */
+    ExpectIntEQ(wolfSSL_set_send_batch(ssl_c, 2), WOLFSSL_SUCCESS);
+    test_writev_sends = 0;
+    ExpectIntEQ(wolfSSL_write(ssl_c, data, dataSz), dataSz);
+    ExpectIntEQ(test_writev_sends, 2);
+    ExpectIntEQ(test_writev_recv(ssl_s, rcvd, dataSz), dataSz);
+    ExpectBufEQ(rcvd, data, dataSz);
+
+    /* Record at a time. */
+    ExpectIntEQ(wolfSSL_set_send_batch(ssl_c, 1), WOLFSSL_SUCCESS);
+    test_writev_sends = 0;
+    ExpectIntEQ(wolfSSL_write(ssl_c, data, dataSz), dataSz);
+    ExpectIntEQ(test_writev_sends, 3);
+    ExpectIntEQ(test_writev_recv(ssl_s, rcvd, dataSz), dataSz);
+    ExpectBufEQ(rcvd, data, dataSz);
+
+    /* Batch that doesn't fit in the transport resumes after WANT_WRITE. */
+    ExpectIntEQ(wolfSSL_set_send_batch(ssl_c, 3), WOLFSSL_SUCCESS);
+    test_ctx.s_len = TEST_MEMIO_BUF_SZ - 1000;
+    ExpectIntEQ(wolfSSL_write(ssl_c, data, dataSz), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_get_error(ssl_c, WOLFSSL_FATAL_ERROR),
+                WOLFSSL_ERROR_WANT_WRITE);
+    /* drop the filler and what made it through */
+    test_ctx.s_len = 0;
+    ExpectIntEQ(wolfSSL_write(ssl_c, data, dataSz), dataSz);
+
+    wolfSSL_free(ssl_c);
+    wolfSSL_free(ssl_s);
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+    XFREE(data, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(rcvd, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+    return EXPECT_RESULT();
+}
+
+/* Record buffers come from the CTX pool and go back to it when the
+ * connection is idle again. */
+static int test_wolfSSL_CTX_set_record_pool(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    !defined(WOLFSSL_NO_RECORD_POOL) && \
+    (defined(WOLFSSL_TLS13) || !defined(WOLFSSL_NO_TLS12))
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    WOLFSSL_RECORD_POOL_STATS stats;
+    byte* data = NULL;
+    byte* rcvd = NULL;
+    const int dataSz = 40010; /* three full size records */
+    unsigned long gets = 0;
+    int i, ret;
+
+    ExpectNotNull(data = (byte*)XMALLOC(dataSz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    ExpectNotNull(rcvd = (byte*)XMALLOC(dataSz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    for (i = 0; EXPECT_SUCCESS() && i < dataSz; i++)
+        data[i] = (byte)(i * 7);
+
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+#ifdef WOLFSSL_TLS13
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, NULL, NULL,
+        wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+#else
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, NULL, NULL,
+        wolfTLSv1_2_client_method, wolfTLSv1_2_server_method), 0);
+#endif
+    ExpectIntEQ(wolfSSL_CTX_set_record_pool(NULL, 4, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_set_record_pool(ctx_s, -1, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_set_record_pool(ctx_s, 4, -1), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_get_record_pool_stats(NULL, &stats),
+        BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_get_record_pool_stats(ctx_s, NULL),
+        BAD_FUNC_ARG);
+    /* no pool yet */
+    ExpectIntEQ(wolfSSL_CTX_get_record_pool_stats(ctx_s, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.gets, 0);
+    ExpectIntEQ(stats.bufSz, 0);
+
+    ExpectIntEQ(wolfSSL_CTX_set_record_pool(ctx_c, 4, 0), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_set_record_pool(ctx_s, 4, 0), WOLFSSL_SUCCESS);
+    /* one record per send so the output fits a pooled buffer */
+    ExpectIntEQ(wolfSSL_CTX_set_send_batch(ctx_c, 1), WOLFSSL_SUCCESS);
+
+    ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+    ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+    wolfSSL_SetIOWriteCtx(ssl_c, &test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_c, &test_ctx);
+    wolfSSL_SetIOWriteCtx(ssl_s, &test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_s, &test_ctx);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+
+    /* full size records in both directions, twice to reuse the buffers */
+    for (i = 0; i < 2; i++) {
+        int rcvdSz = 0;
+        ExpectIntEQ(wolfSSL_write(ssl_c, data, dataSz), dataSz);
+        while (EXPECT_SUCCESS() && rcvdSz < dataSz) {
+            ExpectIntGT(ret = wolfSSL_read(ssl_s, rcvd + rcvdSz,
+                dataSz - rcvdSz), 0);
+            rcvdSz += ret;
+        }
+        ExpectBufEQ(rcvd, data, dataSz);
+    }
+
+    ExpectIntEQ(wolfSSL_CTX_get_record_pool_stats(ctx_s, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntGE(stats.gets, 6);
+    ExpectIntGT(stats.hits, 0);
+    ExpectIntEQ(stats.inUse, 0);
+    ExpectIntGT(stats.peakInUse, 0);
+    ExpectIntGT(stats.idle, 0);
+    ExpectIntLE(stats.idle, 4 + WOLFSSL_RECORD_POOL_LISTS);
+    ExpectIntEQ(stats.bufSz, WOLFSSL_RECORD_POOL_BUF_SZ);
+    ExpectIntEQ(wolfSSL_CTX_get_record_pool_stats(ctx_c, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntGT(stats.gets, 0);
+    ExpectIntEQ(stats.inUse, 0);
+
+    /* a record read in part keeps its buffer */
+    ExpectIntEQ(wolfSSL_write(ssl_c, data, 16384), 16384);
+    ExpectIntEQ(wolfSSL_read(ssl_s, rcvd, 10), 10);
+    ExpectIntEQ(wolfSSL_CTX_get_record_pool_stats(ctx_s, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.inUse, 1);
+    ExpectIntEQ(wolfSSL_CTX_set_record_pool(ctx_s, 4, 20000), BAD_STATE_E);
+    ExpectIntEQ(wolfSSL_read(ssl_s, rcvd + 10, dataSz), 16384 - 10);
+    ExpectBufEQ(rcvd, data, 16384);
+    ExpectIntEQ(wolfSSL_CTX_get_record_pool_stats(ctx_s, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.inUse, 0);
+    ExpectIntEQ(wolfSSL_CTX_set_record_pool(ctx_s, 4, 20000), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_get_record_pool_stats(ctx_s, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.idle, 0);
+    ExpectIntEQ(stats.bufSz, 20000);
+
+    /* stopped pool lends nothing */
+    ExpectIntEQ(wolfSSL_CTX_set_record_pool(ctx_s, 0, 0), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_get_record_pool_stats(ctx_s, &stats),
+        WOLFSSL_SUCCESS);
+    gets = stats.gets;
+    ExpectIntEQ(wolfSSL_write(ssl_c, data, dataSz), dataSz);
+    ExpectIntEQ(wolfSSL_read(ssl_s, rcvd, dataSz), 16384);
+    ExpectIntEQ(wolfSSL_CTX_get_record_pool_stats(ctx_s, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.gets, gets);
+
+    wolfSSL_free(ssl_c);
+    wolfSSL_free(ssl_s);
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+    XFREE(data, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(rcvd, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+    return EXPECT_RESULT();
+}
+
+/* Compacted connections keep working and buffers are allocated again as
+ * records need them. */
+static int test_wolfSSL_compact(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    (defined(WOLFSSL_TLS13) || !defined(WOLFSSL_NO_TLS12))
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    byte* data = NULL;
+    byte* rcvd = NULL;
+    const int dataSz = 20000;
+    int i, j, ret;
+
+    ExpectNotNull(data = (byte*)XMALLOC(dataSz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    ExpectNotNull(rcvd = (byte*)XMALLOC(dataSz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    for (i = 0; EXPECT_SUCCESS() && i < dataSz; i++)
+        data[i] = (byte)(i * 5);
+
+    /* explicit compaction, then automatic on the server */
+    for (i = 0; i < 2; i++) {
+        XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    #ifdef WOLFSSL_TLS13
+        ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, NULL, NULL,
+            wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+    #else
+        ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, NULL, NULL,
+            wolfTLSv1_2_client_method, wolfTLSv1_2_server_method), 0);
+    #endif
+        ExpectIntEQ(wolfSSL_CTX_set_auto_compact(NULL, 1), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_CTX_set_auto_compact(ctx_s, i),
+            WOLFSSL_SUCCESS);
+        ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+        ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+        wolfSSL_SetIOWriteCtx(ssl_c, &test_ctx);
+        wolfSSL_SetIOReadCtx(ssl_c, &test_ctx);
+        wolfSSL_SetIOWriteCtx(ssl_s, &test_ctx);
+        wolfSSL_SetIOReadCtx(ssl_s, &test_ctx);
+        ExpectIntEQ(wolfSSL_set_auto_compact(NULL, 1), BAD_FUNC_ARG);
+        if (i == 0) {
+            ExpectIntEQ(wolfSSL_compact(NULL), BAD_FUNC_ARG);
+            ExpectIntEQ(wolfSSL_compact(ssl_c), BAD_STATE_E);
+            /* hold on to everything so there is something to compact */
+            ExpectIntEQ(wolfSSL_KeepHandshakeResources(ssl_c), 0);
+            ExpectIntEQ(wolfSSL_KeepHandshakeResources(ssl_s), 0);
+        }
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+
+        if (i == 0) {
+            ExpectIntGT(wolfSSL_compact(ssl_c), 0);
+            ExpectIntGT(wolfSSL_compact(ssl_s), 0);
+        }
+        /* nothing left the second time */
+        ExpectIntEQ(wolfSSL_compact(ssl_s), 0);
+
+        for (j = 0; j < 2; j++) {
+            int rcvdSz = 0;
+            ExpectIntEQ(wolfSSL_write(ssl_c, data, dataSz), dataSz);
+            while (EXPECT_SUCCESS() && rcvdSz < dataSz) {
+                ExpectIntGT(ret = wolfSSL_read(ssl_s, rcvd + rcvdSz,
+                    dataSz - rcvdSz), 0);
+                rcvdSz += ret;
+            }
+            ExpectBufEQ(rcvd, data, dataSz);
+            /* idle again, the record buffers go */
+            ExpectIntGE(wolfSSL_compact(ssl_s), 0);
+            ExpectIntEQ(wolfSSL_compact(ssl_s), 0);
+
+            ExpectIntEQ(wolfSSL_write(ssl_s, data, 100), 100);
+            ExpectIntEQ(wolfSSL_read(ssl_c, rcvd, dataSz), 100);
+            ExpectBufEQ(rcvd, data, 100);
+            ExpectIntGE(wolfSSL_compact(ssl_c), 0);
+        }
+
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+        wolfSSL_CTX_free(ctx_c);
+        ctx_c = NULL;
+        wolfSSL_CTX_free(ctx_s);
+        ctx_s = NULL;
+    }
+
+    XFREE(data, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(rcvd, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+    return EXPECT_RESULT();
+}
+
+static int test_wolfSSL_CTX_set_verify_workers(void)
+{
+    EXPECT_DECLS;
+#ifdef WOLFSSL_CHAIN_VERIFY_POOL
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    (defined(WOLFSSL_TLS13) || !defined(WOLFSSL_NO_TLS12))
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    byte* chain = NULL;
+    size_t chainSz = 0;
+    word32 leafSz = 0;
+    int i;
+
+    /* server chain with the signature of the leaf broken, fails whether or
+     * not alternative chains are allowed */
+    ExpectIntEQ(load_file("./certs/intermediate/server-chain.der", &chain,
+        &chainSz), 0);
+    ExpectIntGT(chainSz, 4);
+    if (EXPECT_SUCCESS()) {
+        /* SEQUENCE with a two byte length */
+        ExpectIntEQ(chain[0], 0x30);
+        ExpectIntEQ(chain[1], 0x82);
+        leafSz = 4 + (((word32)chain[2] << 8) | chain[3]);
+        ExpectIntLT(leafSz, chainSz);
+    }
+    if (EXPECT_SUCCESS())
+        chain[leafSz - 1] ^= 0x01;
+
+    /* full chain with 2 and 1 workers, then the broken one */
+    for (i = 0; i < 3; i++) {
+        XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    #ifdef WOLFSSL_TLS13
+        ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, NULL, NULL,
+            wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+    #else
+        ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, NULL, NULL,
+            wolfTLSv1_2_client_method, wolfTLSv1_2_server_method), 0);
+    #endif
+        /* compatible defaults don't verify the server */
+        wolfSSL_CTX_set_verify(ctx_c, WOLFSSL_VERIFY_PEER, NULL);
+        ExpectIntEQ(wolfSSL_CTX_set_verify_workers(ctx_c, -1), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_CTX_set_verify_workers(ctx_c,
+            WOLFSSL_CHAIN_VERIFY_MAX_WORKERS + 1), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_CTX_set_verify_workers(ctx_c, 4),
+            WOLFSSL_SUCCESS);
+        /* replaces the pool */
+        ExpectIntEQ(wolfSSL_CTX_set_verify_workers(ctx_c, i == 1 ? 1 : 2),
+            WOLFSSL_SUCCESS);
+        if (i < 2) {
+            ExpectIntEQ(wolfSSL_CTX_use_certificate_chain_file(ctx_s,
+                "./certs/intermediate/server-chain.pem"), WOLFSSL_SUCCESS);
+        }
+        else {
+            ExpectIntEQ(wolfSSL_CTX_use_certificate_chain_buffer_format(
+                ctx_s, chain, (long)chainSz, WOLFSSL_FILETYPE_ASN1),
+                WOLFSSL_SUCCESS);
+        }
+        ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+        ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+        wolfSSL_SetIOWriteCtx(ssl_c, &test_ctx);
+        wolfSSL_SetIOReadCtx(ssl_c, &test_ctx);
+        wolfSSL_SetIOWriteCtx(ssl_s, &test_ctx);
+        wolfSSL_SetIOReadCtx(ssl_s, &test_ctx);
+
+        if (i < 2) {
+            ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+        }
+        else {
+            ExpectIntNE(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+            ExpectIntEQ(wolfSSL_get_error(ssl_c, 0), ASN_SIG_CONFIRM_E);
+        }
+
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+        /* stops the workers */
+        wolfSSL_CTX_free(ctx_c);
+        ctx_c = NULL;
+        wolfSSL_CTX_free(ctx_s);
+        ctx_s = NULL;
+    }
+
+    free(chain);
+#endif
+#else
+    ExpectIntEQ(wolfSSL_CTX_set_verify_workers(NULL, 1), NOT_COMPILED_IN);
+#endif
+    return EXPECT_RESULT();
+}
+
+static int test_wolfSSL_CTX_set_keyshare_pool(void)
+{
+    EXPECT_DECLS;
+#ifdef WOLFSSL_KEY_SHARE_POOL
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_CURVE25519) || defined(HAVE_ECC))
+#ifdef HAVE_CURVE25519
+    const word16 group = WOLFSSL_ECC_X25519;
+    const word16 other = WOLFSSL_ECC_SECP256R1;
+    const word32 pubKeySz = CURVE25519_KEYSIZE;
+#else
+    const word16 group = WOLFSSL_ECC_SECP256R1;
+    const word16 other = WOLFSSL_ECC_X25519;
+    const word32 pubKeySz = 2 * 32 + 1;
+#endif
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    WOLFSSL_KEYSHARE_POOL_STATS stats;
+    byte pubKey[2][2 * 32 + 1];
+    int i;
+
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    XMEMSET(pubKey, 0, sizeof(pubKey));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, NULL, NULL,
+        wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+
+    ExpectIntEQ(wolfSSL_CTX_set_keyshare_pool(NULL, group, 1),
+        BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_set_keyshare_pool(ctx_c, group, -1),
+        BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_set_keyshare_pool(ctx_c, group,
+        WOLFSSL_KEY_SHARE_POOL_MAX + 1), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_set_keyshare_pool(ctx_c, WOLFSSL_FFDHE_2048, 1),
+        BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_keyshare_pool_fill(ctx_c, -1), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_get_keyshare_pool_stats(ctx_c, group,
+        NULL), BAD_FUNC_ARG);
+    /* nothing pooled yet */
+    ExpectIntEQ(wolfSSL_CTX_keyshare_pool_fill(ctx_c, 0), 0);
+
+    ExpectIntEQ(wolfSSL_CTX_set_keyshare_pool(ctx_c, group, 2),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_set_keyshare_pool(ctx_s, group, 4),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_keyshare_pool_fill(ctx_c, 1), 1);
+    ExpectIntEQ(wolfSSL_CTX_keyshare_pool_fill(ctx_c, 0), 1);
+    ExpectIntEQ(wolfSSL_CTX_keyshare_pool_fill(ctx_c, 0), 0);
+    ExpectIntEQ(wolfSSL_CTX_keyshare_pool_fill(ctx_s, 0), 4);
+    /* shrinking drops key pairs */
+    ExpectIntEQ(wolfSSL_CTX_set_keyshare_pool(ctx_s, group, 1),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_get_keyshare_pool_stats(ctx_s, group,
+        &stats), WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.ready, 1);
+    ExpectIntEQ(stats.size, 1);
+
+    /* two handshakes from the pool of the client, the third runs dry */
+    for (i = 0; i < 3; i++) {
+        test_ctx.c_len = 0;
+        test_ctx.s_len = 0;
+        ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+        ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+        wolfSSL_SetIOWriteCtx(ssl_c, &test_ctx);
+        wolfSSL_SetIOReadCtx(ssl_c, &test_ctx);
+        wolfSSL_SetIOWriteCtx(ssl_s, &test_ctx);
+        wolfSSL_SetIOReadCtx(ssl_s, &test_ctx);
+        ExpectIntEQ(wolfSSL_UseKeyShare(ssl_c, group),
+            WOLFSSL_SUCCESS);
+        if (i < 2 && EXPECT_SUCCESS()) {
+            TLSX* ext = ssl_c->extensions;
+            KeyShareEntry* kse;
+
+            while (ext != NULL && ext->type != TLSX_KEY_SHARE)
+                ext = ext->next;
+            kse = (ext != NULL) ? (KeyShareEntry*)ext->data : NULL;
+
+            ExpectNotNull(kse);
+            if (kse != NULL) {
+                ExpectIntEQ(kse->pubKeyLen, pubKeySz);
+                XMEMCPY(pubKey[i], kse->pubKey, pubKeySz);
+            }
+        }
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+    }
+    /* single use */
+    ExpectIntNE(XMEMCMP(pubKey[0], pubKey[1], pubKeySz), 0);
+
+    ExpectIntEQ(wolfSSL_CTX_get_keyshare_pool_stats(ctx_c, group,
+        &stats), WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.used, 2);
+    ExpectIntEQ(stats.underruns, 1);
+    ExpectIntEQ(stats.ready, 0);
+    ExpectIntEQ(wolfSSL_CTX_get_keyshare_pool_stats(ctx_s, group,
+        &stats), WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.used, 1);
+    ExpectIntEQ(stats.underruns, 2);
+    /* groups not pooled report nothing */
+    ExpectIntEQ(wolfSSL_CTX_get_keyshare_pool_stats(ctx_c, other, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.size, 0);
+
+#ifndef SINGLE_THREADED
+    /* the filler thread tops the pool up again */
+    ExpectIntEQ(wolfSSL_CTX_keyshare_pool_start(ctx_c), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_keyshare_pool_start(ctx_c), WOLFSSL_SUCCESS);
+    for (i = 0; i < 100; i++) {
+        ExpectIntEQ(wolfSSL_CTX_get_keyshare_pool_stats(ctx_c,
+            group, &stats), WOLFSSL_SUCCESS);
+        if (EXPECT_FAIL() || stats.ready == 2)
+            break;
+        XSLEEP_MS(10);
+    }
+    ExpectIntEQ(stats.ready, 2);
+#endif
+
+    /* stops the filler thread */
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+#endif
+#else
+    ExpectIntEQ(wolfSSL_CTX_set_keyshare_pool(NULL, 0, 1), NOT_COMPILED_IN);
+#endif
+    return EXPECT_RESULT();
+}
+
+static int test_wolfSSL_CTX_set_cert_msg_cache(void)
+{
+    EXPECT_DECLS;
+#ifdef WOLFSSL_CERT_MSG_CACHE
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && !defined(NO_RSA)
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    word32 chainMsgSz = 0;
+    int i;
+
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, NULL, NULL,
+        wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+    ExpectIntEQ(wolfSSL_CTX_set_cert_msg_cache(NULL, 1), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_use_certificate_chain_file(ctx_s,
+        "./certs/intermediate/server-chain.pem"), WOLFSSL_SUCCESS);
+
+    /* encoded by the first handshake, reused by the second, encoded again
+     * after the certificates change, not used when off */
+    for (i = 0; i < 4; i++) {
+        if (i == 2) {
+            ExpectIntEQ(wolfSSL_CTX_use_certificate_chain_file(ctx_s,
+                "./certs/server-cert.pem"), WOLFSSL_SUCCESS);
+        }
+        if (i == 3) {
+            ExpectIntEQ(wolfSSL_CTX_set_cert_msg_cache(ctx_s, 0),
+                WOLFSSL_SUCCESS);
+            /* cached body must not be sent */
+            if (EXPECT_SUCCESS() && ctx_s->certMsgCache.msg != NULL)
+                XMEMSET(ctx_s->certMsgCache.msg, 0, ctx_s->certMsgCache.msgSz);
+        }
+        test_ctx.c_len = 0;
+        test_ctx.s_len = 0;
+        ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+        ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+        wolfSSL_SetIOWriteCtx(ssl_c, &test_ctx);
+        wolfSSL_SetIOReadCtx(ssl_c, &test_ctx);
+        wolfSSL_SetIOWriteCtx(ssl_s, &test_ctx);
+        wolfSSL_SetIOReadCtx(ssl_s, &test_ctx);
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+
+        if (EXPECT_SUCCESS() && i < 3) {
+            ExpectNotNull(ctx_s->certMsgCache.msg);
+            ExpectIntEQ(ctx_s->certMsgCache.msgGen,
+                ctx_s->certMsgCache.certGen);
+        }
+        if (EXPECT_SUCCESS() && i == 1)
+            chainMsgSz = ctx_s->certMsgCache.msgSz;
+        if (EXPECT_SUCCESS() && i == 2)
+            ExpectIntLT(ctx_s->certMsgCache.msgSz, chainMsgSz);
+    }
+
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+#endif
+#else
+    ExpectIntEQ(wolfSSL_CTX_set_cert_msg_cache(NULL, 1), NOT_COMPILED_IN);
+#endif
+    return EXPECT_RESULT();
+}
+
+#if defined(WOLFSSL_STATELESS_HRR) && !defined(NO_WOLFSSL_SERVER) && \
+    defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    defined(USE_WOLFSSL_MEMORY) && !defined(WOLFSSL_STATIC_MEMORY) && \
+    !defined(WOLFSSL_DEBUG_MEMORY) && !defined(WOLFSSL_NO_MALLOC)
+#define TEST_HRR_MEM_CNT_MAX   8192
+#define TEST_HRR_PENDING       64
+
+/* Bytes allocated and not yet freed, while the counting allocators are set. */
+static void*  hrrMemPtr[TEST_HRR_MEM_CNT_MAX];
+static size_t hrrMemSz[TEST_HRR_MEM_CNT_MAX];
+static int    hrrMemNum;
+static long   hrrMemBytes;
+
+static void hrrMemDel(void* ptr)
+{
+    int i;
+
+    for (i = 0; ptr != NULL && i < hrrMemNum; i++) {
+        if (hrrMemPtr[i] == ptr) {
+            hrrMemBytes -= (long)hrrMemSz[i];
+            hrrMemNum--;
+            hrrMemPtr[i] = hrrMemPtr[hrrMemNum];
+            hrrMemSz[i] = hrrMemSz[hrrMemNum];
+            break;
+        }
+    }
+}
+
+static void hrrMemAdd(void* ptr, size_t sz)
+{
+    if (ptr != NULL && hrrMemNum < TEST_HRR_MEM_CNT_MAX) {
+        hrrMemPtr[hrrMemNum] = ptr;
+        hrrMemSz[hrrMemNum] = sz;
+        hrrMemNum++;
+        hrrMemBytes += (long)sz;
+    }
+}
+
+static void* hrrMemMalloc(size_t sz)
+{
+    void* ptr = malloc(sz);
+    hrrMemAdd(ptr, sz);
+    return ptr;
+}
+
+static void hrrMemFree(void* ptr)
+{
+    hrrMemDel(ptr);
+    free(ptr);
+}
+
+static void* hrrMemRealloc(void* ptr, size_t sz)
+{
+    void* newPtr;
+
+    /* Forget the old block first - it is gone once realloc succeeds. */
+    hrrMemDel(ptr);
+    newPtr = realloc(ptr, sz);
+    if (newPtr != NULL) {
+        hrrMemAdd(newPtr, sz);
+    }
+    return newPtr;
+}
+
+/* Average heap bytes held by each of TEST_HRR_PENDING server connections that
+ * have read the ClientHello ch and wait for the next one. No ClientHello when
+ * ch is NULL. */
+static long test_hrr_pending_bytes(WOLFSSL_CTX* ctx,
+    struct test_memio_ctx* test_ctx, const byte* ch, int chSz)
+{
+    EXPECT_DECLS;
+    WOLFSSL* ssl[TEST_HRR_PENDING];
+    wolfSSL_Malloc_cb mc;
+    wolfSSL_Free_cb fc;
+    wolfSSL_Realloc_cb rc;
+    long bytes = 0;
+    int i;
+
+    XMEMSET(ssl, 0, sizeof(ssl));
+    ExpectIntEQ(wolfSSL_GetAllocators(&mc, &fc, &rc), 0);
+    hrrMemNum = 0;
+    hrrMemBytes = 0;
+    ExpectIntEQ(wolfSSL_SetAllocators(hrrMemMalloc, hrrMemFree, hrrMemRealloc),
+        0);
+    for (i = 0; EXPECT_SUCCESS() && i < TEST_HRR_PENDING; i++) {
+        ExpectNotNull(ssl[i] = wolfSSL_new(ctx));
+        wolfSSL_SetIOWriteCtx(ssl[i], test_ctx);
+        wolfSSL_SetIOReadCtx(ssl[i], test_ctx);
+        if (ch != NULL) {
+            XMEMCPY(test_ctx->s_buff, ch, chSz);
+            test_ctx->s_len = chSz;
+            test_ctx->c_len = 0;
+            ExpectIntEQ(wolfSSL_accept(ssl[i]), WOLFSSL_FATAL_ERROR);
+            ExpectIntEQ(wolfSSL_get_error(ssl[i], WOLFSSL_FATAL_ERROR),
+                WOLFSSL_ERROR_WANT_READ);
+            /* HelloRetryRequest sent */
+            ExpectIntGT(test_ctx->c_len, 0);
+        }
+    }
+    ExpectIntLT(hrrMemNum, TEST_HRR_MEM_CNT_MAX);
+    bytes = hrrMemBytes / TEST_HRR_PENDING;
+    for (i = 0; i < TEST_HRR_PENDING; i++)
+        wolfSSL_free(ssl[i]);
+    ExpectIntEQ(wolfSSL_SetAllocators(mc, fc, rc), 0);
+    test_ctx->c_len = 0;
+    test_ctx->s_len = 0;
+
+    return EXPECT_SUCCESS() ? bytes : -1;
+}
+#endif
+
+/* Server sends a HelloRetryRequest without keeping the first ClientHello and
+ * holds less memory for each client it waits on. */
+static int test_wolfSSL_CTX_set_stateless_hrr(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_STATELESS_HRR) && !defined(NO_WOLFSSL_SERVER) && \
+    defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    defined(USE_WOLFSSL_MEMORY) && !defined(WOLFSSL_STATIC_MEMORY) && \
+    !defined(WOLFSSL_DEBUG_MEMORY) && !defined(WOLFSSL_NO_MALLOC)
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    byte ch[4096];
+    int chSz = 0;
+    long freshBytes = -1, statefulBytes = -1, statelessBytes = -1;
+
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c, NULL,
+        wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+    ExpectIntEQ(wolfSSL_CTX_set_stateless_hrr(NULL, NULL, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_set_stateless_hrr(ctx_c, NULL, 0), SIDE_ERROR);
+
+    /* ClientHello without key shares needs a HelloRetryRequest */
+    ExpectIntEQ(wolfSSL_NoKeyShares(ssl_c), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_connect(ssl_c), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_get_error(ssl_c, WOLFSSL_FATAL_ERROR),
+        WOLFSSL_ERROR_WANT_READ);
+    ExpectIntLE(test_ctx.s_len, (int)sizeof(ch));
+    if (EXPECT_SUCCESS()) {
+        chSz = test_ctx.s_len;
+        XMEMCPY(ch, test_ctx.s_buff, chSz);
+    }
+
+    ExpectIntGT(freshBytes = test_hrr_pending_bytes(ctx_s, &test_ctx, NULL,
+        0), 0);
+    ExpectIntGT(statefulBytes = test_hrr_pending_bytes(ctx_s, &test_ctx, ch,
+        chSz), freshBytes);
+    ExpectIntEQ(wolfSSL_CTX_set_stateless_hrr(ctx_s, NULL, 0),
+        WOLFSSL_SUCCESS);
+    ExpectIntGT(statelessBytes = test_hrr_pending_bytes(ctx_s, &test_ctx, ch,
+        chSz), 0);
+    /* Nothing of the ClientHello kept - not even the handshake hash. */
+    ExpectIntLE(statelessBytes, freshBytes);
+    ExpectIntLT(statelessBytes, statefulBytes);
+
+    /* Handshake completes with the hash restored from the Cookie. */
+    ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+    wolfSSL_SetIOWriteCtx(ssl_s, &test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_s, &test_ctx);
+    if (EXPECT_SUCCESS()) {
+        XMEMCPY(test_ctx.s_buff, ch, chSz);
+        test_ctx.s_len = chSz;
+    }
+    ExpectIntEQ(wolfSSL_accept(ssl_s), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_get_error(ssl_s, WOLFSSL_FATAL_ERROR),
+        WOLFSSL_ERROR_WANT_READ);
+    if (EXPECT_SUCCESS()) {
+        ExpectNull(ssl_s->hsHashes);
+        ExpectIntEQ(ssl_s->options.serverState,
+            SERVER_HELLO_RETRY_REQUEST_COMPLETE);
+    }
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+    ExpectIntEQ(wolfSSL_version(ssl_s), TLS1_3_VERSION);
+    wolfSSL_free(ssl_c);
+    ssl_c = NULL;
+    wolfSSL_free(ssl_s);
+    ssl_s = NULL;
+
+    /* Cookie made with a different secret is rejected. */
+    test_ctx.c_len = 0;
+    test_ctx.s_len = 0;
+    ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+    wolfSSL_SetIOWriteCtx(ssl_c, &test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_c, &test_ctx);
+    ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+    wolfSSL_SetIOWriteCtx(ssl_s, &test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_s, &test_ctx);
+    ExpectIntEQ(wolfSSL_NoKeyShares(ssl_c), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_connect(ssl_c), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_accept(ssl_s), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_CTX_set_stateless_hrr(ctx_s, NULL, 0),
+        WOLFSSL_SUCCESS);
+    ExpectIntNE(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+    ExpectIntEQ(wolfSSL_get_error(ssl_s, WOLFSSL_FATAL_ERROR),
+        HRR_COOKIE_ERROR);
+    wolfSSL_free(ssl_c);
+    ssl_c = NULL;
+    wolfSSL_free(ssl_s);
+    ssl_s = NULL;
+
+    /* Key share the server accepts needs no HelloRetryRequest. */
+    test_ctx.c_len = 0;
+    test_ctx.s_len = 0;
+    ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+    wolfSSL_SetIOWriteCtx(ssl_c, &test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_c, &test_ctx);
+    ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+    wolfSSL_SetIOWriteCtx(ssl_s, &test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_s, &test_ctx);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+    ExpectIntEQ(ssl_s->options.cookieGood, 0);
+
+    wolfSSL_free(ssl_c);
+    wolfSSL_free(ssl_s);
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+#elif defined(WOLFSSL_TLS13) && !defined(WOLFSSL_STATELESS_HRR)
+    ExpectIntEQ(wolfSSL_CTX_set_stateless_hrr(NULL, NULL, 0), BAD_FUNC_ARG);
+#endif
+    return EXPECT_RESULT();
+}
+
+#if defined(WOLFSSL_TICKET_KEY_SET) && defined(HAVE_SESSION_TICKET) && \
+    !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) && defined(WOLFSSL_TLS13) && \
+    defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES)
+/* Handshake resuming sess when not NULL, replace sess with the new session and
+ * return the name of the key its ticket is encrypted with. */
+static int test_ticket_keys_handshake(WOLFSSL_CTX* ctx_c, WOLFSSL_CTX* ctx_s,
+    struct test_memio_ctx* test_ctx, WOLFSSL_SESSION** sess, int reused,
+    byte* name)
+{
+    EXPECT_DECLS;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    char buf[1];
+
+    test_ctx->c_len = test_ctx->s_len = 0;
+    ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+    ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+    wolfSSL_SetIOWriteCtx(ssl_c, test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_c, test_ctx);
+    wolfSSL_SetIOWriteCtx(ssl_s, test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_s, test_ctx);
+    if (*sess != NULL)
+        ExpectIntEQ(wolfSSL_set_session(ssl_c, *sess), WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+    ExpectIntEQ(wolfSSL_session_reused(ssl_s), reused);
+#ifdef WOLFSSL_TICKET_ENC_BATCH
+    /* Cipher kept only while sending the tickets. */
+    if (ssl_s != NULL) {
+        ExpectNull(ssl_s->ticketEncBatch);
+    }
+#endif
+    /* Read the tickets. */
+    ExpectIntEQ(wolfSSL_read(ssl_c, buf, sizeof(buf)), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_get_error(ssl_c, WOLFSSL_FATAL_ERROR),
+        WOLFSSL_ERROR_WANT_READ);
+    wolfSSL_SESSION_free(*sess);
+    *sess = NULL;
+    ExpectNotNull(*sess = wolfSSL_get1_session(ssl_c));
+    if (*sess != NULL) {
+        ExpectIntGE((*sess)->ticketLen, WOLFSSL_TICKET_NAME_SZ);
+    }
+    if (EXPECT_SUCCESS()) {
+        XMEMCPY(name, (*sess)->ticket, WOLFSSL_TICKET_NAME_SZ);
+    }
+    wolfSSL_free(ssl_c);
+    wolfSSL_free(ssl_s);
+
+    return EXPECT_RESULT();
+}
+#endif
+
+/* Tickets encrypted with the scheduled operator key and decrypted with the key
+ * named in them while it lasts. */
+static int test_wolfSSL_CTX_set_ticket_keys(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_TICKET_KEY_SET) && defined(HAVE_SESSION_TICKET) && \
+    !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) && defined(WOLFSSL_TLS13) && \
+    defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES)
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL_SESSION* sess = NULL;
+    WOLFSSL_SESSION* sessA = NULL;
+    WOLFSSL_TICKET_KEY keys[2];
+    WOLFSSL_TICKET_KEY bad[2];
+    byte name[WOLFSSL_TICKET_NAME_SZ];
+    int i;
+
+    XMEMSET(keys, 0, sizeof(keys));
+    XMEMSET(keys[0].name, 'A', WOLFSSL_TICKET_NAME_SZ);
+    XMEMSET(keys[0].key, 0x11, sizeof(keys[0].key));
+    keys[0].encStart = 0;
+    keys[0].decEnd = 0xffffffff;
+    /* Second key not yet scheduled for encryption. */
+    XMEMSET(keys[1].name, 'B', WOLFSSL_TICKET_NAME_SZ);
+    XMEMSET(keys[1].key, 0x22, sizeof(keys[1].key));
+    keys[1].encStart = 0xfffffff0;
+    keys[1].decEnd = 0xffffffff;
+
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, NULL, NULL,
+        wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(NULL, keys, 2), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, NULL, 2), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, keys, -1), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, keys,
+        WOLFSSL_TICKET_KEY_SET_MAX + 1), BAD_FUNC_ARG);
+    XMEMCPY(bad, keys, sizeof(keys));
+    bad[1].decEnd = bad[1].encStart;
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, bad, 2), BAD_FUNC_ARG);
+    XMEMCPY(bad[1].name, bad[0].name, WOLFSSL_TICKET_NAME_SZ);
+    bad[1].decEnd = 0xffffffff;
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, bad, 2), BAD_FUNC_ARG);
+
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, keys, 2), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_set_num_tickets(ctx_s, 3), WOLFSSL_SUCCESS);
+
+    /* Full handshake sends tickets encrypted with the first key. */
+    ExpectIntEQ(test_ticket_keys_handshake(ctx_c, ctx_s, &test_ctx, &sess, 0,
+        name), TEST_SUCCESS);
+    ExpectBufEQ(name, keys[0].name, WOLFSSL_TICKET_NAME_SZ);
+    ExpectNotNull(sessA = wolfSSL_SESSION_dup(sess));
+
+    /* Rotate: second key encrypts, first still decrypts. */
+    keys[1].encStart = 1;
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, keys, 2), WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_ticket_keys_handshake(ctx_c, ctx_s, &test_ctx, &sess, 1,
+        name), TEST_SUCCESS);
+    ExpectBufEQ(name, keys[1].name, WOLFSSL_TICKET_NAME_SZ);
+    ExpectIntEQ(test_ticket_keys_handshake(ctx_c, ctx_s, &test_ctx, &sess, 1,
+        name), TEST_SUCCESS);
+    ExpectBufEQ(name, keys[1].name, WOLFSSL_TICKET_NAME_SZ);
+
+    /* First key removed - its tickets no longer resume. */
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, &keys[1], 1),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_ticket_keys_handshake(ctx_c, ctx_s, &test_ctx, &sessA, 0,
+        name), TEST_SUCCESS);
+    ExpectBufEQ(name, keys[1].name, WOLFSSL_TICKET_NAME_SZ);
+
+    /* Key past decryption end - context's own keys encrypt. */
+    keys[1].encStart = 0;
+    keys[1].decEnd = 1;
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, &keys[1], 1),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_ticket_keys_handshake(ctx_c, ctx_s, &test_ctx, &sess, 0,
+        name), TEST_SUCCESS);
+    ExpectBufNE(name, keys[0].name, WOLFSSL_TICKET_NAME_SZ);
+    ExpectBufNE(name, keys[1].name, WOLFSSL_TICKET_NAME_SZ);
+    ExpectIntEQ(test_ticket_keys_handshake(ctx_c, ctx_s, &test_ctx, &sess, 1,
+        name), TEST_SUCCESS);
+
+    /* No operator keys. */
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, NULL, 0), WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_ticket_keys_handshake(ctx_c, ctx_s, &test_ctx, &sess, 1,
+        name), TEST_SUCCESS);
+    ExpectBufNE(name, keys[1].name, WOLFSSL_TICKET_NAME_SZ);
+
+    /* Set again after removing and after many replacements. */
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, keys, 1), WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_ticket_keys_handshake(ctx_c, ctx_s, &test_ctx, &sess, 1,
+        name), TEST_SUCCESS);
+    ExpectBufEQ(name, keys[0].name, WOLFSSL_TICKET_NAME_SZ);
+    for (i = 0; i < 5; i++) {
+        ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, NULL, 0),
+            WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(ctx_s, keys, 1),
+            WOLFSSL_SUCCESS);
+    }
+    ExpectIntEQ(test_ticket_keys_handshake(ctx_c, ctx_s, &test_ctx, &sess, 1,
+        name), TEST_SUCCESS);
+    ExpectBufEQ(name, keys[0].name, WOLFSSL_TICKET_NAME_SZ);
+
+    wolfSSL_SESSION_free(sess);
+    wolfSSL_SESSION_free(sessA);
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+#elif defined(HAVE_SESSION_TICKET) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(WOLFSSL_TICKET_KEY_SET)
+    ExpectIntEQ(wolfSSL_CTX_set_ticket_keys(NULL, NULL, 0), BAD_FUNC_ARG);
+#endif
+    return EXPECT_RESULT();
+}
+
+/* Zero-copy reads: partial release, interleaving with wolfSSL_read() and
+ * records that change keys (KeyUpdate, renegotiation) while a view is held. */
+static int test_wolfSSL_read_zc(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    (defined(WOLFSSL_TLS13) || \
+     (defined(HAVE_SECURE_RENEGOTIATION) && !defined(WOLFSSL_NO_TLS12)))
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    const unsigned char* view = NULL;
+    const char msg1[] = "zero-copy read";
+    const char msg2[] = "after rekey";
+    char buf[4];
+#endif
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && defined(WOLFSSL_TLS13)
+    const unsigned char* view2 = NULL;
+    int s_len = 0;
+#endif
+
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && defined(WOLFSSL_TLS13)
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c, &ssl_s,
+        wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+
+    ExpectIntEQ(wolfSSL_read_zc(NULL, &view), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_read_zc(ssl_s, NULL), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_read_release(NULL, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_read_release(ssl_s, 0), BAD_STATE_E);
+
+    ExpectIntEQ(wolfSSL_write(ssl_c, msg1, sizeof(msg1)), sizeof(msg1));
+    ExpectIntEQ(wolfSSL_update_keys(ssl_c), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_write(ssl_c, msg2, sizeof(msg2)), sizeof(msg2));
+
+    /* Partial consumption keeps the rest of the record pinned. */
+    ExpectIntEQ(wolfSSL_read_zc(ssl_s, &view), sizeof(msg1));
+    ExpectBufEQ(view, msg1, sizeof(msg1));
+    ExpectIntEQ(wolfSSL_read_release(ssl_s, sizeof(msg1) + 1), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_read_release(ssl_s, 5), WOLFSSL_SUCCESS);
+    s_len = test_ctx.s_len;
+    ExpectIntEQ(wolfSSL_read_zc(ssl_s, &view2), sizeof(msg1) - 5);
+    ExpectPtrEq(view2, view + 5);
+    /* Copying reads drain the same view. */
+    ExpectIntEQ(wolfSSL_read(ssl_s, buf, sizeof(buf)), sizeof(buf));
+    ExpectBufEQ(buf, msg1 + 5, sizeof(buf));
+    ExpectIntEQ(wolfSSL_read_zc(ssl_s, &view2), sizeof(msg1) - 5 - 4);
+    ExpectPtrEq(view2, view + 5 + 4);
+    /* Nothing more was read from the transport while pinned. */
+    ExpectIntEQ(test_ctx.s_len, s_len);
+    ExpectIntEQ(wolfSSL_read_release(ssl_s, sizeof(msg1) - 5 - 4),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_read_release(ssl_s, 0), BAD_STATE_E);
+
+    /* KeyUpdate is processed before the next application record. */
+    ExpectIntEQ(wolfSSL_read_zc(ssl_s, &view), sizeof(msg2));
+    ExpectBufEQ(view, msg2, sizeof(msg2));
+    ExpectIntEQ(wolfSSL_read_release(ssl_s, sizeof(msg2)), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_read_zc(ssl_s, &view), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_get_error(ssl_s, WOLFSSL_FATAL_ERROR),
+                WOLFSSL_ERROR_WANT_READ);
+    ExpectNull(view);
+
+    /* Server's side of the key update, then data on the new keys. */
+    ExpectIntEQ(wolfSSL_read(ssl_c, buf, sizeof(buf)), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_get_error(ssl_c, WOLFSSL_FATAL_ERROR),
+                WOLFSSL_ERROR_WANT_READ);
+    ExpectIntEQ(wolfSSL_write(ssl_s, msg1, sizeof(msg1)), sizeof(msg1));
+    ExpectIntEQ(wolfSSL_read_zc(ssl_c, &view), sizeof(msg1));
+    ExpectBufEQ(view, msg1, sizeof(msg1));
+    ExpectIntEQ(wolfSSL_read_release(ssl_c, sizeof(msg1)), WOLFSSL_SUCCESS);
+
+    wolfSSL_free(ssl_c);
+    ssl_c = NULL;
+    wolfSSL_free(ssl_s);
+    ssl_s = NULL;
+    wolfSSL_CTX_free(ctx_c);
+    ctx_c = NULL;
+    wolfSSL_CTX_free(ctx_s);
+    ctx_s = NULL;
+#endif
+
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    defined(HAVE_SECURE_RENEGOTIATION) && !defined(WOLFSSL_NO_TLS12)
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c, &ssl_s,
+        wolfTLSv1_2_client_method, wolfTLSv1_2_server_method), 0);
+    ExpectIntEQ(WOLFSSL_SUCCESS, wolfSSL_UseSecureRenegotiation(ssl_c));
+    ExpectIntEQ(WOLFSSL_SUCCESS, wolfSSL_UseSecureRenegotiation(ssl_s));
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+
+    ExpectIntEQ(wolfSSL_write(ssl_c, msg1, sizeof(msg1)), sizeof(msg1));
+    ExpectIntEQ(wolfSSL_read_zc(ssl_s, &view), sizeof(msg1));
+    /* Renegotiation can't read the peer's hello while the view is held. */
+    ExpectIntEQ(wolfSSL_Rehandshake(ssl_s), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_get_error(ssl_s, WOLFSSL_FATAL_ERROR),
+                WOLFSSL_ERROR_WANT_READ);
+    ExpectIntEQ(wolfSSL_read(ssl_c, buf, sizeof(buf)), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_get_error(ssl_c, WOLFSSL_FATAL_ERROR),
+                WOLFSSL_ERROR_WANT_READ);
+    ExpectIntGT(test_ctx.s_len, 0);
+    ExpectIntEQ(wolfSSL_negotiate(ssl_s), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_get_error(ssl_s, WOLFSSL_FATAL_ERROR),
+                WOLFSSL_ERROR_WANT_READ);
+    ExpectBufEQ(view, msg1, sizeof(msg1));
+    ExpectIntEQ(wolfSSL_read_release(ssl_s, sizeof(msg1)), WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+
+    ExpectIntEQ(wolfSSL_write(ssl_c, msg2, sizeof(msg2)), sizeof(msg2));
+    ExpectIntEQ(wolfSSL_read_zc(ssl_s, &view), sizeof(msg2));
+    ExpectBufEQ(view, msg2, sizeof(msg2));
+    ExpectIntEQ(wolfSSL_read_release(ssl_s, sizeof(msg2)), WOLFSSL_SUCCESS);
+
+    wolfSSL_free(ssl_c);
+    wolfSSL_free(ssl_s);
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+#endif
+    return EXPECT_RESULT();
+}
+
+#if (defined(WOLFSSL_KTLS) || defined(WOLFSSL_IO_URING)) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    (defined(WOLFSSL_TLS13) || !defined(WOLFSSL_NO_TLS12))
+/* Connected pair of non-blocking TCP sockets over loopback, for the socket
+ * backends that need a real TCP socket. */
+static int test_loopback_sockets(SOCKET_T* c, SOCKET_T* s)
+{
+    EXPECT_DECLS;
+    SOCKET_T l = SOCKET_INVALID;
+    SOCKADDR_IN_T addr;
+    socklen_t addrSz = sizeof(addr);
+
+    *c = SOCKET_INVALID;
+    *s = SOCKET_INVALID;
+
+    XMEMSET(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ExpectIntGE(l = socket(AF_INET, SOCK_STREAM, 0), 0);
+    ExpectIntEQ(bind(l, (struct sockaddr*)&addr, sizeof(addr)), 0);
+    ExpectIntEQ(listen(l, 1), 0);
+    ExpectIntEQ(getsockname(l, (struct sockaddr*)&addr, &addrSz), 0);
+    ExpectIntGE(*c = socket(AF_INET, SOCK_STREAM, 0), 0);
+    ExpectIntEQ(connect(*c, (struct sockaddr*)&addr, sizeof(addr)), 0);
+    ExpectIntGE(*s = accept(l, NULL, NULL), 0);
+    if (l != SOCKET_INVALID)
+        CloseSocket(l);
+    if (EXPECT_SUCCESS()) {
+        int on = 1;
+        /* handshake flights are several small writes */
+        ExpectIntEQ(setsockopt(*c, IPPROTO_TCP, TCP_NODELAY, &on,
+            sizeof(on)), 0);
+        ExpectIntEQ(setsockopt(*s, IPPROTO_TCP, TCP_NODELAY, &on,
+            sizeof(on)), 0);
+        tcp_set_nonblocking(c);
+        tcp_set_nonblocking(s);
+    }
+
+    return EXPECT_RESULT();
+}
+#endif
+
+#if defined(WOLFSSL_KTLS) && !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && \
+    !defined(NO_RSA) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER) && defined(HAVE_AESGCM) && \
+    (defined(WOLFSSL_TLS13) || !defined(WOLFSSL_NO_TLS12))
+/* Reads until sz bytes are in out or the peer stops sending. */
+static int test_ktls_recv(WOLFSSL* ssl, byte* out, int sz)
+{
+    int got = 0;
+    int tries = 0;
+
+    while (got < sz && tries++ < 1000) {
+        int ret = wolfSSL_read(ssl, out + got, sz - got);
+        if (ret > 0)
+            got += ret;
+        else if (wolfSSL_get_error(ssl, ret) == WOLFSSL_ERROR_WANT_READ)
+            (void)tcp_select(wolfSSL_get_fd(ssl), 1);
+        else
+            break;
+    }
+
+    return got;
+}
+
+static int test_ktls_conn(method_provider cm, method_provider sm)
+{
+    EXPECT_DECLS;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    SOCKET_T c = SOCKET_INVALID, s = SOCKET_INVALID;
+    FILE* f = NULL;
+    off_t offset = 0;
+    byte* data = NULL;
+    byte* rcvd = NULL;
+    const int dataSz = 40000;
+    int dirs = 0;
+    int ret_c = WOLFSSL_FATAL_ERROR, ret_s = WOLFSSL_FATAL_ERROR;
+    int sent;
+    int got = 0;
+    int i;
+
+    ExpectNotNull(data = (byte*)XMALLOC(dataSz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    ExpectNotNull(rcvd = (byte*)XMALLOC(dataSz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    for (i = 0; EXPECT_SUCCESS() && i < dataSz; i++)
+        data[i] = (byte)(i * 7);
+
+    ExpectNotNull(ctx_c = wolfSSL_CTX_new(cm()));
+    ExpectNotNull(ctx_s = wolfSSL_CTX_new(sm()));
+    ExpectIntEQ(wolfSSL_CTX_load_verify_locations(ctx_c, caCertFile, 0),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_use_certificate_file(ctx_s, svrCertFile,
+        WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_use_PrivateKey_file(ctx_s, svrKeyFile,
+        WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_UseKTLS(ctx_s), WOLFSSL_SUCCESS);
+
+    ExpectIntEQ(test_loopback_sockets(&c, &s), TEST_SUCCESS);
+    ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+    ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+    ExpectIntEQ(wolfSSL_UseKTLS(ssl_c), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_set_fd(ssl_c, c), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_set_fd(ssl_s, s), WOLFSSL_SUCCESS);
+
+    for (i = 0; EXPECT_SUCCESS() && i < 1000 &&
+            (ret_c != WOLFSSL_SUCCESS || ret_s != WOLFSSL_SUCCESS); i++) {
+        if (ret_c != WOLFSSL_SUCCESS) {
+            ret_c = wolfSSL_connect(ssl_c);
+            if (ret_c != WOLFSSL_SUCCESS) {
+                ExpectIntEQ(wolfSSL_get_error(ssl_c, ret_c),
+                    WOLFSSL_ERROR_WANT_READ);
+            }
+        }
+        if (ret_s != WOLFSSL_SUCCESS) {
+            ret_s = wolfSSL_accept(ssl_s);
+            if (ret_s != WOLFSSL_SUCCESS) {
+                ExpectIntEQ(wolfSSL_get_error(ssl_s, ret_s),
+                    WOLFSSL_ERROR_WANT_READ);
+            }
+        }
+    }
+    ExpectIntEQ(ret_c, WOLFSSL_SUCCESS);
+    ExpectIntEQ(ret_s, WOLFSSL_SUCCESS);
+
+    /* Same data whether or not the kernel took over the record layer. */
+    ExpectIntEQ(wolfSSL_write(ssl_c, data, 1000), 1000);
+    ExpectIntEQ(test_ktls_recv(ssl_s, rcvd, 1000), 1000);
+    ExpectBufEQ(rcvd, data, 1000);
+    ExpectIntEQ(wolfSSL_write(ssl_s, data + 1000, 2000), 2000);
+    ExpectIntEQ(test_ktls_recv(ssl_c, rcvd, 2000), 2000);
+    ExpectBufEQ(rcvd, data + 1000, 2000);
+    ExpectIntGE(dirs = wolfSSL_get_ktls(ssl_c), 0);
+    ExpectTrue(dirs == 0 || dirs == (WOLFSSL_KTLS_TX | WOLFSSL_KTLS_RX));
+
+    /* File contents go out from the offset and advance it. */
+    ExpectNotNull(f = tmpfile());
+    ExpectIntEQ((int)fwrite(data, 1, dataSz, f), dataSz);
+    ExpectIntEQ(fflush(f), 0);
+    ExpectIntEQ(wolfSSL_sendfile(NULL, 0, &offset, 1), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_sendfile(ssl_c, -1, &offset, 1), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_sendfile(ssl_c, 0, NULL, 1), BAD_FUNC_ARG);
+    offset = 100;
+    sent = 0;
+    for (i = 0; EXPECT_SUCCESS() && f != NULL && i < 1000 &&
+            sent < dataSz - 100; i++) {
+        long ret = wolfSSL_sendfile(ssl_c, fileno(f), &offset,
+            (size_t)(dataSz - 100 - sent));
+        if (ret > 0)
+            sent += (int)ret;
+        else {
+            ExpectIntEQ(wolfSSL_get_error(ssl_c, (int)ret),
+                WOLFSSL_ERROR_WANT_WRITE);
+        }
+        /* keep the socket from filling up */
+        ret = wolfSSL_read(ssl_s, rcvd + got, dataSz - 100 - got);
+        if (ret > 0)
+            got += (int)ret;
+        else
+            (void)tcp_select(s, 1);
+    }
+    ExpectIntEQ(sent, dataSz - 100);
+    ExpectIntEQ((int)offset, dataSz);
+    got += test_ktls_recv(ssl_s, rcvd + got, dataSz - 100 - got);
+    ExpectIntEQ(got, dataSz - 100);
+    ExpectBufEQ(rcvd, data + 100, dataSz - 100);
+
+#ifdef WOLFSSL_TLS13
+    if (wolfSSL_version(ssl_c) == TLS1_3_VERSION) {
+        /* Both directions carry on with the next generation of keys. */
+        ExpectIntEQ(wolfSSL_update_keys(ssl_c), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_write(ssl_c, data, 500), 500);
+        ExpectIntEQ(test_ktls_recv(ssl_s, rcvd, 500), 500);
+        ExpectBufEQ(rcvd, data, 500);
+        ExpectIntEQ(wolfSSL_write(ssl_s, data + 500, 500), 500);
+        ExpectIntEQ(test_ktls_recv(ssl_c, rcvd, 500), 500);
+        ExpectBufEQ(rcvd, data + 500, 500);
+    }
+#endif
+    ExpectIntEQ(wolfSSL_get_ktls(ssl_s), dirs);
+
+    if (f != NULL)
+        fclose(f);
+    wolfSSL_free(ssl_c);
+    wolfSSL_free(ssl_s);
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+    if (c != SOCKET_INVALID)
+        CloseSocket(c);
+    if (s != SOCKET_INVALID)
+        CloseSocket(s);
+    XFREE(data, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(rcvd, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return EXPECT_RESULT();
+}
+#endif
+
+/* Kernel TLS offload over a loopback connection. Where the kernel can't take
+ * the connection the record layer stays in wolfSSL, the data is the same. */
+static int test_wolfSSL_ktls(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_KTLS) && !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && \
+    !defined(NO_RSA) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER) && defined(HAVE_AESGCM) && \
+    (defined(WOLFSSL_TLS13) || !defined(WOLFSSL_NO_TLS12))
+    ExpectIntEQ(wolfSSL_CTX_UseKTLS(NULL), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_UseKTLS(NULL), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_get_ktls(NULL), BAD_FUNC_ARG);
+#ifndef WOLFSSL_NO_TLS12
+    ExpectIntEQ(test_ktls_conn(wolfTLSv1_2_client_method,
+        wolfTLSv1_2_server_method), TEST_SUCCESS);
+#endif
+#ifdef WOLFSSL_TLS13
+    ExpectIntEQ(test_ktls_conn(wolfTLSv1_3_client_method,
+        wolfTLSv1_3_server_method), TEST_SUCCESS);
+#endif
+#endif
+    return EXPECT_RESULT();
+}
+
+/* Connections doing their socket I/O through one io_uring, resumed from
+ * wolfSSL_uring_wait(). The small ring buffers make sends partial. */
+static int test_wolfSSL_SetIO_uring(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_IO_URING) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER) && \
+    (defined(WOLFSSL_TLS13) || !defined(WOLFSSL_NO_TLS12))
+    WOLFSSL_URING* ring = NULL;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL, *ssl_x = NULL;
+    WOLFSSL* ready[4];
+    SOCKET_T c = SOCKET_INVALID, s = SOCKET_INVALID;
+    byte* data = NULL;
+    byte* rcvd = NULL;
+    const int dataSz = 50000;
+    int ret_c, ret_s;
+    int sent = 0, got = 0;
+    int i, j, n = 0;
+    int err;
+
+    ExpectNotNull(data = (byte*)XMALLOC(dataSz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    ExpectNotNull(rcvd = (byte*)XMALLOC(dataSz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    for (i = 0; EXPECT_SUCCESS() && i < dataSz; i++)
+        data[i] = (byte)(i * 11);
+
+    ExpectNull(wolfSSL_uring_new(0, 0, NULL));
+    ExpectNull(wolfSSL_uring_new(1, -1, NULL));
+    ExpectNotNull(ring = wolfSSL_uring_new(2, 2048, NULL));
+    ExpectIntEQ(wolfSSL_uring_submit(NULL), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_uring_submit(ring), 0);
+    ExpectIntEQ(wolfSSL_uring_wait(NULL, ready, 4, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_uring_wait(ring, NULL, 4, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_uring_wait(ring, ready, 0, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_uring_wait(ring, ready, 4, 0), 0);
+
+#ifdef WOLFSSL_TLS13
+    ExpectNotNull(ctx_c = wolfSSL_CTX_new(wolfTLSv1_3_client_method()));
+    ExpectNotNull(ctx_s = wolfSSL_CTX_new(wolfTLSv1_3_server_method()));
+#else
+    ExpectNotNull(ctx_c = wolfSSL_CTX_new(wolfTLSv1_2_client_method()));
+    ExpectNotNull(ctx_s = wolfSSL_CTX_new(wolfTLSv1_2_server_method()));
+#endif
+    ExpectIntEQ(wolfSSL_CTX_load_verify_locations(ctx_c, caCertFile, 0),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_use_certificate_file(ctx_s, svrCertFile,
+        WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_use_PrivateKey_file(ctx_s, svrKeyFile,
+        WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_SetIO_uring(NULL, ring), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_SetIO_uring(ctx_s, NULL), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_SetIO_uring(ctx_s, ring), WOLFSSL_SUCCESS);
+
+    ExpectIntEQ(test_loopback_sockets(&c, &s), TEST_SUCCESS);
+    ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+    ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+    ExpectIntEQ(wolfSSL_SetIO_uring(NULL, ring), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_SetIO_uring(ssl_c, NULL), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_SetIO_uring(ssl_c, ring), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_set_fd(ssl_c, c), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_set_fd(ssl_s, s), WOLFSSL_SUCCESS);
+
+    /* Start both handshakes, then resume whichever the ring reports. */
+    ExpectIntEQ(ret_c = wolfSSL_connect(ssl_c), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_get_error(ssl_c, ret_c), WOLFSSL_ERROR_WANT_READ);
+    ExpectIntEQ(ret_s = wolfSSL_accept(ssl_s), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_get_error(ssl_s, ret_s), WOLFSSL_ERROR_WANT_READ);
+    for (i = 0; EXPECT_SUCCESS() && i < 1000 &&
+            (ret_c != WOLFSSL_SUCCESS || ret_s != WOLFSSL_SUCCESS); i++) {
+        ExpectIntGE(n = wolfSSL_uring_wait(ring, ready, 4, 1000), 0);
+        for (j = 0; j < n; j++) {
+            if (ready[j] == ssl_c && ret_c != WOLFSSL_SUCCESS) {
+                ret_c = wolfSSL_connect(ssl_c);
+                if (ret_c != WOLFSSL_SUCCESS) {
+                    err = wolfSSL_get_error(ssl_c, ret_c);
+                    ExpectTrue(err == WOLFSSL_ERROR_WANT_READ ||
+                               err == WOLFSSL_ERROR_WANT_WRITE);
+                }
+            }
+            else if (ready[j] == ssl_s && ret_s != WOLFSSL_SUCCESS) {
+                ret_s = wolfSSL_accept(ssl_s);
+                if (ret_s != WOLFSSL_SUCCESS) {
+                    err = wolfSSL_get_error(ssl_s, ret_s);
+                    ExpectTrue(err == WOLFSSL_ERROR_WANT_READ ||
+                               err == WOLFSSL_ERROR_WANT_WRITE);
+                }
+            }
+        }
+    }
+    ExpectIntEQ(ret_c, WOLFSSL_SUCCESS);
+    ExpectIntEQ(ret_s, WOLFSSL_SUCCESS);
+
+    /* More than fits in the send area at once. */
+    for (i = 0; EXPECT_SUCCESS() && i < 10000 && got < dataSz; i++) {
+        int ret;
+
+        if (sent < dataSz) {
+            ret = wolfSSL_write(ssl_c, data + sent, dataSz - sent);
+            if (ret > 0)
+                sent += ret;
+            else {
+                ExpectIntEQ(wolfSSL_get_error(ssl_c, ret),
+                    WOLFSSL_ERROR_WANT_WRITE);
+            }
+        }
+        ret = wolfSSL_read(ssl_s, rcvd + got, dataSz - got);
+        if (ret > 0)
+            got += ret;
+        else {
+            ExpectIntEQ(wolfSSL_get_error(ssl_s, ret),
+                WOLFSSL_ERROR_WANT_READ);
+            ExpectIntGE(wolfSSL_uring_wait(ring, ready, 4, 1000), 0);
+        }
+    }
+    ExpectIntEQ(sent, dataSz);
+    ExpectIntEQ(got, dataSz);
+    ExpectBufEQ(rcvd, data, dataSz);
+
+    /* Both connections of the ring are taken. */
+    ExpectNotNull(ssl_x = wolfSSL_new(ctx_s));
+    ExpectIntEQ(wolfSSL_set_fd(ssl_x, s), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_accept(ssl_x), WOLFSSL_FATAL_ERROR);
+    ExpectIntEQ(wolfSSL_get_error(ssl_x, WOLFSSL_FATAL_ERROR),
+        SOCKET_ERROR_E);
+    wolfSSL_free(ssl_x);
+
+    /* Peer closing shows as the end of the connection. */
+    wolfSSL_free(ssl_c);
+    ssl_c = NULL;
+    if (c != SOCKET_INVALID)
+        CloseSocket(c);
+    c = SOCKET_INVALID;
+    for (i = 0; EXPECT_SUCCESS() && i < 1000; i++) {
+        int ret = wolfSSL_read(ssl_s, rcvd, dataSz);
+
+        if (wolfSSL_get_error(ssl_s, ret) != WOLFSSL_ERROR_WANT_READ) {
+            ExpectIntLE(ret, 0);
+            break;
+        }
+        ExpectIntGE(wolfSSL_uring_wait(ring, ready, 4, 1000), 0);
+    }
+    ExpectIntLT(i, 1000);
+
+    wolfSSL_free(ssl_c);
+    wolfSSL_free(ssl_s);
+    wolfSSL_uring_free(ring);
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+    if (c != SOCKET_INVALID)
+        CloseSocket(c);
+    if (s != SOCKET_INVALID)
+        CloseSocket(s);
+    XFREE(data, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(rcvd, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+    return EXPECT_RESULT();
+}
+
 #if !defined(NO_FILESYSTEM) && !defined(NO_WOLFSSL_SERVER) && \
     (!defined(NO_RSA) || defined(HAVE_ECC))
 /* Called when writing. */
@@ -13411,6 +15037,105 @@ static int test_wc_Sha256Copy(void)
 #endif
     return EXPECT_RESULT();
 } /* END test_wc_Sha256Copy */
+
+#ifdef WOLFSSL_SHA256_MB
+#define SHA256_MB_TEST_MSGS 140
+/* Hash messages of many lengths with the multi-buffer API and compare with
+ * the single buffer API. */
+static int test_wc_Sha256_MB_lanes(const byte* data, int* lanes)
+{
+    EXPECT_DECLS;
+    wc_Sha256_MB mb;
+    byte   hash[SHA256_MB_TEST_MSGS][WC_SHA256_DIGEST_SIZE];
+    byte   exp[WC_SHA256_DIGEST_SIZE];
+    word32 len;
+    int    i;
+
+    ExpectIntEQ(wc_Sha256_MB_Init(&mb, HEAP_HINT, INVALID_DEVID), 0);
+    *lanes = wc_Sha256_MB_Lanes(&mb);
+
+    /* 0 to 129 bytes, crossing the one and two pad block boundary, and
+     * some longer messages */
+    for (i = 0; i < SHA256_MB_TEST_MSGS; i++) {
+        len = (i < 130) ? (word32)i : (word32)(1000 + (i - 130) * 309);
+        ExpectIntEQ(wc_Sha256_MB_Submit(&mb, data + i, len, hash[i]), 0);
+    }
+    ExpectIntEQ(wc_Sha256_MB_Flush(&mb), 0);
+
+    for (i = 0; i < SHA256_MB_TEST_MSGS; i++) {
+        len = (i < 130) ? (word32)i : (word32)(1000 + (i - 130) * 309);
+        ExpectIntEQ(wc_Sha256Hash(data + i, len, exp), 0);
+        ExpectBufEQ(hash[i], exp, WC_SHA256_DIGEST_SIZE);
+    }
+
+    /* flush of nothing and submit after flush */
+    ExpectIntEQ(wc_Sha256_MB_Flush(&mb), 0);
+    ExpectIntEQ(wc_Sha256_MB_Submit(&mb, NULL, 0, hash[0]), 0);
+    ExpectIntEQ(wc_Sha256_MB_Flush(&mb), 0);
+    ExpectIntEQ(wc_Sha256Hash(NULL, 0, exp), 0);
+    ExpectBufEQ(hash[0], exp, WC_SHA256_DIGEST_SIZE);
+
+    wc_Sha256_MB_Free(&mb);
+    return EXPECT_RESULT();
+}
+#endif
+
+/*
+ * Unit test function for wc_Sha256_MB_*()
+ */
+static int test_wc_Sha256_MB(void)
+{
+    EXPECT_DECLS;
+#if !defined(NO_SHA256) && defined(WOLFSSL_SHA256_MB)
+    wc_Sha256_MB mb;
+    byte*  data = NULL;
+    byte   hash[WC_SHA256_DIGEST_SIZE];
+    int    lanes = 0;
+#ifdef HAVE_CPUID_INTEL
+    int    had512 = 0;
+#endif
+    int    i;
+
+    ExpectNotNull(data = (byte*)XMALLOC(4096 + SHA256_MB_TEST_MSGS, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    for (i = 0; data != NULL && i < 4096 + SHA256_MB_TEST_MSGS; i++)
+        data[i] = (byte)(i * 7 + (i >> 8));
+
+    ExpectIntEQ(test_wc_Sha256_MB_lanes(data, &lanes), TEST_SUCCESS);
+#ifdef HAVE_CPUID_INTEL
+    /* hash with each narrower engine too */
+    if (lanes == 16) {
+        had512 = 1;
+        cpuid_clear_flag(CPUID_AVX512);
+        ExpectIntEQ(test_wc_Sha256_MB_lanes(data, &lanes), TEST_SUCCESS);
+        ExpectIntEQ(lanes, 8);
+    }
+    if (lanes == 8) {
+        cpuid_clear_flag(CPUID_AVX2);
+        ExpectIntEQ(test_wc_Sha256_MB_lanes(data, &lanes), TEST_SUCCESS);
+        cpuid_set_flag(CPUID_AVX2);
+        ExpectIntEQ(lanes, 1);
+    }
+    if (had512)
+        cpuid_set_flag(CPUID_AVX512);
+#endif
+
+    /* Test bad args. */
+    ExpectIntEQ(wc_Sha256_MB_Init(NULL, HEAP_HINT, INVALID_DEVID),
+        BAD_FUNC_ARG);
+    ExpectIntEQ(wc_Sha256_MB_Lanes(NULL), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_Sha256_MB_Init(&mb, HEAP_HINT, INVALID_DEVID), 0);
+    ExpectIntEQ(wc_Sha256_MB_Submit(NULL, data, 1, hash), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_Sha256_MB_Submit(&mb, NULL, 1, hash), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_Sha256_MB_Submit(&mb, data, 1, NULL), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_Sha256_MB_Flush(NULL), BAD_FUNC_ARG);
+    wc_Sha256_MB_Free(&mb);
+    wc_Sha256_MB_Free(NULL);
+
+    XFREE(data, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+    return EXPECT_RESULT();
+} /* END test_wc_Sha256_MB */
 /*
  * Testing wc_InitSha512()
  */
@@ -15325,6 +17050,170 @@ static int test_wc_Shake256Hash(void)
     return EXPECT_RESULT();
 }  /* END test_wc_Shake256Hash */
 
+#if defined(WOLFSSL_SHA3) && \
+    (defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)) && \
+    !defined(WOLFSSL_XILINX_CRYPT) && !defined(WOLFSSL_AFALG_XILINX_SHA3)
+#define SHAKE_X4_TEST_BLOCKS    3
+
+/* Compare four SHAKE streams computed together against one at a time. */
+static int test_wc_Shake_x4_streams(int shake256, const byte* data)
+{
+    EXPECT_DECLS;
+    static const word32 lens[] = { 0, 1, 33, 135, 136, 167, 168, 169, 400 };
+    wc_Shake_x4 x4;
+    wc_Shake    shake;
+    byte*       out = NULL;
+    byte*       exp = NULL;
+    const byte* in[WC_SHAKE_X4_LANES];
+    byte*       outs[WC_SHAKE_X4_LANES];
+    word32      rate = shake256 ? WC_SHA3_256_COUNT * 8 :
+                                  WC_SHA3_128_COUNT * 8;
+    word32      sz = rate * SHAKE_X4_TEST_BLOCKS;
+    int         i;
+    int         j;
+
+    ExpectNotNull(out = (byte*)XMALLOC(sz * WC_SHAKE_X4_LANES, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    ExpectNotNull(exp = (byte*)XMALLOC(sz, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER));
+
+    for (i = 0; EXPECT_SUCCESS() && i < (int)(sizeof(lens) / sizeof(*lens));
+            i++) {
+        for (j = 0; j < WC_SHAKE_X4_LANES; j++) {
+            in[j] = data + j * 7 + i;
+            outs[j] = out + j * sz;
+        }
+        if (shake256) {
+        #ifdef WOLFSSL_SHAKE256
+            ExpectIntEQ(wc_InitShake256_x4(&x4, HEAP_HINT, INVALID_DEVID), 0);
+            ExpectIntEQ(wc_Shake256_x4_Absorb(&x4, in, lens[i]), 0);
+            ExpectIntEQ(wc_Shake256_x4_SqueezeBlocks(&x4, outs, 1), 0);
+            for (j = 0; j < WC_SHAKE_X4_LANES; j++)
+                outs[j] += rate;
+            ExpectIntEQ(wc_Shake256_x4_SqueezeBlocks(&x4, outs,
+                SHAKE_X4_TEST_BLOCKS - 1), 0);
+            wc_Shake256_x4_Free(&x4);
+        #endif
+        }
+        else {
+        #ifdef WOLFSSL_SHAKE128
+            ExpectIntEQ(wc_InitShake128_x4(&x4, HEAP_HINT, INVALID_DEVID), 0);
+            ExpectIntEQ(wc_Shake128_x4_Absorb(&x4, in, lens[i]), 0);
+            ExpectIntEQ(wc_Shake128_x4_SqueezeBlocks(&x4, outs, 1), 0);
+            for (j = 0; j < WC_SHAKE_X4_LANES; j++)
+                outs[j] += rate;
+            ExpectIntEQ(wc_Shake128_x4_SqueezeBlocks(&x4, outs,
+                SHAKE_X4_TEST_BLOCKS - 1), 0);
+            wc_Shake128_x4_Free(&x4);
+        #endif
+        }
+
+        for (j = 0; EXPECT_SUCCESS() && j < WC_SHAKE_X4_LANES; j++) {
+            if (shake256) {
+            #ifdef WOLFSSL_SHAKE256
+                ExpectIntEQ(wc_InitShake256(&shake, HEAP_HINT, INVALID_DEVID),
+                    0);
+                ExpectIntEQ(wc_Shake256_Absorb(&shake, in[j], lens[i]), 0);
+                ExpectIntEQ(wc_Shake256_SqueezeBlocks(&shake, exp,
+                    SHAKE_X4_TEST_BLOCKS), 0);
+                wc_Shake256_Free(&shake);
+            #endif
+            }
+            else {
+            #ifdef WOLFSSL_SHAKE128
+                ExpectIntEQ(wc_InitShake128(&shake, HEAP_HINT, INVALID_DEVID),
+                    0);
+                ExpectIntEQ(wc_Shake128_Absorb(&shake, in[j], lens[i]), 0);
+                ExpectIntEQ(wc_Shake128_SqueezeBlocks(&shake, exp,
+                    SHAKE_X4_TEST_BLOCKS), 0);
+                wc_Shake128_Free(&shake);
+            #endif
+            }
+            ExpectBufEQ(out + j * sz, exp, sz);
+        }
+    }
+
+    XFREE(exp, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(out, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    return EXPECT_RESULT();
+}
+#endif
+
+/*
+ *  Testing wc_InitShake128_x4(), wc_Shake128_x4_Absorb(),
+ *  wc_Shake128_x4_SqueezeBlocks() and the SHAKE256 equivalents.
+ */
+static int test_wc_Shake_x4(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_SHA3) && \
+    (defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)) && \
+    !defined(WOLFSSL_XILINX_CRYPT) && !defined(WOLFSSL_AFALG_XILINX_SHA3)
+    wc_Shake_x4 x4;
+    byte  data[512];
+    int   simd = 0;
+    int   shake256;
+    int   i;
+
+    for (i = 0; i < (int)sizeof(data); i++)
+        data[i] = (byte)(i * 13 + 5);
+
+    XMEMSET(&x4, 0, sizeof(x4));
+#ifdef WOLFSSL_SHAKE128
+    ExpectIntEQ(wc_InitShake128_x4(&x4, HEAP_HINT, INVALID_DEVID), 0);
+#else
+    ExpectIntEQ(wc_InitShake256_x4(&x4, HEAP_HINT, INVALID_DEVID), 0);
+#endif
+    simd = x4.simd;
+
+    for (shake256 = 0; shake256 <= 1; shake256++) {
+    #ifndef WOLFSSL_SHAKE128
+        if (!shake256)
+            continue;
+    #endif
+    #ifndef WOLFSSL_SHAKE256
+        if (shake256)
+            continue;
+    #endif
+        ExpectIntEQ(test_wc_Shake_x4_streams(shake256, data), TEST_SUCCESS);
+    #ifdef HAVE_CPUID_INTEL
+        /* Permute the states one at a time too. */
+        if (simd) {
+            cpuid_clear_flag(CPUID_AVX2);
+            ExpectIntEQ(test_wc_Shake_x4_streams(shake256, data),
+                TEST_SUCCESS);
+            cpuid_set_flag(CPUID_AVX2);
+        }
+    #endif
+    }
+    (void)simd;
+
+#ifdef WOLFSSL_SHAKE128
+    {
+        const byte* in[WC_SHAKE_X4_LANES] = { data, data, data, NULL };
+        byte*       outs[WC_SHAKE_X4_LANES] = { data, data, data, NULL };
+
+        /* Test bad args. */
+        ExpectIntEQ(wc_InitShake128_x4(NULL, HEAP_HINT, INVALID_DEVID),
+            BAD_FUNC_ARG);
+        ExpectIntEQ(wc_InitShake128_x4(&x4, HEAP_HINT, INVALID_DEVID), 0);
+        ExpectIntEQ(wc_Shake128_x4_Absorb(NULL, in, 1), BAD_FUNC_ARG);
+        ExpectIntEQ(wc_Shake128_x4_Absorb(&x4, NULL, 1), BAD_FUNC_ARG);
+        ExpectIntEQ(wc_Shake128_x4_Absorb(&x4, in, 1), BAD_FUNC_ARG);
+        ExpectIntEQ(wc_Shake128_x4_SqueezeBlocks(NULL, outs, 1),
+            BAD_FUNC_ARG);
+        ExpectIntEQ(wc_Shake128_x4_SqueezeBlocks(&x4, NULL, 1),
+            BAD_FUNC_ARG);
+        ExpectIntEQ(wc_Shake128_x4_SqueezeBlocks(&x4, outs, 1),
+            BAD_FUNC_ARG);
+        wc_Shake128_x4_Free(&x4);
+        wc_Shake128_x4_Free(NULL);
+    }
+#endif
+#endif
+    return EXPECT_RESULT();
+}  /* END test_wc_Shake_x4 */
+
 
 /*
  *  Testing wc_InitSm3(), wc_Sm3Free()
@@ -18603,6 +20492,149 @@ static int test_wc_AesGcmMixedEncDecLongIV(void)
 
 } /* END wc_AesGcmMixedEncDecLongIV */
 
+/*
+ * Testing wc_AesGcmEncryptMulti() and wc_AesGcmDecryptMulti()
+ */
+static int test_wc_AesGcmEncryptMulti(void)
+{
+    EXPECT_DECLS;
+#if !defined(NO_AES) && defined(HAVE_AESGCM) && \
+    defined(WOLFSSL_AESGCM_MULTI) && defined(HAVE_AES_DECRYPT)
+    /* Sizes covering empty, partial and whole blocks, and long messages. */
+    static const word32 sizes[] = {
+        0, 1, 15, 16, 17, 31, 64, 100, 256, 1350, 3000, 33, 48, 1, 500, 64,
+        1400, 2, 0, 80, 80, 80, 80, 16, 16, 16, 16, 17, 1, 0, 64, 128
+    };
+    static const byte key[32] = {
+        0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+        0x38, 0x39, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66,
+        0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+        0x38, 0x39, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66
+    };
+    static const word32 keySz[] = {
+    #ifdef WOLFSSL_AES_128
+        16,
+    #endif
+    #ifdef WOLFSSL_AES_192
+        24,
+    #endif
+    #ifdef WOLFSSL_AES_256
+        32,
+    #endif
+    };
+    #define MULTI_JOBS  (int)(sizeof(sizes) / sizeof(*sizes))
+    #define MULTI_KEYS  (int)(sizeof(keySz) / sizeof(*keySz))
+    #define MULTI_MAX   3000
+    Aes* aes = NULL;
+    wc_AesGcmJob jobs[MULTI_JOBS];
+    byte iv[MULTI_JOBS][GCM_NONCE_MAX_SZ];
+    byte tag[MULTI_JOBS][AES_BLOCK_SIZE];
+    byte expTag[AES_BLOCK_SIZE];
+    byte aad[64];
+    byte* in = NULL;
+    byte* out = NULL;
+    byte* exp = NULL;
+    int i;
+
+    XMEMSET(jobs, 0, sizeof(jobs));
+    for (i = 0; i < (int)sizeof(aad); i++)
+        aad[i] = (byte)(i * 7);
+
+    ExpectNotNull(aes = (Aes*)XMALLOC(MULTI_JOBS * sizeof(Aes), HEAP_HINT,
+        DYNAMIC_TYPE_AES));
+    ExpectNotNull(in = (byte*)XMALLOC(MULTI_MAX, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    ExpectNotNull(out = (byte*)XMALLOC(MULTI_JOBS * MULTI_MAX, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    ExpectNotNull(exp = (byte*)XMALLOC(MULTI_MAX, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    for (i = 0; (in != NULL) && (i < MULTI_MAX); i++)
+        in[i] = (byte)i;
+
+    /* A different key for each job. Runs of jobs with the same key size are
+     * processed together - a full group and a part filled group. */
+    for (i = 0; (aes != NULL) && (i < MULTI_JOBS); i++) {
+        word32 kSz = keySz[(i < 18) ? 0 : (MULTI_KEYS - 1)];
+
+        XMEMSET(&aes[i], 0, sizeof(Aes));
+        ExpectIntEQ(wc_AesInit(&aes[i], HEAP_HINT, INVALID_DEVID), 0);
+        ExpectIntEQ(wc_AesGcmSetKey(&aes[i], key + (i % (int)(33 - kSz)),
+            kSz), 0);
+    }
+#ifdef WOLFSSL_AESGCM_STREAM
+    /* Streaming leaves its own form of the hash key in the object. */
+    ExpectIntEQ(wc_AesGcmEncryptInit(&aes[1], NULL, 0, iv[1],
+        GCM_NONCE_MID_SZ), 0);
+    ExpectIntEQ(wc_AesGcmEncryptUpdate(&aes[1], expTag, in, AES_BLOCK_SIZE,
+        aad, 5), 0);
+    ExpectIntEQ(wc_AesGcmEncryptFinal(&aes[1], expTag, AES_BLOCK_SIZE), 0);
+#endif
+
+    /* Test bad args. */
+    ExpectIntEQ(wc_AesGcmEncryptMulti(NULL, 1), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_AesGcmDecryptMulti(NULL, 1), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_AesGcmEncryptMulti(NULL, 0), 0);
+
+    for (i = 0; (aes != NULL) && (out != NULL) && (i < MULTI_JOBS); i++) {
+        XMEMSET(iv[i], i, sizeof(iv[i]));
+        jobs[i].aes = &aes[i];
+        jobs[i].out = out + i * MULTI_MAX;
+        jobs[i].in = in;
+        jobs[i].sz = sizes[i];
+        jobs[i].iv = iv[i];
+        /* One job with a long IV. */
+        jobs[i].ivSz = (i == 5) ? GCM_NONCE_MAX_SZ : GCM_NONCE_MID_SZ;
+        jobs[i].authTag = tag[i];
+        jobs[i].authTagSz = (i == 7) ? 12 : AES_BLOCK_SIZE;
+        jobs[i].authIn = aad;
+        jobs[i].authInSz = (word32)((i * 13) % (int)sizeof(aad));
+    }
+    ExpectIntEQ(wc_AesGcmEncryptMulti(jobs, MULTI_JOBS), 0);
+
+    /* Each job must match a one-shot encryption. */
+    for (i = 0; (i < MULTI_JOBS) && EXPECT_SUCCESS(); i++) {
+        ExpectIntEQ(jobs[i].ret, 0);
+        ExpectIntEQ(wc_AesGcmEncrypt(jobs[i].aes, exp, in, jobs[i].sz,
+            jobs[i].iv, jobs[i].ivSz, expTag, jobs[i].authTagSz, aad,
+            jobs[i].authInSz), 0);
+        ExpectBufEQ(jobs[i].out, exp, jobs[i].sz);
+        ExpectBufEQ(jobs[i].authTag, expTag, jobs[i].authTagSz);
+    }
+
+    /* Decrypt in place and check a corrupted tag only fails its job. */
+    for (i = 0; i < MULTI_JOBS; i++)
+        jobs[i].in = jobs[i].out;
+    tag[3][0] ^= 0x80;
+    ExpectIntEQ(wc_AesGcmDecryptMulti(jobs, MULTI_JOBS), AES_GCM_AUTH_E);
+    for (i = 0; (i < MULTI_JOBS) && EXPECT_SUCCESS(); i++) {
+        if (i == 3) {
+            ExpectIntEQ(jobs[i].ret, AES_GCM_AUTH_E);
+            continue;
+        }
+        ExpectIntEQ(jobs[i].ret, 0);
+        ExpectBufEQ(jobs[i].out, in, jobs[i].sz);
+    }
+
+    /* A bad job is reported without stopping the others. */
+    jobs[1].ivSz = 0;
+    ExpectIntEQ(wc_AesGcmEncryptMulti(jobs, MULTI_JOBS), BAD_FUNC_ARG);
+    ExpectIntEQ(jobs[1].ret, BAD_FUNC_ARG);
+    ExpectIntEQ(jobs[2].ret, 0);
+
+    for (i = 0; (aes != NULL) && (i < MULTI_JOBS); i++)
+        wc_AesFree(&aes[i]);
+    XFREE(aes, HEAP_HINT, DYNAMIC_TYPE_AES);
+    XFREE(exp, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(out, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(in, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    #undef MULTI_JOBS
+    #undef MULTI_KEYS
+    #undef MULTI_MAX
+#endif
+    return EXPECT_RESULT();
+
+} /* END test_wc_AesGcmEncryptMulti */
+
 /*
  * unit test for wc_GmacSetKey()
  */
@@ -19291,6 +21323,70 @@ static int test_wc_MakeRsaKey(void)
     return EXPECT_RESULT();
 } /* END test_wc_MakeRsaKey */
 
+/*
+ * Testing wc_RsaSetKeyGenThreads() and wc_DhSetParamGenThreads()
+ */
+static int test_wc_KeyGenThreads(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_KEY_GEN) && defined(WOLFSSL_KEYGEN_THREADS)
+    WC_RNG rng;
+#ifndef NO_RSA
+    RsaKey genKey;
+#endif
+#ifndef NO_DH
+    DhKey  dh;
+    byte   priv[128];
+    byte   pub[128];
+    word32 privSz = (word32)sizeof(priv);
+    word32 pubSz = (word32)sizeof(pub);
+#endif
+
+    XMEMSET(&rng, 0, sizeof(WC_RNG));
+    ExpectIntEQ(wc_InitRng(&rng), 0);
+
+#ifndef NO_RSA
+    XMEMSET(&genKey, 0, sizeof(RsaKey));
+    ExpectIntEQ(wc_InitRsaKey(&genKey, HEAP_HINT), 0);
+
+    /* Test bad args. */
+    ExpectIntEQ(wc_RsaSetKeyGenThreads(NULL, 2), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_RsaSetKeyGenThreads(&genKey, -1), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_RsaSetKeyGenThreads(&genKey,
+        WOLFSSL_KEYGEN_MAX_THREADS + 1), BAD_FUNC_ARG);
+
+    ExpectIntEQ(wc_RsaSetKeyGenThreads(&genKey, 4), 0);
+    ExpectIntEQ(MAKE_RSA_KEY(&genKey, 2048, WC_RSA_EXPONENT, &rng), 0);
+#ifdef WOLFSSL_RSA_KEY_CHECK
+    ExpectIntEQ(wc_CheckRsaKey(&genKey), 0);
+#endif
+    DoExpectIntEQ(wc_FreeRsaKey(&genKey), 0);
+#endif
+
+#ifndef NO_DH
+    XMEMSET(&dh, 0, sizeof(DhKey));
+    ExpectIntEQ(wc_InitDhKey(&dh), 0);
+
+    /* Test bad args. */
+    ExpectIntEQ(wc_DhSetParamGenThreads(NULL, 2), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_DhSetParamGenThreads(&dh, -1), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_DhSetParamGenThreads(&dh,
+        WOLFSSL_KEYGEN_MAX_THREADS + 1), BAD_FUNC_ARG);
+
+    ExpectIntEQ(wc_DhSetParamGenThreads(&dh, 3), 0);
+    ExpectIntEQ(wc_DhGenerateParams(&rng, 1024, &dh), 0);
+    /* Public value must be in the subgroup of order q. */
+    ExpectIntEQ(wc_DhGenerateKeyPair(&dh, &rng, priv, &privSz, pub, &pubSz),
+        0);
+    ExpectIntEQ(wc_DhCheckPubKey_ex(&dh, pub, pubSz, NULL, 0), 0);
+    DoExpectIntEQ(wc_FreeDhKey(&dh), 0);
+#endif
+
+    DoExpectIntEQ(wc_FreeRng(&rng), 0);
+#endif
+    return EXPECT_RESULT();
+} /* END test_wc_KeyGenThreads */
+
 /*
  * Test the bounds checking on the cipher text versus the key modulus.
  * 1. Make a new RSA key.
@@ -19965,6 +22061,77 @@ static int test_wc_RsaSSL_SignVerify(void)
 
 } /* END test_wc_RsaSSL_SignVerify */
 
+/*
+ * Testing wc_RsaPrepareKey()
+ */
+static int test_wc_RsaPrepareKey(void)
+{
+    EXPECT_DECLS;
+#if !defined(NO_RSA) && defined(WC_RSA_PREPARED) && \
+    defined(USE_CERT_BUFFERS_2048)
+    RsaKey key;
+    RsaKey pubKey;
+    WC_RNG rng;
+    const byte in[] = TEST_STRING;
+    const word32 inLen = (word32)TEST_STRING_SZ;
+    byte   expSig[256];
+    byte   sig[256];
+    byte   plain[256];
+    word32 idx;
+    int    i;
+
+    XMEMSET(&key, 0, sizeof(RsaKey));
+    XMEMSET(&pubKey, 0, sizeof(RsaKey));
+    XMEMSET(&rng, 0, sizeof(WC_RNG));
+
+    ExpectIntEQ(wc_InitRng(&rng), 0);
+    ExpectIntEQ(wc_InitRsaKey(&key, HEAP_HINT), 0);
+    ExpectIntEQ(wc_InitRsaKey(&pubKey, HEAP_HINT), 0);
+
+    /* Public key can't be prepared. */
+    idx = 0;
+    ExpectIntEQ(wc_RsaPublicKeyDecode(client_keypub_der_2048, &idx, &pubKey,
+        sizeof_client_keypub_der_2048), 0);
+    ExpectIntEQ(wc_RsaPrepareKey(&pubKey, &rng), BAD_FUNC_ARG);
+
+    idx = 0;
+    ExpectIntEQ(wc_RsaPrivateKeyDecode(client_key_der_2048, &idx, &key,
+        sizeof_client_key_der_2048), 0);
+
+    /* Bad args. */
+    ExpectIntEQ(wc_RsaPrepareKey(NULL, &rng), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_RsaPrepareKey(&key, NULL), BAD_FUNC_ARG);
+
+    /* PKCS #1 v1.5 signatures are deterministic - blinding must not change
+     * the result. */
+    ExpectIntEQ(wc_RsaSSL_Sign(in, inLen, expSig, sizeof(expSig), &key,
+        &rng), (int)sizeof(expSig));
+
+    ExpectIntEQ(wc_RsaPrepareKey(&key, &rng), 0);
+    /* Enough operations to generate a new blinding pair. */
+    for (i = 0; (i < 40) && EXPECT_SUCCESS(); i++) {
+        ExpectIntEQ(wc_RsaSSL_Sign(in, inLen, sig, sizeof(sig), &key, &rng),
+            (int)sizeof(sig));
+        ExpectBufEQ(sig, expSig, sizeof(expSig));
+    }
+    ExpectIntEQ(wc_RsaSSL_Verify(sig, sizeof(sig), plain, sizeof(plain),
+        &pubKey), (int)inLen);
+    ExpectBufEQ(plain, in, inLen);
+
+    /* Preparing again replaces cached values. */
+    ExpectIntEQ(wc_RsaPrepareKey(&key, &rng), 0);
+    ExpectIntEQ(wc_RsaSSL_Sign(in, inLen, sig, sizeof(sig), &key, &rng),
+        (int)sizeof(sig));
+    ExpectBufEQ(sig, expSig, sizeof(expSig));
+
+    DoExpectIntEQ(wc_FreeRsaKey(&pubKey), 0);
+    DoExpectIntEQ(wc_FreeRsaKey(&key), 0);
+    DoExpectIntEQ(wc_FreeRng(&rng), 0);
+#endif
+    return EXPECT_RESULT();
+
+} /* END test_wc_RsaPrepareKey */
+
 /*
  * Testing wc_RsaEncryptSize()
  */
@@ -22370,6 +24537,268 @@ static int test_wc_ed25519_sign_msg(void)
 
 } /* END test_wc_ed25519_sign_msg */
 
+#if defined(HAVE_ED25519) && defined(HAVE_ED25519_SIGN) && \
+    defined(HAVE_ED25519_VERIFY) && defined(HAVE_ED25519_MAKE_KEY) && \
+    defined(HAVE_ED25519_KEY_EXPORT) && defined(WOLFSSL_PUBLIC_MP) && \
+    (!defined(WOLFSSL_SP_MATH) || defined(WOLFSSL_SP_MATH_ALL)) && \
+    (!defined(SP_INT_BITS) || SP_INT_BITS >= 1024)
+#define TEST_ED25519_TORSION_R
+
+/* Little endian bytes to and from an mp_int. */
+static int test_ed25519_read_le(mp_int* a, const byte* in, int sz)
+{
+    byte be[WC_SHA512_DIGEST_SIZE];
+    int  i;
+
+    for (i = 0; i < sz; i++)
+        be[i] = in[sz - 1 - i];
+    return mp_read_unsigned_bin(a, be, (word32)sz);
+}
+
+static int test_ed25519_write_le(mp_int* a, byte* out, int sz)
+{
+    byte be[ED25519_KEY_SIZE];
+    int  i;
+    int  ret = mp_to_unsigned_bin_len(a, be, sz);
+
+    for (i = 0; ret == 0 && i < sz; i++)
+        out[i] = be[sz - 1 - i];
+    return ret;
+}
+
+/* Sign msg with R replaced by R + T, T the point of order 2, and S made to
+ * match: S.B - k.A - R' is -T, so the cofactorless verify rejects it.
+ * With shift 0 the normal signature is calculated again.
+ */
+static int test_ed25519_sign_torsion_r(ed25519_key* key, const byte* msg,
+    word32 msgLen, byte* sig, int shift)
+{
+    EXPECT_DECLS;
+    /* order of the base point, big endian */
+    static const byte order[ED25519_KEY_SIZE] = {
+        0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x14, 0xde, 0xf9, 0xde, 0xa2, 0xf7, 0x9c, 0xd6,
+        0x58, 0x12, 0x63, 0x1a, 0x5c, 0xf5, 0xd3, 0xed
+    };
+    byte    seed[ED25519_KEY_SIZE];
+    byte    pub[ED25519_PUB_KEY_SIZE];
+    byte    az[WC_SHA512_DIGEST_SIZE];
+    byte    nonce[WC_SHA512_DIGEST_SIZE];
+    byte    h[WC_SHA512_DIGEST_SIZE];
+    word32  sz;
+    word32  sigSz = ED25519_SIG_SIZE;
+    wc_Sha512 sha;
+    mp_int  l, r, k, a;
+    int     borrow = 0;
+    int     i;
+
+    XMEMSET(&l, 0, sizeof(l));
+    XMEMSET(&r, 0, sizeof(r));
+    XMEMSET(&k, 0, sizeof(k));
+    XMEMSET(&a, 0, sizeof(a));
+    ExpectIntEQ(wc_ed25519_sign_msg(msg, msgLen, sig, &sigSz, key), 0);
+    sz = sizeof(seed);
+    ExpectIntEQ(wc_ed25519_export_private_only(key, seed, &sz), 0);
+    sz = sizeof(pub);
+    ExpectIntEQ(wc_ed25519_export_public(key, pub, &sz), 0);
+
+    /* secret scalar and the nonce the signer used */
+    ExpectIntEQ(wc_Sha512Hash(seed, sizeof(seed), az), 0);
+    az[0] &= 248;
+    az[31] &= 63;
+    az[31] |= 64;
+    ExpectIntEQ(wc_InitSha512(&sha), 0);
+    ExpectIntEQ(wc_Sha512Update(&sha, az + ED25519_KEY_SIZE,
+        ED25519_KEY_SIZE), 0);
+    ExpectIntEQ(wc_Sha512Update(&sha, msg, msgLen), 0);
+    ExpectIntEQ(wc_Sha512Final(&sha, nonce), 0);
+    wc_Sha512Free(&sha);
+
+    if (shift) {
+        /* R + (0,-1) = (-x,-y): y becomes p - y and the sign of x flips */
+        int sign = sig[ED25519_KEY_SIZE-1] & 0x80;
+
+        sig[ED25519_KEY_SIZE-1] &= 0x7f;
+        for (i = 0; i < ED25519_KEY_SIZE; i++) {
+            int p = (i == 0) ? 0xed : ((i == ED25519_KEY_SIZE-1) ? 0x7f : 0xff);
+            int d = p - sig[i] - borrow;
+
+            borrow = d < 0;
+            sig[i] = (byte)d;
+        }
+        sig[ED25519_KEY_SIZE-1] |= (byte)(sign ^ 0x80);
+    }
+
+    ExpectIntEQ(wc_InitSha512(&sha), 0);
+    ExpectIntEQ(wc_Sha512Update(&sha, sig, ED25519_KEY_SIZE), 0);
+    ExpectIntEQ(wc_Sha512Update(&sha, pub, sizeof(pub)), 0);
+    ExpectIntEQ(wc_Sha512Update(&sha, msg, msgLen), 0);
+    ExpectIntEQ(wc_Sha512Final(&sha, h), 0);
+    wc_Sha512Free(&sha);
+
+    /* S = r + k.a mod order */
+    ExpectIntEQ(mp_init_multi(&l, &r, &k, &a, NULL, NULL), 0);
+    ExpectIntEQ(mp_read_unsigned_bin(&l, order, sizeof(order)), 0);
+    ExpectIntEQ(test_ed25519_read_le(&r, nonce, sizeof(nonce)), 0);
+    ExpectIntEQ(test_ed25519_read_le(&k, h, sizeof(h)), 0);
+    ExpectIntEQ(test_ed25519_read_le(&a, az, ED25519_KEY_SIZE), 0);
+    ExpectIntEQ(mp_mod(&r, &l, &r), 0);
+    ExpectIntEQ(mp_mod(&k, &l, &k), 0);
+    ExpectIntEQ(mp_mulmod(&k, &a, &l, &k), 0);
+    ExpectIntEQ(mp_addmod(&r, &k, &l, &r), 0);
+    ExpectIntEQ(test_ed25519_write_le(&r, sig + ED25519_KEY_SIZE,
+        ED25519_KEY_SIZE), 0);
+    mp_forcezero(&a);
+    mp_clear(&l);
+    mp_clear(&r);
+    mp_clear(&k);
+    ForceZero(az, sizeof(az));
+    ForceZero(seed, sizeof(seed));
+
+    return EXPECT_RESULT();
+}
+#endif
+
+/*
+ * Test wc_ed25519_verify_msg_batch()
+ */
+static int test_wc_ed25519_verify_msg_batch(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_ED25519) && defined(HAVE_ED25519_SIGN) && \
+    defined(HAVE_ED25519_VERIFY) && defined(HAVE_ED25519_MAKE_KEY)
+    /* more than one full batch */
+    #define ED25519_TEST_SIGS 70
+    WC_RNG       rng;
+    ed25519_key  key[3];
+    byte         msgs[ED25519_TEST_SIGS][16];
+    byte         sigs[ED25519_TEST_SIGS][ED25519_SIG_SIZE];
+    const byte*  sig[ED25519_TEST_SIGS];
+    word32       sigLen[ED25519_TEST_SIGS];
+    const byte*  msg[ED25519_TEST_SIGS];
+    word32       msgLen[ED25519_TEST_SIGS];
+    int          res[ED25519_TEST_SIGS];
+    ed25519_key* k[ED25519_TEST_SIGS];
+    int          i;
+
+    XMEMSET(key, 0, sizeof(key));
+    XMEMSET(&rng, 0, sizeof(WC_RNG));
+
+    ExpectIntEQ(wc_InitRng(&rng), 0);
+    for (i = 0; i < 3; i++) {
+        ExpectIntEQ(wc_ed25519_init(&key[i]), 0);
+        ExpectIntEQ(wc_ed25519_make_key(&rng, ED25519_KEY_SIZE, &key[i]), 0);
+    }
+
+    for (i = 0; i < ED25519_TEST_SIGS; i++) {
+        XMEMSET(msgs[i], 'a' + (i % 26), sizeof(msgs[i]));
+        msgs[i][0] = (byte)i;
+        sig[i] = sigs[i];
+        sigLen[i] = ED25519_SIG_SIZE;
+        msg[i] = msgs[i];
+        msgLen[i] = (word32)sizeof(msgs[i]);
+        k[i] = &key[i % 3];
+        ExpectIntEQ(wc_ed25519_sign_msg(msg[i], msgLen[i], sigs[i], &sigLen[i],
+            k[i]), 0);
+    }
+
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, res, k,
+        ED25519_TEST_SIGS, &rng), 0);
+    for (i = 0; i < ED25519_TEST_SIGS; i++) {
+        ExpectIntEQ(res[i], 1);
+    }
+
+    /* wrong message, S not reduced, wrong key, bad length and a bad
+     * signature in the second batch - the others stay valid */
+    msg[1] = msgs[0];
+    sigs[3][ED25519_SIG_SIZE-1] |= 0x80;
+    k[5] = &key[0];
+    sigLen[7] = ED25519_SIG_SIZE - 1;
+    sigs[66][40] ^= 0x01;
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, res, k,
+        ED25519_TEST_SIGS, &rng), 0);
+    for (i = 0; i < ED25519_TEST_SIGS; i++) {
+        ExpectIntEQ(res[i], (i == 1 || i == 3 || i == 5 || i == 7 ||
+                             i == 66) ? 0 : 1);
+    }
+
+#ifdef TEST_ED25519_TORSION_R
+    /* R shifted by the point of order 2 in two signatures: each is rejected
+     * by the cofactorless single verify but the cofactored combined check
+     * clears the small order component */
+    for (i = 0; i < ED25519_TEST_SIGS; i++) {
+        sigLen[i] = ED25519_SIG_SIZE;
+        msg[i] = msgs[i];
+        k[i] = &key[i % 3];
+    }
+    sigs[66][40] ^= 0x01;
+    for (i = 0; i < 3; i++) {
+        byte chk[ED25519_SIG_SIZE];
+        int  ok = 1;
+
+        /* the signature is calculated the same way as the signer does */
+        XMEMCPY(chk, sigs[i], ED25519_SIG_SIZE);
+        ExpectIntEQ(test_ed25519_sign_torsion_r(k[i], msg[i], msgLen[i],
+            sigs[i], 0), TEST_SUCCESS);
+        ExpectBufEQ(sigs[i], chk, ED25519_SIG_SIZE);
+        if (i == 0)
+            continue;
+        ExpectIntEQ(test_ed25519_sign_torsion_r(k[i], msg[i], msgLen[i],
+            sigs[i], 1), TEST_SUCCESS);
+        ExpectIntEQ(wc_ed25519_verify_msg(sig[i], sigLen[i], msg[i],
+            msgLen[i], &ok, k[i]), SIG_VERIFY_E);
+        ExpectIntEQ(ok, 0);
+    }
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, res, k,
+        ED25519_TEST_SIGS, &rng), 0);
+    for (i = 0; i < ED25519_TEST_SIGS; i++) {
+        ExpectIntEQ(res[i], (i == 3) ? 0 : 1);
+    }
+    /* with a bad signature in the same batch each is verified on its own */
+    sigs[10][40] ^= 0x01;
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, res, k,
+        ED25519_TEST_SIGS, &rng), 0);
+    for (i = 0; i < ED25519_TEST_SIGS; i++) {
+        ExpectIntEQ(res[i], (i == 1 || i == 2 || i == 3 || i == 10) ? 0 : 1);
+    }
+#endif
+
+    /* a batch of one and an empty batch */
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, res, k,
+        1, &rng), 0);
+    ExpectIntEQ(res[0], 1);
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, res, k,
+        0, &rng), 0);
+
+    /* Test bad args. */
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(NULL, sigLen, msg, msgLen, res, k,
+        1, &rng), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, NULL, msg, msgLen, res, k,
+        1, &rng), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, sigLen, NULL, msgLen, res, k,
+        1, &rng), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, sigLen, msg, NULL, res, k,
+        1, &rng), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, NULL, k,
+        1, &rng), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, res,
+        NULL, 1, &rng), BAD_FUNC_ARG);
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, res, k,
+        1, NULL), BAD_FUNC_ARG);
+    k[0] = NULL;
+    ExpectIntEQ(wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, res, k,
+        1, &rng), BAD_FUNC_ARG);
+
+    for (i = 0; i < 3; i++) {
+        wc_ed25519_free(&key[i]);
+    }
+    DoExpectIntEQ(wc_FreeRng(&rng), 0);
+    #undef ED25519_TEST_SIGS
+#endif
+    return EXPECT_RESULT();
+} /* END test_wc_ed25519_verify_msg_batch */
+
 /*
  * Testing wc_ed25519_import_public()
  */
@@ -25253,6 +27682,109 @@ static int test_wc_ecc_verify_hash_ex(void)
     return EXPECT_RESULT();
 } /* END test_wc_ecc_verify_hash_ex */
 
+/*
+ * Testing wc_ecc_verify_hash_batch()
+ */
+static int test_wc_ecc_verify_hash_batch(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && defined(HAVE_ECC_VERIFY) \
+    && defined(WOLFSSL_PUBLIC_MP) && !defined(WC_NO_RNG) && \
+    !defined(WOLFSSL_ATECC508A) && !defined(WOLFSSL_ATECC608A) && \
+    !defined(WOLFSSL_KCAPI_ECC) && !defined(WOLFSSL_ASYNC_CRYPT) && \
+    (!defined(NO_ECC256) || defined(HAVE_ALL_CURVES)) && \
+    (defined(HAVE_ECC384) || defined(HAVE_ALL_CURVES)) && ECC_MIN_KEY_SZ <= 256
+    #define BATCH_SIGS 6
+    ecc_key       key[3];
+    WC_RNG        rng;
+    mp_int        rv[BATCH_SIGS];
+    mp_int        sv[BATCH_SIGS];
+    mp_int*       r[BATCH_SIGS];
+    mp_int*       s[BATCH_SIGS];
+    ecc_key*      k[BATCH_SIGS];
+    const byte*   h[BATCH_SIGS];
+    word32        hLen[BATCH_SIGS];
+    int           res[BATCH_SIGS];
+    byte          hash[BATCH_SIGS][32];
+    int           i;
+
+    XMEMSET(key, 0, sizeof(key));
+    XMEMSET(&rng, 0, sizeof(WC_RNG));
+
+    ExpectIntEQ(wc_InitRng(&rng), 0);
+    for (i = 0; i < 3; i++) {
+        ExpectIntEQ(wc_ecc_init(&key[i]), 0);
+    }
+    ExpectIntEQ(wc_ecc_make_key(&rng, 32, &key[0]), 0);
+    ExpectIntEQ(wc_ecc_make_key(&rng, 32, &key[1]), 0);
+    ExpectIntEQ(wc_ecc_make_key(&rng, 48, &key[2]), 0);
+
+    /* P-256, P-256, P-384, P-256, P-256, P-256 */
+    for (i = 0; i < BATCH_SIGS; i++) {
+        XMEMSET(hash[i], 'a' + i, sizeof(hash[i]));
+        ExpectIntEQ(mp_init_multi(&rv[i], &sv[i], NULL, NULL, NULL, NULL),
+            MP_OKAY);
+        r[i] = &rv[i];
+        s[i] = &sv[i];
+        h[i] = hash[i];
+        hLen[i] = (word32)sizeof(hash[i]);
+        k[i] = (i == 2) ? &key[2] : &key[i & 1];
+        ExpectIntEQ(wc_ecc_sign_hash_ex(h[i], hLen[i], &rng, k[i], r[i], s[i]),
+            0);
+    }
+
+    ExpectIntEQ(wc_ecc_verify_hash_batch(r, s, h, hLen, res, k, BATCH_SIGS), 0);
+    for (i = 0; i < BATCH_SIGS; i++) {
+        ExpectIntEQ(res[i], 1);
+    }
+
+    /* wrong hash, s of zero and wrong key are invalid, the others valid */
+    h[1] = hash[0];
+    ExpectIntEQ(mp_set(s[3], 0), MP_OKAY);
+    k[5] = &key[0];
+    ExpectIntEQ(wc_ecc_verify_hash_batch(r, s, h, hLen, res, k, BATCH_SIGS), 0);
+    ExpectIntEQ(res[0], 1);
+    ExpectIntEQ(res[1], 0);
+    ExpectIntEQ(res[2], 1);
+    ExpectIntEQ(res[3], 0);
+    ExpectIntEQ(res[4], 1);
+    ExpectIntEQ(res[5], 0);
+
+    /* an empty batch is fine */
+    ExpectIntEQ(wc_ecc_verify_hash_batch(r, s, h, hLen, res, k, 0), 0);
+
+    /* Test bad args. */
+    ExpectIntEQ(wc_ecc_verify_hash_batch(NULL, s, h, hLen, res, k, 1),
+        ECC_BAD_ARG_E);
+    ExpectIntEQ(wc_ecc_verify_hash_batch(r, NULL, h, hLen, res, k, 1),
+        ECC_BAD_ARG_E);
+    ExpectIntEQ(wc_ecc_verify_hash_batch(r, s, NULL, hLen, res, k, 1),
+        ECC_BAD_ARG_E);
+    ExpectIntEQ(wc_ecc_verify_hash_batch(r, s, h, NULL, res, k, 1),
+        ECC_BAD_ARG_E);
+    ExpectIntEQ(wc_ecc_verify_hash_batch(r, s, h, hLen, NULL, k, 1),
+        ECC_BAD_ARG_E);
+    ExpectIntEQ(wc_ecc_verify_hash_batch(r, s, h, hLen, res, NULL, 1),
+        ECC_BAD_ARG_E);
+    ExpectIntEQ(wc_ecc_verify_hash_batch(r, s, h, hLen, res, k, -1),
+        ECC_BAD_ARG_E);
+    k[0] = NULL;
+    ExpectIntEQ(wc_ecc_verify_hash_batch(r, s, h, hLen, res, k, 1),
+        ECC_BAD_ARG_E);
+
+    for (i = 0; i < BATCH_SIGS; i++) {
+        mp_free(&rv[i]);
+        mp_free(&sv[i]);
+    }
+    for (i = 0; i < 3; i++) {
+        wc_ecc_free(&key[i]);
+    }
+    DoExpectIntEQ(wc_FreeRng(&rng), 0);
+    #undef BATCH_SIGS
+#endif
+    return EXPECT_RESULT();
+} /* END test_wc_ecc_verify_hash_batch */
+
 /*
  * Testing wc_ecc_mulmod()
  */
@@ -25318,6 +27850,148 @@ static int test_wc_ecc_mulmod(void)
     return EXPECT_RESULT();
 } /* END test_wc_ecc_mulmod */
 
+#if defined(HAVE_ECC) && defined(FP_ECC) && defined(FP_ECC_SHARED) && \
+    !defined(SINGLE_THREADED) && !defined(WC_NO_RNG) && \
+    defined(HAVE_ECC_SIGN) && defined(HAVE_ECC_VERIFY) && \
+    (!defined(NO_ECC256) || defined(HAVE_ALL_CURVES)) && \
+    ECC_MIN_KEY_SZ <= 256
+#define FP_ECC_SHARED_THREADS    4
+#define FP_ECC_SHARED_ITERATIONS 20
+
+typedef struct {
+    const byte* pub;    /* public key shared by all threads, X9.63 */
+    word32      pubSz;
+    const byte* sig;    /* signature of hash by pub */
+    word32      sigSz;
+    const byte* hash;
+    int         ret;
+} fp_ecc_shared_args;
+
+static volatile int fpEccSharedReady;
+
+/* Signs with its own key and checks the shared signature while the other
+ * threads do the same, the generator and shared public key are cached once
+ * for all of them. */
+static THREAD_RETURN WOLFSSL_THREAD test_wc_ecc_fp_shared_thread(void* args)
+{
+    fp_ecc_shared_args* a = (fp_ecc_shared_args*)args;
+    ecc_key  own;
+    ecc_key  peer;
+    WC_RNG   rng;
+    byte     hash[WC_SHA256_DIGEST_SIZE];
+    byte     sig[ECC_MAX_SIG_SIZE];
+    word32   sigSz;
+    int      verify;
+    int      i;
+    int      ret;
+
+    XMEMSET(&rng, 0, sizeof(rng));
+    ret = wc_InitRng(&rng);
+    if (ret == 0)
+        ret = wc_ecc_init(&own);
+    if (ret == 0)
+        ret = wc_ecc_init(&peer);
+    if (ret == 0)
+        ret = wc_ecc_import_x963(a->pub, a->pubSz, &peer);
+    if (ret == 0)
+        ret = wc_ecc_make_key(&rng, KEY32, &own);
+
+    while (!fpEccSharedReady);
+    for (i = 0; ret == 0 && i < FP_ECC_SHARED_ITERATIONS; i++) {
+        ret = wc_ecc_verify_hash(a->sig, a->sigSz, a->hash,
+            WC_SHA256_DIGEST_SIZE, &verify, &peer);
+        if (ret == 0 && verify != 1)
+            ret = SIG_VERIFY_E;
+
+        XMEMSET(hash, (byte)i, sizeof(hash));
+        sigSz = (word32)sizeof(sig);
+        if (ret == 0) {
+            ret = wc_ecc_sign_hash(hash, sizeof(hash), sig, &sigSz, &rng,
+                &own);
+        }
+        if (ret == 0) {
+            ret = wc_ecc_verify_hash(sig, sigSz, hash, sizeof(hash), &verify,
+                &own);
+        }
+        if (ret == 0 && verify != 1)
+            ret = SIG_VERIFY_E;
+        /* the other key must not verify it */
+        if (ret == 0) {
+            ret = wc_ecc_verify_hash(sig, sigSz, hash, sizeof(hash), &verify,
+                &peer);
+        }
+        if (ret == 0 && verify != 0)
+            ret = SIG_VERIFY_E;
+    }
+
+    wc_ecc_free(&own);
+    wc_ecc_free(&peer);
+    wc_FreeRng(&rng);
+    a->ret = ret;
+
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+#endif
+
+/*
+ * Testing the FP_ECC cache shared by all threads (FP_ECC_SHARED)
+ */
+static int test_wc_ecc_fp_shared(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_ECC) && defined(FP_ECC) && defined(FP_ECC_SHARED) && \
+    !defined(SINGLE_THREADED) && !defined(WC_NO_RNG) && \
+    defined(HAVE_ECC_SIGN) && defined(HAVE_ECC_VERIFY) && \
+    (!defined(NO_ECC256) || defined(HAVE_ALL_CURVES)) && \
+    ECC_MIN_KEY_SZ <= 256
+    fp_ecc_shared_args args[FP_ECC_SHARED_THREADS];
+    THREAD_TYPE threads[FP_ECC_SHARED_THREADS];
+    ecc_key     key;
+    WC_RNG      rng;
+    byte        hash[WC_SHA256_DIGEST_SIZE];
+    byte        sig[ECC_MAX_SIG_SIZE];
+    word32      sigSz = (word32)sizeof(sig);
+    byte        pub[ECC_BUFSIZE];
+    word32      pubSz = (word32)sizeof(pub);
+    int         i;
+
+    XMEMSET(&key, 0, sizeof(key));
+    XMEMSET(&rng, 0, sizeof(rng));
+    XMEMSET(hash, 0xa5, sizeof(hash));
+    ExpectIntEQ(wc_InitRng(&rng), 0);
+    ExpectIntEQ(wc_ecc_init(&key), 0);
+    ExpectIntEQ(wc_ecc_make_key(&rng, KEY32, &key), 0);
+    ExpectIntEQ(wc_ecc_sign_hash(hash, sizeof(hash), sig, &sigSz, &rng,
+        &key), 0);
+    ExpectIntEQ(wc_ecc_export_x963(&key, pub, &pubSz), 0);
+
+    fpEccSharedReady = 0;
+    for (i = 0; EXPECT_SUCCESS() && i < FP_ECC_SHARED_THREADS; i++) {
+        args[i].pub = pub;
+        args[i].pubSz = pubSz;
+        args[i].sig = sig;
+        args[i].sigSz = sigSz;
+        args[i].hash = hash;
+        args[i].ret = WOLFSSL_FATAL_ERROR;
+        ExpectIntEQ(wolfSSL_NewThread(&threads[i],
+            test_wc_ecc_fp_shared_thread, &args[i]), 0);
+        if (EXPECT_FAIL())
+            break;
+    }
+    /* threads started are always joined */
+    fpEccSharedReady = 1;
+    while (--i >= 0) {
+        ExpectIntEQ(wolfSSL_JoinThread(threads[i]), 0);
+        ExpectIntEQ(args[i].ret, 0);
+    }
+
+    wc_ecc_free(&key);
+    DoExpectIntEQ(wc_FreeRng(&rng), 0);
+    wc_ecc_fp_free();
+#endif
+    return EXPECT_RESULT();
+} /* END test_wc_ecc_fp_shared */
+
 /*
  * Testing wc_ecc_is_valid_idx()
  */
@@ -46867,6 +49541,203 @@ static int test_wolfSSL_CTX_sess_set_remove_cb(void)
     return EXPECT_RESULT();
 }
 
+static int test_wolfSSL_session_cache_resize(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_SHARDED_SESSION_CACHE) && \
+    defined(HAVE_SSL_MEMIO_TESTS_DEPENDENCIES) && !defined(WOLFSSL_NO_TLS12)
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL;
+    WOLFSSL_CTX *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL;
+    WOLFSSL *ssl_s = NULL;
+    WOLFSSL_SESSION *sess = NULL;
+    WOLFSSL_SESSION *ref = NULL;
+    word32 sizes[2] = { 1024, 4 };
+    word32 prevSize;
+    word32 hits = 0;
+    word32 misses = 0;
+    word32 hitsEnd = 0;
+    int i;
+
+    prevSize = wolfSSL_CTX_get_session_cache_size(NULL);
+    ExpectIntGT(prevSize, 0);
+    ExpectIntEQ(wolfSSL_CTX_set_session_cache_size(NULL, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_get_session_cache_stats(NULL, NULL, NULL, NULL),
+        WOLFSSL_SUCCESS);
+    /* Only this test's sessions in the cache */
+    wolfSSL_CTX_flush_sessions(NULL, -1);
+
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c, &ssl_s,
+        wolfTLSv1_2_client_method, wolfTLSv1_2_server_method), 0);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+    ExpectNotNull(sess = wolfSSL_get1_session(ssl_c));
+#if !defined(NO_SESSION_CACHE_REF) && !defined(NO_CLIENT_CACHE)
+    /* reference into the ClientCache, must follow the session when moved */
+    ExpectNotNull(ref = wolfSSL_get_session(ssl_c));
+#else
+    ref = sess;
+#endif
+    wolfSSL_free(ssl_c);
+    ssl_c = NULL;
+    wolfSSL_free(ssl_s);
+    ssl_s = NULL;
+
+    ExpectIntEQ(wolfSSL_get_session_cache_stats(&hits, &misses, NULL, NULL),
+        WOLFSSL_SUCCESS);
+
+    /* Grow then shrink the cache. The session must be moved both times. */
+    for (i = 0; i < 2; i++) {
+        ExpectIntEQ(wolfSSL_CTX_set_session_cache_size(ctx_s, sizes[i]),
+            WOLFSSL_SUCCESS);
+        ExpectIntGE(wolfSSL_CTX_get_session_cache_size(ctx_s), sizes[i]);
+
+        test_ctx.c_len = test_ctx.s_len = 0;
+        ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+        ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+        wolfSSL_SetIOWriteCtx(ssl_c, &test_ctx);
+        wolfSSL_SetIOReadCtx(ssl_c, &test_ctx);
+        wolfSSL_SetIOWriteCtx(ssl_s, &test_ctx);
+        wolfSSL_SetIOReadCtx(ssl_s, &test_ctx);
+        ExpectIntEQ(wolfSSL_set_session(ssl_c, ref), WOLFSSL_SUCCESS);
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+        ExpectIntEQ(wolfSSL_session_reused(ssl_c), 1);
+        ExpectIntEQ(wolfSSL_session_reused(ssl_s), 1);
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+    }
+
+    ExpectIntEQ(wolfSSL_get_session_cache_stats(&hitsEnd, NULL, NULL, NULL),
+        WOLFSSL_SUCCESS);
+    ExpectIntGE(hitsEnd, hits + 2);
+
+    ExpectIntEQ(wolfSSL_CTX_set_session_cache_size(NULL, prevSize),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_get_session_cache_size(NULL), prevSize);
+
+    wolfSSL_SESSION_free(sess);
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+#endif
+    return EXPECT_RESULT();
+}
+
+#if defined(WOLFSSL_SESSION_STORE_SHM) && \
+    defined(HAVE_SSL_MEMIO_TESTS_DEPENDENCIES) && !defined(WOLFSSL_NO_TLS12)
+static CallbackSessionStoreGet test_session_store_shm_get = NULL;
+static int test_session_store_pending = 0;
+static int test_session_store_gets = 0;
+
+/* Shared memory store that is busy on the first lookup of a handshake. */
+static int test_session_store_get(WOLFSSL* ssl, const unsigned char* id,
+    int idSz, unsigned char* data, int dataSz, void* ctx)
+{
+    test_session_store_gets++;
+    if (test_session_store_pending) {
+        test_session_store_pending = 0;
+        return WOLFSSL_CBIO_ERR_WANT_READ;
+    }
+    return test_session_store_shm_get(ssl, id, idSz, data, dataSz, ctx);
+}
+#endif
+
+static int test_wolfSSL_session_store(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_SESSION_STORE_SHM) && \
+    defined(HAVE_SSL_MEMIO_TESTS_DEPENDENCIES) && !defined(WOLFSSL_NO_TLS12)
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL;
+    WOLFSSL_CTX *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL;
+    WOLFSSL *ssl_s = NULL;
+    WOLFSSL_SESSION *sess = NULL;
+    WOLFSSL_SESSION *sessS = NULL;
+    void* mem = NULL;
+    int memSz = 0;
+    int i;
+
+    ExpectIntEQ(wolfSSL_SessionStoreShm_Size(0), BAD_FUNC_ARG);
+    ExpectIntGT(memSz = wolfSSL_SessionStoreShm_Size(16), 0);
+    ExpectNotNull(mem = XMALLOC(memSz, NULL, DYNAMIC_TYPE_TMP_BUFFER));
+    ExpectIntEQ(wolfSSL_SessionStoreShm_Init(NULL, memSz), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_SessionStoreShm_Init(mem, memSz), WOLFSSL_SUCCESS);
+
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    /* Server may negotiate TLS v1.3 but client resumes TLS v1.2 session. */
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, NULL, NULL,
+        wolfTLSv1_2_client_method, wolfSSLv23_server_method), 0);
+    ExpectIntEQ(wolfSSL_CTX_UseSessionStoreShm(NULL, mem), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_UseSessionStoreShm(ctx_s, mem), WOLFSSL_SUCCESS);
+    /* Every server session comes from the store. */
+    ExpectIntEQ(wolfSSL_CTX_set_session_cache_mode(ctx_s,
+        WOLFSSL_SESS_CACHE_NO_INTERNAL), WOLFSSL_SUCCESS);
+
+    /* Full handshake, resume from the store and then resume with the store
+     * lookup pending in the first call to accept. */
+    for (i = 0; i < 3; i++) {
+        test_ctx.c_len = test_ctx.s_len = 0;
+        ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+        ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+        wolfSSL_SetIOWriteCtx(ssl_c, &test_ctx);
+        wolfSSL_SetIOReadCtx(ssl_c, &test_ctx);
+        wolfSSL_SetIOWriteCtx(ssl_s, &test_ctx);
+        wolfSSL_SetIOReadCtx(ssl_s, &test_ctx);
+        if (sess != NULL)
+            ExpectIntEQ(wolfSSL_set_session(ssl_c, sess), WOLFSSL_SUCCESS);
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+        ExpectIntEQ(wolfSSL_session_reused(ssl_c), i > 0);
+        ExpectIntEQ(wolfSSL_session_reused(ssl_s), i > 0);
+        if (sess == NULL) {
+            ExpectNotNull(sess = wolfSSL_get1_session(ssl_c));
+            ExpectNotNull(sessS = wolfSSL_get1_session(ssl_s));
+        }
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+
+        if (i == 1) {
+            test_session_store_shm_get = ctx_s->sessStoreGetCb;
+            ExpectIntEQ(wolfSSL_CTX_SetSessionStore(ctx_s,
+                test_session_store_get, ctx_s->sessStoreSetCb,
+                ctx_s->sessStoreRemoveCb, mem), WOLFSSL_SUCCESS);
+            test_session_store_pending = 1;
+        }
+    }
+    ExpectIntEQ(test_session_store_pending, 0);
+    ExpectIntEQ(test_session_store_gets, 2);
+
+#ifdef OPENSSL_EXTRA
+    /* Removed sessions can't be resumed. */
+    ExpectIntEQ(wolfSSL_SSL_CTX_remove_session(ctx_s, sessS), 0);
+    test_ctx.c_len = test_ctx.s_len = 0;
+    ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+    ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+    wolfSSL_SetIOWriteCtx(ssl_c, &test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_c, &test_ctx);
+    wolfSSL_SetIOWriteCtx(ssl_s, &test_ctx);
+    wolfSSL_SetIOReadCtx(ssl_s, &test_ctx);
+    ExpectIntEQ(wolfSSL_set_session(ssl_c, sess), WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+    ExpectIntEQ(wolfSSL_session_reused(ssl_s), 0);
+    wolfSSL_free(ssl_c);
+    wolfSSL_free(ssl_s);
+#endif
+
+    wolfSSL_SESSION_free(sess);
+    wolfSSL_SESSION_free(sessS);
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+    ExpectIntEQ(wolfSSL_SessionStoreShm_Free(mem), WOLFSSL_SUCCESS);
+    XFREE(mem, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+    return EXPECT_RESULT();
+}
+
 static int test_wolfSSL_ticket_keys(void)
 {
     EXPECT_DECLS;
@@ -70829,6 +73700,7 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wc_Sha256Free),
     TEST_DECL(test_wc_Sha256GetHash),
     TEST_DECL(test_wc_Sha256Copy),
+    TEST_DECL(test_wc_Sha256_MB),
 
     TEST_DECL(test_wc_InitSha224),
     TEST_DECL(test_wc_Sha224Update),
@@ -70897,6 +73769,7 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wc_Shake256_Final),
     TEST_DECL(test_wc_Shake256_Copy),
     TEST_DECL(test_wc_Shake256Hash),
+    TEST_DECL(test_wc_Shake_x4),
 
     /* SM3 Digest */
     TEST_DECL(test_wc_InitSm3Free),
@@ -70969,6 +73842,7 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wc_AesGcmSetKey),
     TEST_DECL(test_wc_AesGcmEncryptDecrypt),
     TEST_DECL(test_wc_AesGcmMixedEncDecLongIV),
+    TEST_DECL(test_wc_AesGcmEncryptMulti),
     TEST_DECL(test_wc_GmacSetKey),
     TEST_DECL(test_wc_GmacUpdate),
     TEST_DECL(test_wc_AesCcmSetKey),
@@ -71012,6 +73886,7 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wc_RsaPublicKeyDecode),
     TEST_DECL(test_wc_RsaPublicKeyDecodeRaw),
     TEST_DECL(test_wc_MakeRsaKey),
+    TEST_DECL(test_wc_KeyGenThreads),
     TEST_DECL(test_wc_CheckProbablePrime),
     TEST_DECL(test_wc_RsaPSS_Verify),
     TEST_DECL(test_wc_RsaPSS_VerifyCheck),
@@ -71022,6 +73897,7 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wc_RsaPublicEncryptDecrypt_ex),
     TEST_DECL(test_wc_RsaEncryptSize),
     TEST_DECL(test_wc_RsaSSL_SignVerify),
+    TEST_DECL(test_wc_RsaPrepareKey),
     TEST_DECL(test_wc_RsaFlattenPublicKey),
     TEST_DECL(test_RsaDecryptBoundsCheck),
 
@@ -71075,7 +73951,9 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wc_ecc_pointFns),
     TEST_DECL(test_wc_ecc_shared_secret_ssh),
     TEST_DECL(test_wc_ecc_verify_hash_ex),
+    TEST_DECL(test_wc_ecc_verify_hash_batch),
     TEST_DECL(test_wc_ecc_mulmod),
+    TEST_DECL(test_wc_ecc_fp_shared),
     TEST_DECL(test_wc_ecc_is_valid_idx),
     TEST_DECL(test_wc_ecc_get_curve_id_from_oid),
     TEST_DECL(test_wc_ecc_sig_size_calc),
@@ -71107,6 +73985,7 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wc_ed25519_make_key),
     TEST_DECL(test_wc_ed25519_init),
     TEST_DECL(test_wc_ed25519_sign_msg),
+    TEST_DECL(test_wc_ed25519_verify_msg_batch),
     TEST_DECL(test_wc_ed25519_import_public),
     TEST_DECL(test_wc_ed25519_import_private_key),
     TEST_DECL(test_wc_ed25519_export),
@@ -71616,6 +74495,8 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wolfSSL_SESSION),
     TEST_DECL(test_wolfSSL_SESSION_expire_downgrade),
     TEST_DECL(test_wolfSSL_CTX_sess_set_remove_cb),
+    TEST_DECL(test_wolfSSL_session_cache_resize),
+    TEST_DECL(test_wolfSSL_session_store),
     TEST_DECL(test_wolfSSL_ticket_keys),
     TEST_DECL(test_wolfSSL_sk_GENERAL_NAME),
     TEST_DECL(test_wolfSSL_GENERAL_NAME_print),
@@ -71965,6 +74846,18 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wolfSSL_DisableExtendedMasterSecret),
     TEST_DECL(test_wolfSSL_wolfSSL_UseSecureRenegotiation),
     TEST_DECL(test_wolfSSL_SCR_Reconnect),
+    TEST_DECL(test_wolfSSL_read_zc),
+    TEST_DECL(test_wolfSSL_ktls),
+    TEST_DECL(test_wolfSSL_SetIO_uring),
+    TEST_DECL(test_wolfSSL_writev),
+    TEST_DECL(test_wolfSSL_send_batch),
+    TEST_DECL(test_wolfSSL_CTX_set_record_pool),
+    TEST_DECL(test_wolfSSL_compact),
+    TEST_DECL(test_wolfSSL_CTX_set_verify_workers),
+    TEST_DECL(test_wolfSSL_CTX_set_keyshare_pool),
+    TEST_DECL(test_wolfSSL_CTX_set_cert_msg_cache),
+    TEST_DECL(test_wolfSSL_CTX_set_stateless_hrr),
+    TEST_DECL(test_wolfSSL_CTX_set_ticket_keys),
     TEST_DECL(test_tls_ext_duplicate),
 #if defined(WOLFSSL_TLS13) && defined(HAVE_ECH) && \
     defined(HAVE_IO_TESTS_DEPENDENCIES)
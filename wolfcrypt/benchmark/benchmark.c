@@ -95,6 +95,9 @@
 #ifndef NO_AES
     #include <wolfssl/wolfcrypt/aes.h>
 #endif
+#if defined(WOLFSSL_AESGCM_VAES) && defined(WOLFSSL_AESNI)
+    #include <wolfssl/wolfcrypt/cpuid.h>
+#endif
 #ifdef HAVE_CAMELLIA
     #include <wolfssl/wolfcrypt/camellia.h>
 #endif
@@ -570,8 +573,11 @@
 #define BENCH_AES_XTS            0x00000008
 #define BENCH_AES_CTR            0x00000010
 #define BENCH_AES_CCM            0x00000020
+#define BENCH_AES_GCM_MULTI      0x00000040
+#define BENCH_AES_GCM_VAES       0x00000080
 #define BENCH_CAMELLIA           0x00000100
 #define BENCH_ARC4               0x00000200
+#define BENCH_AES_XTS_SECTORS    0x00000400
 #define BENCH_CHACHA20           0x00001000
 #define BENCH_CHACHA20_POLY1305  0x00002000
 #define BENCH_DES                0x00004000
@@ -586,6 +592,7 @@
 #define BENCH_MD5                0x00000001
 #define BENCH_POLY1305           0x00000002
 #define BENCH_SHA                0x00000004
+#define BENCH_SHA256_MB          0x00000008
 #define BENCH_SHA224             0x00000010
 #define BENCH_SHA256             0x00000020
 #define BENCH_SHA384             0x00000040
@@ -605,6 +612,7 @@
 #define BENCH_BLAKE2B            0x00008000
 #define BENCH_BLAKE2S            0x00010000
 #define BENCH_SM3                0x00020000
+#define BENCH_SHAKE_X4           0x00040000
 
 /* MAC algorithms. */
 #define BENCH_CMAC               0x00000001
@@ -627,6 +635,7 @@
 #define BENCH_RSA_KEYGEN         0x00000001
 #define BENCH_RSA                0x00000002
 #define BENCH_RSA_SZ             0x00000004
+#define BENCH_RSA_KEYGEN_THREADS 0x00000008
 #define BENCH_DH                 0x00000010
 #define BENCH_KYBER              0x00000020
 #define BENCH_ECC_MAKEKEY        0x00001000
@@ -649,6 +658,8 @@
 #define BENCH_ECCSI_PAIRGEN      0x00000040
 #define BENCH_ECCSI_VALIDATE     0x00000080
 #define BENCH_ECCSI              0x00000400
+#define BENCH_ECC_BATCH          0x00000800
+#define BENCH_ED25519_BATCH      0x00000100
 #define BENCH_SAKKE_KEYGEN       0x10000000
 #define BENCH_SAKKE_RSKGEN       0x20000000
 #define BENCH_SAKKE_VALIDATE     0x40000000
@@ -754,12 +765,19 @@ static const bench_alg bench_cipher_opt[] = {
 #endif
 #ifdef HAVE_AESGCM
     { "-aes-gcm",            BENCH_AES_GCM           },
+    #ifdef WOLFSSL_AESGCM_MULTI
+    { "-aes-gcm-multi",      BENCH_AES_GCM_MULTI     },
+    #endif
+    #if defined(WOLFSSL_AESGCM_VAES) && defined(WOLFSSL_AESNI)
+    { "-aes-gcm-vaes",       BENCH_AES_GCM_VAES      },
+    #endif
 #endif
 #ifdef WOLFSSL_AES_DIRECT
     { "-aes-ecb",            BENCH_AES_ECB           },
 #endif
 #ifdef WOLFSSL_AES_XTS
     { "-aes-xts",            BENCH_AES_XTS           },
+    { "-aes-xts-sectors",    BENCH_AES_XTS_SECTORS   },
 #endif
 #ifdef WOLFSSL_AES_CFB
     { "-aes-cfb",            BENCH_AES_CFB           },
@@ -827,6 +845,9 @@ static const bench_alg bench_digest_opt[] = {
 #endif
 #ifndef NO_SHA256
     { "-sha256",             BENCH_SHA256            },
+    #ifdef WOLFSSL_SHA256_MB
+    { "-sha256-mb",          BENCH_SHA256_MB         },
+    #endif
 #endif
 #ifdef WOLFSSL_SHA384
     { "-sha384",             BENCH_SHA384            },
@@ -857,6 +878,9 @@ static const bench_alg bench_digest_opt[] = {
     #ifdef WOLFSSL_SHAKE256
     { "-shake256",           BENCH_SHAKE256          },
     #endif
+    #ifdef WOLFSSL_SHAKE128
+    { "-shake-x4",           BENCH_SHAKE_X4          },
+    #endif
 #endif
 #ifdef WOLFSSL_SM3
     { "-sm3",                BENCH_SM3               },
@@ -924,6 +948,9 @@ static const bench_alg bench_asym_opt[] = {
 #ifndef NO_RSA
     #ifdef WOLFSSL_KEY_GEN
     { "-rsa-kg",             BENCH_RSA_KEYGEN        },
+        #ifdef WOLFSSL_KEYGEN_THREADS
+    { "-rsa-kg-threads",     BENCH_RSA_KEYGEN_THREADS },
+        #endif
     #endif
     { "-rsa",                BENCH_RSA               },
     { "-rsa-sz",             BENCH_RSA_SZ            },
@@ -941,6 +968,10 @@ static const bench_alg bench_asym_opt[] = {
     { "-ecc-enc",            BENCH_ECC_ENCRYPT       },
     #endif
     { "-ecc-all",            BENCH_ECC_ALL           },
+    #if defined(HAVE_ECC_SIGN) && defined(HAVE_ECC_VERIFY) && \
+        defined(WOLFSSL_PUBLIC_MP) && !defined(WOLFSSL_ASYNC_CRYPT)
+    { "-ecc-batch",          BENCH_ECC_BATCH         },
+    #endif
 #endif
 #ifdef WOLFSSL_SM2
     { "-sm2",                BENCH_SM2               },
@@ -954,6 +985,10 @@ static const bench_alg bench_asym_opt[] = {
 #ifdef HAVE_ED25519
     { "-ed25519-kg",         BENCH_ED25519_KEYGEN    },
     { "-ed25519",            BENCH_ED25519_SIGN      },
+    #if defined(HAVE_ED25519_SIGN) && defined(HAVE_ED25519_VERIFY) && \
+        defined(HAVE_ED25519_MAKE_KEY)
+    { "-ed25519-batch",      BENCH_ED25519_BATCH     },
+    #endif
 #endif
 #ifdef HAVE_CURVE448
     { "-curve448-kg",        BENCH_CURVE448_KEYGEN   },
@@ -1925,6 +1960,8 @@ static int minimum_runs = 0;
 #ifndef NO_RSA
     /* Don't measure RSA sign/verify by default */
     static int rsa_sign_verify = 0;
+    /* Algorithm name reported - changes when keys are prepared */
+    static const char* rsa_bench_name = "RSA";
 #endif
 
 #ifndef NO_DH
@@ -3116,6 +3153,14 @@ static void* benchmarks_do(void* args)
         bench_gmac(1);
     #endif
     }
+    #ifdef WOLFSSL_AESGCM_MULTI
+    if (bench_cipher_algs & BENCH_AES_GCM_MULTI)
+        bench_aesgcm_multi();
+    #endif
+    #if defined(WOLFSSL_AESGCM_VAES) && defined(WOLFSSL_AESNI)
+    if (bench_cipher_algs & BENCH_AES_GCM_VAES)
+        bench_aesgcm_vaes();
+    #endif
 #endif
 #ifdef HAVE_AES_ECB
     if (bench_all || (bench_cipher_algs & BENCH_AES_ECB)) {
@@ -3130,6 +3175,8 @@ static void* benchmarks_do(void* args)
 #ifdef WOLFSSL_AES_XTS
     if (bench_all || (bench_cipher_algs & BENCH_AES_XTS))
         bench_aesxts();
+    if (bench_cipher_algs & BENCH_AES_XTS_SECTORS)
+        bench_aesxts_sectors();
 #endif
 #ifdef WOLFSSL_AES_CFB
     if (bench_all || (bench_cipher_algs & BENCH_AES_CFB))
@@ -3248,6 +3295,10 @@ static void* benchmarks_do(void* args)
         bench_sha256(1);
     #endif
     }
+    #ifdef WOLFSSL_SHA256_MB
+    if (bench_digest_algs & BENCH_SHA256_MB)
+        bench_sha256_mb();
+    #endif
 #endif
 #ifdef WOLFSSL_SHA384
     if (bench_all || (bench_digest_algs & BENCH_SHA384)) {
@@ -3355,6 +3406,10 @@ static void* benchmarks_do(void* args)
     #endif
     }
     #endif /* WOLFSSL_SHAKE256 */
+    #ifdef WOLFSSL_SHAKE128
+    if (bench_digest_algs & BENCH_SHAKE_X4)
+        bench_shake_x4();
+    #endif
 #endif
 #ifdef WOLFSSL_SM3
     if (bench_all || (bench_digest_algs & BENCH_SM3)) {
@@ -3494,6 +3549,20 @@ static void* benchmarks_do(void* args)
         #endif
         }
     #endif
+    #if defined(WOLFSSL_KEY_GEN) && defined(WOLFSSL_KEYGEN_THREADS)
+        /* only when asked for - generates many keys per thread count */
+        if (((word32)bench_asym_algs != 0xFFFFFFFFU) &&
+                (bench_asym_algs & BENCH_RSA_KEYGEN_THREADS)) {
+        #ifndef NO_SW_BENCH
+            if ((bench_asym_algs & BENCH_RSA_SZ) == 0) {
+                bench_rsaKeyGen_threads(2048);
+            }
+            else {
+                bench_rsaKeyGen_threads(bench_size);
+            }
+        #endif
+        }
+    #endif
     if (bench_all || (bench_asym_algs & BENCH_RSA)) {
     #ifndef NO_SW_BENCH
         bench_rsa(0);
@@ -3636,6 +3705,18 @@ static void* benchmarks_do(void* args)
         }
     }
 #endif
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && \
+    defined(HAVE_ECC_VERIFY) && defined(WOLFSSL_PUBLIC_MP) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+    if (bench_asym_algs & BENCH_ECC_BATCH) {
+        if (bench_asym_algs & BENCH_ECC_P384) {
+            bench_ecc_verify_batch((int)ECC_SECP384R1);
+        }
+        else {
+            bench_ecc_verify_batch((int)ECC_SECP256R1);
+        }
+    }
+#endif
 #ifdef WOLFSSL_SM2
     if (bench_all || (bench_asym_algs & BENCH_SM2)) {
         bench_sm2(0);
@@ -3665,6 +3746,11 @@ static void* benchmarks_do(void* args)
         bench_ed25519KeyGen();
     if (bench_all || (bench_asym_algs & BENCH_ED25519_SIGN))
         bench_ed25519KeySign();
+    #if defined(HAVE_ED25519_SIGN) && defined(HAVE_ED25519_VERIFY) && \
+        defined(HAVE_ED25519_MAKE_KEY)
+    if (bench_asym_algs & BENCH_ED25519_BATCH)
+        bench_ed25519_verify_batch();
+    #endif
 #endif
 
 #ifdef HAVE_CURVE448
@@ -4675,6 +4761,229 @@ void bench_gmac(int useDeviceID)
 
 }
 
+#ifdef WOLFSSL_AESGCM_MULTI
+/* packets encrypted between checks of the time */
+#define BENCH_AESGCM_MULTI_JOBS     32
+/* largest packet - fits in a 1500 byte MTU with headers */
+#define BENCH_AESGCM_MULTI_MAX      1350
+/* size of TLS 1.3 record header used as AAD */
+#define BENCH_AESGCM_MULTI_AAD      5
+
+/* Packets per second of AES-128-GCM on many small packets, one at a time and
+ * with the multi-job API. */
+void bench_aesgcm_multi(void)
+{
+    static const word32 sizes[] = { 64, 256, BENCH_AESGCM_MULTI_MAX };
+    Aes    aes;
+    wc_AesGcmJob jobs[BENCH_AESGCM_MULTI_JOBS];
+    double start = 0;
+    int    ret = 0, i, j, count = 0, dec;
+    byte*  buf = NULL;
+    byte   tag[BENCH_AESGCM_MULTI_JOBS][AES_AUTH_TAG_SZ];
+    byte   iv[BENCH_AESGCM_MULTI_JOBS][GCM_NONCE_MID_SZ];
+    byte   aad[BENCH_AESGCM_MULTI_AAD];
+    const char* desc;
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    XMEMSET(&aes, 0, sizeof(aes));
+    XMEMSET(jobs, 0, sizeof(jobs));
+    XMEMSET(aad, 0x17, sizeof(aad));
+    ret = wc_AesInit(&aes, HEAP_HINT, INVALID_DEVID);
+    if (ret == 0)
+        ret = wc_AesGcmSetKey(&aes, bench_key, 16);
+    if (ret != 0)
+        goto exit;
+
+    buf = (byte*)XMALLOC(2 * BENCH_AESGCM_MULTI_JOBS * BENCH_AESGCM_MULTI_MAX,
+                         HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (buf == NULL) {
+        ret = MEMORY_E;
+        goto exit;
+    }
+    XMEMSET(buf, 0, 2 * BENCH_AESGCM_MULTI_JOBS * BENCH_AESGCM_MULTI_MAX);
+
+    for (i = 0; i < BENCH_AESGCM_MULTI_JOBS; i++) {
+        /* packet number in the nonce as in TLS 1.3 and QUIC */
+        XMEMCPY(iv[i], bench_iv, GCM_NONCE_MID_SZ);
+        iv[i][GCM_NONCE_MID_SZ - 1] ^= (byte)i;
+        jobs[i].aes = &aes;
+        jobs[i].iv = iv[i];
+        jobs[i].ivSz = GCM_NONCE_MID_SZ;
+        jobs[i].authTag = tag[i];
+        jobs[i].authTagSz = AES_AUTH_TAG_SZ;
+        jobs[i].authIn = aad;
+        jobs[i].authInSz = sizeof(aad);
+    }
+
+    for (j = 0; j < (int)(sizeof(sizes) / sizeof(*sizes)); j++) {
+        for (i = 0; i < BENCH_AESGCM_MULTI_JOBS; i++) {
+            jobs[i].in = jobs[i].out = buf + i * BENCH_AESGCM_MULTI_MAX;
+            jobs[i].sz = sizes[j];
+        }
+
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < BENCH_AESGCM_MULTI_JOBS; i++) {
+                ret = wc_AesGcmEncrypt(&aes, jobs[i].out, jobs[i].in,
+                    jobs[i].sz, jobs[i].iv, jobs[i].ivSz, jobs[i].authTag,
+                    jobs[i].authTagSz, jobs[i].authIn, jobs[i].authInSz);
+                if (ret != 0)
+                    goto exit_aesgcm_multi;
+                RECORD_MULTI_VALUE_STATS();
+            }
+            count += i;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+        bench_stats_asym_finish_ex("AES-128-GCM", (int)sizes[j], "encrypt",
+                                   "-1", 0, count, start, ret);
+    #ifdef MULTI_VALUE_STATISTICS
+        bench_multi_value_stats(max, min, sum, squareSum, runs);
+    #endif
+        RESET_MULTI_VALUE_STATS_VARS();
+
+        /* encrypt then decrypt the same packets so tags verify */
+        for (dec = 0; dec <= 1; dec++) {
+            desc = dec ? "decrypt" : "encrypt";
+            for (i = 0; i < BENCH_AESGCM_MULTI_JOBS; i++) {
+                /* plaintext and ciphertext in separate halves of buf */
+                byte* pt = buf + i * BENCH_AESGCM_MULTI_MAX;
+                byte* ct = pt + BENCH_AESGCM_MULTI_JOBS *
+                                BENCH_AESGCM_MULTI_MAX;
+                jobs[i].in = dec ? ct : pt;
+                jobs[i].out = dec ? pt : ct;
+            }
+            bench_stats_start(&count, &start);
+            do {
+                if (dec)
+                    ret = wc_AesGcmDecryptMulti(jobs, BENCH_AESGCM_MULTI_JOBS);
+                else
+                    ret = wc_AesGcmEncryptMulti(jobs, BENCH_AESGCM_MULTI_JOBS);
+                if (ret != 0)
+                    goto exit_aesgcm_multi;
+                count += BENCH_AESGCM_MULTI_JOBS;
+                RECORD_MULTI_VALUE_STATS();
+            } while (bench_stats_check(start)
+        #ifdef MULTI_VALUE_STATISTICS
+               || runs < minimum_runs
+        #endif
+               );
+            bench_stats_asym_finish_ex("AES-128-GCM", (int)sizes[j], desc,
+                                       "-multi", 0, count, start, ret);
+        #ifdef MULTI_VALUE_STATISTICS
+            bench_multi_value_stats(max, min, sum, squareSum, runs);
+        #endif
+            RESET_MULTI_VALUE_STATS_VARS();
+        }
+    }
+
+exit_aesgcm_multi:
+    if (ret != 0) {
+        printf("%sAES-GCM multi failed: %d\n", err_prefix, ret);
+    }
+exit:
+    wc_AesFree(&aes);
+    XFREE(buf, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+}
+#endif /* WOLFSSL_AESGCM_MULTI */
+
+#if defined(WOLFSSL_AESGCM_VAES) && defined(WOLFSSL_AESNI)
+/* largest message */
+#define BENCH_AESGCM_VAES_MAX       16384
+
+/* Throughput of AES-256-GCM with the AVX2 code and with the AVX-512 VAES code.
+ * Clearing the VAES CPU flag selects the AVX2 code. */
+void bench_aesgcm_vaes(void)
+{
+    static const word32 sizes[] = { 256, 1024, BENCH_AESGCM_VAES_MAX };
+    Aes    aes;
+    double start = 0;
+    int    ret = 0, i, j, count = 0, dec, vaes;
+    word32 flags = cpuid_get_flags();
+    byte*  buf = NULL;
+    byte   tag[AES_AUTH_TAG_SZ];
+    byte   aad[AES_AUTH_ADD_SZ];
+    char   desc[32];
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    if (!IS_INTEL_VAES(flags) || !IS_INTEL_VPCLMULQDQ(flags) ||
+            !IS_INTEL_AVX512(flags) || !IS_INTEL_AVX512BW(flags)) {
+        printf("%sAES-GCM VAES: CPU doesn't support AVX-512 VAES\n",
+               info_prefix);
+        return;
+    }
+
+    XMEMSET(&aes, 0, sizeof(aes));
+    XMEMSET(aad, 0, sizeof(aad));
+    ret = wc_AesInit(&aes, HEAP_HINT, INVALID_DEVID);
+    if (ret == 0)
+        ret = wc_AesGcmSetKey(&aes, bench_key, 32);
+    if (ret != 0)
+        goto exit;
+
+    buf = (byte*)XMALLOC(2 * BENCH_AESGCM_VAES_MAX, HEAP_HINT,
+                         DYNAMIC_TYPE_TMP_BUFFER);
+    if (buf == NULL) {
+        ret = MEMORY_E;
+        goto exit;
+    }
+    XMEMSET(buf, 0, 2 * BENCH_AESGCM_VAES_MAX);
+
+    for (j = 0; j < (int)(sizeof(sizes) / sizeof(*sizes)); j++) {
+        for (vaes = 0; vaes <= 1; vaes++) {
+            cpuid_select_flags(vaes ? flags : (flags & ~CPUID_VAES));
+            /* encrypt then decrypt the same message so the tag verifies */
+            for (dec = 0; dec <= 1; dec++) {
+                bench_stats_start(&count, &start);
+                do {
+                    for (i = 0; i < numBlocks; i++) {
+                        if (dec) {
+                            ret = wc_AesGcmDecrypt(&aes, buf,
+                                buf + BENCH_AESGCM_VAES_MAX, sizes[j],
+                                bench_iv, GCM_NONCE_MID_SZ, tag,
+                                AES_AUTH_TAG_SZ, aad, sizeof(aad));
+                        }
+                        else {
+                            ret = wc_AesGcmEncrypt(&aes,
+                                buf + BENCH_AESGCM_VAES_MAX, buf, sizes[j],
+                                bench_iv, GCM_NONCE_MID_SZ, tag,
+                                AES_AUTH_TAG_SZ, aad, sizeof(aad));
+                        }
+                        if (ret != 0)
+                            goto exit_aesgcm_vaes;
+                        RECORD_MULTI_VALUE_STATS();
+                    }
+                    count += i;
+                } while (bench_stats_check(start)
+            #ifdef MULTI_VALUE_STATISTICS
+                   || runs < minimum_runs
+            #endif
+                   );
+                (void)XSNPRINTF(desc, sizeof(desc), "AES-256-GCM-%s-%s %d",
+                    dec ? "dec" : "enc", vaes ? "vaes" : "avx2",
+                    (int)sizes[j]);
+                bench_stats_sym_finish(desc, 0, count, sizes[j], start, ret);
+            #ifdef MULTI_VALUE_STATISTICS
+                bench_multi_value_stats(max, min, sum, squareSum, runs);
+            #endif
+                RESET_MULTI_VALUE_STATS_VARS();
+            }
+        }
+    }
+
+exit_aesgcm_vaes:
+    cpuid_select_flags(flags);
+    if (ret != 0) {
+        printf("%sAES-GCM VAES failed: %d\n", err_prefix, ret);
+    }
+exit:
+    wc_AesFree(&aes);
+    XFREE(buf, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+}
+#endif /* WOLFSSL_AESGCM_VAES && WOLFSSL_AESNI */
+
 #endif /* HAVE_AESGCM */
 
 
@@ -5049,6 +5358,112 @@ exit:
     wc_AesXtsFree(aes);
     WC_FREE_VAR(aes, HEAP_HINT);
 }
+
+#define BENCH_AESXTS_SECTOR_SZ      4096
+#define BENCH_AESXTS_SECTORS_SZ     (1024 * 1024)
+
+/* AES-XTS of a run of sectors: one sector per call, all in one call and, when
+ * supported, split across threads. */
+void bench_aesxts_sectors(void)
+{
+#ifdef WOLFSSL_AESXTS_THREADS
+    static const int threads[] = { 0, 1, 2, 4 };
+#else
+    static const int threads[] = { 0, 1 };
+#endif
+    XtsAes aes;
+    double start = 0;
+    int    ret = 0, i, j, count = 0, dec;
+    word32 s;
+    byte*  buf = NULL;
+    char   desc[40];
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    XMEMSET(&aes, 0, sizeof(aes));
+    ret = wc_AesXtsInit(&aes, HEAP_HINT, devId);
+    if (ret != 0)
+        goto exit;
+
+    buf = (byte*)XMALLOC(BENCH_AESXTS_SECTORS_SZ, HEAP_HINT,
+                         DYNAMIC_TYPE_TMP_BUFFER);
+    if (buf == NULL) {
+        ret = MEMORY_E;
+        goto exit;
+    }
+    XMEMSET(buf, 0, BENCH_AESXTS_SECTORS_SZ);
+
+    for (dec = 0; dec <= 1; dec++) {
+        ret = wc_AesXtsSetKeyNoInit(&aes, bench_key, 64,
+            dec ? AES_DECRYPTION : AES_ENCRYPTION);
+        if (ret != 0)
+            goto exit;
+
+        /* threads of 0 is one call per sector. */
+        for (j = 0; j < (int)(sizeof(threads) / sizeof(*threads)); j++) {
+            bench_stats_start(&count, &start);
+            do {
+                for (i = 0; i < numBlocks; i++) {
+                    if (threads[j] == 0) {
+                        for (s = 0; (ret == 0) &&
+                                (s < BENCH_AESXTS_SECTORS_SZ);
+                                s += BENCH_AESXTS_SECTOR_SZ) {
+                            if (dec) {
+                                ret = wc_AesXtsDecryptSector(&aes, buf + s,
+                                    buf + s, BENCH_AESXTS_SECTOR_SZ,
+                                    s / BENCH_AESXTS_SECTOR_SZ);
+                            }
+                            else {
+                                ret = wc_AesXtsEncryptSector(&aes, buf + s,
+                                    buf + s, BENCH_AESXTS_SECTOR_SZ,
+                                    s / BENCH_AESXTS_SECTOR_SZ);
+                            }
+                        }
+                    }
+                    else if (dec) {
+                        ret = wc_AesXtsDecryptSectors(&aes, buf, buf,
+                            BENCH_AESXTS_SECTORS_SZ, 0,
+                            BENCH_AESXTS_SECTOR_SZ, threads[j]);
+                    }
+                    else {
+                        ret = wc_AesXtsEncryptSectors(&aes, buf, buf,
+                            BENCH_AESXTS_SECTORS_SZ, 0,
+                            BENCH_AESXTS_SECTOR_SZ, threads[j]);
+                    }
+                    if (ret != 0)
+                        goto exit_aesxts_sectors;
+                    RECORD_MULTI_VALUE_STATS();
+                }
+                count += i;
+            } while (bench_stats_check(start)
+        #ifdef MULTI_VALUE_STATISTICS
+               || runs < minimum_runs
+        #endif
+               );
+            if (threads[j] == 0) {
+                (void)XSNPRINTF(desc, sizeof(desc), "AES-256-XTS-%s-loop",
+                    dec ? "dec" : "enc");
+            }
+            else {
+                (void)XSNPRINTF(desc, sizeof(desc), "AES-256-XTS-%s-%dt",
+                    dec ? "dec" : "enc", threads[j]);
+            }
+            bench_stats_sym_finish(desc, 0, count, BENCH_AESXTS_SECTORS_SZ,
+                start, ret);
+        #ifdef MULTI_VALUE_STATISTICS
+            bench_multi_value_stats(max, min, sum, squareSum, runs);
+        #endif
+            RESET_MULTI_VALUE_STATS_VARS();
+        }
+    }
+
+exit_aesxts_sectors:
+    if (ret != 0) {
+        printf("%sAES-XTS sectors failed: %d\n", err_prefix, ret);
+    }
+exit:
+    wc_AesXtsFree(&aes);
+    XFREE(buf, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+}
 #endif /* WOLFSSL_AES_XTS */
 
 
@@ -6289,6 +6704,97 @@ exit:
     }
     WC_FREE_ARRAY(digest, BENCH_MAX_PENDING, HEAP_HINT);
 }
+
+#ifdef WOLFSSL_SHA256_MB
+#define BENCH_SHA256_MB_MIN     64
+#define BENCH_SHA256_MB_MAX     4096
+/* messages hashed between checks of the time */
+#define BENCH_SHA256_MB_MSGS    256
+
+/* Hashes per second of small independent messages, one at a time and with
+ * the multi-buffer API. */
+void bench_sha256_mb(void)
+{
+    wc_Sha256_MB mb;
+    double start = 0;
+    int    ret = 0, i, count = 0, sz, lanes;
+    byte*  msg = NULL;
+    byte   digest[WC_SHA256_DIGEST_SIZE];
+    char   extra[16];
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    ret = wc_Sha256_MB_Init(&mb, HEAP_HINT, INVALID_DEVID);
+    if (ret != 0)
+        goto exit;
+    lanes = wc_Sha256_MB_Lanes(&mb);
+
+    msg = (byte*)XMALLOC(BENCH_SHA256_MB_MAX, HEAP_HINT,
+                         DYNAMIC_TYPE_TMP_BUFFER);
+    if (msg == NULL) {
+        ret = MEMORY_E;
+        goto exit;
+    }
+    for (i = 0; i < BENCH_SHA256_MB_MAX; i++)
+        msg[i] = (byte)i;
+
+    for (sz = BENCH_SHA256_MB_MIN; sz <= BENCH_SHA256_MB_MAX; sz *= 4) {
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < BENCH_SHA256_MB_MSGS; i++) {
+                ret = wc_Sha256Hash(msg, (word32)sz, digest);
+                if (ret != 0)
+                    goto exit_sha256_mb;
+                RECORD_MULTI_VALUE_STATS();
+            }
+            count += i;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+        bench_stats_asym_finish_ex("SHA-256", sz, "hash", "-1", 0, count,
+                                   start, ret);
+    #ifdef MULTI_VALUE_STATISTICS
+        bench_multi_value_stats(max, min, sum, squareSum, runs);
+    #endif
+        RESET_MULTI_VALUE_STATS_VARS();
+
+        bench_stats_start(&count, &start);
+        do {
+            /* the digest of every message lands in the same buffer */
+            for (i = 0; i < BENCH_SHA256_MB_MSGS; i++) {
+                ret = wc_Sha256_MB_Submit(&mb, msg, (word32)sz, digest);
+                if (ret != 0)
+                    goto exit_sha256_mb;
+                RECORD_MULTI_VALUE_STATS();
+            }
+            ret = wc_Sha256_MB_Flush(&mb);
+            if (ret != 0)
+                goto exit_sha256_mb;
+            count += i;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+        (void)XSNPRINTF(extra, sizeof(extra), "-mb%d", lanes);
+        bench_stats_asym_finish_ex("SHA-256", sz, "hash", extra, 0, count,
+                                   start, ret);
+    #ifdef MULTI_VALUE_STATISTICS
+        bench_multi_value_stats(max, min, sum, squareSum, runs);
+    #endif
+        RESET_MULTI_VALUE_STATS_VARS();
+    }
+
+exit_sha256_mb:
+    if (ret != 0) {
+        printf("%sSHA-256 multi-buffer failed: %d\n", err_prefix, ret);
+    }
+exit:
+    wc_Sha256_MB_Free(&mb);
+    XFREE(msg, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+}
+#endif /* WOLFSSL_SHA256_MB */
 #endif
 
 #ifdef WOLFSSL_SHA384
@@ -7399,6 +7905,103 @@ exit:
     WC_FREE_ARRAY(digest, BENCH_MAX_PENDING, HEAP_HINT);
 }
 #endif /* WOLFSSL_SHAKE256 */
+
+#ifdef WOLFSSL_SHAKE128
+/* seed size and output blocks of a ML-KEM matrix polynomial */
+#define BENCH_SHAKE_X4_SEED     34
+#define BENCH_SHAKE_X4_BLOCKS   3
+/* streams generated between checks of the time */
+#define BENCH_SHAKE_X4_STREAMS  64
+
+/* SHAKE-128 streams per second, one at a time and four at a time. */
+void bench_shake_x4(void)
+{
+    wc_Shake     shake;
+    wc_Shake_x4  x4;
+    double       start = 0;
+    int          ret = 0, i, j, count = 0;
+    byte         seed[WC_SHAKE_X4_LANES][BENCH_SHAKE_X4_SEED];
+    byte*        out = NULL;
+    const byte*  in[WC_SHAKE_X4_LANES];
+    byte*        outs[WC_SHAKE_X4_LANES];
+    const word32 outSz = WC_SHA3_128_BLOCK_SIZE * BENCH_SHAKE_X4_BLOCKS;
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    out = (byte*)XMALLOC(outSz * WC_SHAKE_X4_LANES, HEAP_HINT,
+                         DYNAMIC_TYPE_TMP_BUFFER);
+    if (out == NULL) {
+        ret = MEMORY_E;
+        goto exit;
+    }
+    for (j = 0; j < WC_SHAKE_X4_LANES; j++) {
+        for (i = 0; i < BENCH_SHAKE_X4_SEED; i++)
+            seed[j][i] = (byte)(i + j);
+        in[j] = seed[j];
+        outs[j] = out + j * outSz;
+    }
+
+    bench_stats_start(&count, &start);
+    do {
+        for (i = 0; i < BENCH_SHAKE_X4_STREAMS; i++) {
+            ret = wc_InitShake128(&shake, HEAP_HINT, INVALID_DEVID);
+            if (ret == 0)
+                ret = wc_Shake128_Absorb(&shake, seed[0], sizeof(seed[0]));
+            if (ret == 0)
+                ret = wc_Shake128_SqueezeBlocks(&shake, out,
+                                                BENCH_SHAKE_X4_BLOCKS);
+            wc_Shake128_Free(&shake);
+            if (ret != 0)
+                goto exit_shake_x4;
+            RECORD_MULTI_VALUE_STATS();
+        }
+        count += i;
+    } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+       || runs < minimum_runs
+    #endif
+       );
+    bench_stats_asym_finish_ex("SHAKE128", (int)outSz, "xof", "-1", 0, count,
+                               start, ret);
+#ifdef MULTI_VALUE_STATISTICS
+    bench_multi_value_stats(max, min, sum, squareSum, runs);
+#endif
+    RESET_MULTI_VALUE_STATS_VARS();
+
+    bench_stats_start(&count, &start);
+    do {
+        for (i = 0; i < BENCH_SHAKE_X4_STREAMS; i += WC_SHAKE_X4_LANES) {
+            ret = wc_InitShake128_x4(&x4, HEAP_HINT, INVALID_DEVID);
+            if (ret == 0)
+                ret = wc_Shake128_x4_Absorb(&x4, in, BENCH_SHAKE_X4_SEED);
+            if (ret == 0)
+                ret = wc_Shake128_x4_SqueezeBlocks(&x4, outs,
+                                                   BENCH_SHAKE_X4_BLOCKS);
+            wc_Shake128_x4_Free(&x4);
+            if (ret != 0)
+                goto exit_shake_x4;
+            RECORD_MULTI_VALUE_STATS();
+        }
+        count += i;
+    } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+       || runs < minimum_runs
+    #endif
+       );
+    bench_stats_asym_finish_ex("SHAKE128", (int)outSz, "xof", "-x4", 0, count,
+                               start, ret);
+#ifdef MULTI_VALUE_STATISTICS
+    bench_multi_value_stats(max, min, sum, squareSum, runs);
+#endif
+    RESET_MULTI_VALUE_STATS_VARS();
+
+exit_shake_x4:
+    if (ret != 0) {
+        printf("%sSHAKE128 x4 failed: %d\n", err_prefix, ret);
+    }
+exit:
+    XFREE(out, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+}
+#endif /* WOLFSSL_SHAKE128 */
 #endif
 
 #ifdef WOLFSSL_SM3
@@ -8332,6 +8935,74 @@ void bench_rsaKeyGen_size(int useDeviceID, word32 keySz)
 {
     bench_rsaKeyGen_helper(useDeviceID, keySz);
 }
+
+#ifdef WOLFSSL_KEYGEN_THREADS
+/* most keys generated for each thread count */
+#define BENCH_RSA_KG_MAX_KEYS   256
+
+/* sort latencies for percentiles */
+static void bench_sort_times(double* t, int n)
+{
+    int i, j;
+    double v;
+
+    for (i = 1; i < n; i++) {
+        v = t[i];
+        for (j = i; j > 0 && t[j - 1] > v; j--)
+            t[j] = t[j - 1];
+        t[j] = v;
+    }
+}
+
+/* RSA key generation latency when searching for primes on 1 to 8 threads */
+void bench_rsaKeyGen_threads(word32 keySz)
+{
+    RsaKey key;
+    int    ret = 0, threads, count = 0;
+    double start = 0, t;
+    double* lat = NULL;
+    char   extra[16];
+    const char**desc = bench_desc_words[lng_index];
+
+    lat = (double*)XMALLOC(sizeof(double) * BENCH_RSA_KG_MAX_KEYS, HEAP_HINT,
+                           DYNAMIC_TYPE_TMP_BUFFER);
+    if (lat == NULL) {
+        printf("%sRSA key gen threads failed: %d\n", err_prefix, MEMORY_E);
+        return;
+    }
+
+    for (threads = 1; threads <= 8; threads *= 2) {
+        bench_stats_start(&count, &start);
+        do {
+            t = current_time(0);
+            ret = wc_InitRsaKey_ex(&key, HEAP_HINT, INVALID_DEVID);
+            if (ret == 0)
+                ret = wc_RsaSetKeyGenThreads(&key, threads);
+            if (ret == 0)
+                ret = wc_MakeRsaKey(&key, (int)keySz, WC_RSA_EXPONENT, &gRng);
+            wc_FreeRsaKey(&key);
+            if (ret != 0)
+                break;
+            lat[count] = current_time(0) - t;
+            count++;
+        } while ((bench_stats_check(start) || count < 2) &&
+                 count < BENCH_RSA_KG_MAX_KEYS);
+
+        (void)XSNPRINTF(extra, sizeof(extra), "-t%d", threads);
+        bench_stats_asym_finish_ex("RSA", (int)keySz, desc[2], extra, 0,
+                                   count, start, ret);
+        if (ret != 0)
+            break;
+
+        bench_sort_times(lat, count);
+        printf("%sRSA %d key gen %s latency p50 %.3f ms, p99 %.3f ms\n",
+               info_prefix, (int)keySz, extra, lat[count / 2] * 1000,
+               lat[(count * 99) / 100] * 1000);
+    }
+
+    XFREE(lat, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+}
+#endif /* WOLFSSL_KEYGEN_THREADS */
 #endif /* WOLFSSL_KEY_GEN */
 
 #if !defined(USE_CERT_BUFFERS_1024) && !defined(USE_CERT_BUFFERS_2048) && \
@@ -8529,7 +9200,7 @@ static void bench_rsa_helper(int useDeviceID,
            );
 
 exit_rsa_verify:
-        bench_stats_asym_finish("RSA", (int)rsaKeySz, desc[0],
+        bench_stats_asym_finish(rsa_bench_name, (int)rsaKeySz, desc[0],
                                 useDeviceID, count, start, ret);
     #ifdef MULTI_VALUE_STATISTICS
         bench_multi_value_stats(max, min, sum, squareSum, runs);
@@ -8576,7 +9247,7 @@ exit_rsa_verify:
            );
 
 exit_rsa_pub:
-        bench_stats_asym_finish("RSA", (int)rsaKeySz, desc[1],
+        bench_stats_asym_finish(rsa_bench_name, (int)rsaKeySz, desc[1],
                                 useDeviceID, count, start, ret);
     #ifdef MULTI_VALUE_STATISTICS
         bench_multi_value_stats(max, min, sum, squareSum, runs);
@@ -8615,7 +9286,7 @@ exit_rsa_pub:
            );
 
 exit_rsa_sign:
-        bench_stats_asym_finish("RSA", (int)rsaKeySz, desc[4], useDeviceID,
+        bench_stats_asym_finish(rsa_bench_name, (int)rsaKeySz, desc[4], useDeviceID,
                                 count, start, ret);
     #ifdef MULTI_VALUE_STATISTICS
         bench_multi_value_stats(max, min, sum, squareSum, runs);
@@ -8682,7 +9353,7 @@ exit_rsa_sign:
            );
 
 exit_rsa_verifyinline:
-        bench_stats_asym_finish("RSA", (int)rsaKeySz, desc[5],
+        bench_stats_asym_finish(rsa_bench_name, (int)rsaKeySz, desc[5],
                                  useDeviceID, count,  start, ret);
     #ifdef MULTI_VALUE_STATISTICS
         bench_multi_value_stats(max, min, sum, squareSum, runs);
@@ -8788,6 +9459,23 @@ void bench_rsa(int useDeviceID)
         bench_rsa_helper(useDeviceID, rsaKey, rsaKeySz);
     }
 
+#if defined(WC_RSA_PREPARED) && !defined(WOLFSSL_RSA_PUBLIC_ONLY) && \
+    !defined(WOLFSSL_RSA_VERIFY_ONLY)
+    /* Same operations with cached blinding values. */
+    if (rsaKeySz > 0) {
+        for (i = 0; i < BENCH_MAX_PENDING; i++) {
+            ret = wc_RsaPrepareKey(rsaKey[i], &gRng);
+            if (ret != 0) {
+                printf("wc_RsaPrepareKey failed! %d\n", ret);
+                goto exit;
+            }
+        }
+        rsa_bench_name = "RSA-prep";
+        bench_rsa_helper(useDeviceID, rsaKey, rsaKeySz);
+        rsa_bench_name = "RSA";
+    }
+#endif
+
     (void)bytes;
     (void)tmp;
 
@@ -10770,6 +11458,119 @@ exit:
     (void)name;
 }
 
+#if defined(HAVE_ECC_SIGN) && defined(HAVE_ECC_VERIFY) && \
+    defined(WOLFSSL_PUBLIC_MP) && !defined(WOLFSSL_ASYNC_CRYPT)
+/* number of keys signing the batch, as when checking against a few CAs */
+#define BENCH_ECC_BATCH_KEYS 4
+#define BENCH_ECC_BATCH_MAX  64
+
+void bench_ecc_verify_batch(int curveId)
+{
+    int ret = 0, i, n, times, count = 0, keySize;
+    char name[BENCH_ECC_NAME_SZ];
+    char extra[16];
+    double start = 0;
+    const char**desc = bench_desc_words[lng_index];
+    ecc_key* key = NULL;
+    mp_int* rs = NULL;
+    mp_int* r[BENCH_ECC_BATCH_MAX];
+    mp_int* s[BENCH_ECC_BATCH_MAX];
+    ecc_key* k[BENCH_ECC_BATCH_MAX];
+    const byte* h[BENCH_ECC_BATCH_MAX];
+    word32 hLen[BENCH_ECC_BATCH_MAX];
+    int res[BENCH_ECC_BATCH_MAX];
+    byte digest[MAX_ECC_BYTES];
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    keySize = wc_ecc_get_curve_size_from_id(curveId);
+    for (i = 0; i < (int)sizeof(digest); i++) {
+        digest[i] = (byte)i;
+    }
+
+    key = (ecc_key*)XMALLOC(sizeof(ecc_key) * BENCH_ECC_BATCH_KEYS, HEAP_HINT,
+                            DYNAMIC_TYPE_ECC);
+    rs = (mp_int*)XMALLOC(sizeof(mp_int) * 2 * BENCH_ECC_BATCH_MAX, HEAP_HINT,
+                          DYNAMIC_TYPE_BIGINT);
+    if (key == NULL || rs == NULL) {
+        ret = MEMORY_E;
+        goto exit;
+    }
+    XMEMSET(key, 0, sizeof(ecc_key) * BENCH_ECC_BATCH_KEYS);
+    XMEMSET(rs, 0, sizeof(mp_int) * 2 * BENCH_ECC_BATCH_MAX);
+
+    for (i = 0; i < BENCH_ECC_BATCH_KEYS; i++) {
+        ret = wc_ecc_init_ex(&key[i], HEAP_HINT, INVALID_DEVID);
+        if (ret == 0)
+            ret = wc_ecc_make_key_ex(&gRng, keySize, &key[i], curveId);
+        if (ret != 0)
+            goto exit;
+    }
+
+    /* sign once with each key in turn, every batch verifies a prefix */
+    for (i = 0; i < BENCH_ECC_BATCH_MAX; i++) {
+        r[i] = &rs[2 * i];
+        s[i] = &rs[2 * i + 1];
+        k[i] = &key[i % BENCH_ECC_BATCH_KEYS];
+        h[i] = digest;
+        hLen[i] = (word32)keySize;
+        ret = mp_init_multi(r[i], s[i], NULL, NULL, NULL, NULL);
+        if (ret == 0)
+            ret = wc_ecc_sign_hash_ex(digest, (word32)keySize, &gRng, k[i],
+                                      r[i], s[i]);
+        if (ret != 0)
+            goto exit;
+    }
+
+    (void)XSNPRINTF(name, BENCH_ECC_NAME_SZ, "ECDSA [%15s]",
+                    wc_ecc_get_name(curveId));
+
+    for (n = 1; n <= BENCH_ECC_BATCH_MAX; n *= 2) {
+        bench_stats_start(&count, &start);
+        do {
+            for (times = 0; times < agreeTimes; times += n) {
+                ret = wc_ecc_verify_hash_batch(r, s, h, hLen, res, k, n);
+                if (ret != 0 || res[n - 1] != 1) {
+                    ret = (ret != 0) ? ret : SIG_VERIFY_E;
+                    goto exit_batch;
+                }
+                RECORD_MULTI_VALUE_STATS();
+            }
+            count += times;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+
+exit_batch:
+        (void)XSNPRINTF(extra, sizeof(extra), "-b%d", n);
+        bench_stats_asym_finish_ex(name, keySize * 8, desc[5], extra, 0,
+                                   count, start, ret);
+    #ifdef MULTI_VALUE_STATISTICS
+        bench_multi_value_stats(max, min, sum, squareSum, runs);
+    #endif
+        RESET_MULTI_VALUE_STATS_VARS();
+        if (ret != 0)
+            break;
+    }
+
+exit:
+    if (rs != NULL) {
+        for (i = 0; i < 2 * BENCH_ECC_BATCH_MAX; i++)
+            mp_free(&rs[i]);
+        XFREE(rs, HEAP_HINT, DYNAMIC_TYPE_BIGINT);
+    }
+    if (key != NULL) {
+        for (i = 0; i < BENCH_ECC_BATCH_KEYS; i++)
+            wc_ecc_free(&key[i]);
+        XFREE(key, HEAP_HINT, DYNAMIC_TYPE_ECC);
+    }
+    if (ret != 0) {
+        printf("%sECDSA batch verify failed: %d\n", err_prefix, ret);
+    }
+}
+#endif /* HAVE_ECC_SIGN && HAVE_ECC_VERIFY && WOLFSSL_PUBLIC_MP */
+
 
 #ifdef HAVE_ECC_ENCRYPT
 void bench_eccEncrypt(int curveId)
@@ -11497,6 +12298,150 @@ exit_ed_verify:
 
     wc_ed25519_free(&genKey);
 }
+
+#if defined(HAVE_ED25519_SIGN) && defined(HAVE_ED25519_VERIFY) && \
+    defined(HAVE_ED25519_MAKE_KEY)
+/* number of keys signing the batch */
+#define BENCH_ED25519_BATCH_KEYS 8
+#define BENCH_ED25519_BATCH_MIN  8
+#define BENCH_ED25519_BATCH_MAX  256
+
+void bench_ed25519_verify_batch(void)
+{
+    int ret = 0, i, n, times, count = 0, verify;
+    char extra[16];
+    double start = 0, single = 0, total;
+    const char**desc = bench_desc_words[lng_index];
+    ed25519_key* key = NULL;
+    byte* sigs = NULL;
+    const byte* sig[BENCH_ED25519_BATCH_MAX];
+    word32 sigLen[BENCH_ED25519_BATCH_MAX];
+    const byte* msg[BENCH_ED25519_BATCH_MAX];
+    word32 msgLen[BENCH_ED25519_BATCH_MAX];
+    int res[BENCH_ED25519_BATCH_MAX];
+    ed25519_key* k[BENCH_ED25519_BATCH_MAX];
+    byte m[512];
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    /* make dummy msg */
+    for (i = 0; i < (int)sizeof(m); i++)
+        m[i] = (byte)i;
+
+    key = (ed25519_key*)XMALLOC(sizeof(ed25519_key) * BENCH_ED25519_BATCH_KEYS,
+                                HEAP_HINT, DYNAMIC_TYPE_ED25519);
+    sigs = (byte*)XMALLOC(ED25519_SIG_SIZE * BENCH_ED25519_BATCH_MAX,
+                          HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (key != NULL)
+        XMEMSET(key, 0, sizeof(ed25519_key) * BENCH_ED25519_BATCH_KEYS);
+    if (key == NULL || sigs == NULL) {
+        ret = MEMORY_E;
+        goto exit;
+    }
+
+    for (i = 0; i < BENCH_ED25519_BATCH_KEYS; i++) {
+        ret = wc_ed25519_init_ex(&key[i], HEAP_HINT, INVALID_DEVID);
+        if (ret == 0)
+            ret = wc_ed25519_make_key(&gRng, ED25519_KEY_SIZE, &key[i]);
+        if (ret != 0)
+            goto exit;
+    }
+
+    /* sign once with each key in turn, every batch verifies a prefix */
+    for (i = 0; i < BENCH_ED25519_BATCH_MAX; i++) {
+        sig[i] = sigs + i * ED25519_SIG_SIZE;
+        sigLen[i] = ED25519_SIG_SIZE;
+        msg[i] = m;
+        msgLen[i] = (word32)sizeof(m);
+        k[i] = &key[i % BENCH_ED25519_BATCH_KEYS];
+        ret = wc_ed25519_sign_msg(m, sizeof(m), sigs + i * ED25519_SIG_SIZE,
+                                  &sigLen[i], k[i]);
+        if (ret != 0)
+            goto exit;
+    }
+
+    /* the same signatures verified one at a time, the batch must beat it */
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < agreeTimes; times++) {
+            i = times % BENCH_ED25519_BATCH_MAX;
+            verify = 0;
+            ret = wc_ed25519_verify_msg(sig[i], sigLen[i], msg[i], msgLen[i],
+                                        &verify, k[i]);
+            if (ret != 0 || verify != 1) {
+                ret = (ret != 0) ? ret : SIG_VERIFY_E;
+                goto exit_single;
+            }
+            RECORD_MULTI_VALUE_STATS();
+        }
+        count += times;
+    } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+       || runs < minimum_runs
+    #endif
+       );
+    total = current_time(0) - start;
+    if (total > 0)
+        single = count / total;
+
+exit_single:
+    bench_stats_asym_finish_ex("ED", 25519, desc[5], "-b1", 0, count, start,
+                               ret);
+#ifdef MULTI_VALUE_STATISTICS
+    bench_multi_value_stats(max, min, sum, squareSum, runs);
+#endif
+    RESET_MULTI_VALUE_STATS_VARS();
+    if (ret != 0)
+        goto exit;
+
+    for (n = BENCH_ED25519_BATCH_MIN; n <= BENCH_ED25519_BATCH_MAX; n *= 2) {
+        bench_stats_start(&count, &start);
+        do {
+            for (times = 0; times < agreeTimes; times += n) {
+                ret = wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen,
+                                                  res, k, (word32)n, &gRng);
+                if (ret != 0 || res[n - 1] != 1) {
+                    ret = (ret != 0) ? ret : SIG_VERIFY_E;
+                    goto exit_batch;
+                }
+                RECORD_MULTI_VALUE_STATS();
+            }
+            count += times;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+        total = current_time(0) - start;
+        if (total > 0 && count / total <= single) {
+            printf("%sED25519 batch of %d not faster than single verify\n",
+                   err_prefix, n);
+            ret = -1;
+        }
+
+exit_batch:
+        (void)XSNPRINTF(extra, sizeof(extra), "-b%d", n);
+        bench_stats_asym_finish_ex("ED", 25519, desc[5], extra, 0, count,
+                                   start, ret);
+    #ifdef MULTI_VALUE_STATISTICS
+        bench_multi_value_stats(max, min, sum, squareSum, runs);
+    #endif
+        RESET_MULTI_VALUE_STATS_VARS();
+        if (ret != 0)
+            break;
+    }
+
+exit:
+    if (key != NULL) {
+        for (i = 0; i < BENCH_ED25519_BATCH_KEYS; i++)
+            wc_ed25519_free(&key[i]);
+        XFREE(key, HEAP_HINT, DYNAMIC_TYPE_ED25519);
+    }
+    XFREE(sigs, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (ret != 0) {
+        printf("%sED25519 batch verify failed: %d\n", err_prefix, ret);
+    }
+}
+#endif /* HAVE_ED25519_SIGN && HAVE_ED25519_VERIFY && HAVE_ED25519_MAKE_KEY */
 #endif /* HAVE_ED25519 */
 
 #ifdef HAVE_CURVE448
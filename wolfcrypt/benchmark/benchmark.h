@@ -52,9 +52,12 @@ void bench_chacha20_poly1305_aead(void);
 void bench_aescbc(int useDeviceID);
 void bench_aesgcm(int useDeviceID);
 void bench_gmac(int useDeviceID);
+void bench_aesgcm_multi(void);
+void bench_aesgcm_vaes(void);
 void bench_aesccm(int useDeviceID);
 void bench_aesecb(int useDeviceID);
 void bench_aesxts(void);
+void bench_aesxts_sectors(void);
 void bench_aesctr(int useDeviceID);
 void bench_aescfb(void);
 void bench_aesofb(void);
@@ -68,6 +71,7 @@ void bench_md5(int useDeviceID);
 void bench_sha(int useDeviceID);
 void bench_sha224(int useDeviceID);
 void bench_sha256(int useDeviceID);
+void bench_sha256_mb(void);
 void bench_sha384(int useDeviceID);
 void bench_sha512(int useDeviceID);
 #if !defined(WOLFSSL_NOSHA512_224) && \
@@ -84,6 +88,7 @@ void bench_sha3_384(int useDeviceID);
 void bench_sha3_512(int useDeviceID);
 void bench_shake128(int useDeviceID);
 void bench_shake256(int useDeviceID);
+void bench_shake_x4(void);
 void bench_sm3(int useDeviceID);
 void bench_ripemd(void);
 void bench_cmac(int useDeviceID);
@@ -98,6 +103,7 @@ void bench_siphash(void);
 void bench_srtpkdf(void);
 void bench_rsaKeyGen(int useDeviceID);
 void bench_rsaKeyGen_size(int useDeviceID, word32 keySz);
+void bench_rsaKeyGen_threads(word32 keySz);
 void bench_rsa(int useDeviceID);
 void bench_rsa_key(int useDeviceID, word32 keySz);
 void bench_dh(int useDeviceID);
@@ -107,12 +113,14 @@ void bench_xmss(int hash);
 void bench_ecc_curve(int curveId);
 void bench_eccMakeKey(int useDeviceID, int curveId);
 void bench_ecc(int useDeviceID, int curveId);
+void bench_ecc_verify_batch(int curveId);
 void bench_eccEncrypt(int curveId);
 void bench_sm2(int useDeviceID);
 void bench_curve25519KeyGen(int useDeviceID);
 void bench_curve25519KeyAgree(int useDeviceID);
 void bench_ed25519KeyGen(void);
 void bench_ed25519KeySign(void);
+void bench_ed25519_verify_batch(void);
 void bench_curve448KeyGen(void);
 void bench_curve448KeyAgree(void);
 void bench_ed448KeyGen(void);
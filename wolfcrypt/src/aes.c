@@ -6355,6 +6355,493 @@ void GenerateM0(Gcm* gcm)
 
 #endif /* GCM_TABLE */
 
+#if defined(WOLFSSL_AESNI) && defined(WOLFSSL_X86_64_BUILD) && \
+    (defined(WOLFSSL_AESGCM_VAES) || defined(WOLFSSL_AESGCM_MULTI)) && \
+    !defined(WOLFSSL_LINUXKM) && \
+    ((defined(__GNUC__) && __GNUC__ >= 8) || \
+     (defined(__clang__) && __clang_major__ >= 6))
+/* AES and GHASH on ZMM registers with VAES and VPCLMULQDQ.
+ *
+ * GHASH is calculated on byte reversed blocks, as in aes_gcm_asm.S, so that
+ * the state can be shared with the assembly code.
+ */
+#include <immintrin.h>
+
+#define WC_AESGCM_AVX512
+
+#define AESGCM_VAES_TARGET \
+    __attribute__((target("avx512f,avx512bw,vaes,vpclmulqdq")))
+
+/* CPU supports the instructions used on ZMM registers. */
+#define AESGCM_VAES_CPU(f) \
+    (IS_INTEL_AVX512(f) && IS_INTEL_AVX512BW(f) && IS_INTEL_VAES(f) && \
+     IS_INTEL_VPCLMULQDQ(f))
+
+/* Convert byte reversed hash keys for AesGcmVaesGfMul().
+ *
+ * Each key is multiplied by x so that products need no shift before
+ * reduction.
+ */
+static WC_INLINE AESGCM_VAES_TARGET __m512i AesGcmVaesHashKey(__m512i h)
+{
+    const __m512i poly = _mm512_broadcast_i32x4(
+        _mm_set_epi32((int)0xc2000000, 0, 0, 1));
+    __m512i carry;
+    __m512i t;
+
+    carry = _mm512_srai_epi32(_mm512_shuffle_epi32(h, _MM_PERM_DDDD), 31);
+    t = _mm512_bslli_epi128(_mm512_srli_epi64(h, 63), 8);
+    h = _mm512_or_si512(_mm512_slli_epi64(h, 1), t);
+
+    return _mm512_xor_si512(h, _mm512_and_si512(carry, poly));
+}
+
+/* Reduce lo + mid.x^64 + hi.x^128 in each 128-bit lane - byte reversed.
+ *
+ * Two multiplications by the polynomial fold the low half into the high half.
+ */
+static WC_INLINE AESGCM_VAES_TARGET __m512i AesGcmVaesReduce(__m512i lo,
+    __m512i mid, __m512i hi)
+{
+    const __m512i poly = _mm512_broadcast_i32x4(
+        _mm_set_epi32((int)0xc2000000, 0, 0, 1));
+    __m512i t;
+
+    t = _mm512_clmulepi64_epi128(poly, lo, 0x01);
+    mid = _mm512_ternarylogic_epi32(mid,
+        _mm512_shuffle_epi32(lo, _MM_PERM_BADC), t, 0x96);
+    t = _mm512_clmulepi64_epi128(poly, mid, 0x01);
+    return _mm512_ternarylogic_epi32(hi,
+        _mm512_shuffle_epi32(mid, _MM_PERM_BADC), t, 0x96);
+}
+
+/* Multiply and add a into unreduced lo, mid and hi. */
+#define AESGCM_VAES_MUL_ADD(a, h)                                           \
+    do {                                                                    \
+        lo = _mm512_xor_si512(lo, _mm512_clmulepi64_epi128(a, h, 0x00));    \
+        hi = _mm512_xor_si512(hi, _mm512_clmulepi64_epi128(a, h, 0x11));    \
+        mid = _mm512_ternarylogic_epi32(mid,                                \
+            _mm512_clmulepi64_epi128(a, h, 0x01),                           \
+            _mm512_clmulepi64_epi128(a, h, 0x10), 0x96);                    \
+    } while (0)
+
+/* Multiply x by h in GF(2^128) in each 128-bit lane - x and result byte
+ * reversed, h converted by AesGcmVaesHashKey().
+ */
+static WC_INLINE AESGCM_VAES_TARGET __m512i AesGcmVaesGfMul(__m512i x,
+    __m512i h)
+{
+    __m512i lo = _mm512_setzero_si512();
+    __m512i mid = _mm512_setzero_si512();
+    __m512i hi = _mm512_setzero_si512();
+
+    AESGCM_VAES_MUL_ADD(x, h);
+    return AesGcmVaesReduce(lo, mid, hi);
+}
+#endif
+
+#if defined(WOLFSSL_AESGCM_VAES) && defined(WC_AESGCM_AVX512)
+/* AES-GCM of one message with VAES and VPCLMULQDQ.
+ *
+ * Sixteen blocks, four in each ZMM register, are encrypted and hashed with
+ * one reduction. H^16..H^1 are calculated when the key is set.
+ */
+#define WC_AESGCM_VAES
+
+/* Number of blocks processed together. */
+#define AESGCM_VAES_BLOCKS          16
+/* Fewest bytes of a message worth using the ZMM code for. */
+#ifndef WC_AESGCM_VAES_MIN_SZ
+    #define WC_AESGCM_VAES_MIN_SZ   128
+#endif
+
+/* Use the ZMM code for an amount of data.
+ *
+ * Flags are read each time so that the code can be disabled at runtime with
+ * cpuid_clear_flag().
+ */
+#define AESGCM_VAES_USE(aes, sz) \
+    (((sz) >= WC_AESGCM_VAES_MIN_SZ) && (aes)->gcm.HPowSet && \
+     AESGCM_VAES_CPU(cpuid_get_flags()))
+
+/* Round key broadcast to all lanes. */
+#define AESGCM_VAES_RK(key, r) \
+    _mm512_broadcast_i32x4(_mm_loadu_si128( \
+        (const __m128i*)((key) + (r) * AES_BLOCK_SIZE)))
+
+/* Calculate H^16..H^1 converted for AesGcmVaesGfMul().
+ *
+ * @param [in, out] aes  AES key object. H set and HPow calculated.
+ */
+static AESGCM_VAES_TARGET void AesGcmVaesSetKey(Aes* aes)
+{
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+        12, 13, 14, 15);
+    __m512i h1;
+    __m512i hk;
+    __m512i p;
+    __m512i p4;
+    __m512i p8;
+
+    h1 = _mm512_broadcast_i32x4(_mm_shuffle_epi8(
+        _mm_loadu_si128((const __m128i*)aes->gcm.H), bswap));
+    /* Lanes from first: H^2 | H | H^2 | H */
+    p = AesGcmVaesGfMul(h1, AesGcmVaesHashKey(h1));
+    hk = AesGcmVaesHashKey(p);
+    p = _mm512_mask_blend_epi64(0xcc, p, h1);
+    /* H^4 | H^3 | H^2 | H */
+    p4 = _mm512_mask_blend_epi64(0xf0, AesGcmVaesGfMul(p, hk), p);
+    /* H^8 | H^7 | H^6 | H^5 */
+    hk = AesGcmVaesHashKey(_mm512_shuffle_i32x4(p4, p4, 0x00));
+    p8 = AesGcmVaesGfMul(p4, hk);
+    hk = AesGcmVaesHashKey(_mm512_shuffle_i32x4(p8, p8, 0x00));
+
+    _mm512_storeu_si512(aes->gcm.HPow[0],
+        AesGcmVaesHashKey(AesGcmVaesGfMul(p8, hk)));
+    _mm512_storeu_si512(aes->gcm.HPow[4],
+        AesGcmVaesHashKey(AesGcmVaesGfMul(p4, hk)));
+    _mm512_storeu_si512(aes->gcm.HPow[8], AesGcmVaesHashKey(p8));
+    _mm512_storeu_si512(aes->gcm.HPow[12], AesGcmVaesHashKey(p4));
+}
+
+/* Counters of the first four blocks.
+ *
+ * @param [in] ctr  Counter of next block in format of aes_gcm_asm.S - 64-bit
+ *                  halves byte reversed.
+ * @return  Counters of next four blocks.
+ */
+static WC_INLINE AESGCM_VAES_TARGET __m512i AesGcmVaesCtr(__m128i ctr)
+{
+    return _mm512_add_epi32(_mm512_broadcast_i32x4(ctr),
+        _mm512_set_epi32(0, 3, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0));
+}
+
+/* Encrypt the block in each lane. */
+static WC_INLINE AESGCM_VAES_TARGET __m512i AesGcmVaesEnc(const byte* key,
+    int nr, __m512i s)
+{
+    int r;
+
+    s = _mm512_xor_si512(s, AESGCM_VAES_RK(key, 0));
+    for (r = 1; r < nr; r++) {
+        s = _mm512_aesenc_epi128(s, AESGCM_VAES_RK(key, r));
+    }
+    return _mm512_aesenclast_epi128(s, AESGCM_VAES_RK(key, nr));
+}
+
+/* Mask of the bytes of a register of data.
+ *
+ * @param [in] sz  Number of bytes of data.
+ * @param [in] v   Index of register.
+ * @return  Mask with a bit set for each byte of data in the register.
+ */
+static WC_INLINE __mmask64 AesGcmVaesMask(word32 sz, word32 v)
+{
+    __mmask64 m = 0;
+
+    if (sz >= 64 * (v + 1)) {
+        m = (__mmask64)-1;
+    }
+    else if (sz > 64 * v) {
+        m = ((__mmask64)1 << (sz - 64 * v)) - 1;
+    }
+    return m;
+}
+
+/* Apply one AES round operation to the blocks of all registers. */
+#define AESGCM_VAES_ROUND(op, k)                                            \
+    do {                                                                    \
+        s0 = op(s0, k);                                                     \
+        s1 = op(s1, k);                                                     \
+        s2 = op(s2, k);                                                     \
+        s3 = op(s3, k);                                                     \
+    } while (0)
+
+/* Encrypt or decrypt, and hash, up to 16 blocks.
+ *
+ * The last block may be partial and is zero padded for GHASH.
+ *
+ * @param [in]      key  Round keys of AES key.
+ * @param [in]      nr   Number of rounds.
+ * @param [in]      hp   H^16..H^1, converted.
+ * @param [in, out] ctr  Counters of next four blocks.
+ * @param [out]     out  Output data. NULL when data is only hashed.
+ * @param [in]      in   Input data.
+ * @param [in]      sz   Number of bytes of data - at most 256.
+ * @param [in]      x    GHASH state, byte reversed.
+ * @param [in]      enc  1 to encrypt, 0 to decrypt.
+ * @return  GHASH state, byte reversed.
+ */
+static WC_INLINE AESGCM_VAES_TARGET __m128i AesGcmVaesChunk(const byte* key,
+    int nr, const byte (*hp)[AES_BLOCK_SIZE], __m512i* ctr, byte* out,
+    const byte* in, word32 sz, __m128i x, int enc)
+{
+    const __m512i bswap = _mm512_broadcast_i32x4(_mm_set_epi8(0, 1, 2, 3, 4,
+        5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    const word32 blocks = (sz + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+    const __mmask64 m0 = AesGcmVaesMask(sz, 0);
+    const __mmask64 m1 = AesGcmVaesMask(sz, 1);
+    const __mmask64 m2 = AesGcmVaesMask(sz, 2);
+    const __mmask64 m3 = AesGcmVaesMask(sz, 3);
+    __m512i d0, d1, d2, d3;
+    __m512i lo = _mm512_setzero_si512();
+    __m512i mid = _mm512_setzero_si512();
+    __m512i hi = _mm512_setzero_si512();
+    __m256i t;
+
+    /* Block i is multiplied by H^(blocks-i). */
+    hp += AESGCM_VAES_BLOCKS - blocks;
+
+    d0 = _mm512_maskz_loadu_epi8(m0, in + 0 * 64);
+    d1 = _mm512_maskz_loadu_epi8(m1, in + 1 * 64);
+    d2 = _mm512_maskz_loadu_epi8(m2, in + 2 * 64);
+    d3 = _mm512_maskz_loadu_epi8(m3, in + 3 * 64);
+    if (out != NULL) {
+        const __m512i bswap64 = _mm512_broadcast_i32x4(_mm_set_epi8(8, 9, 10,
+            11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7));
+        const __m512i four = _mm512_maskz_set1_epi32(0x4444, 4);
+        __m512i c = *ctr;
+        __m512i k;
+        __m512i s0, s1, s2, s3;
+        int r;
+
+        s0 = _mm512_shuffle_epi8(c, bswap64);
+        c = _mm512_add_epi32(c, four);
+        s1 = _mm512_shuffle_epi8(c, bswap64);
+        c = _mm512_add_epi32(c, four);
+        s2 = _mm512_shuffle_epi8(c, bswap64);
+        c = _mm512_add_epi32(c, four);
+        s3 = _mm512_shuffle_epi8(c, bswap64);
+        *ctr = _mm512_add_epi32(*ctr, _mm512_maskz_set1_epi32(0x4444,
+            (int)blocks));
+
+        k = AESGCM_VAES_RK(key, 0);
+        AESGCM_VAES_ROUND(_mm512_xor_si512, k);
+        for (r = 1; r < nr; r++) {
+            k = AESGCM_VAES_RK(key, r);
+            AESGCM_VAES_ROUND(_mm512_aesenc_epi128, k);
+        }
+        k = AESGCM_VAES_RK(key, nr);
+        AESGCM_VAES_ROUND(_mm512_aesenclast_epi128, k);
+
+        s0 = _mm512_xor_si512(s0, d0);
+        s1 = _mm512_xor_si512(s1, d1);
+        s2 = _mm512_xor_si512(s2, d2);
+        s3 = _mm512_xor_si512(s3, d3);
+        _mm512_mask_storeu_epi8(out + 0 * 64, m0, s0);
+        _mm512_mask_storeu_epi8(out + 1 * 64, m1, s1);
+        _mm512_mask_storeu_epi8(out + 2 * 64, m2, s2);
+        _mm512_mask_storeu_epi8(out + 3 * 64, m3, s3);
+        if (enc) {
+            d0 = _mm512_maskz_mov_epi8(m0, s0);
+            d1 = _mm512_maskz_mov_epi8(m1, s1);
+            d2 = _mm512_maskz_mov_epi8(m2, s2);
+            d3 = _mm512_maskz_mov_epi8(m3, s3);
+        }
+    }
+
+    /* X = (X ^ C0).H^n ^ C1.H^(n-1) ^ ... ^ Cn-1.H
+     * Hash keys of registers without data aren't loaded. */
+    d0 = _mm512_xor_si512(_mm512_shuffle_epi8(d0, bswap),
+                          _mm512_maskz_broadcast_i32x4(0x000f, x));
+    d1 = _mm512_shuffle_epi8(d1, bswap);
+    d2 = _mm512_shuffle_epi8(d2, bswap);
+    d3 = _mm512_shuffle_epi8(d3, bswap);
+    AESGCM_VAES_MUL_ADD(d0, _mm512_maskz_loadu_epi8(
+        AesGcmVaesMask(blocks * AES_BLOCK_SIZE, 0), hp[0]));
+    AESGCM_VAES_MUL_ADD(d1, _mm512_maskz_loadu_epi8(
+        AesGcmVaesMask(blocks * AES_BLOCK_SIZE, 1), hp[4]));
+    AESGCM_VAES_MUL_ADD(d2, _mm512_maskz_loadu_epi8(
+        AesGcmVaesMask(blocks * AES_BLOCK_SIZE, 2), hp[8]));
+    AESGCM_VAES_MUL_ADD(d3, _mm512_maskz_loadu_epi8(
+        AesGcmVaesMask(blocks * AES_BLOCK_SIZE, 3), hp[12]));
+    d0 = AesGcmVaesReduce(lo, mid, hi);
+
+    /* Sum of the lanes. */
+    t = _mm256_xor_si256(_mm512_castsi512_si256(d0),
+                         _mm512_extracti64x4_epi64(d0, 1));
+    return _mm_xor_si128(_mm256_castsi256_si128(t),
+                         _mm256_extracti128_si256(t, 1));
+}
+
+/* Hash data.
+ *
+ * @param [in] hp  H^16..H^1, converted.
+ * @param [in] in  Data to hash. Last block zero padded.
+ * @param [in] sz  Number of bytes of data.
+ * @param [in] x   GHASH state, byte reversed.
+ * @return  GHASH state, byte reversed.
+ */
+static AESGCM_VAES_TARGET __m128i AesGcmVaesHash(
+    const byte (*hp)[AES_BLOCK_SIZE], const byte* in, word32 sz, __m128i x)
+{
+    for (; sz > 0; ) {
+        word32 n = min(sz, AESGCM_VAES_BLOCKS * AES_BLOCK_SIZE);
+
+        x = AesGcmVaesChunk(NULL, 0, hp, NULL, NULL, in, n, x, 0);
+        in += n;
+        sz -= n;
+    }
+    return x;
+}
+
+/* Encrypt or decrypt, and hash, data.
+ *
+ * @param [in]      key  Round keys of AES key.
+ * @param [in]      nr   Number of rounds.
+ * @param [in]      hp   H^16..H^1, converted.
+ * @param [in, out] ctr  Counters of next four blocks.
+ * @param [out]     out  Output data.
+ * @param [in]      in   Input data.
+ * @param [in]      sz   Number of bytes of data.
+ * @param [in]      x    GHASH state, byte reversed.
+ * @param [in]      enc  1 to encrypt, 0 to decrypt.
+ * @return  GHASH state, byte reversed.
+ */
+static AESGCM_VAES_TARGET __m128i AesGcmVaesCrypt(const byte* key, int nr,
+    const byte (*hp)[AES_BLOCK_SIZE], __m512i* ctr, byte* out, const byte* in,
+    word32 sz, __m128i x, int enc)
+{
+    for (; sz > 0; ) {
+        word32 n = min(sz, AESGCM_VAES_BLOCKS * AES_BLOCK_SIZE);
+
+        x = AesGcmVaesChunk(key, nr, hp, ctr, out, in, n, x, enc);
+        in += n;
+        out += n;
+        sz -= n;
+    }
+    return x;
+}
+
+/* Encrypt or decrypt, and calculate the tag of, a message.
+ *
+ * @param [in]  aes       AES key object.
+ * @param [out] out       Output data.
+ * @param [in]  in        Input data.
+ * @param [in]  sz        Number of bytes of data.
+ * @param [in]  iv        IV/nonce.
+ * @param [in]  ivSz      Length of IV/nonce in bytes.
+ * @param [in]  authIn    Additional authentication data.
+ * @param [in]  authInSz  Length of additional authentication data in bytes.
+ * @param [out] tag       Authentication tag - a block.
+ * @param [in]  enc       1 to encrypt, 0 to decrypt.
+ */
+static AESGCM_VAES_TARGET void AesGcmVaes(Aes* aes, byte* out, const byte* in,
+    word32 sz, const byte* iv, word32 ivSz, const byte* authIn,
+    word32 authInSz, byte* tag, int enc)
+{
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+        12, 13, 14, 15);
+    const __m128i bswap64 = _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1,
+        2, 3, 4, 5, 6, 7);
+    const byte* key = (const byte*)aes->key;
+    const byte (*hp)[AES_BLOCK_SIZE] = (const byte (*)[AES_BLOCK_SIZE])
+        aes->gcm.HPow;
+    const __m512i h = _mm512_broadcast_i32x4(_mm_loadu_si128(
+        (const __m128i*)hp[AESGCM_VAES_BLOCKS - 1]));
+    int nr = (int)aes->rounds;
+    ALIGN16 byte iv16[AES_BLOCK_SIZE];
+    __m128i j0;
+    __m128i s;
+    __m128i x;
+    __m512i ctr;
+
+    if (ivSz == GCM_NONCE_MID_SZ) {
+        /* J0 = IV || 0^31 || 1 */
+        XMEMCPY(iv16, iv, GCM_NONCE_MID_SZ);
+        iv16[12] = 0; iv16[13] = 0; iv16[14] = 0; iv16[15] = 1;
+        j0 = _mm_load_si128((const __m128i*)iv16);
+    }
+    else {
+        /* J0 = GHASH(IV || 0^s+64 || [len(IV)]64) */
+        x = AesGcmVaesHash(hp, iv, ivSz, _mm_setzero_si128());
+        x = _mm_xor_si128(x, _mm_set_epi64x(0, (long long)ivSz * 8));
+        x = _mm512_castsi512_si128(AesGcmVaesGfMul(_mm512_castsi128_si512(x),
+            h));
+        j0 = _mm_shuffle_epi8(x, bswap);
+    }
+    /* E(K, J0) */
+    s = _mm512_castsi512_si128(AesGcmVaesEnc(key, nr,
+        _mm512_castsi128_si512(j0)));
+    /* First block of data uses J0 + 1. */
+    ctr = AesGcmVaesCtr(_mm_add_epi32(_mm_shuffle_epi8(j0, bswap64),
+        _mm_set_epi32(0, 1, 0, 0)));
+
+    x = AesGcmVaesHash(hp, authIn, authInSz, _mm_setzero_si128());
+    x = AesGcmVaesCrypt(key, nr, hp, &ctr, out, in, sz, x, enc);
+    x = _mm_xor_si128(x, _mm_set_epi64x((long long)authInSz * 8,
+        (long long)sz * 8));
+    x = _mm512_castsi512_si128(AesGcmVaesGfMul(_mm512_castsi128_si512(x), h));
+    /* T = E(K, J0) ^ GHASH */
+    _mm_storeu_si128((__m128i*)tag, _mm_xor_si128(_mm_shuffle_epi8(x, bswap),
+        s));
+}
+
+/* Encrypt and authenticate a message.
+ *
+ * @return  0 on success.
+ */
+static int AesGcmVaesEncrypt(Aes* aes, byte* out, const byte* in, word32 sz,
+    const byte* iv, word32 ivSz, byte* authTag, word32 authTagSz,
+    const byte* authIn, word32 authInSz)
+{
+    ALIGN16 byte tag[AES_BLOCK_SIZE];
+
+    AesGcmVaes(aes, out, in, sz, iv, ivSz, authIn, authInSz, tag, 1);
+    XMEMCPY(authTag, tag, authTagSz);
+    ForceZero(tag, sizeof(tag));
+    return 0;
+}
+
+#if defined(HAVE_AES_DECRYPT) || defined(HAVE_AESGCM_DECRYPT)
+/* Decrypt and authenticate a message.
+ *
+ * @return  0 on success.
+ * @return  AES_GCM_AUTH_E when the tag doesn't match.
+ */
+static int AesGcmVaesDecrypt(Aes* aes, byte* out, const byte* in, word32 sz,
+    const byte* iv, word32 ivSz, const byte* authTag, word32 authTagSz,
+    const byte* authIn, word32 authInSz)
+{
+    ALIGN16 byte tag[AES_BLOCK_SIZE];
+    int ret = 0;
+
+    AesGcmVaes(aes, out, in, sz, iv, ivSz, authIn, authInSz, tag, 0);
+    if (ConstantCompare(authTag, tag, (int)authTagSz) != 0) {
+        ret = AES_GCM_AUTH_E;
+    }
+    ForceZero(tag, sizeof(tag));
+    return ret;
+}
+#endif /* HAVE_AES_DECRYPT || HAVE_AESGCM_DECRYPT */
+
+#ifdef WOLFSSL_AESGCM_STREAM
+/* Encrypt or decrypt, and hash, whole blocks of a streamed message.
+ *
+ * GHASH state and counter are in the format of aes_gcm_asm.S.
+ *
+ * @param [in, out] aes     AES key object. GHASH state and counter updated.
+ * @param [out]     out     Output data.
+ * @param [in]      in      Input data.
+ * @param [in]      nbytes  Number of bytes of data - multiple of block size.
+ * @param [in]      enc     1 to encrypt, 0 to decrypt.
+ */
+static AESGCM_VAES_TARGET void AesGcmVaesUpdate(Aes* aes, byte* out,
+    const byte* in, word32 nbytes, int enc)
+{
+    __m512i ctr;
+    __m128i x;
+
+    ctr = AesGcmVaesCtr(_mm_loadu_si128((const __m128i*)AES_COUNTER(aes)));
+    x = AesGcmVaesCrypt((const byte*)aes->key, (int)aes->rounds,
+        (const byte (*)[AES_BLOCK_SIZE])aes->gcm.HPow, &ctr, out, in, nbytes,
+        _mm_loadu_si128((const __m128i*)AES_TAG(aes)), enc);
+    _mm_storeu_si128((__m128i*)AES_TAG(aes), x);
+    _mm_storeu_si128((__m128i*)AES_COUNTER(aes), _mm512_castsi512_si128(ctr));
+}
+#endif /* WOLFSSL_AESGCM_STREAM */
+#endif /* WOLFSSL_AESGCM_VAES && WC_AESGCM_AVX512 */
+
 /* Software AES - GCM SetKey */
 int wc_AesGcmSetKey(Aes* aes, const byte* key, word32 len)
 {
@@ -6414,6 +6901,14 @@ int wc_AesGcmSetKey(Aes* aes, const byte* key, word32 len)
          * assure pure-C fallback is always usable.
          */
         ret = wc_AesEncrypt(aes, iv, aes->gcm.H);
+    #ifdef WC_AESGCM_VAES
+        aes->gcm.HPowSet = 0;
+        if ((ret == 0) && aes->use_aesni &&
+                AESGCM_VAES_CPU(cpuid_get_flags())) {
+            AesGcmVaesSetKey(aes);
+            aes->gcm.HPowSet = 1;
+        }
+    #endif
         VECTOR_REGISTERS_POP;
     }
     if (ret == 0) {
@@ -8355,6 +8850,13 @@ int wc_AesGcmEncrypt(Aes* aes, byte* out, const byte* in, word32 sz,
 
 #ifdef WOLFSSL_AESNI
     if (aes->use_aesni) {
+#ifdef WC_AESGCM_VAES
+        if (AESGCM_VAES_USE(aes, sz)) {
+            ret = AesGcmVaesEncrypt(aes, out, in, sz, iv, ivSz, authTag,
+                                    authTagSz, authIn, authInSz);
+        }
+        else
+#endif
 #ifdef HAVE_INTEL_AVX2
         if (IS_INTEL_AVX2(intel_flags)) {
             AES_GCM_encrypt_avx2(in, out, authIn, iv, authTag, sz, authInSz, ivSz,
@@ -8919,6 +9421,13 @@ int wc_AesGcmDecrypt(Aes* aes, byte* out, const byte* in, word32 sz,
 
 #ifdef WOLFSSL_AESNI
     if (aes->use_aesni) {
+#ifdef WC_AESGCM_VAES
+        if (AESGCM_VAES_USE(aes, sz)) {
+            ret = AesGcmVaesDecrypt(aes, out, in, sz, iv, ivSz, authTag,
+                                    authTagSz, authIn, authInSz);
+        }
+        else
+#endif
 #ifdef HAVE_INTEL_AVX2
         if (IS_INTEL_AVX2(intel_flags)) {
             AES_GCM_decrypt_avx2(in, out, authIn, iv, authTag, sz, authInSz, ivSz,
@@ -8964,6 +9473,515 @@ int wc_AesGcmDecrypt(Aes* aes, byte* out, const byte* in, word32 sz,
 #endif
 #endif /* HAVE_AES_DECRYPT || HAVE_AESGCM_DECRYPT */
 
+#if defined(WOLFSSL_AESGCM_MULTI) && defined(WC_AESGCM_AVX512) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+/* Interleaved AES-GCM of independent jobs with VAES and VPCLMULQDQ.
+ *
+ * Each 128-bit lane of a ZMM register holds a block of a different job, so one
+ * instruction does an AES round or GHASH multiplication of four jobs. Short
+ * messages can't fill the pipeline on their own as the fixed cost of J0, the
+ * length block and GHASH reduction is a chain of dependent operations.
+ * Lanes without a job compute on a dummy block and their results are ignored.
+ */
+#define WC_AESGCM_MULTI_VAES
+
+/* Number of jobs processed together. */
+#define WC_AESGCM_MULTI_LANES       16
+/* Number of ZMM registers holding a block of each job. */
+#define AESGCM_MULTI_VECS           (WC_AESGCM_MULTI_LANES / 4)
+/* Most round keys of a key - AES-256. */
+#define AESGCM_MULTI_ROUND_KEYS     15
+/* Alignment of registers in memory. */
+#define AESGCM_MULTI_ALIGN          64
+/* Fewest jobs worth interleaving - lanes without a job cost as much as lanes
+ * with one. */
+#define AESGCM_MULTI_MIN_JOBS       12
+
+/* Load a block of four lanes, at an offset from each lane's pointer. */
+static WC_INLINE AESGCM_VAES_TARGET __m512i AesGcmMultiLoad4(
+    const byte* const* p, int o)
+{
+    __m512i v = _mm512_castsi128_si512(
+        _mm_loadu_si128((const __m128i*)(p[0] + o)));
+
+    v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(p[1] + o)), 1);
+    v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(p[2] + o)), 2);
+    return _mm512_inserti32x4(v,
+        _mm_loadu_si128((const __m128i*)(p[3] + o)), 3);
+}
+
+/* Store a block of four lanes, at an offset from each lane's pointer. */
+static WC_INLINE AESGCM_VAES_TARGET void AesGcmMultiStore4(byte* const* p,
+    int o, __m512i v)
+{
+    _mm_storeu_si128((__m128i*)(p[0] + o), _mm512_castsi512_si128(v));
+    _mm_storeu_si128((__m128i*)(p[1] + o), _mm512_extracti32x4_epi32(v, 1));
+    _mm_storeu_si128((__m128i*)(p[2] + o), _mm512_extracti32x4_epi32(v, 2));
+    _mm_storeu_si128((__m128i*)(p[3] + o), _mm512_extracti32x4_epi32(v, 3));
+}
+
+/* Apply one AES round operation to the blocks of all lanes. */
+#define AESGCM_MULTI_ROUND(op, r)                                           \
+    do {                                                                    \
+        s0 = op(s0, rk[r][0]);                                              \
+        s1 = op(s1, rk[r][1]);                                              \
+        s2 = op(s2, rk[r][2]);                                              \
+        s3 = op(s3, rk[r][3]);                                              \
+    } while (0)
+
+/* Encrypt a block in each lane.
+ *
+ * @param [in]      rk      Round keys, four lanes per register.
+ * @param [in]      rounds  Number of rounds.
+ * @param [in, out] s       Blocks, four lanes per register.
+ */
+static WC_INLINE AESGCM_VAES_TARGET void AesGcmMultiEnc(
+    const __m512i (*rk)[AESGCM_MULTI_VECS], int rounds, __m512i* s)
+{
+    __m512i s0 = s[0], s1 = s[1], s2 = s[2], s3 = s[3];
+    int r;
+
+    AESGCM_MULTI_ROUND(_mm512_xor_si512, 0);
+    for (r = 1; r < rounds; r++) {
+        AESGCM_MULTI_ROUND(_mm512_aesenc_epi128, r);
+    }
+    AESGCM_MULTI_ROUND(_mm512_aesenclast_epi128, rounds);
+
+    s[0] = s0; s[1] = s1; s[2] = s2; s[3] = s3;
+}
+
+/* Lanes of a group of jobs. Registers hold four lanes. */
+typedef struct AesGcmMultiCtx {
+    __m512i     rk[AESGCM_MULTI_ROUND_KEYS][AESGCM_MULTI_VECS]; /* round keys */
+    __m512i     h[AESGCM_MULTI_VECS][4];    /* H^1..H^4, converted */
+    __m512i     x[AESGCM_MULTI_VECS];       /* GHASH states, byte reversed */
+    __m512i     iv[AESGCM_MULTI_VECS];      /* IVs with a zero counter */
+    __m512i     j0[AESGCM_MULTI_VECS];      /* E(K, J0) */
+    /* partial blocks */
+    ALIGN64 byte in[WC_AESGCM_MULTI_LANES][AES_BLOCK_SIZE];
+    ALIGN64 byte out[WC_AESGCM_MULTI_LANES][AES_BLOCK_SIZE];
+    const byte* src[WC_AESGCM_MULTI_LANES];
+    byte*       dst[WC_AESGCM_MULTI_LANES];
+    byte        dummy[4 * AES_BLOCK_SIZE];  /* data of lanes without a job */
+} AesGcmMultiCtx;
+
+/* Counter block for all lanes - counter in last 32 bits, big-endian. */
+#define AESGCM_MULTI_CTR(c) \
+    _mm512_maskz_set1_epi32(0x8888, (int)ByteReverseWord32(c))
+
+/* Encrypt or decrypt four blocks of four lanes.
+ *
+ * GHASH of the four blocks is reduced once.
+ *
+ * @param [in]      m       Lanes.
+ * @param [in]      v       Index of the register holding the lanes.
+ * @param [in]      ctr     Counter of first block.
+ * @param [in]      rounds  Number of rounds.
+ * @param [in]      enc     1 to encrypt, 0 to decrypt.
+ */
+static WC_INLINE AESGCM_VAES_TARGET void AesGcmMultiBlocks4(
+    AesGcmMultiCtx* m, int v, word32 ctr, int rounds, int enc)
+{
+    const __m512i bswap = _mm512_broadcast_i32x4(_mm_set_epi8(0, 1, 2, 3, 4,
+        5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    const byte* const* src = m->src + 4 * v;
+    byte* const* dst = m->dst + 4 * v;
+    const __m512i* h = m->h[v];
+    __m512i k, s0, s1, s2, s3, d0, d1, d2, d3;
+    __m512i lo = _mm512_setzero_si512();
+    __m512i mid = _mm512_setzero_si512();
+    __m512i hi = _mm512_setzero_si512();
+    int r;
+
+    k = m->rk[0][v];
+    s0 = _mm512_ternarylogic_epi32(m->iv[v], AESGCM_MULTI_CTR(ctr + 0), k,
+                                   0x96);
+    s1 = _mm512_ternarylogic_epi32(m->iv[v], AESGCM_MULTI_CTR(ctr + 1), k,
+                                   0x96);
+    s2 = _mm512_ternarylogic_epi32(m->iv[v], AESGCM_MULTI_CTR(ctr + 2), k,
+                                   0x96);
+    s3 = _mm512_ternarylogic_epi32(m->iv[v], AESGCM_MULTI_CTR(ctr + 3), k,
+                                   0x96);
+    for (r = 1; r < rounds; r++) {
+        k = m->rk[r][v];
+        s0 = _mm512_aesenc_epi128(s0, k);
+        s1 = _mm512_aesenc_epi128(s1, k);
+        s2 = _mm512_aesenc_epi128(s2, k);
+        s3 = _mm512_aesenc_epi128(s3, k);
+    }
+    k = m->rk[rounds][v];
+    s0 = _mm512_aesenclast_epi128(s0, k);
+    s1 = _mm512_aesenclast_epi128(s1, k);
+    s2 = _mm512_aesenclast_epi128(s2, k);
+    s3 = _mm512_aesenclast_epi128(s3, k);
+
+    d0 = AesGcmMultiLoad4(src, 0 * AES_BLOCK_SIZE);
+    d1 = AesGcmMultiLoad4(src, 1 * AES_BLOCK_SIZE);
+    d2 = AesGcmMultiLoad4(src, 2 * AES_BLOCK_SIZE);
+    d3 = AesGcmMultiLoad4(src, 3 * AES_BLOCK_SIZE);
+    s0 = _mm512_xor_si512(s0, d0);
+    s1 = _mm512_xor_si512(s1, d1);
+    s2 = _mm512_xor_si512(s2, d2);
+    s3 = _mm512_xor_si512(s3, d3);
+    AesGcmMultiStore4(dst, 0 * AES_BLOCK_SIZE, s0);
+    AesGcmMultiStore4(dst, 1 * AES_BLOCK_SIZE, s1);
+    AesGcmMultiStore4(dst, 2 * AES_BLOCK_SIZE, s2);
+    AesGcmMultiStore4(dst, 3 * AES_BLOCK_SIZE, s3);
+    if (enc) {
+        d0 = s0; d1 = s1; d2 = s2; d3 = s3;
+    }
+
+    /* X = (X ^ C0).H^4 ^ C1.H^3 ^ C2.H^2 ^ C3.H */
+    d0 = _mm512_xor_si512(_mm512_shuffle_epi8(d0, bswap), m->x[v]);
+    d1 = _mm512_shuffle_epi8(d1, bswap);
+    d2 = _mm512_shuffle_epi8(d2, bswap);
+    d3 = _mm512_shuffle_epi8(d3, bswap);
+    AESGCM_VAES_MUL_ADD(d0, h[3]);
+    AESGCM_VAES_MUL_ADD(d1, h[2]);
+    AESGCM_VAES_MUL_ADD(d2, h[1]);
+    AESGCM_VAES_MUL_ADD(d3, h[0]);
+    m->x[v] = AesGcmVaesReduce(lo, mid, hi);
+}
+
+/* Encrypt or decrypt whole blocks that all jobs have.
+ *
+ * @param [in, out] m       Lanes.
+ * @param [in]      n       Number of jobs.
+ * @param [in]      blocks  Number of blocks.
+ * @param [in]      rounds  Number of rounds.
+ * @param [in]      enc     1 to encrypt, 0 to decrypt.
+ */
+static AESGCM_VAES_TARGET void AesGcmMultiBlocks(AesGcmMultiCtx* m, int n,
+    word32 blocks, int rounds, int enc)
+{
+    const __m512i bswap = _mm512_broadcast_i32x4(_mm_set_epi8(0, 1, 2, 3, 4,
+        5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    __m512i s[AESGCM_MULTI_VECS];
+    word32 b;
+    int v;
+    int l;
+
+    /* First block of data uses a counter of 2. */
+    for (b = 0; b + 4 <= blocks; b += 4) {
+        for (v = 0; v < AESGCM_MULTI_VECS; v++) {
+            AesGcmMultiBlocks4(m, v, b + 2, rounds, enc);
+        }
+        for (l = 0; l < n; l++) {
+            m->src[l] += 4 * AES_BLOCK_SIZE;
+            m->dst[l] += 4 * AES_BLOCK_SIZE;
+        }
+    }
+    for (; b < blocks; b++) {
+        __m512i ctr = AESGCM_MULTI_CTR(b + 2);
+
+        for (v = 0; v < AESGCM_MULTI_VECS; v++) {
+            s[v] = _mm512_or_si512(m->iv[v], ctr);
+        }
+        AesGcmMultiEnc(m->rk, rounds, s);
+
+        for (v = 0; v < AESGCM_MULTI_VECS; v++) {
+            __m512i in = AesGcmMultiLoad4(m->src + 4 * v, 0);
+            __m512i out = _mm512_xor_si512(in, s[v]);
+
+            AesGcmMultiStore4(m->dst + 4 * v, 0, out);
+            m->x[v] = AesGcmVaesGfMul(_mm512_xor_si512(m->x[v],
+                _mm512_shuffle_epi8(enc ? out : in, bswap)), m->h[v][0]);
+        }
+        for (l = 0; l < n; l++) {
+            m->src[l] += AES_BLOCK_SIZE;
+            m->dst[l] += AES_BLOCK_SIZE;
+        }
+    }
+
+    ForceZero(s, sizeof(s));
+}
+
+/* Hash a block of each lane into the GHASH states of the active lanes.
+ *
+ * @param [in, out] m       Lanes.
+ * @param [in]      buf     Block of each lane, zero padded.
+ * @param [in]      active  Two bits for each lane with a block.
+ */
+static AESGCM_VAES_TARGET void AesGcmMultiHash(AesGcmMultiCtx* m,
+    byte (*buf)[AES_BLOCK_SIZE], word32 active)
+{
+    const __m512i bswap = _mm512_broadcast_i32x4(_mm_set_epi8(0, 1, 2, 3, 4,
+        5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    int v;
+
+    for (v = 0; v < AESGCM_MULTI_VECS; v++) {
+        __m512i a = _mm512_shuffle_epi8(_mm512_loadu_si512(buf[4 * v]),
+                                        bswap);
+        __m512i x = AesGcmVaesGfMul(_mm512_xor_si512(m->x[v], a),
+                                     m->h[v][0]);
+
+        m->x[v] = _mm512_mask_blend_epi64((__mmask8)(active >> (8 * v)),
+                                           m->x[v], x);
+    }
+}
+
+/* Encrypt or decrypt and authenticate a group of jobs.
+ *
+ * Jobs have keys with the same number of rounds, 12 byte IVs and valid
+ * arguments.
+ *
+ * @param [in, out] m    Lanes.
+ * @param [in, out] job  Jobs. Result of each job is set.
+ * @param [in]      n    Number of jobs.
+ * @param [in]      enc  1 to encrypt, 0 to decrypt.
+ */
+static AESGCM_VAES_TARGET void AesGcmMulti_VAES(AesGcmMultiCtx* m,
+    wc_AesGcmJob** job, int n, int enc)
+{
+    const __m512i bswap = _mm512_broadcast_i32x4(_mm_set_epi8(0, 1, 2, 3, 4,
+        5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    __m512i s[AESGCM_MULTI_VECS];
+    int rounds = (int)job[0]->aes->rounds;
+    word32 off;
+    word32 minSz = job[0]->sz;
+    word32 maxSz = 0;
+    word32 maxAadSz = 0;
+    word32 active;
+    int v;
+    int l;
+    int r;
+
+    XMEMSET(m->in, 0, sizeof(m->in));
+    for (l = 0; l < WC_AESGCM_MULTI_LANES; l++) {
+        /* Lanes without a job use the key of the first job. */
+        const Aes* aes = job[(l < n) ? l : 0]->aes;
+
+        for (r = 0; r <= rounds; r++) {
+            XMEMCPY((byte*)&m->rk[r][l / 4] + (l % 4) * AES_BLOCK_SIZE,
+                    (const byte*)aes->key + r * AES_BLOCK_SIZE,
+                    AES_BLOCK_SIZE);
+        }
+        if (l < n) {
+            XMEMCPY(m->in[l], job[l]->iv, GCM_NONCE_MID_SZ);
+            m->src[l] = job[l]->in;
+            m->dst[l] = job[l]->out;
+            if (job[l]->sz > maxSz)
+                maxSz = job[l]->sz;
+            if (job[l]->sz < minSz)
+                minSz = job[l]->sz;
+            if (job[l]->authInSz > maxAadSz)
+                maxAadSz = job[l]->authInSz;
+        }
+        else {
+            m->src[l] = m->dummy;
+            m->dst[l] = m->dummy;
+        }
+    }
+    /* H = E(K, 0) - aes->gcm.H is in the format of the assembly code once
+     * streaming has been used. */
+    for (v = 0; v < AESGCM_MULTI_VECS; v++) {
+        s[v] = _mm512_setzero_si512();
+    }
+    AesGcmMultiEnc(m->rk, rounds, s);
+    for (v = 0; v < AESGCM_MULTI_VECS; v++) {
+        __m512i hp = _mm512_shuffle_epi8(s[v], bswap);
+
+        /* Powers of H for reducing four blocks at a time. */
+        m->h[v][0] = AesGcmVaesHashKey(hp);
+        for (r = 1; r < 4; r++) {
+            hp = AesGcmVaesGfMul(hp, m->h[v][0]);
+            m->h[v][r] = AesGcmVaesHashKey(hp);
+        }
+        m->x[v] = _mm512_setzero_si512();
+        m->iv[v] = _mm512_loadu_si512(m->in[4 * v]);
+        /* J0 = IV || 0x00000001 */
+        s[v] = _mm512_or_si512(m->iv[v], AESGCM_MULTI_CTR(1));
+    }
+    AesGcmMultiEnc(m->rk, rounds, s);
+    for (v = 0; v < AESGCM_MULTI_VECS; v++) {
+        m->j0[v] = s[v];
+    }
+
+    /* AAD, last block zero padded. */
+    for (off = 0; off < maxAadSz; off += AES_BLOCK_SIZE) {
+        active = 0;
+        XMEMSET(m->in, 0, sizeof(m->in));
+        for (l = 0; l < n; l++) {
+            if (off < job[l]->authInSz) {
+                XMEMCPY(m->in[l], job[l]->authIn + off,
+                        min(job[l]->authInSz - off, AES_BLOCK_SIZE));
+                active |= (word32)3 << (2 * l);
+            }
+        }
+        AesGcmMultiHash(m, m->in, active);
+    }
+
+    /* Whole blocks that all jobs have. */
+    off = minSz & ~(word32)(AES_BLOCK_SIZE - 1);
+    AesGcmMultiBlocks(m, n, off / AES_BLOCK_SIZE, rounds, enc);
+
+    /* Rest of the data - copied through partial blocks. */
+    for (; off < maxSz; off += AES_BLOCK_SIZE) {
+        __m512i ctr = AESGCM_MULTI_CTR(off / AES_BLOCK_SIZE + 2);
+
+        active = 0;
+        XMEMSET(m->in, 0, sizeof(m->in));
+        for (l = 0; l < n; l++) {
+            if (off < job[l]->sz) {
+                XMEMCPY(m->in[l], job[l]->in + off,
+                        min(job[l]->sz - off, AES_BLOCK_SIZE));
+                active |= (word32)3 << (2 * l);
+            }
+        }
+        for (v = 0; v < AESGCM_MULTI_VECS; v++) {
+            s[v] = _mm512_or_si512(m->iv[v], ctr);
+        }
+        AesGcmMultiEnc(m->rk, rounds, s);
+        for (v = 0; v < AESGCM_MULTI_VECS; v++) {
+            _mm512_storeu_si512(m->out[4 * v], _mm512_xor_si512(s[v],
+                _mm512_loadu_si512(m->in[4 * v])));
+        }
+        for (l = 0; l < n; l++) {
+            if (off < job[l]->sz) {
+                word32 left = min(job[l]->sz - off, AES_BLOCK_SIZE);
+
+                XMEMCPY(job[l]->out + off, m->out[l], left);
+                /* Only bytes of the message are hashed. */
+                XMEMSET(m->out[l] + left, 0, AES_BLOCK_SIZE - left);
+            }
+        }
+        AesGcmMultiHash(m, enc ? m->out : m->in, active);
+    }
+
+    /* Lengths in bits - byte reversed block. */
+    for (l = 0; l < WC_AESGCM_MULTI_LANES; l++) {
+        word64 len[2] = { 0, 0 };
+
+        if (l < n) {
+            len[0] = (word64)job[l]->sz * 8;
+            len[1] = (word64)job[l]->authInSz * 8;
+        }
+        XMEMCPY(m->in[l], len, sizeof(len));
+    }
+    for (v = 0; v < AESGCM_MULTI_VECS; v++) {
+        __m512i x = AesGcmVaesGfMul(_mm512_xor_si512(m->x[v],
+            _mm512_loadu_si512(m->in[4 * v])), m->h[v][0]);
+
+        _mm512_storeu_si512(m->out[4 * v], _mm512_xor_si512(
+            _mm512_shuffle_epi8(x, bswap), m->j0[v]));
+    }
+    for (l = 0; l < n; l++) {
+        if (enc) {
+            XMEMCPY(job[l]->authTag, m->out[l], job[l]->authTagSz);
+            job[l]->ret = 0;
+        }
+        else if (ConstantCompare(job[l]->authTag, m->out[l],
+                                 (int)job[l]->authTagSz) != 0) {
+            job[l]->ret = AES_GCM_AUTH_E;
+        }
+        else {
+            job[l]->ret = 0;
+        }
+    }
+
+    ForceZero(s, sizeof(s));
+}
+
+/* Zeroize registers stored in memory.
+ *
+ * Stores are volatile so that they aren't removed. Whole registers are stored
+ * as ForceZero() is slow for the round keys of all lanes.
+ *
+ * @param [out] z    Registers.
+ * @param [in]  cnt  Number of registers.
+ */
+static AESGCM_VAES_TARGET void AesGcmMultiZero(volatile __m512i* z, int cnt)
+{
+    int i;
+
+    for (i = 0; i < cnt; i++) {
+        z[i] = _mm512_setzero_si512();
+    }
+}
+
+/* Check whether a job can be processed by the interleaved kernel.
+ *
+ * Other jobs are processed alone, which also reports bad arguments.
+ *
+ * @param [in] job  Job.
+ * @param [in] enc  1 when encrypting, 0 when decrypting.
+ * @return  1 when the kernel can process the job.
+ * @return  0 otherwise.
+ */
+static int AesGcmMultiLaneOk(const wc_AesGcmJob* job, int enc)
+{
+    const Aes* aes = job->aes;
+
+    return (aes != NULL) && aes->use_aesni &&
+        #ifdef WOLF_CRYPTO_CB
+           (aes->devId == INVALID_DEVID) &&
+        #endif
+           (job->iv != NULL) && (job->ivSz == GCM_NONCE_MID_SZ) &&
+           ((job->sz == 0) || ((job->in != NULL) && (job->out != NULL))) &&
+           ((job->authInSz == 0) || (job->authIn != NULL)) &&
+           (job->authTag != NULL) && (job->authTagSz <= AES_BLOCK_SIZE) &&
+           (job->authTagSz >= (enc ? WOLFSSL_MIN_AUTH_TAG_SZ : 1));
+}
+
+/* Process a group of jobs with the interleaved kernel.
+ *
+ * A few jobs are faster with the single message code. The CPU may not have
+ * the instructions or the vector registers may not be available.
+ *
+ * @param [in, out] job  Jobs.
+ * @param [in]      n    Number of jobs.
+ * @param [in]      enc  1 to encrypt, 0 to decrypt.
+ * @return  1 when the jobs were processed.
+ * @return  0 when the jobs need to be processed one at a time.
+ */
+static int AesGcmMultiLanes(wc_AesGcmJob** job, int n, int enc)
+{
+#ifdef WOLFSSL_SMALL_STACK
+    byte* buf;
+    AesGcmMultiCtx* m;
+#else
+    AesGcmMultiCtx m[1];
+#endif
+
+    if ((n < AESGCM_MULTI_MIN_JOBS) || !AESGCM_VAES_CPU(intel_flags)) {
+        return 0;
+    }
+#ifdef WOLFSSL_SMALL_STACK
+    /* Registers are stored aligned. */
+    buf = (byte*)XMALLOC(sizeof(AesGcmMultiCtx) + AESGCM_MULTI_ALIGN,
+                         job[0]->aes->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (buf == NULL) {
+        return 0;
+    }
+    m = (AesGcmMultiCtx*)(buf + (AESGCM_MULTI_ALIGN -
+        ((wc_ptr_t)buf & (AESGCM_MULTI_ALIGN - 1))));
+#endif
+
+    if (SAVE_VECTOR_REGISTERS2() != 0) {
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(buf, job[0]->aes->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+        return 0;
+    }
+    AesGcmMulti_VAES(m, job, n, enc);
+    AesGcmMultiZero(m->rk[0], ((int)job[0]->aes->rounds + 1) *
+        AESGCM_MULTI_VECS);
+    AesGcmMultiZero(m->h[0], 4 * AESGCM_MULTI_VECS);
+    AesGcmMultiZero(m->x, AESGCM_MULTI_VECS);
+    AesGcmMultiZero(m->iv, AESGCM_MULTI_VECS);
+    AesGcmMultiZero(m->j0, AESGCM_MULTI_VECS);
+    RESTORE_VECTOR_REGISTERS();
+
+    ForceZero(m->in, sizeof(m->in));
+    ForceZero(m->out, sizeof(m->out));
+    ForceZero(m->dummy, sizeof(m->dummy));
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(buf, job[0]->aes->heap, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+    return 1;
+}
+#endif /* WOLFSSL_AESGCM_MULTI && WC_AESGCM_AVX512 */
+
 #ifdef WOLFSSL_AESGCM_STREAM
 
 /* Initialize the AES GCM cipher with an IV. C implementation.
@@ -9429,6 +10447,12 @@ static WARN_UNUSED_RESULT int AesGcmEncryptUpdate_aesni(
         partial = cSz % AES_BLOCK_SIZE;
         if (blocks > 0) {
             /* Encrypt and GHASH full blocks now. */
+        #ifdef WC_AESGCM_VAES
+            if (AESGCM_VAES_USE(aes, blocks * AES_BLOCK_SIZE)) {
+                AesGcmVaesUpdate(aes, c, p, blocks * AES_BLOCK_SIZE, 1);
+            }
+            else
+        #endif
         #ifdef HAVE_INTEL_AVX2
             if (IS_INTEL_AVX2(intel_flags)) {
                 AES_GCM_encrypt_update_avx2((byte*)aes->key, (int)aes->rounds,
@@ -9662,6 +10686,12 @@ static WARN_UNUSED_RESULT int AesGcmDecryptUpdate_aesni(
         partial = cSz % AES_BLOCK_SIZE;
         if (blocks > 0) {
             /* Decrypt and GHASH full blocks now. */
+        #ifdef WC_AESGCM_VAES
+            if (AESGCM_VAES_USE(aes, blocks * AES_BLOCK_SIZE)) {
+                AesGcmVaesUpdate(aes, p, c, blocks * AES_BLOCK_SIZE, 0);
+            }
+            else
+        #endif
         #ifdef HAVE_INTEL_AVX2
             if (IS_INTEL_AVX2(intel_flags)) {
                 AES_GCM_decrypt_update_avx2((byte*)aes->key, (int)aes->rounds,
@@ -10426,6 +11456,131 @@ WOLFSSL_API int wc_GmacUpdate(Gmac* gmac, const byte* iv, word32 ivSz,
                                          authTag, authTagSz, authIn, authInSz);
 }
 
+#ifdef WOLFSSL_AESGCM_MULTI
+/* Encrypt or decrypt one job on its own.
+ *
+ * @param [in, out] job  Job. Result is set.
+ * @param [in]      enc  1 to encrypt, 0 to decrypt.
+ */
+static void AesGcmMultiOne(wc_AesGcmJob* job, int enc)
+{
+    if (enc) {
+        job->ret = wc_AesGcmEncrypt(job->aes, job->out, job->in, job->sz,
+            job->iv, job->ivSz, job->authTag, job->authTagSz, job->authIn,
+            job->authInSz);
+    }
+    else {
+#if defined(HAVE_AES_DECRYPT) || defined(HAVE_AESGCM_DECRYPT)
+        job->ret = wc_AesGcmDecrypt(job->aes, job->out, job->in, job->sz,
+            job->iv, job->ivSz, job->authTag, job->authTagSz, job->authIn,
+            job->authInSz);
+#else
+        job->ret = NOT_COMPILED_IN;
+#endif
+    }
+}
+
+/* Encrypt or decrypt a vector of independent jobs.
+ *
+ * @param [in, out] jobs   Jobs. Result of each job is set.
+ * @param [in]      count  Number of jobs.
+ * @param [in]      enc    1 to encrypt, 0 to decrypt.
+ * @return  0 when all jobs succeeded.
+ * @return  BAD_FUNC_ARG when jobs is NULL and count is not 0.
+ * @return  Result of first job that failed otherwise.
+ */
+static int AesGcmMulti(wc_AesGcmJob* jobs, word32 count, int enc)
+{
+    int ret = 0;
+    word32 i;
+#ifdef WC_AESGCM_MULTI_VAES
+    wc_AesGcmJob* lane[WC_AESGCM_MULTI_LANES];
+    int n = 0;
+    int j;
+#endif
+
+    if ((jobs == NULL) && (count > 0)) {
+        return BAD_FUNC_ARG;
+    }
+
+    for (i = 0; i < count; i++) {
+    #ifdef WC_AESGCM_MULTI_VAES
+        /* Gather jobs the interleaved kernel can do - all keys of a group
+         * have the same size. */
+        if (AesGcmMultiLaneOk(&jobs[i], enc)) {
+            if ((n > 0) && (lane[0]->aes->rounds != jobs[i].aes->rounds)) {
+                if (!AesGcmMultiLanes(lane, n, enc)) {
+                    for (j = 0; j < n; j++)
+                        AesGcmMultiOne(lane[j], enc);
+                }
+                n = 0;
+            }
+            lane[n++] = &jobs[i];
+            if (n == WC_AESGCM_MULTI_LANES) {
+                if (!AesGcmMultiLanes(lane, n, enc)) {
+                    for (j = 0; j < n; j++)
+                        AesGcmMultiOne(lane[j], enc);
+                }
+                n = 0;
+            }
+            continue;
+        }
+    #endif
+        AesGcmMultiOne(&jobs[i], enc);
+    }
+#ifdef WC_AESGCM_MULTI_VAES
+    if (n > 0) {
+        if (!AesGcmMultiLanes(lane, n, enc)) {
+            for (j = 0; j < n; j++)
+                AesGcmMultiOne(lane[j], enc);
+        }
+    }
+#endif
+
+    for (i = 0; (i < count) && (ret == 0); i++) {
+        ret = jobs[i].ret;
+    }
+
+    return ret;
+}
+
+/* Encrypt and authenticate a vector of independent jobs.
+ *
+ * Each job has its own key, IV, AAD and data. With VAES, runs of jobs with 12
+ * byte IVs and keys of the same size are interleaved so that short messages
+ * keep the AES and GHASH units busy. Other jobs are encrypted one at a time
+ * with wc_AesGcmEncrypt().
+ *
+ * @param [in, out] jobs   Jobs. Result of each job is set.
+ * @param [in]      count  Number of jobs.
+ * @return  0 when all jobs succeeded.
+ * @return  BAD_FUNC_ARG when jobs is NULL and count is not 0.
+ * @return  Result of first job that failed otherwise.
+ */
+int wc_AesGcmEncryptMulti(wc_AesGcmJob* jobs, word32 count)
+{
+    return AesGcmMulti(jobs, count, 1);
+}
+
+#if defined(HAVE_AES_DECRYPT) || defined(HAVE_AESGCM_DECRYPT)
+/* Decrypt and verify a vector of independent jobs.
+ *
+ * authTag of each job is the tag to check. A job whose tag doesn't match has
+ * its result set to AES_GCM_AUTH_E.
+ *
+ * @param [in, out] jobs   Jobs. Result of each job is set.
+ * @param [in]      count  Number of jobs.
+ * @return  0 when all jobs succeeded.
+ * @return  BAD_FUNC_ARG when jobs is NULL and count is not 0.
+ * @return  Result of first job that failed otherwise.
+ */
+int wc_AesGcmDecryptMulti(wc_AesGcmJob* jobs, word32 count)
+{
+    return AesGcmMulti(jobs, count, 0);
+}
+#endif /* HAVE_AES_DECRYPT || HAVE_AESGCM_DECRYPT */
+#endif /* WOLFSSL_AESGCM_MULTI */
+
 #endif /* HAVE_AESGCM */
 
 
@@ -12992,104 +14147,459 @@ int wc_AesXtsDecrypt(XtsAes* xaes, byte* out, const byte* in, word32 sz,
 }
 #endif /* !WOLFSSL_ARMASM || WOLFSSL_ARMASM_NO_HW_CRYPTO */
 
-/* Same as wc_AesXtsEncryptSector but the sector gets incremented by one every
- * sectorSz bytes
+#if defined(WOLFSSL_AESXTS_VAES) && defined(WOLFSSL_AESNI) && \
+    defined(WOLFSSL_X86_64_BUILD) && !defined(WOLFSSL_LINUXKM) && \
+    ((defined(__GNUC__) && __GNUC__ >= 8) || \
+     (defined(__clang__) && __clang_major__ >= 6))
+/* AES-XTS of consecutive sectors with VAES and VPCLMULQDQ.
  *
- * xaes     AES keys to use for block encrypt
- * out      output buffer to hold cipher text
- * in       input plain text buffer to encrypt
- * sz       size of both out and in buffers
- * sector   value to use for tweak
- * sectorSz size of the sector
+ * Each ZMM register holds four consecutive blocks of a different sector, so
+ * sixteen blocks of four sectors are in flight. The tweaks of the four sectors
+ * are encrypted together instead of one sector at a time.
+ */
+#include <immintrin.h>
+
+#define WC_AESXTS_VAES
+
+/* Number of sectors processed together. */
+#define AESXTS_VAES_SECTORS     4
+
+#define AESXTS_VAES_TARGET \
+    __attribute__((target("avx512f,avx512bw,vaes,vpclmulqdq")))
+
+/* CPU supports the instructions used on ZMM registers. */
+#define AESXTS_VAES_CPU(f) \
+    (IS_INTEL_AVX512(f) && IS_INTEL_AVX512BW(f) && IS_INTEL_VAES(f) && \
+     IS_INTEL_VPCLMULQDQ(f))
+
+/* Use the ZMM code for sectors of a size.
  *
- * returns 0 on success
+ * Ciphertext stealing isn't supported so sectors must be whole blocks.
+ * Flags are read each time so that the code can be disabled at runtime with
+ * cpuid_clear_flag().
  */
-int wc_AesXtsEncryptConsecutiveSectors(XtsAes* aes, byte* out, const byte* in,
-        word32 sz, word64 sector, word32 sectorSz)
+#define AESXTS_VAES_USE(aes, sectorSz) \
+    ((aes)->use_aesni && (((sectorSz) % AES_BLOCK_SIZE) == 0) && \
+     AESXTS_VAES_CPU(cpuid_get_flags()))
+
+/* Round key broadcast to all lanes. */
+#define AESXTS_VAES_RK(key, r) \
+    _mm512_broadcast_i32x4(_mm_loadu_si128( \
+        (const __m128i*)((key) + (r) * AES_BLOCK_SIZE)))
+
+/* Multiply the tweak in each lane by alpha^k - k at most 8. */
+#define AESXTS_VAES_MUL_ALPHA(t, k)                                         \
+    do {                                                                    \
+        __m512i c_ = _mm512_srli_epi64(t, 64 - (k));                        \
+        t = _mm512_ternarylogic_epi64(_mm512_slli_epi64(t, k),              \
+            _mm512_bslli_epi128(c_, 8),                                     \
+            _mm512_clmulepi64_epi128(c_, poly, 0x01), 0x96);                \
+    } while (0)
+
+/* Apply one AES round operation to the blocks of all registers. */
+#define AESXTS_VAES_ROUND(op, k)                                            \
+    do {                                                                    \
+        s0 = op(s0, k);                                                     \
+        s1 = op(s1, k);                                                     \
+        s2 = op(s2, k);                                                     \
+        s3 = op(s3, k);                                                     \
+    } while (0)
+
+/* Encrypt or decrypt sectors, four at a time.
+ *
+ * @param [in]  key       Round keys of data key - decryption keys when
+ *                        decrypting.
+ * @param [in]  tkey      Round keys of tweak key.
+ * @param [in]  nr        Number of rounds.
+ * @param [out] out       Output data.
+ * @param [in]  in        Input data.
+ * @param [in]  sectorSz  Size of a sector in bytes - multiple of block size.
+ * @param [in]  sector    Sector number of first sector.
+ * @param [in]  cnt       Number of sectors - multiple of four.
+ * @param [in]  enc       1 to encrypt, 0 to decrypt.
+ */
+static AESXTS_VAES_TARGET void AesXtsVaesSectors(const byte* key,
+    const byte* tkey, int nr, byte* out, const byte* in, word32 sectorSz,
+    word64 sector, word32 cnt, int enc)
+{
+    const __m512i poly = _mm512_set1_epi64(0x87);
+    __m512i t0, t1, t2, t3;
+    __m512i s0, s1, s2, s3;
+    __m512i k;
+    __mmask64 m;
+    word32 i;
+    int r;
+
+    for (; cnt >= AESXTS_VAES_SECTORS; cnt -= AESXTS_VAES_SECTORS) {
+        /* Tweak of sector in each lane: E(K2, sector) */
+        t0 = _mm512_set_epi64(0, (long long)(sector + 3), 0,
+            (long long)(sector + 2), 0, (long long)(sector + 1), 0,
+            (long long)sector);
+        t0 = _mm512_xor_si512(t0, AESXTS_VAES_RK(tkey, 0));
+        for (r = 1; r < nr; r++) {
+            t0 = _mm512_aesenc_epi128(t0, AESXTS_VAES_RK(tkey, r));
+        }
+        t0 = _mm512_aesenclast_epi128(t0, AESXTS_VAES_RK(tkey, nr));
+        t1 = t0;
+        AESXTS_VAES_MUL_ALPHA(t1, 1);
+        t2 = t1;
+        AESXTS_VAES_MUL_ALPHA(t2, 1);
+        t3 = t2;
+        AESXTS_VAES_MUL_ALPHA(t3, 1);
+        /* Transpose so that register j holds blocks 0..3 of sector j. */
+        s0 = _mm512_shuffle_i32x4(t0, t1, 0x44);
+        s1 = _mm512_shuffle_i32x4(t2, t3, 0x44);
+        s2 = _mm512_shuffle_i32x4(t0, t1, 0xee);
+        s3 = _mm512_shuffle_i32x4(t2, t3, 0xee);
+        t0 = _mm512_shuffle_i32x4(s0, s1, 0x88);
+        t1 = _mm512_shuffle_i32x4(s0, s1, 0xdd);
+        t2 = _mm512_shuffle_i32x4(s2, s3, 0x88);
+        t3 = _mm512_shuffle_i32x4(s2, s3, 0xdd);
+
+        for (i = 0; i < sectorSz; i += 4 * AES_BLOCK_SIZE) {
+            m = (sectorSz - i >= 4 * AES_BLOCK_SIZE) ? (__mmask64)-1 :
+                (((__mmask64)1 << (sectorSz - i)) - 1);
+
+            s0 = _mm512_xor_si512(t0,
+                _mm512_maskz_loadu_epi8(m, in + 0 * sectorSz + i));
+            s1 = _mm512_xor_si512(t1,
+                _mm512_maskz_loadu_epi8(m, in + 1 * sectorSz + i));
+            s2 = _mm512_xor_si512(t2,
+                _mm512_maskz_loadu_epi8(m, in + 2 * sectorSz + i));
+            s3 = _mm512_xor_si512(t3,
+                _mm512_maskz_loadu_epi8(m, in + 3 * sectorSz + i));
+            k = AESXTS_VAES_RK(key, 0);
+            AESXTS_VAES_ROUND(_mm512_xor_si512, k);
+            if (enc) {
+                for (r = 1; r < nr; r++) {
+                    k = AESXTS_VAES_RK(key, r);
+                    AESXTS_VAES_ROUND(_mm512_aesenc_epi128, k);
+                }
+                k = AESXTS_VAES_RK(key, nr);
+                AESXTS_VAES_ROUND(_mm512_aesenclast_epi128, k);
+            }
+            else {
+                for (r = 1; r < nr; r++) {
+                    k = AESXTS_VAES_RK(key, r);
+                    AESXTS_VAES_ROUND(_mm512_aesdec_epi128, k);
+                }
+                k = AESXTS_VAES_RK(key, nr);
+                AESXTS_VAES_ROUND(_mm512_aesdeclast_epi128, k);
+            }
+            _mm512_mask_storeu_epi8(out + 0 * sectorSz + i, m,
+                _mm512_xor_si512(s0, t0));
+            _mm512_mask_storeu_epi8(out + 1 * sectorSz + i, m,
+                _mm512_xor_si512(s1, t1));
+            _mm512_mask_storeu_epi8(out + 2 * sectorSz + i, m,
+                _mm512_xor_si512(s2, t2));
+            _mm512_mask_storeu_epi8(out + 3 * sectorSz + i, m,
+                _mm512_xor_si512(s3, t3));
+
+            AESXTS_VAES_MUL_ALPHA(t0, 4);
+            AESXTS_VAES_MUL_ALPHA(t1, 4);
+            AESXTS_VAES_MUL_ALPHA(t2, 4);
+            AESXTS_VAES_MUL_ALPHA(t3, 4);
+        }
+
+        in += AESXTS_VAES_SECTORS * sectorSz;
+        out += AESXTS_VAES_SECTORS * sectorSz;
+        sector += AESXTS_VAES_SECTORS;
+    }
+}
+#endif /* WOLFSSL_AESXTS_VAES && WOLFSSL_AESNI && WOLFSSL_X86_64_BUILD */
+
+/* Encrypt or decrypt consecutive sectors on the calling thread.
+ *
+ * Sectors are done four at a time with VAES when available. The last sector
+ * may be partial.
+ *
+ * @param [in]  xaes      AES keys to use.
+ * @param [out] out       Output data.
+ * @param [in]  in        Input data.
+ * @param [in]  sz        Number of bytes of data.
+ * @param [in]  sector    Sector number of first sector.
+ * @param [in]  sectorSz  Size of a sector in bytes.
+ * @param [in]  enc       1 to encrypt, 0 to decrypt.
+ * @return  0 on success.
+ */
+static int AesXtsSectors(XtsAes* xaes, byte* out, const byte* in, word32 sz,
+    word64 sector, word32 sectorSz, int enc)
 {
-    int ret  = 0;
-    word32 iter = 0;
-    word32 sectorCount;
-    word32 remainder;
+    int ret = 0;
+    word32 sectorCount = sz / sectorSz;
+    word32 remainder = sz % sectorSz;
 
-    if (aes == NULL || out == NULL || in == NULL || sectorSz == 0) {
-        return BAD_FUNC_ARG;
+#ifdef WC_AESXTS_VAES
+    {
+    #ifdef WC_AES_XTS_SUPPORT_SIMULTANEOUS_ENC_AND_DEC_KEYS
+        Aes* aes = enc ? &xaes->aes : &xaes->aes_decrypt;
+    #else
+        Aes* aes = &xaes->aes;
+    #endif
+        word32 cnt = sectorCount - (sectorCount % AESXTS_VAES_SECTORS);
+
+        if ((cnt > 0) && (aes->keylen != 0) &&
+                AESXTS_VAES_USE(aes, sectorSz) &&
+                (SAVE_VECTOR_REGISTERS2() == 0)) {
+            AesXtsVaesSectors((const byte*)aes->key,
+                (const byte*)xaes->tweak.key, (int)aes->rounds, out, in,
+                sectorSz, sector, cnt, enc);
+            RESTORE_VECTOR_REGISTERS();
+            out += cnt * sectorSz;
+            in += cnt * sectorSz;
+            sector += cnt;
+            sectorCount -= cnt;
+        }
     }
+#endif
 
-    if (sz < AES_BLOCK_SIZE) {
-        WOLFSSL_MSG("Cipher text input too small for encryption");
-        return BAD_FUNC_ARG;
+    while ((ret == 0) && (sectorCount > 0)) {
+        if (enc)
+            ret = wc_AesXtsEncryptSector(xaes, out, in, sectorSz, sector);
+        else
+            ret = wc_AesXtsDecryptSector(xaes, out, in, sectorSz, sector);
+        out += sectorSz;
+        in += sectorSz;
+        sector++;
+        sectorCount--;
     }
 
-    sectorCount  = sz / sectorSz;
-    remainder = sz % sectorSz;
+    if ((ret == 0) && (remainder > 0)) {
+        if (enc)
+            ret = wc_AesXtsEncryptSector(xaes, out, in, remainder, sector);
+        else
+            ret = wc_AesXtsDecryptSector(xaes, out, in, remainder, sector);
+    }
 
-    while (sectorCount) {
-        ret = wc_AesXtsEncryptSector(aes, out + (iter * sectorSz),
-                in + (iter * sectorSz), sectorSz, sector);
-        if (ret != 0)
-            break;
+    return ret;
+}
 
-        sectorCount--;
-        iter++;
-        sector++;
+#ifdef WOLFSSL_AESXTS_THREADS
+/* A run of sectors to encrypt or decrypt on a thread. */
+typedef struct AesXtsSectorsJob {
+    XtsAes*     xaes;
+    byte*       out;
+    const byte* in;
+    word32      sz;
+    word64      sector;
+    word32      sectorSz;
+    int         enc;
+    int         ret;
+    THREAD_TYPE tid;
+} AesXtsSectorsJob;
+
+/* Encrypt or decrypt the run of sectors of a job. */
+static THREAD_RETURN WOLFSSL_THREAD AesXtsSectorsRun(void* arg)
+{
+    AesXtsSectorsJob* job = (AesXtsSectorsJob*)arg;
+
+    job->ret = AesXtsSectors(job->xaes, job->out, job->in, job->sz,
+        job->sector, job->sectorSz, job->enc);
+
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+/* Encrypt or decrypt consecutive sectors split across threads.
+ *
+ * Each thread is given a contiguous run of whole sectors of at least
+ * WC_AESXTS_THREAD_MIN_SZ bytes. The calling thread is one of the threads and
+ * does the runs of any threads that fail to start.
+ *
+ * @return  0 on success.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ */
+static int AesXtsSectorsThreads(XtsAes* xaes, byte* out, const byte* in,
+    word32 sz, word64 sector, word32 sectorSz, int threads, int enc)
+{
+    AesXtsSectorsJob* job;
+    word32 sectorCount = sz / sectorSz;
+    word32 per;
+    word32 extra;
+    word32 n;
+    int started;
+    int i;
+    int ret = 0;
+
+    if ((word32)threads > sz / WC_AESXTS_THREAD_MIN_SZ)
+        threads = (int)(sz / WC_AESXTS_THREAD_MIN_SZ);
+    if ((word32)threads > sectorCount)
+        threads = (int)sectorCount;
+    if (threads <= 1)
+        return AesXtsSectors(xaes, out, in, sz, sector, sectorSz, enc);
+
+    job = (AesXtsSectorsJob*)XMALLOC(sizeof(AesXtsSectorsJob) *
+        (size_t)threads, xaes->aes.heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (job == NULL)
+        return MEMORY_E;
+
+    per = sectorCount / (word32)threads;
+    extra = sectorCount % (word32)threads;
+    for (i = 0; i < threads; i++) {
+        n = per + (((word32)i < extra) ? 1 : 0);
+        job[i].xaes = xaes;
+        job[i].out = out;
+        job[i].in = in;
+        job[i].sz = n * sectorSz;
+        job[i].sector = sector;
+        job[i].sectorSz = sectorSz;
+        job[i].enc = enc;
+        job[i].ret = 0;
+        out += n * sectorSz;
+        in += n * sectorSz;
+        sector += n;
+    }
+    /* Last thread does the partial sector. */
+    job[threads - 1].sz += sz % sectorSz;
+
+    for (started = 1; started < threads; started++) {
+        if (wolfSSL_NewThread(&job[started].tid, AesXtsSectorsRun,
+                &job[started]) != 0) {
+            WOLFSSL_MSG("AES-XTS sectors thread start failed");
+            break;
+        }
     }
+    (void)AesXtsSectorsRun(&job[0]);
+    for (i = started; i < threads; i++)
+        (void)AesXtsSectorsRun(&job[i]);
+    for (i = 1; i < started; i++)
+        wolfSSL_JoinThread(job[i].tid);
 
-    if (remainder && ret == 0)
-        ret = wc_AesXtsEncryptSector(aes, out + (iter * sectorSz),
-                in + (iter * sectorSz), remainder, sector);
+    for (i = 0; (ret == 0) && (i < threads); i++)
+        ret = job[i].ret;
 
+    XFREE(job, xaes->aes.heap, DYNAMIC_TYPE_TMP_BUFFER);
     return ret;
 }
+#endif /* WOLFSSL_AESXTS_THREADS */
 
-/* Same as wc_AesXtsEncryptConsecutiveSectors but Aes key is AES_DECRYPTION type
+/* Check the arguments of a call to encrypt or decrypt sectors. */
+static int AesXtsSectorsCheckArgs(XtsAes* aes, byte* out, const byte* in,
+    word32 sz, word32 sectorSz, int threads)
+{
+    if (aes == NULL || out == NULL || in == NULL || sectorSz == 0 ||
+            threads < 0) {
+        return BAD_FUNC_ARG;
+    }
+#ifdef WOLFSSL_AESXTS_THREADS
+    if (threads > WOLFSSL_AESXTS_MAX_THREADS) {
+        return BAD_FUNC_ARG;
+    }
+#endif
+    if (sz < AES_BLOCK_SIZE) {
+        WOLFSSL_MSG("Input too small for AES-XTS");
+        return BAD_FUNC_ARG;
+    }
+
+    return 0;
+}
+
+/* Encrypt a run of consecutive sectors in one call.
  *
- * xaes     AES keys to use for block decrypt
+ * The sector number is incremented every sectorSz bytes. The last sector may
+ * be partial.
+ *
+ * xaes     AES keys to use for block encrypt
  * out      output buffer to hold cipher text
  * in       input plain text buffer to encrypt
  * sz       size of both out and in buffers
- * sector   value to use for tweak
+ * sector   value to use for tweak of first sector
  * sectorSz size of the sector
+ * threads  maximum number of threads to use, 0 or 1 for the calling thread
+ *          only. Ignored unless built with WOLFSSL_AESXTS_THREADS.
  *
  * returns 0 on success
  */
-int wc_AesXtsDecryptConsecutiveSectors(XtsAes* aes, byte* out, const byte* in,
-        word32 sz, word64 sector, word32 sectorSz)
+int wc_AesXtsEncryptSectors(XtsAes* aes, byte* out, const byte* in,
+        word32 sz, word64 sector, word32 sectorSz, int threads)
 {
-    int ret  = 0;
-    word32 iter = 0;
-    word32 sectorCount;
-    word32 remainder;
-
-    if (aes == NULL || out == NULL || in == NULL || sectorSz == 0) {
-        return BAD_FUNC_ARG;
-    }
+    int ret;
 
-    if (sz < AES_BLOCK_SIZE) {
-        WOLFSSL_MSG("Cipher text input too small for decryption");
-        return BAD_FUNC_ARG;
+    ret = AesXtsSectorsCheckArgs(aes, out, in, sz, sectorSz, threads);
+    if (ret == 0) {
+    #ifdef WOLFSSL_AESXTS_THREADS
+        if (threads > 1) {
+            ret = AesXtsSectorsThreads(aes, out, in, sz, sector, sectorSz,
+                threads, 1);
+        }
+        else
+    #endif
+        {
+            ret = AesXtsSectors(aes, out, in, sz, sector, sectorSz, 1);
+        }
     }
 
-    sectorCount  = sz / sectorSz;
-    remainder = sz % sectorSz;
+    return ret;
+}
 
-    while (sectorCount) {
-        ret = wc_AesXtsDecryptSector(aes, out + (iter * sectorSz),
-                in + (iter * sectorSz), sectorSz, sector);
-        if (ret != 0)
-            break;
+/* Same as wc_AesXtsEncryptSectors but Aes key is AES_DECRYPTION type
+ *
+ * xaes     AES keys to use for block decrypt
+ * out      output buffer to hold plain text
+ * in       input cipher text buffer to decrypt
+ * sz       size of both out and in buffers
+ * sector   value to use for tweak of first sector
+ * sectorSz size of the sector
+ * threads  maximum number of threads to use, 0 or 1 for the calling thread
+ *          only. Ignored unless built with WOLFSSL_AESXTS_THREADS.
+ *
+ * returns 0 on success
+ */
+int wc_AesXtsDecryptSectors(XtsAes* aes, byte* out, const byte* in,
+        word32 sz, word64 sector, word32 sectorSz, int threads)
+{
+    int ret;
 
-        sectorCount--;
-        iter++;
-        sector++;
+    ret = AesXtsSectorsCheckArgs(aes, out, in, sz, sectorSz, threads);
+    if (ret == 0) {
+    #ifdef WOLFSSL_AESXTS_THREADS
+        if (threads > 1) {
+            ret = AesXtsSectorsThreads(aes, out, in, sz, sector, sectorSz,
+                threads, 0);
+        }
+        else
+    #endif
+        {
+            ret = AesXtsSectors(aes, out, in, sz, sector, sectorSz, 0);
+        }
     }
 
-    if (remainder && ret == 0)
-        ret = wc_AesXtsDecryptSector(aes, out + (iter * sectorSz),
-                in + (iter * sectorSz), remainder, sector);
-
     return ret;
 }
+
+/* Same as wc_AesXtsEncryptSector but the sector gets incremented by one every
+ * sectorSz bytes
+ *
+ * xaes     AES keys to use for block encrypt
+ * out      output buffer to hold cipher text
+ * in       input plain text buffer to encrypt
+ * sz       size of both out and in buffers
+ * sector   value to use for tweak
+ * sectorSz size of the sector
+ *
+ * returns 0 on success
+ */
+int wc_AesXtsEncryptConsecutiveSectors(XtsAes* aes, byte* out, const byte* in,
+        word32 sz, word64 sector, word32 sectorSz)
+{
+    return wc_AesXtsEncryptSectors(aes, out, in, sz, sector, sectorSz, 1);
+}
+
+/* Same as wc_AesXtsEncryptConsecutiveSectors but Aes key is AES_DECRYPTION type
+ *
+ * xaes     AES keys to use for block decrypt
+ * out      output buffer to hold cipher text
+ * in       input plain text buffer to encrypt
+ * sz       size of both out and in buffers
+ * sector   value to use for tweak
+ * sectorSz size of the sector
+ *
+ * returns 0 on success
+ */
+int wc_AesXtsDecryptConsecutiveSectors(XtsAes* aes, byte* out, const byte* in,
+        word32 sz, word64 sector, word32 sectorSz)
+{
+    return wc_AesXtsDecryptSectors(aes, out, in, sz, sector, sectorSz, 1);
+}
 #endif /* WOLFSSL_AES_XTS */
 
 #ifdef WOLFSSL_AES_SIV
@@ -22467,7 +22467,8 @@ static Signer* GetCABySubjectAndPubKey(DecodedCert* cert, void* cm)
 }
 #endif
 
-#if defined(WOLFSSL_SMALL_CERT_VERIFY) || defined(OPENSSL_EXTRA)
+#if defined(WOLFSSL_SMALL_CERT_VERIFY) || defined(OPENSSL_EXTRA) || \
+    defined(WOLFSSL_CHAIN_VERIFY_POOL)
 #ifdef WOLFSSL_ASN_TEMPLATE
 /* Get the Hash of the Authority Key Identifier from the list of extensions.
  *
@@ -23119,7 +23120,7 @@ static int CheckCertSignature_ex(const byte* cert, word32 certSz, void* heap,
 #endif /* WOLFSSL_ASN_TEMPLATE */
 }
 
-#ifdef OPENSSL_EXTRA
+#if defined(OPENSSL_EXTRA) || defined(WOLFSSL_CHAIN_VERIFY_POOL)
 /* Call CheckCertSignature_ex using a public key buffer for verification
  */
 int CheckCertSignaturePubKey(const byte* cert, word32 certSz, void* heap,
@@ -23128,7 +23129,9 @@ int CheckCertSignaturePubKey(const byte* cert, word32 certSz, void* heap,
     return CheckCertSignature_ex(cert, certSz, heap, NULL,
             pubKey, pubKeySz, pubKeyOID, 0);
 }
+#endif
 
+#ifdef OPENSSL_EXTRA
 int wc_CheckCertSigPubKey(const byte* cert, word32 certSz, void* heap,
         const byte* pubKey, word32 pubKeySz, int pubKeyOID)
 {
@@ -23153,7 +23156,8 @@ int CheckCertSignature(const byte* cert, word32 certSz, void* heap, void* cm)
     return CheckCertSignature_ex(cert, certSz, heap, cm, NULL, 0, 0, 0);
 }
 #endif /* WOLFSSL_SMALL_CERT_VERIFY */
-#endif /* WOLFSSL_SMALL_CERT_VERIFY || OPENSSL_EXTRA */
+#endif /* WOLFSSL_SMALL_CERT_VERIFY || OPENSSL_EXTRA ||
+        * WOLFSSL_CHAIN_VERIFY_POOL */
 
 #if (defined(HAVE_ED25519) && defined(HAVE_ED25519_KEY_IMPORT) || \
     (defined(HAVE_ED448) && defined(HAVE_ED448_KEY_IMPORT)))
@@ -23731,6 +23735,17 @@ int ParseCertRelative(DecodedCert* cert, int type, int verify, void* cm)
 
     if (verify != NO_VERIFY && type != CA_TYPE && type != TRUSTED_PEER_TYPE) {
         if (cert->ca) {
+        #ifdef WOLFSSL_CHAIN_VERIFY_POOL
+            /* signature already confirmed with this signer's key */
+            if (cert->sigVerifiedKey != NULL &&
+                    cert->sigVerifiedKeyOID == cert->ca->keyOID &&
+                    cert->sigVerifiedKeySz == cert->ca->pubKeySize &&
+                    XMEMCMP(cert->sigVerifiedKey, cert->ca->publicKey,
+                            cert->sigVerifiedKeySz) == 0) {
+                WOLFSSL_MSG("Signature confirmed by chain verify pool");
+            }
+            else
+        #endif
             if (verify == VERIFY || verify == VERIFY_OCSP ||
                                                  verify == VERIFY_SKIP_DATE) {
                 /* try to confirm/verify signature */
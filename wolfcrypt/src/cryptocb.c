@@ -1746,4 +1746,452 @@ int wc_CryptoCb_DefaultDevID(void)
     return ret;
 }
 
+#ifdef WOLF_CRYPTO_CB_POOL
+/* Public key operation queued to the pool */
+typedef struct CryptoCbPoolJob {
+    struct CryptoCbPoolJob* next;   /* pool queue link */
+#ifdef WOLFSSL_ASYNC_CRYPT
+    struct CryptoCbPoolJob* deferNext; /* deferred list link */
+#endif
+    wc_CryptoInfo           info;   /* copy of the request */
+    COND_TYPE*              cond;   /* signalled when done, NULL if deferred */
+#ifdef WOLFSSL_ASYNC_CRYPT
+    const void*             key;    /* key a deferred operation is for */
+#endif
+    int                     ret;
+    byte                    done;
+} CryptoCbPoolJob;
+
+struct wc_CryptoCbPool {
+    COND_TYPE        cond;          /* signalled as jobs are queued */
+    CryptoCbPoolJob* head;
+    CryptoCbPoolJob* tail;
+#ifdef WOLFSSL_ASYNC_CRYPT
+    CryptoCbPoolJob* deferred;      /* WC_PENDING_E was returned for these */
+#endif
+    THREAD_TYPE*     threads;
+    int              workers;
+    int              devId;
+    int              flags;
+    int              stop;
+    void*            heap;
+};
+
+/* Set on the pool threads. Operations they run go to the software code when
+ * the callback finds it set. */
+static THREAD_LS_T int cryptoCbPoolThread = 0;
+
+/* Run one operation in software, CRYPTOCB_UNAVAILABLE if not handled */
+static int CryptoCbPoolRun(wc_CryptoInfo* info)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+
+    switch (info->pk.type) {
+    #ifndef NO_RSA
+        case WC_PK_TYPE_RSA:
+            ret = wc_RsaFunction(info->pk.rsa.in, info->pk.rsa.inLen,
+                info->pk.rsa.out, info->pk.rsa.outLen, info->pk.rsa.type,
+                info->pk.rsa.key, info->pk.rsa.rng);
+            break;
+    #endif
+    #ifdef HAVE_ECC
+        case WC_PK_TYPE_EC_KEYGEN:
+            ret = wc_ecc_make_key_ex(info->pk.eckg.rng, info->pk.eckg.size,
+                info->pk.eckg.key, info->pk.eckg.curveId);
+            break;
+    #ifdef HAVE_ECC_DHE
+        case WC_PK_TYPE_ECDH:
+            ret = wc_ecc_shared_secret(info->pk.ecdh.private_key,
+                info->pk.ecdh.public_key, info->pk.ecdh.out,
+                info->pk.ecdh.outlen);
+            break;
+    #endif
+    #ifdef HAVE_ECC_SIGN
+        case WC_PK_TYPE_ECDSA_SIGN:
+            ret = wc_ecc_sign_hash(info->pk.eccsign.in, info->pk.eccsign.inlen,
+                info->pk.eccsign.out, info->pk.eccsign.outlen,
+                info->pk.eccsign.rng, info->pk.eccsign.key);
+            break;
+    #endif
+    #ifdef HAVE_ECC_VERIFY
+        case WC_PK_TYPE_ECDSA_VERIFY:
+            ret = wc_ecc_verify_hash(info->pk.eccverify.sig,
+                info->pk.eccverify.siglen, info->pk.eccverify.hash,
+                info->pk.eccverify.hashlen, info->pk.eccverify.res,
+                info->pk.eccverify.key);
+            break;
+    #endif
+    #endif /* HAVE_ECC */
+    #ifdef HAVE_CURVE25519
+        case WC_PK_TYPE_CURVE25519_KEYGEN:
+            ret = wc_curve25519_make_key(info->pk.curve25519kg.rng,
+                info->pk.curve25519kg.size, info->pk.curve25519kg.key);
+            break;
+        case WC_PK_TYPE_CURVE25519:
+            ret = wc_curve25519_shared_secret_ex(
+                info->pk.curve25519.private_key,
+                info->pk.curve25519.public_key, info->pk.curve25519.out,
+                info->pk.curve25519.outlen, info->pk.curve25519.endian);
+            break;
+    #endif
+    #ifdef HAVE_ED25519
+    #ifdef HAVE_ED25519_SIGN
+        case WC_PK_TYPE_ED25519_SIGN:
+            ret = wc_ed25519_sign_msg_ex(info->pk.ed25519sign.in,
+                info->pk.ed25519sign.inLen, info->pk.ed25519sign.out,
+                info->pk.ed25519sign.outLen, info->pk.ed25519sign.key,
+                info->pk.ed25519sign.type, info->pk.ed25519sign.context,
+                info->pk.ed25519sign.contextLen);
+            break;
+    #endif
+    #ifdef HAVE_ED25519_VERIFY
+        case WC_PK_TYPE_ED25519_VERIFY:
+            ret = wc_ed25519_verify_msg_ex(info->pk.ed25519verify.sig,
+                info->pk.ed25519verify.sigLen, info->pk.ed25519verify.msg,
+                info->pk.ed25519verify.msgLen, info->pk.ed25519verify.res,
+                info->pk.ed25519verify.key, info->pk.ed25519verify.type,
+                info->pk.ed25519verify.context,
+                info->pk.ed25519verify.contextLen);
+            break;
+    #endif
+    #endif /* HAVE_ED25519 */
+        default:
+            break;
+    }
+
+    return ret;
+}
+
+#ifdef WOLFSSL_ASYNC_CRYPT
+/* Key an operation that may be deferred is for, NULL if it must complete
+ * before the callback returns. RSA is never deferred: on WC_PENDING_E
+ * rsa.c finishes the operation from its own state without calling the
+ * device again. */
+static const void* CryptoCbPoolKey(const wc_CryptoInfo* info)
+{
+    switch (info->pk.type) {
+    #ifdef HAVE_ECC
+        case WC_PK_TYPE_EC_KEYGEN:
+            return info->pk.eckg.key;
+        case WC_PK_TYPE_ECDH:
+            return info->pk.ecdh.private_key;
+        case WC_PK_TYPE_ECDSA_SIGN:
+            return info->pk.eccsign.key;
+        case WC_PK_TYPE_ECDSA_VERIFY:
+            return info->pk.eccverify.key;
+    #endif
+    #ifdef HAVE_CURVE25519
+        case WC_PK_TYPE_CURVE25519_KEYGEN:
+            return info->pk.curve25519kg.key;
+        case WC_PK_TYPE_CURVE25519:
+            return info->pk.curve25519.private_key;
+    #endif
+    #ifdef HAVE_ED25519
+        case WC_PK_TYPE_ED25519_SIGN:
+            return info->pk.ed25519sign.key;
+        case WC_PK_TYPE_ED25519_VERIFY:
+            return info->pk.ed25519verify.key;
+    #endif
+        default:
+            return NULL;
+    }
+}
+#endif /* WOLFSSL_ASYNC_CRYPT */
+
+/* Worker thread: run queued jobs until the pool stops and the queue is
+ * empty */
+static THREAD_RETURN WOLFSSL_THREAD CryptoCbPoolWorker(void* arg)
+{
+    wc_CryptoCbPool* pool = (wc_CryptoCbPool*)arg;
+    CryptoCbPoolJob* job;
+    COND_TYPE* cond;
+
+    cryptoCbPoolThread = 1;
+
+    for (;;) {
+        if (wolfSSL_CondStart(&pool->cond) != 0)
+            break;
+        while (pool->head == NULL && !pool->stop) {
+            if (wolfSSL_CondWait(&pool->cond) != 0)
+                break;
+        }
+        job = pool->head;
+        if (job != NULL) {
+            pool->head = job->next;
+            if (pool->head == NULL)
+                pool->tail = NULL;
+        }
+        /* a signal wakes one worker, pass it on to the next */
+        if (pool->head != NULL || pool->stop)
+            wolfSSL_CondSignal(&pool->cond);
+        wolfSSL_CondEnd(&pool->cond);
+
+        if (job == NULL)
+            break;
+
+        job->ret = CryptoCbPoolRun(&job->info);
+
+        /* the waiting caller owns the job, deferred jobs are collected by the
+         * callback under the pool lock */
+        cond = (job->cond != NULL) ? job->cond : &pool->cond;
+        if (wolfSSL_CondStart(cond) == 0) {
+            job->done = 1;
+            if (cond != &pool->cond)
+                wolfSSL_CondSignal(cond);
+            wolfSSL_CondEnd(cond);
+        }
+    }
+
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+/* Add job to the end of the queue and wake a worker. Pool lock held. */
+static void CryptoCbPoolQueue(wc_CryptoCbPool* pool, CryptoCbPoolJob* job)
+{
+    job->next = NULL;
+    if (pool->tail == NULL)
+        pool->head = job;
+    else
+        pool->tail->next = job;
+    pool->tail = job;
+    wolfSSL_CondSignal(&pool->cond);
+}
+
+#ifdef WOLFSSL_ASYNC_CRYPT
+/* Queue the operation for key, or collect its result when the caller calls
+ * again. WC_PENDING_E until a worker has run it. */
+static int CryptoCbPoolDefer(wc_CryptoCbPool* pool, wc_CryptoInfo* info,
+                             const void* key)
+{
+    CryptoCbPoolJob* job;
+    CryptoCbPoolJob** prev;
+    int ret = WC_PENDING_E;
+
+    if (wolfSSL_CondStart(&pool->cond) != 0)
+        return BAD_MUTEX_E;
+
+    for (prev = &pool->deferred; *prev != NULL; prev = &(*prev)->deferNext) {
+        if ((*prev)->key == key && (*prev)->info.pk.type == info->pk.type)
+            break;
+    }
+    job = *prev;
+    if (job != NULL) {
+        if (job->done) {
+            *prev = job->deferNext;
+            ret = job->ret;
+            XFREE(job, pool->heap, DYNAMIC_TYPE_CRYPTOCB_POOL);
+        }
+    }
+    else {
+        job = (CryptoCbPoolJob*)XMALLOC(sizeof(CryptoCbPoolJob), pool->heap,
+                                        DYNAMIC_TYPE_CRYPTOCB_POOL);
+        if (job == NULL) {
+            ret = MEMORY_E;
+        }
+        else {
+            XMEMSET(job, 0, sizeof(CryptoCbPoolJob));
+            XMEMCPY(&job->info, info, sizeof(wc_CryptoInfo));
+            job->key = key;
+            job->deferNext = pool->deferred;
+            pool->deferred = job;
+            CryptoCbPoolQueue(pool, job);
+        }
+    }
+
+    wolfSSL_CondEnd(&pool->cond);
+    return ret;
+}
+#endif /* WOLFSSL_ASYNC_CRYPT */
+
+/* Operations the workers run, others are left to the software code */
+static int CryptoCbPoolHandles(const wc_CryptoInfo* info)
+{
+    if (info->algo_type != WC_ALGO_TYPE_PK)
+        return 0;
+
+    switch (info->pk.type) {
+    #ifndef NO_RSA
+        case WC_PK_TYPE_RSA:
+    #endif
+    #ifdef HAVE_ECC
+        case WC_PK_TYPE_EC_KEYGEN:
+    #ifdef HAVE_ECC_DHE
+        case WC_PK_TYPE_ECDH:
+    #endif
+    #ifdef HAVE_ECC_SIGN
+        case WC_PK_TYPE_ECDSA_SIGN:
+    #endif
+    #ifdef HAVE_ECC_VERIFY
+        case WC_PK_TYPE_ECDSA_VERIFY:
+    #endif
+    #endif /* HAVE_ECC */
+    #ifdef HAVE_CURVE25519
+        case WC_PK_TYPE_CURVE25519_KEYGEN:
+        case WC_PK_TYPE_CURVE25519:
+    #endif
+    #if defined(HAVE_ED25519) && defined(HAVE_ED25519_SIGN)
+        case WC_PK_TYPE_ED25519_SIGN:
+    #endif
+    #if defined(HAVE_ED25519) && defined(HAVE_ED25519_VERIFY)
+        case WC_PK_TYPE_ED25519_VERIFY:
+    #endif
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Device callback: run the operation on a worker and wait for it, or with
+ * WC_CRYPTOCB_POOL_FLAG_ASYNC return WC_PENDING_E until it is done */
+static int CryptoCbPoolCb(int devId, wc_CryptoInfo* info, void* ctx)
+{
+    wc_CryptoCbPool* pool = (wc_CryptoCbPool*)ctx;
+    CryptoCbPoolJob job;
+    COND_TYPE cond;
+    int done = 0;
+
+    (void)devId;
+
+    if (cryptoCbPoolThread || pool == NULL || info == NULL ||
+            !CryptoCbPoolHandles(info)) {
+        return CRYPTOCB_UNAVAILABLE;
+    }
+
+#ifdef WOLFSSL_ASYNC_CRYPT
+    if (pool->flags & WC_CRYPTOCB_POOL_FLAG_ASYNC) {
+        const void* key = CryptoCbPoolKey(info);
+        if (key != NULL)
+            return CryptoCbPoolDefer(pool, info, key);
+    }
+#endif
+
+    XMEMSET(&job, 0, sizeof(job));
+    XMEMCPY(&job.info, info, sizeof(wc_CryptoInfo));
+    if (wolfSSL_CondInit(&cond) != 0)
+        return BAD_MUTEX_E;
+    job.cond = &cond;
+
+    if (wolfSSL_CondStart(&pool->cond) != 0) {
+        wolfSSL_CondFree(&cond);
+        return BAD_MUTEX_E;
+    }
+    CryptoCbPoolQueue(pool, &job);
+    wolfSSL_CondEnd(&pool->cond);
+
+    /* the job is on this stack, wait until the worker is done with it */
+    if (wolfSSL_CondStart(&cond) == 0) {
+        while (!(done = job.done)) {
+            if (wolfSSL_CondWait(&cond) != 0)
+                break;
+        }
+        wolfSSL_CondEnd(&cond);
+    }
+    wolfSSL_CondFree(&cond);
+
+    return done ? job.ret : BAD_MUTEX_E;
+}
+
+/* Stop and join the workers, queued jobs are run first */
+static void CryptoCbPoolStop(wc_CryptoCbPool* pool, int started)
+{
+    void* heap = pool->heap;
+    int i;
+#ifdef WOLFSSL_ASYNC_CRYPT
+    CryptoCbPoolJob* job;
+#endif
+
+    if (wolfSSL_CondStart(&pool->cond) == 0) {
+        pool->stop = 1;
+        wolfSSL_CondSignal(&pool->cond);
+        wolfSSL_CondEnd(&pool->cond);
+    }
+    for (i = 0; i < started; i++)
+        wolfSSL_JoinThread(pool->threads[i]);
+#ifdef WOLFSSL_ASYNC_CRYPT
+    /* results never collected by a caller */
+    while ((job = pool->deferred) != NULL) {
+        pool->deferred = job->deferNext;
+        XFREE(job, heap, DYNAMIC_TYPE_CRYPTOCB_POOL);
+    }
+#endif
+    wolfSSL_CondFree(&pool->cond);
+    XFREE(pool->threads, heap, DYNAMIC_TYPE_CRYPTOCB_POOL);
+    XFREE(pool, heap, DYNAMIC_TYPE_CRYPTOCB_POOL);
+    (void)heap;
+}
+
+/* Start threads workers and register them as the device devId. Keys and
+ * WOLFSSL_CTX objects set to devId then have their RSA, ECC, Curve25519 and
+ * Ed25519 operations run on the workers. */
+int wc_CryptoCbPool_New(wc_CryptoCbPool** pool, int devId, int threads,
+                        int flags, void* heap)
+{
+    wc_CryptoCbPool* p;
+    int i;
+    int ret = 0;
+
+    if (pool == NULL || devId == INVALID_DEVID || threads < 1 ||
+            threads > WC_CRYPTOCB_POOL_MAX_THREADS) {
+        return BAD_FUNC_ARG;
+    }
+#ifdef WOLFSSL_ASYNC_CRYPT
+    if ((flags & ~WC_CRYPTOCB_POOL_FLAG_ASYNC) != 0)
+        return BAD_FUNC_ARG;
+#else
+    if (flags != 0)
+        return BAD_FUNC_ARG;
+#endif
+    *pool = NULL;
+
+    p = (wc_CryptoCbPool*)XMALLOC(sizeof(wc_CryptoCbPool), heap,
+                                  DYNAMIC_TYPE_CRYPTOCB_POOL);
+    if (p == NULL)
+        return MEMORY_E;
+    XMEMSET(p, 0, sizeof(wc_CryptoCbPool));
+    p->heap = heap;
+    p->devId = devId;
+    p->flags = flags;
+    p->threads = (THREAD_TYPE*)XMALLOC(sizeof(THREAD_TYPE) * threads, heap,
+                                       DYNAMIC_TYPE_CRYPTOCB_POOL);
+    if (p->threads == NULL) {
+        XFREE(p, heap, DYNAMIC_TYPE_CRYPTOCB_POOL);
+        return MEMORY_E;
+    }
+    if (wolfSSL_CondInit(&p->cond) != 0) {
+        XFREE(p->threads, heap, DYNAMIC_TYPE_CRYPTOCB_POOL);
+        XFREE(p, heap, DYNAMIC_TYPE_CRYPTOCB_POOL);
+        return BAD_MUTEX_E;
+    }
+
+    for (i = 0; i < threads; i++) {
+        ret = wolfSSL_NewThread(&p->threads[i], CryptoCbPoolWorker, p);
+        if (ret != 0) {
+            WOLFSSL_MSG("CryptoCb pool worker start failed");
+            break;
+        }
+    }
+    if (ret == 0)
+        ret = wc_CryptoCb_RegisterDevice(devId, CryptoCbPoolCb, p);
+    if (ret != 0) {
+        CryptoCbPoolStop(p, i);
+        return ret;
+    }
+
+    p->workers = threads;
+    *pool = p;
+    return 0;
+}
+
+/* Unregister the device and stop the workers. No operation may be using the
+ * device meanwhile. */
+void wc_CryptoCbPool_Free(wc_CryptoCbPool* pool)
+{
+    if (pool == NULL)
+        return;
+
+    wc_CryptoCb_UnRegisterDevice(pool->devId);
+    CryptoCbPoolStop(pool, pool->workers);
+}
+#endif /* WOLF_CRYPTO_CB_POOL */
+
 #endif /* WOLF_CRYPTO_CB */
@@ -948,6 +948,9 @@ int wc_InitDhKey_ex(DhKey* key, void* heap, int devId)
 
     key->heap = heap; /* for XMALLOC/XFREE in future */
     key->trustedGroup = 0;
+#ifdef WOLFSSL_KEYGEN_THREADS
+    key->paramGenThreads = 0;
+#endif
 
 #ifdef WOLFSSL_DH_EXTRA
     if (mp_init_multi(&key->p, &key->g, &key->q, &key->pub, &key->priv, NULL) != MP_OKAY)
@@ -2879,6 +2882,119 @@ int wc_DhCopyNamedKey(int name,
 
 #ifdef WOLFSSL_KEY_GEN
 
+#ifdef WOLFSSL_KEYGEN_THREADS
+/* Set the number of threads wc_DhGenerateParams() searches for p with.
+ *
+ * @param [in, out] key      DH key.
+ * @param [in]      threads  Number of threads. 0 or 1 for calling thread only.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key is NULL or threads is out of range.
+ */
+int wc_DhSetParamGenThreads(DhKey* key, int threads)
+{
+    if ((key == NULL) || (threads < 0) ||
+            (threads > WOLFSSL_KEYGEN_MAX_THREADS)) {
+        return BAD_FUNC_ARG;
+    }
+
+    key->paramGenThreads = threads;
+
+    return 0;
+}
+
+/* Parameters of a threaded search for p = start + 2q * k. */
+typedef struct DhPrimeSearch {
+    mp_int* start;    /* First candidate */
+    mp_int* twoQ;     /* Step between candidates */
+    mp_int* step;     /* Step between candidates of one thread */
+} DhPrimeSearch;
+
+/* Check the next candidate of a thread.
+ *
+ * Thread w checks k = w, w + threads, w + 2 * threads, ... The candidate is
+ * kept between calls and stepped on.
+ */
+static int DhPrimeCandidate(void* ctx, int worker, word32 iter, WC_RNG* rng,
+    mp_int* cand, int* isPrime)
+{
+    DhPrimeSearch* search = (DhPrimeSearch*)ctx;
+    int ret = MP_OKAY;
+    int i;
+
+    if (iter == 0) {
+        ret = mp_copy(search->start, cand);
+        for (i = 0; (ret == MP_OKAY) && (i < worker); i++)
+            ret = mp_add(cand, search->twoQ, cand);
+    }
+    else {
+        ret = mp_add(cand, search->step, cand);
+    }
+    if (ret == MP_OKAY)
+        ret = mp_prime_is_prime_ex(cand, 8, isPrime, rng);
+    if (ret != MP_OKAY)
+        ret = PRIME_GEN_E;
+
+    return ret;
+}
+
+/* Find the first prime of the form p + 2q * k, for k >= 0, using multiple
+ * threads. On success p holds the prime and cnt is set to k.
+ */
+static int DhSearchPrimeThreads(DhKey* dh, mp_int* twoQ, WC_RNG* rng,
+    word32* cnt)
+{
+    int ret = 0;
+    int i;
+    int worker = 0;
+    word32 iter = 0;
+    DhPrimeSearch search;
+#if defined(WOLFSSL_SMALL_STACK) && !defined(WOLFSSL_NO_MALLOC)
+    mp_int* start;
+    mp_int* step;
+#else
+    mp_int start[1], step[1];
+#endif
+
+#if defined(WOLFSSL_SMALL_STACK) && !defined(WOLFSSL_NO_MALLOC)
+    start = (mp_int*)XMALLOC(sizeof(mp_int) * 2, dh->heap,
+        DYNAMIC_TYPE_WOLF_BIGINT);
+    if (start == NULL)
+        return MEMORY_E;
+    step = start + 1;
+#endif
+
+    if (mp_init_multi(start, step, NULL, NULL, NULL, NULL) != MP_OKAY)
+        ret = MP_INIT_E;
+    /* Threads read the start while the found prime is written to p. */
+    if ((ret == 0) && (mp_copy(&dh->p, start) != MP_OKAY))
+        ret = MP_INIT_E;
+    if ((ret == 0) && (mp_copy(twoQ, step) != MP_OKAY))
+        ret = MP_INIT_E;
+    for (i = 1; (ret == 0) && (i < dh->paramGenThreads); i++) {
+        if (mp_add(step, twoQ, step) != MP_OKAY)
+            ret = MP_ADD_E;
+    }
+
+    if (ret == 0) {
+        search.start = start;
+        search.twoQ = twoQ;
+        search.step = step;
+        ret = wc_PrimeSearchThreads(DhPrimeCandidate, &search,
+            dh->paramGenThreads, 0, rng, &dh->p, &worker, &iter, dh->heap);
+    }
+    if (ret == 0)
+        *cnt = (word32)worker + iter * (word32)dh->paramGenThreads;
+
+    mp_clear(step);
+    mp_clear(start);
+#if defined(WOLFSSL_SMALL_STACK) && !defined(WOLFSSL_NO_MALLOC)
+    XFREE(start, dh->heap, DYNAMIC_TYPE_WOLF_BIGINT);
+#endif
+
+    return ret;
+}
+#endif /* WOLFSSL_KEYGEN_THREADS */
+
 /* modulus_size in bits */
 int wc_DhGenerateParams(WC_RNG *rng, int modSz, DhKey *dh)
 {
@@ -3009,6 +3125,12 @@ int wc_DhGenerateParams(WC_RNG *rng, int modSz, DhKey *dh)
     }
 
     /* loop until p is prime */
+#ifdef WOLFSSL_KEYGEN_THREADS
+    if ((ret == 0) && (dh->paramGenThreads > 1)) {
+        ret = DhSearchPrimeThreads(dh, tmp, rng, &primeCheckCount);
+    }
+    else
+#endif
     if (ret == 0) {
         for (;;) {
             if (mp_prime_is_prime_ex(&dh->p, 8, &primeCheck, rng) != MP_OKAY)
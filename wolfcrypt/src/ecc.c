@@ -57,6 +57,10 @@ Possible ECC enable options:
  *                      SECP160K1 and SECP224K1. These do not work with scalars
  *                      that are the length of the order when the order is
  *                      longer than the prime. Use wc_ecc_fp_free to free cache.
+ * FP_ECC_SHARED:       One FP cache shared by all threads      default: off
+ *                      Entries are keyed by curve and point, LUTs are built
+ *                      under a write lock and used under a read lock.
+ *                      Best with WOLFSSL_USE_RWLOCK and atomics.
  * USE_ECC_B_PARAM:     Enable ECC curve B param                default: off
  *                      (on for HAVE_COMP_KEY)
  * WOLFSSL_ECC_CURVE_STATIC:                                    default off (on for windows)
@@ -8640,8 +8644,10 @@ static int ecc_verify_hash_sp(mp_int *r, mp_int *s, const byte* hash,
 }
 
 #if !defined(WOLFSSL_SP_MATH) || defined(FREESCALE_LTC_ECC)
+/* sInv is s^-1 mod n when already calculated, otherwise NULL */
 static int ecc_verify_hash(mp_int *r, mp_int *s, const byte* hash,
-    word32 hashlen, int* res, ecc_key* key, ecc_curve_spec* curve)
+    word32 hashlen, int* res, ecc_key* key, ecc_curve_spec* curve,
+    mp_int* sInv)
 {
    int        err;
    ecc_point* mG = NULL;
@@ -8769,8 +8775,12 @@ static int ecc_verify_hash(mp_int *r, mp_int *s, const byte* hash,
    }
 
    /*  w  = s^-1 mod n */
-   if (err == MP_OKAY)
-       err = mp_invmod(s, curve->order, w);
+   if (err == MP_OKAY) {
+       if (sInv != NULL)
+           err = mp_copy(sInv, w);
+       else
+           err = mp_invmod(s, curve->order, w);
+   }
 
    /* u1 = ew */
    if (err == MP_OKAY)
@@ -9090,7 +9100,7 @@ int wc_ecc_verify_hash_ex(mp_int *r, mp_int *s, const byte* hash,
        }
    }
 
-   err = ecc_verify_hash(r, s, hash, hashlen, res, key, curve);
+   err = ecc_verify_hash(r, s, hash, hashlen, res, key, curve, NULL);
 #endif /* !WOLFSSL_SP_MATH || FREESCALE_LTC_ECC */
 
    (void)curveLoaded;
@@ -9104,6 +9114,209 @@ int wc_ecc_verify_hash_ex(mp_int *r, mp_int *s, const byte* hash,
    return err;
 #endif /* WOLFSSL_STM32_PKA */
 }
+
+#if defined(HAVE_ECC_VERIFY_HELPER) && !defined(WOLFSSL_SP_MATH) && \
+    !defined(FREESCALE_LTC_ECC) && !defined(WOLFSSL_DSP)
+    #define ECC_VERIFY_BATCH
+#endif
+
+#ifdef ECC_VERIFY_BATCH
+/* maximum number of signatures sharing one inversion */
+#ifndef ECC_VERIFY_BATCH_MAX
+    #define ECC_VERIFY_BATCH_MAX 64
+#endif
+
+/* returns 1 when verifying with key uses the multi-precision path, where the
+   inversion of s can be shared across a batch */
+static int ecc_verify_batch_key(ecc_key* key)
+{
+    if (key->type == ECC_PRIVATEKEY_ONLY)
+        return 0;
+#if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_ECC)
+    if (key->asyncDev.marker == WOLFSSL_ASYNC_MARKER_ECC)
+        return 0;
+#endif
+#ifdef WOLFSSL_HAVE_SP_ECC
+    if (key->idx != ECC_CUSTOM_IDX) {
+    #ifndef WOLFSSL_SP_NO_256
+        if (ecc_sets[key->idx].id == ECC_SECP256R1)
+            return 0;
+    #endif
+    #if defined(WOLFSSL_SM2) && defined(WOLFSSL_SP_SM2)
+        if (ecc_sets[key->idx].id == ECC_SM2P256V1)
+            return 0;
+    #endif
+    #ifdef WOLFSSL_SP_384
+        if (ecc_sets[key->idx].id == ECC_SECP384R1)
+            return 0;
+    #endif
+    #ifdef WOLFSSL_SP_521
+        if (ecc_sets[key->idx].id == ECC_SECP521R1)
+            return 0;
+    #endif
+    }
+#endif
+    return 1;
+}
+
+/* Verify n signatures made with keys on the same curve.
+   All the s values are inverted with one modular inversion using Montgomery's
+   trick: prefix products are inverted once and unwound into each s^-1.
+   Signatures with r or s out of range are invalid and left out. */
+static int ecc_verify_hash_batch_run(mp_int** r, mp_int** s,
+    const byte** hash, const word32* hashlen, int* res, ecc_key** key, int n)
+{
+    int     err = MP_OKAY;
+    int     i, cnt = 0, inited = 0;
+    int     idx[ECC_VERIFY_BATCH_MAX];
+    mp_int* acc = NULL;  /* prefix products, then the inverse of each s */
+    mp_int* inv = NULL;
+    void*   heap = key[0]->heap;
+    DECLARE_CURVE_SPECS(ECC_CURVE_FIELD_COUNT);
+
+    ALLOC_CURVE_SPECS(ECC_CURVE_FIELD_COUNT, err);
+    if (err != 0) {
+        return err;
+    }
+    err = wc_ecc_curve_load(key[0]->dp, &curve, ECC_CURVE_FIELD_ALL);
+
+    if (err == MP_OKAY) {
+        acc = (mp_int*)XMALLOC(sizeof(mp_int) * (size_t)(n + 1), heap,
+                               DYNAMIC_TYPE_ECC);
+        if (acc == NULL)
+            err = MEMORY_E;
+    }
+    for (i = 0; err == MP_OKAY && i <= n; i++) {
+        err = mp_init(&acc[i]);
+        if (err == MP_OKAY)
+            inited++;
+    }
+    if (err == MP_OKAY) {
+        inv = &acc[n];
+
+        for (i = 0; i < n; i++) {
+            if (mp_iszero(r[i]) || mp_iszero(s[i]) ||
+                    mp_cmp(r[i], curve->order) != MP_LT ||
+                    mp_cmp(s[i], curve->order) != MP_LT) {
+                continue;
+            }
+            idx[cnt++] = i;
+        }
+    }
+
+    /* acc[k] = s[0] * ... * s[k] mod n */
+    if (err == MP_OKAY && cnt > 0)
+        err = mp_copy(s[idx[0]], &acc[0]);
+    for (i = 1; err == MP_OKAY && i < cnt; i++)
+        err = mp_mulmod(&acc[i - 1], s[idx[i]], curve->order, &acc[i]);
+
+    /* inv = (s[0] * ... * s[cnt-1])^-1 mod n */
+    if (err == MP_OKAY && cnt > 0)
+        err = mp_invmod(&acc[cnt - 1], curve->order, inv);
+
+    /* acc[k] = inv * acc[k-1] = s[k]^-1, then remove s[k] from inv */
+    for (i = cnt - 1; err == MP_OKAY && i > 0; i--) {
+        err = mp_mulmod(inv, &acc[i - 1], curve->order, &acc[i]);
+        if (err == MP_OKAY)
+            err = mp_mulmod(inv, s[idx[i]], curve->order, inv);
+    }
+    if (err == MP_OKAY && cnt > 0)
+        err = mp_copy(inv, &acc[0]);
+
+    for (i = 0; err == MP_OKAY && i < cnt; i++) {
+        err = ecc_verify_hash(r[idx[i]], s[idx[i]], hash[idx[i]],
+                              hashlen[idx[i]], &res[idx[i]], key[idx[i]], curve,
+                              &acc[i]);
+    }
+
+    for (i = 0; i < inited; i++)
+        mp_clear(&acc[i]);
+    XFREE(acc, heap, DYNAMIC_TYPE_ECC);
+    wc_ecc_curve_free(curve);
+    FREE_CURVE_SPECS();
+
+    return err;
+}
+#endif /* ECC_VERIFY_BATCH */
+
+/* verify one signature of a batch, r or s out of range is not an error */
+static int ecc_verify_batch_one(mp_int* r, mp_int* s, const byte* hash,
+    word32 hashlen, int* res, ecc_key* key)
+{
+    int err = wc_ecc_verify_hash_ex(r, s, hash, hashlen, res, key);
+    if (err == MP_ZERO_E || err == MP_VAL) {
+        *res = 0;
+        err = MP_OKAY;
+    }
+    return err;
+}
+
+/**
+   Verify a batch of ECC signatures
+   r           The signature R components to verify
+   s           The signature S components to verify
+   hash        The hashes (message digests) that were signed
+   hashlen     The length of each hash (octets)
+   res         Result of each signature, 1==valid, 0==invalid
+   key         The corresponding public ECC key of each signature
+   count       Number of signatures in the batch
+   return      MP_OKAY if successful (even if signatures are not valid)
+               Caller should check each res value to determine if the
+               signature is valid or invalid. Other negative values are
+               returned on error.
+*/
+int wc_ecc_verify_hash_batch(mp_int** r, mp_int** s, const byte** hash,
+    const word32* hashlen, int* res, ecc_key** key, int count)
+{
+    int err = MP_OKAY;
+    int i;
+
+    if (r == NULL || s == NULL || hash == NULL || hashlen == NULL ||
+            res == NULL || key == NULL || count < 0) {
+        return ECC_BAD_ARG_E;
+    }
+    for (i = 0; i < count; i++) {
+        if (r[i] == NULL || s[i] == NULL || hash[i] == NULL || key[i] == NULL)
+            return ECC_BAD_ARG_E;
+        if (wc_ecc_is_valid_idx(key[i]->idx) == 0 || key[i]->dp == NULL)
+            return ECC_BAD_ARG_E;
+    }
+    for (i = 0; i < count; i++) {
+        res[i] = 0;
+    }
+
+#ifdef ECC_VERIFY_BATCH
+    i = 0;
+    while (err == MP_OKAY && i < count) {
+        int n = 1;
+
+        if (ecc_verify_batch_key(key[i])) {
+            /* run of keys on the same curve */
+            while (i + n < count && n < ECC_VERIFY_BATCH_MAX &&
+                    key[i + n]->dp == key[i]->dp &&
+                    ecc_verify_batch_key(key[i + n])) {
+                n++;
+            }
+        }
+        if (n > 1) {
+            err = ecc_verify_hash_batch_run(&r[i], &s[i], &hash[i],
+                                            &hashlen[i], &res[i], &key[i], n);
+        }
+        else {
+            err = ecc_verify_batch_one(r[i], s[i], hash[i], hashlen[i],
+                                       &res[i], key[i]);
+        }
+        i += n;
+    }
+#else
+    for (i = 0; err == MP_OKAY && i < count; i++) {
+        err = ecc_verify_batch_one(r[i], s[i], hash[i], hashlen[i], &res[i],
+                                   key[i]);
+    }
+#endif
+
+    return err;
+}
 #endif /* WOLF_CRYPTO_CB_ONLY_ECC */
 #endif /* HAVE_ECC_VERIFY */
 
@@ -11598,11 +11811,35 @@ typedef struct {
    ecc_point* LUT[1U<<FP_LUT]; /* fixed point lookup */
    int        LUT_set;         /* flag to determine if the LUT has been computed */
    mp_int     mu;              /* copy of the montgomery constant */
+   mp_int     prime;           /* copy of the curve modulus */
+#if defined(FP_ECC_SHARED) && defined(WOLFSSL_ATOMIC_OPS)
+   wolfSSL_Atomic_Int lru_count; /* amount of times this entry has been used */
+#else
    int        lru_count;       /* amount of times this entry has been used */
+#endif
    int        lock;            /* flag to indicate cache eviction */
                                /* permitted (0) or not (1) */
 } fp_cache_t;
 
+#ifdef FP_ECC_SHARED
+/* one cache for the whole process: LUTs are built and published under the
+ * write lock, lookups of an entry with a built LUT only take the read lock */
+static fp_cache_t fp_cache[FP_ENTRIES];
+
+    static wolfSSL_RwLock ecc_fp_lock;
+    static volatile int initMutex = 0;  /* prevent multiple lock inits */
+
+    #define FP_ECC_LOCKING
+    #define FP_ECC_LOCK_INIT
+    #define FP_ECC_INIT_LOCK()  wc_InitRwLock(&ecc_fp_lock)
+    #define FP_ECC_FREE_LOCK()  wc_FreeRwLock(&ecc_fp_lock)
+    #define FP_ECC_LOCK()       wc_LockRwLock_Wr(&ecc_fp_lock)
+    #define FP_ECC_UNLOCK()     wc_UnLockRwLock(&ecc_fp_lock)
+#ifdef WOLFSSL_ATOMIC_OPS
+    /* read path needs an atomic lru_count, else everything is write locked */
+    #define FP_ECC_READ_LOCK()  wc_LockRwLock_Rd(&ecc_fp_lock)
+#endif
+#else
 /* if HAVE_THREAD_LS this cache is per thread, no locking needed */
 static THREAD_LS_T fp_cache_t fp_cache[FP_ENTRIES];
 
@@ -11610,8 +11847,33 @@ static THREAD_LS_T fp_cache_t fp_cache[FP_ENTRIES];
     static wolfSSL_Mutex ecc_fp_lock WOLFSSL_MUTEX_INITIALIZER_CLAUSE(ecc_fp_lock);
 #ifndef WOLFSSL_MUTEX_INITIALIZER
     static volatile int initMutex = 0;  /* prevent multiple mutex inits */
+    #define FP_ECC_LOCK_INIT
 #endif
+    #define FP_ECC_LOCKING
+    #define FP_ECC_INIT_LOCK()  wc_InitMutex(&ecc_fp_lock)
+    #define FP_ECC_FREE_LOCK()  wc_FreeMutex(&ecc_fp_lock)
+    #define FP_ECC_LOCK()       wc_LockMutex(&ecc_fp_lock)
+    #define FP_ECC_UNLOCK()     wc_UnLockMutex(&ecc_fp_lock)
 #endif /* HAVE_THREAD_LS */
+#endif /* FP_ECC_SHARED */
+
+/* with the shared cache lru_count is bumped under the read lock, so every
+ * access to it is atomic */
+#if defined(FP_ECC_SHARED) && defined(WOLFSSL_ATOMIC_OPS)
+    #define FP_LRU_GET(idx) \
+        wolfSSL_Atomic_Int_FetchAdd(&fp_cache[idx].lru_count, 0)
+    #define FP_LRU_INC(idx) \
+        (void)wolfSSL_Atomic_Int_FetchAdd(&fp_cache[idx].lru_count, 1)
+    #define FP_LRU_DEC(idx) \
+        (void)wolfSSL_Atomic_Int_FetchSub(&fp_cache[idx].lru_count, 1)
+    #define FP_LRU_RESET(idx) \
+        wolfSSL_Atomic_Int_Init(&fp_cache[idx].lru_count, 0)
+#else
+    #define FP_LRU_GET(idx)     (fp_cache[idx].lru_count)
+    #define FP_LRU_INC(idx)     ++(fp_cache[idx].lru_count)
+    #define FP_LRU_DEC(idx)     --(fp_cache[idx].lru_count)
+    #define FP_LRU_RESET(idx)   (fp_cache[idx].lru_count = 0)
+#endif
 
 /* simple table to help direct the generation of the LUT */
 static const struct {
@@ -12149,22 +12411,23 @@ static int find_hole(void)
 {
    int      x, y, z;
    for (z = -1, y = INT_MAX, x = 0; x < FP_ENTRIES; x++) {
-       if (fp_cache[x].lru_count < y && fp_cache[x].lock == 0) {
+       if (FP_LRU_GET(x) < y && fp_cache[x].lock == 0) {
           z = x;
-          y = fp_cache[x].lru_count;
+          y = FP_LRU_GET(x);
        }
    }
 
    /* decrease all */
    for (x = 0; x < FP_ENTRIES; x++) {
-      if (fp_cache[x].lru_count > 3) {
-         --(fp_cache[x].lru_count);
+      if (FP_LRU_GET(x) > 3) {
+         FP_LRU_DEC(x);
       }
    }
 
    /* free entry z */
    if (z >= 0 && fp_cache[z].g) {
       mp_clear(&fp_cache[z].mu);
+      mp_clear(&fp_cache[z].prime);
       wc_ecc_del_point(fp_cache[z].g);
       fp_cache[z].g  = NULL;
       for (x = 0; x < (1<<FP_LUT); x++) {
@@ -12172,17 +12435,19 @@ static int find_hole(void)
          fp_cache[z].LUT[x] = NULL;
       }
       fp_cache[z].LUT_set = 0;
-      fp_cache[z].lru_count = 0;
+      FP_LRU_RESET(z);
    }
    return z;
 }
 
-/* determine if a base is already in the cache and if so, where */
-static int find_base(ecc_point* g)
+/* determine if a base is already in the cache and if so, where,
+   entries are keyed by curve modulus and point */
+static int find_base(ecc_point* g, mp_int* modulus)
 {
    int x;
    for (x = 0; x < FP_ENTRIES; x++) {
       if (fp_cache[x].g != NULL &&
+          mp_cmp(&fp_cache[x].prime, modulus) == MP_EQ &&
           mp_cmp(fp_cache[x].g->x, g->x) == MP_EQ &&
           mp_cmp(fp_cache[x].g->y, g->y) == MP_EQ &&
           mp_cmp(fp_cache[x].g->z, g->z) == MP_EQ) {
@@ -12196,13 +12461,19 @@ static int find_base(ecc_point* g)
 }
 
 /* add a new base to the cache */
-static int add_entry(int idx, ecc_point *g)
+static int add_entry(int idx, ecc_point *g, mp_int* modulus)
 {
    unsigned x, y;
 
+   /* copy the curve the base is on */
+   if (mp_init_copy(&fp_cache[idx].prime, modulus) != MP_OKAY) {
+      return GEN_MEM_ERR;
+   }
+
    /* allocate base and LUT */
    fp_cache[idx].g = wc_ecc_new_point();
    if (fp_cache[idx].g == NULL) {
+      mp_clear(&fp_cache[idx].prime);
       return GEN_MEM_ERR;
    }
 
@@ -12212,6 +12483,7 @@ static int add_entry(int idx, ecc_point *g)
        (mp_copy(g->z, fp_cache[idx].g->z) != MP_OKAY)) {
       wc_ecc_del_point(fp_cache[idx].g);
       fp_cache[idx].g = NULL;
+      mp_clear(&fp_cache[idx].prime);
       return GEN_MEM_ERR;
    }
 
@@ -12224,13 +12496,14 @@ static int add_entry(int idx, ecc_point *g)
          }
          wc_ecc_del_point(fp_cache[idx].g);
          fp_cache[idx].g         = NULL;
-         fp_cache[idx].lru_count = 0;
+         FP_LRU_RESET(idx);
+         mp_clear(&fp_cache[idx].prime);
          return GEN_MEM_ERR;
       }
    }
 
    fp_cache[idx].LUT_set   = 0;
-   fp_cache[idx].lru_count = 0;
+   FP_LRU_RESET(idx);
 
    return MP_OKAY;
 }
@@ -12392,8 +12665,9 @@ static int build_lut(int idx, mp_int* a, mp_int* modulus, mp_digit mp,
    wc_ecc_del_point(fp_cache[idx].g);
    fp_cache[idx].g         = NULL;
    fp_cache[idx].LUT_set   = 0;
-   fp_cache[idx].lru_count = 0;
+   FP_LRU_RESET(idx);
    mp_clear(&fp_cache[idx].mu);
+   mp_clear(&fp_cache[idx].prime);
 
    return err;
 }
@@ -12578,6 +12852,46 @@ done:
 
    return err;
 }
+
+#ifdef FP_ECC_READ_LOCK
+/* Fixed point mulmod using the shared cache while only holding the read lock.
+   Sets done when G was cached with its LUT built, otherwise the caller takes
+   the write lock to add the entry and build the LUT.
+   return MP_OKAY if successful */
+static int fp_shared_mulmod(const mp_int* k, ecc_point* G, ecc_point* R,
+                            mp_int* a, mp_int* modulus, int map, int* done)
+{
+   int      idx, err = MP_OKAY;
+   mp_digit mp;
+
+   if (initMutex == 0) { /* extra sanity check if wolfCrypt_Init not called */
+        FP_ECC_INIT_LOCK();
+        initMutex = 1;
+   }
+
+   if (FP_ECC_READ_LOCK() != 0) {
+      return BAD_MUTEX_E;
+   }
+
+   idx = find_base(G, modulus);
+   if (idx >= 0 && fp_cache[idx].LUT_set) {
+      FP_LRU_INC(idx);
+      *done = 1;
+
+      SAVE_VECTOR_REGISTERS(err = _svr_ret;);
+      if (err == MP_OKAY) {
+         err = mp_montgomery_setup(modulus, &mp);
+         if (err == MP_OKAY)
+            err = accel_fp_mul(idx, k, R, a, modulus, mp, map);
+         RESTORE_VECTOR_REGISTERS();
+      }
+   }
+
+   FP_ECC_UNLOCK();
+
+   return err;
+}
+#endif /* FP_ECC_READ_LOCK */
 #endif
 
 #ifdef ECC_SHAMIR
@@ -12862,6 +13176,50 @@ done:
 }
 
 
+#ifdef FP_ECC_READ_LOCK
+/* Shamir's Trick using the shared cache while only holding the read lock.
+   Sets done when both A and B were cached with their LUTs built.
+   return MP_OKAY on success */
+static int fp_shared_mul2add(ecc_point* A, mp_int* kA,
+                             ecc_point* B, mp_int* kB,
+                             ecc_point* C, mp_int* a, mp_int* modulus,
+                             int* done)
+{
+   int      idx1, idx2, err = MP_OKAY;
+   mp_digit mp;
+
+   if (initMutex == 0) { /* extra sanity check if wolfCrypt_Init not called */
+        FP_ECC_INIT_LOCK();
+        initMutex = 1;
+   }
+
+   if (FP_ECC_READ_LOCK() != 0) {
+      return BAD_MUTEX_E;
+   }
+
+   idx1 = find_base(A, modulus);
+   idx2 = find_base(B, modulus);
+   if (idx1 >= 0 && idx2 >= 0 && fp_cache[idx1].LUT_set &&
+                                 fp_cache[idx2].LUT_set) {
+      FP_LRU_INC(idx1);
+      FP_LRU_INC(idx2);
+      *done = 1;
+
+      SAVE_VECTOR_REGISTERS(err = _svr_ret;);
+      if (err == MP_OKAY) {
+         err = mp_montgomery_setup(modulus, &mp);
+         if (err == MP_OKAY)
+            err = accel_fp_mul2add(idx1, idx2, kA, kB, C, a, modulus, mp);
+         RESTORE_VECTOR_REGISTERS();
+      }
+   }
+
+   FP_ECC_UNLOCK();
+
+   return err;
+}
+#endif /* FP_ECC_READ_LOCK */
+
 /** ECC Fixed Point mulmod global with heap hint used
   Computes kA*A + kB*B = C using Shamir's Trick
   A        First point to multiply
@@ -12880,12 +13238,24 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
    int  idx1 = -1, idx2 = -1, err, mpInit = 0;
    mp_digit mp;
 #ifdef WOLFSSL_SMALL_STACK
-   mp_int   *mu = (mp_int *)XMALLOC(sizeof *mu, NULL, DYNAMIC_TYPE_ECC_BUFFER);
+   mp_int   *mu;
+#else
+   mp_int   mu[1];
+#endif
+
+#ifdef FP_ECC_READ_LOCK
+   {
+      int done = 0;
+      err = fp_shared_mul2add(A, kA, B, kB, C, a, modulus, &done);
+      if (err != MP_OKAY || done)
+         return err;
+   }
+#endif
 
+#ifdef WOLFSSL_SMALL_STACK
+   mu = (mp_int *)XMALLOC(sizeof *mu, NULL, DYNAMIC_TYPE_ECC_BUFFER);
    if (mu == NULL)
        return MP_MEM;
-#else
-   mp_int   mu[1];
 #endif
 
    err = mp_init(mu);
@@ -12896,59 +13266,59 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
        return err;
    }
 
-#ifndef HAVE_THREAD_LS
-#ifndef WOLFSSL_MUTEX_INITIALIZER
+#ifdef FP_ECC_LOCKING
+#ifdef FP_ECC_LOCK_INIT
    if (initMutex == 0) { /* extra sanity check if wolfCrypt_Init not called */
-        wc_InitMutex(&ecc_fp_lock);
+        FP_ECC_INIT_LOCK();
         initMutex = 1;
    }
 #endif
 
-   if (wc_LockMutex(&ecc_fp_lock) != 0) {
+   if (FP_ECC_LOCK() != 0) {
 #ifdef WOLFSSL_SMALL_STACK
        XFREE(mu, NULL, DYNAMIC_TYPE_ECC_BUFFER);
 #endif
       return BAD_MUTEX_E;
    }
-#endif /* HAVE_THREAD_LS */
+#endif /* FP_ECC_LOCKING */
 
       SAVE_VECTOR_REGISTERS(err = _svr_ret;);
 
       /* find point */
-      idx1 = find_base(A);
+      idx1 = find_base(A, modulus);
 
       /* no entry? */
       if (idx1 == -1) {
          /* find hole and add it */
          if ((idx1 = find_hole()) >= 0) {
-            err = add_entry(idx1, A);
+            err = add_entry(idx1, A, modulus);
          }
       }
       if (err == MP_OKAY && idx1 != -1) {
          /* increment LRU */
-         ++(fp_cache[idx1].lru_count);
+         FP_LRU_INC(idx1);
       }
 
       if (err == MP_OKAY) {
         /* find point */
-        idx2 = find_base(B);
+        idx2 = find_base(B, modulus);
 
         /* no entry? */
         if (idx2 == -1) {
            /* find hole and add it */
            if ((idx2 = find_hole()) >= 0)
-              err = add_entry(idx2, B);
+              err = add_entry(idx2, B, modulus);
          }
       }
 
       if (err == MP_OKAY && idx2 != -1) {
          /* increment LRU */
-         ++(fp_cache[idx2].lru_count);
+         FP_LRU_INC(idx2);
       }
 
       if (err == MP_OKAY) {
         /* if it's >= 2 AND the LUT is not set build the LUT */
-        if (idx1 >= 0 && fp_cache[idx1].lru_count >= 2 && !fp_cache[idx1].LUT_set) {
+        if (idx1 >= 0 && FP_LRU_GET(idx1) >= 2 && !fp_cache[idx1].LUT_set) {
            /* compute mp */
            err = mp_montgomery_setup(modulus, &mp);
 
@@ -12965,7 +13335,7 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
 
       if (err == MP_OKAY) {
         /* if it's >= 2 AND the LUT is not set build the LUT */
-        if (idx2 >= 0 && fp_cache[idx2].lru_count >= 2 && !fp_cache[idx2].LUT_set) {
+        if (idx2 >= 0 && FP_LRU_GET(idx2) >= 2 && !fp_cache[idx2].LUT_set) {
            if (mpInit == 0) {
                 /* compute mp */
                 err = mp_montgomery_setup(modulus, &mp);
@@ -12998,9 +13368,9 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
 
       RESTORE_VECTOR_REGISTERS();
 
-#ifndef HAVE_THREAD_LS
-    wc_UnLockMutex(&ecc_fp_lock);
-#endif /* HAVE_THREAD_LS */
+#ifdef FP_ECC_LOCKING
+    FP_ECC_UNLOCK();
+#endif /* FP_ECC_LOCKING */
     mp_clear(mu);
 #ifdef WOLFSSL_SMALL_STACK
     XFREE(mu, NULL, DYNAMIC_TYPE_ECC_BUFFER);
@@ -13033,7 +13403,7 @@ int wc_ecc_mulmod_ex(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
    mp_int   mu[1];
 #endif
    int      mpSetup = 0;
-#ifndef HAVE_THREAD_LS
+#ifdef FP_ECC_LOCKING
    int got_ecc_fp_lock = 0;
 #endif
 
@@ -13046,6 +13416,15 @@ int wc_ecc_mulmod_ex(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
       return ECC_OUT_OF_RANGE_E;
    }
 
+#ifdef FP_ECC_READ_LOCK
+   {
+      int done = 0;
+      err = fp_shared_mulmod(k, G, R, a, modulus, map, &done);
+      if (err != MP_OKAY || done)
+         return err;
+   }
+#endif
+
 #ifdef WOLFSSL_SMALL_STACK
    if ((mu = (mp_int *)XMALLOC(sizeof(*mu), NULL, DYNAMIC_TYPE_ECC_BUFFER)) == NULL)
        return MP_MEM;
@@ -13056,25 +13435,25 @@ int wc_ecc_mulmod_ex(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
        goto out;
    }
 
-#ifndef HAVE_THREAD_LS
-#ifndef WOLFSSL_MUTEX_INITIALIZER
+#ifdef FP_ECC_LOCKING
+#ifdef FP_ECC_LOCK_INIT
    if (initMutex == 0) { /* extra sanity check if wolfCrypt_Init not called */
-        wc_InitMutex(&ecc_fp_lock);
+        FP_ECC_INIT_LOCK();
         initMutex = 1;
    }
 #endif
 
-   if (wc_LockMutex(&ecc_fp_lock) != 0) {
+   if (FP_ECC_LOCK() != 0) {
       err = BAD_MUTEX_E;
       goto out;
    }
    got_ecc_fp_lock = 1;
-#endif /* HAVE_THREAD_LS */
+#endif /* FP_ECC_LOCKING */
 
       SAVE_VECTOR_REGISTERS(err = _svr_ret; goto out;);
 
       /* find point */
-      idx = find_base(G);
+      idx = find_base(G, modulus);
 
       /* no entry? */
       if (idx == -1) {
@@ -13082,17 +13461,17 @@ int wc_ecc_mulmod_ex(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
          idx = find_hole();
 
          if (idx >= 0)
-            err = add_entry(idx, G);
+            err = add_entry(idx, G, modulus);
       }
       if (err == MP_OKAY && idx >= 0) {
          /* increment LRU */
-         ++(fp_cache[idx].lru_count);
+         FP_LRU_INC(idx);
       }
 
 
       if (err == MP_OKAY) {
         /* if it's 2 build the LUT, if it's higher just use the LUT */
-        if (idx >= 0 && fp_cache[idx].lru_count >= 2 && !fp_cache[idx].LUT_set) {
+        if (idx >= 0 && FP_LRU_GET(idx) >= 2 && !fp_cache[idx].LUT_set) {
            /* compute mp */
            err = mp_montgomery_setup(modulus, &mp);
 
@@ -13125,10 +13504,10 @@ int wc_ecc_mulmod_ex(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
 
   out:
 
-#ifndef HAVE_THREAD_LS
+#ifdef FP_ECC_LOCKING
     if (got_ecc_fp_lock)
-        wc_UnLockMutex(&ecc_fp_lock);
-#endif /* HAVE_THREAD_LS */
+        FP_ECC_UNLOCK();
+#endif /* FP_ECC_LOCKING */
     mp_clear(mu);
 #ifdef WOLFSSL_SMALL_STACK
     XFREE(mu, NULL, DYNAMIC_TYPE_ECC_BUFFER);
@@ -13209,7 +13588,7 @@ int wc_ecc_mulmod_ex2(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
    mp_int   mu[1];
 #endif
    int      mpSetup = 0;
-#ifndef HAVE_THREAD_LS
+#ifdef FP_ECC_LOCKING
    int got_ecc_fp_lock = 0;
 #endif
 
@@ -13223,6 +13602,15 @@ int wc_ecc_mulmod_ex2(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
       return ECC_OUT_OF_RANGE_E;
    }
 
+#ifdef FP_ECC_READ_LOCK
+   {
+      int done = 0;
+      err = fp_shared_mulmod(k, G, R, a, modulus, map, &done);
+      if (err != MP_OKAY || done)
+         return err;
+   }
+#endif
+
 #ifdef WOLFSSL_SMALL_STACK
    if ((mu = (mp_int *)XMALLOC(sizeof(*mu), NULL, DYNAMIC_TYPE_ECC_BUFFER)) == NULL)
        return MP_MEM;
@@ -13233,25 +13621,25 @@ int wc_ecc_mulmod_ex2(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
        goto out;
    }
 
-#ifndef HAVE_THREAD_LS
-#ifndef WOLFSSL_MUTEX_INITIALIZER
+#ifdef FP_ECC_LOCKING
+#ifdef FP_ECC_LOCK_INIT
    if (initMutex == 0) { /* extra sanity check if wolfCrypt_Init not called */
-        wc_InitMutex(&ecc_fp_lock);
+        FP_ECC_INIT_LOCK();
         initMutex = 1;
    }
 #endif
 
-   if (wc_LockMutex(&ecc_fp_lock) != 0) {
+   if (FP_ECC_LOCK() != 0) {
       err = BAD_MUTEX_E;
       goto out;
    }
    got_ecc_fp_lock = 1;
-#endif /* HAVE_THREAD_LS */
+#endif /* FP_ECC_LOCKING */
 
       SAVE_VECTOR_REGISTERS(err = _svr_ret; goto out;);
 
       /* find point */
-      idx = find_base(G);
+      idx = find_base(G, modulus);
 
       /* no entry? */
       if (idx == -1) {
@@ -13259,17 +13647,17 @@ int wc_ecc_mulmod_ex2(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
          idx = find_hole();
 
          if (idx >= 0)
-            err = add_entry(idx, G);
+            err = add_entry(idx, G, modulus);
       }
       if (err == MP_OKAY && idx >= 0) {
          /* increment LRU */
-         ++(fp_cache[idx].lru_count);
+         FP_LRU_INC(idx);
       }
 
 
       if (err == MP_OKAY) {
         /* if it's 2 build the LUT, if it's higher just use the LUT */
-        if (idx >= 0 && fp_cache[idx].lru_count >= 2 && !fp_cache[idx].LUT_set) {
+        if (idx >= 0 && FP_LRU_GET(idx) >= 2 && !fp_cache[idx].LUT_set) {
            /* compute mp */
            err = mp_montgomery_setup(modulus, &mp);
 
@@ -13302,10 +13690,10 @@ int wc_ecc_mulmod_ex2(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
 
   out:
 
-#ifndef HAVE_THREAD_LS
+#ifdef FP_ECC_LOCKING
     if (got_ecc_fp_lock)
-        wc_UnLockMutex(&ecc_fp_lock);
-#endif /* HAVE_THREAD_LS */
+        FP_ECC_UNLOCK();
+#endif /* FP_ECC_LOCKING */
     mp_clear(mu);
 #ifdef WOLFSSL_SMALL_STACK
     XFREE(mu, NULL, DYNAMIC_TYPE_ECC_BUFFER);
@@ -13382,8 +13770,9 @@ static void wc_ecc_fp_free_cache(void)
          wc_ecc_del_point(fp_cache[x].g);
          fp_cache[x].g         = NULL;
          mp_clear(&fp_cache[x].mu);
+         mp_clear(&fp_cache[x].prime);
          fp_cache[x].LUT_set   = 0;
-         fp_cache[x].lru_count = 0;
+         FP_LRU_RESET(x);
          fp_cache[x].lock = 0;
       }
    }
@@ -13395,10 +13784,10 @@ static void wc_ecc_fp_free_cache(void)
 void wc_ecc_fp_init(void)
 {
 #ifndef WOLFSSL_SP_MATH
-#ifndef HAVE_THREAD_LS
-#ifndef WOLFSSL_MUTEX_INITIALIZER
+#ifdef FP_ECC_LOCKING
+#ifdef FP_ECC_LOCK_INIT
    if (initMutex == 0) {
-        wc_InitMutex(&ecc_fp_lock);
+        FP_ECC_INIT_LOCK();
         initMutex = 1;
    }
 #endif
@@ -13412,27 +13801,29 @@ WOLFSSL_ABI
 void wc_ecc_fp_free(void)
 {
 #if !defined(WOLFSSL_SP_MATH)
-#ifndef HAVE_THREAD_LS
-#ifndef WOLFSSL_MUTEX_INITIALIZER
+#ifdef FP_ECC_LOCKING
+#ifdef FP_ECC_LOCK_INIT
    if (initMutex == 0) { /* extra sanity check if wolfCrypt_Init not called */
-        wc_InitMutex(&ecc_fp_lock);
+        FP_ECC_INIT_LOCK();
         initMutex = 1;
    }
 #endif
 
-   if (wc_LockMutex(&ecc_fp_lock) == 0) {
-#endif /* HAVE_THREAD_LS */
+   if (FP_ECC_LOCK() == 0) {
+#endif /* FP_ECC_LOCKING */
 
        wc_ecc_fp_free_cache();
 
-#ifndef HAVE_THREAD_LS
-       wc_UnLockMutex(&ecc_fp_lock);
-#ifndef WOLFSSL_MUTEX_INITIALIZER
-       wc_FreeMutex(&ecc_fp_lock);
+#ifdef FP_ECC_LOCKING
+       FP_ECC_UNLOCK();
+#if defined(FP_ECC_LOCK_INIT) && !defined(FP_ECC_SHARED)
+       FP_ECC_FREE_LOCK();
        initMutex = 0;
 #endif
+       /* with FP_ECC_SHARED other threads may still be using the cache, so
+        * only the entries are freed and the lock is kept */
    }
-#endif /* HAVE_THREAD_LS */
+#endif /* FP_ECC_LOCKING */
 #endif
 }
 
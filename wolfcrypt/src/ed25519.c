@@ -634,33 +634,10 @@ static const byte ed25519_low_order[] = {
 
 /*
    sig     is array of bytes containing the signature
-   sigLen  is the length of sig byte array
-   res     will be 1 on successful verify and 0 on unsuccessful
-   key     Ed25519 public key
-   return  0 and res of 1 on success
+   return  0 when S is less than the order and BAD_FUNC_ARG otherwise
 */
-static int ed25519_verify_msg_final_with_sha(const byte* sig, word32 sigLen,
-                                             int* res, ed25519_key* key,
-                                             wc_Sha512 *sha)
+static int ed25519_check_s(const byte* sig)
 {
-    ALIGN16 byte rcheck[ED25519_KEY_SIZE];
-    ALIGN16 byte h[WC_SHA512_DIGEST_SIZE];
-#ifndef FREESCALE_LTC_ECC
-    ge_p3  A;
-    ge_p2  R;
-#endif
-    int    ret;
-
-    /* sanity check on arguments */
-    if (sig == NULL || res == NULL || key == NULL)
-        return BAD_FUNC_ARG;
-
-    /* set verification failed by default */
-    *res = 0;
-
-    /* check on basics needed to verify signature */
-    if (sigLen != ED25519_SIG_SIZE)
-        return BAD_FUNC_ARG;
     /* S is not larger or equal to the order:
      *     2^252 + 0x14def9dea2f79cd65812631a5cf5d3ed
      *   = 0x1000000000000000000000000000000014def9dea2f79cd65812631a5cf5d3ed
@@ -693,6 +670,42 @@ static int ed25519_verify_msg_final_with_sha(const byte* sig, word32 sigLen,
         }
     }
 
+    return 0;
+}
+
+/*
+   sig     is array of bytes containing the signature
+   sigLen  is the length of sig byte array
+   res     will be 1 on successful verify and 0 on unsuccessful
+   key     Ed25519 public key
+   return  0 and res of 1 on success
+*/
+static int ed25519_verify_msg_final_with_sha(const byte* sig, word32 sigLen,
+                                             int* res, ed25519_key* key,
+                                             wc_Sha512 *sha)
+{
+    ALIGN16 byte rcheck[ED25519_KEY_SIZE];
+    ALIGN16 byte h[WC_SHA512_DIGEST_SIZE];
+#ifndef FREESCALE_LTC_ECC
+    ge_p3  A;
+    ge_p2  R;
+#endif
+    int    ret;
+
+    /* sanity check on arguments */
+    if (sig == NULL || res == NULL || key == NULL)
+        return BAD_FUNC_ARG;
+
+    /* set verification failed by default */
+    *res = 0;
+
+    /* check on basics needed to verify signature */
+    if (sigLen != ED25519_SIG_SIZE)
+        return BAD_FUNC_ARG;
+    ret = ed25519_check_s(sig);
+    if (ret != 0)
+        return ret;
+
     /* uncompress A (public key), test if valid, and negate it */
 #ifndef FREESCALE_LTC_ECC
     if (ge_frombytes_negate_vartime(&A, key->p) != 0)
@@ -905,6 +918,283 @@ int wc_ed25519ph_verify_msg(const byte* sig, word32 sigLen, const byte* msg,
     return wc_ed25519_verify_msg_ex(sig, sigLen, hash, sizeof(hash), res, key,
                                     Ed25519ph, context, contextLen);
 }
+
+#if !defined(ED25519_SMALL) && !defined(FREESCALE_LTC_ECC) && \
+    !defined(WOLFSSL_SE050)
+    #define ED25519_VERIFY_BATCH
+#endif
+
+#ifndef ED25519_BATCH_MAX
+    /* Number of signatures combined into one check. */
+    #define ED25519_BATCH_MAX   64
+#endif
+
+/* Verify one signature of a batch. An invalid signature is a result of 0 and
+ * not an error so that the rest of the batch is still checked.
+ */
+static int ed25519_verify_batch_one(const byte* sig, word32 sigLen,
+                                    const byte* msg, word32 msgLen, int* res,
+                                    ed25519_key* key)
+{
+    int ret = wc_ed25519_verify_msg(sig, sigLen, msg, msgLen, res, key);
+    if (ret == SIG_VERIFY_E || ret == BAD_FUNC_ARG) {
+        *res = 0;
+        ret = 0;
+    }
+    return ret;
+}
+
+#ifdef ED25519_VERIFY_BATCH
+/* The single verify compares encodings so R must be the canonical encoding
+ * of a point for the combined check to give the same answer.
+ *
+ * r  R of the signature.
+ * returns 1 when canonical and 0 otherwise.
+ */
+static int ed25519_r_canonical(const byte* r)
+{
+    int i;
+
+    /* y is less than p = 2^255 - 19 */
+    if ((r[ED25519_KEY_SIZE-1] & 0x7f) == 0x7f) {
+        for (i = ED25519_KEY_SIZE-2; i > 0 && r[i] == 0xff; i--) {
+        }
+        if (i == 0 && r[0] >= 0xed)
+            return 0;
+    }
+    /* x is zero when y is 1 or -1 - sign bit must not be set */
+    if (r[ED25519_KEY_SIZE-1] & 0x80) {
+        byte top = r[ED25519_KEY_SIZE-1] & 0x7f;
+        byte mid = (top == 0) ? 0x00 : 0xff;
+
+        if ((top == 0x00 && r[0] == 0x01) || (top == 0x7f && r[0] == 0xec)) {
+            for (i = 1; i < ED25519_KEY_SIZE-1 && r[i] == mid; i++) {
+            }
+            if (i == ED25519_KEY_SIZE-1)
+                return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* Decode the points of one signature and calculate H(R,A,M).
+ *
+ * k   H(R,A,M) reduced modulo the order.
+ * nA  negated public key.
+ * nR  negated R of the signature.
+ * returns SIG_VERIFY_E when the signature can't be valid, 0 on success and
+ * other negative values on error.
+ */
+static int ed25519_verify_batch_prep(const byte* sig, word32 sigLen,
+    const byte* msg, word32 msgLen, ed25519_key* key, byte* k, ge_p3* nA,
+    ge_p3* nR)
+{
+    int ret;
+    ALIGN16 byte h[WC_SHA512_DIGEST_SIZE];
+#ifdef WOLFSSL_ED25519_PERSISTENT_SHA
+    wc_Sha512 *sha;
+#else
+    wc_Sha512 sha[1];
+#endif
+
+    if (sigLen != ED25519_SIG_SIZE ||
+            ed25519_check_s(sig) != 0 || !ed25519_r_canonical(sig) ||
+            ge_frombytes_negate_vartime(nA, key->p) != 0 ||
+            ge_frombytes_negate_vartime(nR, sig) != 0) {
+        return SIG_VERIFY_E;
+    }
+
+#ifdef WOLFSSL_ED25519_PERSISTENT_SHA
+    sha = &key->sha;
+#else
+    ret = ed25519_hash_init(key, sha);
+    if (ret < 0)
+        return ret;
+#endif
+
+    ret = ed25519_verify_msg_init_with_sha(sig, sigLen, key, sha,
+        (byte)Ed25519, NULL, 0);
+    if (ret == 0)
+        ret = ed25519_verify_msg_update_with_sha(msg, msgLen, key, sha);
+    if (ret == 0)
+        ret = ed25519_hash_final(key, sha, h);
+
+#ifndef WOLFSSL_ED25519_PERSISTENT_SHA
+    ed25519_hash_free(key, sha);
+#endif
+
+    if (ret == 0) {
+        sc_reduce(h);
+        XMEMCPY(k, h, ED25519_KEY_SIZE);
+    }
+
+    return ret;
+}
+
+/* Verify up to ED25519_BATCH_MAX signatures with one check:
+ *   8((sum z_i.S_i)B - sum (z_i.k_i)A_i - sum z_i.R_i) == 0
+ * with z_i random, non-zero 128-bit values. The check is cofactored: with
+ * random weights, small order components of R and A only add up modulo 8 and
+ * may cancel out, so they are cleared instead of checked. Only signatures
+ * with such components, which a signer never makes, can be accepted here and
+ * rejected by the cofactorless single verify. When the check fails each
+ * signature is verified on its own to find the bad ones.
+ *
+ * sc   scratch of 2 * ED25519_BATCH_MAX scalars.
+ * pts  scratch of 2 * ED25519_BATCH_MAX points.
+ */
+static int ed25519_verify_batch_run(const byte** sig, const word32* sigLen,
+    const byte** msg, const word32* msgLen, int* res, ed25519_key** key,
+    int n, WC_RNG* rng, byte* sc, ge_p3* pts)
+{
+    int    ret = 0;
+    int    i;
+    int    m = 0;
+    int    idx[ED25519_BATCH_MAX];
+    byte   b[ED25519_KEY_SIZE];
+    byte   z[ED25519_KEY_SIZE];
+    byte   chk[ED25519_KEY_SIZE];
+    byte   zero[ED25519_KEY_SIZE];
+    ge_p2  R;
+
+    XMEMSET(b, 0, sizeof(b));
+    XMEMSET(z, 0, sizeof(z));
+    XMEMSET(zero, 0, sizeof(zero));
+
+    for (i = 0; ret == 0 && i < n; i++) {
+        byte* zk = sc + m * ED25519_KEY_SIZE;
+        byte* zr = sc + (ED25519_BATCH_MAX + m) * ED25519_KEY_SIZE;
+
+    #ifdef WOLF_CRYPTO_CB
+        if (key[i]->devId != INVALID_DEVID) {
+            ret = ed25519_verify_batch_one(sig[i], sigLen[i], msg[i],
+                msgLen[i], &res[i], key[i]);
+            continue;
+        }
+    #endif
+
+        ret = ed25519_verify_batch_prep(sig[i], sigLen[i], msg[i], msgLen[i],
+            key[i], zk, &pts[m], &pts[ED25519_BATCH_MAX + m]);
+        if (ret == SIG_VERIFY_E) {
+            ret = 0;
+            continue;
+        }
+        if (ret == 0) {
+            ret = wc_RNG_GenerateBlock(rng, z, ED25519_KEY_SIZE / 2);
+        }
+        if (ret == 0) {
+            /* Never zero. */
+            z[0] |= 1;
+            /* z.k for -A, z for -R and accumulate z.S for B. */
+            sc_muladd(zk, z, zk, zero);
+            XMEMCPY(zr, z, ED25519_KEY_SIZE);
+            sc_muladd(b, z, sig[i] + ED25519_SIG_SIZE/2, b);
+            idx[m++] = i;
+        }
+    }
+
+    if (ret == 0 && m == 1) {
+        ret = ed25519_verify_batch_one(sig[idx[0]], sigLen[idx[0]],
+            msg[idx[0]], msgLen[idx[0]], &res[idx[0]], key[idx[0]]);
+    }
+    else if (ret == 0 && m > 1) {
+        /* Pack the R terms after the A terms. */
+        if (m < ED25519_BATCH_MAX) {
+            XMEMMOVE(sc + m * ED25519_KEY_SIZE,
+                sc + ED25519_BATCH_MAX * ED25519_KEY_SIZE,
+                m * ED25519_KEY_SIZE);
+            XMEMMOVE(&pts[m], &pts[ED25519_BATCH_MAX], m * sizeof(ge_p3));
+        }
+
+        ret = ge_multi_scalarmult_vartime(&R, b, sc, pts, 2 * m,
+            key[0]->heap);
+        if (ret == 0) {
+            ge_p2_mul8(&R);
+            ge_tobytes(chk, &R);
+            /* Encoding of the identity is y = 1. */
+            zero[0] = 1;
+            if (XMEMCMP(chk, zero, ED25519_KEY_SIZE) == 0) {
+                for (i = 0; i < m; i++)
+                    res[idx[i]] = 1;
+            }
+            else {
+                for (i = 0; ret == 0 && i < m; i++) {
+                    ret = ed25519_verify_batch_one(sig[idx[i]],
+                        sigLen[idx[i]], msg[idx[i]], msgLen[idx[i]],
+                        &res[idx[i]], key[idx[i]]);
+                }
+            }
+        }
+    }
+
+    ForceZero(z, sizeof(z));
+
+    return ret;
+}
+#endif /* ED25519_VERIFY_BATCH */
+
+/*
+   sig     array of signatures
+   sigLen  array of signature lengths
+   msg     array of messages
+   msgLen  array of message lengths
+   res     array of results, each 1 on successful verify and 0 otherwise
+   key     array of Ed25519 public keys
+   count   number of signatures
+   rng     random number generator for the batch weights
+   return  0 when all signatures were checked, res holds the outcome of each
+*/
+int wc_ed25519_verify_msg_batch(const byte** sig, const word32* sigLen,
+    const byte** msg, const word32* msgLen, int* res, ed25519_key** key,
+    word32 count, WC_RNG* rng)
+{
+    int    ret = 0;
+    word32 i;
+#ifdef ED25519_VERIFY_BATCH
+    byte*  sc = NULL;
+    ge_p3* pts = NULL;
+    void*  heap;
+#endif
+
+    if (sig == NULL || sigLen == NULL || msg == NULL || msgLen == NULL ||
+            res == NULL || key == NULL || rng == NULL) {
+        return BAD_FUNC_ARG;
+    }
+    for (i = 0; i < count; i++) {
+        if (sig[i] == NULL || msg[i] == NULL || key[i] == NULL)
+            return BAD_FUNC_ARG;
+        res[i] = 0;
+    }
+    if (count == 0)
+        return 0;
+
+#ifdef ED25519_VERIFY_BATCH
+    heap = key[0]->heap;
+    sc = (byte*)XMALLOC(2 * ED25519_BATCH_MAX * ED25519_KEY_SIZE, heap,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    pts = (ge_p3*)XMALLOC(2 * ED25519_BATCH_MAX * sizeof(ge_p3), heap,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (sc == NULL || pts == NULL)
+        ret = MEMORY_E;
+
+    for (i = 0; ret == 0 && i < count; i += ED25519_BATCH_MAX) {
+        int n = (int)min(count - i, ED25519_BATCH_MAX);
+        ret = ed25519_verify_batch_run(&sig[i], &sigLen[i], &msg[i],
+            &msgLen[i], &res[i], &key[i], n, rng, sc, pts);
+    }
+
+    XFREE(pts, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(sc, heap, DYNAMIC_TYPE_TMP_BUFFER);
+#else
+    for (i = 0; ret == 0 && i < count; i++) {
+        ret = ed25519_verify_batch_one(sig[i], sigLen[i], msg[i], msgLen[i],
+            &res[i], key[i]);
+    }
+#endif
+
+    return ret;
+}
 #endif /* HAVE_ED25519_VERIFY */
 
 
@@ -9489,6 +9489,117 @@ int ge_double_scalarmult_vartime(ge_p2 *r, const unsigned char *a,
 #endif
 }
 
+
+/*
+r = b * B + s[0] * P[0] + ... + s[n-1] * P[n-1]
+where each scalar is 32 bytes little endian, s holds the n scalars back to
+back, and B is the Ed25519 base point.
+The sliding windows of all the scalars are walked together (Straus) so every
+doubling is shared by all the points. Not constant time, public values only.
+*/
+int ge_multi_scalarmult_vartime(ge_p2 *r, const unsigned char *b,
+                                const unsigned char *s, const ge_p3 *P, int n,
+                                void* heap)
+{
+  signed char *slides = NULL; /* slide of each scalar, base point last */
+  ge_cached *Pi = NULL;       /* P,3P,5P,7P,9P,11P,13P,15P of each point */
+  signed char *bslide;
+  ge_p1p1 t;
+  ge_p3 u;
+  ge_p3 P2;
+  int i, j, k;
+
+  (void)heap;
+
+  if (r == NULL || b == NULL || n < 0 || (n > 0 && (s == NULL || P == NULL)))
+      return BAD_FUNC_ARG;
+
+  slides = (signed char *)XMALLOC((size_t)(n + 1) * SLIDE_SIZE, heap,
+                                  DYNAMIC_TYPE_TMP_BUFFER);
+  if (slides == NULL)
+      return MEMORY_E;
+  if (n > 0) {
+      Pi = (ge_cached *)XMALLOC((size_t)n * 8 * sizeof(*Pi), heap,
+                                DYNAMIC_TYPE_TMP_BUFFER);
+      if (Pi == NULL) {
+          XFREE(slides, heap, DYNAMIC_TYPE_TMP_BUFFER);
+          return MEMORY_E;
+      }
+  }
+
+  for (j = 0; j < n; j++) {
+      ge_cached *Aj = Pi + 8 * j;
+
+      slide(slides + j * SLIDE_SIZE, s + j * 32);
+
+      ge_p3_to_cached(&Aj[0],&P[j]);
+      ge_p3_dbl(&t,&P[j]); ge_p1p1_to_p3(&P2,&t);
+      for (k = 1; k < 8; k++) {
+          ge_add(&t,&P2,&Aj[k-1]); ge_p1p1_to_p3(&u,&t);
+          ge_p3_to_cached(&Aj[k],&u);
+      }
+  }
+  bslide = slides + n * SLIDE_SIZE;
+  slide(bslide,b);
+
+  ge_p2_0(r);
+
+  /* find the top non-zero digit of all the scalars */
+  for (i = SLIDE_SIZE - 1; i >= 0; --i) {
+    for (j = 0; j <= n; j++) {
+      if (slides[j * SLIDE_SIZE + i])
+        break;
+    }
+    if (j <= n) break;
+  }
+
+  for (;i >= 0;--i) {
+    ge_p2_dbl(&t,r);
+
+    for (j = 0; j < n; j++) {
+      signed char d = slides[j * SLIDE_SIZE + i];
+
+      if (d > 0) {
+        ge_p1p1_to_p3(&u,&t);
+        ge_add(&t,&u,&Pi[8 * j + d/2]);
+      } else if (d < 0) {
+        ge_p1p1_to_p3(&u,&t);
+        ge_sub(&t,&u,&Pi[8 * j + (-d)/2]);
+      }
+    }
+
+    if (bslide[i] > 0) {
+      ge_p1p1_to_p3(&u,&t);
+      ge_madd(&t,&u,&Bi[bslide[i]/2]);
+    } else if (bslide[i] < 0) {
+      ge_p1p1_to_p3(&u,&t);
+      ge_msub(&t,&u,&Bi[(-bslide[i])/2]);
+    }
+
+    ge_p1p1_to_p2(r,&t);
+  }
+
+  XFREE(Pi, heap, DYNAMIC_TYPE_TMP_BUFFER);
+  XFREE(slides, heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+  return 0;
+}
+
+/*
+r = 8 * r
+Clears any small order component, as used by cofactored verification.
+*/
+void ge_p2_mul8(ge_p2 *r)
+{
+  ge_p1p1 t;
+  int i;
+
+  for (i = 0; i < 3; i++) {
+    ge_p2_dbl(&t,r);
+    ge_p1p1_to_p2(r,&t);
+  }
+}
+
 #ifdef CURVED25519_ASM_64BIT
 static const ge d = {
     0x75eb4dca135978a3, 0x00700a4d4141d8ab, -0x7338bf8688861768, 0x52036cee2b6ffe73,
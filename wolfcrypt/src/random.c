@@ -1836,6 +1836,103 @@ int wc_InitRngNonce_ex(WC_RNG* rng, byte* nonce, word32 nonceSz,
 }
 
 
+#ifdef WOLFSSL_KEYGEN_THREADS
+/* Initialize child as a new generator seeded from the output of rng.
+ *
+ * When rng is a Hash DRBG the child's output is determined by the state of rng
+ * and no entropy is collected. Otherwise the child is initialized normally.
+ * Used to give each worker thread its own generator.
+ *
+ * @param [in, out] rng    Parent random number generator.
+ * @param [out]     child  Random number generator to initialize.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when rng or child is NULL.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  RNG_FAILURE_E when generating or instantiating fails.
+ */
+int wc_RNG_Fork(WC_RNG* rng, WC_RNG* child)
+{
+#if defined(HAVE_HASHDRBG) && !defined(CUSTOM_RAND_GENERATE_BLOCK) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+    int ret;
+#ifndef WOLFSSL_SMALL_STACK
+    byte seed[SEED_SZ + SEED_SZ/2];
+#else
+    byte* seed;
+#endif
+#endif
+
+    if ((rng == NULL) || (child == NULL))
+        return BAD_FUNC_ARG;
+
+#if defined(HAVE_HASHDRBG) && !defined(CUSTOM_RAND_GENERATE_BLOCK) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+    if ((rng->drbg == NULL) || (rng->status != DRBG_OK))
+        return _InitRng(child, NULL, 0, rng->heap, INVALID_DEVID);
+
+#ifdef WOLFSSL_SMALL_STACK
+    seed = (byte*)XMALLOC(SEED_SZ + SEED_SZ/2, rng->heap, DYNAMIC_TYPE_SEED);
+    if (seed == NULL)
+        return MEMORY_E;
+#endif
+
+    XMEMSET(child, 0, sizeof(WC_RNG));
+    child->heap = rng->heap;
+#if defined(WOLFSSL_ASYNC_CRYPT) || defined(WOLF_CRYPTO_CB)
+    child->devId = INVALID_DEVID;
+    #if defined(WOLF_CRYPTO_CB)
+        child->seed.devId = INVALID_DEVID;
+    #endif
+#endif
+    child->status = DRBG_NOT_INIT;
+
+    ret = wc_RNG_GenerateBlock(rng, seed, SEED_SZ + SEED_SZ/2);
+    if (ret == 0) {
+#if !defined(WOLFSSL_NO_MALLOC) || defined(WOLFSSL_STATIC_MEMORY)
+        child->drbg = (struct DRBG*)XMALLOC(sizeof(DRBG_internal),
+            child->heap, DYNAMIC_TYPE_RNG);
+        if (child->drbg == NULL)
+            ret = MEMORY_E;
+#else
+        child->drbg = (struct DRBG*)&child->drbg_data;
+#endif
+    }
+    if (ret == 0) {
+        /* First part of output is the entropy input, the rest the nonce. */
+        if (Hash_DRBG_Instantiate((DRBG_internal*)child->drbg, seed, SEED_SZ,
+                seed + SEED_SZ, SEED_SZ/2, child->heap,
+                INVALID_DEVID) != DRBG_SUCCESS) {
+        #if !defined(WOLFSSL_NO_MALLOC) || defined(WOLFSSL_STATIC_MEMORY)
+            XFREE(child->drbg, child->heap, DYNAMIC_TYPE_RNG);
+        #endif
+            child->drbg = NULL;
+            ret = RNG_FAILURE_E;
+        }
+    }
+    if (ret == 0) {
+    #ifdef WOLFSSL_CHECK_MEM_ZERO
+        struct DRBG_internal* drbg = (struct DRBG_internal*)child->drbg;
+        wc_MemZero_Add("DRBG V", &drbg->V, sizeof(drbg->V));
+        wc_MemZero_Add("DRBG C", &drbg->C, sizeof(drbg->C));
+    #endif
+        child->status = DRBG_OK;
+    }
+    else {
+        child->status = DRBG_FAILED;
+    }
+
+    ForceZero(seed, SEED_SZ + SEED_SZ/2);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(seed, rng->heap, DYNAMIC_TYPE_SEED);
+#endif
+    return ret;
+#else
+    return _InitRng(child, NULL, 0, rng->heap, INVALID_DEVID);
+#endif
+}
+#endif /* WOLFSSL_KEYGEN_THREADS */
+
+
 /* place a generated block in output */
 WOLFSSL_ABI
 int wc_RNG_GenerateBlock(WC_RNG* rng, byte* output, word32 sz)
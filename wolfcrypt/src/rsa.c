@@ -86,6 +86,10 @@ Possible RSA enable options:
  * WC_RSA_NO_FERMAT_CHECK:Don't check for small difference in       default: off
  *                        p and q (Fermat's factorization is       (not defined)
  *                        possible when small difference).
+ * WC_RSA_PREPARED:       Enables wc_RsaPrepareKey() to cache       default: off
+ *                        blinding values for private operations.
+ * WC_RSA_PREPARED_REFRESH: Private operations before a prepared    default: 32
+ *                        key generates a new blinding pair.
 */
 
 /*
@@ -542,6 +546,27 @@ int wc_RsaGetKeyId(RsaKey* key, word32* keyId)
 }
 #endif /* WOLFSSL_SE050 */
 
+#ifdef WC_RSA_PREPARED
+static void RsaPreparedFree(RsaKey* key)
+{
+    RsaPrepared* prep = key->prep;
+
+    if (prep != NULL) {
+        mp_forcezero(&prep->blindInv);
+        mp_forcezero(&prep->blind);
+    #ifndef SINGLE_THREADED
+        wc_FreeMutex(&prep->lock);
+    #endif
+    #ifdef WOLFSSL_CHECK_MEM_ZERO
+        mp_memzero_check(&prep->blind);
+        mp_memzero_check(&prep->blindInv);
+    #endif
+        XFREE(prep, key->heap, DYNAMIC_TYPE_RSA);
+        key->prep = NULL;
+    }
+}
+#endif /* WC_RSA_PREPARED */
+
 int wc_FreeRsaKey(RsaKey* key)
 {
     int ret = 0;
@@ -552,6 +577,10 @@ int wc_FreeRsaKey(RsaKey* key)
 
     wc_RsaCleanup(key);
 
+#ifdef WC_RSA_PREPARED
+    RsaPreparedFree(key);
+#endif
+
 #if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_RSA)
     wolfAsync_DevCtxFree(&key->asyncDev, WOLFSSL_ASYNC_MARKER_RSA);
 #endif
@@ -2502,6 +2531,145 @@ static int RsaFunction_SP(const byte* in, word32 inLen, byte* out,
 
 #if !defined(WOLFSSL_SP_MATH)
 #if !defined(WOLFSSL_RSA_PUBLIC_ONLY) && !defined(WOLFSSL_RSA_VERIFY_ONLY)
+#ifdef WC_RSA_PREPARED
+#ifndef WC_RSA_PREPARED_REFRESH
+    #define WC_RSA_PREPARED_REFRESH     32
+#endif
+
+/* Generate a new blinding pair for a prepared key.
+ *
+ * blind = r^e mod n and blindInv = 1/r mod n, both in Montgomery form.
+ *
+ * @param [in]      key   RSA key.
+ * @param [in, out] prep  Prepared state of key.
+ * @param [in]      rng   Random number generator.
+ * @return  0 on success.
+ * @return  MP_INVMOD_E, MP_EXPTMOD_E or MP_MULMOD_E when calculation fails.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ */
+static int RsaPreparedBlind(RsaKey* key, RsaPrepared* prep, WC_RNG* rng)
+{
+    int ret = 0;
+    DECL_MP_INT_SIZE_DYN(norm, mp_bitsused(&key->n), RSA_MAX_SIZE);
+
+    NEW_MP_INT_SIZE(norm, mp_bitsused(&key->n), key->heap, DYNAMIC_TYPE_RSA);
+#ifdef MP_INT_SIZE_CHECK_NULL
+    if (norm == NULL) {
+        return MEMORY_E;
+    }
+#endif
+
+    if (INIT_MP_INT_SIZE(norm, mp_bitsused(&key->n)) != MP_OKAY) {
+        ret = MP_INIT_E;
+    }
+
+    if (ret == 0) {
+        ret = mp_rand(&prep->blind, get_digit_count(&key->n), rng);
+    }
+    /* blindInv = 1/r mod n */
+    if ((ret == 0) && (mp_invmod(&prep->blind, &key->n, &prep->blindInv) !=
+            MP_OKAY)) {
+        ret = MP_INVMOD_E;
+    }
+    /* blind = r^e mod n */
+#ifndef WOLFSSL_SP_MATH_ALL
+    if ((ret == 0) && (mp_exptmod(&prep->blind, &key->e, &key->n,
+            &prep->blind) != MP_OKAY)) {
+        ret = MP_EXPTMOD_E;
+    }
+#else
+    if ((ret == 0) && (mp_exptmod_nct(&prep->blind, &key->e, &key->n,
+            &prep->blind) != MP_OKAY)) {
+        ret = MP_EXPTMOD_E;
+    }
+#endif
+    /* Convert both to Montgomery form. */
+    if ((ret == 0) && (mp_montgomery_calc_normalization(norm, &key->n) !=
+            MP_OKAY)) {
+        ret = MP_MULMOD_E;
+    }
+    if ((ret == 0) && (mp_mulmod(&prep->blind, norm, &key->n, &prep->blind) !=
+            MP_OKAY)) {
+        ret = MP_MULMOD_E;
+    }
+    if ((ret == 0) && (mp_mulmod(&prep->blindInv, norm, &key->n,
+            &prep->blindInv) != MP_OKAY)) {
+        ret = MP_MULMOD_E;
+    }
+    if (ret == 0) {
+        prep->uses = 0;
+    }
+
+    mp_clear(norm);
+    FREE_MP_INT_SIZE(norm, key->heap, DYNAMIC_TYPE_RSA);
+    return ret;
+}
+
+/* Get the blinding pair of a prepared key and advance to the next pair.
+ *
+ * Squaring both values gives r'^e and 1/r' for r' = r^2 without the random
+ * generation, inversion and exponentiation. A fresh pair is generated every
+ * WC_RSA_PREPARED_REFRESH operations.
+ *
+ * @param [in]  key   RSA key.
+ * @param [in]  rng   Random number generator.
+ * @param [out] rnd   r^e mod n in Montgomery form.
+ * @param [out] rndi  1/r mod n in Montgomery form.
+ * @return  0 on success.
+ * @return  BAD_MUTEX_E when locking the prepared state fails.
+ * @return  Other negative on calculation failure.
+ */
+static int RsaPreparedNext(RsaKey* key, WC_RNG* rng, mp_int* rnd,
+    mp_int* rndi)
+{
+    int ret = 0;
+    RsaPrepared* prep = key->prep;
+
+#ifndef SINGLE_THREADED
+    if (wc_LockMutex(&prep->lock) != 0) {
+        return BAD_MUTEX_E;
+    }
+#endif
+
+    if (prep->uses >= WC_RSA_PREPARED_REFRESH) {
+        ret = RsaPreparedBlind(key, prep, rng);
+    }
+    if (ret == 0) {
+        ret = mp_copy(&prep->blind, rnd);
+    }
+    if (ret == 0) {
+        ret = mp_copy(&prep->blindInv, rndi);
+    }
+    /* Montgomery squaring keeps values in Montgomery form. */
+    if ((ret == 0) && (mp_sqr(&prep->blind, &prep->blind) != MP_OKAY)) {
+        ret = MP_MULMOD_E;
+    }
+    if ((ret == 0) && (mp_montgomery_reduce_ct(&prep->blind, &key->n,
+            prep->mp) != MP_OKAY)) {
+        ret = MP_MULMOD_E;
+    }
+    if ((ret == 0) && (mp_sqr(&prep->blindInv, &prep->blindInv) != MP_OKAY)) {
+        ret = MP_MULMOD_E;
+    }
+    if ((ret == 0) && (mp_montgomery_reduce_ct(&prep->blindInv, &key->n,
+            prep->mp) != MP_OKAY)) {
+        ret = MP_MULMOD_E;
+    }
+    if (ret == 0) {
+        prep->uses++;
+    }
+    else {
+        /* Don't use a partially updated pair. */
+        prep->uses = WC_RSA_PREPARED_REFRESH;
+    }
+
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&prep->lock);
+#endif
+    return ret;
+}
+#endif /* WC_RSA_PREPARED */
+
 static int RsaFunctionPrivate(mp_int* tmp, RsaKey* key, WC_RNG* rng)
 {
     int    ret = 0;
@@ -2529,38 +2697,62 @@ static int RsaFunctionPrivate(mp_int* tmp, RsaKey* key, WC_RNG* rng)
         ret = MP_INIT_E;
     }
 
-    if (ret == 0) {
-        /* blind */
-        ret = mp_rand(rnd, get_digit_count(&key->n), rng);
-    }
-    if (ret == 0) {
-        /* rndi = 1/rnd mod n */
-        if (mp_invmod(rnd, &key->n, rndi) != MP_OKAY) {
-            ret = MP_INVMOD_E;
-        }
-    }
-    if (ret == 0) {
+#ifdef WC_RSA_PREPARED
+    if ((ret == 0) && (key->prep != NULL)) {
+        /* Cached blinding pair is already in Montgomery form. */
+        ret = RsaPreparedNext(key, rng, rnd, rndi);
     #ifdef WOLFSSL_CHECK_MEM_ZERO
-        mp_memzero_add("RSA Private rnd", rnd);
-        mp_memzero_add("RSA Private rndi", rndi);
+        if (ret == 0) {
+            mp_memzero_add("RSA Private rnd", rnd);
+            mp_memzero_add("RSA Private rndi", rndi);
+        }
     #endif
-
-        /* rnd = rnd^e */
-    #ifndef WOLFSSL_SP_MATH_ALL
-        if (mp_exptmod(rnd, &key->e, &key->n, rnd) != MP_OKAY) {
-            ret = MP_EXPTMOD_E;
+        mp = key->prep->mp;
+        /* tmp = tmp*rnd mod n */
+        if ((ret == 0) && (mp_mul(tmp, rnd, tmp) != MP_OKAY)) {
+            ret = MP_MULMOD_E;
         }
-    #else
-        if (mp_exptmod_nct(rnd, &key->e, &key->n, rnd) != MP_OKAY) {
-            ret = MP_EXPTMOD_E;
+        if ((ret == 0) && (mp_montgomery_reduce_ct(tmp, &key->n, mp) !=
+                MP_OKAY)) {
+            ret = MP_MULMOD_E;
         }
-    #endif
     }
+    else
+#endif
+    {
+        if (ret == 0) {
+            /* blind */
+            ret = mp_rand(rnd, get_digit_count(&key->n), rng);
+        }
+        if (ret == 0) {
+            /* rndi = 1/rnd mod n */
+            if (mp_invmod(rnd, &key->n, rndi) != MP_OKAY) {
+                ret = MP_INVMOD_E;
+            }
+        }
+        if (ret == 0) {
+        #ifdef WOLFSSL_CHECK_MEM_ZERO
+            mp_memzero_add("RSA Private rnd", rnd);
+            mp_memzero_add("RSA Private rndi", rndi);
+        #endif
 
-    if (ret == 0) {
-        /* tmp = tmp*rnd mod n */
-        if (mp_mulmod(tmp, rnd, &key->n, tmp) != MP_OKAY) {
-            ret = MP_MULMOD_E;
+            /* rnd = rnd^e */
+        #ifndef WOLFSSL_SP_MATH_ALL
+            if (mp_exptmod(rnd, &key->e, &key->n, rnd) != MP_OKAY) {
+                ret = MP_EXPTMOD_E;
+            }
+        #else
+            if (mp_exptmod_nct(rnd, &key->e, &key->n, rnd) != MP_OKAY) {
+                ret = MP_EXPTMOD_E;
+            }
+        #endif
+        }
+
+        if (ret == 0) {
+            /* tmp = tmp*rnd mod n */
+            if (mp_mulmod(tmp, rnd, &key->n, tmp) != MP_OKAY) {
+                ret = MP_MULMOD_E;
+            }
         }
     }
 #endif /* WC_RSA_BLINDING && !WC_NO_RNG */
@@ -2642,19 +2834,24 @@ static int RsaFunctionPrivate(mp_int* tmp, RsaKey* key, WC_RNG* rng)
     /* Multiply result (tmp) by blinding invertor (rndi).
      * Use Montgomery form to make operation more constant time.
      */
-    if ((ret == 0) && (mp_montgomery_setup(&key->n, &mp) != MP_OKAY)) {
-        ret = MP_MULMOD_E;
-    }
-    if ((ret == 0) && (mp_montgomery_calc_normalization(rnd, &key->n) !=
-            MP_OKAY)) {
-        ret = MP_MULMOD_E;
-    }
-    /* Convert blinding invert to Montgomery form. */
-    if ((ret == 0) && (mp_mul(rndi, rnd, rndi) != MP_OKAY)) {
-        ret = MP_MULMOD_E;
-    }
-    if ((ret == 0) && (mp_mod(rndi, &key->n, rndi) != MP_OKAY)) {
-        ret = MP_MULMOD_E;
+#ifdef WC_RSA_PREPARED
+    if (key->prep == NULL)
+#endif
+    {
+        if ((ret == 0) && (mp_montgomery_setup(&key->n, &mp) != MP_OKAY)) {
+            ret = MP_MULMOD_E;
+        }
+        if ((ret == 0) && (mp_montgomery_calc_normalization(rnd, &key->n) !=
+                MP_OKAY)) {
+            ret = MP_MULMOD_E;
+        }
+        /* Convert blinding invert to Montgomery form. */
+        if ((ret == 0) && (mp_mul(rndi, rnd, rndi) != MP_OKAY)) {
+            ret = MP_MULMOD_E;
+        }
+        if ((ret == 0) && (mp_mod(rndi, &key->n, rndi) != MP_OKAY)) {
+            ret = MP_MULMOD_E;
+        }
     }
     /* Multiply result by blinding invert. */
     if ((ret == 0) && (mp_mul(tmp, rndi, tmp) != MP_OKAY)) {
@@ -4701,6 +4898,151 @@ int wc_CheckProbablePrime(const byte* pRaw, word32 pRawSz,
 
 #if !defined(HAVE_FIPS) || (defined(HAVE_FIPS) && \
         defined(HAVE_FIPS_VERSION) && (HAVE_FIPS_VERSION >= 2))
+#if defined(WOLFSSL_KEYGEN_THREADS) && !defined(WOLFSSL_CRYPTOCELL) && \
+    !defined(WOLFSSL_SE050)
+/* Set the number of threads wc_MakeRsaKey() searches for primes with.
+ *
+ * @param [in, out] key      RSA key.
+ * @param [in]      threads  Number of threads. 0 or 1 for calling thread only.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key is NULL or threads is out of range.
+ */
+int wc_RsaSetKeyGenThreads(RsaKey* key, int threads)
+{
+    if ((key == NULL) || (threads < 0) ||
+            (threads > WOLFSSL_KEYGEN_MAX_THREADS)) {
+        return BAD_FUNC_ARG;
+    }
+
+    key->keyGenThreads = threads;
+
+    return 0;
+}
+
+/* Parameters of a threaded prime search for RSA key generation. */
+typedef struct RsaPrimeSearch {
+    mp_int* p;        /* First prime when searching for q, otherwise NULL */
+    mp_int* e;        /* Public exponent */
+    int     size;     /* Size of modulus in bits */
+    word32  primeSz;  /* Size of prime in bytes */
+    void*   heap;
+} RsaPrimeSearch;
+
+/* Generate a random candidate and check it is a suitable prime.
+ * Called by each thread of the prime search with its own RNG.
+ */
+static int RsaPrimeCandidate(void* ctx, int worker, word32 iter, WC_RNG* rng,
+    mp_int* cand, int* isPrime)
+{
+    RsaPrimeSearch* search = (RsaPrimeSearch*)ctx;
+    int err;
+#ifdef WOLFSSL_SMALL_STACK
+    byte* buf;
+#else
+    byte buf[RSA_MAX_SIZE / 16];
+#endif
+#ifndef WC_RSA_NO_FERMAT_CHECK
+    DECL_MP_INT_SIZE_DYN(diff, search->size / 2, RSA_MAX_SIZE / 2);
+#endif
+
+    (void)worker;
+    (void)iter;
+
+#ifdef WOLFSSL_SMALL_STACK
+    buf = (byte*)XMALLOC(search->primeSz, search->heap, DYNAMIC_TYPE_RSA);
+    if (buf == NULL)
+        return MEMORY_E;
+#endif
+
+    err = wc_RNG_GenerateBlock(rng, buf, search->primeSz);
+    if (err == 0) {
+        /* prime lower bound has the MSB set, set it in candidate */
+        buf[0] |= 0x80;
+        /* make candidate odd */
+        buf[search->primeSz - 1] |= 0x01;
+        err = mp_read_unsigned_bin(cand, buf, search->primeSz);
+    }
+    ForceZero(buf, search->primeSz);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(buf, search->heap, DYNAMIC_TYPE_RSA);
+#endif
+
+    if (err == MP_OKAY) {
+        if (search->p == NULL) {
+            err = _CheckProbablePrime(cand, NULL, search->e, search->size,
+                isPrime, rng);
+        }
+        else {
+            err = _CheckProbablePrime(search->p, cand, search->e, search->size,
+                isPrime, rng);
+        }
+    }
+
+#ifndef WC_RSA_NO_FERMAT_CHECK
+    /* See wc_MakeRsaKey() - reject q too close to p. */
+    if ((err == MP_OKAY) && *isPrime && (search->p != NULL)) {
+        NEW_MP_INT_SIZE(diff, search->size / 2, search->heap,
+            DYNAMIC_TYPE_RSA);
+    #ifdef MP_INT_SIZE_CHECK_NULL
+        if (diff == NULL)
+            err = MEMORY_E;
+    #endif
+        if ((err == MP_OKAY) &&
+                (INIT_MP_INT_SIZE(diff, search->size / 2) != MP_OKAY)) {
+            err = MP_INIT_E;
+        }
+        if (err == MP_OKAY)
+            err = mp_sub(search->p, cand, diff);
+        if ((err == MP_OKAY) &&
+                (mp_count_bits(diff) <= (search->size / 4) + 32)) {
+            *isPrime = 0;
+        }
+        mp_clear(diff);
+        FREE_MP_INT_SIZE(diff, search->heap, DYNAMIC_TYPE_RSA);
+    }
+#endif
+
+    return err;
+}
+
+/* Find the primes p and q of an RSA key using multiple threads.
+ *
+ * @param [in]      key        RSA key being generated.
+ * @param [in]      size       Size of modulus in bits.
+ * @param [in]      e          Public exponent.
+ * @param [in, out] rng        Random number generator.
+ * @param [out]     p          First prime.
+ * @param [out]     q          Second prime.
+ * @param [in]      failCount  Maximum candidates for each prime. 0 for no
+ *                             limit.
+ * @return  0 on success.
+ * @return  PRIME_GEN_E when no prime found within limit.
+ * @return  Other negative on failure.
+ */
+static int RsaMakePrimesThreads(RsaKey* key, int size, mp_int* e,
+    WC_RNG* rng, mp_int* p, mp_int* q, word32 failCount)
+{
+    int err;
+    RsaPrimeSearch search;
+
+    search.p = NULL;
+    search.e = e;
+    search.size = size;
+    search.primeSz = (word32)size / 16;
+    search.heap = key->heap;
+
+    err = wc_PrimeSearchThreads(RsaPrimeCandidate, &search,
+        key->keyGenThreads, failCount, rng, p, NULL, NULL, key->heap);
+    if (err == 0) {
+        search.p = p;
+        err = wc_PrimeSearchThreads(RsaPrimeCandidate, &search,
+            key->keyGenThreads, failCount, rng, q, NULL, NULL, key->heap);
+    }
+
+    return err;
+}
+#endif /* WOLFSSL_KEYGEN_THREADS && !WOLFSSL_CRYPTOCELL && !WOLFSSL_SE050 */
+
 /* Make an RSA key for size bits, with e specified, 65537 is a good e */
 int wc_MakeRsaKey(RsaKey* key, int size, long e, WC_RNG* rng)
 {
@@ -4722,6 +5064,11 @@ int wc_MakeRsaKey(RsaKey* key, int size, long e, WC_RNG* rng)
     int i, failCount, isPrime = 0;
     word32 primeSz;
     byte* buf = NULL;
+#ifdef WOLFSSL_KEYGEN_THREADS
+    int primesFound = 0;
+#else
+    const int primesFound = 0;
+#endif
 #endif /* !WOLFSSL_CRYPTOCELL && !WOLFSSL_SE050 */
     int err;
 
@@ -4836,8 +5183,22 @@ int wc_MakeRsaKey(RsaKey* key, int size, long e, WC_RNG* rng)
 
     SAVE_VECTOR_REGISTERS(err = _svr_ret;);
 
+#ifdef WOLFSSL_KEYGEN_THREADS
+    if ((err == MP_OKAY) && (key->keyGenThreads > 1)) {
+    #ifdef HAVE_FIPS
+        err = RsaMakePrimesThreads(key, size, tmp3, rng, p, q,
+            (word32)failCount);
+    #else
+        err = RsaMakePrimesThreads(key, size, tmp3, rng, p, q, 0);
+    #endif
+        /* p and q have been found - skip the single threaded search. */
+        primesFound = 1;
+        isPrime = 1;
+    }
+#endif
+
     /* make p */
-    if (err == MP_OKAY) {
+    if ((err == MP_OKAY) && !primesFound) {
     #ifdef WOLFSSL_CHECK_MEM_ZERO
         wc_MemZero_Add("RSA gen buf", buf, primeSz);
         mp_memzero_add("RSA gen p", p);
@@ -4886,7 +5247,7 @@ int wc_MakeRsaKey(RsaKey* key, int size, long e, WC_RNG* rng)
         err = PRIME_GEN_E;
 
     /* make q */
-    if (err == MP_OKAY) {
+    if ((err == MP_OKAY) && !primesFound) {
         isPrime = 0;
         i = 0;
         do {
@@ -5126,6 +5487,72 @@ int wc_RsaSetRNG(RsaKey* key, WC_RNG* rng)
 }
 #endif /* WC_RSA_BLINDING */
 
+#ifdef WC_RSA_PREPARED
+/* Prepare a private key for repeated private key operations.
+ *
+ * Caches the Montgomery multiplier of n and a blinding pair. Each private
+ * operation then advances the pair by squaring instead of generating,
+ * inverting and exponentiating a new random value.
+ * The key must not be changed after being prepared - call again to re-prepare.
+ *
+ * @param [in, out] key  RSA private key.
+ * @param [in]      rng  Random number generator.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key or rng is NULL or key is not private.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  Other negative on calculation failure.
+ */
+int wc_RsaPrepareKey(RsaKey* key, WC_RNG* rng)
+{
+    int ret = 0;
+    RsaPrepared* prep;
+
+    if ((key == NULL) || (rng == NULL) || (key->type != RSA_PRIVATE)) {
+        return BAD_FUNC_ARG;
+    }
+
+    RsaPreparedFree(key);
+
+    prep = (RsaPrepared*)XMALLOC(sizeof(RsaPrepared), key->heap,
+        DYNAMIC_TYPE_RSA);
+    if (prep == NULL) {
+        return MEMORY_E;
+    }
+    XMEMSET(prep, 0, sizeof(RsaPrepared));
+
+    if (mp_init_multi(&prep->blind, &prep->blindInv, NULL, NULL, NULL,
+            NULL) != MP_OKAY) {
+        XFREE(prep, key->heap, DYNAMIC_TYPE_RSA);
+        return MP_INIT_E;
+    }
+#ifndef SINGLE_THREADED
+    if (wc_InitMutex(&prep->lock) != 0) {
+        mp_clear(&prep->blind);
+        mp_clear(&prep->blindInv);
+        XFREE(prep, key->heap, DYNAMIC_TYPE_RSA);
+        return BAD_MUTEX_E;
+    }
+#endif
+#ifdef WOLFSSL_CHECK_MEM_ZERO
+    mp_memzero_add("RSA Prepared blind", &prep->blind);
+    mp_memzero_add("RSA Prepared blindInv", &prep->blindInv);
+#endif
+    key->prep = prep;
+
+    if (mp_montgomery_setup(&key->n, &prep->mp) != MP_OKAY) {
+        ret = MP_MULMOD_E;
+    }
+    if (ret == 0) {
+        ret = RsaPreparedBlind(key, prep, rng);
+    }
+
+    if (ret != 0) {
+        RsaPreparedFree(key);
+    }
+    return ret;
+}
+#endif /* WC_RSA_PREPARED */
+
 #ifdef WC_RSA_NONBLOCK
 int wc_RsaSetNonBlock(RsaKey* key, RsaNb* nb)
 {
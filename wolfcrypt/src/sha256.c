@@ -55,6 +55,8 @@ on the specific device platform.
                                 optimize and recognize as SHA256 (default OFF)
  * SHA256_MANY_REGISTERS:      A SHA256 version that keeps all data in registers
                                 and partial unrolled (default OFF)
+ * WOLFSSL_SHA256_MB:          Multi-buffer API that hashes independent messages
+                                in parallel SIMD lanes (default OFF)
  */
 
 /* Default SHA256 to use Ch/Maj based on specification */
@@ -1061,6 +1063,438 @@ static int InitSha256(wc_Sha256* sha256)
 /* End wc_ software implementation */
 
 
+#if defined(WOLFSSL_SHA256_MB) && defined(NEED_SOFT_SHA256)
+/* Multi-buffer SHA-256.
+ *
+ * Each lane hashes its own message. The state of all lanes is kept
+ * interleaved - word i of lane l is digest[i][l] - so that one block of every
+ * lane is hashed at once with SIMD instructions.
+ * The last partial block and padding of each message is built in the lane
+ * at submit so the kernels only ever see whole blocks.
+ * Without SIMD lanes there is one lane and each message is hashed at submit
+ * with the single buffer implementation.
+ */
+
+#if defined(WOLFSSL_X86_64_BUILD) && defined(USE_INTEL_SPEEDUP) && \
+    defined(HAVE_INTEL_AVX2) && \
+    ((defined(__GNUC__) && __GNUC__ >= 5) || defined(__clang__))
+    #include <immintrin.h>
+    #define WC_SHA256_MB_AVX
+#endif
+
+#ifdef WC_SHA256_MB_AVX
+static const word32 sha256MbH0[WC_SHA256_DIGEST_SIZE / sizeof(word32)] = {
+    0x6A09E667L, 0xBB67AE85L, 0x3C6EF372L, 0xA54FF53AL,
+    0x510E527FL, 0x9B05688CL, 0x1F83D9ABL, 0x5BE0CD19L
+};
+
+/* Data hashed by lanes without a message. */
+static const byte sha256MbZero[WC_SHA256_BLOCK_SIZE] = { 0 };
+
+#define MB8_ROTR(x, n)                                                     \
+    _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define MB8_XOR3(x, y, z)                                                  \
+    _mm256_xor_si256(_mm256_xor_si256(x, y), z)
+#define MB8_ADD3(x, y, z)                                                  \
+    _mm256_add_epi32(_mm256_add_epi32(x, y), z)
+#define MB8_SIGMA0(x)   MB8_XOR3(MB8_ROTR(x, 2), MB8_ROTR(x, 13), MB8_ROTR(x, 22))
+#define MB8_SIGMA1(x)   MB8_XOR3(MB8_ROTR(x, 6), MB8_ROTR(x, 11), MB8_ROTR(x, 25))
+#define MB8_GAMMA0(x)   MB8_XOR3(MB8_ROTR(x, 7), MB8_ROTR(x, 18),           \
+                                 _mm256_srli_epi32(x, 3))
+#define MB8_GAMMA1(x)   MB8_XOR3(MB8_ROTR(x, 17), MB8_ROTR(x, 19),          \
+                                 _mm256_srli_epi32(x, 10))
+#define MB8_CH(x, y, z)                                                    \
+    _mm256_xor_si256(_mm256_and_si256(_mm256_xor_si256(y, z), x), z)
+#define MB8_MAJ(x, y, z)                                                   \
+    _mm256_xor_si256(_mm256_and_si256(_mm256_xor_si256(x, y),              \
+                                      _mm256_xor_si256(y, z)), y)
+
+/* Load 8 big-endian words from each of 8 lanes - w[i] has word i of all the
+ * lanes.
+ */
+static WC_INLINE __attribute__((target("avx2")))
+void Sha256MbLoad8(__m256i* w, const byte* const* data, int off)
+{
+    const __m256i flip = _mm256_set_epi8(
+        12, 13, 14, 15,  8,  9, 10, 11,  4,  5,  6,  7,  0,  1,  2,  3,
+        12, 13, 14, 15,  8,  9, 10, 11,  4,  5,  6,  7,  0,  1,  2,  3);
+    __m256i r0, r1, r2, r3, r4, r5, r6, r7;
+    __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+
+    r0 = _mm256_loadu_si256((const __m256i*)(data[0] + off));
+    r1 = _mm256_loadu_si256((const __m256i*)(data[1] + off));
+    r2 = _mm256_loadu_si256((const __m256i*)(data[2] + off));
+    r3 = _mm256_loadu_si256((const __m256i*)(data[3] + off));
+    r4 = _mm256_loadu_si256((const __m256i*)(data[4] + off));
+    r5 = _mm256_loadu_si256((const __m256i*)(data[5] + off));
+    r6 = _mm256_loadu_si256((const __m256i*)(data[6] + off));
+    r7 = _mm256_loadu_si256((const __m256i*)(data[7] + off));
+
+    /* 8x8 transpose of 32-bit words */
+    t0 = _mm256_unpacklo_epi32(r0, r1);
+    t1 = _mm256_unpackhi_epi32(r0, r1);
+    t2 = _mm256_unpacklo_epi32(r2, r3);
+    t3 = _mm256_unpackhi_epi32(r2, r3);
+    t4 = _mm256_unpacklo_epi32(r4, r5);
+    t5 = _mm256_unpackhi_epi32(r4, r5);
+    t6 = _mm256_unpacklo_epi32(r6, r7);
+    t7 = _mm256_unpackhi_epi32(r6, r7);
+    r0 = _mm256_unpacklo_epi64(t0, t2);
+    r1 = _mm256_unpackhi_epi64(t0, t2);
+    r2 = _mm256_unpacklo_epi64(t1, t3);
+    r3 = _mm256_unpackhi_epi64(t1, t3);
+    r4 = _mm256_unpacklo_epi64(t4, t6);
+    r5 = _mm256_unpackhi_epi64(t4, t6);
+    r6 = _mm256_unpacklo_epi64(t5, t7);
+    r7 = _mm256_unpackhi_epi64(t5, t7);
+    w[0] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r0, r4, 0x20), flip);
+    w[1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r1, r5, 0x20), flip);
+    w[2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r2, r6, 0x20), flip);
+    w[3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r3, r7, 0x20), flip);
+    w[4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r0, r4, 0x31), flip);
+    w[5] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r1, r5, 0x31), flip);
+    w[6] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r2, r6, 0x31), flip);
+    w[7] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r3, r7, 0x31), flip);
+}
+
+#define MB8_SCHED(j)                                                       \
+    W[j] = _mm256_add_epi32(MB8_ADD3(W[j], MB8_GAMMA1(W[((j) + 14) & 15]),  \
+                                     W[((j) + 9) & 15]),                   \
+                            MB8_GAMMA0(W[((j) + 1) & 15]))
+#define MB8_RND(s0, s1, s2, s3, s4, s5, s6, s7, j)                         \
+    t0 = _mm256_add_epi32(MB8_ADD3(s7, MB8_SIGMA1(s4), MB8_CH(s4, s5, s6)), \
+             _mm256_add_epi32(_mm256_set1_epi32((int)K[i + (j)]), W[j]));  \
+    t1 = _mm256_add_epi32(MB8_SIGMA0(s0), MB8_MAJ(s0, s1, s2));            \
+    s3 = _mm256_add_epi32(s3, t0);                                         \
+    s7 = _mm256_add_epi32(t0, t1)
+
+/* Hash one block in each of the first 8 lanes with AVX2. */
+static __attribute__((target("avx2")))
+void Sha256MbBlock_AVX2(word32 (*digest)[WC_SHA256_MB_MAX_LANES],
+                        const byte* const* data)
+{
+    __m256i W[16];
+    __m256i s0, s1, s2, s3, s4, s5, s6, s7;
+    __m256i t0, t1;
+    int i;
+
+    Sha256MbLoad8(W, data, 0);
+    Sha256MbLoad8(W + 8, data, 32);
+    s0 = _mm256_loadu_si256((const __m256i*)digest[0]);
+    s1 = _mm256_loadu_si256((const __m256i*)digest[1]);
+    s2 = _mm256_loadu_si256((const __m256i*)digest[2]);
+    s3 = _mm256_loadu_si256((const __m256i*)digest[3]);
+    s4 = _mm256_loadu_si256((const __m256i*)digest[4]);
+    s5 = _mm256_loadu_si256((const __m256i*)digest[5]);
+    s6 = _mm256_loadu_si256((const __m256i*)digest[6]);
+    s7 = _mm256_loadu_si256((const __m256i*)digest[7]);
+
+    for (i = 0; i < WC_SHA256_BLOCK_SIZE; i += 16) {
+        if (i > 0) {
+            MB8_SCHED( 0); MB8_SCHED( 1); MB8_SCHED( 2); MB8_SCHED( 3);
+            MB8_SCHED( 4); MB8_SCHED( 5); MB8_SCHED( 6); MB8_SCHED( 7);
+            MB8_SCHED( 8); MB8_SCHED( 9); MB8_SCHED(10); MB8_SCHED(11);
+            MB8_SCHED(12); MB8_SCHED(13); MB8_SCHED(14); MB8_SCHED(15);
+        }
+        MB8_RND(s0, s1, s2, s3, s4, s5, s6, s7,  0);
+        MB8_RND(s7, s0, s1, s2, s3, s4, s5, s6,  1);
+        MB8_RND(s6, s7, s0, s1, s2, s3, s4, s5,  2);
+        MB8_RND(s5, s6, s7, s0, s1, s2, s3, s4,  3);
+        MB8_RND(s4, s5, s6, s7, s0, s1, s2, s3,  4);
+        MB8_RND(s3, s4, s5, s6, s7, s0, s1, s2,  5);
+        MB8_RND(s2, s3, s4, s5, s6, s7, s0, s1,  6);
+        MB8_RND(s1, s2, s3, s4, s5, s6, s7, s0,  7);
+        MB8_RND(s0, s1, s2, s3, s4, s5, s6, s7,  8);
+        MB8_RND(s7, s0, s1, s2, s3, s4, s5, s6,  9);
+        MB8_RND(s6, s7, s0, s1, s2, s3, s4, s5, 10);
+        MB8_RND(s5, s6, s7, s0, s1, s2, s3, s4, 11);
+        MB8_RND(s4, s5, s6, s7, s0, s1, s2, s3, 12);
+        MB8_RND(s3, s4, s5, s6, s7, s0, s1, s2, 13);
+        MB8_RND(s2, s3, s4, s5, s6, s7, s0, s1, 14);
+        MB8_RND(s1, s2, s3, s4, s5, s6, s7, s0, 15);
+    }
+
+#define MB8_STORE(i, v)                                                    \
+    _mm256_storeu_si256((__m256i*)digest[i], _mm256_add_epi32(v,           \
+        _mm256_loadu_si256((const __m256i*)digest[i])))
+    MB8_STORE(0, s0); MB8_STORE(1, s1); MB8_STORE(2, s2); MB8_STORE(3, s3);
+    MB8_STORE(4, s4); MB8_STORE(5, s5); MB8_STORE(6, s6); MB8_STORE(7, s7);
+#undef MB8_STORE
+}
+
+#define MB16_XOR3(x, y, z)      _mm512_ternarylogic_epi32(x, y, z, 0x96)
+#define MB16_ADD3(x, y, z)                                                 \
+    _mm512_add_epi32(_mm512_add_epi32(x, y), z)
+#define MB16_SIGMA0(x)                                                     \
+    MB16_XOR3(_mm512_ror_epi32(x, 2), _mm512_ror_epi32(x, 13),             \
+              _mm512_ror_epi32(x, 22))
+#define MB16_SIGMA1(x)                                                     \
+    MB16_XOR3(_mm512_ror_epi32(x, 6), _mm512_ror_epi32(x, 11),             \
+              _mm512_ror_epi32(x, 25))
+#define MB16_GAMMA0(x)                                                     \
+    MB16_XOR3(_mm512_ror_epi32(x, 7), _mm512_ror_epi32(x, 18),             \
+              _mm512_srli_epi32(x, 3))
+#define MB16_GAMMA1(x)                                                     \
+    MB16_XOR3(_mm512_ror_epi32(x, 17), _mm512_ror_epi32(x, 19),            \
+              _mm512_srli_epi32(x, 10))
+#define MB16_CH(x, y, z)        _mm512_ternarylogic_epi32(x, y, z, 0xca)
+#define MB16_MAJ(x, y, z)       _mm512_ternarylogic_epi32(x, y, z, 0xe8)
+
+#define MB16_SCHED(j)                                                      \
+    W[j] = _mm512_add_epi32(MB16_ADD3(W[j], MB16_GAMMA1(W[((j) + 14) & 15]),\
+                                      W[((j) + 9) & 15]),                  \
+                            MB16_GAMMA0(W[((j) + 1) & 15]))
+#define MB16_RND(s0, s1, s2, s3, s4, s5, s6, s7, j)                        \
+    t0 = _mm512_add_epi32(MB16_ADD3(s7, MB16_SIGMA1(s4),                   \
+                                    MB16_CH(s4, s5, s6)),                  \
+             _mm512_add_epi32(_mm512_set1_epi32((int)K[i + (j)]), W[j]));  \
+    t1 = _mm512_add_epi32(MB16_SIGMA0(s0), MB16_MAJ(s0, s1, s2));          \
+    s3 = _mm512_add_epi32(s3, t0);                                         \
+    s7 = _mm512_add_epi32(t0, t1)
+
+/* Hash one block in each of the 16 lanes with AVX-512. */
+static __attribute__((target("avx512f")))
+void Sha256MbBlock_AVX512(word32 (*digest)[WC_SHA256_MB_MAX_LANES],
+                          const byte* const* data)
+{
+    __m512i W[16];
+    __m512i s0, s1, s2, s3, s4, s5, s6, s7;
+    __m512i t0, t1;
+    __m256i lo[8];
+    __m256i hi[8];
+    int i, j;
+
+    for (j = 0; j < 2; j++) {
+        Sha256MbLoad8(lo, data, j * 32);
+        Sha256MbLoad8(hi, data + 8, j * 32);
+        for (i = 0; i < 8; i++) {
+            W[j * 8 + i] = _mm512_inserti64x4(_mm512_castsi256_si512(lo[i]),
+                                              hi[i], 1);
+        }
+    }
+    s0 = _mm512_loadu_si512((const void*)digest[0]);
+    s1 = _mm512_loadu_si512((const void*)digest[1]);
+    s2 = _mm512_loadu_si512((const void*)digest[2]);
+    s3 = _mm512_loadu_si512((const void*)digest[3]);
+    s4 = _mm512_loadu_si512((const void*)digest[4]);
+    s5 = _mm512_loadu_si512((const void*)digest[5]);
+    s6 = _mm512_loadu_si512((const void*)digest[6]);
+    s7 = _mm512_loadu_si512((const void*)digest[7]);
+
+    for (i = 0; i < WC_SHA256_BLOCK_SIZE; i += 16) {
+        if (i > 0) {
+            MB16_SCHED( 0); MB16_SCHED( 1); MB16_SCHED( 2); MB16_SCHED( 3);
+            MB16_SCHED( 4); MB16_SCHED( 5); MB16_SCHED( 6); MB16_SCHED( 7);
+            MB16_SCHED( 8); MB16_SCHED( 9); MB16_SCHED(10); MB16_SCHED(11);
+            MB16_SCHED(12); MB16_SCHED(13); MB16_SCHED(14); MB16_SCHED(15);
+        }
+        MB16_RND(s0, s1, s2, s3, s4, s5, s6, s7,  0);
+        MB16_RND(s7, s0, s1, s2, s3, s4, s5, s6,  1);
+        MB16_RND(s6, s7, s0, s1, s2, s3, s4, s5,  2);
+        MB16_RND(s5, s6, s7, s0, s1, s2, s3, s4,  3);
+        MB16_RND(s4, s5, s6, s7, s0, s1, s2, s3,  4);
+        MB16_RND(s3, s4, s5, s6, s7, s0, s1, s2,  5);
+        MB16_RND(s2, s3, s4, s5, s6, s7, s0, s1,  6);
+        MB16_RND(s1, s2, s3, s4, s5, s6, s7, s0,  7);
+        MB16_RND(s0, s1, s2, s3, s4, s5, s6, s7,  8);
+        MB16_RND(s7, s0, s1, s2, s3, s4, s5, s6,  9);
+        MB16_RND(s6, s7, s0, s1, s2, s3, s4, s5, 10);
+        MB16_RND(s5, s6, s7, s0, s1, s2, s3, s4, 11);
+        MB16_RND(s4, s5, s6, s7, s0, s1, s2, s3, 12);
+        MB16_RND(s3, s4, s5, s6, s7, s0, s1, s2, 13);
+        MB16_RND(s2, s3, s4, s5, s6, s7, s0, s1, 14);
+        MB16_RND(s1, s2, s3, s4, s5, s6, s7, s0, 15);
+    }
+
+#define MB16_STORE(i, v)                                                   \
+    _mm512_storeu_si512((void*)digest[i], _mm512_add_epi32(v,              \
+        _mm512_loadu_si512((const void*)digest[i])))
+    MB16_STORE(0, s0); MB16_STORE(1, s1); MB16_STORE(2, s2);
+    MB16_STORE(3, s3); MB16_STORE(4, s4); MB16_STORE(5, s5);
+    MB16_STORE(6, s6); MB16_STORE(7, s7);
+#undef MB16_STORE
+}
+
+/* Hash one block in every lane. */
+static void Sha256MbBlock(wc_Sha256_MB* mb, const byte* const* data)
+{
+    if (mb->lanes == 16)
+        Sha256MbBlock_AVX512(mb->digest, data);
+    else
+        Sha256MbBlock_AVX2(mb->digest, data);
+}
+
+/* Hash blocks in all the busy lanes until the lane with the least data left
+ * finishes its message or moves on to the padding.
+ */
+static void Sha256MbRun(wc_Sha256_MB* mb)
+{
+    const byte* p[WC_SHA256_MB_MAX_LANES];
+    word32 n = 0;
+    word32 i;
+    word32 l;
+
+    for (l = 0; l < mb->lanes; l++) {
+        if ((mb->busy & (1U << l)) && (n == 0 || mb->lane[l].blocks < n))
+            n = mb->lane[l].blocks;
+    }
+
+    for (i = 0; i < n; i++) {
+        for (l = 0; l < mb->lanes; l++) {
+            p[l] = (mb->busy & (1U << l)) ?
+                mb->lane[l].data + i * WC_SHA256_BLOCK_SIZE : sha256MbZero;
+        }
+        Sha256MbBlock(mb, p);
+    }
+
+    for (l = 0; l < mb->lanes; l++) {
+        wc_Sha256_MB_Lane* lane = &mb->lane[l];
+
+        if ((mb->busy & (1U << l)) == 0)
+            continue;
+
+        lane->data += n * WC_SHA256_BLOCK_SIZE;
+        lane->blocks -= n;
+        if (lane->blocks > 0)
+            continue;
+
+        if (lane->padBlocks > 0) {
+            lane->data = lane->pad;
+            lane->blocks = lane->padBlocks;
+            lane->padBlocks = 0;
+        }
+        else {
+            for (i = 0; i < WC_SHA256_DIGEST_SIZE / sizeof(word32); i++)
+                c32toa(mb->digest[i][l], lane->hash + i * sizeof(word32));
+            ForceZero(lane->pad, sizeof(lane->pad));
+            mb->busy &= ~(1U << l);
+        }
+    }
+}
+#endif /* WC_SHA256_MB_AVX */
+
+int wc_Sha256_MB_Init(wc_Sha256_MB* mb, void* heap, int devId)
+{
+#ifdef WC_SHA256_MB_AVX
+    word32 flags;
+#endif
+
+    if (mb == NULL)
+        return BAD_FUNC_ARG;
+
+    XMEMSET(mb, 0, sizeof(*mb));
+    mb->heap = heap;
+    mb->devId = devId;
+    /* Without SIMD lanes each message is hashed on its own, the single
+     * buffer transforms are faster than interleaving in C. */
+    mb->lanes = 1;
+#ifdef WC_SHA256_MB_AVX
+    flags = cpuid_get_flags();
+    if (IS_INTEL_AVX512(flags))
+        mb->lanes = 16;
+    else if (IS_INTEL_AVX2(flags))
+        mb->lanes = 8;
+#endif
+
+    return 0;
+}
+
+int wc_Sha256_MB_Lanes(wc_Sha256_MB* mb)
+{
+    if (mb == NULL)
+        return BAD_FUNC_ARG;
+
+    return (int)mb->lanes;
+}
+
+int wc_Sha256_MB_Submit(wc_Sha256_MB* mb, const byte* data, word32 len,
+                        byte* hash)
+{
+#ifdef WC_SHA256_MB_AVX
+    wc_Sha256_MB_Lane* lane;
+    word32 full;
+    word32 rem;
+    word32 padLen;
+    word32 i;
+    word32 l;
+#endif
+
+    if (mb == NULL || hash == NULL || (data == NULL && len > 0))
+        return BAD_FUNC_ARG;
+
+    if (mb->lanes == 1)
+        return wc_Sha256Hash_ex(data, len, hash, mb->heap, mb->devId);
+
+#ifdef WC_SHA256_MB_AVX
+
+    /* a lane is always free - a full set of lanes is run at once */
+    for (l = 0; l < mb->lanes; l++) {
+        if ((mb->busy & (1U << l)) == 0)
+            break;
+    }
+    if (l == mb->lanes)
+        return BAD_STATE_E;
+    lane = &mb->lane[l];
+
+    full = len / WC_SHA256_BLOCK_SIZE;
+    rem = len % WC_SHA256_BLOCK_SIZE;
+    padLen = (rem < WC_SHA256_PAD_SIZE) ? WC_SHA256_BLOCK_SIZE :
+                                          2 * WC_SHA256_BLOCK_SIZE;
+
+    /* last partial block, 1 bit, zeros and length in bits */
+    if (rem > 0)
+        XMEMCPY(lane->pad, data + full * WC_SHA256_BLOCK_SIZE, rem);
+    lane->pad[rem] = 0x80;
+    XMEMSET(lane->pad + rem + 1, 0, padLen - rem - 1 - 2 * sizeof(word32));
+    c32toa(len >> 29, lane->pad + padLen - 2 * sizeof(word32));
+    c32toa(len << 3, lane->pad + padLen - sizeof(word32));
+
+    if (full > 0) {
+        lane->data = data;
+        lane->blocks = full;
+        lane->padBlocks = padLen / WC_SHA256_BLOCK_SIZE;
+    }
+    else {
+        lane->data = lane->pad;
+        lane->blocks = padLen / WC_SHA256_BLOCK_SIZE;
+        lane->padBlocks = 0;
+    }
+    lane->hash = hash;
+    for (i = 0; i < WC_SHA256_DIGEST_SIZE / sizeof(word32); i++)
+        mb->digest[i][l] = sha256MbH0[i];
+    mb->busy |= 1U << l;
+
+    /* all lanes have a message - hash until one is free again */
+    while (mb->busy == (1U << mb->lanes) - 1)
+        Sha256MbRun(mb);
+#endif
+
+    return 0;
+}
+
+int wc_Sha256_MB_Flush(wc_Sha256_MB* mb)
+{
+    if (mb == NULL)
+        return BAD_FUNC_ARG;
+
+#ifdef WC_SHA256_MB_AVX
+    while (mb->busy != 0)
+        Sha256MbRun(mb);
+#endif
+
+    return 0;
+}
+
+void wc_Sha256_MB_Free(wc_Sha256_MB* mb)
+{
+    if (mb == NULL)
+        return;
+
+    ForceZero(mb, sizeof(*mb));
+}
+#endif /* WOLFSSL_SHA256_MB && NEED_SOFT_SHA256 */
+
+
 #ifdef XTRANSFORM
 
     static WC_INLINE void AddLength(wc_Sha256* sha256, word32 len)
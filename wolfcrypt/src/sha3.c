@@ -42,6 +42,7 @@
 #include <wolfssl/wolfcrypt/sha3.h>
 #include <wolfssl/wolfcrypt/error-crypt.h>
 #include <wolfssl/wolfcrypt/hash.h>
+#include <wolfssl/wolfcrypt/cpuid.h>
 
 #ifdef NO_INLINE
     #include <wolfssl/wolfcrypt/misc.h>
@@ -54,8 +55,6 @@
 #if !defined(WOLFSSL_ARMASM) || !defined(WOLFSSL_ARMASM_CRYPTO_SHA3)
 
 #ifdef USE_INTEL_SPEEDUP
-    #include <wolfssl/wolfcrypt/cpuid.h>
-
     word32 cpuid_flags;
     int cpuid_flags_set = 0;
     void (*sha3_block)(word64 *s) = NULL;
@@ -594,6 +593,28 @@ static word64 Load64BitBigEndian(const byte* a)
 #endif
 }
 
+#ifdef USE_INTEL_SPEEDUP
+/* Choose the block functions to use based on the CPU's features.
+ */
+static void Sha3SetBlockFuncs(void)
+{
+    if (!cpuid_flags_set) {
+        cpuid_flags = cpuid_get_flags();
+        cpuid_flags_set = 1;
+        if (IS_INTEL_BMI1(cpuid_flags) && IS_INTEL_BMI2(cpuid_flags)) {
+            sha3_block = sha3_block_bmi2;
+            sha3_block_n = sha3_block_n_bmi2;
+        }
+        else if (IS_INTEL_AVX2(cpuid_flags)) {
+            sha3_block = sha3_block_avx2;
+        }
+        else {
+            sha3_block = BlockSha3;
+        }
+    }
+}
+#endif
+
 /* Initialize the state for a SHA3-224 hash operation.
  *
  * sha3   wc_Sha3 object holding state.
@@ -611,20 +632,7 @@ static int InitSha3(wc_Sha3* sha3)
 #endif
 
 #ifdef USE_INTEL_SPEEDUP
-    if (!cpuid_flags_set) {
-        cpuid_flags = cpuid_get_flags();
-        cpuid_flags_set = 1;
-        if (IS_INTEL_BMI1(cpuid_flags) && IS_INTEL_BMI2(cpuid_flags)) {
-            sha3_block = sha3_block_bmi2;
-            sha3_block_n = sha3_block_n_bmi2;
-        }
-        else if (IS_INTEL_AVX2(cpuid_flags)) {
-            sha3_block = sha3_block_avx2;
-        }
-        else {
-            sha3_block = BlockSha3;
-        }
-    }
+    Sha3SetBlockFuncs();
 #endif
 
     return 0;
@@ -1490,4 +1498,375 @@ int wc_Shake256_Copy(wc_Shake* src, wc_Shake* dst)
 }
 #endif
 
+#if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
+
+#if defined(WOLFSSL_X86_64_BUILD) && defined(HAVE_CPUID_INTEL) && \
+    !defined(WOLFSSL_LINUXKM) && \
+    ((defined(__GNUC__) && (__GNUC__ >= 5)) || defined(__clang__))
+    /* Permute four interleaved states at once with AVX2. */
+    #define WC_SHA3_X4_AVX2
+    #include <immintrin.h>
+#endif
+
+#ifdef WC_SHA3_X4_AVX2
+#define X4_ROTL(a, n)                                                   \
+    _mm256_or_si256(_mm256_slli_epi64(a, n), _mm256_srli_epi64(a, 64 - (n)))
+#define X4_XOR5(a, b, c, d, e)                                          \
+    _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a, b),           \
+                                      _mm256_xor_si256(c, d)), e)
+
+/* Perform the Keccak-f[1600] permutation on four interleaved states.
+ *
+ * st  Four states. Word i of state j is at st[4 * i + j].
+ */
+static __attribute__((target("avx2")))
+void BlockSha3_x4_avx2(word64* st)
+{
+    __m256i s[25];
+    __m256i b[25];
+    __m256i c0, c1, c2, c3, c4;
+    __m256i d0, d1, d2, d3, d4;
+    int i;
+
+    for (i = 0; i < 25; i++) {
+        s[i] = _mm256_loadu_si256((const __m256i*)(st + 4 * i));
+    }
+    for (i = 0; i < 24; i++) {
+        c0 = X4_XOR5(s[0], s[5], s[10], s[15], s[20]);
+        c1 = X4_XOR5(s[1], s[6], s[11], s[16], s[21]);
+        c2 = X4_XOR5(s[2], s[7], s[12], s[17], s[22]);
+        c3 = X4_XOR5(s[3], s[8], s[13], s[18], s[23]);
+        c4 = X4_XOR5(s[4], s[9], s[14], s[19], s[24]);
+        d0 = _mm256_xor_si256(c4, X4_ROTL(c1, 1));
+        d1 = _mm256_xor_si256(c0, X4_ROTL(c2, 1));
+        d2 = _mm256_xor_si256(c1, X4_ROTL(c3, 1));
+        d3 = _mm256_xor_si256(c2, X4_ROTL(c4, 1));
+        d4 = _mm256_xor_si256(c3, X4_ROTL(c0, 1));
+        b[0] = _mm256_xor_si256(s[0], d0);
+        b[1] = X4_ROTL(_mm256_xor_si256(s[6], d1), 44);
+        b[2] = X4_ROTL(_mm256_xor_si256(s[12], d2), 43);
+        b[3] = X4_ROTL(_mm256_xor_si256(s[18], d3), 21);
+        b[4] = X4_ROTL(_mm256_xor_si256(s[24], d4), 14);
+        b[5] = X4_ROTL(_mm256_xor_si256(s[3], d3), 28);
+        b[6] = X4_ROTL(_mm256_xor_si256(s[9], d4), 20);
+        b[7] = X4_ROTL(_mm256_xor_si256(s[10], d0), 3);
+        b[8] = X4_ROTL(_mm256_xor_si256(s[16], d1), 45);
+        b[9] = X4_ROTL(_mm256_xor_si256(s[22], d2), 61);
+        b[10] = X4_ROTL(_mm256_xor_si256(s[1], d1), 1);
+        b[11] = X4_ROTL(_mm256_xor_si256(s[7], d2), 6);
+        b[12] = X4_ROTL(_mm256_xor_si256(s[13], d3), 25);
+        b[13] = X4_ROTL(_mm256_xor_si256(s[19], d4), 8);
+        b[14] = X4_ROTL(_mm256_xor_si256(s[20], d0), 18);
+        b[15] = X4_ROTL(_mm256_xor_si256(s[4], d4), 27);
+        b[16] = X4_ROTL(_mm256_xor_si256(s[5], d0), 36);
+        b[17] = X4_ROTL(_mm256_xor_si256(s[11], d1), 10);
+        b[18] = X4_ROTL(_mm256_xor_si256(s[17], d2), 15);
+        b[19] = X4_ROTL(_mm256_xor_si256(s[23], d3), 56);
+        b[20] = X4_ROTL(_mm256_xor_si256(s[2], d2), 62);
+        b[21] = X4_ROTL(_mm256_xor_si256(s[8], d3), 55);
+        b[22] = X4_ROTL(_mm256_xor_si256(s[14], d4), 39);
+        b[23] = X4_ROTL(_mm256_xor_si256(s[15], d0), 41);
+        b[24] = X4_ROTL(_mm256_xor_si256(s[21], d1), 2);
+        s[0] = _mm256_xor_si256(b[0], _mm256_andnot_si256(b[1], b[2]));
+        s[1] = _mm256_xor_si256(b[1], _mm256_andnot_si256(b[2], b[3]));
+        s[2] = _mm256_xor_si256(b[2], _mm256_andnot_si256(b[3], b[4]));
+        s[3] = _mm256_xor_si256(b[3], _mm256_andnot_si256(b[4], b[0]));
+        s[4] = _mm256_xor_si256(b[4], _mm256_andnot_si256(b[0], b[1]));
+        s[5] = _mm256_xor_si256(b[5], _mm256_andnot_si256(b[6], b[7]));
+        s[6] = _mm256_xor_si256(b[6], _mm256_andnot_si256(b[7], b[8]));
+        s[7] = _mm256_xor_si256(b[7], _mm256_andnot_si256(b[8], b[9]));
+        s[8] = _mm256_xor_si256(b[8], _mm256_andnot_si256(b[9], b[5]));
+        s[9] = _mm256_xor_si256(b[9], _mm256_andnot_si256(b[5], b[6]));
+        s[10] = _mm256_xor_si256(b[10], _mm256_andnot_si256(b[11], b[12]));
+        s[11] = _mm256_xor_si256(b[11], _mm256_andnot_si256(b[12], b[13]));
+        s[12] = _mm256_xor_si256(b[12], _mm256_andnot_si256(b[13], b[14]));
+        s[13] = _mm256_xor_si256(b[13], _mm256_andnot_si256(b[14], b[10]));
+        s[14] = _mm256_xor_si256(b[14], _mm256_andnot_si256(b[10], b[11]));
+        s[15] = _mm256_xor_si256(b[15], _mm256_andnot_si256(b[16], b[17]));
+        s[16] = _mm256_xor_si256(b[16], _mm256_andnot_si256(b[17], b[18]));
+        s[17] = _mm256_xor_si256(b[17], _mm256_andnot_si256(b[18], b[19]));
+        s[18] = _mm256_xor_si256(b[18], _mm256_andnot_si256(b[19], b[15]));
+        s[19] = _mm256_xor_si256(b[19], _mm256_andnot_si256(b[15], b[16]));
+        s[20] = _mm256_xor_si256(b[20], _mm256_andnot_si256(b[21], b[22]));
+        s[21] = _mm256_xor_si256(b[21], _mm256_andnot_si256(b[22], b[23]));
+        s[22] = _mm256_xor_si256(b[22], _mm256_andnot_si256(b[23], b[24]));
+        s[23] = _mm256_xor_si256(b[23], _mm256_andnot_si256(b[24], b[20]));
+        s[24] = _mm256_xor_si256(b[24], _mm256_andnot_si256(b[20], b[21]));
+        s[0] = _mm256_xor_si256(s[0],
+            _mm256_set1_epi64x((long long)hash_keccak_r[i]));
+    }
+    for (i = 0; i < 25; i++) {
+        _mm256_storeu_si256((__m256i*)(st + 4 * i), s[i]);
+    }
+}
+
+#undef X4_XOR5
+#undef X4_ROTL
+#endif /* WC_SHA3_X4_AVX2 */
+
+/* Initialize four SHAKE states.
+ *
+ * shake  wc_Shake_x4 object holding states.
+ * heap   Heap reference for dynamic memory allocation. (Not used.)
+ * devId  Device identifier. (Not used.)
+ * p      Number of 64-bit numbers in a block of data to process.
+ * returns BAD_FUNC_ARG when shake is NULL, 0 on success.
+ */
+static int InitShake_x4(wc_Shake_x4* shake, void* heap, int devId, byte p)
+{
+    if (shake == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    XMEMSET(shake->s, 0, sizeof(shake->s));
+    shake->heap = heap;
+    shake->count = p;
+    shake->simd = 0;
+#ifdef WC_SHA3_X4_AVX2
+    if (IS_INTEL_AVX2(cpuid_get_flags())) {
+        shake->simd = 1;
+    }
+#endif
+#ifdef USE_INTEL_SPEEDUP
+    Sha3SetBlockFuncs();
+#endif
+    (void)devId;
+
+    return 0;
+}
+
+/* Permute all four SHAKE states.
+ *
+ * shake  wc_Shake_x4 object holding states.
+ */
+static void Shake_x4_Block(wc_Shake_x4* shake)
+{
+    int j;
+
+#ifdef WC_SHA3_X4_AVX2
+    if (shake->simd) {
+        BlockSha3_x4_avx2(shake->s);
+        return;
+    }
+#endif
+    for (j = 0; j < WC_SHAKE_X4_LANES; j++) {
+    #ifdef USE_INTEL_SPEEDUP
+        (*sha3_block)(shake->s + 25 * j);
+    #else
+        BlockSha3(shake->s + 25 * j);
+    #endif
+    }
+}
+
+/* Absorb data of the same length into each of the four states and pad.
+ *
+ * shake  wc_Shake_x4 object holding states.
+ * data   Four buffers of data to absorb, one per state.
+ * len    Length of each buffer in bytes.
+ * returns BAD_FUNC_ARG when a parameter is NULL, 0 on success.
+ */
+static int Shake_x4_Absorb(wc_Shake_x4* shake, const byte* const* data,
+    word32 len)
+{
+    word32 rate;
+    word32 stride;
+    word32 off = 0;
+    word32 i;
+    int j;
+    byte t[WC_SHA3_128_COUNT * 8];
+
+    if ((shake == NULL) || (data == NULL)) {
+        return BAD_FUNC_ARG;
+    }
+    for (j = 0; j < WC_SHAKE_X4_LANES; j++) {
+        if ((data[j] == NULL) && (len > 0)) {
+            return BAD_FUNC_ARG;
+        }
+    }
+
+    rate = (word32)shake->count * 8;
+    stride = shake->simd ? WC_SHAKE_X4_LANES : 1;
+    for (; len - off >= rate; off += rate) {
+        for (j = 0; j < WC_SHAKE_X4_LANES; j++) {
+            word64* s = shake->s + (shake->simd ? j : 25 * j);
+            for (i = 0; i < shake->count; i++) {
+                s[i * stride] ^= Load64Unaligned(data[j] + off + 8 * i);
+            }
+        }
+        Shake_x4_Block(shake);
+    }
+    for (j = 0; j < WC_SHAKE_X4_LANES; j++) {
+        word64* s = shake->s + (shake->simd ? j : 25 * j);
+
+        XMEMSET(t, 0, rate);
+        if (len > off) {
+            XMEMCPY(t, data[j] + off, len - off);
+        }
+        t[len - off] = 0x1f;
+        t[rate - 1] |= 0x80;
+        for (i = 0; i < shake->count; i++) {
+            s[i * stride] ^= Load64Unaligned(t + 8 * i);
+        }
+    }
+
+    return 0;
+}
+
+/* Squeeze blocks of output from each of the four states.
+ *
+ * shake     wc_Shake_x4 object holding states.
+ * out       Four output buffers, one per state.
+ * blockCnt  Number of blocks to write to each buffer.
+ * returns BAD_FUNC_ARG when a parameter is NULL, 0 on success.
+ */
+static int Shake_x4_SqueezeBlocks(wc_Shake_x4* shake, byte* const* out,
+    word32 blockCnt)
+{
+    word32 rate;
+    word32 stride;
+    word32 b;
+    word32 i;
+    int j;
+
+    if ((shake == NULL) || (out == NULL)) {
+        return BAD_FUNC_ARG;
+    }
+    for (j = 0; j < WC_SHAKE_X4_LANES; j++) {
+        if ((out[j] == NULL) && (blockCnt > 0)) {
+            return BAD_FUNC_ARG;
+        }
+    }
+
+    rate = (word32)shake->count * 8;
+    stride = shake->simd ? WC_SHAKE_X4_LANES : 1;
+    for (b = 0; b < blockCnt; b++) {
+        Shake_x4_Block(shake);
+        for (j = 0; j < WC_SHAKE_X4_LANES; j++) {
+            const word64* s = shake->s + (shake->simd ? j : 25 * j);
+            byte* o = out[j] + b * rate;
+
+            for (i = 0; i < shake->count; i++) {
+                word64 w = s[i * stride];
+            #ifdef BIG_ENDIAN_ORDER
+                w = ByteReverseWord64(w);
+            #endif
+                XMEMCPY(o + 8 * i, &w, sizeof(w));
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Dispose of the four SHAKE states.
+ *
+ * shake  wc_Shake_x4 object holding states.
+ */
+static void Shake_x4_Free(wc_Shake_x4* shake)
+{
+    if (shake != NULL) {
+        ForceZero(shake->s, sizeof(shake->s));
+    }
+}
+
+#ifdef WOLFSSL_SHAKE128
+/* Initialize four SHAKE128 states to be used in parallel.
+ *
+ * shake  wc_Shake_x4 object holding states.
+ * heap   Heap reference for dynamic memory allocation. (Not used.)
+ * devId  Device identifier. (Not used.)
+ * returns BAD_FUNC_ARG when shake is NULL, 0 on success.
+ */
+int wc_InitShake128_x4(wc_Shake_x4* shake, void* heap, int devId)
+{
+    return InitShake_x4(shake, heap, devId, WC_SHA3_128_COUNT);
+}
+
+/* Absorb four buffers of data of the same length for squeezing.
+ *
+ * shake  wc_Shake_x4 object holding states.
+ * data   Four buffers of data to absorb.
+ * len    Length of each buffer in bytes.
+ * returns BAD_FUNC_ARG when a parameter is NULL, 0 on success.
+ */
+int wc_Shake128_x4_Absorb(wc_Shake_x4* shake, const byte* const* data,
+    word32 len)
+{
+    return Shake_x4_Absorb(shake, data, len);
+}
+
+/* Squeeze the four states to produce pseudo-random output.
+ *
+ * shake     wc_Shake_x4 object holding states.
+ * out       Four output buffers.
+ * blockCnt  Number of blocks to write to each buffer.
+ * returns BAD_FUNC_ARG when a parameter is NULL, 0 on success.
+ */
+int wc_Shake128_x4_SqueezeBlocks(wc_Shake_x4* shake, byte* const* out,
+    word32 blockCnt)
+{
+    return Shake_x4_SqueezeBlocks(shake, out, blockCnt);
+}
+
+/* Dispose of the four SHAKE128 states.
+ *
+ * shake  wc_Shake_x4 object holding states.
+ */
+void wc_Shake128_x4_Free(wc_Shake_x4* shake)
+{
+    Shake_x4_Free(shake);
+}
+#endif
+
+#ifdef WOLFSSL_SHAKE256
+/* Initialize four SHAKE256 states to be used in parallel.
+ *
+ * shake  wc_Shake_x4 object holding states.
+ * heap   Heap reference for dynamic memory allocation. (Not used.)
+ * devId  Device identifier. (Not used.)
+ * returns BAD_FUNC_ARG when shake is NULL, 0 on success.
+ */
+int wc_InitShake256_x4(wc_Shake_x4* shake, void* heap, int devId)
+{
+    return InitShake_x4(shake, heap, devId, WC_SHA3_256_COUNT);
+}
+
+/* Absorb four buffers of data of the same length for squeezing.
+ *
+ * shake  wc_Shake_x4 object holding states.
+ * data   Four buffers of data to absorb.
+ * len    Length of each buffer in bytes.
+ * returns BAD_FUNC_ARG when a parameter is NULL, 0 on success.
+ */
+int wc_Shake256_x4_Absorb(wc_Shake_x4* shake, const byte* const* data,
+    word32 len)
+{
+    return Shake_x4_Absorb(shake, data, len);
+}
+
+/* Squeeze the four states to produce pseudo-random output.
+ *
+ * shake     wc_Shake_x4 object holding states.
+ * out       Four output buffers.
+ * blockCnt  Number of blocks to write to each buffer.
+ * returns BAD_FUNC_ARG when a parameter is NULL, 0 on success.
+ */
+int wc_Shake256_x4_SqueezeBlocks(wc_Shake_x4* shake, byte* const* out,
+    word32 blockCnt)
+{
+    return Shake_x4_SqueezeBlocks(shake, out, blockCnt);
+}
+
+/* Dispose of the four SHAKE256 states.
+ *
+ * shake  wc_Shake_x4 object holding states.
+ */
+void wc_Shake256_x4_Free(wc_Shake_x4* shake)
+{
+    Shake_x4_Free(shake);
+}
+#endif
+
+#endif /* WOLFSSL_SHAKE128 || WOLFSSL_SHAKE256 */
+
 #endif /* WOLFSSL_SHA3 */
@@ -72,6 +72,11 @@ static word32 cpuid_flags = 0;
 #define GEN_MATRIX_SIZE     GEN_MATRIX_NBLOCKS * XOF_BLOCK_SIZE
 
 
+#ifndef WOLFSSL_KYBER_SMALL
+    /* Generate polynomials four at a time with interleaved SHAKE states. */
+    #define KYBER_SHAKE_X4
+#endif
+
 /* Number of random bytes to generate for ETA3. */
 #define ETA3_RAND_SIZE     ((3 * KYBER_N) / 4)
 /* Number of random bytes to generate for ETA2. */
@@ -980,6 +985,7 @@ static int kyber_gen_matrix_k4_avx2(sword16* a, byte* seed, int transposed)
 #endif /* KYBER1024 */
 #endif /* USE_INTEL_SPEEDUP */
 
+#ifndef KYBER_SHAKE_X4
 /* Absorb the seed data for squeezing out pseudo-random data.
  *
  * @param  [in, out]  shake128  SHAKE-128 object.
@@ -1010,6 +1016,7 @@ static int kyber_xof_squeezeblocks(wc_Shake* shake128, byte* out, int blocks)
 {
     return wc_Shake128_SqueezeBlocks(shake128, out, blocks);
 }
+#endif
 
 /* Initialize SHAKE-256 object.
  *
@@ -1041,6 +1048,8 @@ void kyber_prf_free(wc_Shake* prf)
     wc_Shake256_Free(prf);
 }
 
+#if !defined(KYBER_SHAKE_X4) || (defined(USE_INTEL_SPEEDUP) && \
+    (defined(WOLFSSL_KYBER512) || defined(WOLFSSL_KYBER1024)))
 /* Create pseudo-random data from the key using SHAKE-256.
  *
  * @param  [in, out]  shake256  SHAKE-256 object.
@@ -1090,6 +1099,7 @@ static int kyber_prf(wc_Shake* shake256, byte* out, unsigned int outLen,
     return ret;
 #endif
 }
+#endif
 
 #ifdef USE_INTEL_SPEEDUP
 /* Create pseudo-random key from the seed using SHAKE-256.
@@ -1167,6 +1177,7 @@ static unsigned int kyber_rej_uniform_c(sword16* p, unsigned int len,
     return i;
 }
 
+#ifndef KYBER_SHAKE_X4
 /* Deterministically generate a matrix (or transpose) of uniform integers mod q.
  *
  * Seed used with XOF to generate random bytes.
@@ -1262,6 +1273,125 @@ static int kyber_gen_matrix_c(KYBER_PRF_T* prf, sword16* a, int kp, byte* seed,
 
     return ret;
 }
+#else
+/* Deterministically generate a matrix (or transpose) of uniform integers mod q.
+ *
+ * Seed used with XOF to generate random bytes.
+ * Four polynomials are generated at a time with interleaved SHAKE-128.
+ *
+ * @param  [in]   prf         XOF object. (Not used.)
+ * @param  [out]  a           Matrix of uniform integers.
+ * @param  [in]   kp          Number of dimensions. kp x kp polynomials.
+ * @param  [in]   seed        Bytes to seed XOF generation.
+ * @param  [in]   transposed  Whether A or A^T is generated.
+ * @return  0 on success.
+ * @return  MEMORY_E when dynamic memory allocation fails. Only possible when
+ * WOLFSSL_SMALL_STACK is defined.
+ */
+static int kyber_gen_matrix_c(KYBER_PRF_T* prf, sword16* a, int kp, byte* seed,
+    int transposed)
+{
+#ifdef WOLFSSL_SMALL_STACK
+    wc_Shake_x4* shake;
+    byte* rand = NULL;
+#else
+    wc_Shake_x4 shake[1];
+    byte rand[WC_SHAKE_X4_LANES * GEN_MATRIX_SIZE];
+#endif
+    byte extSeed[WC_SHAKE_X4_LANES][KYBER_SYM_SZ + 2];
+    const byte* in[WC_SHAKE_X4_LANES];
+    byte* out[WC_SHAKE_X4_LANES];
+    unsigned int ctr[WC_SHAKE_X4_LANES];
+    int idx[WC_SHAKE_X4_LANES];
+    int ret = 0;
+    int n = kp * kp;
+    int k;
+    int l;
+
+    (void)prf;
+
+#ifdef WOLFSSL_SMALL_STACK
+    /* Allocate XOF states and memory to hold random bytes to be sampled. */
+    shake = (wc_Shake_x4*)XMALLOC(sizeof(wc_Shake_x4) +
+        WC_SHAKE_X4_LANES * GEN_MATRIX_SIZE, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    if (shake == NULL) {
+        ret = MEMORY_E;
+    }
+    else {
+        rand = (byte*)(shake + 1);
+    }
+#endif
+
+    for (l = 0; (ret == 0) && (l < WC_SHAKE_X4_LANES); l++) {
+        XMEMCPY(extSeed[l], seed, KYBER_SYM_SZ);
+        in[l] = extSeed[l];
+        out[l] = rand + l * GEN_MATRIX_SIZE;
+    }
+
+    /* Generate four polynomials of the matrix at a time. */
+    for (k = 0; (ret == 0) && (k < n); k += WC_SHAKE_X4_LANES) {
+        int done;
+
+        for (l = 0; l < WC_SHAKE_X4_LANES; l++) {
+            int i;
+            int j;
+
+            /* Repeat the first polynomial when fewer than four are left. */
+            idx[l] = (k + l < n) ? (k + l) : k;
+            i = idx[l] / kp;
+            j = idx[l] % kp;
+            if (transposed) {
+                extSeed[l][KYBER_SYM_SZ + 0] = (byte)i;
+                extSeed[l][KYBER_SYM_SZ + 1] = (byte)j;
+            }
+            else {
+                extSeed[l][KYBER_SYM_SZ + 0] = (byte)j;
+                extSeed[l][KYBER_SYM_SZ + 1] = (byte)i;
+            }
+        }
+        /* Absorb the index specific seeds. */
+        ret = wc_InitShake128_x4(shake, NULL, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_Shake128_x4_Absorb(shake, in, KYBER_SYM_SZ + 2);
+        }
+        if (ret == 0) {
+            /* Create out based on the seeds. */
+            ret = wc_Shake128_x4_SqueezeBlocks(shake, out,
+                GEN_MATRIX_NBLOCKS);
+        }
+        if (ret == 0) {
+            /* Sample random bytes to create the polynomials. */
+            done = 1;
+            for (l = 0; l < WC_SHAKE_X4_LANES; l++) {
+                ctr[l] = kyber_rej_uniform_c(a + idx[l] * KYBER_N, KYBER_N,
+                    out[l], GEN_MATRIX_SIZE);
+                done &= (ctr[l] == KYBER_N);
+            }
+            /* Create more blocks if too many rejected. */
+            while ((ret == 0) && (!done)) {
+                ret = wc_Shake128_x4_SqueezeBlocks(shake, out, 1);
+                done = 1;
+                for (l = 0; (ret == 0) && (l < WC_SHAKE_X4_LANES); l++) {
+                    if (ctr[l] < KYBER_N) {
+                        ctr[l] += kyber_rej_uniform_c(
+                            a + idx[l] * KYBER_N + ctr[l], KYBER_N - ctr[l],
+                            out[l], XOF_BLOCK_SIZE);
+                    }
+                    done &= (ctr[l] == KYBER_N);
+                }
+            }
+        }
+        wc_Shake128_x4_Free(shake);
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    /* Dispose of temporary buffer. */
+    XFREE(shake, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    return ret;
+}
+#endif /* KYBER_SHAKE_X4 */
 
 /* Deterministically generate a matrix (or transpose) of uniform integers mod q.
  *
@@ -1537,6 +1667,7 @@ static void kyber_cbd_eta3(sword16* p, const byte* r)
 }
 #endif
 
+#ifndef KYBER_SHAKE_X4
 /* Get noise/error by calculating random bytes and sampling to a binomial
  * distribution.
  *
@@ -1579,7 +1710,10 @@ static int kyber_get_noise_eta1_c(KYBER_PRF_T* prf, sword16* p,
 
     return ret;
 }
+#endif
 
+#if !defined(KYBER_SHAKE_X4) || (defined(USE_INTEL_SPEEDUP) && \
+    defined(WOLFSSL_KYBER1024))
 /* Get noise/error by calculating random bytes and sampling to a binomial
  * distribution. Values -2..2
  *
@@ -1602,6 +1736,7 @@ static int kyber_get_noise_eta2_c(KYBER_PRF_T* prf, sword16* p,
 
     return ret;
 }
+#endif
 
 #ifdef USE_INTEL_SPEEDUP
 #define PRF_RAND_SZ   (2 * SHA3_256_BYTES)
@@ -1785,6 +1920,7 @@ static int kyber_get_noise_k4_avx2(KYBER_PRF_T* prf, sword16* vec1,
 #endif
 #endif /* USE_INTEL_SPEEDUP */
 
+#ifndef KYBER_SHAKE_X4
 /* Get the noise/error by calculating random bytes and sampling to a binomial
  * distribution.
  *
@@ -1827,6 +1963,101 @@ static int kyber_get_noise_c(KYBER_PRF_T* prf, int kp, sword16* vec1, int eta1,
 
     return ret;
 }
+#else
+/* Get the noise/error by calculating random bytes and sampling to a binomial
+ * distribution.
+ *
+ * Four polynomials are generated at a time with interleaved SHAKE-256.
+ *
+ * @param  [in, out]  prf   Psuedo-random function object. (Not used.)
+ * @param  [in]       kp    Number of polynomials in vector.
+ * @param  [out]      vec1  First Vector of polynomials.
+ * @param  [in]       eta1  Size of noise/error integers with first vector.
+ * @param  [out]      vec2  Second Vector of polynomials.
+ * @param  [in]       eta2  Size of noise/error integers with second vector.
+ * @param  [out]      poly  Polynomial.
+ * @param  [in]       seed  Seed to use when calculating random.
+ * @return  0 on success.
+ */
+static int kyber_get_noise_c(KYBER_PRF_T* prf, int kp, sword16* vec1, int eta1,
+    sword16* vec2, int eta2, sword16* poly, byte* seed)
+{
+    wc_Shake_x4 shake;
+    byte extSeed[WC_SHAKE_X4_LANES][KYBER_SYM_SZ + 1];
+    byte rand[WC_SHAKE_X4_LANES][2 * SHA3_256_BYTES];
+    const byte* in[WC_SHAKE_X4_LANES];
+    byte* out[WC_SHAKE_X4_LANES];
+    sword16* p[2 * KYBER_MAX_K + 1];
+    int eta[2 * KYBER_MAX_K + 1];
+    int n = 0;
+    int ret = 0;
+    int i;
+    int l;
+
+    (void)prf;
+    (void)eta;
+
+    /* List polynomials in order of the appended byte. */
+    for (i = 0; i < kp; i++, n++) {
+        p[n] = vec1 + i * KYBER_N;
+        eta[n] = eta1;
+    }
+    for (i = 0; i < kp; i++, n++) {
+        p[n] = vec2 + i * KYBER_N;
+        eta[n] = eta2;
+    }
+    if (poly != NULL) {
+        p[n] = poly;
+        eta[n] = KYBER_CBD_ETA2;
+        n++;
+    }
+
+    for (l = 0; l < WC_SHAKE_X4_LANES; l++) {
+        XMEMCPY(extSeed[l], seed, KYBER_SYM_SZ);
+        in[l] = extSeed[l];
+        out[l] = rand[l];
+    }
+
+    /* Generate four polynomials at a time. */
+    for (i = 0; (ret == 0) && (i < n); i += WC_SHAKE_X4_LANES) {
+        word32 blocks = 1;
+
+        for (l = 0; l < WC_SHAKE_X4_LANES; l++) {
+            /* Appended byte is the index of the polynomial. */
+            extSeed[l][KYBER_SYM_SZ] = (byte)(i + l);
+        #ifdef WOLFSSL_KYBER512
+            if ((i + l < n) && (eta[i + l] == KYBER_CBD_ETA3)) {
+                blocks = 2;
+            }
+        #endif
+        }
+        ret = wc_InitShake256_x4(&shake, NULL, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_Shake256_x4_Absorb(&shake, in, KYBER_SYM_SZ + 1);
+        }
+        if (ret == 0) {
+            ret = wc_Shake256_x4_SqueezeBlocks(&shake, out, blocks);
+        }
+        for (l = 0; (ret == 0) && (l < WC_SHAKE_X4_LANES) && (i + l < n);
+                l++) {
+        #ifdef WOLFSSL_KYBER512
+            if (eta[i + l] == KYBER_CBD_ETA3) {
+                /* Sample for values in range -3..3 from 3 bits of random. */
+                kyber_cbd_eta3(p[i + l], rand[l]);
+            }
+            else
+        #endif
+            {
+                /* Sample for values in range -2..2 from 2 bits of random. */
+                kyber_cbd_eta2(p[i + l], rand[l]);
+            }
+        }
+        wc_Shake256_x4_Free(&shake);
+    }
+
+    return ret;
+}
+#endif /* KYBER_SHAKE_X4 */
 
 /* Get the noise/error by calculating random bytes and sampling to a binomial
  * distribution.
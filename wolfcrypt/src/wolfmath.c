@@ -224,6 +224,180 @@ int mp_rand(mp_int* a, int digits, WC_RNG* rng)
 #endif /* WC_RSA_BLINDING || WOLFCRYPT_HAVE_SAKKE */
 #endif /* !WC_NO_RNG */
 
+#ifdef WOLFSSL_KEYGEN_THREADS
+/* State shared by the threads of a prime search. */
+typedef struct PrimeSearch {
+    wc_PrimeSearchCb cb;
+    void*            ctx;
+    mp_int*          prime;    /* Accepted candidate */
+    wolfSSL_Mutex    lock;     /* Protects fields below */
+    word32           maxCands; /* Candidates to try in total, 0 for no limit */
+    word32           cands;    /* Candidates started */
+    int              done;     /* Accepted, failed or limit reached */
+    int              ret;
+    int              worker;   /* Thread that accepted prime */
+    word32           iter;     /* Iteration of thread that accepted prime */
+} PrimeSearch;
+
+/* Per thread state of a prime search. */
+typedef struct PrimeSearchWorker {
+    PrimeSearch* search;
+    WC_RNG       rng;
+    mp_int       cand;
+    THREAD_TYPE  tid;
+    int          id;
+} PrimeSearchWorker;
+
+/* Try candidates until any thread accepts one, fails or the limit is hit. */
+static THREAD_RETURN WOLFSSL_THREAD PrimeSearchRun(void* arg)
+{
+    PrimeSearchWorker* w = (PrimeSearchWorker*)arg;
+    PrimeSearch* search = w->search;
+    word32 iter = 0;
+    int ret;
+    int isPrime;
+    int stop;
+
+    for (;;) {
+        if (wc_LockMutex(&search->lock) != 0)
+            break;
+        if (!search->done && (search->maxCands != 0) &&
+                (search->cands >= search->maxCands)) {
+            search->done = 1;
+        }
+        search->cands++;
+        stop = search->done;
+        wc_UnLockMutex(&search->lock);
+        if (stop)
+            break;
+
+        isPrime = 0;
+        ret = search->cb(search->ctx, w->id, iter, &w->rng, &w->cand,
+            &isPrime);
+
+        if (wc_LockMutex(&search->lock) != 0)
+            break;
+        if (!search->done && ((ret != 0) || isPrime)) {
+            search->done = 1;
+            search->ret = ret;
+            if (ret == 0) {
+                search->ret = mp_copy(&w->cand, search->prime);
+                search->worker = w->id;
+                search->iter = iter;
+            }
+        }
+        stop = search->done;
+        wc_UnLockMutex(&search->lock);
+        if (stop)
+            break;
+        iter++;
+    }
+
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+/* Search for a prime using multiple threads.
+ *
+ * Each thread repeatedly calls cb with its own random number generator, forked
+ * from rng, until a candidate is accepted by any thread. The calling thread is
+ * one of the threads. Fewer threads are used when not all can be started.
+ *
+ * @param [in]      cb        Generates and tests one candidate.
+ * @param [in]      ctx       Context passed to cb.
+ * @param [in]      threads   Number of threads to search with.
+ * @param [in]      maxCands  Maximum candidates to try in total. 0 for no
+ *                            limit.
+ * @param [in, out] rng       Random number generator to fork.
+ * @param [out]     prime     Accepted candidate.
+ * @param [out]     worker    Index of thread that accepted prime. May be NULL.
+ * @param [out]     iter      Candidates tried by that thread before prime.
+ *                            May be NULL.
+ * @param [in]      heap      Dynamic memory allocation hint.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when a pointer is NULL or threads is out of range.
+ * @return  PRIME_GEN_E when limit reached without a prime.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  Other negative on failure of cb.
+ */
+int wc_PrimeSearchThreads(wc_PrimeSearchCb cb, void* ctx, int threads,
+    word32 maxCands, WC_RNG* rng, mp_int* prime, int* worker, word32* iter,
+    void* heap)
+{
+    PrimeSearch search;
+    PrimeSearchWorker* w;
+    int inited = 0;
+    int started;
+    int i;
+    int ret = 0;
+
+    if ((cb == NULL) || (rng == NULL) || (prime == NULL) || (threads < 1) ||
+            (threads > WOLFSSL_KEYGEN_MAX_THREADS)) {
+        return BAD_FUNC_ARG;
+    }
+
+    w = (PrimeSearchWorker*)XMALLOC(sizeof(PrimeSearchWorker) *
+        (size_t)threads, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (w == NULL)
+        return MEMORY_E;
+    XMEMSET(w, 0, sizeof(PrimeSearchWorker) * (size_t)threads);
+
+    XMEMSET(&search, 0, sizeof(search));
+    search.cb = cb;
+    search.ctx = ctx;
+    search.prime = prime;
+    search.maxCands = maxCands;
+    search.ret = PRIME_GEN_E;
+    if (wc_InitMutex(&search.lock) != 0) {
+        XFREE(w, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        return BAD_MUTEX_E;
+    }
+
+    for (i = 0; (ret == 0) && (i < threads); i++) {
+        w[i].search = &search;
+        w[i].id = i;
+        ret = wc_RNG_Fork(rng, &w[i].rng);
+        if (ret == 0) {
+            ret = mp_init(&w[i].cand);
+            if (ret != MP_OKAY)
+                wc_FreeRng(&w[i].rng);
+        }
+        if (ret == 0)
+            inited++;
+    }
+
+    if (ret == 0) {
+        for (started = 1; started < threads; started++) {
+            if (wolfSSL_NewThread(&w[started].tid, PrimeSearchRun,
+                    &w[started]) != 0) {
+                WOLFSSL_MSG("Prime search thread start failed");
+                break;
+            }
+        }
+        (void)PrimeSearchRun(&w[0]);
+        for (i = 1; i < started; i++)
+            wolfSSL_JoinThread(w[i].tid);
+
+        ret = search.ret;
+        if (ret == 0) {
+            if (worker != NULL)
+                *worker = search.worker;
+            if (iter != NULL)
+                *iter = search.iter;
+        }
+    }
+
+    for (i = 0; i < inited; i++) {
+        mp_forcezero(&w[i].cand);
+        wc_FreeRng(&w[i].rng);
+    }
+    wc_FreeMutex(&search.lock);
+    XFREE(w, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    (void)heap;
+
+    return ret;
+}
+#endif /* WOLFSSL_KEYGEN_THREADS */
+
 #if defined(HAVE_ECC) || defined(WOLFSSL_EXPORT_INT)
 /* export an mp_int as unsigned char or hex string
  * encType is WC_TYPE_UNSIGNED_BIN or WC_TYPE_HEX_STR
@@ -718,6 +718,9 @@ WOLFSSL_TEST_SUBROUTINE int ariagcm_test(MC_ALGID);
 #ifdef WOLF_CRYPTO_CB
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t cryptocb_test(void);
 #endif
+#ifdef WOLF_CRYPTO_CB_POOL
+WOLFSSL_TEST_SUBROUTINE wc_test_ret_t cryptocb_pool_test(void);
+#endif
 #ifdef WOLFSSL_CERT_PIV
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t certpiv_test(void);
 #endif
@@ -1908,6 +1911,13 @@ options: [-s max_relative_stack_bytes] [-m max_relative_heap_memory_bytes]\n\
         TEST_PASS("crypto callback test passed!\n");
 #endif
 
+#ifdef WOLF_CRYPTO_CB_POOL
+    if ( (ret = cryptocb_pool_test()) != 0)
+        TEST_FAIL("crypto callback pool test failed!\n", ret);
+    else
+        TEST_PASS("crypto callback pool test passed!\n");
+#endif
+
 #ifdef WOLFSSL_CERT_PIV
     if ( (ret = certpiv_test()) != 0)
         TEST_FAIL("cert piv test failed!\n", ret);
@@ -10628,6 +10638,129 @@ out:
 }
 #endif /* WOLFSSL_AES_128 && WOLFSSL_AES_256 */
 
+#if defined(WOLFSSL_AES_256) && !defined(WOLFSSL_NO_MALLOC) && \
+    !defined(BENCH_EMBEDDED) && !defined(HAVE_FIPS) && \
+    !defined(HAVE_SELFTEST) && !defined(WOLFSSL_ASYNC_CRYPT)
+/* Runs of sectors compared with one sector at a time. */
+static wc_test_ret_t aes_xts_sectors_test(void)
+{
+    /* Sector sizes that aren't and are a multiple of four blocks, the second
+     * large enough to be split across threads. */
+    static const word32 sectorSz[] = { 528, 4096 };
+    static const word32 sectors[] = { 70, 40 };
+    /* Last sector is partial. */
+    const word32 tailSz = 40;
+    const word64 sector = W64LIT(0xfffffffffffffff0);
+    WOLFSSL_SMALL_STACK_STATIC const byte key[64] = {
+        0x27, 0x18, 0x28, 0x18, 0x28, 0x45, 0x90, 0x45,
+        0x23, 0x53, 0x60, 0x28, 0x74, 0x71, 0x35, 0x26,
+        0x62, 0x49, 0x77, 0x57, 0x24, 0x70, 0x93, 0x69,
+        0x99, 0x59, 0x57, 0x49, 0x66, 0x96, 0x76, 0x27,
+        0x31, 0x41, 0x59, 0x26, 0x53, 0x58, 0x97, 0x93,
+        0x23, 0x84, 0x62, 0x64, 0x33, 0x83, 0x27, 0x95,
+        0x02, 0x88, 0x41, 0x97, 0x16, 0x93, 0x99, 0x37,
+        0x51, 0x05, 0x82, 0x09, 0x74, 0x94, 0x45, 0x92
+    };
+    XtsAes* aes = NULL;
+    byte* pt = NULL;
+    byte* ct = NULL;
+    byte* buf = NULL;
+    word32 maxSz = sectorSz[1] * sectors[1] + tailSz;
+    word32 sz = 0;
+    word32 i;
+    word32 j;
+    int aes_inited = 0;
+    wc_test_ret_t ret = 0;
+
+    aes = (XtsAes*)XMALLOC(sizeof(*aes), HEAP_HINT, DYNAMIC_TYPE_AES);
+    pt = (byte*)XMALLOC(maxSz, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    ct = (byte*)XMALLOC(maxSz, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    buf = (byte*)XMALLOC(maxSz, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if ((aes == NULL) || (pt == NULL) || (ct == NULL) || (buf == NULL))
+        ERROR_OUT(WC_TEST_RET_ENC_ERRNO, out);
+    for (i = 0; i < maxSz; i++)
+        pt[i] = (byte)(i * 7 + (i >> 8));
+
+    ret = wc_AesXtsInit(aes, HEAP_HINT, devId);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    aes_inited = 1;
+
+    for (i = 0; i < sizeof(sectorSz) / sizeof(*sectorSz); i++) {
+        sz = sectorSz[i] * sectors[i] + tailSz;
+
+        ret = wc_AesXtsSetKeyNoInit(aes, key, sizeof(key), AES_ENCRYPTION);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        for (j = 0; j < sectors[i]; j++) {
+            ret = wc_AesXtsEncryptSector(aes, ct + j * sectorSz[i],
+                pt + j * sectorSz[i], sectorSz[i], sector + j);
+            if (ret != 0)
+                ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        }
+        ret = wc_AesXtsEncryptSector(aes, ct + j * sectorSz[i],
+            pt + j * sectorSz[i], tailSz, sector + j);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+
+        XMEMSET(buf, 0, sz);
+        ret = wc_AesXtsEncryptSectors(aes, buf, pt, sz, sector, sectorSz[i],
+            1);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        if (XMEMCMP(buf, ct, sz) != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+
+        /* In-place on multiple threads when supported. */
+        XMEMCPY(buf, pt, sz);
+        ret = wc_AesXtsEncryptSectors(aes, buf, buf, sz, sector, sectorSz[i],
+            4);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        if (XMEMCMP(buf, ct, sz) != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+
+        ret = wc_AesXtsSetKeyNoInit(aes, key, sizeof(key), AES_DECRYPTION);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        ret = wc_AesXtsDecryptSectors(aes, buf, buf, sz, sector, sectorSz[i],
+            4);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        if (XMEMCMP(buf, pt, sz) != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+        XMEMSET(buf, 0, sz);
+        ret = wc_AesXtsDecryptSectors(aes, buf, ct, sz, sector, sectorSz[i],
+            0);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        if (XMEMCMP(buf, pt, sz) != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+    }
+
+    ret = wc_AesXtsEncryptSectors(NULL, buf, pt, sz, sector, sectorSz[0], 1);
+    if (ret != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    ret = wc_AesXtsEncryptSectors(aes, buf, pt, sz, sector, 0, 1);
+    if (ret != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    ret = wc_AesXtsDecryptSectors(aes, buf, pt, sz, sector, sectorSz[0], -1);
+    if (ret != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    ret = 0;
+
+out:
+    if (aes_inited)
+        wc_AesXtsFree(aes);
+    XFREE(buf, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(ct, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(pt, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(aes, HEAP_HINT, DYNAMIC_TYPE_AES);
+
+    return ret;
+}
+#endif /* WOLFSSL_AES_256 && !WOLFSSL_NO_MALLOC && !BENCH_EMBEDDED */
+
 
 #ifdef WOLFSSL_AES_128
 /* testing of bad arguments */
@@ -12202,6 +12335,13 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t aes_xts_test(void)
     if (ret != 0)
         return ret;
     #endif
+    #if defined(WOLFSSL_AES_256) && !defined(WOLFSSL_NO_MALLOC) && \
+        !defined(BENCH_EMBEDDED) && !defined(HAVE_FIPS) && \
+        !defined(HAVE_SELFTEST) && !defined(WOLFSSL_ASYNC_CRYPT)
+    ret = aes_xts_sectors_test();
+    if (ret != 0)
+        return ret;
+    #endif
     #ifdef WOLFSSL_AES_128
     ret = aes_xts_args_test();
     if (ret != 0)
@@ -12800,6 +12940,144 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t aesgcm_default_test(void)
     return 0;
 }
 
+#if defined(WOLFSSL_AESGCM_VAES) && defined(WOLFSSL_AES_256) && \
+    !defined(WOLFSSL_NO_MALLOC)
+/* Messages long enough for the AVX-512 VAES code: whole and partial chunks of
+ * sixteen blocks, long AAD and IVs that aren't 12 bytes. Plaintext, AAD and IV
+ * are byte patterns. Expected tags calculated with another implementation.
+ */
+static wc_test_ret_t aesgcm_vaes_test(Aes* aes)
+{
+    WOLFSSL_SMALL_STACK_STATIC const byte key[] =
+    {
+        0x6d, 0x1e, 0x5a, 0xf9, 0x83, 0x2c, 0x47, 0xb0,
+        0x0e, 0x91, 0xd4, 0x38, 0x7a, 0xc5, 0x12, 0xef,
+        0x59, 0xa6, 0x24, 0x8b, 0xf3, 0x0d, 0x7e, 0x61,
+        0xb2, 0x9c, 0x15, 0x40, 0xea, 0x77, 0xc8, 0x3f
+    };
+    WOLFSSL_SMALL_STACK_STATIC const struct {
+        word32 keySz;
+        word32 ivSz;
+        word32 aadSz;
+        word32 sz;
+        byte   tag[AES_BLOCK_SIZE];
+    } tv[] = {
+#ifdef WOLFSSL_AES_128
+        { 16, 12, 20, 256,
+          { 0x28, 0xbe, 0x87, 0x9e, 0x23, 0x21, 0xa1, 0xd1,
+            0x09, 0x5b, 0x0d, 0x22, 0xb6, 0xc4, 0x77, 0xc9 } },
+#endif
+#ifdef WOLFSSL_AES_192
+        { 24, 12, 0, 1000,
+          { 0x67, 0xdf, 0xff, 0x73, 0x22, 0xb5, 0xd3, 0x21,
+            0x62, 0xf9, 0xaf, 0x59, 0xd6, 0xea, 0xe2, 0x82 } },
+#endif
+        { 32, 60, 300, 4111,
+          { 0xfa, 0xed, 0x93, 0x44, 0x2e, 0x89, 0x81, 0xbe,
+            0x9e, 0xc2, 0x17, 0xbb, 0xd1, 0xb9, 0x28, 0x73 } },
+        { 32, 12, 13, 2064,
+          { 0x6c, 0x1f, 0x23, 0xd7, 0xcb, 0xad, 0x00, 0xbc,
+            0x74, 0xaf, 0x14, 0xf0, 0xf0, 0x02, 0xdb, 0xec } }
+    };
+    wc_test_ret_t ret = 0;
+    byte iv[60];
+    byte aad[300];
+    byte tag[AES_BLOCK_SIZE];
+    byte* buf;
+    byte* pt;
+    byte* ct;
+    byte* dec;
+    word32 i;
+#ifdef WOLFSSL_AESGCM_STREAM
+    word32 j;
+    word32 o;
+    word32 n;
+#endif
+
+    buf = (byte*)XMALLOC(3 * 4111, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (buf == NULL)
+        return WC_TEST_RET_ENC_ERRNO;
+    pt = buf;
+    ct = pt + 4111;
+    dec = ct + 4111;
+
+    for (i = 0; i < (word32)sizeof(iv); i++)
+        iv[i] = (byte)(0xa0 + 3 * i);
+    for (i = 0; i < (word32)sizeof(aad); i++)
+        aad[i] = (byte)(0xff - i);
+    for (i = 0; i < 4111; i++)
+        pt[i] = (byte)i;
+
+    for (i = 0; i < (word32)(sizeof(tv) / sizeof(*tv)); i++) {
+        ret = wc_AesGcmSetKey(aes, key, tv[i].keySz);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        ret = wc_AesGcmEncrypt(aes, ct, pt, tv[i].sz, iv, tv[i].ivSz, tag,
+            sizeof(tag), aad, tv[i].aadSz);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        if (XMEMCMP(tag, tv[i].tag, sizeof(tag)) != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), out);
+    #ifdef HAVE_AES_DECRYPT
+        ret = wc_AesGcmDecrypt(aes, dec, ct, tv[i].sz, iv, tv[i].ivSz, tag,
+            sizeof(tag), aad, tv[i].aadSz);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        if (XMEMCMP(dec, pt, tv[i].sz) != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), out);
+        tag[0] ^= 0x01;
+        ret = wc_AesGcmDecrypt(aes, dec, ct, tv[i].sz, iv, tv[i].ivSz, tag,
+            sizeof(tag), aad, tv[i].aadSz);
+        if (ret != AES_GCM_AUTH_E)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    #endif
+
+    #ifdef WOLFSSL_AESGCM_STREAM
+        /* Small and large updates mix the AVX2 and the VAES code. */
+        ret = wc_AesGcmEncryptInit(aes, NULL, 0, iv, tv[i].ivSz);
+        if (ret == 0)
+            ret = wc_AesGcmEncryptUpdate(aes, NULL, NULL, 0, aad, tv[i].aadSz);
+        for (o = 0, j = 0; (ret == 0) && (o < tv[i].sz); o += n, j++) {
+            n = ((j & 1) == 0) ? 17 : 500;
+            if (n > tv[i].sz - o)
+                n = tv[i].sz - o;
+            ret = wc_AesGcmEncryptUpdate(aes, dec + o, pt + o, n, NULL, 0);
+        }
+        if (ret == 0)
+            ret = wc_AesGcmEncryptFinal(aes, tag, sizeof(tag));
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        if (XMEMCMP(dec, ct, tv[i].sz) != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), out);
+        if (XMEMCMP(tag, tv[i].tag, sizeof(tag)) != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), out);
+    #ifdef HAVE_AES_DECRYPT
+        ret = wc_AesGcmDecryptInit(aes, NULL, 0, iv, tv[i].ivSz);
+        if (ret == 0)
+            ret = wc_AesGcmDecryptUpdate(aes, NULL, NULL, 0, aad, tv[i].aadSz);
+        for (o = 0, j = 0; (ret == 0) && (o < tv[i].sz); o += n, j++) {
+            n = ((j & 1) == 0) ? 500 : 17;
+            if (n > tv[i].sz - o)
+                n = tv[i].sz - o;
+            ret = wc_AesGcmDecryptUpdate(aes, dec + o, ct + o, n, NULL, 0);
+        }
+        if (ret == 0)
+            ret = wc_AesGcmDecryptFinal(aes, tv[i].tag, sizeof(tag));
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        if (XMEMCMP(dec, pt, tv[i].sz) != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), out);
+    #endif
+    #endif /* WOLFSSL_AESGCM_STREAM */
+    }
+    ret = 0;
+
+out:
+    XFREE(buf, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    return ret;
+}
+#endif /* WOLFSSL_AESGCM_VAES && WOLFSSL_AES_256 && !WOLFSSL_NO_MALLOC */
+
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t aesgcm_test(void)
 {
 #if defined(WOLFSSL_SMALL_STACK) && !defined(WOLFSSL_NO_MALLOC)
@@ -13610,6 +13888,13 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t aesgcm_test(void)
 #endif /* WOLFSSL_AES_256 */
 #endif /* !WOLFSSL_AFALG_XILINX_AES && !WOLFSSL_XILINX_CRYPT */
 
+#if defined(WOLFSSL_AESGCM_VAES) && defined(WOLFSSL_AES_256) && \
+    !defined(WOLFSSL_NO_MALLOC)
+    ret = aesgcm_vaes_test(enc);
+    if (ret != 0)
+        goto out;
+#endif
+
     wc_AesFree(enc);
     wc_AesFree(dec);
 
@@ -50298,6 +50583,61 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t cryptocb_test(void)
 
     return ret;
 }
+
+#ifdef WOLF_CRYPTO_CB_POOL
+/* Public key tests with their keys on a worker pool device */
+WOLFSSL_TEST_SUBROUTINE wc_test_ret_t cryptocb_pool_test(void)
+{
+    wc_test_ret_t ret = 0;
+    int origDevId = devId;
+    wc_CryptoCbPool* pool = NULL;
+    WOLFSSL_ENTER("cryptocb_pool_test");
+
+    if (wc_CryptoCbPool_New(NULL, 2, 2, 0, HEAP_HINT) != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_CryptoCbPool_New(&pool, INVALID_DEVID, 2, 0, HEAP_HINT) !=
+            BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_CryptoCbPool_New(&pool, 2, 0, 0, HEAP_HINT) != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_CryptoCbPool_New(&pool, 2, WC_CRYPTOCB_POOL_MAX_THREADS + 1, 0,
+            HEAP_HINT) != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_NC;
+
+    devId = 2;
+    ret = wc_CryptoCbPool_New(&pool, devId, 2, 0, HEAP_HINT);
+    if (ret != 0) {
+        devId = origDevId;
+        return WC_TEST_RET_ENC_EC(ret);
+    }
+#if !defined(NO_RSA)
+    PRIVATE_KEY_UNLOCK();
+    if (ret == 0)
+        ret = rsa_test();
+    PRIVATE_KEY_LOCK();
+#endif
+#if defined(HAVE_ECC)
+    PRIVATE_KEY_UNLOCK();
+    if (ret == 0)
+        ret = ecc_test();
+    PRIVATE_KEY_LOCK();
+#endif
+#ifdef HAVE_ED25519
+    if (ret == 0)
+        ret = ed25519_test();
+#endif
+#ifdef HAVE_CURVE25519
+    if (ret == 0)
+        ret = curve25519_test();
+#endif
+    wc_CryptoCbPool_Free(pool);
+
+    /* restore devId */
+    devId = origDevId;
+
+    return ret;
+}
+#endif /* WOLF_CRYPTO_CB_POOL */
 #endif /* WOLF_CRYPTO_CB */
 
 #ifdef WOLFSSL_CERT_PIV
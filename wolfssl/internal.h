@@ -2332,8 +2332,55 @@ typedef struct {
     word32 bufferSize;   /* current buffer size */
     byte   dynamicFlag;  /* dynamic memory currently in use */
     byte   offset;       /* alignment offset attempt */
+    byte   pooled;       /* dynamic buffer borrowed from ctx->recordPool */
 } bufferStatic;
 
+/* Pool of record sized buffers shared by the connections of a CTX, see
+ * wolfSSL_CTX_set_record_pool(). The static memory allocator has its own I/O
+ * buffer pools. */
+#if defined(WOLFSSL_STATIC_MEMORY) && !defined(WOLFSSL_NO_RECORD_POOL)
+    #define WOLFSSL_NO_RECORD_POOL
+#endif
+#ifndef WOLFSSL_NO_RECORD_POOL
+/* default usable size of a pooled buffer: one full size record */
+#ifndef WOLFSSL_RECORD_POOL_BUF_SZ
+    #define WOLFSSL_RECORD_POOL_BUF_SZ (DTLS_RECORD_HEADER_SZ + \
+             MAX_RECORD_SIZE + COMP_EXTRA + MTU_EXTRA + MAX_MSG_EXTRA)
+#endif
+/* room for the alignment Grow{In,Out}putBuffer apply on top */
+#define RECORD_POOL_SLACK (16 + WOLFSSL_GENERAL_ALIGNMENT)
+/* number of freelists, each thread sticks to one */
+#ifndef WOLFSSL_RECORD_POOL_LISTS
+    #ifdef SINGLE_THREADED
+        #define WOLFSSL_RECORD_POOL_LISTS 1
+    #else
+        #define WOLFSSL_RECORD_POOL_LISTS 8
+    #endif
+#endif
+#if WOLFSSL_RECORD_POOL_LISTS < 1 || WOLFSSL_RECORD_POOL_LISTS > 255
+    #error WOLFSSL_RECORD_POOL_LISTS must be between 1 and 255
+#endif
+
+typedef struct RecordPoolList {
+#ifndef SINGLE_THREADED
+    wolfSSL_Mutex lock;
+#endif
+    byte*         head;      /* idle buffers, linked through first bytes */
+    word32        idle;      /* buffers on head */
+    word32        maxIdle;   /* idle buffers kept, the rest are freed */
+    word32        inUse;     /* buffers lent to connections */
+    word32        peakInUse; /* high-water mark of inUse */
+    unsigned long gets;      /* buffers handed out */
+    unsigned long hits;      /* handed out without allocating */
+} RecordPoolList;
+
+typedef struct RecordPool {
+    RecordPoolList list[WOLFSSL_RECORD_POOL_LISTS];
+    void*          heap;
+    word32         bufSz;    /* usable bytes per buffer */
+} RecordPool;
+#endif /* !WOLFSSL_NO_RECORD_POOL */
+
 /* Cipher Suites holder */
 struct Suites {
     word16 suiteSz;                 /* suite length in bytes        */
@@ -2654,6 +2701,56 @@ WOLFSSL_LOCAL int CM_VerifyBuffer_ex(WOLFSSL_CERT_MANAGER* cm, const byte* buff,
                                      long sz, int format, int prev_err);
 
 
+#ifdef WOLFSSL_CHAIN_VERIFY_POOL
+#if defined(SINGLE_THREADED) || !defined(WOLFSSL_COND) || \
+    defined(NO_CERTS) || defined(WOLFSSL_SMALL_CERT_VERIFY)
+    #error WOLFSSL_CHAIN_VERIFY_POOL needs threads, WOLFSSL_COND and full certs
+#endif
+#ifndef WOLFSSL_CHAIN_VERIFY_MAX_WORKERS
+    #define WOLFSSL_CHAIN_VERIFY_MAX_WORKERS 64
+#endif
+
+typedef struct ChainVerifyBatch ChainVerifyBatch;
+
+/* Signature check of one chain cert against the key of the cert above it */
+typedef struct ChainVerifyJob {
+    struct ChainVerifyJob* next;     /* pool queue link */
+    ChainVerifyBatch*      batch;
+    const byte*            cert;     /* cert whose signature is checked */
+    word32                 certSz;
+    const byte*            issuer;   /* cert holding the signing key */
+    word32                 issuerSz;
+    byte*                  key;      /* issuer public key, owned */
+    word32                 keySz;
+    word32                 keyOID;
+    int                    ret;
+    byte                   done;
+} ChainVerifyJob;
+
+/* Jobs of one peer Certificate message */
+struct ChainVerifyBatch {
+    COND_TYPE       cond;            /* signalled as jobs complete */
+    ChainVerifyJob* jobs;
+    int             count;
+    void*           heap;
+};
+
+/* Worker threads shared by the connections of a CTX, see
+ * wolfSSL_CTX_set_verify_workers() */
+typedef struct ChainVerifyPool {
+    COND_TYPE       cond;            /* signalled as jobs are queued */
+    ChainVerifyJob* head;
+    ChainVerifyJob* tail;
+    THREAD_TYPE*    threads;
+    int             workers;
+    int             stop;
+    void*           heap;
+} ChainVerifyPool;
+
+WOLFSSL_LOCAL int  ChainVerifyPoolSet(WOLFSSL_CTX* ctx, int workers);
+WOLFSSL_LOCAL void ChainVerifyPoolFree(WOLFSSL_CTX* ctx);
+#endif /* WOLFSSL_CHAIN_VERIFY_POOL */
+
 #ifndef NO_CERTS
 #if !defined(NO_WOLFSSL_CLIENT) || !defined(WOLFSSL_NO_CLIENT_AUTH)
 typedef struct ProcPeerCertArgs {
@@ -2662,6 +2759,9 @@ typedef struct ProcPeerCertArgs {
     buffer*      exts; /* extensions */
 #endif
     DecodedCert* dCert;
+#ifdef WOLFSSL_CHAIN_VERIFY_POOL
+    ChainVerifyBatch* batch; /* chain signatures checked by ctx workers */
+#endif
     word32 idx;
     word32 begin;
     int    totalCerts; /* number of certs in certs buffer */
@@ -3308,6 +3408,39 @@ typedef struct SessionTicket {
 
 #if !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) && !defined(NO_WOLFSSL_SERVER)
 
+#ifdef WOLFSSL_TICKET_KEY_SET
+#if WOLFSSL_TICKET_KEY_SET_MAX < 1 || WOLFSSL_TICKET_KEY_SET_MAX > 127
+    #error "WOLFSSL_TICKET_KEY_SET_MAX must be 1 to 127"
+#endif
+/* Buckets of key name index - twice the keys to keep probes short. */
+#define WOLFSSL_TICKET_KEY_SET_BUCKETS      (2 * WOLFSSL_TICKET_KEY_SET_MAX)
+
+/* Operator supplied ticket keys. Accessed under the key context mutex. */
+typedef struct TicketKeySet {
+    WOLFSSL_TICKET_KEY key[WOLFSSL_TICKET_KEY_SET_MAX];
+    /* Index + 1 of key with name in bucket, 0 when empty. */
+    byte bucket[WOLFSSL_TICKET_KEY_SET_BUCKETS];
+    /* Number of keys. */
+    int cnt;
+} TicketKeySet;
+
+#if !(defined(HAVE_CHACHA) && defined(HAVE_POLY1305) && \
+      !defined(WOLFSSL_TICKET_ENC_AES128_GCM) && \
+      !defined(WOLFSSL_TICKET_ENC_AES256_GCM)) && defined(HAVE_AESGCM)
+    /* AES-GCM key set up once for all tickets sent by a connection. */
+    #define WOLFSSL_TICKET_ENC_BATCH
+
+/* Ticket cipher kept while a connection sends a number of tickets. */
+typedef struct TicketEncBatch {
+    Aes  aes;
+    /* Key the cipher is set up with. */
+    byte key[WOLFSSL_TICKET_KEY_SZ];
+    /* Whether the cipher has a key. */
+    byte ready;
+} TicketEncBatch;
+#endif
+#endif /* WOLFSSL_TICKET_KEY_SET */
+
 /* Data passed to default SessionTicket enc/dec callback. */
 typedef struct TicketEncCbCtx {
     /* Name for this context. */
@@ -3324,6 +3457,10 @@ typedef struct TicketEncCbCtx {
 #endif
     /* Pointer back to SSL_CTX. */
     WOLFSSL_CTX* ctx;
+#ifdef WOLFSSL_TICKET_KEY_SET
+    /* Operator keys - none when count is 0. */
+    TicketKeySet keySet;
+#endif
 } TicketEncCbCtx;
 
 #endif /* !WOLFSSL_NO_DEF_TICKET_ENC_CB && !NO_WOLFSSL_SERVER */
@@ -3357,6 +3494,13 @@ WOLFSSL_LOCAL int TLSX_Cookie_Use(const WOLFSSL* ssl, const byte* data,
 WOLFSSL_LOCAL int TlsCheckCookie(const WOLFSSL* ssl, const byte* cookie,
                                  word16 cookieSz);
 
+#ifdef WOLFSSL_STATELESS_HRR
+#if !defined(WOLFSSL_TLS13) || !defined(WOLFSSL_SEND_HRR_COOKIE) || \
+    !defined(HAVE_SUPPORTED_CURVES)
+    #error WOLFSSL_STATELESS_HRR needs TLS 1.3 and WOLFSSL_SEND_HRR_COOKIE
+#endif
+#endif
+
 
 /* Key Share - TLS v1.3 Specification */
 
@@ -3395,6 +3539,90 @@ WOLFSSL_LOCAL int TLSX_KeyShare_Parse(WOLFSSL* ssl, const byte* input,
         word16 length, byte msgType);
 WOLFSSL_LOCAL int TLSX_KeyShare_Parse_ClientHello(const WOLFSSL* ssl,
         const byte* input, word16 length, TLSX** extensions);
+
+#ifdef WOLFSSL_KEY_SHARE_POOL
+#if !defined(WOLFSSL_TLS13) || !defined(HAVE_SUPPORTED_CURVES) || \
+    (!defined(SINGLE_THREADED) && !defined(WOLFSSL_COND))
+    #error WOLFSSL_KEY_SHARE_POOL needs TLS 1.3 and, with threads, WOLFSSL_COND
+#endif
+#ifndef WOLFSSL_KEY_SHARE_POOL_GROUPS
+    #define WOLFSSL_KEY_SHARE_POOL_GROUPS 4
+#endif
+#ifndef WOLFSSL_KEY_SHARE_POOL_MAX
+    #define WOLFSSL_KEY_SHARE_POOL_MAX 4096
+#endif
+
+/* Ephemeral key pair made ahead of the one handshake that uses it */
+typedef struct KeySharePoolEntry {
+    struct KeySharePoolEntry* next;
+    void*  key;        /* curve25519_key or ecc_key, NULL for Kyber */
+    word32 keyLen;
+    byte*  pubKey;
+    word32 pubKeyLen;
+#ifdef HAVE_PQC
+    byte*  privKey;    /* Kyber private key */
+    word32 privKeyLen;
+#endif
+} KeySharePoolEntry;
+
+/* Ready key pairs of one named group */
+typedef struct KeySharePoolGroup {
+    KeySharePoolEntry* head;
+    unsigned long      used;      /* key pairs handed to handshakes */
+    unsigned long      underruns; /* handshakes that found none ready */
+    word32             ready;
+    word32             making;    /* being generated now */
+    word32             size;      /* refilled up to */
+    word16             group;     /* 0 when the slot is free */
+} KeySharePoolGroup;
+
+/* Key pairs for the key shares of the handshakes of a CTX, see
+ * wolfSSL_CTX_set_keyshare_pool() */
+typedef struct KeySharePool {
+#ifndef SINGLE_THREADED
+    COND_TYPE         cond;      /* guards the groups, wakes the filler */
+    wolfSSL_Mutex     rngLock;   /* key generation */
+    THREAD_TYPE       thread;
+    byte              threadOn;
+    byte              stop;
+#endif
+    WC_RNG            rng;
+    KeySharePoolGroup groups[WOLFSSL_KEY_SHARE_POOL_GROUPS];
+    void*             heap;
+} KeySharePool;
+
+WOLFSSL_LOCAL int  KeySharePoolSet(WOLFSSL_CTX* ctx, word16 group,
+                                   word32 size);
+WOLFSSL_LOCAL int  KeySharePoolFill(WOLFSSL_CTX* ctx, int max);
+WOLFSSL_LOCAL int  KeySharePoolStart(WOLFSSL_CTX* ctx);
+WOLFSSL_LOCAL int  KeySharePoolGetStats(WOLFSSL_CTX* ctx, word16 group,
+                                        WOLFSSL_KEYSHARE_POOL_STATS* stats);
+WOLFSSL_LOCAL void KeySharePoolFree(WOLFSSL_CTX* ctx);
+#endif /* WOLFSSL_KEY_SHARE_POOL */
+
+#ifdef WOLFSSL_CERT_MSG_CACHE
+#if !defined(WOLFSSL_TLS13) || defined(NO_WOLFSSL_SERVER) || defined(NO_CERTS)
+    #error WOLFSSL_CERT_MSG_CACHE needs TLS 1.3, the server and certificates
+#endif
+
+/* Body of the TLS 1.3 Certificate message of the certificate and chain of a
+ * CTX, encoded once and copied into the handshakes of the server */
+typedef struct CertMsgCache {
+#ifndef SINGLE_THREADED
+    wolfSSL_Mutex lock;
+#endif
+    byte*  msg;
+    word32 msgSz;
+    word32 msgGen;  /* certGen when msg was encoded */
+    word32 certGen; /* bumped when the certificate or chain changes */
+    byte   off;
+} CertMsgCache;
+
+/* Call after changing the certificate or chain of the CTX */
+#define CertMsgCacheReset(ctx) ((ctx)->certMsgCache.certGen++)
+#else
+#define CertMsgCacheReset(ctx) WC_DO_NOTHING
+#endif /* WOLFSSL_CERT_MSG_CACHE */
 #ifdef WOLFSSL_DUAL_ALG_CERTS
 WOLFSSL_LOCAL int TLSX_CKS_Parse(WOLFSSL* ssl, byte* input,
                                  word16 length, TLSX** extensions);
@@ -3621,8 +3849,13 @@ struct WOLFSSL_CTX {
     byte        quietShutdown:1;  /* don't send close notify */
     byte        groupMessages:1;  /* group handshake messages before sending */
     byte        minDowngrade;     /* minimum downgrade version */
+    byte        sendBatch;        /* app data records built per flush */
     byte        haveEMS:1;        /* have extended master secret extension */
     byte        useClientOrder:1; /* Use client's cipher preference order */
+    byte        autoCompact:1;    /* compact connections after handshake */
+#ifdef WOLFSSL_KTLS
+    byte        useKtls:1;        /* offload record layer to kernel TLS */
+#endif
 #if defined(HAVE_SESSION_TICKET)
     byte        noTicketTls12:1;  /* TLS 1.2 server won't send ticket */
 #endif
@@ -3720,6 +3953,25 @@ struct WOLFSSL_CTX {
 #endif /* WOLFSSL_WOLFSENTRY_HOOKS */
     CallbackIORecv CBIORecv;
     CallbackIOSend CBIOSend;
+#ifdef WOLFSSL_IO_URING
+    WOLFSSL_URING* uring;               /* ring of the io_uring callbacks */
+#endif
+#ifndef WOLFSSL_NO_RECORD_POOL
+    RecordPool*    recordPool;          /* record buffers lent to conns */
+#endif
+#ifdef WOLFSSL_CHAIN_VERIFY_POOL
+    ChainVerifyPool* verifyPool;        /* workers checking peer chains */
+#endif
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    KeySharePool*  keySharePool;        /* key share key pairs made ahead */
+#endif
+#ifdef WOLFSSL_CERT_MSG_CACHE
+    CertMsgCache   certMsgCache;        /* encoded Certificate message */
+#endif
+#ifdef WOLFSSL_STATELESS_HRR
+    byte*          hrrCookieSecret;     /* HRR cookie key of all conns */
+    word32         hrrCookieSecretSz;
+#endif
 #ifdef WOLFSSL_DTLS
     CallbackGenCookie CBIOCookie;       /* gen cookie callback */
 #endif /* WOLFSSL_DTLS */
@@ -3938,6 +4190,12 @@ struct WOLFSSL_CTX {
 #if defined(HAVE_EXT_CACHE) || defined(HAVE_EX_DATA)
     Rem_Sess_Cb rem_sess_cb;
 #endif
+#ifdef WOLFSSL_SESSION_STORE
+    CallbackSessionStoreGet    sessStoreGetCb;
+    CallbackSessionStoreSet    sessStoreSetCb;
+    CallbackSessionStoreRemove sessStoreRemoveCb;
+    void*                      sessStoreCtx;
+#endif
 #if defined(OPENSSL_EXTRA) && defined(WOLFCRYPT_HAVE_SRP) && !defined(NO_SHA256)
     Srp*  srp;  /* TLS Secure Remote Password Protocol*/
     byte* srp_password;
@@ -4446,6 +4704,10 @@ WOLFSSL_API int wolfSSL_GetSessionFromCache(WOLFSSL* ssl, WOLFSSL_SESSION* outpu
 WOLFSSL_LOCAL int wolfSSL_SetSession(WOLFSSL* ssl, WOLFSSL_SESSION* session);
 WOLFSSL_LOCAL void wolfSSL_FreeSession(WOLFSSL_CTX* ctx,
         WOLFSSL_SESSION* session);
+#ifdef WOLFSSL_SESSION_STORE
+WOLFSSL_LOCAL int SessionStorePrefetch(WOLFSSL* ssl, const byte* input,
+        word32 helloSz);
+#endif
 WOLFSSL_LOCAL int wolfSSL_DupSession(const WOLFSSL_SESSION* input,
         WOLFSSL_SESSION* output, int avoidSysCalls);
 
@@ -4531,6 +4793,8 @@ typedef struct Buffers {
                                               when got WANT_WRITE            */
     int             plainSz;               /* plain text bytes in buffer to send
                                               when got WANT_WRITE            */
+    byte            clearOutputPinned;     /* clearOutputBuffer is viewed by
+                                              wolfSSL_read_zc()              */
     byte            weOwnCert;             /* SSL own cert flag */
     byte            weOwnCertChain;        /* SSL own cert chain flag */
     byte            weOwnKey;              /* SSL own key flag */
@@ -4651,6 +4915,9 @@ struct Options {
 #ifdef HAVE_EXT_CACHE
     word16            internalCacheOff:1;
     word16            internalCacheLookupOff:1;
+#endif
+#ifdef WOLFSSL_SESSION_STORE
+    word16            sessionStoreDone:1; /* external store looked up */
 #endif
     word16            side:2;             /* client, server or neither end */
     word16            verifyPeer:1;
@@ -4716,6 +4983,9 @@ struct Options {
 #ifdef WOLFSSL_TLS13
     word16            noTicketTls13:1;    /* Server won't create new Ticket */
 #endif
+#ifdef WOLFSSL_TICKET_ENC_BATCH
+    word16            ticketEncBatch:1;   /* Keep ticket cipher set up */
+#endif
 #endif
 #ifdef WOLFSSL_DTLS
 #ifdef HAVE_SECURE_RENEGOTIATION
@@ -4733,6 +5003,7 @@ struct Options {
     word16            userCurves:1;       /* indicates user called wolfSSL_UseSupportedCurve */
 #endif
     word16            keepResources:1;    /* Keep resources after handshake */
+    word16            autoCompact:1;      /* CompactIdle() after handshake */
     word16            useClientOrder:1;   /* Use client's cipher order */
     word16            mutualAuth:1;       /* Mutual authentication is required */
     word16            peerAuthGood:1;     /* Any required peer auth done */
@@ -4748,6 +5019,10 @@ struct Options {
 #if defined(WOLFSSL_TLS13) && !defined(NO_WOLFSSL_SERVER)
     word16            sendCookie:1;       /* Server creates a Cookie in HRR */
 #endif
+#ifdef WOLFSSL_STATELESS_HRR
+    word16            statelessHrr:1;     /* HRR made without conn state */
+    word16            sendingStatelessHrr:1; /* HRR from stack ClientHello */
+#endif
 #ifdef WOLFSSL_ALT_CERT_CHAINS
     word16            usingAltCertChain:1;/* Alternate cert chain was used */
 #endif
@@ -4779,6 +5054,15 @@ struct Options {
 #endif
     word16            buildingMsg:1;      /* If set then we need to re-enter the
                                            * handshake logic. */
+#ifdef WOLFSSL_KTLS
+    word16            useKtls:1;          /* offload record layer to kernel */
+    word16            ktlsUlp:1;          /* kTLS attached to the socket */
+    word16            ktlsTx:1;           /* kernel encrypts sent records */
+    word16            ktlsRx:1;           /* kernel decrypts received records */
+    word16            ktlsTxOff:1;        /* transmit stays in user space */
+    word16            ktlsRxOff:1;        /* receive stays in user space */
+    word16            ktlsTxRekey:1;      /* new keys wait for queued records */
+#endif
 #ifdef WOLFSSL_DTLS13
     word16            dtls13SendMoreAcks:1;  /* Send more acks during the
                                               * handshake process */
@@ -5470,7 +5754,14 @@ struct WOLFSSL {
 #endif
     void*           IOCB_ReadCtx;
     void*           IOCB_WriteCtx;
+#ifdef WOLFSSL_IO_URING
+    WOLFSSL_URING*    uring;            /* ring of the io_uring callbacks */
+    struct UringConn* uringConn;        /* this connection's slot in ring */
+#endif
     WC_RNG*         rng;
+#ifdef WOLFSSL_TICKET_ENC_BATCH
+    TicketEncBatch* ticketEncBatch;     /* cipher kept across tickets */
+#endif
     void*           verifyCbCtx;        /* cert verify callback user ctx*/
     VerifyCallback  verifyCallback;     /* cert verification callback */
     void*           heap;               /* for user overrides */
@@ -5529,6 +5820,9 @@ struct WOLFSSL {
     WOLFSSL_SESSION* session;
 #ifndef NO_CLIENT_CACHE
     ClientSession*  clientSession;
+#endif
+#ifdef WOLFSSL_SESSION_STORE
+    WOLFSSL_SESSION* storeSession;      /* session found in external store */
 #endif
     WOLFSSL_ALERT_HISTORY alert_history;
     WOLFSSL_ALERT   pendingAlert;
@@ -5738,6 +6032,10 @@ struct WOLFSSL {
                                             flag found in buffers.weOwnCert) */
 #endif
     byte             keepCert;           /* keep certificate after handshake */
+    byte             sendBatch;          /* app data records built per flush */
+#ifndef WOLFSSL_NO_RECORD_POOL
+    byte             recordPoolList;     /* ctx->recordPool list borrowed from */
+#endif
 #ifdef HAVE_EX_DATA
     WOLFSSL_CRYPTO_EX_DATA ex_data; /* external data, for Fortress */
 #endif
@@ -6141,8 +6439,23 @@ WOLFSSL_LOCAL int DoClientTicket_ex(const WOLFSSL* ssl, PreSharedKey* psk,
 #endif
 
 WOLFSSL_LOCAL int DoClientTicket(WOLFSSL* ssl, const byte* input, word32 len);
+#if defined(WOLFSSL_TICKET_KEY_SET) && !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) \
+    && !defined(NO_WOLFSSL_SERVER)
+WOLFSSL_LOCAL int TicketEncCbCtx_SetKeys(TicketEncCbCtx* keyCtx,
+                                         const WOLFSSL_TICKET_KEY* keys,
+                                         int cnt);
+#endif
+#ifdef WOLFSSL_TICKET_ENC_BATCH
+WOLFSSL_LOCAL void FreeTicketEncBatch(WOLFSSL* ssl);
+#endif
 #endif /* HAVE_SESSION_TICKET */
 WOLFSSL_LOCAL int SendData(WOLFSSL* ssl, const void* data, int sz);
+#if !defined(USE_WINDOWS_API) && !defined(NO_WRITEV)
+    /* records are built straight from the caller's iovecs */
+    #define WOLFSSL_SEND_GATHER
+WOLFSSL_LOCAL int SendDataV(WOLFSSL* ssl, const struct iovec* iov, int iovcnt,
+                            int sz);
+#endif
 #ifdef WOLFSSL_TLS13
 WOLFSSL_LOCAL int SendTls13ServerHello(WOLFSSL* ssl, byte extMsgType);
 #endif
@@ -6161,6 +6474,19 @@ WOLFSSL_LOCAL int SendCertificateStatus(WOLFSSL* ssl);
 WOLFSSL_LOCAL int SendServerKeyExchange(WOLFSSL* ssl);
 WOLFSSL_LOCAL int SendBuffered(WOLFSSL* ssl);
 WOLFSSL_LOCAL int ReceiveData(WOLFSSL* ssl, byte* output, int sz, int peek);
+WOLFSSL_LOCAL int ReceiveDataView(WOLFSSL* ssl, const byte** data);
+WOLFSSL_LOCAL int ReleaseReceivedData(WOLFSSL* ssl, int sz);
+#ifdef WOLFSSL_KTLS
+WOLFSSL_LOCAL void KtlsTryEnable(WOLFSSL* ssl);
+WOLFSSL_LOCAL int KtlsInit(WOLFSSL* ssl);
+WOLFSSL_LOCAL int KtlsSetKeys(WOLFSSL* ssl, int tx);
+WOLFSSL_LOCAL int KtlsSend(WOLFSSL* ssl, byte* buf, int sz);
+WOLFSSL_LOCAL int KtlsReceive(WOLFSSL* ssl, byte* buf, int sz);
+WOLFSSL_LOCAL int KtlsSendFile(WOLFSSL* ssl, int fd, off_t* offset, int sz);
+#endif
+#ifdef WOLFSSL_IO_URING
+WOLFSSL_LOCAL void UringDetach(WOLFSSL* ssl);
+#endif
 WOLFSSL_LOCAL int SendFinished(WOLFSSL* ssl);
 WOLFSSL_LOCAL int RetrySendAlert(WOLFSSL* ssl);
 WOLFSSL_LOCAL int SendAlert(WOLFSSL* ssl, int severity, int type);
@@ -6185,8 +6511,18 @@ WOLFSSL_LOCAL int IsEncryptionOn(const WOLFSSL* ssl, int isSend);
 WOLFSSL_LOCAL int TLSv1_3_Capable(WOLFSSL* ssl);
 
 WOLFSSL_LOCAL void FreeHandshakeResources(WOLFSSL* ssl);
+WOLFSSL_LOCAL void CompactIdle(WOLFSSL* ssl);
+WOLFSSL_LOCAL word32 CompactSSL(WOLFSSL* ssl);
 WOLFSSL_LOCAL void ShrinkInputBuffer(WOLFSSL* ssl, int forcedFree);
 WOLFSSL_LOCAL void ShrinkOutputBuffer(WOLFSSL* ssl);
+#ifndef WOLFSSL_NO_RECORD_POOL
+WOLFSSL_LOCAL int  RecordPoolSet(WOLFSSL_CTX* ctx, word32 maxIdle,
+                                 word32 bufSz);
+WOLFSSL_LOCAL void RecordPoolGetStats(WOLFSSL_CTX* ctx,
+                                      WOLFSSL_RECORD_POOL_STATS* stats);
+WOLFSSL_LOCAL void RecordPoolFree(WOLFSSL_CTX* ctx);
+WOLFSSL_LOCAL void RecordPoolDetach(WOLFSSL* ssl);
+#endif
 WOLFSSL_LOCAL byte* GetOutputBuffer(WOLFSSL* ssl);
 
 WOLFSSL_LOCAL int CipherRequires(byte first, byte second, int requirement);
@@ -6526,6 +6862,11 @@ WOLFSSL_LOCAL void FreeBuildMsgArgs(WOLFSSL* ssl, BuildMsgArgs* args);
 WOLFSSL_LOCAL int BuildMessage(WOLFSSL* ssl, byte* output, int outSz,
                         const byte* input, int inSz, int type, int hashOutput,
                         int sizeOnly, int asyncOkay, int epochOrder);
+#ifdef WOLFSSL_KTLS
+WOLFSSL_LOCAL int BuildKtlsMessage(WOLFSSL* ssl, byte* output, int outSz,
+                        const byte* input, int inSz, int type, int hashOutput,
+                        int sizeOnly);
+#endif
 
 #ifdef WOLFSSL_TLS13
 /* Use WOLFSSL_API to use this function in tests/api.c */
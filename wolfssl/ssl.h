@@ -835,6 +835,24 @@ enum Tls13Secret {
 #define WOLFSSL_MODE_AUTO_RETRY_ATTEMPTS 10
 #endif
 
+/* Number of application data records a write builds back-to-back before
+ * flushing them with one send. WOLFSSL_SEND_BATCH is the default (1, a send
+ * per record), wolfSSL_CTX_set_send_batch() accepts up to
+ * WOLFSSL_MAX_SEND_BATCH. Each batched record adds a maximum sized record to
+ * the output buffer. */
+#ifndef WOLFSSL_MAX_SEND_BATCH
+    #define WOLFSSL_MAX_SEND_BATCH 16
+#endif
+#ifndef WOLFSSL_SEND_BATCH
+    #define WOLFSSL_SEND_BATCH 1
+#endif
+#if WOLFSSL_MAX_SEND_BATCH < 1 || WOLFSSL_MAX_SEND_BATCH > 255
+    #error WOLFSSL_MAX_SEND_BATCH must be between 1 and 255
+#endif
+#if WOLFSSL_SEND_BATCH < 1 || WOLFSSL_SEND_BATCH > WOLFSSL_MAX_SEND_BATCH
+    #error WOLFSSL_SEND_BATCH must be between 1 and WOLFSSL_MAX_SEND_BATCH
+#endif
+
 typedef WOLFSSL_METHOD* (*wolfSSL_method_func)(void* heap);
 
 /* CTX Method Constructor Functions */
@@ -1174,6 +1192,46 @@ WOLFSSL_ABI WOLFSSL_API int  wolfSSL_write(
     WOLFSSL* ssl, const void* data, int sz);
 WOLFSSL_ABI WOLFSSL_API int  wolfSSL_read(WOLFSSL* ssl, void* data, int sz);
 WOLFSSL_API int  wolfSSL_peek(WOLFSSL* ssl, void* data, int sz);
+WOLFSSL_API int  wolfSSL_read_zc(WOLFSSL* ssl, const unsigned char** data);
+WOLFSSL_API int  wolfSSL_read_release(WOLFSSL* ssl, int sz);
+WOLFSSL_API int  wolfSSL_CTX_set_send_batch(WOLFSSL_CTX* ctx, int records);
+WOLFSSL_API int  wolfSSL_set_send_batch(WOLFSSL* ssl, int records);
+WOLFSSL_API int  wolfSSL_get_send_batch(const WOLFSSL* ssl);
+
+/* Usage of the record buffer pool of a CTX, see
+ * wolfSSL_CTX_set_record_pool(). */
+typedef struct WOLFSSL_RECORD_POOL_STATS {
+    unsigned long gets;      /* buffers handed to connections */
+    unsigned long hits;      /* of those, reused without allocating */
+    unsigned int  inUse;     /* buffers held by connections now */
+    unsigned int  peakInUse; /* high-water mark of inUse, per list summed */
+    unsigned int  idle;      /* buffers kept by the pool for reuse */
+    unsigned int  bufSz;     /* usable bytes per buffer */
+} WOLFSSL_RECORD_POOL_STATS;
+
+WOLFSSL_API int  wolfSSL_CTX_set_record_pool(WOLFSSL_CTX* ctx, int maxIdle,
+                                             int bufSz);
+WOLFSSL_API int  wolfSSL_CTX_get_record_pool_stats(WOLFSSL_CTX* ctx,
+                                          WOLFSSL_RECORD_POOL_STATS* stats);
+WOLFSSL_API int  wolfSSL_CTX_set_verify_workers(WOLFSSL_CTX* ctx, int workers);
+
+/* Counters of one named group of the key share pool, see
+ * wolfSSL_CTX_set_keyshare_pool(). */
+typedef struct WOLFSSL_KEYSHARE_POOL_STATS {
+    unsigned long used;      /* key pairs handed to handshakes */
+    unsigned long underruns; /* handshakes that found none ready */
+    unsigned int  ready;     /* key pairs waiting in the pool */
+    unsigned int  size;      /* number the group is refilled up to */
+} WOLFSSL_KEYSHARE_POOL_STATS;
+
+WOLFSSL_API int  wolfSSL_CTX_set_keyshare_pool(WOLFSSL_CTX* ctx,
+                                               word16 group, int size);
+WOLFSSL_API int  wolfSSL_CTX_keyshare_pool_fill(WOLFSSL_CTX* ctx, int max);
+WOLFSSL_API int  wolfSSL_CTX_keyshare_pool_start(WOLFSSL_CTX* ctx);
+WOLFSSL_API int  wolfSSL_CTX_get_keyshare_pool_stats(WOLFSSL_CTX* ctx,
+                        word16 group, WOLFSSL_KEYSHARE_POOL_STATS* stats);
+WOLFSSL_API int  wolfSSL_CTX_set_cert_msg_cache(WOLFSSL_CTX* ctx, int on);
+
 WOLFSSL_ABI WOLFSSL_API int  wolfSSL_accept(WOLFSSL* ssl);
 WOLFSSL_API int  wolfSSL_CTX_mutual_auth(WOLFSSL_CTX* ctx, int req);
 WOLFSSL_API int  wolfSSL_mutual_auth(WOLFSSL* ssl, int req);
@@ -1181,6 +1239,8 @@ WOLFSSL_API int  wolfSSL_mutual_auth(WOLFSSL* ssl, int req);
 WOLFSSL_API int  wolfSSL_send_hrr_cookie(WOLFSSL* ssl,
     const unsigned char* secret, unsigned int secretSz);
 WOLFSSL_API int  wolfSSL_disable_hrr_cookie(WOLFSSL * ssl);
+WOLFSSL_API int  wolfSSL_CTX_set_stateless_hrr(WOLFSSL_CTX* ctx,
+    const unsigned char* secret, unsigned int secretSz);
 WOLFSSL_API int  wolfSSL_CTX_no_ticket_TLSv13(WOLFSSL_CTX* ctx);
 WOLFSSL_API int  wolfSSL_no_ticket_TLSv13(WOLFSSL* ssl);
 WOLFSSL_API int  wolfSSL_CTX_no_dhe_psk(WOLFSSL_CTX* ctx);
@@ -3059,6 +3119,18 @@ WOLFSSL_API int wolfSSL_make_eap_keys(WOLFSSL* ssl, void* key, unsigned int len,
     #endif /* !NO_WRITEV */
 #endif /* !_WIN32 */
 
+#ifdef WOLFSSL_KTLS
+    /* directions offloaded to kernel TLS, see wolfSSL_get_ktls() */
+    #define WOLFSSL_KTLS_TX 0x1
+    #define WOLFSSL_KTLS_RX 0x2
+
+    WOLFSSL_API int  wolfSSL_CTX_UseKTLS(WOLFSSL_CTX* ctx);
+    WOLFSSL_API int  wolfSSL_UseKTLS(WOLFSSL* ssl);
+    WOLFSSL_API int  wolfSSL_get_ktls(const WOLFSSL* ssl);
+    WOLFSSL_API long wolfSSL_sendfile(WOLFSSL* ssl, int fd, off_t* offset,
+                                      size_t count);
+#endif
+
 
 #ifndef NO_CERTS
     /* SSL_CTX versions */
@@ -3731,6 +3803,9 @@ WOLFSSL_API void wolfSSL_FreeArrays(WOLFSSL* ssl);
 
 WOLFSSL_API int wolfSSL_KeepHandshakeResources(WOLFSSL* ssl);
 WOLFSSL_API int wolfSSL_FreeHandshakeResources(WOLFSSL* ssl);
+WOLFSSL_API int wolfSSL_compact(WOLFSSL* ssl);
+WOLFSSL_API int wolfSSL_CTX_set_auto_compact(WOLFSSL_CTX* ctx, int on);
+WOLFSSL_API int wolfSSL_set_auto_compact(WOLFSSL* ssl, int on);
 
 WOLFSSL_API int wolfSSL_CTX_UseClientSuites(WOLFSSL_CTX* ctx);
 WOLFSSL_API int wolfSSL_UseClientSuites(WOLFSSL* ssl);
@@ -4133,6 +4208,29 @@ WOLFSSL_API void* wolfSSL_CTX_get_TicketEncCtx(WOLFSSL_CTX* ctx);
 WOLFSSL_API size_t wolfSSL_CTX_get_num_tickets(WOLFSSL_CTX* ctx);
 WOLFSSL_API int wolfSSL_CTX_set_num_tickets(WOLFSSL_CTX* ctx, size_t mxTickets);
 
+typedef struct WOLFSSL_TICKET_KEY WOLFSSL_TICKET_KEY;
+#if defined(WOLFSSL_TICKET_KEY_SET) && !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB)
+    #ifndef WOLFSSL_TICKET_KEY_SET_MAX
+        /* Maximum number of keys in an operator key set. */
+        #define WOLFSSL_TICKET_KEY_SET_MAX  8
+    #endif
+    /* Size of key field - largest ticket cipher key. */
+    #define WOLFSSL_TICKET_KEY_MAX_SZ       32
+
+/* Key for the default session ticket callback supplied by the operator.
+ * Only the first WOLFSSL_TICKET_KEY_SZ bytes of key are used.
+ * Times are seconds on the clock of session timeouts (time() on POSIX). */
+struct WOLFSSL_TICKET_KEY {
+    unsigned char name[WOLFSSL_TICKET_NAME_SZ];   /* in ticket to find key */
+    unsigned char key[WOLFSSL_TICKET_KEY_MAX_SZ]; /* encryption key */
+    word32        encStart;    /* new tickets encrypted from this time */
+    word32        decEnd;      /* tickets decrypted until this time */
+};
+#endif
+WOLFSSL_API int wolfSSL_CTX_set_ticket_keys(WOLFSSL_CTX* ctx,
+                                            const WOLFSSL_TICKET_KEY* keys,
+                                            int cnt);
+
 #endif /* NO_WOLFSSL_SERVER */
 
 #endif /* HAVE_SESSION_TICKET */
@@ -4163,6 +4261,37 @@ WOLFSSL_API int wolfSSL_get_session_stats(unsigned int* active,
                                           unsigned int* total,
                                           unsigned int* peak,
                                           unsigned int* maxSessions);
+#ifdef WOLFSSL_SHARDED_SESSION_CACHE
+WOLFSSL_API int wolfSSL_CTX_set_session_cache_size(WOLFSSL_CTX* ctx,
+                                                   unsigned int sz);
+WOLFSSL_API unsigned int wolfSSL_CTX_get_session_cache_size(WOLFSSL_CTX* ctx);
+WOLFSSL_API int wolfSSL_get_session_cache_stats(unsigned int* hits,
+                                                unsigned int* misses,
+                                                unsigned int* evictions,
+                                                unsigned int* contention);
+#endif
+#ifdef WOLFSSL_SESSION_STORE
+/* External session store shared by servers that resume each other's
+ * sessions. Sessions are stored serialized with wolfSSL_i2d_SSL_SESSION.
+ * Get returns the serialized size, 0 when not found or
+ * WOLFSSL_CBIO_ERR_WANT_READ when the lookup is still in progress. */
+typedef int  (*CallbackSessionStoreGet)(WOLFSSL* ssl, const unsigned char* id,
+        int idSz, unsigned char* data, int dataSz, void* ctx);
+typedef int  (*CallbackSessionStoreSet)(WOLFSSL* ssl, const unsigned char* id,
+        int idSz, const unsigned char* data, int dataSz, word32 expire,
+        void* ctx);
+typedef void (*CallbackSessionStoreRemove)(const unsigned char* id, int idSz,
+        void* ctx);
+WOLFSSL_API int wolfSSL_CTX_SetSessionStore(WOLFSSL_CTX* ctx,
+        CallbackSessionStoreGet getCb, CallbackSessionStoreSet setCb,
+        CallbackSessionStoreRemove removeCb, void* storeCtx);
+#ifdef WOLFSSL_SESSION_STORE_SHM
+WOLFSSL_API int wolfSSL_SessionStoreShm_Size(int sessions);
+WOLFSSL_API int wolfSSL_SessionStoreShm_Init(void* mem, int memSz);
+WOLFSSL_API int wolfSSL_SessionStoreShm_Free(void* mem);
+WOLFSSL_API int wolfSSL_CTX_UseSessionStoreShm(WOLFSSL_CTX* ctx, void* mem);
+#endif
+#endif
 /* External facing KDF */
 WOLFSSL_API
 int wolfSSL_MakeTlsMasterSecret(unsigned char* ms, word32 msLen,
@@ -53,6 +53,11 @@ typedef struct Gcm {
         ALIGN16 byte M0[32][16];
     #endif
 #endif /* GCM_TABLE */
+#ifdef WOLFSSL_AESGCM_VAES
+    /* H^16..H^1 for AES-GCM with VAES, set when the CPU supports it. */
+    ALIGN16 byte HPow[16][16];
+    byte HPowSet;
+#endif
 } Gcm;
 
 WOLFSSL_LOCAL void GenerateM0(Gcm* gcm);
@@ -561,6 +566,29 @@ WOLFSSL_API int wc_AesGcmDecryptFinal(Aes* aes, const byte* authTag,
         word32 authTagSz);
 #endif
 
+#ifdef WOLFSSL_AESGCM_MULTI
+/* Independent AES-GCM operation for wc_AesGcmEncryptMulti() and
+ * wc_AesGcmDecryptMulti(). */
+typedef struct wc_AesGcmJob {
+    Aes*        aes;        /* key set with wc_AesGcmSetKey() */
+    byte*       out;        /* output, same size as in */
+    const byte* in;         /* plaintext or ciphertext */
+    word32      sz;         /* size of in and out */
+    const byte* iv;
+    word32      ivSz;
+    byte*       authTag;    /* tag made when encrypting, checked decrypting */
+    word32      authTagSz;
+    const byte* authIn;     /* additional authenticated data */
+    word32      authInSz;
+    int         ret;        /* result of this job */
+} wc_AesGcmJob;
+
+WOLFSSL_API int wc_AesGcmEncryptMulti(wc_AesGcmJob* jobs, word32 count);
+#if defined(HAVE_AES_DECRYPT) || defined(HAVE_AESGCM_DECRYPT)
+WOLFSSL_API int wc_AesGcmDecryptMulti(wc_AesGcmJob* jobs, word32 count);
+#endif
+#endif /* WOLFSSL_AESGCM_MULTI */
+
 #ifndef WC_NO_RNG
  WOLFSSL_API int  wc_AesGcmSetExtIV(Aes* aes, const byte* iv, word32 ivSz);
  WOLFSSL_API int  wc_AesGcmSetIV(Aes* aes, word32 ivSz,
@@ -658,6 +686,28 @@ WOLFSSL_API int wc_AesXtsDecryptConsecutiveSectors(XtsAes* aes,
         byte* out, const byte* in, word32 sz, word64 sector,
         word32 sectorSz);
 
+#ifdef WOLFSSL_AESXTS_THREADS
+#if defined(SINGLE_THREADED) || defined(WOLFSSL_LINUXKM) || \
+    defined(WOLFSSL_NO_MALLOC)
+    #error WOLFSSL_AESXTS_THREADS needs threads and dynamic memory
+#endif
+#ifndef WOLFSSL_AESXTS_MAX_THREADS
+    #define WOLFSSL_AESXTS_MAX_THREADS 64
+#endif
+/* Fewest bytes of sectors worth starting a thread for. */
+#ifndef WC_AESXTS_THREAD_MIN_SZ
+    #define WC_AESXTS_THREAD_MIN_SZ (64 * 1024)
+#endif
+#endif /* WOLFSSL_AESXTS_THREADS */
+
+WOLFSSL_API int wc_AesXtsEncryptSectors(XtsAes* aes, byte* out,
+        const byte* in, word32 sz, word64 sector, word32 sectorSz,
+        int threads);
+
+WOLFSSL_API int wc_AesXtsDecryptSectors(XtsAes* aes, byte* out,
+        const byte* in, word32 sz, word64 sector, word32 sectorSz,
+        int threads);
+
 WOLFSSL_API int wc_AesXtsFree(XtsAes* aes);
 #endif
 
@@ -1881,6 +1881,11 @@ struct DecodedCert {
 #ifndef NO_CERTS
     SignatureCtx sigCtx;
 #endif
+#ifdef WOLFSSL_CHAIN_VERIFY_POOL
+    const byte* sigVerifiedKey;    /* key signature was already checked with */
+    word32      sigVerifiedKeySz;
+    word32      sigVerifiedKeyOID;
+#endif
 #if defined(WOLFSSL_RENESAS_TSIP) || defined(WOLFSSL_RENESAS_FSPSM_TLS)
     byte*  sce_tsip_encRsaKeyIdx;
 #endif
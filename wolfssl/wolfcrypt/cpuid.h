@@ -51,6 +51,10 @@
     #define CPUID_MOVBE  0x0080   /* Move and byte swap */
     #define CPUID_BMI1   0x0100   /* ANDN */
     #define CPUID_SHA    0x0200   /* SHA-1 and SHA-256 instructions */
+    #define CPUID_AVX512 0x0400   /* AVX-512 Foundation */
+    #define CPUID_AVX512BW 0x0800 /* AVX-512 Byte and Word */
+    #define CPUID_VAES   0x1000   /* AES instructions on YMM/ZMM registers */
+    #define CPUID_VPCLMULQDQ 0x2000 /* PCLMULQDQ on YMM/ZMM registers */
 
     #define IS_INTEL_AVX1(f)    ((f) & CPUID_AVX1)
     #define IS_INTEL_AVX2(f)    ((f) & CPUID_AVX2)
@@ -62,14 +66,18 @@
     #define IS_INTEL_MOVBE(f)   ((f) & CPUID_MOVBE)
     #define IS_INTEL_BMI1(f)    ((f) & CPUID_BMI1)
     #define IS_INTEL_SHA(f)     ((f) & CPUID_SHA)
+    #define IS_INTEL_AVX512(f)  ((f) & CPUID_AVX512)
+    #define IS_INTEL_AVX512BW(f) ((f) & CPUID_AVX512BW)
+    #define IS_INTEL_VAES(f)    ((f) & CPUID_VAES)
+    #define IS_INTEL_VPCLMULQDQ(f) ((f) & CPUID_VPCLMULQDQ)
 
 #endif
 
 #ifdef HAVE_CPUID
     void cpuid_set_flags(void);
-    word32 cpuid_get_flags(void);
 
-    /* Public APIs to modify flags. */
+    /* Public APIs to get and modify flags. */
+    WOLFSSL_API word32 cpuid_get_flags(void);
     WOLFSSL_API void cpuid_select_flags(word32 flags);
     WOLFSSL_API void cpuid_set_flag(word32 flag);
     WOLFSSL_API void cpuid_clear_flag(word32 flag);
@@ -470,6 +470,29 @@ WOLFSSL_API void wc_CryptoCb_SetDeviceFindCb(CryptoDevCallbackFind cb);
 WOLFSSL_API void wc_CryptoCb_InfoString(wc_CryptoInfo* info);
 #endif
 
+#ifdef WOLF_CRYPTO_CB_POOL
+#if defined(SINGLE_THREADED) || !defined(WOLFSSL_COND) || \
+    !defined(HAVE_THREAD_LS) || defined(NO_MALLOC) || \
+    defined(WOLF_CRYPTO_CB_ONLY_RSA) || defined(WOLF_CRYPTO_CB_ONLY_ECC)
+    #error WOLF_CRYPTO_CB_POOL needs threads, WOLFSSL_COND, thread local \
+           storage and the software public key code
+#endif
+#ifndef WC_CRYPTOCB_POOL_MAX_THREADS
+    #define WC_CRYPTOCB_POOL_MAX_THREADS 64
+#endif
+
+/* wc_CryptoCbPool_New() flags */
+#define WC_CRYPTOCB_POOL_FLAG_ASYNC 0x01 /* return WC_PENDING_E, needs
+                                          * WOLFSSL_ASYNC_CRYPT */
+
+/* Software device running public key operations on worker threads */
+typedef struct wc_CryptoCbPool wc_CryptoCbPool;
+
+WOLFSSL_API int  wc_CryptoCbPool_New(wc_CryptoCbPool** pool, int devId,
+                                     int threads, int flags, void* heap);
+WOLFSSL_API void wc_CryptoCbPool_Free(wc_CryptoCbPool* pool);
+#endif /* WOLF_CRYPTO_CB_POOL */
+
 /* old function names */
 #define wc_CryptoDev_RegisterDevice   wc_CryptoCb_RegisterDevice
 #define wc_CryptoDev_UnRegisterDevice wc_CryptoCb_UnRegisterDevice
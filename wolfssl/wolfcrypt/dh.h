@@ -73,6 +73,9 @@ struct DhKey {
     WC_ASYNC_DEV asyncDev;
 #endif
     int trustedGroup;
+#ifdef WOLFSSL_KEYGEN_THREADS
+    int paramGenThreads;
+#endif
 #ifdef WOLFSSL_KCAPI_DH
     struct kcapi_handle* handle;
 #endif
@@ -189,6 +192,9 @@ WOLFSSL_API int wc_DhCheckPrivKey_ex(DhKey* key, const byte* priv, word32 pubSz,
 WOLFSSL_API int wc_DhCheckKeyPair(DhKey* key, const byte* pub, word32 pubSz,
                         const byte* priv, word32 privSz);
 WOLFSSL_API int wc_DhGenerateParams(WC_RNG *rng, int modSz, DhKey *dh);
+#if defined(WOLFSSL_KEY_GEN) && defined(WOLFSSL_KEYGEN_THREADS)
+WOLFSSL_API int wc_DhSetParamGenThreads(DhKey* key, int threads);
+#endif
 WOLFSSL_API int wc_DhExportParamsRaw(DhKey* dh, byte* p, word32* pSz,
                        byte* q, word32* qSz, byte* g, word32* gSz);
 
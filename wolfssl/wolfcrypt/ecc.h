@@ -695,6 +695,10 @@ int wc_ecc_verify_hash(const byte* sig, word32 siglen, const byte* hash,
 WOLFSSL_API
 int wc_ecc_verify_hash_ex(mp_int *r, mp_int *s, const byte* hash,
                           word32 hashlen, int* res, ecc_key* key);
+WOLFSSL_API
+int wc_ecc_verify_hash_batch(mp_int** r, mp_int** s, const byte** hash,
+                             const word32* hashlen, int* res, ecc_key** key,
+                             int count);
 #endif /* HAVE_ECC_VERIFY */
 
 WOLFSSL_ABI WOLFSSL_API
@@ -158,6 +158,11 @@ WOLFSSL_API
 int wc_ed25519_verify_msg_ex(const byte* sig, word32 sigLen, const byte* msg,
                               word32 msgLen, int* res, ed25519_key* key,
                               byte type, const byte* context, byte contextLen);
+WOLFSSL_API
+int wc_ed25519_verify_msg_batch(const byte** sig, const word32* sigLen,
+                                const byte** msg, const word32* msgLen,
+                                int* res, ed25519_key** key, word32 count,
+                                WC_RNG* rng);
 #ifdef WOLFSSL_ED25519_STREAMING_VERIFY
 WOLFSSL_API
 int wc_ed25519_verify_msg_init(const byte* sig, word32 sigLen, ed25519_key* key,
@@ -80,6 +80,12 @@ WOLFSSL_LOCAL int  ge_frombytes_negate_vartime(ge_p3 *h,const unsigned char *s);
 
 WOLFSSL_LOCAL int  ge_double_scalarmult_vartime(ge_p2 *r, const unsigned char *a,
                                  const ge_p3 *A, const unsigned char *b);
+#ifndef ED25519_SMALL
+WOLFSSL_LOCAL int  ge_multi_scalarmult_vartime(ge_p2 *r, const unsigned char *b,
+                                 const unsigned char *s, const ge_p3 *P, int n,
+                                 void* heap);
+WOLFSSL_LOCAL void ge_p2_mul8(ge_p2 *r);
+#endif
 WOLFSSL_LOCAL void ge_scalarmult_base(ge_p3 *h,const unsigned char *a);
 WOLFSSL_LOCAL void sc_reduce(byte* s);
 WOLFSSL_LOCAL void sc_muladd(byte* s, const byte* a, const byte* b,
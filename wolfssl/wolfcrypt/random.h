@@ -237,6 +237,9 @@ WOLFSSL_API int  wc_FreeRng(WC_RNG* rng);
 #define wc_FreeRng(rng) (void)NOT_COMPILED_IN
 #endif
 
+#if defined(WOLFSSL_KEYGEN_THREADS) && !defined(WC_NO_RNG)
+    WOLFSSL_LOCAL int wc_RNG_Fork(WC_RNG* rng, WC_RNG* child);
+#endif
 #ifdef WC_RNG_SEED_CB
     WOLFSSL_API int wc_SetSeed_Cb(wc_RngSeed_Cb cb);
 #endif
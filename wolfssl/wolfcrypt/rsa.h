@@ -182,6 +182,26 @@ typedef struct RsaNb {
 } RsaNb;
 #endif
 
+#if defined(WC_RSA_PREPARED) && (!defined(WC_RSA_BLINDING) || \
+    defined(WC_NO_RNG) || defined(WOLFSSL_SP_MATH) || \
+    defined(WOLFSSL_RSA_PUBLIC_ONLY) || defined(WOLFSSL_RSA_VERIFY_ONLY))
+    /* Prepared keys cache blinding values - nothing to cache without. */
+    #undef WC_RSA_PREPARED
+#endif
+
+#ifdef WC_RSA_PREPARED
+/* Cached private key operation state. See wc_RsaPrepareKey(). */
+typedef struct RsaPrepared {
+    mp_int   blind;     /* r^e mod n in Montgomery form */
+    mp_int   blindInv;  /* 1/r mod n in Montgomery form */
+    mp_digit mp;        /* Montgomery multiplier for n */
+    word32   uses;      /* Operations since blinding pair was generated */
+#ifndef SINGLE_THREADED
+    wolfSSL_Mutex lock;
+#endif
+} RsaPrepared;
+#endif
+
 /* RSA */
 struct RsaKey {
     mp_int n, e;
@@ -242,6 +262,12 @@ struct RsaKey {
 #ifdef WC_RSA_NONBLOCK
     RsaNb* nb;
 #endif
+#ifdef WC_RSA_PREPARED
+    RsaPrepared* prep;
+#endif
+#ifdef WOLFSSL_KEYGEN_THREADS
+    int keyGenThreads;
+#endif
 #ifdef WOLFSSL_AFALG_XILINX_RSA
     int alFd;
     int rdFd;
@@ -369,6 +395,9 @@ WOLFSSL_API int  wc_RsaPublicKeyDecodeRaw(const byte* n, word32 nSz,
 #ifdef WC_RSA_BLINDING
     WOLFSSL_API int wc_RsaSetRNG(RsaKey* key, WC_RNG* rng);
 #endif
+#ifdef WC_RSA_PREPARED
+    WOLFSSL_API int wc_RsaPrepareKey(RsaKey* key, WC_RNG* rng);
+#endif
 #ifdef WC_RSA_NONBLOCK
     WOLFSSL_API int wc_RsaSetNonBlock(RsaKey* key, RsaNb* nb);
     #ifdef WC_RSA_NONBLOCK_TIME
@@ -424,6 +453,9 @@ WOLFSSL_API int wc_RsaExportKey(RsaKey* key,
 
 #ifdef WOLFSSL_KEY_GEN
     WOLFSSL_API int wc_MakeRsaKey(RsaKey* key, int size, long e, WC_RNG* rng);
+    #ifdef WOLFSSL_KEYGEN_THREADS
+    WOLFSSL_API int wc_RsaSetKeyGenThreads(RsaKey* key, int threads);
+    #endif
     WOLFSSL_API int wc_CheckProbablePrime_ex(const byte* p, word32 pSz,
                                           const byte* q, word32 qSz,
                                           const byte* e, word32 eSz,
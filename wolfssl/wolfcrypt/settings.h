@@ -3412,6 +3412,55 @@ extern void uITRON4_free(void *p) ;
     #endif
 #endif /* WOLFSSL_SYS_CA_CERTS */
 
+#if defined(WOLFSSL_SHARDED_SESSION_CACHE) && defined(NO_SESSION_CACHE)
+    #undef WOLFSSL_SHARDED_SESSION_CACHE
+#endif
+#ifdef WOLFSSL_SHARDED_SESSION_CACHE
+    /* Sessions are moved between rows on resize so they must be allocated
+     * individually and every row (shard) needs its own lock. */
+    #ifdef NO_SESSION_CACHE_ROW_LOCK
+        #error "Sharded session cache requires session cache row locks."
+    #endif
+    #ifdef PERSIST_SESSION_CACHE
+        #error "Sharded session cache does not support persistent session cache."
+    #endif
+    #undef SESSION_CACHE_DYNAMIC_MEM
+    #define SESSION_CACHE_DYNAMIC_MEM
+    #undef ENABLE_SESSION_CACHE_ROW_LOCK
+    #define ENABLE_SESSION_CACHE_ROW_LOCK
+#endif
+
+#if defined(WOLFSSL_SESSION_STORE) && (defined(NO_SESSION_CACHE) || \
+        defined(NO_WOLFSSL_SERVER))
+    #undef WOLFSSL_SESSION_STORE
+#endif
+#ifdef WOLFSSL_SESSION_STORE
+    /* Stored sessions are serialized with wolfSSL_i2d_SSL_SESSION. */
+    #undef HAVE_EXT_CACHE
+    #define HAVE_EXT_CACHE
+#else
+    #undef WOLFSSL_SESSION_STORE_SHM
+#endif
+#if defined(WOLFSSL_SESSION_STORE_SHM) && defined(SINGLE_THREADED)
+    #error "Shared memory session store requires process shared mutexes."
+#endif
+
+/* kernel TLS offload works on the default socket I/O of Linux */
+#if defined(WOLFSSL_KTLS) && (!defined(__linux__) || \
+        defined(WOLFSSL_USER_IO) || defined(WOLFSSL_NO_SOCK) || \
+        defined(WOLFSSL_LINUXKM) || defined(WOLFCRYPT_ONLY) || \
+        defined(NO_TLS))
+    #undef WOLFSSL_KTLS
+#endif
+
+/* the io_uring backend drives the sockets of Linux directly */
+#if defined(WOLFSSL_IO_URING) && (!defined(__linux__) || \
+        defined(WOLFSSL_USER_IO) || defined(WOLFSSL_NO_SOCK) || \
+        defined(WOLFSSL_LINUXKM) || defined(WOLFCRYPT_ONLY) || \
+        defined(NO_TLS))
+    #undef WOLFSSL_IO_URING
+#endif
+
 #if defined(SESSION_CACHE_DYNAMIC_MEM) && defined(PERSIST_SESSION_CACHE)
 #error "Dynamic session cache currently does not support persistent session cache."
 #endif
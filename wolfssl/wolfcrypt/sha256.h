@@ -268,6 +268,39 @@ WOLFSSL_API void wc_Sha256SizeSet(wc_Sha256* sha256, word32 len);
     WOLFSSL_API int wc_Sha256GetFlags(wc_Sha256* sha256, word32* flags);
 #endif
 
+#ifdef WOLFSSL_SHA256_MB
+/* Most messages hashed at once by the multi-buffer API. */
+#define WC_SHA256_MB_MAX_LANES  16
+
+/* Message being hashed in one lane. */
+typedef struct wc_Sha256_MB_Lane {
+    const byte* data;       /* next block to hash */
+    byte*       hash;       /* where the digest is put when done */
+    word32      blocks;     /* blocks left to hash from data */
+    word32      padBlocks;  /* blocks of pad to hash after data */
+    byte        pad[2 * WC_SHA256_BLOCK_SIZE]; /* last bytes and padding */
+} wc_Sha256_MB_Lane;
+
+/* Multi-buffer SHA-256 - hashes independent messages in parallel lanes. */
+typedef struct wc_Sha256_MB {
+    /* word i of the state of lane l is digest[i][l] */
+    ALIGN64 word32 digest[WC_SHA256_DIGEST_SIZE / sizeof(word32)]
+                         [WC_SHA256_MB_MAX_LANES];
+    wc_Sha256_MB_Lane lane[WC_SHA256_MB_MAX_LANES];
+    void*  heap;
+    int    devId;
+    word32 lanes;   /* number of lanes hashed at once: 1, 8 or 16 */
+    word32 busy;    /* bit mask of lanes with a message */
+} wc_Sha256_MB;
+
+WOLFSSL_API int wc_Sha256_MB_Init(wc_Sha256_MB* mb, void* heap, int devId);
+WOLFSSL_API int wc_Sha256_MB_Lanes(wc_Sha256_MB* mb);
+WOLFSSL_API int wc_Sha256_MB_Submit(wc_Sha256_MB* mb, const byte* data,
+    word32 len, byte* hash);
+WOLFSSL_API int wc_Sha256_MB_Flush(wc_Sha256_MB* mb);
+WOLFSSL_API void wc_Sha256_MB_Free(wc_Sha256_MB* mb);
+#endif /* WOLFSSL_SHA256_MB */
+
 #ifdef WOLFSSL_SHA224
 /* avoid redefinition of structs */
 #if !defined(HAVE_FIPS) || \
@@ -190,6 +190,43 @@ WOLFSSL_API void wc_Shake256_Free(wc_Shake* shake);
 WOLFSSL_API int wc_Shake256_Copy(wc_Shake* src, wc_Sha3* dst);
 #endif
 
+#if !defined(WOLFSSL_XILINX_CRYPT) && !defined(WOLFSSL_AFALG_XILINX_SHA3)
+#if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
+/* Number of SHAKE states processed together by wc_Shake_x4. */
+#define WC_SHAKE_X4_LANES    4
+
+/* Four SHAKE states absorbed and squeezed in parallel. */
+typedef struct wc_Shake_x4 {
+    /* State data. Interleaved when simd is set, word i of state j at
+     * s[4 * i + j], otherwise one state after another. */
+    ALIGN32 word64 s[25 * WC_SHAKE_X4_LANES];
+    void*  heap;
+    /* Number of 64-bit numbers in a block. */
+    byte   count;
+    /* Whether the AVX2 permutation of interleaved states is used. */
+    byte   simd;
+} wc_Shake_x4;
+#endif
+
+#ifdef WOLFSSL_SHAKE128
+WOLFSSL_API int wc_InitShake128_x4(wc_Shake_x4* shake, void* heap, int devId);
+WOLFSSL_API int wc_Shake128_x4_Absorb(wc_Shake_x4* shake,
+    const byte* const* data, word32 len);
+WOLFSSL_API int wc_Shake128_x4_SqueezeBlocks(wc_Shake_x4* shake,
+    byte* const* out, word32 blockCnt);
+WOLFSSL_API void wc_Shake128_x4_Free(wc_Shake_x4* shake);
+#endif
+
+#ifdef WOLFSSL_SHAKE256
+WOLFSSL_API int wc_InitShake256_x4(wc_Shake_x4* shake, void* heap, int devId);
+WOLFSSL_API int wc_Shake256_x4_Absorb(wc_Shake_x4* shake,
+    const byte* const* data, word32 len);
+WOLFSSL_API int wc_Shake256_x4_SqueezeBlocks(wc_Shake_x4* shake,
+    byte* const* out, word32 blockCnt);
+WOLFSSL_API void wc_Shake256_x4_Free(wc_Shake_x4* shake);
+#endif
+#endif /* !WOLFSSL_XILINX_CRYPT && !WOLFSSL_AFALG_XILINX_SHA3 */
+
 #ifdef WOLFSSL_HASH_FLAGS
     WOLFSSL_API int wc_Sha3_SetFlags(wc_Sha3* sha3, word32 flags);
     WOLFSSL_API int wc_Sha3_GetFlags(wc_Sha3* sha3, word32* flags);
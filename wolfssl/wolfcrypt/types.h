@@ -1053,6 +1053,12 @@ typedef struct w64wrapper {
         DYNAMIC_TYPE_SM4_BUFFER   = 99,
         DYNAMIC_TYPE_DEBUG_TAG    = 100,
         DYNAMIC_TYPE_LMS          = 101,
+        DYNAMIC_TYPE_URING        = 102,
+        DYNAMIC_TYPE_RECORD_POOL  = 103,
+        DYNAMIC_TYPE_VERIFY_POOL  = 104,
+        DYNAMIC_TYPE_CRYPTOCB_POOL = 105,
+        DYNAMIC_TYPE_KEY_SHARE_POOL = 106,
+        DYNAMIC_TYPE_CERT_MSG     = 107,
         DYNAMIC_TYPE_SNIFFER_SERVER      = 1000,
         DYNAMIC_TYPE_SNIFFER_SESSION     = 1001,
         DYNAMIC_TYPE_SNIFFER_PB          = 1002,
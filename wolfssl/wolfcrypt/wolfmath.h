@@ -77,6 +77,28 @@ WOLFSSL_LOCAL void mp_reverse(unsigned char *s, int len);
 
 WOLFSSL_API int mp_cond_copy(mp_int* a, int copy, mp_int* b);
 WOLFSSL_API int mp_rand(mp_int* a, int digits, WC_RNG* rng);
+
+#ifdef WOLFSSL_KEYGEN_THREADS
+#if defined(SINGLE_THREADED) || defined(WC_NO_RNG) || \
+    defined(WOLFSSL_LINUXKM) || defined(WOLFSSL_NO_MALLOC)
+    #error WOLFSSL_KEYGEN_THREADS needs threads, an RNG and dynamic memory
+#endif
+#ifndef WOLFSSL_KEYGEN_MAX_THREADS
+    #define WOLFSSL_KEYGEN_MAX_THREADS 64
+#endif
+
+/* Generate and test one prime candidate.
+ *
+ * worker is the index of the calling thread and iter the number of
+ * candidates it has tried before. Sets isPrime to 1 when cand is accepted.
+ */
+typedef int (*wc_PrimeSearchCb)(void* ctx, int worker, word32 iter,
+    WC_RNG* rng, mp_int* cand, int* isPrime);
+
+WOLFSSL_LOCAL int wc_PrimeSearchThreads(wc_PrimeSearchCb cb, void* ctx,
+    int threads, word32 maxCands, WC_RNG* rng, mp_int* prime, int* worker,
+    word32* iter, void* heap);
+#endif /* WOLFSSL_KEYGEN_THREADS */
 #endif
 
 #define WC_TYPE_HEX_STR 1
@@ -542,6 +542,25 @@ WOLFSSL_API void* wolfSSL_GetIOWriteCtx(WOLFSSL* ssl);
 WOLFSSL_API void wolfSSL_SetIOReadFlags( WOLFSSL* ssl, int flags);
 WOLFSSL_API void wolfSSL_SetIOWriteFlags(WOLFSSL* ssl, int flags);
 
+#ifdef WOLFSSL_IO_URING
+    /* socket I/O of many connections through one Linux io_uring */
+    typedef struct WOLFSSL_URING WOLFSSL_URING;
+
+    WOLFSSL_API WOLFSSL_URING* wolfSSL_uring_new(int maxConns, int bufSz,
+                                                 void* heap);
+    WOLFSSL_API void wolfSSL_uring_free(WOLFSSL_URING* ring);
+    WOLFSSL_API int  wolfSSL_CTX_SetIO_uring(WOLFSSL_CTX* ctx,
+                                             WOLFSSL_URING* ring);
+    WOLFSSL_API int  wolfSSL_SetIO_uring(WOLFSSL* ssl, WOLFSSL_URING* ring);
+    WOLFSSL_API int  wolfSSL_uring_submit(WOLFSSL_URING* ring);
+    WOLFSSL_API int  wolfSSL_uring_wait(WOLFSSL_URING* ring, WOLFSSL** ready,
+                                        int max, int timeoutMs);
+
+    WOLFSSL_LOCAL int UringReceive(WOLFSSL* ssl, char* buf, int sz,
+                                   void* ctx);
+    WOLFSSL_LOCAL int UringSend(WOLFSSL* ssl, char* buf, int sz, void* ctx);
+#endif /* WOLFSSL_IO_URING */
+
 
 #ifdef HAVE_NETX
     WOLFSSL_LOCAL int NetX_Receive(WOLFSSL *ssl, char *buf, int sz, void *ctx);